@@ -32,6 +32,8 @@
 
 #include <fstream>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <binder/IBinder.h>
 #include <binder/IServiceManager.h>
@@ -345,14 +347,29 @@ static const char* k_traceStreamPath =
 static const char* k_traceMarkerPath =
     "trace_marker";
 
+// One invocation probes the same tracefs paths several times over: once per
+// requested category while parsing arguments, again when listing categories,
+// and again for every sysfs enable during trace setup. The permissions of
+// these paths cannot change mid-run, so each access() result is remembered
+// for the lifetime of the process. atrace is single threaded.
+static bool cachedAccess(const char* filename, int mode) {
+    static std::unordered_map<std::string, bool> cache[2];
+    auto& modeCache = cache[mode == W_OK ? 1 : 0];
+    auto [it, inserted] = modeCache.try_emplace(filename, false);
+    if (inserted) {
+        it->second = access((g_traceFolder + filename).c_str(), mode) != -1;
+    }
+    return it->second;
+}
+
 // Check whether a file exists.
 static bool fileExists(const char* filename) {
-    return access((g_traceFolder + filename).c_str(), F_OK) != -1;
+    return cachedAccess(filename, F_OK);
 }
 
 // Check whether a file is writable.
 static bool fileIsWritable(const char* filename) {
-    return access((g_traceFolder + filename).c_str(), W_OK) != -1;
+    return cachedAccess(filename, W_OK);
 }
 
 // Truncate a file.
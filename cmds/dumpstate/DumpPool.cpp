@@ -18,6 +18,10 @@
 
 #include "DumpPool.h"
 
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <array>
 #include <thread>
 
@@ -33,6 +37,18 @@ namespace dumpstate {
 
 const std::string DumpPool::PREFIX_TMPFILE_NAME = "dump-tmp.";
 
+namespace {
+
+// Nice value matching ANDROID_PRIORITY_BACKGROUND.
+constexpr int kBackgroundNice = 10;
+
+// From linux/ioprio.h, which bionic does not export.
+constexpr int kIoprioWhoProcess = 1;
+constexpr int kIoprioClassIdle = 3;
+constexpr int kIoprioClassShift = 13;
+
+}  // namespace
+
 
 void WaitForTask(std::future<std::string> future, const std::string& title, int out_fd) {
     DurationReporter duration_reporter("Wait for " + title, true);
@@ -83,6 +99,7 @@ void DumpPool::start(int thread_counts) {
     for (int i = 0; i < thread_counts; i++) {
         threads_.emplace_back(std::thread([=]() {
             setThreadName(pthread_self(), i + 1);
+            setThreadPriority();
             loop();
         }));
     }
@@ -163,6 +180,20 @@ void DumpPool::setThreadName(const pthread_t thread, int id) {
     pthread_setname_np(thread, name.data());
 }
 
+void DumpPool::setThreadPriority() {
+    // Pool threads inherit dumpstate's elevated priority (the main thread runs
+    // at -20 so orchestration is never starved), but the sections they collect
+    // are heavy and run while the device may be in active use. Drop the
+    // workers to background CPU and idle I/O priority so parallel collection
+    // does not compete with foreground work.
+    if (setpriority(PRIO_PROCESS, 0, kBackgroundNice) != 0) {
+        MYLOGE("Failed to set background priority: %s\n", strerror(errno));
+    }
+    if (syscall(SYS_ioprio_set, kIoprioWhoProcess, 0, kIoprioClassIdle << kIoprioClassShift)) {
+        MYLOGE("Failed to set idle io priority: %s\n", strerror(errno));
+    }
+}
+
 void DumpPool::loop() {
     std::unique_lock lock(lock_);
     while (!shutdown_) {
@@ -177,6 +177,7 @@ class DumpPool {
     std::unique_ptr<TmpFile> createTempFile();
     void deleteTempFiles(const std::string& folder);
     void setThreadName(const pthread_t thread, int id);
+    void setThreadPriority();
     void loop();
 
     /*
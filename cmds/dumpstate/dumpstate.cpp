@@ -74,6 +74,7 @@
 #include <sys/poll.h>
 #include <sys/prctl.h>
 #include <sys/resource.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/wait.h>
@@ -274,7 +275,25 @@ static int OpenForRead(std::string path) {
 }
 
 bool CopyFile(int in_fd, int out_fd) {
-    char buf[4096];
+    // When the source is a regular file (the common case: finished bugreport zips and
+    // screenshots, which can be hundreds of MB), let the kernel move the bytes directly from
+    // the page cache instead of bouncing them through a userspace buffer.
+    struct stat st;
+    if (fstat(in_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        constexpr size_t kSendfileChunkSize = 1024 * 1024;
+        ssize_t sent;
+        while ((sent = TEMP_FAILURE_RETRY(sendfile(out_fd, in_fd, nullptr,
+                                                   kSendfileChunkSize))) > 0) {
+        }
+        if (sent == 0) {
+            return true;
+        }
+        // sendfile can fail if out_fd doesn't support it (e.g. EINVAL); fall through and
+        // retry with read/write from the current offset.
+        MYLOGD("sendfile failed (%s), falling back to read/write\n", strerror(errno));
+    }
+
+    char buf[65536];
     ssize_t byte_count;
     while ((byte_count = TEMP_FAILURE_RETRY(read(in_fd, buf, sizeof(buf)))) > 0) {
         if (!android::base::WriteFully(out_fd, buf, byte_count)) {
@@ -1690,6 +1709,18 @@ Dumpstate::RunStatus Dumpstate::dumpstate() {
     RunCommand("CPU INFO", {"top", "-b", "-n", "1", "-H", "-s", "6", "-o",
                             "pid,tid,user,pr,ni,%cpu,s,virt,res,pcy,cmd,name"});
 
+    // Kernel logs are among the most requested triage data and are cheap to
+    // collect, so grab them before the heavy sections and checkpoint what we
+    // have so far: if this run is interrupted later, the checkpoint still
+    // carries them along with the critical dumpsys output collected earlier.
+    if (android::base::GetBoolProperty("ro.logd.kernel", false)) {
+        DoKernelLogcat();
+    } else {
+        do_dmesg();
+    }
+    DoKmsg();
+    ds.MaybeWriteEarlyCheckpoint();
+
     RUN_SLOW_FUNCTION_WITH_CONSENT_CHECK(RunCommand, "BUGREPORT_PROCDUMP", {"bugreport_procdump"},
                                          CommandOptions::AS_ROOT);
 
@@ -1727,12 +1758,6 @@ Dumpstate::RunStatus Dumpstate::dumpstate() {
                     "done"}, CommandOptions::AS_ROOT);
     }
 
-    if (android::base::GetBoolProperty("ro.logd.kernel", false)) {
-        DoKernelLogcat();
-    } else {
-        do_dmesg();
-    }
-
     DumpVintf();
 
     RunCommand("LIST OF OPEN FILES", {"lsof"}, CommandOptions::AS_ROOT);
@@ -1764,8 +1789,6 @@ Dumpstate::RunStatus Dumpstate::dumpstate() {
 
     RunDumpsys("EBPF MAP STATS", {"connectivity", "trafficcontroller"});
 
-    DoKmsg();
-
     DumpShutdownCheckpoints();
 
     DumpIpAddrAndRules();
@@ -2729,6 +2752,64 @@ static void register_sig_handler() {
     signal(SIGPIPE, SIG_IGN);
 }
 
+void Dumpstate::MaybeWriteEarlyCheckpoint() {
+    // Only useful when the report ends up in a zip file; when streaming to a
+    // socket the caller already received everything dumped so far.
+    if (zip_writer_ == nullptr || tmp_path_.empty()) {
+        return;
+    }
+    DurationReporter duration_reporter("EARLY CHECKPOINT", true /* logcat_only */);
+
+    // stdout (the main report) is unbuffered, but flush anyway so the snapshot
+    // below can't race a partially written section title.
+    fflush(stdout);
+    std::string content;
+    if (!android::base::ReadFileToString(tmp_path_, &content)) {
+        MYLOGE("Unable to read %s for the early checkpoint\n", tmp_path_.c_str());
+        return;
+    }
+
+    early_zip_path_ = GetPath("-early.zip");
+    auto file = std::unique_ptr<FILE, int (*)(FILE*)>{fopen(early_zip_path_.c_str(), "wb"),
+                                                      fclose};
+    if (file == nullptr) {
+        MYLOGE("fopen(%s): %s\n", early_zip_path_.c_str(), strerror(errno));
+        early_zip_path_.clear();
+        return;
+    }
+
+    ZipWriter writer(file.get());
+    std::string entry_name = base_name_ + "-" + name_ + "-early.txt";
+    size_t flags = ZipWriter::kCompress | ZipWriter::kDefaultCompression;
+    int32_t err = writer.StartEntryWithTime(entry_name.c_str(), flags, now_);
+    if (err == 0) {
+        err = writer.WriteBytes(content.c_str(), content.length());
+    }
+    if (err == 0) {
+        err = writer.FinishEntry();
+    }
+    if (err == 0) {
+        err = writer.Finish();
+    }
+    if (err != 0) {
+        MYLOGE("Failed to write early checkpoint %s: %s\n", early_zip_path_.c_str(),
+               ZipWriter::ErrorCodeString(err));
+        android::os::UnlinkAndLogOnError(early_zip_path_);
+        early_zip_path_.clear();
+        return;
+    }
+
+    // Make sure the checkpoint actually hits storage; it only matters if this
+    // process later dies without finishing the full report.
+    fflush(file.get());
+    fsync(fileno(file.get()));
+    if (chown(early_zip_path_.c_str(), AID_SHELL, AID_SHELL)) {
+        MYLOGE("Unable to change ownership of early checkpoint %s: %s\n", early_zip_path_.c_str(),
+               strerror(errno));
+    }
+    MYLOGI("Wrote early bugreport checkpoint to %s\n", early_zip_path_.c_str());
+}
+
 bool Dumpstate::FinishZipFile() {
     // Runs all enqueued adding zip entry and cleanup tasks before finishing the zip file.
     if (zip_entry_tasks_) {
@@ -2779,6 +2860,12 @@ bool Dumpstate::FinishZipFile() {
     MYLOGD("Removing temporary file %s\n", tmp_path_.c_str())
     android::os::UnlinkAndLogOnError(tmp_path_);
 
+    // The full report is complete, so the early checkpoint is now redundant.
+    if (!early_zip_path_.empty()) {
+        android::os::UnlinkAndLogOnError(early_zip_path_);
+        early_zip_path_.clear();
+    }
+
     return true;
 }
 
@@ -3646,6 +3733,9 @@ void Dumpstate::CleanupTmpFiles() {
     android::os::UnlinkAndLogOnError(tmp_path_);
     android::os::UnlinkAndLogOnError(screenshot_path_);
     android::os::UnlinkAndLogOnError(path_);
+    if (!early_zip_path_.empty()) {
+        android::os::UnlinkAndLogOnError(early_zip_path_);
+    }
     if (dump_traces_path != nullptr) {
         android::os::UnlinkAndLogOnError(dump_traces_path);
     }
@@ -326,6 +326,14 @@ class Dumpstate {
     /* Prints the dumpstate header on `stdout`. */
     void PrintHeader() const;
 
+    /*
+     * Writes a finalized "-early.zip" checkpoint containing everything dumped so far, so an
+     * interrupted run still leaves a valid archive with the high-value early sections. The
+     * checkpoint is removed again once the full zip is finished. No-op when the report is not
+     * being written to a zip file.
+     */
+    void MaybeWriteEarlyCheckpoint();
+
     /*
      * Adds the temporary report to the existing .zip file, closes the .zip file, and removes the
      * temporary file.
@@ -510,6 +518,10 @@ class Dumpstate {
     // Full path of the bugreport zip file inside bugreport_internal_dir_.
     std::string path_;
 
+    // Full path of the early checkpoint zip (empty when none was written). Deleted once the
+    // full report zip is complete.
+    std::string early_zip_path_;
+
     // Full path of the file containing the screenshot (when requested).
     std::string screenshot_path_;
 
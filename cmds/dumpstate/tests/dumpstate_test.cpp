@@ -34,6 +34,7 @@
 #include <gtest/gtest.h>
 #include <libgen.h>
 #include <signal.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <ziparchive/zip_archive.h>
@@ -1766,6 +1767,18 @@ TEST_F(DumpPoolTest, EnqueueTaskWithFd) {
     EXPECT_THAT(getTempFileCounts(kTestDataPath), Eq(0));
 }
 
+TEST_F(DumpPoolTest, RunsTasksAtBackgroundPriority) {
+    int task_nice = -100;
+    auto dump_func = [&]() {
+        task_nice = getpriority(PRIO_PROCESS, 0);
+    };
+
+    auto t = dump_pool_->enqueueTask(/* duration_title = */"", dump_func);
+    WaitForTask(std::move(t), "", out_fd_.get());
+
+    EXPECT_THAT(task_nice, Eq(10));
+}
+
 TEST_F(DumpPoolTest, EnqueueTask_withDurationLog) {
     bool run_1 = false;
     auto dump_func_1 = [&]() {
@@ -16,8 +16,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iomanip>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include <android-base/file.h>
 #include <android-base/stringprintf.h>
@@ -59,6 +62,11 @@ static int sort_func(const String16* lhs, const String16* rhs)
     return lhs->compare(*rhs);
 }
 
+// Number of services dumped concurrently on a multi-service dump: enough to
+// hide slow services behind each other without hammering the system while a
+// bugreport is taken.
+static constexpr size_t kMaxConcurrentDumps = 4;
+
 static void usage() {
     fprintf(
         stderr,
@@ -271,33 +279,80 @@ int Dumpsys::main(int argc, char* const argv[]) {
         return 0;
     }
 
+    Vector<String16> servicesToDump;
     for (size_t i = 0; i < N; i++) {
-        const String16& serviceName = services[i];
-        if (IsSkipped(skippedServices, serviceName)) continue;
+        if (IsSkipped(skippedServices, services[i])) continue;
+        servicesToDump.add(services[i]);
+    }
+
+    const std::chrono::milliseconds timeout(timeoutArgMs);
+    if (servicesToDump.size() <= 1) {
+        for (const String16& serviceName : servicesToDump) {
+            if (startDumpThread(dumpTypeFlags, serviceName, args) == OK) {
+                bool addSeparator = (N > 1);
+                if (addSeparator) {
+                    writeDumpHeader(STDOUT_FILENO, serviceName, priorityFlags);
+                }
+                std::chrono::duration<double> elapsedDuration;
+                size_t bytesWritten = 0;
+                status_t status = writeDump(STDOUT_FILENO, serviceName, timeout, asProto,
+                                            elapsedDuration, bytesWritten);
+
+                if (status == TIMED_OUT) {
+                    std::cout << std::endl
+                         << "*** SERVICE '" << serviceName << "' DUMP TIMEOUT (" << timeoutArgMs
+                         << "ms) EXPIRED ***" << std::endl
+                         << std::endl;
+                }
 
-        if (startDumpThread(dumpTypeFlags, serviceName, args) == OK) {
-            bool addSeparator = (N > 1);
-            if (addSeparator) {
-                writeDumpHeader(STDOUT_FILENO, serviceName, priorityFlags);
+                if (addSeparator) {
+                    writeDumpFooter(STDOUT_FILENO, serviceName, elapsedDuration);
+                }
+                bool dumpComplete = (status == OK);
+                stopDumpThread(dumpComplete);
+            }
+        }
+    } else {
+        // Dump services concurrently with bounded parallelism so that slow
+        // services do not serialize the whole dump. Each service still gets
+        // its own timeout budget. Output is buffered per service and stitched
+        // to stdout in service order, so it stays deterministic.
+        std::vector<std::unique_ptr<PendingDump>> pendingDumps;
+        pendingDumps.reserve(servicesToDump.size());
+        size_t started = 0;
+        for (size_t i = 0; i < servicesToDump.size(); i++) {
+            // Keep a bounded window of dumps in flight ahead of the writer.
+            while (started < servicesToDump.size() && started < i + kMaxConcurrentDumps) {
+                auto dump = std::make_unique<PendingDump>();
+                if (startPendingDump(*dump, dumpTypeFlags, servicesToDump[started], args, timeout,
+                                     asProto) != OK) {
+                    dump.reset();
+                }
+                pendingDumps.push_back(std::move(dump));
+                started++;
             }
-            std::chrono::duration<double> elapsedDuration;
-            size_t bytesWritten = 0;
-            status_t status =
-                writeDump(STDOUT_FILENO, serviceName, std::chrono::milliseconds(timeoutArgMs),
-                          asProto, elapsedDuration, bytesWritten);
 
-            if (status == TIMED_OUT) {
+            PendingDump* dump = pendingDumps[i].get();
+            if (dump == nullptr) continue;
+            dump->readerThread.join();
+
+            writeDumpHeader(STDOUT_FILENO, servicesToDump[i], priorityFlags);
+            if (!dump->output.empty() &&
+                !WriteFully(STDOUT_FILENO, dump->output.data(), dump->output.size())) {
+                std::cerr << "Failed to write while dumping service " << servicesToDump[i] << ": "
+                          << strerror(errno) << std::endl;
+            }
+            if (dump->status == TIMED_OUT) {
                 std::cout << std::endl
-                     << "*** SERVICE '" << serviceName << "' DUMP TIMEOUT (" << timeoutArgMs
+                     << "*** SERVICE '" << servicesToDump[i] << "' DUMP TIMEOUT (" << timeoutArgMs
                      << "ms) EXPIRED ***" << std::endl
                      << std::endl;
             }
+            writeDumpFooter(STDOUT_FILENO, servicesToDump[i], dump->elapsedDuration);
 
-            if (addSeparator) {
-                writeDumpFooter(STDOUT_FILENO, serviceName, elapsedDuration);
-            }
-            bool dumpComplete = (status == OK);
-            stopDumpThread(dumpComplete);
+            // Release the buffer before waiting on the next service.
+            dump->output.clear();
+            dump->output.shrink_to_fit();
         }
     }
 
@@ -413,6 +468,33 @@ static void reportDumpError(const String16& serviceName, status_t error, const c
               << statusToString(error) << std::endl;
 }
 
+static void dumpServiceToFd(const sp<IBinder>& service, int dumpTypeFlags,
+                            const String16& serviceName, const Vector<String16>& args,
+                            const unique_fd& remoteEnd) {
+    if (dumpTypeFlags & Dumpsys::TYPE_PID) {
+        status_t err = dumpPidToFd(service, remoteEnd, dumpTypeFlags == Dumpsys::TYPE_PID);
+        reportDumpError(serviceName, err, "dumping PID");
+    }
+    if (dumpTypeFlags & Dumpsys::TYPE_STABILITY) {
+        status_t err = dumpStabilityToFd(service, remoteEnd);
+        reportDumpError(serviceName, err, "dumping stability");
+    }
+    if (dumpTypeFlags & Dumpsys::TYPE_THREAD) {
+        status_t err = dumpThreadsToFd(service, remoteEnd);
+        reportDumpError(serviceName, err, "dumping thread info");
+    }
+    if (dumpTypeFlags & Dumpsys::TYPE_CLIENTS) {
+        status_t err = dumpClientsToFd(service, remoteEnd);
+        reportDumpError(serviceName, err, "dumping clients info");
+    }
+
+    // other types always act as a header, this is usually longer
+    if (dumpTypeFlags & Dumpsys::TYPE_DUMP) {
+        status_t err = service->dump(remoteEnd.get(), args);
+        reportDumpError(serviceName, err, "dumping");
+    }
+}
+
 status_t Dumpsys::startDumpThread(int dumpTypeFlags, const String16& serviceName,
                                   const Vector<String16>& args) {
     sp<IBinder> service = sm_->checkService(serviceName);
@@ -434,28 +516,7 @@ status_t Dumpsys::startDumpThread(int dumpTypeFlags, const String16& serviceName
 
     // dump blocks until completion, so spawn a thread..
     activeThread_ = std::thread([=, remote_end{std::move(remote_end)}]() mutable {
-        if (dumpTypeFlags & TYPE_PID) {
-            status_t err = dumpPidToFd(service, remote_end, dumpTypeFlags == TYPE_PID);
-            reportDumpError(serviceName, err, "dumping PID");
-        }
-        if (dumpTypeFlags & TYPE_STABILITY) {
-            status_t err = dumpStabilityToFd(service, remote_end);
-            reportDumpError(serviceName, err, "dumping stability");
-        }
-        if (dumpTypeFlags & TYPE_THREAD) {
-            status_t err = dumpThreadsToFd(service, remote_end);
-            reportDumpError(serviceName, err, "dumping thread info");
-        }
-        if (dumpTypeFlags & TYPE_CLIENTS) {
-            status_t err = dumpClientsToFd(service, remote_end);
-            reportDumpError(serviceName, err, "dumping clients info");
-        }
-
-        // other types always act as a header, this is usually longer
-        if (dumpTypeFlags & TYPE_DUMP) {
-            status_t err = service->dump(remote_end.get(), args);
-            reportDumpError(serviceName, err, "dumping");
-        }
+        dumpServiceToFd(service, dumpTypeFlags, serviceName, args, remote_end);
     });
     return OK;
 }
@@ -486,19 +547,18 @@ void Dumpsys::writeDumpHeader(int fd, const String16& serviceName, int priorityF
     WriteStringToFd(msg, fd);
 }
 
-status_t Dumpsys::writeDump(int fd, const String16& serviceName, std::chrono::milliseconds timeout,
-                            bool asProto, std::chrono::duration<double>& elapsedDuration,
-                            size_t& bytesWritten) const {
+// Drains a service dump pipe until EOF, error or timeout, handing each chunk
+// to writeChunk (which returns false on write failure).
+static status_t drainDumpOutput(int serviceDumpFd, const String16& serviceName,
+                                std::chrono::milliseconds timeout,
+                                const std::function<bool(const char*, size_t)>& writeChunk,
+                                std::chrono::duration<double>& elapsedDuration,
+                                size_t& bytesWritten) {
     status_t status = OK;
     size_t totalBytes = 0;
     auto start = std::chrono::steady_clock::now();
     auto end = start + timeout;
 
-    int serviceDumpFd = redirectFd_.get();
-    if (serviceDumpFd == -1) {
-        return INVALID_OPERATION;
-    }
-
     struct pollfd pfd = {.fd = serviceDumpFd, .events = POLLIN};
 
     while (true) {
@@ -521,7 +581,7 @@ status_t Dumpsys::writeDump(int fd, const String16& serviceName, std::chrono::mi
         }
 
         char buf[4096];
-        rc = TEMP_FAILURE_RETRY(read(redirectFd_.get(), buf, sizeof(buf)));
+        rc = TEMP_FAILURE_RETRY(read(serviceDumpFd, buf, sizeof(buf)));
         if (rc < 0) {
             std::cerr << "Failed to read while dumping service " << serviceName << ": "
                  << strerror(errno) << std::endl;
@@ -532,7 +592,7 @@ status_t Dumpsys::writeDump(int fd, const String16& serviceName, std::chrono::mi
             break;
         }
 
-        if (!WriteFully(fd, buf, rc)) {
+        if (!writeChunk(buf, rc)) {
             std::cerr << "Failed to write while dumping service " << serviceName << ": "
                  << strerror(errno) << std::endl;
             status = -errno;
@@ -541,17 +601,86 @@ status_t Dumpsys::writeDump(int fd, const String16& serviceName, std::chrono::mi
         totalBytes += rc;
     }
 
+    elapsedDuration = std::chrono::steady_clock::now() - start;
+    bytesWritten = totalBytes;
+    return status;
+}
+
+status_t Dumpsys::writeDump(int fd, const String16& serviceName, std::chrono::milliseconds timeout,
+                            bool asProto, std::chrono::duration<double>& elapsedDuration,
+                            size_t& bytesWritten) const {
+    int serviceDumpFd = redirectFd_.get();
+    if (serviceDumpFd == -1) {
+        return INVALID_OPERATION;
+    }
+
+    status_t status = drainDumpOutput(
+            serviceDumpFd, serviceName, timeout,
+            [fd](const char* buf, size_t size) { return WriteFully(fd, buf, size); },
+            elapsedDuration, bytesWritten);
+
     if ((status == TIMED_OUT) && (!asProto)) {
         std::string msg = StringPrintf("\n*** SERVICE '%s' DUMP TIMEOUT (%llums) EXPIRED ***\n\n",
                                        String8(serviceName).c_str(), timeout.count());
         WriteStringToFd(msg, fd);
     }
 
-    elapsedDuration = std::chrono::steady_clock::now() - start;
-    bytesWritten = totalBytes;
     return status;
 }
 
+status_t Dumpsys::startPendingDump(PendingDump& dump, int dumpTypeFlags,
+                                   const String16& serviceName, const Vector<String16>& args,
+                                   std::chrono::milliseconds timeout, bool asProto) {
+    sp<IBinder> service = sm_->checkService(serviceName);
+    if (service == nullptr) {
+        std::cerr << "Can't find service: " << serviceName << std::endl;
+        return NAME_NOT_FOUND;
+    }
+
+    int sfd[2];
+    if (pipe(sfd) != 0) {
+        std::cerr << "Failed to create pipe to dump service info for " << serviceName << ": "
+             << strerror(errno) << std::endl;
+        return -errno;
+    }
+
+    unique_fd localEnd(sfd[0]);
+    unique_fd remoteEnd(sfd[1]);
+    sfd[0] = sfd[1] = -1;
+
+    dump.serviceName = serviceName;
+    dump.readerThread = std::thread([&dump, service, dumpTypeFlags, serviceName, args, timeout,
+                                     asProto, localEnd{std::move(localEnd)},
+                                     remoteEnd{std::move(remoteEnd)}]() mutable {
+        // dump blocks until completion, so it gets its own thread while this
+        // one drains the pipe into the buffer.
+        std::thread dumpThread([=, remoteEnd{std::move(remoteEnd)}]() mutable {
+            dumpServiceToFd(service, dumpTypeFlags, serviceName, args, remoteEnd);
+        });
+
+        dump.status = drainDumpOutput(
+                localEnd.get(), serviceName, timeout,
+                [&dump](const char* buf, size_t size) {
+                    dump.output.append(buf, size);
+                    return true;
+                },
+                dump.elapsedDuration, dump.bytesWritten);
+
+        if ((dump.status == TIMED_OUT) && (!asProto)) {
+            StringAppendF(&dump.output, "\n*** SERVICE '%s' DUMP TIMEOUT (%llums) EXPIRED ***\n\n",
+                          String8(serviceName).c_str(), timeout.count());
+        }
+
+        if (dump.status == OK) {
+            dumpThread.join();
+        } else {
+            // The service is likely stuck in its dump; don't wait for it.
+            dumpThread.detach();
+        }
+    });
+    return OK;
+}
+
 void Dumpsys::writeDumpFooter(int fd, const String16& serviceName,
                               const std::chrono::duration<double>& elapsedDuration) const {
     using std::chrono::system_clock;
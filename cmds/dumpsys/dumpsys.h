@@ -17,6 +17,7 @@
 #ifndef FRAMEWORK_NATIVE_CMD_DUMPSYS_H_
 #define FRAMEWORK_NATIVE_CMD_DUMPSYS_H_
 
+#include <string>
 #include <thread>
 
 #include <android-base/unique_fd.h>
@@ -126,6 +127,30 @@ class Dumpsys {
     }
 
   private:
+    /**
+     * State of one service dump running concurrently with others. The service
+     * dumps into a pipe while a reader thread drains it into {@code output},
+     * which is stitched to stdout in service order once complete.
+     */
+    struct PendingDump {
+        String16 serviceName;
+        std::thread readerThread;
+        std::string output;
+        status_t status = OK;
+        std::chrono::duration<double> elapsedDuration{};
+        size_t bytesWritten = 0;
+    };
+
+    /**
+     * Starts dumping a service concurrently: a thread to run the dump and a
+     * reader thread draining it into {@code dump.output} under the given
+     * per-service timeout. On {@code OK}, {@code dump.readerThread} must be
+     * joined before reading the other fields.
+     */
+    status_t startPendingDump(PendingDump& dump, int dumpTypeFlags, const String16& serviceName,
+                              const Vector<String16>& args, std::chrono::milliseconds timeout,
+                              bool asProto);
+
     android::IServiceManager* sm_;
     std::thread activeThread_;
     mutable android::base::unique_fd redirectFd_;
@@ -36,9 +36,11 @@
 #include <sys/xattr.h>
 #include <unistd.h>
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <numeric>
 #include <regex>
 #include <thread>
 #include <unordered_set>
@@ -1620,16 +1622,47 @@ binder::Status InstalldNativeService::snapshotAppData(const std::optional<std::s
 
     auto scope_guard = android::base::make_scope_guard(deleter);
 
+    // The app may not have any CE data at all, in which case it's OK to skip
+    // the CE snapshot and the cache trimming that precedes it.
+    auto from_ce = create_data_user_ce_package_path(volume_uuid, userId, package_name);
+    const bool has_ce_source = access(from_ce.c_str(), F_OK) == 0;
+    if (!has_ce_source) {
+        LOG(INFO) << "Missing source " << from_ce;
+    } else {
+        // Trim the caches before copying anything so that neither snapshot
+        // wastes time and space on disposable data.
+        // ce_data_inode is not needed when FLAG_CLEAR_CACHE_ONLY is set.
+        binder::Status clear_cache_result = clearAppData(volumeUuid, packageName, userId,
+                                                         storageFlags | FLAG_CLEAR_CACHE_ONLY, 0);
+        if (!clear_cache_result.isOk()) {
+            // It should be fine to continue snapshot if we for some reason failed
+            // to clear cache.
+            LOG(WARNING) << "Failed to clear cache of app " << packageName;
+        }
+
+        // ce_data_inode is not needed when FLAG_CLEAR_CODE_CACHE_ONLY is set.
+        binder::Status clear_code_cache_result =
+                clearAppData(volumeUuid, packageName, userId,
+                             storageFlags | FLAG_CLEAR_CODE_CACHE_ONLY, 0);
+        if (!clear_code_cache_result.isOk()) {
+            // It should be fine to continue snapshot if we for some reason failed
+            // to clear code_cache.
+            LOG(WARNING) << "Failed to clear code_cache of app " << packageName;
+        }
+    }
+
+    bool de_copy_needed = false;
+    std::string from_de, to_de;
     if (storageFlags & FLAG_STORAGE_DE) {
-        auto from = create_data_user_de_package_path(volume_uuid, userId, package_name);
-        auto to = create_data_misc_de_rollback_path(volume_uuid, userId, snapshotId);
+        from_de = create_data_user_de_package_path(volume_uuid, userId, package_name);
+        to_de = create_data_misc_de_rollback_path(volume_uuid, userId, snapshotId);
         auto rollback_package_path =
                 create_data_misc_de_rollback_package_path(volume_uuid, userId, snapshotId,
                                                           package_name);
 
-        int rc = create_dir_if_needed(to.c_str(), kRollbackFolderMode);
+        int rc = create_dir_if_needed(to_de.c_str(), kRollbackFolderMode);
         if (rc != 0) {
-            return error(rc, "Failed to create folder " + to);
+            return error(rc, "Failed to create folder " + to_de);
         }
 
         rc = delete_dir_contents(rollback_package_path, true /* ignore_if_missing */);
@@ -1638,52 +1671,20 @@ binder::Status InstalldNativeService::snapshotAppData(const std::optional<std::s
         }
 
         // Check if we have data to copy.
-        if (access(from.c_str(), F_OK) == 0) {
-          rc = copy_directory_recursive(from.c_str(), to.c_str());
-        }
-        if (rc != 0) {
-            res = error(rc, "Failed copying " + from + " to " + to);
-            clear_de_on_exit = true;
-            return res;
-        }
+        de_copy_needed = access(from_de.c_str(), F_OK) == 0;
     }
 
-    // The app may not have any data at all, in which case it's OK to skip here.
-    auto from_ce = create_data_user_ce_package_path(volume_uuid, userId, package_name);
-    if (access(from_ce.c_str(), F_OK) != 0) {
-        LOG(INFO) << "Missing source " << from_ce;
-        return ok();
-    }
-
-    // ce_data_inode is not needed when FLAG_CLEAR_CACHE_ONLY is set.
-    binder::Status clear_cache_result =
-            clearAppData(volumeUuid, packageName, userId, storageFlags | FLAG_CLEAR_CACHE_ONLY, 0);
-    if (!clear_cache_result.isOk()) {
-        // It should be fine to continue snapshot if we for some reason failed
-        // to clear cache.
-        LOG(WARNING) << "Failed to clear cache of app " << packageName;
-    }
-
-    // ce_data_inode is not needed when FLAG_CLEAR_CODE_CACHE_ONLY is set.
-    binder::Status clear_code_cache_result =
-            clearAppData(volumeUuid, packageName, userId, storageFlags | FLAG_CLEAR_CODE_CACHE_ONLY,
-                         0);
-    if (!clear_code_cache_result.isOk()) {
-        // It should be fine to continue snapshot if we for some reason failed
-        // to clear code_cache.
-        LOG(WARNING) << "Failed to clear code_cache of app " << packageName;
-    }
-
-    if (storageFlags & FLAG_STORAGE_CE) {
-        auto from = create_data_user_ce_package_path(volume_uuid, userId, package_name);
-        auto to = create_data_misc_ce_rollback_path(volume_uuid, userId, snapshotId);
+    bool ce_copy_needed = false;
+    std::string to_ce;
+    if ((storageFlags & FLAG_STORAGE_CE) && has_ce_source) {
+        to_ce = create_data_misc_ce_rollback_path(volume_uuid, userId, snapshotId);
         auto rollback_package_path =
                 create_data_misc_ce_rollback_package_path(volume_uuid, userId, snapshotId,
                                                           package_name);
 
-        int rc = create_dir_if_needed(to.c_str(), kRollbackFolderMode);
+        int rc = create_dir_if_needed(to_ce.c_str(), kRollbackFolderMode);
         if (rc != 0) {
-            return error(rc, "Failed to create folder " + to);
+            return error(rc, "Failed to create folder " + to_ce);
         }
 
         rc = delete_dir_contents(rollback_package_path, true /* ignore_if_missing */);
@@ -1691,23 +1692,47 @@ binder::Status InstalldNativeService::snapshotAppData(const std::optional<std::s
             return error(rc, "Failed clearing existing snapshot " + rollback_package_path);
         }
 
-        rc = copy_directory_recursive(from.c_str(), to.c_str());
+        ce_copy_needed = true;
+    }
+
+    // Copy the two trees concurrently: they touch disjoint sources and
+    // destinations, and for large apps the snapshot time is dominated by these
+    // copies.
+    int de_rc = 0;
+    int ce_rc = 0;
+    std::thread de_copy_thread;
+    if (de_copy_needed) {
+        de_copy_thread = std::thread(
+                [&] { de_rc = copy_directory_recursive(from_de.c_str(), to_de.c_str()); });
+    }
+    if (ce_copy_needed) {
+        ce_rc = copy_directory_recursive(from_ce.c_str(), to_ce.c_str());
+    }
+    if (de_copy_thread.joinable()) {
+        de_copy_thread.join();
+    }
+
+    if (de_rc != 0) {
+        res = error(de_rc, "Failed copying " + from_de + " to " + to_de);
+        clear_de_on_exit = true;
+        clear_ce_on_exit = ce_copy_needed;
+        return res;
+    }
+    if (ce_rc != 0) {
+        res = error(ce_rc, "Failed copying " + from_ce + " to " + to_ce);
+        clear_ce_on_exit = true;
+        return res;
+    }
+
+    if (ce_copy_needed && _aidl_return != nullptr) {
+        auto ce_snapshot_path = create_data_misc_ce_rollback_package_path(volume_uuid, userId,
+                                                                          snapshotId, package_name);
+        int rc = get_path_inode(ce_snapshot_path, reinterpret_cast<ino_t*>(_aidl_return));
         if (rc != 0) {
-            res = error(rc, "Failed copying " + from + " to " + to);
+            res = error(rc, "Failed to get_path_inode for " + ce_snapshot_path);
             clear_ce_on_exit = true;
             return res;
         }
-        if (_aidl_return != nullptr) {
-            auto ce_snapshot_path =
-                    create_data_misc_ce_rollback_package_path(volume_uuid, userId, snapshotId,
-                                                              package_name);
-            rc = get_path_inode(ce_snapshot_path, reinterpret_cast<ino_t*>(_aidl_return));
-            if (rc != 0) {
-                res = error(rc, "Failed to get_path_inode for " + ce_snapshot_path);
-                clear_ce_on_exit = true;
-                return res;
-            }
-        }
     }
 
     return res;
@@ -1755,30 +1780,53 @@ binder::Status InstalldNativeService::restoreAppDataSnapshot(
         return res;
     }
 
+    // Restore the CE and DE trees concurrently: they touch disjoint sources
+    // and destinations, and the clearAppData above has already emptied both.
+    int ce_rc = 0;
+    int de_rc = 0;
+    std::string to_ce, to_de;
+    std::thread de_copy_thread;
+    if (needs_de_rollback) {
+        to_de = create_data_user_de_path(volume_uuid, userId);
+        de_copy_thread = std::thread(
+                [&] { de_rc = copy_directory_recursive(from_de.c_str(), to_de.c_str()); });
+    }
     if (needs_ce_rollback) {
-        auto to_ce = create_data_user_ce_path(volume_uuid, userId);
-        int rc = copy_directory_recursive(from_ce.c_str(), to_ce.c_str());
-        if (rc != 0) {
-            res = error(rc, "Failed copying " + from_ce + " to " + to_ce);
-            return res;
+        to_ce = create_data_user_ce_path(volume_uuid, userId);
+        ce_rc = copy_directory_recursive(from_ce.c_str(), to_ce.c_str());
+    }
+    if (de_copy_thread.joinable()) {
+        de_copy_thread.join();
+    }
+
+    if (ce_rc != 0 || de_rc != 0) {
+        // Leaving the app with no data is better than leaving it with
+        // mismatched data: erase whichever half was restored successfully, and
+        // keep both snapshots so the caller may retry.
+        if (needs_ce_rollback && ce_rc == 0) {
+            auto ce_data = create_data_user_ce_package_path(volume_uuid, userId, package_name);
+            LOG(WARNING) << "de_data rollback failed. Erasing rolled back ce_data " << ce_data;
+            if (delete_dir_contents(ce_data.c_str(), 1, nullptr) != 0) {
+                LOG(WARNING) << "Failed to delete rolled back ce_data " << ce_data;
+            }
         }
-        delete_dir_contents_and_dir(from_ce, true /* ignore_if_missing */);
+        if (needs_de_rollback && de_rc == 0) {
+            auto de_data = create_data_user_de_package_path(volume_uuid, userId, package_name);
+            LOG(WARNING) << "ce_data rollback failed. Erasing rolled back de_data " << de_data;
+            if (delete_dir_contents(de_data.c_str(), 1, nullptr) != 0) {
+                LOG(WARNING) << "Failed to delete rolled back de_data " << de_data;
+            }
+        }
+        if (ce_rc != 0) {
+            return error(ce_rc, "Failed copying " + from_ce + " to " + to_ce);
+        }
+        return error(de_rc, "Failed copying " + from_de + " to " + to_de);
     }
 
+    if (needs_ce_rollback) {
+        delete_dir_contents_and_dir(from_ce, true /* ignore_if_missing */);
+    }
     if (needs_de_rollback) {
-        auto to_de = create_data_user_de_path(volume_uuid, userId);
-        int rc = copy_directory_recursive(from_de.c_str(), to_de.c_str());
-        if (rc != 0) {
-            if (needs_ce_rollback) {
-                auto ce_data = create_data_user_ce_package_path(volume_uuid, userId, package_name);
-                LOG(WARNING) << "de_data rollback failed. Erasing rolled back ce_data " << ce_data;
-                if (delete_dir_contents(ce_data.c_str(), 1, nullptr) != 0) {
-                    LOG(WARNING) << "Failed to delete rolled back ce_data " << ce_data;
-                }
-            }
-            res = error(rc, "Failed copying " + from_de + " to " + to_de);
-            return res;
-        }
         delete_dir_contents_and_dir(from_de, true /* ignore_if_missing */);
     }
 
@@ -3275,6 +3323,22 @@ binder::Status InstalldNativeService::dexopt(
         const std::optional<std::string>& dexMetadataPath,
         const std::optional<std::string>& compilationReason, bool* aidl_return) {
     ENFORCE_UID(AID_SYSTEM);
+    return dexoptInternal(apkPath, uid, packageName, instructionSet, dexoptNeeded, outputPath,
+                          dexFlags, compilerFilter, uuid, classLoaderContext, seInfo, downgrade,
+                          targetSdkVersion, profileName, dexMetadataPath, compilationReason,
+                          aidl_return);
+}
+
+binder::Status InstalldNativeService::dexoptInternal(
+        const std::string& apkPath, int32_t uid, const std::string& packageName,
+        const std::string& instructionSet, int32_t dexoptNeeded,
+        const std::optional<std::string>& outputPath, int32_t dexFlags,
+        const std::string& compilerFilter, const std::optional<std::string>& uuid,
+        const std::optional<std::string>& classLoaderContext,
+        const std::optional<std::string>& seInfo, bool downgrade, int32_t targetSdkVersion,
+        const std::optional<std::string>& profileName,
+        const std::optional<std::string>& dexMetadataPath,
+        const std::optional<std::string>& compilationReason, bool* aidl_return) {
     CHECK_ARGUMENT_UUID(uuid);
     CHECK_ARGUMENT_PATH(apkPath);
     CHECK_ARGUMENT_PACKAGE_NAME(packageName);
@@ -3309,6 +3373,55 @@ binder::Status InstalldNativeService::dexopt(
     return res ? error(res, error_msg) : ok();
 }
 
+binder::Status InstalldNativeService::dexoptBatched(
+        const std::vector<android::os::DexoptArgs>& args, int32_t parallelism,
+        std::vector<android::os::DexoptResult>* _aidl_return) {
+    ENFORCE_UID(AID_SYSTEM);
+
+    const int32_t maxJobs = std::max(1u, std::thread::hardware_concurrency());
+    const size_t numJobs =
+            std::min<size_t>(std::clamp<int32_t>(parallelism, 1, maxJobs), args.size());
+
+    // Start entries in descending priority order; stable so equal priorities keep the
+    // caller's order. Results are reported in the order of args regardless.
+    std::vector<size_t> schedule(args.size());
+    std::iota(schedule.begin(), schedule.end(), 0);
+    std::stable_sort(schedule.begin(), schedule.end(), [&args](size_t lhs, size_t rhs) {
+        return args[lhs].priority > args[rhs].priority;
+    });
+
+    std::vector<android::os::DexoptResult> results(args.size());
+    std::atomic<size_t> nextJob(0);
+    auto worker = [&]() {
+        for (size_t i; (i = nextJob.fetch_add(1)) < schedule.size();) {
+            const android::os::DexoptArgs& arg = args[schedule[i]];
+            android::os::DexoptResult& result = results[schedule[i]];
+            bool completed = false;
+            auto status = dexoptInternal(arg.apkPath, arg.uid, arg.packageName,
+                                         arg.instructionSet, arg.dexoptNeeded, arg.outputPath,
+                                         arg.dexFlags, arg.compilerFilter, arg.uuid,
+                                         arg.sharedLibraries, arg.seInfo, arg.downgrade,
+                                         arg.targetSdkVersion, arg.profileName,
+                                         arg.dexMetadataPath, arg.compilationReason, &completed);
+            result.completed = completed;
+            result.exceptionCode = status.exceptionCode();
+            result.exceptionMessage = status.exceptionMessage();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(numJobs);
+    for (size_t i = 0; i < numJobs; i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    *_aidl_return = std::move(results);
+    return ok();
+}
+
 binder::Status InstalldNativeService::controlDexOptBlocking(bool block) {
     android::installd::control_dexopt_blocking(block);
     return ok();
@@ -143,6 +143,10 @@ public:
                           const std::optional<std::string>& dexMetadataPath,
                           const std::optional<std::string>& compilationReason, bool* aidl_return);
 
+    binder::Status dexoptBatched(const std::vector<android::os::DexoptArgs>& args,
+                                 int32_t parallelism,
+                                 std::vector<android::os::DexoptResult>* _aidl_return);
+
     binder::Status controlDexOptBlocking(bool block);
 
     binder::Status rmdex(const std::string& codePath, const std::string& instructionSet);
@@ -231,6 +235,22 @@ private:
 
     std::string findDataMediaPath(const std::optional<std::string>& uuid, userid_t userid);
 
+    // Body of dexopt() without the calling-uid check, so that dexoptBatched() worker
+    // threads (which do not run with a binder calling identity) can share it.
+    binder::Status dexoptInternal(const std::string& apkPath, int32_t uid,
+                                  const std::string& packageName,
+                                  const std::string& instructionSet, int32_t dexoptNeeded,
+                                  const std::optional<std::string>& outputPath, int32_t dexFlags,
+                                  const std::string& compilerFilter,
+                                  const std::optional<std::string>& uuid,
+                                  const std::optional<std::string>& classLoaderContext,
+                                  const std::optional<std::string>& seInfo, bool downgrade,
+                                  int32_t targetSdkVersion,
+                                  const std::optional<std::string>& profileName,
+                                  const std::optional<std::string>& dexMetadataPath,
+                                  const std::optional<std::string>& compilationReason,
+                                  bool* aidl_return);
+
     binder::Status createAppDataLocked(const std::optional<std::string>& uuid,
                                        const std::string& packageName, int32_t userId,
                                        int32_t flags, int32_t appId, int32_t previousAppId,
@@ -46,14 +46,28 @@ static std::string getPidcon(pid_t pid) {
     return result;
 }
 
-static struct selabel_handle* getSehandle() {
+// Epoch bumped whenever libselinux reports that the policy changed.
+// selinux_status_updated() consumes the notification, so it must have exactly
+// one caller; everything that needs invalidation compares its recorded epoch
+// against this one.
+static uint32_t getPolicyEpoch() {
+    static uint32_t gPolicyEpoch = 1;
+    if (selinux_status_updated()) {
+        gPolicyEpoch++;
+    }
+    return gPolicyEpoch;
+}
+
+static struct selabel_handle* getSehandle(uint32_t policyEpoch) {
     static struct selabel_handle* gSehandle = nullptr;
-    if (gSehandle != nullptr && selinux_status_updated()) {
+    static uint32_t gSehandleEpoch = 0;
+    if (gSehandle != nullptr && gSehandleEpoch != policyEpoch) {
         selabel_close(gSehandle);
         gSehandle = nullptr;
     }
 
     if (gSehandle == nullptr) {
+        gSehandleEpoch = policyEpoch;
         gSehandle = kIsVendor
             ? selinux_android_vendor_service_context_handle()
             : selinux_android_service_context_handle();
@@ -161,14 +175,37 @@ bool Access::actionAllowed(const CallingContext& sctx, const char* tctx, const c
 
 bool Access::actionAllowedFromLookup(const CallingContext& sctx, const std::string& name, const char *perm) {
 #ifdef __ANDROID__
+    // boot storms hit servicemanager with the same (caller, service) lookups over
+    // and over; memoize the grants so repeats skip the service_contexts lookup
+    // and the access check entirely
+    constexpr size_t kMaxCachedGrants = 4096;
+
+    const uint32_t policyEpoch = getPolicyEpoch();
+    if (mGrantCacheEpoch != policyEpoch) {
+        mGrantCache.clear();
+        mGrantCacheEpoch = policyEpoch;
+    }
+
+    std::string key = sctx.sid + '\0' + perm + '\0' + name;
+    if (mGrantCache.count(key) != 0) {
+        return true;
+    }
+
     char *tctx = nullptr;
-    if (selabel_lookup(getSehandle(), &tctx, name.c_str(), SELABEL_CTX_ANDROID_SERVICE) != 0) {
+    if (selabel_lookup(getSehandle(policyEpoch), &tctx, name.c_str(),
+                       SELABEL_CTX_ANDROID_SERVICE) != 0) {
         LOG(ERROR) << "SELinux: No match for " << name << " in service_contexts.\n";
         return false;
     }
 
     bool allowed = actionAllowed(sctx, tctx, perm, name);
     freecon(tctx);
+    if (allowed) {
+        if (mGrantCache.size() >= kMaxCachedGrants) {
+            mGrantCache.clear();
+        }
+        mGrantCache.insert(std::move(key));
+    }
     return allowed;
 #else
     (void)sctx;
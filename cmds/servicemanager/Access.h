@@ -16,9 +16,12 @@
 
 #pragma once
 
-#include <string>
+#include <stdint.h>
 #include <sys/types.h>
 
+#include <string>
+#include <unordered_set>
+
 namespace android {
 
 // singleton
@@ -53,6 +56,12 @@ private:
             const char *perm);
 
     char* mThisProcessContext = nullptr;
+
+    // Positive decisions keyed by (sid, perm, name), flushed whenever libselinux
+    // reports a policy update. Denials are never cached, so each one is
+    // re-evaluated and audited.
+    std::unordered_set<std::string> mGrantCache;
+    uint32_t mGrantCacheEpoch = 0;
 };
 
 };
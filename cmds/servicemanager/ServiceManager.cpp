@@ -419,6 +419,20 @@ Status ServiceManager::checkService(const std::string& name, os::Service* outSer
     return Status::ok();
 }
 
+Status ServiceManager::checkServices(const std::vector<std::string>& names,
+                                     std::vector<os::Service>* outServices) {
+    SM_PERFETTO_TRACE_FUNC();
+
+    outServices->clear();
+    outServices->reserve(names.size());
+    for (const std::string& name : names) {
+        // Access control is enforced per name by tryGetService, so a caller gets
+        // null for any service it is not allowed to find.
+        outServices->push_back(tryGetService(name, false));
+    }
+    return Status::ok();
+}
+
 os::Service ServiceManager::tryGetService(const std::string& name, bool startIfNotFound) {
     std::optional<std::string> accessorName;
 #ifndef VENDORSERVICEMANAGER
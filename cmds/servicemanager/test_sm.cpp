@@ -201,6 +201,20 @@ TEST(GetService, HappyHappy) {
     EXPECT_EQ(service, outBinder);
 }
 
+TEST(GetService, CheckServicesBatch) {
+    auto sm = getPermissiveServiceManager();
+    sp<IBinder> service = getBinder();
+
+    EXPECT_TRUE(sm->addService("foo", service, false /*allowIsolated*/,
+        IServiceManager::DUMP_FLAG_PRIORITY_DEFAULT).isOk());
+
+    std::vector<Service> out;
+    EXPECT_TRUE(sm->checkServices({"foo", "bar"}, &out).isOk());
+    ASSERT_EQ(2u, out.size());
+    EXPECT_EQ(service, out[0].get<Service::Tag::binder>());
+    EXPECT_EQ(nullptr, out[1].get<Service::Tag::binder>());
+}
+
 TEST(GetService, NonExistant) {
     auto sm = getPermissiveServiceManager();
 
@@ -29,6 +29,57 @@
 
 namespace android::ftl {
 
+template <typename F>
+class Flags;
+
+namespace details {
+
+// Upper bound on the length of Flags<F>::string(): every named flag in the declared range
+// joined by " | ", plus one group of unnamed bits (or "0x0") and its separator.
+template <typename F>
+constexpr std::size_t flag_string_size() {
+    const EnumRange<F, FlagName> range;
+    std::size_t size = to_chars_length_v<std::underlying_type_t<F>> + 3;
+    for (const auto& name : range) {
+        if (name) size += name->size() + 3;
+    }
+    return size;
+}
+
+}  // namespace details
+
+/*
+ * A fixed-capacity string of flag names, sized at compile time for the worst case of F: every
+ * named flag in the declared range joined by " | ", plus one group of unnamed bits. Produced by
+ * Flags<F>::stringify() so dump and trace paths can format flags without allocating.
+ */
+template <typename F>
+class FlagString {
+    static_assert(std::is_enum_v<F>, "Flags type must be an enum");
+
+public:
+    static constexpr std::size_t max_size() { return details::flag_string_size<F>(); }
+
+    constexpr std::string_view str() const { return {buffer_, size_}; }
+    constexpr const char* c_str() const { return buffer_; }
+    constexpr std::size_t size() const { return size_; }
+
+private:
+    friend class Flags<F>;
+
+    constexpr FlagString() : buffer_{} {}
+
+    constexpr void append(std::string_view str) {
+        for (const char c : str) {
+            buffer_[size_++] = c;
+        }
+        buffer_[size_] = '\0';
+    }
+
+    char buffer_[details::flag_string_size<F>() + 1];
+    std::size_t size_ = 0;
+};
+
 /* A class for handling flags defined by an enum or enum class in a type-safe way. */
 template <typename F>
 class Flags {
@@ -170,8 +221,15 @@ public:
      */
     U get() const { return mFlags; }
 
-    std::string string() const {
-        std::string result;
+    std::string string() const { return std::string(stringify().str()); }
+
+    /*
+     * Allocation-free alternative to string(). The returned object owns a fixed-capacity buffer
+     * sized at compile time for the worst case of F, so the result can be formatted into dumps
+     * and trace labels without touching the heap.
+     */
+    FlagString<F> stringify() const {
+        FlagString<F> result;
         bool first = true;
         U unstringified = 0;
         for (const F f : *this) {
@@ -184,11 +242,12 @@ public:
 
         if (unstringified != 0) {
             constexpr auto radix = sizeof(U) == 1 ? Radix::kBin : Radix::kHex;
-            appendFlag(result, to_string(unstringified, radix), first);
+            to_chars_buffer_t<U> buffer;
+            appendFlag(result, to_chars(buffer, unstringified, radix), first);
         }
 
         if (first) {
-            result += "0x0";
+            result.append("0x0");
         }
 
         return result;
@@ -197,13 +256,13 @@ public:
 private:
     U mFlags;
 
-    static void appendFlag(std::string& str, const std::string_view& flag, bool& first) {
+    static void appendFlag(FlagString<F>& str, const std::string_view& flag, bool& first) {
         if (first) {
             first = false;
         } else {
-            str += " | ";
+            str.append(" | ");
         }
-        str += flag;
+        str.append(flag);
     }
 };
 
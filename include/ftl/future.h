@@ -17,9 +17,11 @@
 #pragma once
 
 #include <future>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <ftl/details/future.h>
 
@@ -131,4 +133,34 @@ inline auto defer(F&& f, Args&&... args) {
   return Future(std::async(std::launch::deferred, std::forward<F>(f), std::forward<Args>(args)...));
 }
 
+// Combines futures into one that resolves to a tuple of their results. Like then(), the
+// combinator is deferred, so no thread parks on the constituent futures: they are drained
+// in order by whichever thread queries the composite future.
+//
+//   auto future = ftl::when_all(ftl::yield(42), ftl::yield('!'));
+//   const auto [n, c] = future.get();
+//   assert(n == 42);
+//   assert(c == '!');
+//
+template <typename... Ts, template <typename> class... FutureImpls>
+inline auto when_all(Future<Ts, FutureImpls>&&... futures) -> Future<std::tuple<Ts...>> {
+  return defer([](auto&&... fs) { return std::make_tuple(fs.get()...); }, std::move(futures)...);
+}
+
+// As above, but for a homogeneous batch of futures, resolving to the results in the order
+// of the input futures.
+template <typename T, template <typename> class FutureImpl>
+inline auto when_all(std::vector<Future<T, FutureImpl>> futures) -> Future<std::vector<T>> {
+  return defer(
+      [](std::vector<Future<T, FutureImpl>>&& fs) {
+        std::vector<T> results;
+        results.reserve(fs.size());
+        for (auto& f : fs) {
+          results.push_back(f.get());
+        }
+        return results;
+      },
+      std::move(futures));
+}
+
 }  // namespace android::ftl
@@ -32,7 +32,9 @@ namespace android::ftl {
 // exceeds N, at which point mappings are relocated to dynamic memory. The try_emplace operation has
 // a non-standard analogue try_replace that destructively emplaces. The API also defines an in-place
 // counterpart to insert_or_assign: emplace_or_replace. Lookup is done not via a subscript operator,
-// but immutable getters that can optionally transform the value.
+// but immutable getters that can optionally transform the value. If KeyEqual is transparent, e.g.
+// std::equal_to<>, then contains/get/find accept any type comparable with the key, such as
+// std::string_view against std::string keys, without converting it to key_type.
 //
 // SmallMap<K, V, 0> unconditionally allocates on the heap.
 //
@@ -133,6 +135,12 @@ class SmallMap final {
   // Returns whether a mapping exists for the given key.
   bool contains(const key_type& key) const { return get(key).has_value(); }
 
+  // Heterogeneous counterpart of contains, enabled if KeyEqual is transparent. See get below.
+  template <typename Q, typename E = KeyEqual, typename = typename E::is_transparent>
+  bool contains(const Q& key) const {
+    return get(key).has_value();
+  }
+
   // Returns a reference to the value for the given key, or std::nullopt if the key was not found.
   //
   //   ftl::SmallMap map = ftl::init::map('a', 'A')('b', 'B')('c', 'C');
@@ -163,10 +171,50 @@ class SmallMap final {
     return {};
   }
 
+  // Heterogeneous counterparts of get, enabled if KeyEqual is transparent, which look up the key
+  // without converting it to key_type, e.g. to avoid allocating a temporary std::string key:
+  //
+  //   ftl::SmallMap<std::string, int, 2, std::equal_to<>> map;
+  //   map.try_emplace("abc", 1);
+  //
+  //   using namespace std::string_view_literals;
+  //   assert(map.get("abc"sv) == 1);
+  //
+  template <typename Q, typename E = KeyEqual, typename = typename E::is_transparent>
+  auto get(const Q& key) const -> Optional<std::reference_wrapper<const mapped_type>> {
+    for (const auto& [k, v] : *this) {
+      if (KeyEqual{}(k, key)) {
+        return std::cref(v);
+      }
+    }
+    return {};
+  }
+
+  template <typename Q, typename E = KeyEqual, typename = typename E::is_transparent>
+  auto get(const Q& key) -> Optional<std::reference_wrapper<mapped_type>> {
+    for (auto& [k, v] : *this) {
+      if (KeyEqual{}(k, key)) {
+        return std::ref(v);
+      }
+    }
+    return {};
+  }
+
   // Returns an iterator to an existing mapping for the given key, or the end() iterator otherwise.
   const_iterator find(const key_type& key) const { return const_cast<SmallMap&>(*this).find(key); }
   iterator find(const key_type& key) { return find(key, begin()); }
 
+  // Heterogeneous counterparts of find, enabled if KeyEqual is transparent. See get above.
+  template <typename Q, typename E = KeyEqual, typename = typename E::is_transparent>
+  const_iterator find(const Q& key) const {
+    return const_cast<SmallMap&>(*this).find(key);
+  }
+
+  template <typename Q, typename E = KeyEqual, typename = typename E::is_transparent>
+  iterator find(const Q& key) {
+    return find(key, begin());
+  }
+
   // Inserts a mapping unless it exists. Returns an iterator to the inserted or existing mapping,
   // and whether the mapping was inserted.
   //
@@ -241,7 +289,8 @@ class SmallMap final {
   void clear() { map_.clear(); }
 
  private:
-  iterator find(const key_type& key, iterator first) {
+  template <typename Q>
+  iterator find(const Q& key, iterator first) {
     return std::find_if(first, end(),
                         [&key](const auto& pair) { return KeyEqual{}(pair.first, key); });
   }
@@ -500,12 +500,18 @@ struct PointerCoords {
     // axes, however the window scaling will not.
     void scale(float globalScale, float windowXScale, float windowYScale);
 
+    // X and Y occupy the two lowest bits, so when present they are always the
+    // first packed values. Resolve them with plain bit tests instead of the
+    // bit-counting scan in getAxisValue; these are by far the hottest axis
+    // reads in dispatch and resampling.
     inline float getX() const {
-        return getAxisValue(AMOTION_EVENT_AXIS_X);
+        static_assert(AMOTION_EVENT_AXIS_X == 0);
+        return (bits & 0x1) ? values[0] : 0;
     }
 
     inline float getY() const {
-        return getAxisValue(AMOTION_EVENT_AXIS_Y);
+        static_assert(AMOTION_EVENT_AXIS_Y == 1);
+        return (bits & 0x2) ? values[bits & 0x1] : 0;
     }
 
     vec2 getXYValue() const { return vec2(getX(), getY()); }
@@ -836,6 +842,12 @@ public:
 
     float getHistoricalAxisValue(int32_t axis, size_t pointerIndex, size_t historicalIndex) const;
 
+    // Extracts the given axis for all samples (history plus the current
+    // sample, oldest first) into outValues, validating the pointer index only
+    // once. Used by consumers like VelocityTracker that walk every sample.
+    void getHistoricalAxisValues(int32_t axis, size_t pointerIndex,
+                                 std::vector<float>& outValues) const;
+
     inline float getHistoricalX(size_t pointerIndex, size_t historicalIndex) const {
         return getHistoricalAxisValue(
                 AMOTION_EVENT_AXIS_X, pointerIndex, historicalIndex);
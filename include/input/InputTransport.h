@@ -449,9 +449,28 @@ public:
      */
     android::base::Result<ConsumerResponse> receiveConsumerResponse();
 
+    /* Returns the current size of the channel's socket send buffer, in bytes. */
+    inline size_t getSendBufferSize() const { return mSendBufferSize; }
+
+    /* Returns how many times the send buffer has grown because the channel filled up,
+     * i.e. the high-water telemetry for this connection. */
+    inline uint32_t getSendBufferGrowCount() const { return mSendBufferGrowCount; }
+
 private:
+    /* Sends a message, adaptively growing the socket send buffer when the channel
+     * fills up. */
+    status_t sendMessage(const InputMessage& msg);
+
+    /* Decays a grown send buffer back toward the default once the consumer has kept
+     * up for a while, so idle connections do not pin kernel memory. */
+    void shrinkSendBufferIfIdle();
+
     std::shared_ptr<InputChannel> mChannel;
     InputVerifier mInputVerifier;
+
+    size_t mSendBufferSize;
+    uint32_t mSendBufferGrowCount = 0;
+    nsecs_t mLastWouldBlockTime = 0;
 };
 
 } // namespace android
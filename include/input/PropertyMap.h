@@ -21,6 +21,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -62,17 +63,20 @@ public:
     void addProperty(const std::string& key, const std::string& value);
 
     /* Returns a set of all property keys starting with the given prefix. */
-    std::unordered_set<std::string> getKeysWithPrefix(const std::string& prefix) const;
+    std::unordered_set<std::string> getKeysWithPrefix(std::string_view prefix) const;
 
     /* Gets the value of a property and parses it. Returns nullopt if the key wasn't found or
      * couldn't be parsed as the requested type. (Warnings are also logged in the case of parsing
      * failures.)
+     *
+     * The key is taken as a string_view so that lookups with string literals do not allocate a
+     * temporary std::string.
      */
-    std::optional<std::string> getString(const std::string& key) const;
-    std::optional<bool> getBool(const std::string& key) const;
-    std::optional<int32_t> getInt(const std::string& key) const;
-    std::optional<float> getFloat(const std::string& key) const;
-    std::optional<double> getDouble(const std::string& key) const;
+    std::optional<std::string> getString(std::string_view key) const;
+    std::optional<bool> getBool(std::string_view key) const;
+    std::optional<int32_t> getInt(std::string_view key) const;
+    std::optional<float> getFloat(std::string_view key) const;
+    std::optional<double> getDouble(std::string_view key) const;
 
     /* Adds all values from the specified property map. */
     void addAll(const PropertyMap* map);
@@ -82,7 +86,7 @@ public:
 
 private:
     /* Returns true if the property map contains the specified key. */
-    bool hasProperty(const std::string& key) const;
+    bool hasProperty(std::string_view key) const;
 
     class Parser {
         PropertyMap* mMap;
@@ -101,7 +105,17 @@ private:
         status_t parseCharacterLiteral(char16_t* outCharacter);
     };
 
-    std::unordered_map<std::string, std::string> mProperties;
+    // Hashes std::string and std::string_view keys interchangeably so that lookups can be done
+    // without materializing a std::string.
+    struct TransparentStringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const {
+            return std::hash<std::string_view>()(key);
+        }
+    };
+
+    std::unordered_map<std::string, std::string, TransparentStringHash, std::equal_to<>>
+            mProperties;
 };
 
 } // namespace android
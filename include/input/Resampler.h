@@ -84,6 +84,7 @@ private:
 
         std::vector<PointerCoords> asPointerCoords() const {
             std::vector<PointerCoords> pointersCoords;
+            pointersCoords.reserve(pointers.size());
             for (const Pointer& pointer : pointers) {
                 pointersCoords.push_back(pointer.coords);
             }
@@ -120,6 +121,19 @@ private:
      */
     static bool pointerPropertiesResampleable(const Sample& target, const Sample& auxiliary);
 
+    /**
+     * Same check against an InputMessage that has not been converted to a Sample yet, so callers
+     * on the hot path do not have to pay for the conversion's pointer vector allocation.
+     */
+    static bool pointerPropertiesResampleable(const Sample& target, const InputMessage& auxiliary);
+
+    /**
+     * Checks a single target/auxiliary pointer pair for matching ID, matching toolType, and a
+     * resampleable toolType.
+     */
+    static bool pointerResampleable(const PointerProperties& target,
+                                    const PointerProperties& auxiliary);
+
     /**
      * Checks if there are necessary conditions to interpolate. For example, interpolation cannot
      * take place if samples are too far apart in time. mLatestSamples must have at least one sample
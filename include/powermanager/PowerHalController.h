@@ -68,6 +68,25 @@ public:
             int32_t tgid, int32_t uid, const std::vector<int32_t>& threadIds, int64_t durationNanos,
             aidl::android::hardware::power::SessionTag tag,
             aidl::android::hardware::power::SessionConfig* config) override;
+    // Creates one hint session per entry of threadIdsPerSession, acquiring the
+    // HAL handle once for the whole batch. Either all sessions are created or
+    // none: on failure the partial batch is closed before returning.
+    virtual HalResult<std::vector<std::shared_ptr<PowerHintSessionWrapper>>> createHintSessions(
+            int32_t tgid, int32_t uid, const std::vector<std::vector<int32_t>>& threadIdsPerSession,
+            int64_t durationNanos);
+    // Pre-arms paused hint sessions for the given process so a later
+    // acquireLaunchBoostSession only pays for setThreads/resume instead of the
+    // full session setup. The sessions are created against the process main
+    // thread as a placeholder, so this can run as soon as the pid is known.
+    // Replaces any sessions previously armed for a different process.
+    virtual void prepareLaunchBoostSessions(int32_t tgid, int32_t uid, size_t count,
+                                            int64_t durationNanos);
+    // Hands out a pre-armed session for the given process, retargeted to
+    // threadIds and resumed. Falls back to a regular createHintSession when no
+    // armed session matches or retargeting fails.
+    virtual HalResult<std::shared_ptr<PowerHintSessionWrapper>> acquireLaunchBoostSession(
+            int32_t tgid, int32_t uid, const std::vector<int32_t>& threadIds,
+            int64_t durationNanos);
     virtual HalResult<int64_t> getHintSessionPreferredRate() override;
     virtual HalResult<aidl::android::hardware::power::ChannelConfig> getSessionChannel(
             int tgid, int uid) override;
@@ -82,6 +101,13 @@ private:
     std::shared_ptr<HalWrapper> mConnectedHal GUARDED_BY(mConnectedHalMutex) = nullptr;
     const std::shared_ptr<HalWrapper> mDefaultHal = std::make_shared<EmptyHalWrapper>();
 
+    // Pre-armed launch-boost sessions, valid for a single process at a time.
+    std::mutex mSessionPoolMutex;
+    int32_t mPooledSessionTgid GUARDED_BY(mSessionPoolMutex) = -1;
+    int32_t mPooledSessionUid GUARDED_BY(mSessionPoolMutex) = -1;
+    std::vector<std::shared_ptr<PowerHintSessionWrapper>> mPooledSessions
+            GUARDED_BY(mSessionPoolMutex);
+
     std::shared_ptr<HalWrapper> initHal();
     template <typename T>
     HalResult<T> processHalResult(HalResult<T>&& result, const char* functionName);
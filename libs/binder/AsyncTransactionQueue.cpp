@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <binder/AsyncTransactionQueue.h>
+
+#include <algorithm>
+
+namespace android {
+
+AsyncTransactionQueue::AsyncTransactionQueue(size_t maxThreads)
+      : mMaxThreads(maxThreads > 0 ? maxThreads : 1) {}
+
+AsyncTransactionQueue::~AsyncTransactionQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShuttingDown = true;
+    }
+    mCondition.notify_all();
+    for (auto& thread : mThreads) {
+        thread.join();
+    }
+}
+
+std::unique_ptr<Parcel> AsyncTransactionQueue::obtainParcel() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mParcelPool.empty()) {
+            std::unique_ptr<Parcel> parcel = std::move(mParcelPool.back());
+            mParcelPool.pop_back();
+            return parcel;
+        }
+    }
+    return std::make_unique<Parcel>();
+}
+
+void AsyncTransactionQueue::transact(const sp<IBinder>& binder, uint32_t code,
+                                     std::unique_ptr<Parcel> data, Callback callback,
+                                     uint32_t flags) {
+    if (data == nullptr) {
+        data = std::make_unique<Parcel>();
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPending.push_back(Call{binder, code, std::move(data), std::move(callback), flags,
+                            std::this_thread::get_id()});
+    if (mIdleThreads == 0 && mThreads.size() < mMaxThreads) {
+        mThreads.emplace_back(&AsyncTransactionQueue::workerLoop, this);
+    } else {
+        mCondition.notify_one();
+    }
+}
+
+void AsyncTransactionQueue::recycleLocked(std::unique_ptr<Parcel> parcel) {
+    // The parcel's data must already have been freed by the caller, outside
+    // the lock; contained binder and fd references are released there.
+    if (mParcelPool.size() < 2 * mMaxThreads) {
+        mParcelPool.push_back(std::move(parcel));
+    }
+}
+
+void AsyncTransactionQueue::workerLoop() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        // Claim the oldest call whose submitter has no run in flight; calls
+        // from a claimed submitter are completed in order below.
+        auto it = std::find_if(mPending.begin(), mPending.end(), [this](const Call& call) {
+            return std::find(mBusySubmitters.begin(), mBusySubmitters.end(), call.submitter) ==
+                    mBusySubmitters.end();
+        });
+        if (it == mPending.end()) {
+            if (mShuttingDown) {
+                return;
+            }
+            mIdleThreads++;
+            mCondition.wait(lock);
+            mIdleThreads--;
+            continue;
+        }
+
+        const std::thread::id submitter = it->submitter;
+        mBusySubmitters.push_back(submitter);
+
+        std::unique_ptr<Parcel> reply;
+        if (!mParcelPool.empty()) {
+            reply = std::move(mParcelPool.back());
+            mParcelPool.pop_back();
+        }
+
+        // Drain this submitter's run, batching any calls it queues meanwhile.
+        while (it != mPending.end()) {
+            Call call = std::move(*it);
+            mPending.erase(it);
+            lock.unlock();
+
+            if (reply == nullptr) {
+                reply = std::make_unique<Parcel>();
+            }
+            const status_t status =
+                    call.binder->transact(call.code, *call.data, reply.get(), call.flags);
+            call.callback(status, *reply);
+
+            const bool poolData = call.data->dataCapacity() <= kMaxPooledParcelCapacity;
+            const bool poolReply = reply->dataCapacity() <= kMaxPooledParcelCapacity;
+            call.data->freeData();
+            reply->freeData();
+            if (!poolReply) {
+                reply.reset();
+            }
+
+            lock.lock();
+            if (poolData) {
+                recycleLocked(std::move(call.data));
+            }
+            it = std::find_if(mPending.begin(), mPending.end(), [submitter](const Call& call) {
+                return call.submitter == submitter;
+            });
+        }
+
+        if (reply != nullptr) {
+            recycleLocked(std::move(reply));
+        }
+        mBusySubmitters.erase(
+                std::find(mBusySubmitters.begin(), mBusySubmitters.end(), submitter));
+    }
+}
+
+} // namespace android
@@ -189,6 +189,44 @@ binder::Status BackendUnifiedServiceManager::checkService(const ::std::string& n
     return status;
 }
 
+binder::Status BackendUnifiedServiceManager::checkServices(const ::std::vector<::std::string>& names,
+                                                           ::std::vector<os::Service>* _aidl_return) {
+    binder::Status status = mTheRealServiceManager->checkServices(names, _aidl_return);
+    if (!status.isOk()) {
+        return status;
+    }
+    if (_aidl_return->size() != names.size()) {
+        ALOGE("checkServices returned %zu services for %zu names", _aidl_return->size(),
+              names.size());
+        return binder::Status::fromStatusT(BAD_VALUE);
+    }
+    for (size_t i = 0; i < names.size(); i++) {
+        os::Service service;
+        status = toBinderService(names[i], (*_aidl_return)[i], &service);
+        if (!status.isOk()) {
+            return status;
+        }
+        (*_aidl_return)[i] = std::move(service);
+        updateCache(names[i], (*_aidl_return)[i]);
+    }
+    return binder::Status::ok();
+}
+
+binder::Status BackendUnifiedServiceManager::preloadCache() {
+    if (!kUseCache) {
+        return binder::Status::ok();
+    }
+    std::vector<std::string> names;
+    names.reserve(std::size(kStaticCachableList));
+    for (const char* name : kStaticCachableList) {
+        names.emplace_back(name);
+    }
+    // Seeding goes through updateCache, so only services that are registered, alive and
+    // cachable end up in the cache; everything else keeps its lazy lookup path.
+    std::vector<os::Service> services;
+    return checkServices(names, &services);
+}
+
 binder::Status BackendUnifiedServiceManager::toBinderService(const ::std::string& name,
                                                              const os::Service& in,
                                                              os::Service* _out) {
@@ -107,6 +107,8 @@ public:
     binder::Status getService(const ::std::string& name, sp<IBinder>* _aidl_return) override;
     binder::Status getService2(const ::std::string& name, os::Service* out) override;
     binder::Status checkService(const ::std::string& name, os::Service* out) override;
+    binder::Status checkServices(const ::std::vector<::std::string>& names,
+                                 ::std::vector<os::Service>* _aidl_return) override;
     binder::Status addService(const ::std::string& name, const sp<IBinder>& service,
                               bool allowIsolated, int32_t dumpPriority) override;
     binder::Status listServices(int32_t dumpPriority,
@@ -130,6 +132,12 @@ public:
                                         const sp<IBinder>& service) override;
     binder::Status getServiceDebugInfo(::std::vector<os::ServiceDebugInfo>* _aidl_return) override;
 
+    /**
+     * Seeds the client-side getService cache with every cachable service that is currently
+     * registered, using a single batched checkServices call. No-op if the cache is disabled.
+     */
+    binder::Status preloadCache();
+
     // for legacy ABI
     const String16& getInterfaceDescriptor() const override {
         return mTheRealServiceManager->getInterfaceDescriptor();
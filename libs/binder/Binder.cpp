@@ -291,6 +291,10 @@ public:
     BpBinder::ObjectManager mObjects;
 
     unique_fd mRecordingFd;
+    // Record every Nth transaction. 1 records everything. Kept alongside a
+    // running count so sampled recording stays cheap on the transact path.
+    uint32_t mRecordingSampleInterval = 1;
+    uint32_t mRecordingTransactionCount = 0;
 };
 
 // ---------------------------------------------------------------------------
@@ -331,6 +335,14 @@ status_t BBinder::startRecordingTransactions(const Parcel& data) {
         if (readStatus != OK) {
             return readStatus;
         }
+        // Optional trailing sampling interval: record every Nth transaction.
+        // Older clients don't write it, in which case record everything.
+        int32_t sampleInterval = 1;
+        if (data.readInt32(&sampleInterval) != OK || sampleInterval < 1) {
+            sampleInterval = 1;
+        }
+        e->mRecordingSampleInterval = static_cast<uint32_t>(sampleInterval);
+        e->mRecordingTransactionCount = 0;
         mRecordingOn = true;
         ALOGI("Started Binder recording.");
         return NO_ERROR;
@@ -421,7 +433,7 @@ status_t BBinder::transact(
     if (kEnableKernelIpc && mRecordingOn && code != START_RECORDING_TRANSACTION) [[unlikely]] {
         Extras* e = mExtras.load(std::memory_order_acquire);
         RpcMutexUniqueLock lock(e->mLock);
-        if (mRecordingOn) {
+        if (mRecordingOn && (e->mRecordingTransactionCount++ % e->mRecordingSampleInterval) == 0) {
             Parcel emptyReply;
             timespec ts;
             timespec_get(&ts, TIME_UTC);
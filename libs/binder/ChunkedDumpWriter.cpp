@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <binder/ChunkedDumpWriter.h>
+
+#include "file.h"
+
+#include <errno.h>
+#include <fcntl.h>
+
+namespace android {
+
+using binder::WriteFully;
+
+ChunkedDumpWriter::ChunkedDumpWriter(int fd, size_t maxBufferedBytes)
+      : mMaxBufferedBytes(maxBufferedBytes), mFd(fcntl(fd, F_DUPFD_CLOEXEC, 0)) {
+    if (!mFd.ok()) {
+        mError = -errno;
+        mDone = true;
+        mWriterJoined = true;
+        return;
+    }
+    mWriter = RpcMaybeThread(&ChunkedDumpWriter::writerLoop, this);
+}
+
+ChunkedDumpWriter::~ChunkedDumpWriter() {
+    finish();
+}
+
+void ChunkedDumpWriter::write(std::string chunk) {
+    if (chunk.empty()) {
+        return;
+    }
+    RpcMutexUniqueLock lock(mLock);
+    if (mDone || mError != OK) {
+        return;
+    }
+#ifndef BINDER_RPC_SINGLE_THREADED
+    // Flow control: hold the producer, not the pipe, when the reader lags.
+    // In single-threaded builds the writer only runs at finish(), so the
+    // budget cannot be enforced and the queue is allowed to grow.
+    mProducerCv.wait(lock, [this] { return mBufferedBytes < mMaxBufferedBytes || mError != OK; });
+    if (mError != OK) {
+        return;
+    }
+#endif
+    mBufferedBytes += chunk.size();
+    mChunks.push_back(std::move(chunk));
+    mWriterCv.notify_one();
+}
+
+void ChunkedDumpWriter::writerLoop() {
+    RpcMutexUniqueLock lock(mLock);
+    while (true) {
+        mWriterCv.wait(lock, [this] { return !mChunks.empty() || mDone; });
+        if (mChunks.empty()) {
+            return;
+        }
+        std::string chunk = std::move(mChunks.front());
+        mChunks.pop_front();
+        lock.unlock();
+        const bool written = WriteFully(mFd, chunk.data(), chunk.size());
+        lock.lock();
+        mBufferedBytes -= chunk.size();
+        if (!written) {
+            // Typically EPIPE from a reader that went away. Drop what is
+            // left; write() stops queueing once it sees the error.
+            mError = (errno != 0) ? -errno : UNKNOWN_ERROR;
+            mChunks.clear();
+            mBufferedBytes = 0;
+            mProducerCv.notify_all();
+            return;
+        }
+        mProducerCv.notify_all();
+    }
+}
+
+status_t ChunkedDumpWriter::finish() {
+    {
+        RpcMutexLockGuard lock(mLock);
+        mDone = true;
+    }
+    mWriterCv.notify_one();
+    if (!mWriterJoined) {
+        mWriterJoined = true;
+        mWriter.join();
+    }
+    RpcMutexLockGuard lock(mLock);
+    return mError;
+}
+
+} // namespace android
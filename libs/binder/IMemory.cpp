@@ -352,6 +352,14 @@ void BpMemoryHeap::assertReallyMapped() const
                         IInterface::asBinder(this).get(), size, fd, strerror(errno));
                 close(fd);
             } else {
+#ifdef MADV_HUGEPAGE
+                // Ask for transparent hugepages on large heaps to cut TLB
+                // pressure in processes streaming media buffers; the kernel
+                // ignores the hint when THP cannot back the mapping.
+                if (size >= 2 * 1024 * 1024) {
+                    madvise(mBase, size, MADV_HUGEPAGE);
+                }
+#endif
                 mSize = size;
                 mFlags = flags;
                 mOffset = offset;
@@ -120,6 +120,17 @@ static const char* kCommandStrings[] = {
 
 static const int64_t kWorkSourcePropagatedBitIndex = 32;
 
+// Ceiling for growing mIn when the driver keeps filling the whole receive buffer.
+static const size_t kMaxReceiveBufferCapacity = 8 * 1024;
+
+// Ceiling for the per-thread reply high-water mark, so one huge reply does not pin
+// oversized reply buffers on the thread forever.
+static const size_t kReplyHighWaterCap = 64 * 1024;
+
+// Batched oneway payload bytes after which the batch is flushed automatically and the
+// overflow callback, if any, is invoked.
+static const size_t kOnewayBatchFlushBytes = 16 * 1024;
+
 static const char* getReturnString(uint32_t cmd)
 {
     size_t idx = cmd & _IOC_NRMASK;
@@ -607,6 +618,31 @@ ProcessState::CallRestriction IPCThreadState::getCallRestriction() const {
     return mCallRestriction;
 }
 
+void IPCThreadState::setParcelArenaEnabled(bool enabled) {
+    if (mParcelArenaEnabled == enabled) return;
+    mParcelArenaEnabled = enabled;
+    Parcel::setThreadArenaEnabled(enabled);
+}
+
+bool IPCThreadState::isParcelArenaEnabled() const {
+    return mParcelArenaEnabled;
+}
+
+void IPCThreadState::setOnewayBatchingEnabled(bool enabled) {
+    if (mOnewayBatchingEnabled && !enabled) {
+        flushCommands();
+    }
+    mOnewayBatchingEnabled = enabled;
+}
+
+bool IPCThreadState::isOnewayBatchingEnabled() const {
+    return mOnewayBatchingEnabled;
+}
+
+void IPCThreadState::setOnewayBatchOverflowCallback(std::function<void(size_t)> callback) {
+    mOnewayBatchOverflowCallback = std::move(callback);
+}
+
 void IPCThreadState::restoreCallingIdentity(int64_t token)
 {
     mCallingUid = unpackCallingUid(token);
@@ -688,6 +724,11 @@ status_t IPCThreadState::getAndExecuteCommand()
         }
 
         size_t newThreadsCount = mProcess->mExecutingThreadsCount.fetch_add(1) + 1;
+        size_t peak = mProcess->mExecutingThreadsPeak.load(std::memory_order_relaxed);
+        while (newThreadsCount > peak &&
+               !mProcess->mExecutingThreadsPeak.compare_exchange_weak(peak, newThreadsCount,
+                                                                      std::memory_order_relaxed)) {
+        }
         if (newThreadsCount >= mProcess->mMaxThreads) {
             auto expected = ProcessState::never();
             mProcess->mStarvationStartTime
@@ -703,6 +744,9 @@ status_t IPCThreadState::getAndExecuteCommand()
                     mProcess->mStarvationStartTime.exchange(ProcessState::never());
             if (starvationStartTime != ProcessState::never()) {
                 auto starvationTime = std::chrono::steady_clock::now() - starvationStartTime;
+                mProcess->mStarvationCount.fetch_add(1, std::memory_order_relaxed);
+                mProcess->mStarvationTimeMs.fetch_add(to_ms(starvationTime),
+                                                      std::memory_order_relaxed);
                 if (starvationTime > 100ms) {
                     ALOGE("binder thread pool (%zu threads) starved for %" PRId64 " ms", maxThreads,
                           to_ms(starvationTime));
@@ -866,6 +910,17 @@ status_t IPCThreadState::transact(int32_t handle,
 
     LOG_ONEWAY(">>>> SEND from pid %d uid %d %s", getpid(), getuid(),
         (flags & TF_ONE_WAY) == 0 ? "READ REPLY" : "ONE WAY");
+
+    if ((flags & TF_ONE_WAY) != 0 && mOnewayBatchingEnabled) [[unlikely]] {
+        if (data.objectsCount() == 0 && data.ipcBufferSize() == 0) {
+            return (mLastError = queueOnewayTransaction(handle, code, data, flags));
+        }
+        // Transactions carrying objects or scatter-gather buffers reference caller-owned
+        // state the driver must read before transact() returns, so they bypass the batch.
+        // Flush first to preserve ordering with already-queued oneway calls.
+        flushCommands();
+    }
+
     err = writeTransactionData(BC_TRANSACTION, flags, handle, code, data, nullptr);
 
     if (err != NO_ERROR) {
@@ -923,6 +978,26 @@ status_t IPCThreadState::transact(int32_t handle,
     return err;
 }
 
+status_t IPCThreadState::queueOnewayTransaction(int32_t handle, uint32_t code, const Parcel& data,
+                                                uint32_t flags) {
+    // writeTransactionData() records a pointer to the payload that the driver dereferences
+    // at ioctl time, so the batch is built against copies this thread owns until
+    // talkWithDriver() consumes mOut.
+    auto owned = std::make_unique<Parcel>();
+    status_t err = owned->appendFrom(&data, 0, data.dataSize());
+    if (err != NO_ERROR) return err;
+    err = writeTransactionData(BC_TRANSACTION, flags, handle, code, *owned, nullptr);
+    if (err != NO_ERROR) return err;
+    mBatchedOnewayBytes += owned->dataSize();
+    mBatchedOnewayData.push_back(std::move(owned));
+    if (mBatchedOnewayBytes >= kOnewayBatchFlushBytes) {
+        const size_t queuedBytes = mBatchedOnewayBytes;
+        flushCommands();
+        if (mOnewayBatchOverflowCallback) mOnewayBatchOverflowCallback(queuedBytes);
+    }
+    return NO_ERROR;
+}
+
 void IPCThreadState::incStrongHandle(int32_t handle, BpBinder *proxy)
 {
     LOG_REMOTEREFS("IPCThreadState::incStrongHandle(%d)\n", handle);
@@ -1030,7 +1105,11 @@ IPCThreadState::IPCThreadState()
         mIsFlushing(false),
         mStrictModePolicy(0),
         mLastTransactionBinderFlags(0),
-        mCallRestriction(mProcess->mCallRestriction) {
+        mCallRestriction(mProcess->mCallRestriction),
+        mParcelArenaEnabled(false),
+        mReplyDataHighWater(0),
+        mOnewayBatchingEnabled(false),
+        mBatchedOnewayBytes(0) {
     pthread_setspecific(gTLS, this);
     clearCaller();
     mHasExplicitIdentity = false;
@@ -1255,11 +1334,26 @@ status_t IPCThreadState::talkWithDriver(bool doReceive)
             } else {
                 mOut.setDataSize(0);
                 processPostWriteDerefs();
+                if (!mBatchedOnewayData.empty()) [[unlikely]] {
+                    // The driver has consumed the queued oneway transactions, so their
+                    // payload copies can be released.
+                    mBatchedOnewayData.clear();
+                    mBatchedOnewayBytes = 0;
+                }
             }
         }
         if (bwr.read_consumed > 0) {
             mIn.setDataSize(bwr.read_consumed);
             mIn.setDataPosition(0);
+            // If another transaction command would not have fit, the driver likely has more
+            // commands pending. Grow so command bursts, e.g. completions from a oneway
+            // flood, drain in fewer ioctls.
+            const size_t largestCommand =
+                    sizeof(int32_t) + sizeof(binder_transaction_data_secctx);
+            if (bwr.read_consumed + largestCommand > mIn.dataCapacity() &&
+                mIn.dataCapacity() < kMaxReceiveBufferCapacity) {
+                mIn.setDataCapacity(mIn.dataCapacity() * 2);
+            }
         }
         IF_LOG_COMMANDS() {
             std::ostringstream logStream;
@@ -1306,8 +1400,20 @@ status_t IPCThreadState::writeTransactionData(int32_t cmd, uint32_t binderFlags,
         return (mLastError = err);
     }
 
-    mOut.writeInt32(cmd);
-    mOut.write(&tr, sizeof(tr));
+    // Transactions carrying writeExternal() buffers go out as scatter-gather
+    // commands so the driver copies those buffers straight from the caller's
+    // memory instead of from an intermediate copy in the parcel.
+    const size_t buffersSize = (err == NO_ERROR) ? data.ipcBufferSize() : 0;
+    if (buffersSize > 0 && (cmd == BC_TRANSACTION || cmd == BC_REPLY)) {
+        binder_transaction_data_sg tr_sg;
+        tr_sg.transaction_data = tr;
+        tr_sg.buffers_size = buffersSize;
+        mOut.writeInt32(cmd == BC_TRANSACTION ? (int32_t)BC_TRANSACTION_SG : (int32_t)BC_REPLY_SG);
+        mOut.write(&tr_sg, sizeof(tr_sg));
+    } else {
+        mOut.writeInt32(cmd);
+        mOut.write(&tr, sizeof(tr));
+    }
 
     return NO_ERROR;
 }
@@ -1319,6 +1425,56 @@ void IPCThreadState::setTheContextObject(const sp<BBinder>& obj)
     the_context_object = obj;
 }
 
+// Saved scheduling state of a pool thread, so a ProcessState::ThreadServicePolicy applied for
+// the duration of one incoming call can be undone before the thread returns to the pool.
+struct SavedThreadSchedState {
+    bool affinityChanged = false;
+    cpu_set_t affinity;
+    bool schedChanged = false;
+    int schedPolicy;
+    sched_param schedParam;
+};
+
+static void applyThreadServicePolicy(const ProcessState::ThreadServicePolicy& policy,
+                                     SavedThreadSchedState& saved) {
+    if (policy.cpuAffinityMask != 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++) {
+            if (policy.cpuAffinityMask & (1ULL << cpu)) CPU_SET(cpu, &set);
+        }
+        if (sched_getaffinity(0, sizeof(saved.affinity), &saved.affinity) == 0 &&
+            sched_setaffinity(0, sizeof(set), &set) == 0) {
+            saved.affinityChanged = true;
+        } else {
+            ALOGW("Unable to apply binder thread affinity %#" PRIx64 ": %s",
+                  policy.cpuAffinityMask, strerror(errno));
+        }
+    }
+    if (policy.schedPolicy != -1) {
+        saved.schedPolicy = sched_getscheduler(0);
+        if (saved.schedPolicy >= 0 && sched_getparam(0, &saved.schedParam) == 0) {
+            sched_param param = {};
+            param.sched_priority = policy.schedPriority;
+            if (sched_setscheduler(0, policy.schedPolicy, &param) == 0) {
+                saved.schedChanged = true;
+            } else {
+                ALOGW("Unable to apply binder thread scheduler %d prio %d: %s",
+                      policy.schedPolicy, policy.schedPriority, strerror(errno));
+            }
+        }
+    }
+}
+
+static void restoreThreadSchedState(const SavedThreadSchedState& saved) {
+    if (saved.schedChanged) {
+        sched_setscheduler(0, saved.schedPolicy, &saved.schedParam);
+    }
+    if (saved.affinityChanged) {
+        sched_setaffinity(0, sizeof(saved.affinity), &saved.affinity);
+    }
+}
+
 status_t IPCThreadState::executeCommand(int32_t cmd)
 {
     BBinder* obj;
@@ -1450,6 +1606,11 @@ status_t IPCThreadState::executeCommand(int32_t cmd)
             //    (mCallingSid ? mCallingSid : "<N/A>"), mCallingUid);
 
             Parcel reply;
+            if (mReplyDataHighWater > 0 && (tr.flags & TF_ONE_WAY) == 0) {
+                // Pre-size to this thread's typical reply, so building the reply does not
+                // walk the doubling realloc chain on every synchronous transaction.
+                reply.setDataCapacity(mReplyDataHighWater);
+            }
             status_t error;
             IF_LOG_TRANSACTIONS() {
                 std::ostringstream logStream;
@@ -1467,9 +1628,17 @@ status_t IPCThreadState::executeCommand(int32_t cmd)
                 // safely acquire a strong reference before doing anything else with it.
                 if (reinterpret_cast<RefBase::weakref_type*>(
                         tr.target.ptr)->attemptIncStrong(this)) {
-                    error = reinterpret_cast<BBinder*>(tr.cookie)->transact(tr.code, buffer,
-                            &reply, tr.flags);
-                    reinterpret_cast<BBinder*>(tr.cookie)->decStrong(this);
+                    BBinder* target = reinterpret_cast<BBinder*>(tr.cookie);
+                    SavedThreadSchedState savedSched;
+                    if (mProcess->hasThreadServicePolicies()) {
+                        if (auto policy = mProcess->getThreadServicePolicy(
+                                    target->getInterfaceDescriptor())) {
+                            applyThreadServicePolicy(*policy, savedSched);
+                        }
+                    }
+                    error = target->transact(tr.code, buffer, &reply, tr.flags);
+                    restoreThreadSchedState(savedSched);
+                    target->decStrong(this);
                 } else {
                     error = UNKNOWN_TRANSACTION;
                 }
@@ -1492,6 +1661,11 @@ status_t IPCThreadState::executeCommand(int32_t cmd)
                 // be freed for the client.
                 buffer.setDataSize(0);
 
+                if (reply.dataSize() > mReplyDataHighWater &&
+                    reply.dataSize() <= kReplyHighWaterCap) {
+                    mReplyDataHighWater = reply.dataSize();
+                }
+
                 constexpr uint32_t kForwardReplyFlags = TF_CLEAR_BUF;
                 sendReply(reply, (tr.flags & kForwardReplyFlags));
             } else {
@@ -1577,6 +1751,12 @@ status_t IPCThreadState::executeCommand(int32_t cmd)
     case BR_NOOP:
         break;
 
+    case BR_TRANSACTION_COMPLETE:
+        // Oneway transactions batched by queueOnewayTransaction() may be flushed by a
+        // thread that then enters the looper, in which case their completes are delivered
+        // here rather than to waitForResponse(). There is nothing to do.
+        break;
+
     case BR_SPAWN_LOOPER:
         mProcess->spawnPooledThread(false);
         break;
@@ -301,6 +301,13 @@ sp<IServiceManager> defaultServiceManager()
     return gDefaultServiceManager;
 }
 
+void preloadCachedServices() {
+    binder::Status status = getBackendUnifiedServiceManager()->preloadCache();
+    if (!status.isOk()) {
+        ALOGW("Failed to preload service cache: %s", status.toString8().c_str());
+    }
+}
+
 void setDefaultServiceManager(const sp<IServiceManager>& sm) {
     bool called = false;
     std::call_once(gSmOnce, [&]() {
@@ -117,6 +117,26 @@ constexpr size_t kMaxFds = 1024;
 // Maximum size of a blob to transfer in-place.
 [[maybe_unused]] static const size_t BLOB_INPLACE_LIMIT = 16 * 1024;
 
+// Minimum size of an ashmem blob before we bother advising the kernel about
+// its mapping. Media metadata payloads commonly run 1-8MB and are mmap'd
+// fresh on both sides, so they pay the full fault cost per transfer.
+[[maybe_unused]] static const size_t BLOB_ADVISE_LIMIT = 1 * 1024 * 1024;
+
+// Hints the kernel about a freshly mmap'd large blob region. On the writer we
+// ask for transparent huge pages so the fill faults in 2MB chunks instead of
+// 4KB ones; on the reader we additionally request readahead so the pages are
+// populated before the consumer walks the payload. Best effort only: madvise
+// failures (old kernels, THP disabled for shmem) are ignored.
+[[maybe_unused]] static void adviseBlobMapping(void* ptr, size_t len, bool willRead) {
+    if (len < BLOB_ADVISE_LIMIT) return;
+#if defined(MADV_HUGEPAGE)
+    (void)::madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+    if (willRead) {
+        (void)::madvise(ptr, len, MADV_WILLNEED);
+    }
+}
+
 #if defined(__BIONIC__)
 static void FdTag(int fd, const void* old_addr, const void* new_addr) {
     if (android_fdsan_exchange_owner_tag) {
@@ -178,6 +198,10 @@ static void acquire_object(const sp<ProcessState>& proc, const flat_binder_objec
             }
             return;
         }
+        case BINDER_TYPE_PTR: {
+            // scatter-gather buffer reference; nothing to acquire
+            return;
+        }
     }
 
     ALOGD("Invalid object type 0x%08x", obj.hdr.type);
@@ -193,10 +217,16 @@ static void release_object(const sp<ProcessState>& proc, const flat_binder_objec
             }
             return;
         case BINDER_TYPE_HANDLE: {
-            const sp<IBinder> b = proc->getStrongProxyForHandle(obj.handle);
+            // The reference being released here was taken in acquire_object, so the
+            // proxy is pinned and can be looked up without the create-and-release
+            // refcount traffic of getStrongProxyForHandle.
+            IBinder* b = proc->getExistingProxyForHandle(obj.handle);
             if (b != nullptr) {
-                LOG_REFS("Parcel %p releasing reference on remote %p", who, b.get());
+                LOG_REFS("Parcel %p releasing reference on remote %p", who, b);
                 b->decStrong(who);
+            } else {
+                ALOGE("Parcel %p releasing reference on missing proxy for handle %d", who,
+                      obj.handle);
             }
             return;
         }
@@ -208,6 +238,10 @@ static void release_object(const sp<ProcessState>& proc, const flat_binder_objec
             }
             return;
         }
+        case BINDER_TYPE_PTR: {
+            // scatter-gather buffer reference; nothing to release
+            return;
+        }
     }
 
     ALOGE("Invalid object type 0x%08x", obj.hdr.type);
@@ -469,8 +503,9 @@ void Parcel::setDataPosition(size_t pos) const
 
     mDataPos = pos;
     if (const auto* kernelFields = maybeKernelFields()) {
+        // Moving the read cursor does not reorder the object array, so mObjectsSorted stays
+        // valid; only the scan hint is positional.
         kernelFields->mNextObjectHint = 0;
-        kernelFields->mObjectsSorted = false;
     }
 }
 
@@ -594,6 +629,9 @@ status_t Parcel::appendFrom(const Parcel* parcel, size_t offset, size_t len) {
             int idx = kernelFields->mObjectsSize;
             for (int i = firstIndex; i <= lastIndex; i++) {
                 size_t off = objects[i] - offset + startPos;
+                if (idx > 0 && kernelFields->mObjects[idx - 1] > off) {
+                    kernelFields->mObjectsSorted = false;
+                }
                 kernelFields->mObjects[idx++] = off;
                 kernelFields->mObjectsSize++;
 
@@ -611,6 +649,14 @@ status_t Parcel::appendFrom(const Parcel* parcel, size_t offset, size_t len) {
                     }
                 }
 
+                if (flat->hdr.type == BINDER_TYPE_PTR) {
+                    // A writeExternal() record: account its aligned payload so
+                    // ipcBufferSize() covers the appended scatter-gather
+                    // buffers and the driver receives a correct buffers_size.
+                    const auto* buf = reinterpret_cast<const binder_buffer_object*>(flat);
+                    kernelFields->mExternalBufferSize += (buf->length + 7) & ~size_t{7};
+                }
+
                 acquire_object(proc, *flat, this);
             }
         }
@@ -1709,6 +1755,7 @@ status_t Parcel::writeBlob(size_t len, bool mutableCopy, WritableBlob* outBlob)
         if (ptr == MAP_FAILED) {
             status = -errno;
         } else {
+            adviseBlobMapping(ptr, len, false /*willRead*/);
             if (!mutableCopy) {
                 result = ashmem_set_prot_region(fd, PROT_READ);
             }
@@ -1768,12 +1815,19 @@ status_t Parcel::write(const FlattenableHelperInterface& val)
     if (buf == nullptr)
         return BAD_VALUE;
 
+    // Transaction-heavy clients flatten dozens of single-fd fences per frame,
+    // so keep small fd arrays on the stack instead of the heap.
+    int inlineFds[4];
     int* fds = nullptr;
     if (fd_count) {
-        fds = new (std::nothrow) int[fd_count];
-        if (fds == nullptr) {
-            ALOGE("write: failed to allocate requested %zu fds", fd_count);
-            return BAD_VALUE;
+        if (fd_count <= std::size(inlineFds)) {
+            fds = inlineFds;
+        } else {
+            fds = new (std::nothrow) int[fd_count];
+            if (fds == nullptr) {
+                ALOGE("write: failed to allocate requested %zu fds", fd_count);
+                return BAD_VALUE;
+            }
         }
     }
 
@@ -1782,7 +1836,7 @@ status_t Parcel::write(const FlattenableHelperInterface& val)
         err = this->writeDupFileDescriptor( fds[i] );
     }
 
-    if (fd_count) {
+    if (fds != nullptr && fds != inlineFds) {
         delete [] fds;
     }
 
@@ -1812,6 +1866,11 @@ restart_write:
 
         // Need to write meta-data?
         if (nullMetaData || val.binder != 0) {
+            if (kernelFields->mObjectsSize > 0 &&
+                kernelFields->mObjects[kernelFields->mObjectsSize - 1] > mDataPos) {
+                // An object written after rewinding the cursor lands out of order.
+                kernelFields->mObjectsSorted = false;
+            }
             kernelFields->mObjects[kernelFields->mObjectsSize] = mDataPos;
             acquire_object(ProcessState::self(), val, this);
             kernelFields->mObjectsSize++;
@@ -1845,6 +1904,68 @@ restart_write:
 #endif // BINDER_WITH_KERNEL_IPC
 }
 
+status_t Parcel::writeExternal(const void* buffer, size_t len)
+{
+    auto* kernelFields = maybeKernelFields();
+    if (kernelFields == nullptr) {
+        // RPC parcels have no scatter-gather transport; fall back to a copy.
+        if (status_t status = writeUint64(len); status != OK) return status;
+        return write(buffer, len);
+    }
+
+#ifdef BINDER_WITH_KERNEL_IPC
+    if (len > INT32_MAX) {
+        // don't accept size_t values which may have come from an
+        // inadvertent conversion from a negative int.
+        return BAD_VALUE;
+    }
+
+    binder_buffer_object obj{};
+    obj.hdr.type = BINDER_TYPE_PTR;
+    obj.flags = 0;
+    obj.buffer = reinterpret_cast<binder_uintptr_t>(buffer);
+    obj.length = len;
+
+    // Mirror writeObject()'s bookkeeping, but for a binder_buffer_object:
+    // the record lands in the data stream and its position in the object
+    // list, so the driver copies straight from the caller-owned buffer when
+    // the transaction is sent.
+    if (mDataPos + sizeof(obj) > mDataCapacity) {
+        const status_t err = growData(sizeof(obj));
+        if (err != NO_ERROR) return err;
+    }
+    if (kernelFields->mObjectsSize >= kernelFields->mObjectsCapacity) {
+        if (kernelFields->mObjectsSize > SIZE_MAX - 2) return NO_MEMORY;       // overflow
+        if ((kernelFields->mObjectsSize + 2) > SIZE_MAX / 3) return NO_MEMORY; // overflow
+        size_t newSize = ((kernelFields->mObjectsSize + 2) * 3) / 2;
+        if (newSize > SIZE_MAX / sizeof(binder_size_t)) return NO_MEMORY; // overflow
+        binder_size_t* objects =
+                (binder_size_t*)realloc(kernelFields->mObjects, newSize * sizeof(binder_size_t));
+        if (objects == nullptr) return NO_MEMORY;
+        kernelFields->mObjects = objects;
+        kernelFields->mObjectsCapacity = newSize;
+    }
+
+    *reinterpret_cast<binder_buffer_object*>(mData + mDataPos) = obj;
+    if (kernelFields->mObjectsSize > 0 &&
+        kernelFields->mObjects[kernelFields->mObjectsSize - 1] > mDataPos) {
+        kernelFields->mObjectsSorted = false;
+    }
+    kernelFields->mObjects[kernelFields->mObjectsSize] = mDataPos;
+    kernelFields->mObjectsSize++;
+
+    // The driver lays scatter-gather buffers out at 8-byte granularity.
+    kernelFields->mExternalBufferSize += (len + 7) & ~size_t{7};
+
+    return finishWrite(sizeof(obj));
+#else  // BINDER_WITH_KERNEL_IPC
+    LOG_ALWAYS_FATAL("Binder kernel driver disabled at build time");
+    (void)buffer;
+    (void)len;
+    return INVALID_OPERATION;
+#endif // BINDER_WITH_KERNEL_IPC
+}
+
 status_t Parcel::writeNoException()
 {
     binder::Status status;
@@ -1867,21 +1988,24 @@ status_t Parcel::validateReadData(size_t upperBound) const
         // Expect to check only against the next object
         if (kernelFields->mNextObjectHint < kernelFields->mObjectsSize &&
             upperBound > kernelFields->mObjects[kernelFields->mNextObjectHint]) {
-            // For some reason the current read position is greater than the next object
-            // hint. Iterate until we find the right object
-            size_t nextObject = kernelFields->mNextObjectHint;
-            do {
-                if (mDataPos < kernelFields->mObjects[nextObject] + sizeof(flat_binder_object)) {
-                    // Requested info overlaps with an object
-                    if (!mServiceFuzzing) {
-                        ALOGE("Attempt to read from protected data in Parcel %p", this);
-                    }
-                    return PERMISSION_DENIED;
+            // The read is out of order with respect to the hint. Binary search for the first
+            // object not entirely before the read position; since the array is sorted, any
+            // object overlapping [mDataPos, upperBound) must be that one.
+            binder_size_t* const begin = kernelFields->mObjects;
+            binder_size_t* const end = begin + kernelFields->mObjectsSize;
+            binder_size_t* const firstObj =
+                    std::upper_bound(begin, end, mDataPos,
+                                     [](size_t pos, binder_size_t object) {
+                                         return pos < object + sizeof(flat_binder_object);
+                                     });
+            if (firstObj != end && upperBound > *firstObj) {
+                // Requested info overlaps with an object
+                if (!mServiceFuzzing) {
+                    ALOGE("Attempt to read from protected data in Parcel %p", this);
                 }
-                nextObject++;
-            } while (nextObject < kernelFields->mObjectsSize &&
-                     upperBound > kernelFields->mObjects[nextObject]);
-            kernelFields->mNextObjectHint = nextObject;
+                return PERMISSION_DENIED;
+            }
+            kernelFields->mNextObjectHint = static_cast<size_t>(firstObj - begin);
         }
         return NO_ERROR;
     }
@@ -2551,6 +2675,7 @@ status_t Parcel::readBlob(size_t len, ReadableBlob* outBlob) const
             MAP_SHARED, fd, 0);
     if (ptr == MAP_FAILED) return NO_MEMORY;
 
+    adviseBlobMapping(ptr, len, true /*willRead*/);
     outBlob->init(fd, ptr, len, isMutable);
     return NO_ERROR;
 #endif
@@ -2573,12 +2698,18 @@ status_t Parcel::read(FlattenableHelperInterface& val) const
     if (buf == nullptr)
         return BAD_VALUE;
 
+    // As in the write path, avoid a heap allocation for fence-sized fd counts.
+    int inlineFds[4];
     int* fds = nullptr;
     if (fd_count) {
-        fds = new (std::nothrow) int[fd_count];
-        if (fds == nullptr) {
-            ALOGE("read: failed to allocate requested %zu fds", fd_count);
-            return BAD_VALUE;
+        if (fd_count <= std::size(inlineFds)) {
+            fds = inlineFds;
+        } else {
+            fds = new (std::nothrow) int[fd_count];
+            if (fds == nullptr) {
+                ALOGE("read: failed to allocate requested %zu fds", fd_count);
+                return BAD_VALUE;
+            }
         }
     }
 
@@ -2600,7 +2731,7 @@ status_t Parcel::read(FlattenableHelperInterface& val) const
         err = val.unflatten(buf, len, fds, fd_count);
     }
 
-    if (fd_count) {
+    if (fds != nullptr && fds != inlineFds) {
         delete [] fds;
     }
 
@@ -2637,6 +2768,23 @@ const flat_binder_object* Parcel::readObject(bool nullMetaData) const
             ALOGV("Parcel %p looking for obj at %zu, hint=%zu",
                  this, DPOS, opos);
 
+            if (kernelFields->mObjectsSorted) {
+                // The object array is known sorted, so look the position up directly rather
+                // than scanning from the hint.
+                binder_size_t* const found = std::lower_bound(OBJS, OBJS + N, DPOS);
+                if (found != OBJS + N && *found == DPOS) {
+                    kernelFields->mNextObjectHint = static_cast<size_t>(found - OBJS) + 1;
+                    ALOGV("readObject Setting data pos of %p to %zu", this, mDataPos);
+                    return obj;
+                }
+                if (!mServiceFuzzing) {
+                    ALOGW("Attempt to read object from Parcel %p at offset %zu that is not in "
+                          "the object list",
+                          this, DPOS);
+                }
+                return nullptr;
+            }
+
             // Start at the current hint position, looking for an object at
             // the current data position.
             if (opos < N) {
@@ -2678,6 +2826,60 @@ const flat_binder_object* Parcel::readObject(bool nullMetaData) const
 }
 #endif // BINDER_WITH_KERNEL_IPC
 
+status_t Parcel::readExternal(const void** buffer, size_t* outLen) const
+{
+    const auto* kernelFields = maybeKernelFields();
+    if (kernelFields == nullptr) {
+        // Written as a length-prefixed copy on RPC parcels; hand out a view.
+        uint64_t len;
+        if (status_t status = readUint64(&len); status != OK) return status;
+        if (len > SIZE_MAX) return BAD_VALUE;
+        const void* data = readInplace(len);
+        if (data == nullptr) return NOT_ENOUGH_DATA;
+        *buffer = data;
+        *outLen = len;
+        return OK;
+    }
+
+#ifdef BINDER_WITH_KERNEL_IPC
+    const size_t DPOS = mDataPos;
+    if (DPOS + sizeof(binder_buffer_object) > mDataSize) {
+        return NOT_ENOUGH_DATA;
+    }
+    const auto* obj = reinterpret_cast<const binder_buffer_object*>(mData + DPOS);
+    if (obj->hdr.type != BINDER_TYPE_PTR) {
+        return BAD_TYPE;
+    }
+
+    // Only trust the (driver-translated) buffer pointer if the record is in
+    // the object list; anything else is plain data crafted by the sender.
+    bool found = false;
+    for (size_t i = 0; i < kernelFields->mObjectsSize; i++) {
+        if (kernelFields->mObjects[i] == DPOS) {
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        if (!mServiceFuzzing) {
+            ALOGW("Attempt to read external buffer from Parcel %p at offset %zu that is not in "
+                  "the object list",
+                  this, DPOS);
+        }
+        return BAD_VALUE;
+    }
+
+    mDataPos = DPOS + sizeof(binder_buffer_object);
+    *buffer = reinterpret_cast<const void*>(obj->buffer);
+    *outLen = obj->length;
+    return OK;
+#else  // BINDER_WITH_KERNEL_IPC
+    (void)buffer;
+    (void)outLen;
+    return INVALID_OPERATION;
+#endif // BINDER_WITH_KERNEL_IPC
+}
+
 void Parcel::closeFileDescriptors() {
     if (auto* kernelFields = maybeKernelFields()) {
 #ifdef BINDER_WITH_KERNEL_IPC
@@ -2729,6 +2931,14 @@ size_t Parcel::ipcObjectsCount() const
     return 0;
 }
 
+size_t Parcel::ipcBufferSize() const
+{
+    if (const auto* kernelFields = maybeKernelFields()) {
+        return kernelFields->mExternalBufferSize;
+    }
+    return 0;
+}
+
 void Parcel::ipcSetDataReference(const uint8_t* data, size_t dataSize, const binder_size_t* objects,
                                  size_t objectsCount, release_func relFunc) {
     // this code uses 'mOwner == nullptr' to understand whether it owns memory
@@ -2907,6 +3117,184 @@ void Parcel::acquireObjects()
 #endif // BINDER_WITH_KERNEL_IPC
 }
 
+static uint8_t* reallocZeroFree(uint8_t* data, size_t oldCapacity, size_t newCapacity, bool zero) {
+    if (!zero) {
+        return (uint8_t*)realloc(data, newCapacity);
+    }
+    uint8_t* newData = (uint8_t*)malloc(newCapacity);
+    if (!newData) {
+        return nullptr;
+    }
+
+    memcpy(newData, data, std::min(oldCapacity, newCapacity));
+    zeroMemory(data, oldCapacity);
+    free(data);
+    return newData;
+}
+
+// ---------------------------------------------------------------------------
+// Per-thread arena for transaction-sized Parcel buffers.
+//
+// When enabled via IPCThreadState::setParcelArenaEnabled(), Parcel data
+// buffers are carved out of a single reusable thread-local slab with a bump
+// pointer instead of going through malloc/realloc. Releasing the last
+// outstanding buffer rewinds the bump pointer, so a transaction cycle whose
+// parcels fit in the slab performs no heap allocation at all. Requests that
+// do not fit fall back to the heap transparently.
+//
+// Arena-backed parcels must be written, resized, and destroyed on the thread
+// that allocated them; this matches the intended use for request/reply
+// parcels owned by a single binder thread.
+
+struct ParcelArena {
+    explicit ParcelArena(size_t size) : slab(static_cast<uint8_t*>(malloc(size))), slabSize(size) {}
+
+    uint8_t* slab;
+    size_t slabSize;
+    size_t bump = 0;
+    // Number of carved buffers not yet freed. The slab is only rewound when
+    // this drops to zero, so interleaved parcel lifetimes stay safe.
+    size_t live = 0;
+    // Set when the owning thread disabled the arena or exited; the slab is
+    // freed once the last outstanding buffer is released.
+    bool retired = false;
+
+    void releaseIfIdle() {
+        if (live == 0) {
+            if (retired) {
+                free(slab);
+                delete this;
+            } else {
+                bump = 0;
+            }
+        }
+    }
+};
+
+// Carved buffers are preceded by a header so the free path can find the
+// owning arena without consulting thread-local state.
+struct ParcelArenaBlockHeader {
+    ParcelArena* arena;
+    size_t capacity;
+};
+
+constexpr size_t kParcelArenaBlockAlign = 16;
+static_assert(sizeof(ParcelArenaBlockHeader) <= kParcelArenaBlockAlign);
+constexpr size_t kParcelArenaSlabSize = 512 * 1024;
+
+struct ThreadParcelArenaSlot {
+    ParcelArena* arena = nullptr;
+    ~ThreadParcelArenaSlot() {
+        if (arena) {
+            arena->retired = true;
+            arena->releaseIfIdle();
+        }
+    }
+};
+static thread_local ThreadParcelArenaSlot gParcelArenaSlot;
+
+static size_t parcelArenaBlockFootprint(size_t size) {
+    return kParcelArenaBlockAlign +
+            ((size + kParcelArenaBlockAlign - 1) & ~(kParcelArenaBlockAlign - 1));
+}
+
+static ParcelArenaBlockHeader* parcelArenaBlockHeader(uint8_t* data) {
+    return reinterpret_cast<ParcelArenaBlockHeader*>(data - kParcelArenaBlockAlign);
+}
+
+// Allocates `size` bytes, preferring the calling thread's arena when one is
+// enabled and has room. `*arenaBacked` records where the buffer came from.
+static uint8_t* parcelAllocData(size_t size, bool* arenaBacked) {
+    *arenaBacked = false;
+    ParcelArena* arena = gParcelArenaSlot.arena;
+    if (arena == nullptr || arena->slab == nullptr) {
+        return static_cast<uint8_t*>(malloc(size));
+    }
+    const size_t footprint = parcelArenaBlockFootprint(size);
+    if (footprint > arena->slabSize - arena->bump) {
+        return static_cast<uint8_t*>(malloc(size));
+    }
+    uint8_t* base = arena->slab + arena->bump;
+    arena->bump += footprint;
+    arena->live++;
+    auto* header = reinterpret_cast<ParcelArenaBlockHeader*>(base);
+    header->arena = arena;
+    header->capacity = footprint - kParcelArenaBlockAlign;
+    *arenaBacked = true;
+    return base + kParcelArenaBlockAlign;
+}
+
+static void parcelFreeData(uint8_t* data, size_t dataSize, bool arenaBacked, bool zero) {
+    if (zero) {
+        zeroMemory(data, dataSize);
+    }
+    if (!arenaBacked) {
+        free(data);
+        return;
+    }
+    ParcelArena* arena = parcelArenaBlockHeader(data)->arena;
+    arena->live--;
+    arena->releaseIfIdle();
+}
+
+// Grows a Parcel data buffer, staying inside the arena when possible. The
+// most recently carved block can be extended in place; otherwise the data
+// moves to a fresh carve or to the heap.
+static uint8_t* parcelReallocData(uint8_t* data, size_t oldCapacity, size_t newCapacity,
+                                  bool* arenaBacked, bool zero) {
+    if (data == nullptr || !*arenaBacked) {
+        if (data != nullptr && gParcelArenaSlot.arena == nullptr) {
+            return reallocZeroFree(data, oldCapacity, newCapacity, zero);
+        }
+        bool newArenaBacked = false;
+        uint8_t* newData = parcelAllocData(newCapacity, &newArenaBacked);
+        if (newData == nullptr) return nullptr;
+        if (data != nullptr) {
+            memcpy(newData, data, std::min(oldCapacity, newCapacity));
+            parcelFreeData(data, oldCapacity, /*arenaBacked=*/false, zero);
+        }
+        *arenaBacked = newArenaBacked;
+        return newData;
+    }
+
+    ParcelArenaBlockHeader* header = parcelArenaBlockHeader(data);
+    ParcelArena* arena = header->arena;
+    const size_t oldFootprint = parcelArenaBlockFootprint(header->capacity);
+    if (arena == gParcelArenaSlot.arena && data - kParcelArenaBlockAlign + oldFootprint ==
+            arena->slab + arena->bump) {
+        // Top of the arena: extend in place if the slab has room.
+        const size_t newFootprint = parcelArenaBlockFootprint(newCapacity);
+        if (newFootprint <= arena->slabSize - (arena->bump - oldFootprint)) {
+            arena->bump += newFootprint - oldFootprint;
+            header->capacity = newFootprint - kParcelArenaBlockAlign;
+            return data;
+        }
+    }
+
+    bool newArenaBacked = false;
+    uint8_t* newData = parcelAllocData(newCapacity, &newArenaBacked);
+    if (newData == nullptr) return nullptr;
+    memcpy(newData, data, std::min(oldCapacity, newCapacity));
+    parcelFreeData(data, oldCapacity, /*arenaBacked=*/true, zero);
+    *arenaBacked = newArenaBacked;
+    return newData;
+}
+
+void Parcel::setThreadArenaEnabled(bool enabled) {
+    if (enabled) {
+        if (gParcelArenaSlot.arena == nullptr) {
+            gParcelArenaSlot.arena = new ParcelArena(kParcelArenaSlabSize);
+        }
+    } else if (gParcelArenaSlot.arena != nullptr) {
+        ParcelArena* arena = gParcelArenaSlot.arena;
+        gParcelArenaSlot.arena = nullptr;
+        arena->retired = true;
+        arena->releaseIfIdle();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 void Parcel::freeData()
 {
     freeDataNoInit();
@@ -2930,10 +3318,7 @@ void Parcel::freeDataNoInit()
             LOG_ALLOC("Parcel %p: freeing with %zu capacity", this, mDataCapacity);
             gParcelGlobalAllocSize -= mDataCapacity;
             gParcelGlobalAllocCount--;
-            if (mDeallocZero) {
-                zeroMemory(mData, mDataSize);
-            }
-            free(mData);
+            parcelFreeData(mData, mDataSize, mArenaBacked, mDeallocZero);
         }
         auto* kernelFields = maybeKernelFields();
         if (kernelFields && kernelFields->mObjects) free(kernelFields->mObjects);
@@ -2956,21 +3341,6 @@ status_t Parcel::growData(size_t len)
             : continueWrite(std::max(newSize, (size_t) 128));
 }
 
-static uint8_t* reallocZeroFree(uint8_t* data, size_t oldCapacity, size_t newCapacity, bool zero) {
-    if (!zero) {
-        return (uint8_t*)realloc(data, newCapacity);
-    }
-    uint8_t* newData = (uint8_t*)malloc(newCapacity);
-    if (!newData) {
-        return nullptr;
-    }
-
-    memcpy(newData, data, std::min(oldCapacity, newCapacity));
-    zeroMemory(data, oldCapacity);
-    free(data);
-    return newData;
-}
-
 status_t Parcel::restartWrite(size_t desired)
 {
     if (desired > INT32_MAX) {
@@ -2986,7 +3356,7 @@ status_t Parcel::restartWrite(size_t desired)
 
     releaseObjects();
 
-    uint8_t* data = reallocZeroFree(mData, mDataCapacity, desired, mDeallocZero);
+    uint8_t* data = parcelReallocData(mData, mDataCapacity, desired, &mArenaBacked, mDeallocZero);
     if (!data && desired > mDataCapacity) {
         LOG_ALWAYS_FATAL("out of memory");
         mError = NO_MEMORY;
@@ -3020,6 +3390,7 @@ status_t Parcel::restartWrite(size_t desired)
         kernelFields->mObjectsSorted = false;
         kernelFields->mHasFds = false;
         kernelFields->mFdsKnown = true;
+        kernelFields->mExternalBufferSize = 0;
     } else if (auto* rpcFields = maybeRpcFields()) {
         rpcFields->mObjectPositions.clear();
         rpcFields->mFds.reset();
@@ -3071,7 +3442,8 @@ status_t Parcel::continueWrite(size_t desired)
 
         // If there is a different owner, we need to take
         // posession.
-        uint8_t* data = (uint8_t*)malloc(desired);
+        bool arenaBacked = false;
+        uint8_t* data = parcelAllocData(desired, &arenaBacked);
         if (!data) {
             mError = NO_MEMORY;
             return NO_MEMORY;
@@ -3081,7 +3453,7 @@ status_t Parcel::continueWrite(size_t desired)
         if (kernelFields && objectsSize) {
             objects = (binder_size_t*)calloc(objectsSize, sizeof(binder_size_t));
             if (!objects) {
-                free(data);
+                parcelFreeData(data, 0, arenaBacked, /*zero=*/false);
 
                 mError = NO_MEMORY;
                 return NO_MEMORY;
@@ -3096,7 +3468,7 @@ status_t Parcel::continueWrite(size_t desired)
         }
         if (rpcFields) {
             if (status_t status = truncateRpcObjects(objectsSize); status != OK) {
-                free(data);
+                parcelFreeData(data, 0, arenaBacked, /*zero=*/false);
                 return status;
             }
         }
@@ -3122,6 +3494,7 @@ status_t Parcel::continueWrite(size_t desired)
         gParcelGlobalAllocCount++;
 
         mData = data;
+        mArenaBacked = arenaBacked;
         mDataSize = (mDataSize < desired) ? mDataSize : desired;
         ALOGV("continueWrite Setting data size of %p to %zu", this, mDataSize);
         mDataCapacity = desired;
@@ -3144,6 +3517,10 @@ status_t Parcel::continueWrite(size_t desired)
                     // will need to rescan because we may have lopped off the only FDs
                     kernelFields->mFdsKnown = false;
                 }
+                if (flat->hdr.type == BINDER_TYPE_PTR) {
+                    const auto* buf = reinterpret_cast<const binder_buffer_object*>(flat);
+                    kernelFields->mExternalBufferSize -= (buf->length + 7) & ~size_t{7};
+                }
                 release_object(proc, *flat, this);
             }
 
@@ -3175,7 +3552,8 @@ status_t Parcel::continueWrite(size_t desired)
 
         // We own the data, so we can just do a realloc().
         if (desired > mDataCapacity) {
-            uint8_t* data = reallocZeroFree(mData, mDataCapacity, desired, mDeallocZero);
+            uint8_t* data = parcelReallocData(mData, mDataCapacity, desired, &mArenaBacked,
+                                              mDeallocZero);
             if (data) {
                 LOG_ALLOC("Parcel %p: continue from %zu to %zu capacity", this, mDataCapacity,
                         desired);
@@ -3200,7 +3578,7 @@ status_t Parcel::continueWrite(size_t desired)
 
     } else {
         // This is the first data.  Easy!
-        uint8_t* data = (uint8_t*)malloc(desired);
+        uint8_t* data = parcelAllocData(desired, &mArenaBacked);
         if (!data) {
             mError = NO_MEMORY;
             return NO_MEMORY;
@@ -3270,6 +3648,7 @@ void Parcel::initState()
     mVariantFields.emplace<KernelFields>();
     mAllowFds = true;
     mDeallocZero = false;
+    mArenaBacked = false;
     mOwner = nullptr;
     mEnforceNoDataAvail = true;
     mServiceFuzzing = false;
@@ -31,47 +31,126 @@ ANDROID_SINGLETON_STATIC_INSTANCE(PermissionCache)
 
 // ----------------------------------------------------------------------------
 
+// Slot layout: a slot packs the whole cache entry into one atomic word so
+// lookups are a handful of relaxed-cost loads.
+//   bits  0..31  uid
+//   bits 32..44  pooled permission name index (13 bits)
+//   bit  45      granted
+//   bits 46..61  epoch the entry was cached under (16 bits)
+//   bit  62      valid
+// A zero word is an empty slot.
+static constexpr uint64_t kSlotValid = 1ull << 62;
+
+static uint64_t packSlot(uid_t uid, uint32_t nameIndex, bool granted, uint32_t epoch) {
+    return kSlotValid | (uint64_t(epoch & 0xffff) << 46) | (uint64_t(granted) << 45) |
+            (uint64_t(nameIndex & 0x1fff) << 32) | uint64_t(uint32_t(uid));
+}
+
+static uint64_t slotKey(uint64_t slot) {
+    // everything but the granted bit
+    return slot & ~(1ull << 45);
+}
+
+static size_t slotHash(uid_t uid, uint32_t nameIndex) {
+    uint64_t h = (uint64_t(nameIndex) << 32) | uint32_t(uid);
+    // 64-bit finalizer from splitmix64
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    return size_t(h);
+}
+
 PermissionCache::PermissionCache() {
+    for (auto& shard : mShards) {
+        for (auto& slot : shard.slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+ssize_t PermissionCache::findPooledName(const String16& permission) const {
+    const uint32_t count = mNamePoolSize.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; i++) {
+        if (mNamePool[i] == permission) {
+            return ssize_t(i);
+        }
+    }
+    return NAME_NOT_FOUND;
 }
 
 status_t PermissionCache::check(bool* granted,
         const String16& permission, uid_t uid) const {
-    Mutex::Autolock _l(mLock);
-    Entry e;
-    e.name = permission;
-    e.uid  = uid;
-    ssize_t index = mCache.indexOf(e);
-    if (index >= 0) {
-        *granted = mCache.itemAt(index).granted;
-        return NO_ERROR;
+    const ssize_t nameIndex = findPooledName(permission);
+    if (nameIndex < 0) {
+        return NAME_NOT_FOUND;
+    }
+    const uint32_t epoch = mEpoch.load(std::memory_order_acquire);
+    const uint64_t key = slotKey(packSlot(uid, uint32_t(nameIndex), false, epoch));
+    const size_t hash = slotHash(uid, uint32_t(nameIndex));
+    const Shard& shard = mShards[hash % kNumShards];
+    const size_t start = (hash / kNumShards) % kSlotsPerShard;
+    for (size_t i = 0; i < kProbeLength; i++) {
+        const uint64_t slot =
+                shard.slots[(start + i) % kSlotsPerShard].load(std::memory_order_acquire);
+        if (slotKey(slot) == key) {
+            *granted = (slot >> 45) & 1;
+            return NO_ERROR;
+        }
     }
     return NAME_NOT_FOUND;
 }
 
 void PermissionCache::cache(const String16& permission,
         uid_t uid, bool granted) {
-    Mutex::Autolock _l(mLock);
-    Entry e;
-    ssize_t index = mPermissionNamesPool.indexOf(permission);
-    if (index > 0) {
-        e.name = mPermissionNamesPool.itemAt(index);
-    } else {
-        mPermissionNamesPool.add(permission);
-        e.name = permission;
+    ssize_t nameIndex;
+    {
+        Mutex::Autolock _l(mNamePoolLock);
+        nameIndex = findPooledName(permission);
+        if (nameIndex < 0) {
+            const uint32_t count = mNamePoolSize.load(std::memory_order_relaxed);
+            if (count >= kMaxPooledNames) {
+                // pool exhausted; this permission just won't be cached
+                return;
+            }
+            mNamePool[count] = permission;
+            mNamePoolSize.store(count + 1, std::memory_order_release);
+            nameIndex = ssize_t(count);
+        }
     }
     // note, we don't need to store the pid, which is not actually used in
     // permission checks
-    e.uid  = uid;
-    e.granted = granted;
-    index = mCache.indexOf(e);
-    if (index < 0) {
-        mCache.add(e);
+    const uint32_t epoch = mEpoch.load(std::memory_order_acquire);
+    const uint64_t packed = packSlot(uid, uint32_t(nameIndex), granted, epoch);
+    const size_t hash = slotHash(uid, uint32_t(nameIndex));
+    Shard& shard = mShards[hash % kNumShards];
+    const size_t start = (hash / kNumShards) % kSlotsPerShard;
+    Mutex::Autolock _l(shard.fillLock);
+    size_t victim = start;
+    for (size_t i = 0; i < kProbeLength; i++) {
+        const size_t index = (start + i) % kSlotsPerShard;
+        const uint64_t slot = shard.slots[index].load(std::memory_order_relaxed);
+        const bool stale = ((slot >> 46) & 0xffff) != (epoch & 0xffff);
+        if (slot == 0 || stale || slotKey(slot) == slotKey(packed)) {
+            victim = index;
+            break;
+        }
     }
+    // if the whole probe window is live we overwrite its first slot; this is
+    // a cache, so evicting a colliding entry just costs a future re-check
+    shard.slots[victim].store(packed, std::memory_order_release);
 }
 
 void PermissionCache::purge() {
-    Mutex::Autolock _l(mLock);
-    mCache.clear();
+    // Bumping the epoch invalidates every entry at once without blocking
+    // readers. The sweep below merely recycles the slots; an insert racing
+    // with it either lands with the new epoch (kept, possibly swept away as a
+    // harmless cache miss) or the old one (already stale).
+    mEpoch.fetch_add(1, std::memory_order_acq_rel);
+    for (auto& shard : mShards) {
+        for (auto& slot : shard.slots) {
+            slot.store(0, std::memory_order_release);
+        }
+    }
 }
 
 bool PermissionCache::checkCallingPermission(const String16& permission) {
@@ -90,12 +90,52 @@ namespace os {
         }                                     \
     }
 
+PersistableBundle::PersistableBundle(const PersistableBundle& bundle) {
+    *this = bundle;
+}
+
+PersistableBundle& PersistableBundle::operator=(const PersistableBundle& bundle) {
+    if (this == &bundle) return *this;
+    /*
+     * Copies materialize the source first: sharing the deferred parcel would
+     * let two copies parse the same Parcel (and its read cursor) concurrently.
+     */
+    bundle.unparcel();
+    mParcelledData.reset();
+    mDeferredParseStatus = bundle.mDeferredParseStatus;
+    mBoolMap = bundle.mBoolMap;
+    mIntMap = bundle.mIntMap;
+    mLongMap = bundle.mLongMap;
+    mDoubleMap = bundle.mDoubleMap;
+    mStringMap = bundle.mStringMap;
+    mBoolVectorMap = bundle.mBoolVectorMap;
+    mIntVectorMap = bundle.mIntVectorMap;
+    mLongVectorMap = bundle.mLongVectorMap;
+    mDoubleVectorMap = bundle.mDoubleVectorMap;
+    mStringVectorMap = bundle.mStringVectorMap;
+    mPersistableBundleMap = bundle.mPersistableBundleMap;
+    return *this;
+}
+
 status_t PersistableBundle::writeToParcel(Parcel* parcel) const {
     /*
      * Keep implementation in sync with writeToParcelInner() in
      * frameworks/base/core/java/android/os/BaseBundle.java.
      */
 
+    // If the bundle was read from a parcel and never inspected, forward the
+    // raw bytes instead of parsing and re-serializing all the entries. The
+    // lock keeps the check coherent against a concurrent materialization.
+    {
+        std::lock_guard<std::mutex> lock(mUnparcelMutex);
+        if (mParcelledData) {
+            size_t length = mParcelledData->dataSize();
+            RETURN_IF_FAILED(parcel->writeInt32(static_cast<int32_t>(length)));
+            RETURN_IF_FAILED(parcel->writeInt32(BUNDLE_MAGIC_NATIVE));
+            return parcel->appendFrom(mParcelledData.get(), 0, length);
+        }
+    }
+
     // Special case for empty bundles.
     if (empty()) {
         RETURN_IF_FAILED(parcel->writeInt32(0));
@@ -141,6 +181,7 @@ bool PersistableBundle::empty() const {
 }
 
 size_t PersistableBundle::size() const {
+    unparcel();
     return (mBoolMap.size() +
             mIntMap.size() +
             mLongMap.size() +
@@ -155,6 +196,7 @@ size_t PersistableBundle::size() const {
 }
 
 size_t PersistableBundle::erase(const String16& key) {
+    unparcel();
     RETURN_IF_ENTRY_ERASED(mBoolMap, key);
     RETURN_IF_ENTRY_ERASED(mIntMap, key);
     RETURN_IF_ENTRY_ERASED(mLongMap, key);
@@ -224,90 +266,112 @@ void PersistableBundle::putPersistableBundle(const String16& key, const Persista
 }
 
 bool PersistableBundle::getBoolean(const String16& key, bool* out) const {
+    unparcel();
     return getValue(key, out, mBoolMap);
 }
 
 bool PersistableBundle::getInt(const String16& key, int32_t* out) const {
+    unparcel();
     return getValue(key, out, mIntMap);
 }
 
 bool PersistableBundle::getLong(const String16& key, int64_t* out) const {
+    unparcel();
     return getValue(key, out, mLongMap);
 }
 
 bool PersistableBundle::getDouble(const String16& key, double* out) const {
+    unparcel();
     return getValue(key, out, mDoubleMap);
 }
 
 bool PersistableBundle::getString(const String16& key, String16* out) const {
+    unparcel();
     return getValue(key, out, mStringMap);
 }
 
 bool PersistableBundle::getBooleanVector(const String16& key, vector<bool>* out) const {
+    unparcel();
     return getValue(key, out, mBoolVectorMap);
 }
 
 bool PersistableBundle::getIntVector(const String16& key, vector<int32_t>* out) const {
+    unparcel();
     return getValue(key, out, mIntVectorMap);
 }
 
 bool PersistableBundle::getLongVector(const String16& key, vector<int64_t>* out) const {
+    unparcel();
     return getValue(key, out, mLongVectorMap);
 }
 
 bool PersistableBundle::getDoubleVector(const String16& key, vector<double>* out) const {
+    unparcel();
     return getValue(key, out, mDoubleVectorMap);
 }
 
 bool PersistableBundle::getStringVector(const String16& key, vector<String16>* out) const {
+    unparcel();
     return getValue(key, out, mStringVectorMap);
 }
 
 bool PersistableBundle::getPersistableBundle(const String16& key, PersistableBundle* out) const {
+    unparcel();
     return getValue(key, out, mPersistableBundleMap);
 }
 
 set<String16> PersistableBundle::getBooleanKeys() const {
+    unparcel();
     return getKeys(mBoolMap);
 }
 
 set<String16> PersistableBundle::getIntKeys() const {
+    unparcel();
     return getKeys(mIntMap);
 }
 
 set<String16> PersistableBundle::getLongKeys() const {
+    unparcel();
     return getKeys(mLongMap);
 }
 
 set<String16> PersistableBundle::getDoubleKeys() const {
+    unparcel();
     return getKeys(mDoubleMap);
 }
 
 set<String16> PersistableBundle::getStringKeys() const {
+    unparcel();
     return getKeys(mStringMap);
 }
 
 set<String16> PersistableBundle::getBooleanVectorKeys() const {
+    unparcel();
     return getKeys(mBoolVectorMap);
 }
 
 set<String16> PersistableBundle::getIntVectorKeys() const {
+    unparcel();
     return getKeys(mIntVectorMap);
 }
 
 set<String16> PersistableBundle::getLongVectorKeys() const {
+    unparcel();
     return getKeys(mLongVectorMap);
 }
 
 set<String16> PersistableBundle::getDoubleVectorKeys() const {
+    unparcel();
     return getKeys(mDoubleVectorMap);
 }
 
 set<String16> PersistableBundle::getStringVectorKeys() const {
+    unparcel();
     return getKeys(mStringVectorMap);
 }
 
 set<String16> PersistableBundle::getPersistableBundleKeys() const {
+    unparcel();
     return getKeys(mPersistableBundleMap);
 }
 
@@ -402,6 +466,27 @@ status_t PersistableBundle::readFromParcelInner(const Parcel* parcel, size_t len
         return BAD_VALUE;
     }
 
+    /*
+     * Defer parsing until a key is accessed: keep the raw bytes so bundles
+     * that are merely carried through a process, or of which only a few
+     * entries are read, do not pay for deserializing every entry. Reading
+     * into a non-empty bundle merges, so that case still parses eagerly.
+     */
+    if (!mParcelledData && size() == 0) {
+        auto parcelledData = std::make_shared<Parcel>();
+        size_t start_pos = parcel->dataPosition();
+        RETURN_IF_FAILED(parcelledData->appendFrom(parcel, start_pos, length));
+        parcel->setDataPosition(start_pos + length);
+        mParcelledData = std::move(parcelledData);
+        mDeferredParseStatus = NO_ERROR;
+        return NO_ERROR;
+    }
+
+    unparcel();
+    return readEntries(parcel);
+}
+
+status_t PersistableBundle::readEntries(const Parcel* parcel) {
     /*
      * To keep this implementation in sync with unparcel() in
      * frameworks/base/core/java/android/os/BaseBundle.java, the number of
@@ -477,6 +562,36 @@ status_t PersistableBundle::readFromParcelInner(const Parcel* parcel, size_t len
     return NO_ERROR;
 }
 
+void PersistableBundle::unparcel() const {
+    /*
+     * Materialization is logically const: it only converts the deferred
+     * representation into the map representation of the same contents. It is
+     * synchronized, mirroring the Java BaseBundle, so concurrent const reads
+     * of a bundle fresh off a parcel are safe: whichever accessor gets here
+     * first parses under the lock, and every other accessor passes through
+     * the lock before touching the maps.
+     */
+    auto* self = const_cast<PersistableBundle*>(this);
+    std::lock_guard<std::mutex> lock(mUnparcelMutex);
+    if (!mParcelledData) {
+        return;
+    }
+
+    std::shared_ptr<Parcel> parcelledData = std::move(self->mParcelledData);
+    parcelledData->setDataPosition(0);
+    status_t result = self->readEntries(parcelledData.get());
+    if (result != NO_ERROR) {
+        self->mDeferredParseStatus = result;
+        ALOGE("Failed to parse deferred PersistableBundle data: %d", result);
+    }
+}
+
+status_t PersistableBundle::deferredParseStatus() const {
+    unparcel();
+    std::lock_guard<std::mutex> lock(mUnparcelMutex);
+    return mDeferredParseStatus;
+}
+
 }  // namespace os
 
 }  // namespace android
@@ -35,6 +35,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
@@ -310,17 +311,19 @@ void ProcessState::setCallRestriction(CallRestriction restriction) {
     mCallRestriction = restriction;
 }
 
-ProcessState::handle_entry* ProcessState::lookupHandleLocked(int32_t handle)
+ProcessState::handle_entry* ProcessState::lookupHandleLocked(HandleTableShard& shard,
+                                                             int32_t handle)
 {
-    const size_t N=mHandleToObject.size();
-    if (N <= (size_t)handle) {
+    const size_t index = (size_t)handle / kHandleTableShards;
+    const size_t N = shard.entries.size();
+    if (N <= index) {
         handle_entry e;
         e.binder = nullptr;
         e.refs = nullptr;
-        status_t err = mHandleToObject.insertAt(e, N, handle+1-N);
+        status_t err = shard.entries.insertAt(e, N, index + 1 - N);
         if (err < NO_ERROR) return nullptr;
     }
-    return &mHandleToObject.editItemAt(handle);
+    return &shard.entries.editItemAt(index);
 }
 
 // see b/166779391: cannot change the VNDK interface, so access like this
@@ -331,11 +334,12 @@ sp<IBinder> ProcessState::getStrongProxyForHandle(int32_t handle)
     sp<IBinder> result;
     std::function<void()> postTask;
 
-    std::unique_lock<std::mutex> _l(mLock);
-
     if (handle == 0 && the_context_object != nullptr) return the_context_object;
 
-    handle_entry* e = lookupHandleLocked(handle);
+    HandleTableShard& shard = mHandleTable[(size_t)handle % kHandleTableShards];
+    std::unique_lock<std::mutex> _l(shard.lock);
+
+    handle_entry* e = lookupHandleLocked(shard, handle);
 
     if (e != nullptr) {
         // We need to create a new BpBinder if there isn't currently one, OR we
@@ -397,11 +401,21 @@ sp<IBinder> ProcessState::getStrongProxyForHandle(int32_t handle)
     return result;
 }
 
+IBinder* ProcessState::getExistingProxyForHandle(int32_t handle) {
+    if (handle == 0 && the_context_object != nullptr) return the_context_object.get();
+
+    HandleTableShard& shard = mHandleTable[(size_t)handle % kHandleTableShards];
+    std::unique_lock<std::mutex> _l(shard.lock);
+    handle_entry* e = lookupHandleLocked(shard, handle);
+    return e != nullptr ? e->binder : nullptr;
+}
+
 void ProcessState::expungeHandle(int32_t handle, IBinder* binder)
 {
-    std::unique_lock<std::mutex> _l(mLock);
+    HandleTableShard& shard = mHandleTable[(size_t)handle % kHandleTableShards];
+    std::unique_lock<std::mutex> _l(shard.lock);
 
-    handle_entry* e = lookupHandleLocked(handle);
+    handle_entry* e = lookupHandleLocked(shard, handle);
 
     // This handle may have already been replaced with a new BpBinder
     // (if someone failed the AttemptIncWeak() above); we don't want
@@ -451,6 +465,35 @@ status_t ProcessState::setThreadPoolMaxThreadCount(size_t maxThreads) {
     return result;
 }
 
+status_t ProcessState::setThreadServicePolicy(const String16& descriptor,
+                                              const ThreadServicePolicy& policy) {
+    if (policy.schedPolicy != -1 && policy.schedPolicy != SCHED_OTHER &&
+        policy.schedPolicy != SCHED_FIFO && policy.schedPolicy != SCHED_RR) {
+        ALOGE("setThreadServicePolicy: unsupported scheduler %d", policy.schedPolicy);
+        return BAD_VALUE;
+    }
+    if ((policy.schedPolicy == SCHED_FIFO || policy.schedPolicy == SCHED_RR) &&
+        (policy.schedPriority < sched_get_priority_min(policy.schedPolicy) ||
+         policy.schedPriority > sched_get_priority_max(policy.schedPolicy))) {
+        ALOGE("setThreadServicePolicy: priority %d out of range for scheduler %d",
+              policy.schedPriority, policy.schedPolicy);
+        return BAD_VALUE;
+    }
+
+    std::unique_lock<std::mutex> _l(mLock);
+    mThreadServicePolicies[descriptor] = policy;
+    mHasThreadServicePolicies.store(true, std::memory_order_relaxed);
+    return NO_ERROR;
+}
+
+std::optional<ProcessState::ThreadServicePolicy> ProcessState::getThreadServicePolicy(
+        const String16& descriptor) const {
+    std::unique_lock<std::mutex> _l(mLock);
+    auto it = mThreadServicePolicies.find(descriptor);
+    if (it == mThreadServicePolicies.end()) return std::nullopt;
+    return it->second;
+}
+
 size_t ProcessState::getThreadPoolMaxTotalThreadCount() const {
     // Need to read `mKernelStartedThreads` before `mThreadPoolStarted` (with
     // non-relaxed memory ordering) to avoid a race like the following:
@@ -497,6 +540,24 @@ size_t ProcessState::getThreadPoolMaxTotalThreadCount() const {
     return mCurrentThreads;
 }
 
+ProcessState::ThreadPoolStats ProcessState::getThreadPoolStats() const {
+    ThreadPoolStats stats;
+    stats.maxThreads = mMaxThreads;
+    stats.executingThreads = mExecutingThreadsCount;
+    stats.executingThreadsPeak = mExecutingThreadsPeak.load(std::memory_order_relaxed);
+    stats.starvationEpisodes = mStarvationCount.load(std::memory_order_relaxed);
+    stats.starvationTimeMs = mStarvationTimeMs.load(std::memory_order_relaxed);
+    // Account for an ongoing saturation episode so a dump taken while the pool
+    // is wedged still shows the time spent.
+    auto starvationStartTime = mStarvationStartTime.load();
+    if (starvationStartTime != never()) {
+        stats.starvationTimeMs += std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          std::chrono::steady_clock::now() - starvationStartTime)
+                                          .count();
+    }
+    return stats;
+}
+
 bool ProcessState::isThreadPoolStarted() const {
     return mThreadPoolStarted;
 }
@@ -578,6 +639,9 @@ ProcessState::ProcessState(const char* driver)
         mMaxThreads(DEFAULT_MAX_BINDER_THREADS),
         mCurrentThreads(0),
         mKernelStartedThreads(0),
+        mExecutingThreadsPeak(0),
+        mStarvationCount(0),
+        mStarvationTimeMs(0),
         mStarvationStartTime(never()),
         mForked(false),
         mThreadPoolStarted(false),
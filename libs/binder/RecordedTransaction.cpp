@@ -310,8 +310,9 @@ std::optional<RecordedTransaction> RecordedTransaction::fromFile(const unique_fd
     return std::optional<RecordedTransaction>(std::move(t));
 }
 
-android::status_t RecordedTransaction::writeChunk(borrowed_fd fd, uint32_t chunkType,
-                                                  size_t byteCount, const uint8_t* data) const {
+android::status_t RecordedTransaction::appendChunk(std::vector<std::byte>& buffer,
+                                                   uint32_t chunkType, size_t byteCount,
+                                                   const uint8_t* data) const {
     if (byteCount > kMaxChunkDataSize) {
         ALOGE("Chunk data exceeds maximum size");
         return BAD_VALUE;
@@ -322,68 +323,79 @@ android::status_t RecordedTransaction::writeChunk(borrowed_fd fd, uint32_t chunk
     const std::byte* descriptorBytes = reinterpret_cast<const std::byte*>(&descriptor);
     const std::byte* dataBytes = reinterpret_cast<const std::byte*>(data);
 
-    // Add Chunk to intermediate buffer, except checksum
-    std::vector<std::byte> buffer;
+    // Add Chunk to buffer, except checksum
+    const size_t chunkStart = buffer.size();
     buffer.insert(buffer.end(), descriptorBytes, descriptorBytes + sizeof(ChunkDescriptor));
     buffer.insert(buffer.end(), dataBytes, dataBytes + byteCount);
     std::byte zero{0};
     buffer.insert(buffer.end(), PADDING8(byteCount), zero);
 
-    // Calculate checksum from buffer
-    transaction_checksum_t* checksumData = reinterpret_cast<transaction_checksum_t*>(buffer.data());
+    // Calculate checksum over the chunk
+    transaction_checksum_t* checksumData =
+            reinterpret_cast<transaction_checksum_t*>(buffer.data() + chunkStart);
     transaction_checksum_t checksumValue = 0;
-    for (size_t idx = 0; idx < (buffer.size() / sizeof(transaction_checksum_t)); idx++) {
+    for (size_t idx = 0; idx < ((buffer.size() - chunkStart) / sizeof(transaction_checksum_t));
+         idx++) {
         checksumValue ^= checksumData[idx];
     }
 
     // Write checksum to buffer
     std::byte* checksumBytes = reinterpret_cast<std::byte*>(&checksumValue);
     buffer.insert(buffer.end(), checksumBytes, checksumBytes + sizeof(transaction_checksum_t));
-
-    // Write buffer to file
-    if (!WriteFully(fd, buffer.data(), buffer.size())) {
-        ALOGE("Failed to write chunk fd %d", fd.get());
-        return UNKNOWN_ERROR;
-    }
     return NO_ERROR;
 }
 
 android::status_t RecordedTransaction::dumpToFile(const unique_fd& fd) const {
+    // Build the whole transaction in one buffer so recording costs a single
+    // write() on the caller's thread rather than one per chunk.
+    std::vector<std::byte> buffer;
+    constexpr size_t kPerChunkOverhead =
+            sizeof(ChunkDescriptor) + sizeof(transaction_checksum_t) + 7 /* max padding */;
+    buffer.reserve(sizeof(TransactionHeader) + mData.mInterfaceName.size() +
+                   mSentDataOnly.dataBufferSize() + mReplyDataOnly.dataBufferSize() +
+                   mData.mSentObjectData.size() * sizeof(uint64_t) + 6 * kPerChunkOverhead);
+
     if (NO_ERROR !=
-        writeChunk(fd, HEADER_CHUNK, sizeof(TransactionHeader),
-                   reinterpret_cast<const uint8_t*>(&(mData.mHeader)))) {
-        ALOGE("Failed to write transactionHeader to fd %d", fd.get());
+        appendChunk(buffer, HEADER_CHUNK, sizeof(TransactionHeader),
+                    reinterpret_cast<const uint8_t*>(&(mData.mHeader)))) {
+        ALOGE("Failed to serialize transactionHeader");
         return UNKNOWN_ERROR;
     }
     if (NO_ERROR !=
-        writeChunk(fd, INTERFACE_NAME_CHUNK, mData.mInterfaceName.size() * sizeof(uint8_t),
-                   reinterpret_cast<const uint8_t*>(mData.mInterfaceName.c_str()))) {
-        ALOGI("Failed to write Interface Name Chunk to fd %d", fd.get());
+        appendChunk(buffer, INTERFACE_NAME_CHUNK, mData.mInterfaceName.size() * sizeof(uint8_t),
+                    reinterpret_cast<const uint8_t*>(mData.mInterfaceName.c_str()))) {
+        ALOGI("Failed to serialize Interface Name Chunk");
         return UNKNOWN_ERROR;
     }
 
     if (NO_ERROR !=
-        writeChunk(fd, DATA_PARCEL_CHUNK, mSentDataOnly.dataBufferSize(), mSentDataOnly.data())) {
-        ALOGE("Failed to write sent Parcel to fd %d", fd.get());
+        appendChunk(buffer, DATA_PARCEL_CHUNK, mSentDataOnly.dataBufferSize(),
+                    mSentDataOnly.data())) {
+        ALOGE("Failed to serialize sent Parcel");
         return UNKNOWN_ERROR;
     }
 
     if (NO_ERROR !=
-        writeChunk(fd, REPLY_PARCEL_CHUNK, mReplyDataOnly.dataBufferSize(),
-                   mReplyDataOnly.data())) {
-        ALOGE("Failed to write reply Parcel to fd %d", fd.get());
+        appendChunk(buffer, REPLY_PARCEL_CHUNK, mReplyDataOnly.dataBufferSize(),
+                    mReplyDataOnly.data())) {
+        ALOGE("Failed to serialize reply Parcel");
         return UNKNOWN_ERROR;
     }
 
     if (NO_ERROR !=
-        writeChunk(fd, DATA_PARCEL_OBJECT_CHUNK, mData.mSentObjectData.size() * sizeof(uint64_t),
-                   reinterpret_cast<const uint8_t*>(mData.mSentObjectData.data()))) {
-        ALOGE("Failed to write sent parcel object metadata to fd %d", fd.get());
+        appendChunk(buffer, DATA_PARCEL_OBJECT_CHUNK, mData.mSentObjectData.size() * sizeof(uint64_t),
+                    reinterpret_cast<const uint8_t*>(mData.mSentObjectData.data()))) {
+        ALOGE("Failed to serialize sent parcel object metadata");
         return UNKNOWN_ERROR;
     }
 
-    if (NO_ERROR != writeChunk(fd, END_CHUNK, 0, nullptr)) {
-        ALOGE("Failed to write end chunk to fd %d", fd.get());
+    if (NO_ERROR != appendChunk(buffer, END_CHUNK, 0, nullptr)) {
+        ALOGE("Failed to serialize end chunk");
+        return UNKNOWN_ERROR;
+    }
+
+    if (!WriteFully(fd, buffer.data(), buffer.size())) {
+        ALOGE("Failed to write transaction to fd %d", fd.get());
         return UNKNOWN_ERROR;
     }
     return NO_ERROR;
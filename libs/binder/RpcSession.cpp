@@ -514,6 +514,9 @@ status_t RpcSession::setupClient(const std::function<status_t(const std::vector<
 
         mConnections = {};
 
+        mOutgoingConnectionFactory = nullptr;
+        mDesiredOutgoingConnections = 0;
+
         // clear mStartedSetup so that we can reuse this RpcSession
         mStartedSetup = false;
     });
@@ -536,8 +539,6 @@ status_t RpcSession::setupClient(const std::function<status_t(const std::vector<
         if (!setProtocolVersionInternal(version, false)) return BAD_VALUE;
     }
 
-    // TODO(b/189955605): we should add additional sessions dynamically
-    // instead of all at once.
     size_t numThreadsAvailable;
     if (status_t status = getRemoteMaxThreads(&numThreadsAvailable); status != OK) {
         ALOGE("Could not get max threads after initial session setup: %s",
@@ -557,18 +558,30 @@ status_t RpcSession::setupClient(const std::function<status_t(const std::vector<
              "because it is preconfigured to start at most %zu outgoing threads.",
              numThreadsAvailable, outgoingConnections, mMaxOutgoingConnections);
 
-    // TODO(b/189955605): we should add additional sessions dynamically
-    // instead of all at once - the other side should be responsible for setting
-    // up additional connections. We need to create at least one (unless 0 are
-    // requested to be set) in order to allow the other side to reliably make
-    // any requests at all.
+    // We need to create at least one connection (unless 0 are requested to be
+    // set) in order to allow the other side to reliably make any requests at
+    // all - that connection has already been made above. When a connection
+    // factory is available, the remaining outgoing connections are added on
+    // demand by ExclusiveConnection::find, once transactions actually contend
+    // for connections. Otherwise (e.g. preconnected sessions, where the fds
+    // were handed to us up front), they are all created here.
+    bool deferOutgoingConnections;
+    {
+        RpcMutexLockGuard _l(mMutex);
+        mDesiredOutgoingConnections = outgoingConnections;
+        deferOutgoingConnections = mOutgoingConnectionFactory != nullptr;
+    }
 
     // we've already setup one client
     LOG_RPC_DETAIL("RpcSession::setupClient() instantiating %zu outgoing connections (server max: "
-                   "%zu) and %zu incoming threads",
-                   outgoingConnections, numThreadsAvailable, mMaxIncomingThreads);
-    for (size_t i = 0; i + 1 < outgoingConnections; i++) {
-        if (status_t status = connectAndInit(mId, false /*incoming*/); status != OK) return status;
+                   "%zu, on demand: %d) and %zu incoming threads",
+                   outgoingConnections, numThreadsAvailable, deferOutgoingConnections,
+                   mMaxIncomingThreads);
+    if (!deferOutgoingConnections) {
+        for (size_t i = 0; i + 1 < outgoingConnections; i++) {
+            if (status_t status = connectAndInit(mId, false /*incoming*/); status != OK)
+                return status;
+        }
     }
 
     for (size_t i = 0; i < mMaxIncomingThreads; i++) {
@@ -581,6 +594,16 @@ status_t RpcSession::setupClient(const std::function<status_t(const std::vector<
 }
 
 status_t RpcSession::setupSocketClient(const RpcSocketAddress& addr) {
+    {
+        // Socket addresses can be reconnected to at any time, so outgoing
+        // connections beyond the first can be added lazily, once transactions
+        // actually contend for connections.
+        RpcMutexLockGuard _l(mMutex);
+        mOutgoingConnectionFactory = [this, savedAddr = SavedSocketAddress(addr)](
+                                             const std::vector<uint8_t>& sessionId) {
+            return setupOneSocketConnection(savedAddr, sessionId, false /*incoming*/);
+        };
+    }
     return setupClient([&](const std::vector<uint8_t>& sessionId, bool incoming) {
         return setupOneSocketConnection(addr, sessionId, incoming);
     });
@@ -968,6 +991,28 @@ status_t RpcSession::ExclusiveConnection::find(const sp<RpcSession>& session, Co
             return WOULD_BLOCK;
         }
 
+        // All outgoing connections are busy. If the session can still grow, add
+        // another connection now instead of queueing this transaction behind
+        // whatever payloads are in flight on the existing connections.
+        if (session->mOutgoingConnectionFactory != nullptr &&
+            !session->mAddingOutgoingConnection &&
+            session->mConnections.mOutgoing.size() < session->mDesiredOutgoingConnections) {
+            session->mAddingOutgoingConnection = true;
+            std::vector<uint8_t> sessionId = session->mId;
+            _l.unlock();
+            status_t status = session->mOutgoingConnectionFactory(sessionId);
+            _l.lock();
+            session->mAddingOutgoingConnection = false;
+            if (status != OK) {
+                ALOGE("Could not add outgoing connection to session: %s. Continuing with %zu "
+                      "connections.",
+                      statusToString(status).c_str(), session->mConnections.mOutgoing.size());
+                // don't keep trying on every blocked transaction
+                session->mDesiredOutgoingConnections = session->mConnections.mOutgoing.size();
+            }
+            continue;
+        }
+
         LOG_RPC_DETAIL("No available connections (have %zu clients and %zu servers). Waiting...",
                        session->mConnections.mOutgoing.size(),
                        session->mConnections.mIncoming.size());
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <arpa/inet.h>
 #include <netdb.h>
@@ -113,6 +114,28 @@ private:
     unsigned int mPort;
 };
 
+/**
+ * An owning copy of another RpcSocketAddress, usable after the address it was
+ * constructed from has gone out of scope (e.g. to connect to the same server
+ * again later).
+ */
+class SavedSocketAddress : public RpcSocketAddress {
+public:
+    explicit SavedSocketAddress(const RpcSocketAddress& other)
+          : mAddr(reinterpret_cast<const uint8_t*>(other.addr()),
+                  reinterpret_cast<const uint8_t*>(other.addr()) + other.addrSize()),
+            mDescription(other.toString()) {}
+    std::string toString() const override { return mDescription; }
+    const sockaddr* addr() const override {
+        return reinterpret_cast<const sockaddr*>(mAddr.data());
+    }
+    size_t addrSize() const override { return mAddr.size(); }
+
+private:
+    std::vector<uint8_t> mAddr;
+    std::string mDescription;
+};
+
 /**
  * Connects to a single socket and produces a RpcTransportFd.
  */
@@ -19,8 +19,11 @@
 
 #include <poll.h>
 #include <stddef.h>
+#include <string.h>
 #include <sys/socket.h>
 
+#include <algorithm>
+
 #include <binder/RpcTransportRaw.h>
 
 #include "FdTrigger.h"
@@ -39,6 +42,10 @@ class RpcTransportRaw : public RpcTransport {
 public:
     explicit RpcTransportRaw(android::RpcTransportFd socket) : mSocket(std::move(socket)) {}
     status_t pollRead(void) override {
+        if (mReadBufferCount > 0) {
+            return OK;
+        }
+
         uint8_t buf;
         ssize_t ret = TEMP_FAILURE_RETRY(
                 ::recv(mSocket.fd.get(), &buf, sizeof(buf), MSG_PEEK | MSG_DONTWAIT));
@@ -76,8 +83,41 @@ public:
             FdTrigger* fdTrigger, iovec* iovs, int niovs,
             const std::optional<SmallFunction<status_t()>>& altPoll,
             std::vector<std::variant<unique_fd, borrowed_fd>>* ancillaryFds) override {
-        auto recv = [&](iovec* iovs, int niovs) -> ssize_t {
-            return binder::os::receiveMessageFromSocket(mSocket, iovs, niovs, ancillaryFds);
+        // Serve bytes over-read by a previous recvmsg before touching the socket again.
+        for (int i = 0; i < niovs && mReadBufferCount > 0; i++) {
+            const size_t toCopy = std::min(iovs[i].iov_len, mReadBufferCount);
+            memcpy(iovs[i].iov_base, mReadBuffer + mReadBufferPos, toCopy);
+            iovs[i].iov_base = reinterpret_cast<uint8_t*>(iovs[i].iov_base) + toCopy;
+            iovs[i].iov_len -= toCopy;
+            mReadBufferPos += toCopy;
+            mReadBufferCount -= toCopy;
+        }
+
+        auto recv = [&](iovec* curIovs, int curNiovs) -> ssize_t {
+            // Tack the spare buffer space onto the request, so that frames already queued
+            // behind the requested bytes (e.g. the body following a command header, or the
+            // next small command) are drained by the same syscall. Kernels do not merge
+            // data across ancillary (fd-carrying) message boundaries, so over-reading
+            // cannot misattribute file descriptors.
+            if (mReadBufferCount == 0 && curNiovs < kMaxReadIovs) {
+                size_t requested = 0;
+                for (int i = 0; i < curNiovs; i++) {
+                    requested += curIovs[i].iov_len;
+                }
+
+                iovec extended[kMaxReadIovs];
+                std::copy(curIovs, curIovs + curNiovs, extended);
+                extended[curNiovs] = {mReadBuffer, sizeof(mReadBuffer)};
+                ssize_t ret = binder::os::receiveMessageFromSocket(mSocket, extended,
+                                                                   curNiovs + 1, ancillaryFds);
+                if (ret > static_cast<ssize_t>(requested)) {
+                    mReadBufferPos = 0;
+                    mReadBufferCount = static_cast<size_t>(ret) - requested;
+                    return static_cast<ssize_t>(requested);
+                }
+                return ret;
+            }
+            return binder::os::receiveMessageFromSocket(mSocket, curIovs, curNiovs, ancillaryFds);
         };
         return interruptableReadOrWrite(mSocket, fdTrigger, iovs, niovs, recv, "recvmsg", POLLIN,
                                         altPoll);
@@ -87,6 +127,13 @@ public:
 
 private:
     android::RpcTransportFd mSocket;
+
+    // Holds bytes received past the end of a read request. Each connection is used by one
+    // thread at a time, so no synchronization is needed.
+    static constexpr int kMaxReadIovs = 4;
+    uint8_t mReadBuffer[4096];
+    size_t mReadBufferPos = 0;
+    size_t mReadBufferCount = 0;
 };
 
 // RpcTransportCtx with TLS disabled.
@@ -19,6 +19,11 @@
 namespace android {
 namespace binder {
 
+const Status& Status::okRef() {
+    static const Status kOk;
+    return kOk;
+}
+
 Status Status::ok() {
     return Status();
 }
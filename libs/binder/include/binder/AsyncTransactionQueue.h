@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <binder/Common.h>
+#include <binder/IBinder.h>
+#include <binder/Parcel.h>
+#include <utils/Errors.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace android {
+
+/**
+ * Issues two-way binder transactions without blocking the submitting thread.
+ *
+ * Kernel binder has no non-blocking two-way transact: a reply is only
+ * delivered to a thread parked in the driver, so every hand-rolled async flow
+ * either blocks a thread per call or builds a callback binder interface with
+ * its own proxy and parcel allocations. This class centralizes the pattern:
+ * transact() queues the call and returns immediately, a small shared pool of
+ * threads performs the transactions, and the continuation is invoked with the
+ * status and reply. Fanning out N calls costs min(N, maxThreads) threads for
+ * the duration of the slowest call instead of N blocked caller threads, and
+ * the Parcel contexts (both data and reply) are recycled across calls instead
+ * of reallocated.
+ *
+ * Continuations for calls submitted from the same thread are invoked in
+ * submission order on one pool thread; calls from different threads may
+ * complete concurrently. Continuations must not block indefinitely, since
+ * they occupy a pool thread.
+ *
+ * The destructor drains pending calls and joins the pool, so the queue must
+ * outlive all use of the objects its continuations capture.
+ */
+class AsyncTransactionQueue {
+public:
+    // Invoked with the result of IBinder::transact and the reply parcel. The
+    // reply is only valid for the duration of the call; it is recycled
+    // afterwards.
+    using Callback = std::function<void(status_t, const Parcel& reply)>;
+
+    LIBBINDER_EXPORTED explicit AsyncTransactionQueue(size_t maxThreads = kDefaultMaxThreads);
+    LIBBINDER_EXPORTED ~AsyncTransactionQueue();
+
+    AsyncTransactionQueue(const AsyncTransactionQueue&) = delete;
+    AsyncTransactionQueue& operator=(const AsyncTransactionQueue&) = delete;
+
+    // Obtains a data parcel, recycled from the queue's pool when one is
+    // available. Fill it and hand it back through transact().
+    LIBBINDER_EXPORTED std::unique_ptr<Parcel> obtainParcel();
+
+    // Submits `code` with `data` to `binder` and returns immediately. The
+    // continuation runs on a pool thread once the transaction completes.
+    // Pool threads are created lazily, up to the limit given at construction.
+    LIBBINDER_EXPORTED void transact(const sp<IBinder>& binder, uint32_t code,
+                                     std::unique_ptr<Parcel> data, Callback callback,
+                                     uint32_t flags = 0);
+
+private:
+    struct Call {
+        sp<IBinder> binder;
+        uint32_t code;
+        std::unique_ptr<Parcel> data;
+        Callback callback;
+        uint32_t flags;
+        // Calls submitted by one thread complete in submission order; the
+        // worker claiming one call claims the submitter's whole run.
+        std::thread::id submitter;
+    };
+
+    void workerLoop();
+    void recycleLocked(std::unique_ptr<Parcel> parcel);
+
+    static constexpr size_t kDefaultMaxThreads = 4;
+    // Parcels above this capacity are destroyed instead of pooled so one
+    // oversized transaction does not pin its buffer forever.
+    static constexpr size_t kMaxPooledParcelCapacity = 4096;
+
+    const size_t mMaxThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Call> mPending;
+    std::vector<std::thread> mThreads;
+    size_t mIdleThreads = 0;
+    bool mShuttingDown = false;
+    // In-flight submitter threads, so their later calls are not claimed out
+    // of order by another worker.
+    std::vector<std::thread::id> mBusySubmitters;
+    std::vector<std::unique_ptr<Parcel>> mParcelPool;
+};
+
+} // namespace android
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <binder/Common.h>
+#include <binder/RpcThreads.h>
+#include <binder/unique_fd.h>
+#include <utils/Errors.h>
+
+#include <deque>
+#include <string>
+
+namespace android {
+
+/**
+ * Decouples dump generation from draining the caller's pipe.
+ *
+ * IBinder::dump implementations normally stream straight into the dump fd, so
+ * a large dump parks a binder thread on pipe writes for as long as the reader
+ * takes to drain them. An implementation can instead construct a
+ * ChunkedDumpWriter on the dump fd and write() chunks into it: a writer thread
+ * owned by this class drains the queue into the fd at the reader's pace, so
+ * generation overlaps with transfer. write() only blocks when the amount of
+ * generated-but-unsent data reaches the byte budget, which bounds memory while
+ * keeping back pressure on the producer rather than on the pipe.
+ *
+ * The fd is duplicated, so the writer remains valid for the lifetime of this
+ * object regardless of what the caller does with its fd. finish() flushes the
+ * queue, joins the writer thread and returns the first write error, and is
+ * invoked by the destructor if not called explicitly.
+ */
+class ChunkedDumpWriter {
+public:
+    LIBBINDER_EXPORTED explicit ChunkedDumpWriter(int fd,
+                                                  size_t maxBufferedBytes = kDefaultByteBudget);
+    LIBBINDER_EXPORTED ~ChunkedDumpWriter();
+
+    ChunkedDumpWriter(const ChunkedDumpWriter&) = delete;
+    ChunkedDumpWriter& operator=(const ChunkedDumpWriter&) = delete;
+
+    // Queues a chunk for transfer. Blocks only while the buffered byte budget
+    // is exhausted, never on the pipe itself. Chunks arriving after a write
+    // error are dropped.
+    LIBBINDER_EXPORTED void write(std::string chunk);
+
+    // Flushes remaining chunks, joins the writer thread, and returns the
+    // first error encountered while writing, if any.
+    LIBBINDER_EXPORTED status_t finish();
+
+private:
+    static constexpr size_t kDefaultByteBudget = 1 << 20;
+
+    void writerLoop();
+
+    const size_t mMaxBufferedBytes;
+    binder::unique_fd mFd;
+    RpcMutex mLock;
+    RpcConditionVariable mProducerCv;
+    RpcConditionVariable mWriterCv;
+    std::deque<std::string> mChunks; // guarded by mLock
+    size_t mBufferedBytes = 0;       // guarded by mLock
+    bool mDone = false;              // guarded by mLock
+    status_t mError = OK;            // guarded by mLock
+    bool mWriterJoined = false;      // only touched by finish()
+    RpcMaybeThread mWriter;
+};
+
+} // namespace android
@@ -22,6 +22,10 @@
 #include <utils/Errors.h>
 #include <utils/Vector.h>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #if defined(_WIN32)
 typedef  int  uid_t;
 #endif
@@ -141,6 +145,32 @@ public:
     LIBBINDER_EXPORTED void setCallRestriction(CallRestriction restriction);
     LIBBINDER_EXPORTED CallRestriction getCallRestriction() const;
 
+    // Opt this thread into arena-backed Parcel allocation. While enabled,
+    // Parcel data buffers created on this thread are carved out of a reusable
+    // per-thread slab and the slab is rewound in O(1) once the last such
+    // buffer is released, avoiding per-transaction heap churn. Parcels
+    // allocated while this is enabled must stay confined to this thread.
+    LIBBINDER_EXPORTED void setParcelArenaEnabled(bool enabled);
+    LIBBINDER_EXPORTED bool isParcelArenaEnabled() const;
+
+    // Controls user-space batching of oneway transactions issued from this thread. While
+    // enabled, oneway calls whose parcels carry no binder objects or file descriptors are
+    // queued locally instead of entering the driver once per call; flushCommands() (or
+    // disabling batching again) submits the accumulated batch in a single driver write.
+    // Queued payloads are copied, so callers may reuse their parcels immediately.
+    //
+    // Driver-reported failures for a batched transaction (e.g. BR_DEAD_REPLY) surface on
+    // whichever call next drains this thread's return queue, not on the call that queued
+    // the transaction.
+    LIBBINDER_EXPORTED void setOnewayBatchingEnabled(bool enabled);
+    LIBBINDER_EXPORTED bool isOnewayBatchingEnabled() const;
+
+    // Invoked whenever the batch grows past its size threshold and is flushed
+    // automatically, with the number of payload bytes that had been queued. Producers can
+    // use this as a backpressure signal instead of silently saturating the target's async
+    // buffer.
+    LIBBINDER_EXPORTED void setOnewayBatchOverflowCallback(std::function<void(size_t)> callback);
+
     LIBBINDER_EXPORTED int64_t clearCallingIdentity();
     // Restores PID/UID (not SID)
     LIBBINDER_EXPORTED void restoreCallingIdentity(int64_t token);
@@ -218,6 +248,8 @@ private:
     [[nodiscard]] status_t writeTransactionData(int32_t cmd, uint32_t binderFlags, int32_t handle,
                                                 uint32_t code, const Parcel& data,
                                                 status_t* statusBuffer);
+    [[nodiscard]] status_t queueOnewayTransaction(int32_t handle, uint32_t code,
+                                                  const Parcel& data, uint32_t flags);
     [[nodiscard]] status_t getAndExecuteCommand();
     [[nodiscard]] status_t executeCommand(int32_t command);
     void processPendingDerefs();
@@ -254,6 +286,16 @@ private:
             int32_t             mStrictModePolicy;
             int32_t             mLastTransactionBinderFlags;
             CallRestriction     mCallRestriction;
+            bool                mParcelArenaEnabled;
+            // Largest synchronous reply built on this thread so far; used to
+            // pre-size reply parcels for incoming transactions.
+            size_t              mReplyDataHighWater;
+            bool mOnewayBatchingEnabled;
+            // Owned copies of batched oneway payloads; the commands queued in mOut point
+            // into them, so they must stay alive until the driver consumes the batch.
+            std::vector<std::unique_ptr<Parcel>> mBatchedOnewayData;
+            size_t mBatchedOnewayBytes;
+            std::function<void(size_t)> mOnewayBatchOverflowCallback;
 };
 
 } // namespace android
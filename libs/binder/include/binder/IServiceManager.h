@@ -161,6 +161,14 @@ LIBBINDER_EXPORTED sp<IServiceManager> defaultServiceManager();
  */
 LIBBINDER_EXPORTED void setDefaultServiceManager(const sp<IServiceManager>& sm);
 
+/**
+ * Seed libbinder's client-side service cache with a single batched servicemanager
+ * call, so subsequent getService/checkService lookups of cachable services are
+ * satisfied without an IPC. Intended to be called once during startup of processes
+ * that look up many services; a no-op when the client cache is disabled.
+ */
+LIBBINDER_EXPORTED void preloadCachedServices();
+
 template<typename INTERFACE>
 sp<INTERFACE> waitForService(const String16& name) {
     const sp<IServiceManager> sm = defaultServiceManager();
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <limits>
 #include <map> // for legacy reasons
 #include <optional>
@@ -401,8 +402,42 @@ public:
     // as long as it keeps a dup of the blob file descriptor handy for later.
     LIBBINDER_EXPORTED status_t writeDupImmutableBlobFileDescriptor(int fd);
 
+    // Writes a contiguous vector of a trivially copyable type as a single
+    // length-prefixed blob instead of marshalling each element. Small arrays
+    // are stored in-place; writeBlob() automatically promotes larger ones to an
+    // anonymous shared memory region, keeping bulk transfers out of the binder
+    // transaction buffer. Pair with readTrivialVector() on the receiving side.
+    template <typename T>
+    status_t writeTrivialVector(const std::vector<T>& val) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "writeTrivialVector requires a trivially copyable element type");
+        if (val.size() > INT32_MAX / sizeof(T)) return BAD_VALUE;
+        status_t status = writeInt32(static_cast<int32_t>(val.size()));
+        if (status != NO_ERROR) return status;
+        if (val.empty()) return NO_ERROR;
+        WritableBlob blob;
+        status = writeBlob(val.size() * sizeof(T), false /*mutableCopy*/, &blob);
+        if (status != NO_ERROR) return status;
+        memcpy(blob.data(), val.data(), val.size() * sizeof(T));
+        blob.release();
+        return NO_ERROR;
+    }
+
     LIBBINDER_EXPORTED status_t writeObject(const flat_binder_object& val, bool nullMetaData);
 
+    // Writes a reference to a large caller-owned buffer. On kernel binder the
+    // buffer is handed to the driver as a scatter-gather segment when the
+    // transaction is sent, so it is never copied into the parcel; the memory
+    // must stay valid and unmodified until the transaction completes. On RPC
+    // binder this degrades to a length-prefixed copy. Pair with
+    // readExternal() on the receiving side.
+    LIBBINDER_EXPORTED status_t writeExternal(const void* buffer, size_t len);
+
+    // Reads a buffer written with writeExternal(). On success *buffer points
+    // into the transaction buffer (no copy) and stays valid for as long as
+    // this parcel's data does.
+    LIBBINDER_EXPORTED status_t readExternal(const void** buffer, size_t* outLen) const;
+
     // Like Parcel.java's writeNoException().  Just writes a zero int32.
     // Currently the native implementation doesn't do any of the StrictMode
     // stack gathering and serialization that the Java implementation does.
@@ -635,6 +670,27 @@ public:
     // The caller should call release() on the blob after reading its contents.
     LIBBINDER_EXPORTED status_t readBlob(size_t len, ReadableBlob* outBlob) const;
 
+    // Reads a vector written with writeTrivialVector(). The element type must
+    // match the one used on the sending side.
+    template <typename T>
+    status_t readTrivialVector(std::vector<T>* val) const {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "readTrivialVector requires a trivially copyable element type");
+        int32_t size;
+        status_t status = readInt32(&size);
+        if (status != NO_ERROR) return status;
+        if (size < 0 || static_cast<size_t>(size) > INT32_MAX / sizeof(T)) return BAD_VALUE;
+        val->clear();
+        if (size == 0) return NO_ERROR;
+        ReadableBlob blob;
+        status = readBlob(static_cast<size_t>(size) * sizeof(T), &blob);
+        if (status != NO_ERROR) return status;
+        val->resize(static_cast<size_t>(size));
+        memcpy(val->data(), blob.data(), val->size() * sizeof(T));
+        blob.release();
+        return NO_ERROR;
+    }
+
     LIBBINDER_EXPORTED const flat_binder_object* readObject(bool nullMetaData) const;
 
     // Explicitly close all file descriptors in the parcel.
@@ -660,6 +716,7 @@ private:
     size_t              ipcDataSize() const;
     uintptr_t           ipcObjects() const;
     size_t              ipcObjectsCount() const;
+    size_t              ipcBufferSize() const;
     void ipcSetDataReference(const uint8_t* data, size_t dataSize, const binder_size_t* objects,
                              size_t objectsCount, release_func relFunc);
     // Takes ownership even when an error is returned.
@@ -911,7 +968,9 @@ private:
             || std::is_same_v<T, uint64_t>
             || std::is_same_v<T, int64_t>
             || std::is_same_v<T, double>
-            || (std::is_enum_v<T> && (sizeof(T) == 1 || sizeof(T) == 4)); // size check not type
+            // 8-byte enums are backed by int64_t/uint64_t, which are handled above.
+            || (std::is_enum_v<T> &&
+                (sizeof(T) == 1 || sizeof(T) == 4 || sizeof(T) == 8)); // size check not type
 
     // allowed "nullable" types
     // These are nonintrusive containers std::optional, std::unique_ptr, std::shared_ptr.
@@ -1340,6 +1399,10 @@ private:
         mutable bool mObjectsSorted = false;
         mutable bool mFdsKnown = true;
         mutable bool mHasFds = false;
+
+        // Total driver-side footprint (8-byte aligned) of buffers referenced
+        // via writeExternal(); sent as buffers_size with BC_TRANSACTION_SG.
+        size_t mExternalBufferSize = 0;
     };
     // Fields only needed when parcelling for RPC Binder.
     struct RpcFields {
@@ -1382,6 +1445,15 @@ private:
     // data to be overridden with zero when deallocated
     mutable bool        mDeallocZero;
 
+    // whether mData was carved out of the allocating thread's parcel arena
+    // rather than malloc'd. See IPCThreadState::setParcelArenaEnabled().
+    bool                mArenaBacked;
+
+    // Enables/disables the calling thread's parcel arena. Called by
+    // IPCThreadState (a friend); not exposed directly because arena-backed
+    // parcels are only safe when confined to the allocating thread.
+    static void setThreadArenaEnabled(bool enabled);
+
     // Set this to false to skip dataAvail checks.
     bool mEnforceNoDataAvail;
     bool mServiceFuzzing;
@@ -21,9 +21,11 @@
 #include <stdint.h>
 #include <unistd.h>
 
+#include <array>
+#include <atomic>
+
 #include <utils/String16.h>
 #include <utils/Singleton.h>
-#include <utils/SortedVector.h>
 #include <binder/Common.h>
 
 namespace android {
@@ -38,25 +40,35 @@ namespace android {
  * IMPORTANT: for the reason stated above, only system permissions are safe
  * to cache. This restriction may be lifted at a later time.
  *
+ * Lookups are lock-free: entries live in a sharded open-addressing table of
+ * atomic 64-bit slots keyed by (pooled permission name, uid), and every slot
+ * carries the epoch it was cached under. purge() bumps the epoch, which
+ * invalidates all entries at once without readers ever taking a lock, so
+ * permission checks scale with the number of binder threads.
  */
 
 class PermissionCache : Singleton<PermissionCache> {
-    struct Entry {
-        String16    name;
-        uid_t       uid;
-        bool        granted;
-        inline bool operator < (const Entry& e) const {
-            return (uid == e.uid) ? (name < e.name) : (uid < e.uid);
-        }
+    static constexpr size_t kNumShards = 8;
+    static constexpr size_t kSlotsPerShard = 256;
+    static constexpr size_t kProbeLength = 8;
+    // we pool all the permission names we see, as many permission checks will
+    // have identical names; a slot stores the pool index, not the string
+    static constexpr size_t kMaxPooledNames = 1024;
+
+    struct Shard {
+        std::array<std::atomic<uint64_t>, kSlotsPerShard> slots;
+        Mutex fillLock; // serializes inserts only; lookups never take it
     };
-    mutable Mutex mLock;
-    // we pool all the permission names we see, as many permissions checks
-    // will have identical names
-    SortedVector< String16 > mPermissionNamesPool;
-    // this is our cache per say. it stores pooled names.
-    SortedVector< Entry > mCache;
-
-    // free the whole cache, but keep the permission name pool
+    mutable std::array<Shard, kNumShards> mShards;
+    std::atomic<uint32_t> mEpoch{0};
+
+    mutable Mutex mNamePoolLock;
+    String16 mNamePool[kMaxPooledNames];
+    std::atomic<uint32_t> mNamePoolSize{0};
+
+    ssize_t findPooledName(const String16& permission) const;
+
+    // invalidate the whole cache, but keep the permission name pool
     void purge();
 
     status_t check(bool* granted,
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -32,12 +34,20 @@ namespace os {
 /*
  * C++ implementation of PersistableBundle, a mapping from String values to
  * various types that can be saved to persistent and later restored.
+ *
+ * A bundle read from a parcel keeps the raw parcel bytes and defers parsing
+ * until a key is first accessed, so transactions that carry large bundles
+ * only pay for the entries they actually touch. Materialization is
+ * synchronized, mirroring the Java BaseBundle, so concurrent const reads of
+ * a bundle fresh off a parcel remain safe; mixed reads and writes still
+ * require external synchronization, as before.
  */
 class LIBBINDER_EXPORTED PersistableBundle : public Parcelable {
 public:
     PersistableBundle() = default;
     virtual ~PersistableBundle() = default;
-    PersistableBundle(const PersistableBundle& bundle) = default;
+    PersistableBundle(const PersistableBundle& bundle);
+    PersistableBundle& operator=(const PersistableBundle& bundle);
 
     status_t writeToParcel(Parcel* parcel) const override;
     status_t readFromParcel(const Parcel* parcel) override;
@@ -93,7 +103,17 @@ public:
     std::set<String16> getStringVectorKeys() const;
     std::set<String16> getPersistableBundleKeys() const;
 
+    /*
+     * Parses any deferred parcel data and returns the result: NO_ERROR if
+     * this bundle holds no deferred data or parsing succeeded, or the sticky
+     * error from a corrupt payload. Lets callers that relied on
+     * readFromParcel() failing eagerly still observe the error.
+     */
+    status_t deferredParseStatus() const;
+
     friend bool operator==(const PersistableBundle& lhs, const PersistableBundle& rhs) {
+        lhs.unparcel();
+        rhs.unparcel();
         return (lhs.mBoolMap == rhs.mBoolMap && lhs.mIntMap == rhs.mIntMap &&
                 lhs.mLongMap == rhs.mLongMap && lhs.mDoubleMap == rhs.mDoubleMap &&
                 lhs.mStringMap == rhs.mStringMap && lhs.mBoolVectorMap == rhs.mBoolVectorMap &&
@@ -112,6 +132,28 @@ private:
     status_t writeToParcelInner(Parcel* parcel) const;
     status_t readFromParcelInner(const Parcel* parcel, size_t length);
 
+    /* Reads key-value pairs from |parcel|, merging them into the member maps. */
+    status_t readEntries(const Parcel* parcel);
+
+    /*
+     * Parses any deferred parcel bytes into the member maps. Called by every
+     * accessor, so the cost of parsing is only paid for bundles that are
+     * actually inspected.
+     */
+    void unparcel() const;
+
+    /* Guards materialization of mParcelledData and the parse status. */
+    mutable std::mutex mUnparcelMutex;
+
+    /*
+     * Raw bytes of a bundle read from a parcel that have not been parsed yet.
+     * Reset once parsed into the member maps.
+     */
+    std::shared_ptr<Parcel> mParcelledData;
+
+    /* Result of the deferred parse; sticky once it fails. */
+    status_t mDeferredParseStatus = NO_ERROR;
+
     std::map<String16, bool> mBoolMap;
     std::map<String16, int32_t> mIntMap;
     std::map<String16, int64_t> mLongMap;
@@ -26,7 +26,10 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <array>
+#include <map>
 #include <mutex>
+#include <optional>
 
 // ---------------------------------------------------------------------------
 namespace android {
@@ -81,6 +84,10 @@ public:
     [[nodiscard]] LIBBINDER_EXPORTED bool becomeContextManager();
 
     LIBBINDER_EXPORTED sp<IBinder> getStrongProxyForHandle(int32_t handle);
+    // Returns the existing proxy for the handle without creating one or touching its
+    // reference counts. Only safe when the caller already holds a strong reference on
+    // the proxy, e.g. when releasing references previously acquired through a Parcel.
+    LIBBINDER_EXPORTED IBinder* getExistingProxyForHandle(int32_t handle);
     LIBBINDER_EXPORTED void expungeHandle(int32_t handle, IBinder* binder);
 
     // TODO: deprecate.
@@ -118,6 +125,31 @@ public:
     // before any threads are spawned.
     LIBBINDER_EXPORTED void setCallRestriction(CallRestriction restriction);
 
+    /**
+     * Scheduling policy applied to a binder thread for the duration of an incoming call on a
+     * matching interface. Latency-critical services can pin their calls to fast cores with
+     * real-time priority while bulk traffic keeps the pool defaults.
+     */
+    struct ThreadServicePolicy {
+        // Bitmask of CPUs the servicing thread may run on during the call; 0 leaves the
+        // thread's affinity untouched.
+        uint64_t cpuAffinityMask = 0;
+        // SCHED_OTHER, SCHED_FIFO or SCHED_RR; -1 leaves the scheduler untouched.
+        int schedPolicy = -1;
+        // Priority for SCHED_FIFO/SCHED_RR; ignored for SCHED_OTHER.
+        int schedPriority = 0;
+    };
+
+    /**
+     * Register (or replace) the scheduling policy for incoming calls on the interface with the
+     * given descriptor. IPCThreadState applies the policy around each transaction on a local
+     * binder whose interface descriptor matches, and restores the thread's previous scheduling
+     * and affinity afterwards. The kernel still picks which pool thread services a call, so the
+     * policy follows the call, not a dedicated thread.
+     */
+    LIBBINDER_EXPORTED status_t setThreadServicePolicy(const String16& descriptor,
+                                                       const ThreadServicePolicy& policy);
+
     /**
      * Get the max number of threads that have joined the thread pool.
      * This includes kernel started threads, user joined threads and polling
@@ -130,6 +162,26 @@ public:
      */
     LIBBINDER_EXPORTED bool isThreadPoolStarted() const;
 
+    /**
+     * Snapshot of thread pool utilization since the process started. The
+     * counters are maintained on the transaction path with relaxed atomics,
+     * so values may be slightly stale under concurrency but are cheap enough
+     * to collect from a dump without perturbing the pool.
+     */
+    struct ThreadPoolStats {
+        // Maximum number of threads the kernel may start for this pool.
+        size_t maxThreads = 0;
+        // Threads currently executing a command.
+        size_t executingThreads = 0;
+        // Highest number of simultaneously executing threads observed.
+        size_t executingThreadsPeak = 0;
+        // Number of times the pool went from saturated back to having a free thread.
+        uint64_t starvationEpisodes = 0;
+        // Total time the pool spent with every thread busy, in milliseconds.
+        int64_t starvationTimeMs = 0;
+    };
+    LIBBINDER_EXPORTED ThreadPoolStats getThreadPoolStats() const;
+
     enum class DriverFeature {
         ONEWAY_SPAM_DETECTION,
         EXTENDED_ERROR,
@@ -160,7 +212,26 @@ private:
         RefBase::weakref_type* refs;
     };
 
-    handle_entry* lookupHandleLocked(int32_t handle);
+    // The handle table is sharded so proxy lookups for different handles do
+    // not contend on a single process-wide lock. A handle lives in shard
+    // (handle % kHandleTableShards) at index (handle / kHandleTableShards),
+    // and the shard's own mutex covers both the lookup and the expunge path
+    // for its handles, preserving the attemptIncWeak()/expungeHandle() race
+    // protection per shard.
+    static constexpr size_t kHandleTableShards = 16;
+    struct HandleTableShard {
+        std::mutex lock;
+        Vector<handle_entry> entries;
+    };
+
+    handle_entry* lookupHandleLocked(HandleTableShard& shard, int32_t handle);
+
+    // Whether any thread service policy has been registered. Lets IPCThreadState skip the
+    // policy lookup on the transaction fast path when the feature is unused.
+    bool hasThreadServicePolicies() const {
+        return mHasThreadServicePolicies.load(std::memory_order_relaxed);
+    }
+    std::optional<ThreadServicePolicy> getThreadServicePolicy(const String16& descriptor) const;
 
     String8 mDriverName;
     int mDriverFD;
@@ -179,6 +250,12 @@ private:
     std::atomic_size_t mCurrentThreads;
     // Current number of pooled threads inside the thread pool.
     std::atomic_size_t mKernelStartedThreads;
+    // Highest number of simultaneously executing binder threads observed.
+    std::atomic_size_t mExecutingThreadsPeak;
+    // Number of completed pool saturation episodes.
+    std::atomic_uint64_t mStarvationCount;
+    // Total time the pool has spent saturated, in milliseconds.
+    std::atomic_int64_t mStarvationTimeMs;
     // Time when thread pool was emptied
     std::atomic<std::chrono::steady_clock::time_point> mStarvationStartTime;
 
@@ -186,13 +263,16 @@ private:
 
     mutable std::mutex mLock; // protects everything below.
 
-    Vector<handle_entry> mHandleToObject;
+    std::array<HandleTableShard, kHandleTableShards> mHandleTable;
 
     bool mForked;
     std::atomic_bool mThreadPoolStarted;
     std::atomic_int32_t mThreadPoolSeq;
 
     CallRestriction mCallRestriction;
+
+    std::atomic_bool mHasThreadServicePolicies = false;
+    std::map<String16, ThreadServicePolicy> mThreadServicePolicies; // protected by mLock
 };
 
 } // namespace android
@@ -19,7 +19,9 @@
 #include <binder/Common.h>
 #include <binder/Parcel.h>
 #include <binder/unique_fd.h>
+#include <cstddef>
 #include <mutex>
+#include <vector>
 
 namespace android {
 
@@ -56,8 +58,8 @@ public:
 private:
     RecordedTransaction() = default;
 
-    android::status_t writeChunk(const binder::borrowed_fd, uint32_t chunkType, size_t byteCount,
-                                 const uint8_t* data) const;
+    android::status_t appendChunk(std::vector<std::byte>& buffer, uint32_t chunkType,
+                                  size_t byteCount, const uint8_t* data) const;
 
 #pragma clang diagnostic push
 #pragma clang diagnostic error "-Wpadded"
@@ -23,6 +23,7 @@
 #include <utils/Errors.h>
 #include <utils/RefBase.h>
 
+#include <functional>
 #include <map>
 #include <optional>
 #include <vector>
@@ -385,6 +386,16 @@ private:
     bool mStartedSetup = false;
     size_t mMaxIncomingThreads = 0;
     size_t mMaxOutgoingConnections = kDefaultMaxOutgoingConnections;
+    // Set for socket-based client sessions. When present, outgoing connections
+    // beyond the first are brought up on demand (when all existing connections
+    // are busy), up to the limit negotiated during setup, instead of all at
+    // once during setup.
+    std::function<status_t(const std::vector<uint8_t>& sessionId)> mOutgoingConnectionFactory;
+    // min of the server's thread count and mMaxOutgoingConnections, known once
+    // setup has completed
+    size_t mDesiredOutgoingConnections = 0;
+    // whether a thread is currently adding an outgoing connection on demand
+    bool mAddingOutgoingConnection = false;
     std::optional<uint32_t> mProtocolVersion;
     FileDescriptorTransportMode mFileDescriptorTransportMode = FileDescriptorTransportMode::NONE;
 
@@ -36,6 +36,7 @@ public:
 class LIBBINDER_EXPORTED RpcMutexUniqueLock {
 public:
     RpcMutexUniqueLock(RpcMutex&) {}
+    void lock() {}
     void unlock() {}
 };
 
@@ -77,6 +77,11 @@ public:
     // A more readable alias for the default constructor.
     static Status ok();
 
+    // A shared immutable OK status, for high-rate paths that need a Status by
+    // const reference. Avoids constructing and destroying a Status (and the
+    // reference count traffic of its message string) on every call.
+    static const Status& okRef();
+
     // Authors should explicitly pick whether their integer is:
     //  - an exception code (EX_* above)
     //  - service specific error code
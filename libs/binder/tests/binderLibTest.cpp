@@ -17,11 +17,14 @@
 #include <errno.h>
 #include <poll.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <thread>
 
 #include <gmock/gmock.h>
@@ -30,6 +33,7 @@
 #include <android-base/logging.h>
 #include <android-base/properties.h>
 #include <android-base/result-gmock.h>
+#include <binder/AsyncTransactionQueue.h>
 #include <binder/Binder.h>
 #include <binder/BpBinder.h>
 #include <binder/Functional.h>
@@ -541,6 +545,24 @@ TEST_F(BinderLibTest, CannotUseBinderAfterFork) {
     EXPECT_DEATH({ ProcessState::self(); }, "libbinder ProcessState can not be used after fork");
 }
 
+TEST_F(BinderLibTest, ThreadServicePolicyValidation) {
+    ProcessState::ThreadServicePolicy policy;
+    policy.schedPolicy = 12345;
+    EXPECT_EQ(BAD_VALUE,
+              ProcessState::self()->setThreadServicePolicy(String16("test.interface"), policy));
+
+    policy.schedPolicy = SCHED_FIFO;
+    policy.schedPriority = sched_get_priority_max(SCHED_FIFO) + 1;
+    EXPECT_EQ(BAD_VALUE,
+              ProcessState::self()->setThreadServicePolicy(String16("test.interface"), policy));
+
+    // An affinity-only policy needs no scheduler change and is always valid.
+    policy = {};
+    policy.cpuAffinityMask = 0x1;
+    EXPECT_EQ(NO_ERROR,
+              ProcessState::self()->setThreadServicePolicy(String16("test.interface"), policy));
+}
+
 TEST_F(BinderLibTest, AddManagerToManager) {
     sp<IServiceManager> sm = defaultServiceManager();
     sp<IBinder> binder = IInterface::asBinder(sm);
@@ -596,6 +618,69 @@ TEST_F(BinderLibTest, NopTransactionOneway) {
                 StatusEq(NO_ERROR));
 }
 
+TEST_F(BinderLibTest, NopTransactionOnewayBatched) {
+    IPCThreadState* state = IPCThreadState::self();
+    state->setOnewayBatchingEnabled(true);
+    for (int i = 0; i < 16; i++) {
+        Parcel data, reply;
+        EXPECT_THAT(m_server->transact(BINDER_LIB_TEST_NOP_TRANSACTION, data, &reply, TF_ONE_WAY),
+                    StatusEq(NO_ERROR));
+    }
+    // Disabling batching flushes anything still queued.
+    state->setOnewayBatchingEnabled(false);
+    // The server is still reachable after the batch is delivered.
+    Parcel data, reply;
+    EXPECT_THAT(m_server->transact(BINDER_LIB_TEST_NOP_TRANSACTION, data, &reply),
+                StatusEq(NO_ERROR));
+}
+
+TEST_F(BinderLibTest, AsyncTransactionQueueFanOut) {
+    constexpr size_t kCalls = 8;
+    AsyncTransactionQueue queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t completed = 0;
+    std::vector<int32_t> pids;
+    for (size_t i = 0; i < kCalls; i++) {
+        queue.transact(m_server, BINDER_LIB_TEST_GETPID, queue.obtainParcel(),
+                       [&](status_t status, const Parcel& reply) {
+                           EXPECT_THAT(status, StatusEq(NO_ERROR));
+                           std::lock_guard<std::mutex> lock(mutex);
+                           pids.push_back(reply.readInt32());
+                           completed++;
+                           cv.notify_one();
+                       });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(10),
+                            [&] { return completed == kCalls; }));
+    for (int32_t pid : pids) {
+        EXPECT_GT(pid, 0);
+        EXPECT_EQ(pids[0], pid);
+    }
+}
+
+TEST_F(BinderLibTest, NopTransactionOnewayBatchedLooperThread) {
+    std::thread looper([&] {
+        IPCThreadState* state = IPCThreadState::self();
+        state->setOnewayBatchingEnabled(true);
+        for (int i = 0; i < 4; i++) {
+            Parcel data, reply;
+            EXPECT_THAT(m_server->transact(BINDER_LIB_TEST_NOP_TRANSACTION, data, &reply,
+                                           TF_ONE_WAY),
+                        StatusEq(NO_ERROR));
+        }
+        state->setOnewayBatchingEnabled(false);
+        // The flush left one BR_TRANSACTION_COMPLETE per batched call queued for this
+        // thread. Entering the looper must consume them benignly instead of treating them
+        // as bad commands.
+        int fd;
+        EXPECT_THAT(state->setupPolling(&fd), StatusEq(NO_ERROR));
+        EXPECT_THAT(state->handlePolledCommands(), StatusEq(NO_ERROR));
+    });
+    looper.join();
+}
+
 TEST_F(BinderLibTest, NopTransactionClear) {
     Parcel data, reply;
     // make sure it accepts the transaction flag
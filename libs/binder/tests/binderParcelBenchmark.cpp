@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <binder/Binder.h>
 #include <binder/Parcel.h>
 #include <benchmark/benchmark.h>
 
@@ -169,4 +170,36 @@ BENCHMARK(BM_CharVector)->Apply(VectorArgs);
 BENCHMARK(BM_Int32Vector)->Apply(VectorArgs);
 BENCHMARK(BM_Int64Vector)->Apply(VectorArgs);
 
+/*
+  Out-of-order reads of plain data from a parcel holding many binder objects.
+  Every read reposition forces validateReadData to locate the read against the
+  object offset array, so this measures the object lookup, not the payload copy.
+*/
+static void BM_ObjectScatteredRead(benchmark::State& state) {
+    const size_t objects = state.range(0);
+
+    android::sp<android::BBinder> binder = android::sp<android::BBinder>::make();
+    android::Parcel p;
+    std::vector<size_t> positions(objects);
+    for (size_t i = 0; i < objects; ++i) {
+        positions[i] = p.dataPosition();
+        p.writeInt32(static_cast<int32_t>(i));
+        p.writeStrongBinder(binder);
+    }
+
+    while (state.KeepRunning()) {
+        // Read the data words in reverse so every read is out of order with
+        // respect to the object offsets.
+        for (size_t i = objects; i-- > 0;) {
+            p.setDataPosition(positions[i]);
+            int32_t value;
+            p.readInt32(&value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetComplexityN(objects);
+}
+
+BENCHMARK(BM_ObjectScatteredRead)->Apply(VectorArgs);
+
 BENCHMARK_MAIN();
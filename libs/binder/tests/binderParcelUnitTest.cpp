@@ -401,6 +401,55 @@ TEST_READ_WRITE_INVERSE(int8_t, Byte, {-1, 0, 1});
 TEST_READ_WRITE_INVERSE(String8, String8, {String8(), String8("a"), String8("asdf")});
 TEST_READ_WRITE_INVERSE(String16, String16, {String16(), String16("a"), String16("asdf")});
 
+TEST(Parcel, TrivialVectorInPlaceRoundTrip) {
+    const std::vector<float> kConfig = {-1.0f, 0.0f, 3.14f, 1e6f};
+
+    Parcel p;
+    ASSERT_EQ(OK, p.writeTrivialVector(kConfig));
+
+    p.setDataPosition(0);
+    std::vector<float> result;
+    ASSERT_EQ(OK, p.readTrivialVector(&result));
+    EXPECT_EQ(kConfig, result);
+}
+
+TEST(Parcel, TrivialVectorEmptyRoundTrip) {
+    Parcel p;
+    ASSERT_EQ(OK, p.writeTrivialVector(std::vector<int32_t>()));
+
+    p.setDataPosition(0);
+    std::vector<int32_t> result = {1, 2, 3};
+    ASSERT_EQ(OK, p.readTrivialVector(&result));
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(Parcel, TrivialVectorAshmemRoundTrip) {
+    // Large enough that writeBlob() promotes the payload to ashmem rather than
+    // storing it in-place (the in-place limit is 16KiB).
+    std::vector<int32_t> kEvents(32 * 1024);
+    for (size_t i = 0; i < kEvents.size(); i++) {
+        kEvents[i] = static_cast<int32_t>(i);
+    }
+
+    Parcel p;
+    ASSERT_EQ(OK, p.writeTrivialVector(kEvents));
+    EXPECT_GE(p.getOpenAshmemSize(), kEvents.size() * sizeof(int32_t));
+
+    p.setDataPosition(0);
+    std::vector<int32_t> result;
+    ASSERT_EQ(OK, p.readTrivialVector(&result));
+    EXPECT_EQ(kEvents, result);
+}
+
+TEST(Parcel, TrivialVectorRejectsBadSize) {
+    Parcel p;
+    ASSERT_EQ(OK, p.writeInt32(-1));
+
+    p.setDataPosition(0);
+    std::vector<int32_t> result;
+    EXPECT_EQ(android::BAD_VALUE, p.readTrivialVector(&result));
+}
+
 TEST(Parcel, GetOpenAshmemSize) {
     constexpr size_t kSize = 1024;
     constexpr size_t kCount = 3;
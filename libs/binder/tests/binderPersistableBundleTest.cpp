@@ -18,6 +18,7 @@
 #include <binder/PersistableBundle.h>
 #include <gtest/gtest.h>
 #include <numeric>
+#include <thread>
 
 using android::OK;
 using android::Parcel;
@@ -119,6 +120,70 @@ TEST(PersistableBundle, ParcelAndUnparcel) {
     EXPECT_EQ(expected, out);
 }
 
+TEST(PersistableBundle, ForwardWithoutAccess) {
+    // A bundle read from a parcel defers parsing; writing it back out again
+    // should forward the raw bytes and still round-trip correctly.
+    PersistableBundle expected = createSimplePersistableBundle();
+
+    Parcel p{};
+    EXPECT_EQ(expected.writeToParcel(&p), 0);
+    p.setDataPosition(0);
+
+    PersistableBundle carried{};
+    EXPECT_EQ(carried.readFromParcel(&p), 0);
+
+    Parcel p2{};
+    EXPECT_EQ(carried.writeToParcel(&p2), 0);
+    p2.setDataPosition(0);
+
+    PersistableBundle out{};
+    EXPECT_EQ(out.readFromParcel(&p2), 0);
+
+    EXPECT_EQ(expected, out);
+}
+
+TEST(PersistableBundle, DeferredParseErrorIsObservable) {
+    Parcel p{};
+    // Payload claims five entries but is truncated; the failure only surfaces
+    // once the deferred bytes are materialized.
+    ASSERT_EQ(p.writeInt32(8), 0);           // length
+    ASSERT_EQ(p.writeInt32(0x4C444E44), 0);  // BUNDLE_MAGIC_NATIVE
+    ASSERT_EQ(p.writeInt32(5), 0);           // num_entries
+    ASSERT_EQ(p.writeInt32(0x7FFFFFFF), 0);  // truncated first key
+    p.setDataPosition(0);
+
+    PersistableBundle pb{};
+    ASSERT_EQ(pb.readFromParcel(&p), 0);
+    EXPECT_NE(pb.deferredParseStatus(), 0);
+    EXPECT_EQ(pb.size(), 0u);
+}
+
+TEST(PersistableBundle, ConcurrentFirstAccess) {
+    PersistableBundle expected = createSimplePersistableBundle();
+
+    Parcel p{};
+    EXPECT_EQ(expected.writeToParcel(&p), 0);
+    p.setDataPosition(0);
+
+    PersistableBundle carried{};
+    ASSERT_EQ(carried.readFromParcel(&p), 0);
+
+    // Several readers race to materialize the deferred bytes; exactly one
+    // should parse and every reader should see the full contents.
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&] {
+            int32_t val{};
+            EXPECT_TRUE(carried.getInt(kKey, &val));
+            EXPECT_EQ(val, 64);
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(expected, carried);
+}
+
 TEST(PersistableBundle, OverwriteKey) {
     PersistableBundle pb{};
 
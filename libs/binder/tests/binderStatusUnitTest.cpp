@@ -21,6 +21,21 @@
 using android::Parcel;
 using android::binder::Status;
 
+TEST(Status, OkRefMatchesOk) {
+    const Status& shared = Status::okRef();
+    EXPECT_TRUE(shared.isOk());
+    // The shared instance is stable across calls.
+    EXPECT_EQ(&shared, &Status::okRef());
+
+    Parcel fromShared;
+    shared.writeToParcel(&fromShared);
+
+    Parcel fromOk;
+    Status::ok().writeToParcel(&fromOk);
+
+    EXPECT_EQ(0, fromShared.compareData(fromOk));
+}
+
 TEST(Status, WriteOverParcel) {
     Status status = Status::fromExceptionCode(Status::EX_NULL_POINTER);
 
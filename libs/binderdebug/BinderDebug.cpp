@@ -19,6 +19,8 @@
 #include <android-base/strings.h>
 #include <binder/Binder.h>
 #include <sys/types.h>
+#include <cinttypes>
+#include <cstdio>
 #include <fstream>
 #include <regex>
 
@@ -127,6 +129,71 @@ status_t getBinderPidInfo(BinderDebugContext context, pid_t pid, BinderPidInfo*
     return ret;
 }
 
+// Example of the per-process section we are looking at:
+// proc 2300
+// context binder
+//   threads: 4
+//   requested threads: 0+2/15
+//   ready threads 3
+//   free async space 520192
+status_t getBinderPoolStats(BinderDebugContext context, pid_t pid, BinderPoolStats* poolStats) {
+    std::ifstream ifs("/dev/binderfs/binder_logs/stats");
+    if (!ifs.is_open()) {
+        ifs.open("/d/binder/stats");
+        if (!ifs.is_open()) {
+            return -errno;
+        }
+    }
+
+    std::string contextStr = contextToString(context);
+    bool isDesiredProc = false;
+    bool isDesiredContext = false;
+    bool found = false;
+    std::string line;
+    while (getline(ifs, line)) {
+        if (base::StartsWith(line, "proc ")) {
+            if (found) {
+                break;
+            }
+            isDesiredProc = base::Split(line, " ").back() == std::to_string(pid);
+            isDesiredContext = false;
+            continue;
+        }
+        if (!isDesiredProc) {
+            continue;
+        }
+        if (base::StartsWith(line, "context")) {
+            isDesiredContext = base::Split(line, " ").back() == contextStr;
+            continue;
+        }
+        if (!isDesiredContext) {
+            continue;
+        }
+        uint32_t requested;
+        uint32_t started;
+        uint32_t max;
+        uint32_t count;
+        unsigned long long asyncSpace;
+        if (sscanf(line.c_str(), " threads: %" SCNu32, &count) == 1) {
+            poolStats->threadCount = count;
+            found = true;
+        } else if (sscanf(line.c_str(), " requested threads: %" SCNu32 "+%" SCNu32 "/%" SCNu32,
+                          &requested, &started, &max) == 3) {
+            poolStats->requestedThreads = requested;
+            poolStats->requestedThreadsStarted = started;
+            poolStats->maxThreads = max;
+            found = true;
+        } else if (sscanf(line.c_str(), " ready threads %" SCNu32, &count) == 1) {
+            poolStats->readyThreads = count;
+            found = true;
+        } else if (sscanf(line.c_str(), " free async space %llu", &asyncSpace) == 1) {
+            poolStats->freeAsyncSpace = asyncSpace;
+            found = true;
+        }
+    }
+    return found ? OK : NAME_NOT_FOUND;
+}
+
 // Examples of what we are looking at:
 // ref 52493: desc 910 node 52492 s 1 w 1 d 0000000000000000
 // node 29413: u00007803fc982e80 c000078042c982210 pri 0:139 hs 1 hw 1 ls 0 lw 0 is 2 iw 2 tr 1 proc 488 683
@@ -34,10 +34,25 @@ enum class BinderDebugContext {
     VNDBINDER,
 };
 
+struct BinderPoolStats {
+    uint32_t threadCount = 0;              // threads created for this process
+    uint32_t requestedThreads = 0;         // spawn requests currently outstanding
+    uint32_t requestedThreadsStarted = 0;  // threads started on kernel request
+    uint32_t maxThreads = 0;               // configured pool limit
+    uint32_t readyThreads = 0;             // threads idle and waiting for work
+    uint64_t freeAsyncSpace = 0;           // remaining async transaction buffer, in bytes
+};
+
 /**
  * pid is the pid of the service
  */
 status_t getBinderPidInfo(BinderDebugContext context, pid_t pid, BinderPidInfo* pidInfo);
+/**
+ * Thread pool utilization for a given process, parsed from the per-process
+ * section of /dev/binderfs/binder_logs/stats. A pool is saturated when
+ * readyThreads is 0 while threadCount has reached maxThreads.
+ */
+status_t getBinderPoolStats(BinderDebugContext context, pid_t pid, BinderPoolStats* poolStats);
 /**
  * pid is typically the pid of this process that is making the query
  */
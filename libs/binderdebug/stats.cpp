@@ -29,7 +29,8 @@ extern "C" int main() {
 
     // we should use a csv library here for escaping, because
     // the name is coming from another process
-    printf("name,binder_threads_in_use,binder_threads_started,client_count\n");
+    printf("name,binder_threads_in_use,binder_threads_started,binder_threads_ready,binder_"
+           "threads_max,client_count\n");
 
     for (const String16& name : defaultServiceManager()->listServices()) {
         sp<IBinder> binder = defaultServiceManager()->checkService(name);
@@ -48,13 +49,17 @@ extern "C" int main() {
         BinderPidInfo info;
         CHECK_EQ(OK, getBinderPidInfo(BinderDebugContext::BINDER, pid, &info));
 
+        BinderPoolStats poolStats;
+        CHECK_EQ(OK, getBinderPoolStats(BinderDebugContext::BINDER, pid, &poolStats));
+
         std::vector<pid_t> clientPids;
         CHECK_EQ(OK,
                  getBinderClientPids(BinderDebugContext::BINDER, getpid(), pid, *handle,
                                      &clientPids));
 
-        printf("%s,%" PRIu32 ",%" PRIu32 ",%zu\n", String8(name).c_str(), info.threadUsage,
-               info.threadCount, clientPids.size());
+        printf("%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%zu\n", String8(name).c_str(),
+               info.threadUsage, info.threadCount, poolStats.readyThreads, poolStats.maxThreads,
+               clientPids.size());
     }
     return 0;
 }
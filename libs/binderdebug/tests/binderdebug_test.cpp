@@ -60,6 +60,24 @@ TEST(BinderDebugTests, BinderThreads) {
     EXPECT_GE(pidInfo.threadCount, 1);
 }
 
+TEST(BinderDebugTests, BinderPoolStats) {
+    BinderPoolStats poolStats;
+    const auto& status = getBinderPoolStats(BinderDebugContext::BINDER, getpid(), &poolStats);
+    ASSERT_EQ(status, OK);
+    // main() configures the pool for 8 kernel-started threads.
+    EXPECT_EQ(poolStats.maxThreads, 8u);
+    EXPECT_GE(poolStats.threadCount, 1u);
+    EXPECT_LE(poolStats.readyThreads, poolStats.threadCount);
+}
+
+TEST(BinderDebugTests, ThreadPoolStats) {
+    const auto stats = ProcessState::self()->getThreadPoolStats();
+    EXPECT_EQ(stats.maxThreads, 8u);
+    // At least the Control::Continue call from the client process has executed.
+    EXPECT_GE(stats.executingThreadsPeak, 1u);
+    EXPECT_LE(stats.executingThreads, stats.maxThreads);
+}
+
 extern "C" {
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -22,7 +22,10 @@
 #include <dirent.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <linux/bpf.h>
+#include <sys/syscall.h>
 #include <sys/sysinfo.h>
+#include <unistd.h>
 
 #include <mutex>
 #include <numeric>
@@ -337,6 +340,65 @@ std::optional<std::vector<std::vector<uint64_t>>> getUidCpuFreqTimes(uint32_t ui
     return out;
 }
 
+static bool gBatchLookupSupported = true;
+
+// Snapshots every entry of the per-cpu hash map fd with BPF_MAP_LOOKUP_BATCH: one
+// syscall per batch of entries instead of a get_next_key plus a lookup per entry,
+// which dominates the cost of a full-map read on a busy device. Returns nullopt if
+// the kernel lacks batch operations (pre-5.6, remembered so later polls skip the
+// attempt) or if a batch read fails; callers then fall back to the per-key walk.
+template <typename Key, typename Val>
+static std::optional<std::vector<std::pair<Key, std::vector<Val>>>> readMapBatched(int fd) {
+    constexpr uint32_t kBatchCount = 64;
+    if (!gBatchLookupSupported) return {};
+
+    std::vector<std::pair<Key, std::vector<Val>>> out;
+    std::vector<Key> keys(kBatchCount);
+    std::vector<Val> vals(kBatchCount * gNCpus);
+    // Opaque batch positions; for hash maps the kernel uses a u32 bucket index.
+    uint64_t inBatch = 0, outBatch = 0;
+    bool first = true;
+    while (true) {
+        union bpf_attr attr = {};
+        attr.batch.in_batch = first ? 0 : reinterpret_cast<uintptr_t>(&inBatch);
+        attr.batch.out_batch = reinterpret_cast<uintptr_t>(&outBatch);
+        attr.batch.keys = reinterpret_cast<uintptr_t>(keys.data());
+        attr.batch.values = reinterpret_cast<uintptr_t>(vals.data());
+        attr.batch.count = kBatchCount;
+        attr.batch.map_fd = static_cast<uint32_t>(fd);
+        int ret = syscall(__NR_bpf, BPF_MAP_LOOKUP_BATCH, &attr, sizeof(attr));
+        if (ret < 0 && errno != ENOENT) {
+            if (errno == EINVAL) gBatchLookupSupported = false;
+            return {};
+        }
+        for (uint32_t i = 0; i < attr.batch.count; ++i) {
+            out.emplace_back(keys[i],
+                             std::vector<Val>(vals.begin() + i * gNCpus,
+                                              vals.begin() + (i + 1) * gNCpus));
+        }
+        if (ret < 0) break; // ENOENT: no entries past this batch
+        inBatch = outBatch;
+        first = false;
+    }
+    return out;
+}
+
+// Adds one (uid, bucket) map entry's per-cpu values into the per-policy totals.
+static void accumulateTisEntry(const time_key_t &key, const std::vector<tis_val_t> &vals,
+                               std::vector<std::vector<uint64_t>> *out) {
+    auto offset = key.bucket * FREQS_PER_ENTRY;
+    auto nextOffset = (key.bucket + 1) * FREQS_PER_ENTRY;
+    for (uint32_t i = 0; i < gNPolicies; ++i) {
+        if (offset >= gPolicyFreqs[i].size()) continue;
+        auto begin = (*out)[i].begin() + offset;
+        auto end = nextOffset < gPolicyFreqs[i].size() ? begin + FREQS_PER_ENTRY : (*out)[i].end();
+        for (const auto &cpu : gPolicyCpus[i]) {
+            std::transform(begin, end, std::begin(vals[gCpuIndexMap[cpu]].ar), begin,
+                           std::plus<uint64_t>());
+        }
+    }
+}
+
 static std::optional<bool> uidUpdatedSince(uint32_t uid, uint64_t lastUpdate,
                                            uint64_t *newLastUpdate) {
     uint64_t uidLastUpdate;
@@ -366,17 +428,40 @@ getUidsCpuFreqTimes() {
 std::optional<std::unordered_map<uint32_t, std::vector<std::vector<uint64_t>>>>
 getUidsUpdatedCpuFreqTimes(uint64_t *lastUpdate) {
     if (!gInitialized && !initGlobals()) return {};
-    time_key_t key, prevKey;
     std::unordered_map<uint32_t, std::vector<std::vector<uint64_t>>> map;
-    if (getFirstMapKey(gTisMapFd, &key)) {
-        if (errno == ENOENT) return map;
-        return std::nullopt;
-    }
 
     std::vector<std::vector<uint64_t>> mapFormat;
     for (const auto &freqList : gPolicyFreqs) mapFormat.emplace_back(freqList.size(), 0);
 
     uint64_t newLastUpdate = lastUpdate ? *lastUpdate : 0;
+
+    if (auto entries = readMapBatched<time_key_t, tis_val_t>(gTisMapFd)) {
+        // The changed-uid filter is cached per uid since each uid has one map entry
+        // per freq bucket.
+        std::unordered_map<uint32_t, bool> uidUpdatedCache;
+        for (const auto &[key, vals] : *entries) {
+            if (lastUpdate) {
+                auto [it, inserted] = uidUpdatedCache.emplace(key.uid, false);
+                if (inserted) {
+                    auto uidUpdated = uidUpdatedSince(key.uid, *lastUpdate, &newLastUpdate);
+                    if (!uidUpdated.has_value()) return {};
+                    it->second = *uidUpdated;
+                }
+                if (!it->second) continue;
+            }
+            if (map.find(key.uid) == map.end()) map.emplace(key.uid, mapFormat);
+            accumulateTisEntry(key, vals, &map[key.uid]);
+        }
+        if (lastUpdate && newLastUpdate > *lastUpdate) *lastUpdate = newLastUpdate;
+        return map;
+    }
+
+    time_key_t key, prevKey;
+    if (getFirstMapKey(gTisMapFd, &key)) {
+        if (errno == ENOENT) return map;
+        return std::nullopt;
+    }
+
     std::vector<tis_val_t> vals(gNCpus);
     do {
         if (lastUpdate) {
@@ -386,19 +471,7 @@ getUidsUpdatedCpuFreqTimes(uint64_t *lastUpdate) {
         }
         if (findMapEntry(gTisMapFd, &key, vals.data())) return {};
         if (map.find(key.uid) == map.end()) map.emplace(key.uid, mapFormat);
-
-        auto offset = key.bucket * FREQS_PER_ENTRY;
-        auto nextOffset = (key.bucket + 1) * FREQS_PER_ENTRY;
-        for (uint32_t i = 0; i < gNPolicies; ++i) {
-            if (offset >= gPolicyFreqs[i].size()) continue;
-            auto begin = map[key.uid][i].begin() + offset;
-            auto end = nextOffset < gPolicyFreqs[i].size() ? begin + FREQS_PER_ENTRY :
-                map[key.uid][i].end();
-            for (const auto &cpu : gPolicyCpus[i]) {
-                std::transform(begin, end, std::begin(vals[gCpuIndexMap[cpu]].ar), begin,
-                               std::plus<uint64_t>());
-            }
-        }
+        accumulateTisEntry(key, vals, &map[key.uid]);
         prevKey = key;
     } while (prevKey = key, !getNextMapKey(gTisMapFd, &prevKey, &key));
     if (errno != ENOENT) return {};
@@ -406,6 +479,34 @@ getUidsUpdatedCpuFreqTimes(uint64_t *lastUpdate) {
     return map;
 }
 
+// Adds one (uid, bucket) map entry's per-cpu values into the active/policy totals.
+static void accumulateConcurrentEntry(const time_key_t &key,
+                                      const std::vector<concurrent_val_t> &vals,
+                                      concurrent_time_t *out) {
+    auto offset = key.bucket * CPUS_PER_ENTRY;
+    auto nextOffset = (key.bucket + 1) * CPUS_PER_ENTRY;
+
+    auto activeBegin = out->active.begin() + offset;
+    auto activeEnd = nextOffset < gNCpus ? activeBegin + CPUS_PER_ENTRY : out->active.end();
+
+    for (uint32_t cpu = 0; cpu < gNCpus; ++cpu) {
+        std::transform(activeBegin, activeEnd, std::begin(vals[cpu].active), activeBegin,
+                       std::plus<uint64_t>());
+    }
+
+    for (uint32_t policy = 0; policy < gNPolicies; ++policy) {
+        if (offset >= gPolicyCpus[policy].size()) continue;
+        auto policyBegin = out->policy[policy].begin() + offset;
+        auto policyEnd = nextOffset < gPolicyCpus[policy].size() ? policyBegin + CPUS_PER_ENTRY
+                                                                 : out->policy[policy].end();
+
+        for (const auto &cpu : gPolicyCpus[policy]) {
+            std::transform(policyBegin, policyEnd, std::begin(vals[gCpuIndexMap[cpu]].policy),
+                           policyBegin, std::plus<uint64_t>());
+        }
+    }
+}
+
 static bool verifyConcurrentTimes(const concurrent_time_t &ct) {
     uint64_t activeSum = std::accumulate(ct.active.begin(), ct.active.end(), (uint64_t)0);
     uint64_t policySum = 0;
@@ -478,20 +579,46 @@ std::optional<std::unordered_map<uint32_t, concurrent_time_t>> getUidsConcurrent
 std::optional<std::unordered_map<uint32_t, concurrent_time_t>> getUidsUpdatedConcurrentTimes(
         uint64_t *lastUpdate) {
     if (!gInitialized && !initGlobals()) return {};
-    time_key_t key, prevKey;
     std::unordered_map<uint32_t, concurrent_time_t> ret;
+
+    concurrent_time_t retFormat = {.active = std::vector<uint64_t>(gNCpus, 0)};
+    for (const auto &cpuList : gPolicyCpus) retFormat.policy.emplace_back(cpuList.size(), 0);
+
+    uint64_t newLastUpdate = lastUpdate ? *lastUpdate : 0;
+
+    if (auto entries = readMapBatched<time_key_t, concurrent_val_t>(gConcurrentMapFd)) {
+        std::unordered_map<uint32_t, bool> uidUpdatedCache;
+        for (const auto &[key, vals] : *entries) {
+            if (key.bucket > (gNCpus - 1) / CPUS_PER_ENTRY) return {};
+            if (lastUpdate) {
+                auto [it, inserted] = uidUpdatedCache.emplace(key.uid, false);
+                if (inserted) {
+                    auto uidUpdated = uidUpdatedSince(key.uid, *lastUpdate, &newLastUpdate);
+                    if (!uidUpdated.has_value()) return {};
+                    it->second = *uidUpdated;
+                }
+                if (!it->second) continue;
+            }
+            if (ret.find(key.uid) == ret.end()) ret.emplace(key.uid, retFormat);
+            accumulateConcurrentEntry(key, vals, &ret[key.uid]);
+        }
+        for (const auto &[key, value] : ret) {
+            if (!verifyConcurrentTimes(value)) {
+                auto val = getUidConcurrentTimes(key, false);
+                if (val.has_value()) ret[key] = val.value();
+            }
+        }
+        if (lastUpdate && newLastUpdate > *lastUpdate) *lastUpdate = newLastUpdate;
+        return ret;
+    }
+
+    time_key_t key, prevKey;
     if (getFirstMapKey(gConcurrentMapFd, &key)) {
         if (errno == ENOENT) return ret;
         return {};
     }
 
-    concurrent_time_t retFormat = {.active = std::vector<uint64_t>(gNCpus, 0)};
-    for (const auto &cpuList : gPolicyCpus) retFormat.policy.emplace_back(cpuList.size(), 0);
-
     std::vector<concurrent_val_t> vals(gNCpus);
-    std::vector<uint64_t>::iterator activeBegin, activeEnd, policyBegin, policyEnd;
-
-    uint64_t newLastUpdate = lastUpdate ? *lastUpdate : 0;
     do {
         if (key.bucket > (gNCpus - 1) / CPUS_PER_ENTRY) return {};
         if (lastUpdate) {
@@ -501,29 +628,7 @@ std::optional<std::unordered_map<uint32_t, concurrent_time_t>> getUidsUpdatedCon
         }
         if (findMapEntry(gConcurrentMapFd, &key, vals.data())) return {};
         if (ret.find(key.uid) == ret.end()) ret.emplace(key.uid, retFormat);
-
-        auto offset = key.bucket * CPUS_PER_ENTRY;
-        auto nextOffset = (key.bucket + 1) * CPUS_PER_ENTRY;
-
-        activeBegin = ret[key.uid].active.begin();
-        activeEnd = nextOffset < gNCpus ? activeBegin + CPUS_PER_ENTRY : ret[key.uid].active.end();
-
-        for (uint32_t cpu = 0; cpu < gNCpus; ++cpu) {
-            std::transform(activeBegin, activeEnd, std::begin(vals[cpu].active), activeBegin,
-                           std::plus<uint64_t>());
-        }
-
-        for (uint32_t policy = 0; policy < gNPolicies; ++policy) {
-            if (offset >= gPolicyCpus[policy].size()) continue;
-            policyBegin = ret[key.uid].policy[policy].begin() + offset;
-            policyEnd = nextOffset < gPolicyCpus[policy].size() ? policyBegin + CPUS_PER_ENTRY
-                                                                : ret[key.uid].policy[policy].end();
-
-            for (const auto &cpu : gPolicyCpus[policy]) {
-                std::transform(policyBegin, policyEnd, std::begin(vals[gCpuIndexMap[cpu]].policy),
-                               policyBegin, std::plus<uint64_t>());
-            }
-        }
+        accumulateConcurrentEntry(key, vals, &ret[key.uid]);
     } while (prevKey = key, !getNextMapKey(gConcurrentMapFd, &prevKey, &key));
     if (errno != ENOENT) return {};
     for (const auto &[key, value] : ret) {
@@ -17,6 +17,7 @@
 #include <ftl/flags.h>
 #include <gtest/gtest.h>
 
+#include <string_view>
 #include <type_traits>
 
 namespace android::test {
@@ -173,6 +174,21 @@ TEST(Flags, String_UnknownValues) {
     ASSERT_EQ(flags.string(), "ONE | TWO | 0b1000");
 }
 
+TEST(Flags, Stringify_NoFlags) {
+    Flags<TestFlags> flags;
+    ASSERT_EQ(flags.stringify().str(), "0x0");
+}
+
+TEST(Flags, Stringify_KnownAndUnknownValues) {
+    auto flags = Flags<TestFlags>(0b1011);
+    const auto string = flags.stringify();
+    ASSERT_EQ(string.str(), "ONE | TWO | 0b1000");
+    ASSERT_EQ(string.c_str()[string.size()], '\0');
+
+    // The buffer is sized at compile time for the worst case of the enum.
+    static_assert(decltype(string)::max_size() >= std::string_view("ONE | TWO | 0b1000").size());
+}
+
 TEST(FlagsIterator, IteratesOverAllFlags) {
     Flags<TestFlags> flags1 = TestFlags::ONE | TestFlags::TWO;
     Flags<TestFlags> flags2;
@@ -102,6 +102,42 @@ TEST(Future, Chain) {
   decrement_thread.join();
 }
 
+// Keep in sync with example usage in header file.
+TEST(Future, WhenAll) {
+  {
+    auto future = ftl::when_all(ftl::yield(42), ftl::yield('!'));
+    const auto [n, c] = future.get();
+    EXPECT_EQ(n, 42);
+    EXPECT_EQ(c, '!');
+  }
+  {
+    std::packaged_task<int()> fetch_int([] { return 123; });
+    std::packaged_task<std::string()> fetch_string([] { return std::string("abc"); });
+
+    auto future = ftl::when_all(ftl::Future(fetch_int.get_future()),
+                                ftl::Future(fetch_string.get_future()));
+
+    std::thread int_thread(std::move(fetch_int));
+    std::thread string_thread(std::move(fetch_string));
+
+    const auto [n, str] = future.get();
+    EXPECT_EQ(n, 123);
+    EXPECT_EQ(str, "abc");
+
+    int_thread.join();
+    string_thread.join();
+  }
+  {
+    std::vector<ftl::Future<int>> futures;
+    for (int i = 0; i < 5; i++) {
+      futures.push_back(ftl::yield(i * i));
+    }
+
+    auto future = ftl::when_all(std::move(futures));
+    EXPECT_EQ(future.get(), (std::vector<int>{0, 1, 4, 9, 16}));
+  }
+}
+
 TEST(Future, WaitFor) {
   using namespace std::chrono_literals;
   {
@@ -442,4 +442,37 @@ TEST(SmallMap, KeyEqual) {
   EXPECT_EQ(map, SmallMap(ftl::init::map<int, char, KeyEqual>(1, '1')(2, '2')));
 }
 
+TEST(SmallMap, TransparentKeyEqual) {
+  SmallMap<std::string, int, 3, std::equal_to<>> map;
+
+  EXPECT_TRUE(map.try_emplace("abc", 1).second);
+  EXPECT_TRUE(map.try_emplace("def", 2).second);
+
+  // Lookup by std::string_view, without constructing a temporary std::string key.
+  EXPECT_TRUE(map.contains("abc"sv));
+  EXPECT_FALSE(map.contains("ghi"sv));
+
+  EXPECT_EQ(map.get("def"sv), 2);
+  EXPECT_FALSE(map.get("ghi"sv));
+
+  {
+    // Mutable reference.
+    const auto opt = map.get("abc"sv);
+    ASSERT_TRUE(opt);
+    opt->get() = 3;
+  }
+
+  EXPECT_NE(map.find("abc"sv), map.end());
+  EXPECT_EQ(map.find("abc"sv)->second, 3);
+  EXPECT_EQ(map.find("ghi"sv), map.end());
+
+  const auto& const_map = map;
+  EXPECT_EQ(const_map.get("abc"sv), 3);
+  EXPECT_EQ(const_map.find("ghi"sv), const_map.end());
+
+  // Lookup by key_type still works.
+  EXPECT_TRUE(map.contains("def"s));
+  EXPECT_EQ(map.get("def"s), 2);
+}
+
 }  // namespace android::test
@@ -697,6 +697,15 @@ void GraphicsEnv::nativeToggleAngleAsSystemDriver(bool enabled) {
     gpuService->toggleAngleAsSystemDriver(enabled);
 }
 
+void GraphicsEnv::prewarmGpuDriver() {
+    const sp<IGpuService> gpuService = getGpuService();
+    if (!gpuService) {
+        ALOGE("No GPU service");
+        return;
+    }
+    gpuService->prewarmGpuDriver();
+}
+
 bool GraphicsEnv::shouldUseSystemAngle() {
     return mShouldUseSystemAngle;
 }
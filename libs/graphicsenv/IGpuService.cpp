@@ -108,6 +108,35 @@ public:
                            IBinder::FLAG_ONEWAY);
     }
 
+    void prewarmGpuDriver() override {
+        Parcel data, reply;
+        data.writeInterfaceToken(IGpuService::getInterfaceDescriptor());
+
+        remote()->transact(BnGpuService::PREWARM_GPU_DRIVER, data, &reply, IBinder::FLAG_ONEWAY);
+    }
+
+    std::vector<GpuMemTotal> getGpuMemTotals() override {
+        Parcel data, reply;
+        data.writeInterfaceToken(IGpuService::getInterfaceDescriptor());
+
+        std::vector<GpuMemTotal> totals;
+        status_t error = remote()->transact(BnGpuService::GET_GPU_MEM_TOTALS, data, &reply);
+        if (error != OK) return totals;
+
+        uint32_t count;
+        if (reply.readUint32(&count) != OK) return totals;
+
+        totals.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            GpuMemTotal total;
+            if (reply.readUint32(&total.gpuId) != OK) break;
+            if (reply.readUint32(&total.pid) != OK) break;
+            if (reply.readUint64(&total.size) != OK) break;
+            totals.push_back(total);
+        }
+        return totals;
+    }
+
     std::string getUpdatableDriverPath() override {
         Parcel data, reply;
         data.writeInterfaceToken(IGpuService::getInterfaceDescriptor());
@@ -240,6 +269,25 @@ status_t BnGpuService::onTransact(uint32_t code, const Parcel& data, Parcel* rep
             std::string driverPath = getUpdatableDriverPath();
             return reply->writeUtf8AsUtf16(driverPath);
         }
+        case GET_GPU_MEM_TOTALS: {
+            CHECK_INTERFACE(IGpuService, data, reply);
+
+            const std::vector<GpuMemTotal> totals = getGpuMemTotals();
+            if ((status = reply->writeUint32(static_cast<uint32_t>(totals.size()))) != OK)
+                return status;
+            for (const GpuMemTotal& total : totals) {
+                if ((status = reply->writeUint32(total.gpuId)) != OK) return status;
+                if ((status = reply->writeUint32(total.pid)) != OK) return status;
+                if ((status = reply->writeUint64(total.size)) != OK) return status;
+            }
+            return OK;
+        }
+        case PREWARM_GPU_DRIVER: {
+            CHECK_INTERFACE(IGpuService, data, reply);
+
+            prewarmGpuDriver();
+            return OK;
+        }
         case SHELL_COMMAND_TRANSACTION: {
             int in = dup(data.readFileDescriptor());
             int out = dup(data.readFileDescriptor());
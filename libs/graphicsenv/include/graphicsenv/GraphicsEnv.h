@@ -122,6 +122,9 @@ public:
     const std::vector<std::string>& getAngleEglFeatures();
     // Set the persist.graphics.egl system property value.
     void nativeToggleAngleAsSystemDriver(bool enabled);
+    // Ask GpuService to read the vendor driver libraries into the page cache ahead of an app
+    // launch, so the first driver load in the app does not pay for the disk I/O.
+    void prewarmGpuDriver();
     bool shouldUseSystemAngle();
     bool shouldUseNativeDriver();
 
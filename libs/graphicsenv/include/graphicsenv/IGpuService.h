@@ -24,6 +24,16 @@
 
 namespace android {
 
+/*
+ * A snapshot of the GPU memory total for one process (or the global total when
+ * pid is 0) on one GPU, as accounted by the gpu_mem_total tracepoint.
+ */
+struct GpuMemTotal {
+    uint32_t gpuId = 0;
+    uint32_t pid = 0;
+    uint64_t size = 0;
+};
+
 /*
  * This class defines the Binder IPC interface for GPU-related queries and
  * control.
@@ -55,6 +65,17 @@ public:
 
     // sets ANGLE as system GLES driver if enabled==true by setting persist.graphics.egl to true.
     virtual void toggleAngleAsSystemDriver(bool enabled) = 0;
+
+    // returns the GPU memory totals for all processes on all GPUs in a single call, so that
+    // continuous memory monitors do not need one dumpsys round trip per poll. Restricted to
+    // system callers and holders of ACCESS_GPU_SERVICE.
+    virtual std::vector<GpuMemTotal> getGpuMemTotals() = 0;
+
+    // reads the vendor GLES/Vulkan driver libraries (and the updatable driver, if one is set)
+    // into the page cache, so that the first process to load the driver afterwards does not pay
+    // for the disk I/O. Called by system_server on an app-launch signal. Restricted to system
+    // callers and holders of ACCESS_GPU_SERVICE.
+    virtual void prewarmGpuDriver() = 0;
 };
 
 class BnGpuService : public BnInterface<IGpuService> {
@@ -67,6 +88,8 @@ public:
         TOGGLE_ANGLE_AS_SYSTEM_DRIVER,
         SET_TARGET_STATS_ARRAY,
         ADD_VULKAN_ENGINE_NAME,
+        GET_GPU_MEM_TOTALS,
+        PREWARM_GPU_DRIVER,
         // Always append new enum to the end.
     };
 
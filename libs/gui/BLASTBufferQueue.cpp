@@ -436,11 +436,7 @@ void BLASTBufferQueue::transactionCallback(nsecs_t /*latchTime*/, const sp<Fence
 
 void BLASTBufferQueue::flushShadowQueue() {
     BQA_LOGV("flushShadowQueue");
-    int numFramesToFlush = mNumFrameAvailable;
-    while (numFramesToFlush > 0) {
-        acquireNextBufferLocked(std::nullopt);
-        numFramesToFlush--;
-    }
+    acquireAndApplyAvailableBuffersLocked();
 }
 
 // Unlike transactionCallbackThunk the release buffer callback does not extend the life of the
@@ -500,17 +496,20 @@ void BLASTBufferQueue::releaseBufferCallbackLocked(
     }
 
     // Release all buffers that are beyond the ones that we need to hold
+    bool releasedBuffers = false;
     while (mPendingRelease.size() > numPendingBuffersToHold) {
         const auto releasedBuffer = mPendingRelease.front();
         mPendingRelease.pop_front();
         releaseBuffer(releasedBuffer.callbackId, releasedBuffer.releaseFence);
-        // Don't process the transactions here if mSyncedFrameNumbers is not empty. That means
-        // are still transactions that have sync buffers in them that have not been applied or
-        // dropped. Instead, let onFrameAvailable handle processing them since it will merge with
-        // the syncTransaction.
-        if (mSyncedFrameNumbers.empty()) {
-            acquireNextBufferLocked(std::nullopt);
-        }
+        releasedBuffers = true;
+    }
+    // Don't process the transactions here if mSyncedFrameNumbers is not empty. That means
+    // are still transactions that have sync buffers in them that have not been applied or
+    // dropped. Instead, let onFrameAvailable handle processing them since it will merge with
+    // the syncTransaction. Acquiring after all the releases lets a backlog of queued buffers
+    // drain into a single merged transaction.
+    if (releasedBuffers && mSyncedFrameNumbers.empty()) {
+        acquireAndApplyAvailableBuffersLocked();
     }
 
     ATRACE_INT("PendingRelease", mPendingRelease.size());
@@ -549,7 +548,7 @@ static ui::Size getBufferSize(const BufferItem& item) {
 }
 
 status_t BLASTBufferQueue::acquireNextBufferLocked(
-        const std::optional<SurfaceComposerClient::Transaction*> transaction) {
+        const std::optional<SurfaceComposerClient::Transaction*> transaction, bool setBarrier) {
     // Check if we have frames available and we have not acquired the maximum number of buffers.
     // Even with this check, the consumer can fail to acquire an additional buffer if the consumer
     // has already acquired (mMaxAcquiredBuffers + 1) and the new buffer is not droppable. In this
@@ -606,7 +605,7 @@ status_t BLASTBufferQueue::acquireNextBufferLocked(
                  mSize.width, mSize.height, mRequestedSize.width, mRequestedSize.height,
                  buffer->getWidth(), buffer->getHeight(), bufferItem.mTransform);
         mBufferItemConsumer->releaseBuffer(bufferItem, Fence::NO_FENCE);
-        return acquireNextBufferLocked(transaction);
+        return acquireNextBufferLocked(transaction, setBarrier);
     }
 
     mNumAcquired++;
@@ -703,7 +702,7 @@ status_t BLASTBufferQueue::acquireNextBufferLocked(
         t->setApplyToken(mApplyToken).apply(false, true);
         mAppliedLastTransaction = true;
         mLastAppliedFrameNumber = bufferItem.mFrameNumber;
-    } else {
+    } else if (setBarrier) {
         t->setBufferHasBarrier(mSurfaceControl, mLastAppliedFrameNumber);
         mAppliedLastTransaction = false;
     }
@@ -725,6 +724,24 @@ Rect BLASTBufferQueue::computeCrop(const BufferItem& item) {
     return item.mCrop;
 }
 
+void BLASTBufferQueue::acquireAndApplyAvailableBuffersLocked() {
+    SurfaceComposerClient::Transaction t;
+    size_t numAcquired = 0;
+    while (mNumFrameAvailable > 0 && acquireNextBufferLocked(&t, false /* setBarrier */) == OK) {
+        numAcquired++;
+    }
+    if (numAcquired == 0) {
+        return;
+    }
+    if (numAcquired > 1) {
+        BBQ_TRACE("coalesced %zu buffers", numAcquired);
+    }
+    // All transactions on our apply token are one-way. See comment on mAppliedLastTransaction
+    t.setApplyToken(mApplyToken).apply(false, true);
+    mAppliedLastTransaction = true;
+    mLastAppliedFrameNumber = mLastAcquiredFrameNumber;
+}
+
 void BLASTBufferQueue::acquireAndReleaseBuffer() {
     BBQ_TRACE();
     BufferItem bufferItem;
@@ -824,7 +841,7 @@ void BLASTBufferQueue::onFrameAvailable(const BufferItem& item) {
                 mSyncTransaction = nullptr;
             }
         } else if (!waitForTransactionCallback) {
-            acquireNextBufferLocked(std::nullopt);
+            acquireAndApplyAvailableBuffersLocked();
         }
     }
     if (prevCallback) {
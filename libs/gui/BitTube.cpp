@@ -17,12 +17,18 @@
 #include <private/gui/BitTube.h>
 
 #include <stdint.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
 #include <utils/Errors.h>
 
 #include <binder/Parcel.h>
@@ -34,12 +40,89 @@ namespace gui {
 // need. So we make it smaller.
 static const size_t DEFAULT_SOCKET_BUFFER_SIZE = 4 * 1024;
 
+// A single-producer single-consumer byte ring carrying length-prefixed messages, shared between
+// the send and receive ends of an in-process BitTube. An eventfd mirrors data availability so the
+// receive end stays pollable like its socket-backed counterpart.
+class BitTube::InProcessRing {
+public:
+    explicit InProcessRing(size_t capacity) : mCapacity(capacity), mBuffer(capacity) {}
+
+    // Writes one message, or fails without writing anything if the ring is full, matching the
+    // all-or-nothing semantics of a SOCK_SEQPACKET send.
+    bool push(void const* data, size_t size) {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+        const size_t head = mHead.load(std::memory_order_acquire);
+        if (sizeof(Header) + size > mCapacity - (tail - head)) {
+            return false;
+        }
+        const Header header{size};
+        copyIn(tail, &header, sizeof(header));
+        copyIn(tail + sizeof(header), data, size);
+        mTail.store(tail + sizeof(header) + size, std::memory_order_release);
+        return true;
+    }
+
+    // Reads one message into data, or returns 0 if the ring is empty. Excess bytes beyond size
+    // are silently discarded, like a recv with a too-small buffer.
+    ssize_t pop(void* data, size_t size) {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        const size_t tail = mTail.load(std::memory_order_acquire);
+        if (head == tail) {
+            return 0;
+        }
+        Header header;
+        copyOut(head, &header, sizeof(header));
+        const size_t len = std::min(header.size, size);
+        copyOut(head + sizeof(header), data, len);
+        mHead.store(head + sizeof(header) + header.size, std::memory_order_release);
+        return static_cast<ssize_t>(len);
+    }
+
+private:
+    struct Header {
+        size_t size;
+    };
+
+    void copyIn(size_t pos, void const* data, size_t size) {
+        const size_t offset = pos % mCapacity;
+        const size_t contiguous = std::min(size, mCapacity - offset);
+        memcpy(mBuffer.data() + offset, data, contiguous);
+        memcpy(mBuffer.data(), static_cast<uint8_t const*>(data) + contiguous, size - contiguous);
+    }
+
+    void copyOut(size_t pos, void* data, size_t size) const {
+        const size_t offset = pos % mCapacity;
+        const size_t contiguous = std::min(size, mCapacity - offset);
+        memcpy(data, mBuffer.data() + offset, contiguous);
+        memcpy(static_cast<uint8_t*>(data) + contiguous, mBuffer.data(), size - contiguous);
+    }
+
+    const size_t mCapacity;
+    std::vector<uint8_t> mBuffer;
+
+    // free-running positions, reduced modulo mCapacity on access
+    std::atomic<size_t> mHead{0};
+    std::atomic<size_t> mTail{0};
+};
+
 BitTube::BitTube(size_t bufsize) {
     init(bufsize, bufsize);
 }
 
 BitTube::BitTube(DefaultSizeType) : BitTube(DEFAULT_SOCKET_BUFFER_SIZE) {}
 
+BitTube::BitTube(InProcessSizeType)
+      : mRing(std::make_shared<InProcessRing>(DEFAULT_SOCKET_BUFFER_SIZE)) {
+    const int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fd < 0) {
+        ALOGE("BitTube: eventfd creation failed (%s)", strerror(errno));
+        mRing.reset();
+        return;
+    }
+    mReceiveFd.reset(fd);
+    mSendFd.reset(dup(fd));
+}
+
 BitTube::BitTube(const Parcel& data) {
     readFromParcel(&data);
 }
@@ -90,7 +173,22 @@ void BitTube::setSendFd(base::unique_fd&& sendFd) {
     mSendFd = std::move(sendFd);
 }
 
+void BitTube::moveReceiveEndTo(BitTube* outTube) {
+    outTube->setReceiveFd(std::move(mReceiveFd));
+    outTube->setSendFd(base::unique_fd(dup(mSendFd)));
+    outTube->mRing = mRing;
+}
+
 ssize_t BitTube::write(void const* vaddr, size_t size) {
+    if (mRing) {
+        if (!mRing->push(vaddr, size)) {
+            return -EAGAIN;
+        }
+        // wake up a poller on the receive end
+        const uint64_t kick = 1;
+        TEMP_FAILURE_RETRY(::write(mSendFd, &kick, sizeof(kick)));
+        return static_cast<ssize_t>(size);
+    }
     ssize_t err, len;
     do {
         len = ::send(mSendFd, vaddr, size, MSG_DONTWAIT | MSG_NOSIGNAL);
@@ -101,6 +199,17 @@ ssize_t BitTube::write(void const* vaddr, size_t size) {
 }
 
 ssize_t BitTube::read(void* vaddr, size_t size) {
+    if (mRing) {
+        ssize_t len = mRing->pop(vaddr, size);
+        if (len <= 0) {
+            // Clear the eventfd, then recheck the ring so a message pushed between the pop and
+            // the clear is not stranded until the next signal.
+            uint64_t count;
+            TEMP_FAILURE_RETRY(::read(mReceiveFd, &count, sizeof(count)));
+            len = mRing->pop(vaddr, size);
+        }
+        return len;
+    }
     ssize_t err, len;
     do {
         len = ::recv(mReceiveFd, vaddr, size, MSG_DONTWAIT);
@@ -115,6 +224,11 @@ ssize_t BitTube::read(void* vaddr, size_t size) {
 }
 
 status_t BitTube::writeToParcel(Parcel* reply) const {
+    if (mRing) {
+        // The ring is process-local; an in-process BitTube cannot cross processes.
+        ALOGE("BitTube: cannot parcel an in-process tube");
+        return INVALID_OPERATION;
+    }
     if (mReceiveFd < 0) return -EINVAL;
 
     status_t result = reply->writeDupFileDescriptor(mReceiveFd);
@@ -128,6 +242,7 @@ status_t BitTube::writeToParcel(Parcel* reply) const {
 }
 
 status_t BitTube::readFromParcel(const Parcel* parcel) {
+    mRing.reset();
     mReceiveFd.reset(dup(parcel->readFileDescriptor()));
     if (mReceiveFd < 0) {
         mReceiveFd.reset();
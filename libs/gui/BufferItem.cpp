@@ -21,6 +21,9 @@
 
 #include <system/window.h>
 
+#include <cstddef>
+#include <cstring>
+
 namespace android {
 
 template<typename T>
@@ -61,32 +64,54 @@ BufferItem::BufferItem() :
 
 BufferItem::~BufferItem() {}
 
-template <typename T>
-static void addAligned(size_t& size, T /* value */) {
-    size = FlattenableUtils::align<sizeof(T)>(size);
-    size += sizeof(T);
-}
+// The POD tail of the flattened representation. The wire format was originally defined by a
+// sequence of per-field aligned writes; this struct reproduces that layout with natural member
+// alignment so the whole tail can be moved with a single bounds check and memcpy. The 64-bit
+// fields stay split into lo/hi words because the old format aligned them to 4, not 8.
+struct FlattenedPod {
+    Rect crop;
+    uint32_t transform;
+    uint32_t scalingMode;
+    uint32_t timestampLo;
+    uint32_t timestampHi;
+    bool isAutoTimestamp;
+    android_dataspace dataSpace;
+    uint32_t frameNumberLo;
+    uint32_t frameNumberHi;
+    int slot;
+    bool isDroppable;
+    bool acquireCalled;
+    bool transformToDisplayInverse;
+    bool autoRefresh;
+    bool queuedBuffer;
+    bool isStale;
+    int api;
+};
+
+// Pin the layout to the offsets the per-field aligned writes produced, so that any change to
+// the struct that would alter the wire format fails to compile.
+static_assert(offsetof(FlattenedPod, crop) == 0);
+static_assert(offsetof(FlattenedPod, transform) == 16);
+static_assert(offsetof(FlattenedPod, scalingMode) == 20);
+static_assert(offsetof(FlattenedPod, timestampLo) == 24);
+static_assert(offsetof(FlattenedPod, timestampHi) == 28);
+static_assert(offsetof(FlattenedPod, isAutoTimestamp) == 32);
+static_assert(offsetof(FlattenedPod, dataSpace) == 36);
+static_assert(offsetof(FlattenedPod, frameNumberLo) == 40);
+static_assert(offsetof(FlattenedPod, frameNumberHi) == 44);
+static_assert(offsetof(FlattenedPod, slot) == 48);
+static_assert(offsetof(FlattenedPod, isDroppable) == 52);
+static_assert(offsetof(FlattenedPod, acquireCalled) == 53);
+static_assert(offsetof(FlattenedPod, transformToDisplayInverse) == 54);
+static_assert(offsetof(FlattenedPod, autoRefresh) == 55);
+static_assert(offsetof(FlattenedPod, queuedBuffer) == 56);
+static_assert(offsetof(FlattenedPod, isStale) == 57);
+static_assert(offsetof(FlattenedPod, api) == 60);
+static_assert(sizeof(FlattenedPod) == 64);
+static_assert(alignof(FlattenedPod) == 4);
 
 size_t BufferItem::getPodSize() const {
-    size_t size = 0;
-    addAligned(size, mCrop);
-    addAligned(size, mTransform);
-    addAligned(size, mScalingMode);
-    addAligned(size, low32(mTimestamp));
-    addAligned(size, high32(mTimestamp));
-    addAligned(size, mIsAutoTimestamp);
-    addAligned(size, mDataSpace);
-    addAligned(size, low32(mFrameNumber));
-    addAligned(size, high32(mFrameNumber));
-    addAligned(size, mSlot);
-    addAligned(size, mIsDroppable);
-    addAligned(size, mAcquireCalled);
-    addAligned(size, mTransformToDisplayInverse);
-    addAligned(size, mAutoRefresh);
-    addAligned(size, mQueuedBuffer);
-    addAligned(size, mIsStale);
-    addAligned(size, mApi);
-    return size;
+    return sizeof(FlattenedPod);
 }
 
 size_t BufferItem::getFlattenedSize() const {
@@ -116,12 +141,6 @@ size_t BufferItem::getFdCount() const {
     return count;
 }
 
-template <typename T>
-static void writeAligned(void*& buffer, size_t& size, T value) {
-    size -= FlattenableUtils::align<alignof(T)>(buffer);
-    FlattenableUtils::write(buffer, size, value);
-}
-
 status_t BufferItem::flatten(
         void*& buffer, size_t& size, int*& fds, size_t& count) const {
 
@@ -158,38 +177,37 @@ status_t BufferItem::flatten(
     if (err) return err;
     FlattenableUtils::advance(buffer, size, mHdrMetadata.getFlattenedSize());
 
-    // Check we still have enough space
-    if (size < getPodSize()) {
+    // Write the POD fields with a single bounds check and copy.
+    size -= FlattenableUtils::align<alignof(FlattenedPod)>(buffer);
+    if (size < sizeof(FlattenedPod)) {
         return NO_MEMORY;
     }
 
-    writeAligned(buffer, size, mCrop);
-    writeAligned(buffer, size, mTransform);
-    writeAligned(buffer, size, mScalingMode);
-    writeAligned(buffer, size, low32(mTimestamp));
-    writeAligned(buffer, size, high32(mTimestamp));
-    writeAligned(buffer, size, mIsAutoTimestamp);
-    writeAligned(buffer, size, mDataSpace);
-    writeAligned(buffer, size, low32(mFrameNumber));
-    writeAligned(buffer, size, high32(mFrameNumber));
-    writeAligned(buffer, size, mSlot);
-    writeAligned(buffer, size, mIsDroppable);
-    writeAligned(buffer, size, mAcquireCalled);
-    writeAligned(buffer, size, mTransformToDisplayInverse);
-    writeAligned(buffer, size, mAutoRefresh);
-    writeAligned(buffer, size, mQueuedBuffer);
-    writeAligned(buffer, size, mIsStale);
-    writeAligned(buffer, size, mApi);
+    FlattenedPod pod;
+    memset(&pod, 0, sizeof(pod)); // don't leak padding bytes into the parcel
+    pod.crop = mCrop;
+    pod.transform = mTransform;
+    pod.scalingMode = mScalingMode;
+    pod.timestampLo = low32(mTimestamp);
+    pod.timestampHi = high32(mTimestamp);
+    pod.isAutoTimestamp = mIsAutoTimestamp;
+    pod.dataSpace = mDataSpace;
+    pod.frameNumberLo = low32(mFrameNumber);
+    pod.frameNumberHi = high32(mFrameNumber);
+    pod.slot = mSlot;
+    pod.isDroppable = mIsDroppable;
+    pod.acquireCalled = mAcquireCalled;
+    pod.transformToDisplayInverse = mTransformToDisplayInverse;
+    pod.autoRefresh = mAutoRefresh;
+    pod.queuedBuffer = mQueuedBuffer;
+    pod.isStale = mIsStale;
+    pod.api = mApi;
+    memcpy(buffer, &pod, sizeof(pod));
+    FlattenableUtils::advance(buffer, size, sizeof(pod));
 
     return NO_ERROR;
 }
 
-template <typename T>
-static void readAligned(const void*& buffer, size_t& size, T& value) {
-    size -= FlattenableUtils::align<alignof(T)>(buffer);
-    FlattenableUtils::read(buffer, size, value);
-}
-
 status_t BufferItem::unflatten(
         void const*& buffer, size_t& size, int const*& fds, size_t& count) {
 
@@ -224,33 +242,31 @@ status_t BufferItem::unflatten(
     if (err) return err;
     FlattenableUtils::advance(buffer, size, mHdrMetadata.getFlattenedSize());
 
-    // Check we still have enough space
-    if (size < getPodSize()) {
+    // Read the POD fields with a single bounds check and copy.
+    size -= FlattenableUtils::align<alignof(FlattenedPod)>(buffer);
+    if (size < sizeof(FlattenedPod)) {
         return NO_MEMORY;
     }
 
-    uint32_t timestampLo = 0, timestampHi = 0;
-    uint32_t frameNumberLo = 0, frameNumberHi = 0;
-
-    readAligned(buffer, size, mCrop);
-    readAligned(buffer, size, mTransform);
-    readAligned(buffer, size, mScalingMode);
-    readAligned(buffer, size, timestampLo);
-    readAligned(buffer, size, timestampHi);
-    mTimestamp = to64<int64_t>(timestampLo, timestampHi);
-    readAligned(buffer, size, mIsAutoTimestamp);
-    readAligned(buffer, size, mDataSpace);
-    readAligned(buffer, size, frameNumberLo);
-    readAligned(buffer, size, frameNumberHi);
-    mFrameNumber = to64<uint64_t>(frameNumberLo, frameNumberHi);
-    readAligned(buffer, size, mSlot);
-    readAligned(buffer, size, mIsDroppable);
-    readAligned(buffer, size, mAcquireCalled);
-    readAligned(buffer, size, mTransformToDisplayInverse);
-    readAligned(buffer, size, mAutoRefresh);
-    readAligned(buffer, size, mQueuedBuffer);
-    readAligned(buffer, size, mIsStale);
-    readAligned(buffer, size, mApi);
+    FlattenedPod pod;
+    memcpy(&pod, buffer, sizeof(pod));
+    FlattenableUtils::advance(buffer, size, sizeof(pod));
+
+    mCrop = pod.crop;
+    mTransform = pod.transform;
+    mScalingMode = pod.scalingMode;
+    mTimestamp = to64<int64_t>(pod.timestampLo, pod.timestampHi);
+    mIsAutoTimestamp = pod.isAutoTimestamp;
+    mDataSpace = pod.dataSpace;
+    mFrameNumber = to64<uint64_t>(pod.frameNumberLo, pod.frameNumberHi);
+    mSlot = pod.slot;
+    mIsDroppable = pod.isDroppable;
+    mAcquireCalled = pod.acquireCalled;
+    mTransformToDisplayInverse = pod.transformToDisplayInverse;
+    mAutoRefresh = pod.autoRefresh;
+    mQueuedBuffer = pod.queuedBuffer;
+    mIsStale = pod.isStale;
+    mApi = pod.api;
 
     return NO_ERROR;
 }
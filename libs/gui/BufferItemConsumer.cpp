@@ -107,6 +107,43 @@ status_t BufferItemConsumer::acquireBuffer(BufferItem *item,
     return OK;
 }
 
+#if COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(WB_PLATFORM_API_IMPROVEMENTS)
+status_t BufferItemConsumer::acquireBuffers(std::vector<BufferItem>* outItems, nsecs_t presentWhen,
+                                            size_t maxBuffers, bool waitForFence) {
+    if (outItems == nullptr || maxBuffers == 0) return BAD_VALUE;
+
+    Mutex::Autolock _l(mMutex);
+
+    status_t err = NO_BUFFER_AVAILABLE;
+    size_t acquired = 0;
+    while (acquired < maxBuffers) {
+        BufferItem item;
+        err = acquireBufferLocked(&item, presentWhen);
+        if (err != OK) {
+            if (err != NO_BUFFER_AVAILABLE && err != INVALID_OPERATION) {
+                BI_LOGE("Error acquiring buffer: %s (%d)", strerror(err), err);
+            }
+            break;
+        }
+
+        item.mGraphicBuffer = mSlots[item.mSlot].mGraphicBuffer;
+        outItems->push_back(item);
+        acquired++;
+
+        if (waitForFence) {
+            status_t fenceErr = item.mFence->waitForever("BufferItemConsumer::acquireBuffers");
+            if (fenceErr != OK) {
+                BI_LOGE("Failed to wait for fence of acquired buffer: %s (%d)", strerror(-fenceErr),
+                        fenceErr);
+                return fenceErr;
+            }
+        }
+    }
+
+    return acquired > 0 ? OK : err;
+}
+#endif // COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(WB_PLATFORM_API_IMPROVEMENTS)
+
 status_t BufferItemConsumer::releaseBuffer(const BufferItem &item,
         const sp<Fence>& releaseFence) {
     Mutex::Autolock _l(mMutex);
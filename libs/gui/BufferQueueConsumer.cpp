@@ -81,6 +81,15 @@ status_t BufferQueueConsumer::acquireBuffer(BufferItem* outBuffer,
         nsecs_t expectedPresent, uint64_t maxFrameNumber) {
     ATRACE_CALL();
 
+    // Fast path: nothing to acquire. Checking the published queue depth here
+    // keeps empty-queue polls from contending on mMutex with a producer that
+    // is mid-queueBuffer. Shared buffer mode can satisfy an acquire with an
+    // empty queue, so it takes the slow path.
+    if (mCore->mQueueSize.load(std::memory_order_acquire) == 0 &&
+        !mCore->mSharedBufferModePublished.load(std::memory_order_acquire)) {
+        return NO_BUFFER_AVAILABLE;
+    }
+
     int numDroppedBuffers = 0;
     sp<IProducerListener> listener;
     {
@@ -202,6 +211,7 @@ status_t BufferQueueConsumer::acquireBuffer(BufferItem* outBuffer,
                 }
 
                 mCore->mQueue.erase(front);
+                mCore->mQueueSize.store(mCore->mQueue.size(), std::memory_order_release);
                 front = mCore->mQueue.begin();
             }
 
@@ -293,6 +303,7 @@ status_t BufferQueueConsumer::acquireBuffer(BufferItem* outBuffer,
         }
 
         mCore->mQueue.erase(front);
+        mCore->mQueueSize.store(mCore->mQueue.size(), std::memory_order_release);
 
         // We might have freed a slot while dropping old buffers, or the producer
         // may be blocked waiting for the number of buffers in the queue to
@@ -572,6 +583,7 @@ status_t BufferQueueConsumer::disconnect() {
     mCore->mIsAbandoned = true;
     mCore->mConsumerListener = nullptr;
     mCore->mQueue.clear();
+    mCore->mQueueSize.store(0, std::memory_order_release);
     mCore->freeAllBuffersLocked();
     mCore->mSharedBufferSlot = BufferQueueCore::INVALID_BUFFER_SLOT;
     mCore->mDequeueCondition.notify_all();
@@ -99,6 +99,7 @@ BufferQueueCore::BufferQueueCore()
         mBufferAttachedCbEnabled(false),
         mSlots(),
         mQueue(),
+        mQueueSize(0),
         mFreeSlots(),
         mFreeBuffers(),
         mUnusedSlots(),
@@ -124,6 +125,7 @@ BufferQueueCore::BufferQueueCore()
         mGenerationNumber(0),
         mAsyncMode(false),
         mSharedBufferMode(false),
+        mSharedBufferModePublished(false),
         mAutoRefresh(false),
         mSharedBufferSlot(INVALID_BUFFER_SLOT),
         mSharedBufferCache(Rect::INVALID_RECT, 0, NATIVE_WINDOW_SCALING_MODE_FREEZE,
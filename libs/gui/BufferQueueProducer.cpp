@@ -1038,6 +1038,7 @@ status_t BufferQueueProducer::queueBuffer(int slot,
             // When the queue is empty, we can ignore mDequeueBufferCannotBlock
             // and simply queue this buffer
             mCore->mQueue.push_back(item);
+            mCore->mQueueSize.store(mCore->mQueue.size(), std::memory_order_release);
             frameAvailableListener = mCore->mConsumerListener;
         } else {
             // When the queue is not empty, we need to look at the last buffer
@@ -1078,6 +1079,7 @@ status_t BufferQueueProducer::queueBuffer(int slot,
                 frameReplacedListener = mCore->mConsumerListener;
             } else {
                 mCore->mQueue.push_back(item);
+                mCore->mQueueSize.store(mCore->mQueue.size(), std::memory_order_release);
                 frameAvailableListener = mCore->mConsumerListener;
             }
         }
@@ -1695,6 +1697,7 @@ status_t BufferQueueProducer::setSharedBufferMode(bool sharedBufferMode) {
         mCore->mSharedBufferSlot = BufferQueueCore::INVALID_BUFFER_SLOT;
     }
     mCore->mSharedBufferMode = sharedBufferMode;
+    mCore->mSharedBufferModePublished.store(sharedBufferMode, std::memory_order_release);
     return NO_ERROR;
 }
 
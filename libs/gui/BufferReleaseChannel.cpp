@@ -20,6 +20,8 @@
 #include <sys/socket.h>
 #include <sys/uio.h>
 
+#include <algorithm>
+
 #include <android-base/result.h>
 #include <android/binder_status.h>
 #include <binder/Parcel.h>
@@ -136,9 +138,25 @@ status_t BufferReleaseChannel::Message::unflatten(void const*& buffer, size_t& s
 status_t BufferReleaseChannel::ConsumerEndpoint::readReleaseFence(
         ReleaseCallbackId& outReleaseCallbackId, sp<Fence>& outReleaseFence,
         uint32_t& outMaxAcquiredBufferCount) {
-    Message message;
-    mFlattenedBuffer.resize(message.getFlattenedSize());
-    std::array<uint8_t, CMSG_SPACE(sizeof(int))> controlMessageBuffer;
+    // Drain any messages left over from a previous batched datagram before hitting the socket.
+    if (mPendingMessages.empty()) {
+        if (status_t err = readNextDatagram(); err != OK) {
+            return err;
+        }
+    }
+
+    Message& message = mPendingMessages.front();
+    outReleaseCallbackId = message.releaseCallbackId;
+    outReleaseFence = std::move(message.releaseFence);
+    outMaxAcquiredBufferCount = message.maxAcquiredBufferCount;
+    mPendingMessages.pop_front();
+
+    return OK;
+}
+
+status_t BufferReleaseChannel::ConsumerEndpoint::readNextDatagram() {
+    mFlattenedBuffer.resize(Message().getFlattenedSize() * MAX_MESSAGES_PER_DATAGRAM);
+    std::array<uint8_t, CMSG_SPACE(MAX_MESSAGES_PER_DATAGRAM * sizeof(int))> controlMessageBuffer;
 
     iovec iov{
             .iov_base = mFlattenedBuffer.data(),
@@ -174,7 +192,7 @@ status_t BufferReleaseChannel::ConsumerEndpoint::readReleaseFence(
         return UNKNOWN_ERROR;
     }
 
-    size_t dataLen = msg.msg_iov->iov_len;
+    size_t dataLen = static_cast<size_t>(result);
     const void* data = static_cast<const void*>(msg.msg_iov->iov_base);
     if (!data) {
         ALOGE("Error reading release fence from socket: no buffer data");
@@ -188,13 +206,25 @@ status_t BufferReleaseChannel::ConsumerEndpoint::readReleaseFence(
         fdCount = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
     }
 
-    if (status_t err = message.unflatten(data, dataLen, fdData, fdCount); err != OK) {
-        return err;
+    // The producer may have packed multiple messages into this datagram. Unflatten all of
+    // them so later reads can be satisfied without another syscall.
+    while (dataLen > 0) {
+        Message message;
+        const size_t remaining = dataLen;
+        if (status_t err = message.unflatten(data, dataLen, fdData, fdCount); err != OK) {
+            return err;
+        }
+        if (dataLen == remaining) {
+            ALOGE("Error reading release fence from socket: bad data length");
+            return UNKNOWN_ERROR;
+        }
+        mPendingMessages.emplace_back(std::move(message));
     }
 
-    outReleaseCallbackId = message.releaseCallbackId;
-    outReleaseFence = std::move(message.releaseFence);
-    outMaxAcquiredBufferCount = message.maxAcquiredBufferCount;
+    if (mPendingMessages.empty()) {
+        ALOGE("Error reading release fence from socket: empty message");
+        return UNKNOWN_ERROR;
+    }
 
     return OK;
 }
@@ -203,21 +233,45 @@ int BufferReleaseChannel::ProducerEndpoint::writeReleaseFence(const ReleaseCallb
                                                               const sp<Fence>& fence,
                                                               uint32_t maxAcquiredBufferCount) {
     Message message{callbackId, fence ? fence : Fence::NO_FENCE, maxAcquiredBufferCount};
-    mFlattenedBuffer.resize(message.getFlattenedSize());
-    int flattenedFd;
+    return writeBatch(&message, 1);
+}
+
+status_t BufferReleaseChannel::ProducerEndpoint::writeReleaseFences(
+        const std::vector<Message>& messages) {
+    for (size_t begin = 0; begin < messages.size(); begin += MAX_MESSAGES_PER_DATAGRAM) {
+        const size_t count = std::min(MAX_MESSAGES_PER_DATAGRAM, messages.size() - begin);
+        if (status_t err = writeBatch(messages.data() + begin, count); err != OK) {
+            return err;
+        }
+    }
+    return OK;
+}
+
+status_t BufferReleaseChannel::ProducerEndpoint::writeBatch(const Message* messages, size_t count) {
+    size_t flattenedSize = 0;
+    for (size_t i = 0; i < count; i++) {
+        flattenedSize += messages[i].getFlattenedSize();
+    }
+    mFlattenedBuffer.resize(flattenedSize);
+
+    std::array<int, MAX_MESSAGES_PER_DATAGRAM> flattenedFds;
+    size_t flattenedFdCount = 0;
     {
         // Make copies of needed items since flatten modifies them, and we don't
         // want to send anything if there's an error during flatten.
         void* flattenedBufferPtr = mFlattenedBuffer.data();
         size_t flattenedBufferSize = mFlattenedBuffer.size();
-        int* flattenedFdPtr = &flattenedFd;
-        size_t flattenedFdCount = 1;
-        if (status_t err = message.flatten(flattenedBufferPtr, flattenedBufferSize, flattenedFdPtr,
-                                           flattenedFdCount);
-            err != OK) {
-            ALOGE("Failed to flatten BufferReleaseChannel message.");
-            return err;
+        int* flattenedFdPtr = flattenedFds.data();
+        size_t flattenedFdSpace = flattenedFds.size();
+        for (size_t i = 0; i < count; i++) {
+            if (status_t err = messages[i].flatten(flattenedBufferPtr, flattenedBufferSize,
+                                                   flattenedFdPtr, flattenedFdSpace);
+                err != OK) {
+                ALOGE("Failed to flatten BufferReleaseChannel message.");
+                return err;
+            }
         }
+        flattenedFdCount = flattenedFds.size() - flattenedFdSpace;
     }
 
     iovec iov{
@@ -230,16 +284,16 @@ int BufferReleaseChannel::ProducerEndpoint::writeReleaseFence(const ReleaseCallb
             .msg_iovlen = 1,
     };
 
-    std::array<uint8_t, CMSG_SPACE(sizeof(int))> controlMessageBuffer;
-    if (fence && fence->isValid()) {
+    std::array<uint8_t, CMSG_SPACE(MAX_MESSAGES_PER_DATAGRAM * sizeof(int))> controlMessageBuffer;
+    if (flattenedFdCount > 0) {
         msg.msg_control = controlMessageBuffer.data();
-        msg.msg_controllen = controlMessageBuffer.size();
+        msg.msg_controllen = CMSG_SPACE(flattenedFdCount * sizeof(int));
 
         cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
         cmsg->cmsg_level = SOL_SOCKET;
         cmsg->cmsg_type = SCM_RIGHTS;
-        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
-        memcpy(CMSG_DATA(cmsg), &flattenedFd, sizeof(int));
+        cmsg->cmsg_len = CMSG_LEN(flattenedFdCount * sizeof(int));
+        memcpy(CMSG_DATA(cmsg), flattenedFds.data(), flattenedFdCount * sizeof(int));
     }
 
     int result;
@@ -106,10 +106,25 @@ status_t CpuConsumer::lockBufferItem(const BufferItem& item, LockedBuffer* outBu
 
     PixelFormat format = item.mGraphicBuffer->getPixelFormat();
     PixelFormat flexFormat = format;
-    if (isPossiblyYUV(format)) {
+    // Buffers cycle through the queue, so once a buffer has failed a flexible
+    // YUV lock there is no point probing gralloc again for it on every
+    // subsequent acquire; remember the verdict per buffer id. For explicitly
+    // flexible YUV buffers the YCbCr lock is mandatory, so those are always
+    // attempted.
+    const uint64_t bufferId = item.mGraphicBuffer->getId();
+    const auto cachedYuvSupport = mCanLockYCbCr.find(bufferId);
+    if (isPossiblyYUV(format) &&
+        (format == HAL_PIXEL_FORMAT_YCbCr_420_888 || cachedYuvSupport == mCanLockYCbCr.end() ||
+         cachedYuvSupport->second)) {
         int fenceFd = item.mFence.get() ? item.mFence->dup() : -1;
         status_t err = item.mGraphicBuffer->lockAsyncYCbCr(GraphicBuffer::USAGE_SW_READ_OFTEN,
                                                            item.mCrop, &ycbcr, fenceFd);
+        // A queue only has NUM_BUFFER_SLOTS live buffers; anything beyond that
+        // is stale ids from reallocated buffers, so just start over.
+        if (mCanLockYCbCr.size() >= static_cast<size_t>(BufferQueue::NUM_BUFFER_SLOTS)) {
+            mCanLockYCbCr.clear();
+        }
+        mCanLockYCbCr[bufferId] = (err == OK);
         if (err == OK) {
             flexFormat = HAL_PIXEL_FORMAT_YCbCr_420_888;
             if (format != HAL_PIXEL_FORMAT_YCbCr_420_888) {
@@ -31,6 +31,11 @@ namespace android::gui {
 
 // --- DisplayInfo ---
 
+bool DisplayInfo::operator==(const DisplayInfo& info) const {
+    return info.displayId == displayId && info.logicalWidth == logicalWidth &&
+            info.logicalHeight == logicalHeight && info.transform == transform;
+}
+
 status_t DisplayInfo::readFromParcel(const android::Parcel* parcel) {
     if (parcel == nullptr) {
         ALOGE("%s: Null parcel", __func__);
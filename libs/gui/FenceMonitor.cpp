@@ -20,15 +20,104 @@
 #include <gui/TraceUtils.h>
 #include <log/log.h>
 
+#include <android-base/unique_fd.h>
+#include <sys/epoll.h>
+
+#include <functional>
 #include <thread>
+#include <unordered_map>
 
 namespace android::gui {
 
-FenceMonitor::FenceMonitor(const char* name) : mName(name), mFencesQueued(0), mFencesSignaled(0) {
-    std::thread thread(&FenceMonitor::loop, this);
-    pthread_setname_np(thread.native_handle(), mName);
-    thread.detach();
-}
+namespace {
+
+/**
+ * One thread multiplexing all monitored fences in the process over epoll.
+ * Sync file fds become readable when their fence signals, so a single
+ * epoll_wait picks up every expiry in one wakeup instead of one thread
+ * per monitor round-tripping through the scheduler.
+ */
+class FenceWaiter {
+public:
+    static FenceWaiter& getInstance() {
+        static FenceWaiter instance;
+        return instance;
+    }
+
+    // Invokes onSignaled on the waiter thread, without internal locks held,
+    // once the sync fd signals. Takes ownership of the fd. Returns false if
+    // the fd could not be watched; the callback will then never fire.
+    bool watch(base::unique_fd fd, std::function<void()> onSignaled) {
+        if (fd.get() < 0) {
+            return false;
+        }
+        const int rawFd = fd.get();
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            mWatches.emplace(rawFd, Watch{std::move(fd), std::move(onSignaled)});
+        }
+        epoll_event event = {.events = EPOLLIN, .data = {.fd = rawFd}};
+        if (epoll_ctl(mEpollFd.get(), EPOLL_CTL_ADD, rawFd, &event) < 0) {
+            ALOGE("Failed to watch fence fd: %s", strerror(errno));
+            std::lock_guard<std::mutex> lock(mLock);
+            mWatches.erase(rawFd);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Watch {
+        base::unique_fd fd;
+        std::function<void()> onSignaled;
+    };
+
+    FenceWaiter() : mEpollFd(epoll_create1(EPOLL_CLOEXEC)) {
+        LOG_ALWAYS_FATAL_IF(mEpollFd.get() < 0, "Failed to create epoll: %s", strerror(errno));
+        std::thread thread(&FenceWaiter::loop, this);
+        pthread_setname_np(thread.native_handle(), "FenceMonitor");
+        thread.detach();
+    }
+
+    void loop() {
+        constexpr size_t kMaxEvents = 16;
+        epoll_event events[kMaxEvents];
+        while (true) {
+            const int eventCount = epoll_wait(mEpollFd.get(), events, kMaxEvents, -1);
+            if (eventCount < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ALOGE("epoll_wait failed: %s", strerror(errno));
+                return;
+            }
+            for (int i = 0; i < eventCount; i++) {
+                const int rawFd = events[i].data.fd;
+                epoll_ctl(mEpollFd.get(), EPOLL_CTL_DEL, rawFd, nullptr);
+                Watch watch;
+                {
+                    std::lock_guard<std::mutex> lock(mLock);
+                    auto node = mWatches.extract(rawFd);
+                    if (node.empty()) {
+                        continue;
+                    }
+                    watch = std::move(node.mapped());
+                }
+                // outside mLock: the callback typically arms the next fence
+                watch.onSignaled();
+            }
+        }
+    }
+
+    base::unique_fd mEpollFd;
+    std::mutex mLock;
+    std::unordered_map<int, Watch> mWatches;
+};
+
+} // namespace
+
+FenceMonitor::FenceMonitor(const char* name)
+      : mName(name), mFencesQueued(0), mFencesSignaled(0) {}
 
 void FenceMonitor::queueFence(const sp<Fence>& fence) {
     char message[64];
@@ -46,44 +135,42 @@ void FenceMonitor::queueFence(const sp<Fence>& fence) {
     ATRACE_NAME(message);
 
     mQueue.push_back(fence);
-    mCondition.notify_one();
     mFencesQueued++;
     ATRACE_INT(mName, int32_t(mQueue.size()));
-}
-
-void FenceMonitor::loop() {
-    while (true) {
-        threadLoop();
+    if (mQueue.size() == 1) {
+        armLocked();
     }
 }
 
-void FenceMonitor::threadLoop() {
-    sp<Fence> fence;
-    uint32_t fenceNum;
-    {
-        std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty()) {
-            mCondition.wait(lock);
+void FenceMonitor::armLocked() {
+    // Fences are traced in queue order, so one outstanding watch on the front
+    // fence per monitor is enough.
+    while (!mQueue.empty()) {
+        if (FenceWaiter::getInstance().watch(base::unique_fd(mQueue.front()->dup()),
+                                             [this] { onFenceSignaled(); })) {
+            return;
         }
-        fence = mQueue[0];
-        fenceNum = mFencesSignaled;
-    }
-    {
-        char message[64];
-        snprintf(message, sizeof(message), "waiting for %s %u", mName, fenceNum);
-        ATRACE_NAME(message);
-
-        status_t result = fence->waitForever(message);
-        if (result != OK) {
-            ALOGE("Error waiting for fence: %d", result);
-        }
-    }
-    {
-        std::lock_guard<std::mutex> lock(mMutex);
+        // Couldn't watch this fence; count it as signaled so the queue never
+        // stalls.
         mQueue.pop_front();
         mFencesSignaled++;
         ATRACE_INT(mName, int32_t(mQueue.size()));
     }
 }
 
-} // namespace android::gui
\ No newline at end of file
+void FenceMonitor::onFenceSignaled() {
+    char message[64];
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    snprintf(message, sizeof(message), "%s fence %u signaled", mName, mFencesSignaled);
+    ATRACE_NAME(message);
+
+    mQueue.pop_front();
+    mFencesSignaled++;
+    ATRACE_INT(mName, int32_t(mQueue.size()));
+    if (!mQueue.empty()) {
+        armLocked();
+    }
+}
+
+} // namespace android::gui
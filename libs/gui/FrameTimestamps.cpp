@@ -204,6 +204,29 @@ void FrameEventHistory::checkFencesForCompletion() {
     }
 }
 
+CompositorTiming FrameEventHistory::getCompositorTimingSnapshot() const {
+    for (;;) {
+        const uint32_t begin = mCompositorTimingSeq.load(std::memory_order_acquire);
+        if (CC_UNLIKELY(begin & 1)) {
+            // A write is in progress.
+            continue;
+        }
+        CompositorTiming timing = mCompositorTiming;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (CC_LIKELY(mCompositorTimingSeq.load(std::memory_order_relaxed) == begin)) {
+            return timing;
+        }
+    }
+}
+
+void FrameEventHistory::publishCompositorTiming(const CompositorTiming& timing) {
+    const uint32_t seq = mCompositorTimingSeq.load(std::memory_order_relaxed);
+    mCompositorTimingSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    mCompositorTiming = timing;
+    mCompositorTimingSeq.store(seq + 2, std::memory_order_release);
+}
+
 // Uses !|valid| as the MSB.
 static bool FrameNumberLessThan(
         const FrameEvents& lhs, const FrameEvents& rhs) {
@@ -270,7 +293,7 @@ void ProducerFrameEventHistory::updateAcquireFence(
 
 void ProducerFrameEventHistory::applyDelta(
         const FrameEventHistoryDelta& delta) {
-    mCompositorTiming = delta.mCompositorTiming;
+    publishCompositorTiming(delta.mCompositorTiming);
 
     // Deltas should have enough reserved capacity for the consumer-side, therefore if there's a
     // different capacity, we re-sized on the consumer side and now need to resize on the producer
@@ -411,7 +434,7 @@ void ConsumerFrameEventHistory::setProducerWantsEvents() {
 
 void ConsumerFrameEventHistory::initializeCompositorTiming(
         const CompositorTiming& compositorTiming) {
-    mCompositorTiming = compositorTiming;
+    publishCompositorTiming(compositorTiming);
 }
 
 void ConsumerFrameEventHistory::addQueue(const NewFrameEventsEntry& newEntry) {
@@ -464,7 +487,7 @@ void ConsumerFrameEventHistory::addPostComposition(uint64_t frameNumber,
         const std::shared_ptr<FenceTime>& gpuCompositionDone,
         const std::shared_ptr<FenceTime>& displayPresent,
         const CompositorTiming& compositorTiming) {
-    mCompositorTiming = compositorTiming;
+    publishCompositorTiming(compositorTiming);
 
     FrameEvents* frame = getFrame(frameNumber, &mCompositionOffset);
     if (frame == nullptr) {
@@ -68,43 +68,13 @@ public:
             const std::vector<ListenerCallbacks>& listenerCallbacks, uint64_t transactionId,
             const std::vector<uint64_t>& mergedTransactionIds) override {
         Parcel data, reply;
-        data.writeInterfaceToken(ISurfaceComposer::getInterfaceDescriptor());
-
-        frameTimelineInfo.writeToParcel(&data);
-
-        SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(state.size()));
-        for (const auto& s : state) {
-            SAFE_PARCEL(s.write, data);
-        }
-
-        SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(displays.size()));
-        for (const auto& d : displays) {
-            SAFE_PARCEL(d.write, data);
-        }
-
-        SAFE_PARCEL(data.writeUint32, flags);
-        SAFE_PARCEL(data.writeStrongBinder, applyToken);
-        SAFE_PARCEL(commands.write, data);
-        SAFE_PARCEL(data.writeInt64, desiredPresentTime);
-        SAFE_PARCEL(data.writeBool, isAutoTimestamp);
-        SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(uncacheBuffers.size()));
-        for (const client_cache_t& uncacheBuffer : uncacheBuffers) {
-            SAFE_PARCEL(data.writeStrongBinder, uncacheBuffer.token.promote());
-            SAFE_PARCEL(data.writeUint64, uncacheBuffer.id);
-        }
-        SAFE_PARCEL(data.writeBool, hasListenerCallbacks);
-
-        SAFE_PARCEL(data.writeVectorSize, listenerCallbacks);
-        for (const auto& [listener, callbackIds] : listenerCallbacks) {
-            SAFE_PARCEL(data.writeStrongBinder, listener);
-            SAFE_PARCEL(data.writeParcelableVector, callbackIds);
-        }
-
-        SAFE_PARCEL(data.writeUint64, transactionId);
-
-        SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(mergedTransactionIds.size()));
-        for (auto mergedTransactionId : mergedTransactionIds) {
-            SAFE_PARCEL(data.writeUint64, mergedTransactionId);
+        status_t err =
+                writeTransactionState(data, frameTimelineInfo, state, displays, flags, applyToken,
+                                      commands, desiredPresentTime, isAutoTimestamp, uncacheBuffers,
+                                      hasListenerCallbacks, listenerCallbacks, transactionId,
+                                      mergedTransactionIds);
+        if (err != NO_ERROR) {
+            return err;
         }
 
         if (flags & ISurfaceComposer::eOneWay) {
@@ -123,6 +93,59 @@ BpSurfaceComposer::~BpSurfaceComposer() {}
 
 IMPLEMENT_META_INTERFACE(SurfaceComposer, "android.ui.ISurfaceComposer");
 
+status_t ISurfaceComposer::writeTransactionState(
+        Parcel& data, const FrameTimelineInfo& frameTimelineInfo,
+        const Vector<ComposerState>& state, const Vector<DisplayState>& displays, uint32_t flags,
+        const sp<IBinder>& applyToken, const InputWindowCommands& commands,
+        int64_t desiredPresentTime, bool isAutoTimestamp,
+        const std::vector<client_cache_t>& uncacheBuffers, bool hasListenerCallbacks,
+        const std::vector<ListenerCallbacks>& listenerCallbacks, uint64_t transactionId,
+        const std::vector<uint64_t>& mergedTransactionIds, size_t* outTransactionIdPos) {
+    data.writeInterfaceToken(ISurfaceComposer::getInterfaceDescriptor());
+
+    frameTimelineInfo.writeToParcel(&data);
+
+    SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(state.size()));
+    for (const auto& s : state) {
+        SAFE_PARCEL(s.write, data);
+    }
+
+    SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(displays.size()));
+    for (const auto& d : displays) {
+        SAFE_PARCEL(d.write, data);
+    }
+
+    SAFE_PARCEL(data.writeUint32, flags);
+    SAFE_PARCEL(data.writeStrongBinder, applyToken);
+    SAFE_PARCEL(commands.write, data);
+    SAFE_PARCEL(data.writeInt64, desiredPresentTime);
+    SAFE_PARCEL(data.writeBool, isAutoTimestamp);
+    SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(uncacheBuffers.size()));
+    for (const client_cache_t& uncacheBuffer : uncacheBuffers) {
+        SAFE_PARCEL(data.writeStrongBinder, uncacheBuffer.token.promote());
+        SAFE_PARCEL(data.writeUint64, uncacheBuffer.id);
+    }
+    SAFE_PARCEL(data.writeBool, hasListenerCallbacks);
+
+    SAFE_PARCEL(data.writeVectorSize, listenerCallbacks);
+    for (const auto& [listener, callbackIds] : listenerCallbacks) {
+        SAFE_PARCEL(data.writeStrongBinder, listener);
+        SAFE_PARCEL(data.writeParcelableVector, callbackIds);
+    }
+
+    if (outTransactionIdPos != nullptr) {
+        *outTransactionIdPos = data.dataPosition();
+    }
+    SAFE_PARCEL(data.writeUint64, transactionId);
+
+    SAFE_PARCEL(data.writeUint32, static_cast<uint32_t>(mergedTransactionIds.size()));
+    for (auto mergedTransactionId : mergedTransactionIds) {
+        SAFE_PARCEL(data.writeUint64, mergedTransactionId);
+    }
+
+    return NO_ERROR;
+}
+
 // ----------------------------------------------------------------------
 
 status_t BnSurfaceComposer::onTransact(
@@ -200,6 +200,8 @@ status_t layer_state_t::write(Parcel& output) const
         SAFE_PARCEL(output.writeParcelable, *bufferReleaseChannel);
     }
 
+    SAFE_PARCEL(animationSpec.write, output);
+
     return NO_ERROR;
 }
 
@@ -352,6 +354,46 @@ status_t layer_state_t::read(const Parcel& input)
         SAFE_PARCEL(input.readParcelable, bufferReleaseChannel.get());
     }
 
+    SAFE_PARCEL(animationSpec.read, input);
+
+    return NO_ERROR;
+}
+
+status_t LayerAnimationSpec::write(Parcel& output) const {
+    SAFE_PARCEL(output.writeInt64, startTimeNanos);
+    SAFE_PARCEL(output.writeInt64, durationNanos);
+    SAFE_PARCEL(output.writeInt32, static_cast<int32_t>(curve));
+    SAFE_PARCEL(output.writeBool, animatePosition);
+    SAFE_PARCEL(output.writeFloat, startX);
+    SAFE_PARCEL(output.writeFloat, startY);
+    SAFE_PARCEL(output.writeFloat, endX);
+    SAFE_PARCEL(output.writeFloat, endY);
+    SAFE_PARCEL(output.writeBool, animateAlpha);
+    SAFE_PARCEL(output.writeFloat, startAlpha);
+    SAFE_PARCEL(output.writeFloat, endAlpha);
+    SAFE_PARCEL(output.writeBool, animateCrop);
+    SAFE_PARCEL(output.write, startCrop);
+    SAFE_PARCEL(output.write, endCrop);
+    return NO_ERROR;
+}
+
+status_t LayerAnimationSpec::read(const Parcel& input) {
+    SAFE_PARCEL(input.readInt64, &startTimeNanos);
+    SAFE_PARCEL(input.readInt64, &durationNanos);
+    int32_t curveInt;
+    SAFE_PARCEL(input.readInt32, &curveInt);
+    curve = static_cast<Curve>(curveInt);
+    SAFE_PARCEL(input.readBool, &animatePosition);
+    SAFE_PARCEL(input.readFloat, &startX);
+    SAFE_PARCEL(input.readFloat, &startY);
+    SAFE_PARCEL(input.readFloat, &endX);
+    SAFE_PARCEL(input.readFloat, &endY);
+    SAFE_PARCEL(input.readBool, &animateAlpha);
+    SAFE_PARCEL(input.readFloat, &startAlpha);
+    SAFE_PARCEL(input.readFloat, &endAlpha);
+    SAFE_PARCEL(input.readBool, &animateCrop);
+    SAFE_PARCEL(input.read, startCrop);
+    SAFE_PARCEL(input.read, endCrop);
     return NO_ERROR;
 }
 
@@ -735,6 +777,10 @@ void layer_state_t::merge(const layer_state_t& other) {
         what |= eBufferReleaseChannelChanged;
         bufferReleaseChannel = other.bufferReleaseChannel;
     }
+    if (other.what & eAnimationChanged) {
+        what |= eAnimationChanged;
+        animationSpec = other.animationSpec;
+    }
     if ((other.what & what) != other.what) {
         ALOGE("Unmerged SurfaceComposer Transaction properties. LayerState::merge needs updating? "
               "other.what=0x%" PRIX64 " what=0x%" PRIX64 " unmerged flags=0x%" PRIX64,
@@ -815,6 +861,7 @@ uint64_t layer_state_t::diff(const layer_state_t& other) const {
     CHECK_DIFF(diff, eColorSpaceAgnosticChanged, other, colorSpaceAgnostic);
     CHECK_DIFF(diff, eDimmingEnabledChanged, other, dimmingEnabled);
     if (other.what & eBufferReleaseChannelChanged) diff |= eBufferReleaseChannelChanged;
+    CHECK_DIFF(diff, eAnimationChanged, other, animationSpec);
     return diff;
 }
 
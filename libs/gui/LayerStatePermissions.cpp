@@ -22,7 +22,26 @@
 #endif // __ANDROID_VNDK__
 #include <gui/LayerState.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace android {
+
+namespace {
+// The transaction permissions are signature-level system permissions: for a given (pid, uid) they
+// cannot change while the process is alive, which makes them safe to memoize with the same caveat
+// that PermissionCache documents. Entries are pushed out through invalidateCache() when the client
+// behind them goes away, so a recycled pid cannot observe a stale grant.
+std::mutex gCacheLock;
+std::unordered_map<uint64_t, uint32_t> gCachedPermissions;
+
+// Processes come and go; past this size the map is more leak than cache.
+constexpr size_t kMaxCachedProcesses = 1024;
+
+uint64_t cacheKey(int pid, int uid) {
+    return (uint64_t(uint32_t(uid)) << 32) | uint32_t(pid);
+}
+} // namespace
 std::vector<std::pair<String16, int>> LayerStatePermissions::mPermissionMap = {
         // If caller has ACCESS_SURFACE_FLINGER, they automatically get ROTATE_SURFACE_FLINGER
         // permission, as well
@@ -45,7 +64,7 @@ static bool callingThreadHasPermission(const String16& permission __attribute__(
     return false;
 }
 
-uint32_t LayerStatePermissions::getTransactionPermissions(int pid, int uid) {
+uint32_t LayerStatePermissions::evaluateTransactionPermissions(int pid, int uid) {
     uint32_t permissions = 0;
     for (const auto& [permissionName, permissionVal] : mPermissionMap) {
         if (callingThreadHasPermission(permissionName, pid, uid)) {
@@ -55,4 +74,29 @@ uint32_t LayerStatePermissions::getTransactionPermissions(int pid, int uid) {
 
     return permissions;
 }
+
+uint32_t LayerStatePermissions::getTransactionPermissions(int pid, int uid) {
+    const uint64_t key = cacheKey(pid, uid);
+    {
+        std::lock_guard lock(gCacheLock);
+        const auto it = gCachedPermissions.find(key);
+        if (it != gCachedPermissions.end()) {
+            return it->second;
+        }
+    }
+    // Evaluate outside the lock; the checks may block on a binder call to the
+    // permission controller the first time a process is seen.
+    const uint32_t permissions = evaluateTransactionPermissions(pid, uid);
+    std::lock_guard lock(gCacheLock);
+    if (gCachedPermissions.size() >= kMaxCachedProcesses) {
+        gCachedPermissions.clear();
+    }
+    gCachedPermissions.emplace(key, permissions);
+    return permissions;
+}
+
+void LayerStatePermissions::invalidateCache(int pid, int uid) {
+    std::lock_guard lock(gCacheLock);
+    gCachedPermissions.erase(cacheKey(pid, uid));
+}
 } // namespace android
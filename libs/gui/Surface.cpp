@@ -188,6 +188,18 @@ void Surface::allocateBuffers() {
             mReqFormat, mReqUsage);
 }
 
+void Surface::allocateBuffersAsync(std::function<void()> onComplete) {
+    uint32_t reqWidth = mReqWidth ? mReqWidth : mUserWidth;
+    uint32_t reqHeight = mReqHeight ? mReqHeight : mUserHeight;
+    std::thread([reqWidth, reqHeight, gbp = mGraphicBufferProducer, reqFormat = mReqFormat,
+                 reqUsage = mReqUsage, onComplete = std::move(onComplete)]() {
+        gbp->allocateBuffers(reqWidth, reqHeight, reqFormat, reqUsage);
+        if (onComplete != nullptr) {
+            onComplete();
+        }
+    }).detach();
+}
+
 #if COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(WB_PLATFORM_API_IMPROVEMENTS)
 status_t Surface::allowAllocation(bool allowAllocation) {
     return mGraphicBufferProducer->allowAllocation(allowAllocation);
@@ -250,21 +262,23 @@ void Surface::enableFrameTimestamps(bool enable) {
 status_t Surface::getCompositorTiming(
         nsecs_t* compositeDeadline, nsecs_t* compositeInterval,
         nsecs_t* compositeToPresentLatency) {
-    Mutex::Autolock lock(mMutex);
+    // Deliberately not holding mMutex: the timing is read from a seqlock'd
+    // snapshot, so callers asking for the next deadline are never blocked
+    // behind a dequeue or queue in progress on another thread.
     if (!mEnableFrameTimestamps) {
         return INVALID_OPERATION;
     }
 
+    const CompositorTiming timing = mFrameEventHistory->getCompositorTimingSnapshot();
     if (compositeDeadline != nullptr) {
-        *compositeDeadline =
-                mFrameEventHistory->getNextCompositeDeadline(now());
+        *compositeDeadline = ProducerFrameEventHistory::snapToNextTick(now(), timing.deadline,
+                                                                       timing.interval);
     }
     if (compositeInterval != nullptr) {
-        *compositeInterval = mFrameEventHistory->getCompositeInterval();
+        *compositeInterval = timing.interval;
     }
     if (compositeToPresentLatency != nullptr) {
-        *compositeToPresentLatency =
-                mFrameEventHistory->getCompositeToPresentLatency();
+        *compositeToPresentLatency = timing.presentLatency;
     }
     return NO_ERROR;
 }
@@ -830,6 +830,7 @@ SurfaceComposerClient::Transaction::Transaction(const Transaction& other)
         mAnimation(other.mAnimation),
         mEarlyWakeupStart(other.mEarlyWakeupStart),
         mEarlyWakeupEnd(other.mEarlyWakeupEnd),
+        mUrgent(other.mUrgent),
         mMayContainBuffer(other.mMayContainBuffer),
         mDesiredPresentTime(other.mDesiredPresentTime),
         mIsAutoTimestamp(other.mIsAutoTimestamp),
@@ -869,6 +870,7 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
     const bool animation = parcel->readBool();
     const bool earlyWakeupStart = parcel->readBool();
     const bool earlyWakeupEnd = parcel->readBool();
+    const bool urgent = parcel->readBool();
     const int64_t desiredPresentTime = parcel->readInt64();
     const bool isAutoTimestamp = parcel->readBool();
     FrameTimelineInfo frameTimelineInfo;
@@ -965,6 +967,7 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
     mAnimation = animation;
     mEarlyWakeupStart = earlyWakeupStart;
     mEarlyWakeupEnd = earlyWakeupEnd;
+    mUrgent = urgent;
     mDesiredPresentTime = desiredPresentTime;
     mIsAutoTimestamp = isAutoTimestamp;
     mFrameTimelineInfo = frameTimelineInfo;
@@ -996,6 +999,7 @@ status_t SurfaceComposerClient::Transaction::writeToParcel(Parcel* parcel) const
     parcel->writeBool(mAnimation);
     parcel->writeBool(mEarlyWakeupStart);
     parcel->writeBool(mEarlyWakeupEnd);
+    parcel->writeBool(mUrgent);
     parcel->writeInt64(mDesiredPresentTime);
     parcel->writeBool(mIsAutoTimestamp);
     mFrameTimelineInfo.writeToParcel(parcel);
@@ -1078,13 +1082,11 @@ SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::merge(Tr
     mMergedTransactionIds.insert(mMergedTransactionIds.begin(), other.mId);
 
     for (auto const& [handle, composerState] : other.mComposerStates) {
-        if (mComposerStates.count(handle) == 0) {
-            mComposerStates[handle] = composerState;
-        } else {
+        if (auto [it, inserted] = mComposerStates.try_emplace(handle, composerState); !inserted) {
             if (composerState.state.what & layer_state_t::eBufferChanged) {
-                releaseBufferIfOverwriting(mComposerStates[handle].state);
+                releaseBufferIfOverwriting(it->second.state);
             }
-            mComposerStates[handle].state.merge(composerState.state);
+            it->second.state.merge(composerState.state);
         }
     }
 
@@ -1129,6 +1131,7 @@ SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::merge(Tr
     mMayContainBuffer |= other.mMayContainBuffer;
     mEarlyWakeupStart = mEarlyWakeupStart || other.mEarlyWakeupStart;
     mEarlyWakeupEnd = mEarlyWakeupEnd || other.mEarlyWakeupEnd;
+    mUrgent = mUrgent || other.mUrgent;
     mApplyToken = other.mApplyToken;
 
     mergeFrameTimelineInfo(mFrameTimelineInfo, other.mFrameTimelineInfo);
@@ -1147,6 +1150,7 @@ void SurfaceComposerClient::Transaction::clear() {
     mAnimation = false;
     mEarlyWakeupStart = false;
     mEarlyWakeupEnd = false;
+    mUrgent = false;
     mDesiredPresentTime = 0;
     mIsAutoTimestamp = true;
     mFrameTimelineInfo = {};
@@ -1342,6 +1346,9 @@ status_t SurfaceComposerClient::Transaction::apply(bool synchronous, bool oneWay
     if (mEarlyWakeupEnd && !mEarlyWakeupStart) {
         flags |= ISurfaceComposer::eEarlyWakeupEnd;
     }
+    if (mUrgent) {
+        flags |= ISurfaceComposer::eUrgent;
+    }
 
     sp<IBinder> applyToken = mApplyToken ? mApplyToken : getDefaultApplyToken();
 
@@ -1363,6 +1370,87 @@ status_t SurfaceComposerClient::Transaction::apply(bool synchronous, bool oneWay
     return NO_ERROR;
 }
 
+SurfaceComposerClient::Transaction::Snapshot::Snapshot() = default;
+SurfaceComposerClient::Transaction::Snapshot::~Snapshot() = default;
+SurfaceComposerClient::Transaction::Snapshot::Snapshot(Snapshot&&) noexcept = default;
+SurfaceComposerClient::Transaction::Snapshot& SurfaceComposerClient::Transaction::Snapshot::
+operator=(Snapshot&&) noexcept = default;
+
+status_t SurfaceComposerClient::Transaction::Snapshot::apply() {
+    if (mParcel == nullptr) {
+        return NO_INIT;
+    }
+
+    // Give every replay its own id so tracing can tell the applies apart. The id is a
+    // fixed-size field, so it can be patched in place without reflattening.
+    mParcel->setDataPosition(static_cast<size_t>(mTransactionIdPos));
+    SAFE_PARCEL(mParcel->writeUint64, static_cast<uint64_t>(generateId()));
+
+    sp<IBinder> sf = IInterface::asBinder(ComposerService::getComposerService());
+    if (sf == nullptr) {
+        return NO_INIT;
+    }
+    Parcel reply;
+    return sf->transact(BnSurfaceComposer::SET_TRANSACTION_STATE, *mParcel, &reply,
+                        mOneWay ? IBinder::FLAG_ONEWAY : 0);
+}
+
+status_t SurfaceComposerClient::Transaction::createSnapshot(Snapshot* outSnapshot, bool oneWay) {
+    if (mStatus != NO_ERROR) {
+        return mStatus;
+    }
+    if (!mListenerCallbacks.empty() || mMayContainBuffer || !mUncacheBuffers.empty()) {
+        ALOGE("createSnapshot: transactions with buffers or callbacks cannot be snapshotted");
+        return BAD_VALUE;
+    }
+
+    Vector<ComposerState> composerStates;
+    for (auto const& kv : mComposerStates) {
+        composerStates.add(kv.second);
+    }
+    Vector<DisplayState> displayStates;
+    displayStates = mDisplayStates;
+
+    uint32_t flags = 0;
+    if (mAnimation) {
+        flags |= ISurfaceComposer::eAnimation;
+    }
+    if (oneWay) {
+        flags |= ISurfaceComposer::eOneWay;
+    }
+    if (mEarlyWakeupStart && !mEarlyWakeupEnd) {
+        flags |= ISurfaceComposer::eEarlyWakeupStart;
+    }
+    if (mEarlyWakeupEnd && !mEarlyWakeupStart) {
+        flags |= ISurfaceComposer::eEarlyWakeupEnd;
+    }
+    if (mUrgent) {
+        flags |= ISurfaceComposer::eUrgent;
+    }
+
+    sp<IBinder> applyToken = mApplyToken ? mApplyToken : getDefaultApplyToken();
+
+    auto parcel = std::make_unique<Parcel>();
+    size_t transactionIdPos = 0;
+    status_t err =
+            ISurfaceComposer::writeTransactionState(*parcel, mFrameTimelineInfo, composerStates,
+                                                    displayStates, flags, applyToken,
+                                                    mInputWindowCommands, mDesiredPresentTime,
+                                                    mIsAutoTimestamp, /*uncacheBuffers=*/{},
+                                                    /*hasListenerCallbacks=*/false,
+                                                    /*listenerCallbacks=*/{}, mId,
+                                                    mMergedTransactionIds, &transactionIdPos);
+    if (err != NO_ERROR) {
+        ALOGE("createSnapshot: failed to flatten transaction: %s", strerror(-err));
+        return err;
+    }
+
+    outSnapshot->mParcel = std::move(parcel);
+    outSnapshot->mTransactionIdPos = transactionIdPos;
+    outSnapshot->mOneWay = oneWay;
+    return NO_ERROR;
+}
+
 sp<IBinder> SurfaceComposerClient::Transaction::sApplyToken = new BBinder();
 
 std::mutex SurfaceComposerClient::Transaction::sApplyTokenMutex;
@@ -1451,20 +1539,21 @@ void SurfaceComposerClient::Transaction::setEarlyWakeupEnd() {
     mEarlyWakeupEnd = true;
 }
 
-layer_state_t* SurfaceComposerClient::Transaction::getLayerState(const sp<SurfaceControl>& sc) {
-    auto handle = sc->getLayerStateHandle();
-
-    if (mComposerStates.count(handle) == 0) {
-        // we don't have it, add an initialized layer_state to our list
-        ComposerState s;
-
-        s.state.surface = handle;
-        s.state.layerId = sc->getLayerId();
+void SurfaceComposerClient::Transaction::setUrgentTransaction() {
+    mUrgent = true;
+}
 
-        mComposerStates[handle] = s;
+layer_state_t* SurfaceComposerClient::Transaction::getLayerState(const sp<SurfaceControl>& sc) {
+    // This runs for every setter on the transaction, so hash the handle once and avoid
+    // refcounting temporary handle copies.
+    auto [it, inserted] = mComposerStates.try_emplace(sc->getLayerStateHandle());
+    if (inserted) {
+        // we didn't have it, so initialize the layer_state we just added
+        it->second.state.surface = it->first;
+        it->second.state.layerId = sc->getLayerId();
     }
 
-    return &(mComposerStates[handle].state);
+    return &(it->second.state);
 }
 
 void SurfaceComposerClient::Transaction::registerSurfaceControlForCallback(
@@ -1664,6 +1753,20 @@ SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::setCrop(
     return *this;
 }
 
+SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::setAnimationSpec(
+        const sp<SurfaceControl>& sc, const LayerAnimationSpec& spec) {
+    layer_state_t* s = getLayerState(sc);
+    if (!s) {
+        mStatus = BAD_INDEX;
+        return *this;
+    }
+    s->what |= layer_state_t::eAnimationChanged;
+    s->animationSpec = spec;
+
+    registerSurfaceControlForCallback(sc);
+    return *this;
+}
+
 SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::setCornerRadius(
         const sp<SurfaceControl>& sc, float cornerRadius) {
     layer_state_t* s = getLayerState(sc);
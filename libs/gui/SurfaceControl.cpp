@@ -173,7 +173,7 @@ void SurfaceControl::updateDefaultBufferSize(uint32_t width, uint32_t height) {
     }
 }
 
-sp<IBinder> SurfaceControl::getLayerStateHandle() const
+const sp<IBinder>& SurfaceControl::getLayerStateHandle() const
 {
     return mHandle;
 }
@@ -160,7 +160,13 @@ private:
     void resizeFrameEventHistory(size_t newSize);
 
     status_t acquireNextBufferLocked(
-            const std::optional<SurfaceComposerClient::Transaction*> transaction) REQUIRES(mMutex);
+            const std::optional<SurfaceComposerClient::Transaction*> transaction,
+            bool setBarrier = true) REQUIRES(mMutex);
+    // Acquires every buffer waiting in the shadow queue into a single transaction and applies it
+    // once, so a burst of queued buffers costs one setTransactionState call instead of one per
+    // buffer. Stale buffers overwritten by a later setBuffer in the merged transaction are
+    // released locally by the Transaction without a round trip to SurfaceFlinger.
+    void acquireAndApplyAvailableBuffersLocked() REQUIRES(mMutex);
     Rect computeCrop(const BufferItem& item) REQUIRES(mMutex);
     // Return true if we need to reject the buffer based on the scaling mode and the buffer size.
     bool rejectBuffer(const BufferItem& item) REQUIRES(mMutex);
@@ -17,6 +17,8 @@
 #ifndef ANDROID_GUI_BUFFERITEMCONSUMER_H
 #define ANDROID_GUI_BUFFERITEMCONSUMER_H
 
+#include <vector>
+
 #include <com_android_graphics_libgui_flags.h>
 #include <gui/BufferQueue.h>
 #include <gui/ConsumerBase.h>
@@ -86,6 +88,20 @@ class BufferItemConsumer: public ConsumerBase
     status_t acquireBuffer(BufferItem* item, nsecs_t presentWhen,
             bool waitForFence = true);
 
+#if COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(WB_PLATFORM_API_IMPROVEMENTS)
+    // Like acquireBuffer, but drains up to maxBuffers ready buffers under a
+    // single lock of the consumer, appending them to outItems. A producer that
+    // burst-queues frames can thus be drained with one call instead of one
+    // acquireBuffer round trip per onFrameAvailable callback.
+    //
+    // Returns OK if at least one buffer was acquired; otherwise returns the
+    // error from the first acquire attempt, as documented on acquireBuffer.
+    // Buffers appended to outItems are owned by the caller and must be
+    // returned with releaseBuffer even if an error is returned.
+    status_t acquireBuffers(std::vector<BufferItem>* outItems, nsecs_t presentWhen,
+                            size_t maxBuffers, bool waitForFence = true);
+#endif // COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(WB_PLATFORM_API_IMPROVEMENTS)
+
     // Returns an acquired buffer to the queue, allowing it to be reused. Since
     // only a fixed number of buffers may be acquired at a time, old buffers
     // must be released by calling releaseBuffer to ensure new buffers can be
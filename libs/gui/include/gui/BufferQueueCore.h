@@ -32,6 +32,7 @@
 #include <utils/Trace.h>
 #include <utils/Vector.h>
 
+#include <atomic>
 #include <list>
 #include <set>
 #include <mutex>
@@ -207,6 +208,12 @@ private:
     // mQueue is a FIFO of queued buffers used in synchronous mode.
     Fifo mQueue;
 
+    // Mirror of mQueue.size(), published with release semantics at every
+    // queue mutation (which happens with mMutex held). Read without the lock
+    // by the consumer's acquireBuffer fast path so that polling an empty
+    // queue does not contend with a producer that is mid-queueBuffer.
+    std::atomic<size_t> mQueueSize;
+
     // mFreeSlots contains all of the slots which are FREE and do not currently
     // have a buffer attached.
     std::set<int> mFreeSlots;
@@ -321,6 +328,9 @@ private:
     // mSharedBufferMode indicates whether or not shared buffer mode is enabled.
     bool mSharedBufferMode;
 
+    // Lock-free mirror of mSharedBufferMode for the acquireBuffer fast path.
+    std::atomic<bool> mSharedBufferModePublished;
+
     // When shared buffer mode is enabled, this indicates whether the consumer
     // should acquire buffers even if BufferQueue doesn't indicate that they are
     // available.
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -53,6 +54,37 @@ private:
     };
 
 public:
+    /**
+     * Maximum number of release messages packed into a single datagram. Sizes the consumer's
+     * receive buffers and the producer's SCM_RIGHTS array.
+     */
+    static constexpr size_t MAX_MESSAGES_PER_DATAGRAM = 8;
+
+    struct Message : public Flattenable<Message> {
+        ReleaseCallbackId releaseCallbackId;
+        sp<Fence> releaseFence = Fence::NO_FENCE;
+        uint32_t maxAcquiredBufferCount;
+
+        Message() = default;
+        Message(ReleaseCallbackId releaseCallbackId, sp<Fence> releaseFence,
+                uint32_t maxAcquiredBufferCount)
+              : releaseCallbackId{releaseCallbackId},
+                releaseFence{std::move(releaseFence)},
+                maxAcquiredBufferCount{maxAcquiredBufferCount} {}
+
+        // Flattenable protocol
+        size_t getFlattenedSize() const;
+
+        size_t getFdCount() const { return releaseFence->getFdCount(); }
+
+        status_t flatten(void*& buffer, size_t& size, int*& fds, size_t& count) const;
+
+        status_t unflatten(void const*& buffer, size_t& size, int const*& fds, size_t& count);
+
+    private:
+        size_t getPodSize() const;
+    };
+
     class ConsumerEndpoint : public Endpoint {
     public:
         ConsumerEndpoint(std::string name, android::base::unique_fd fd)
@@ -61,6 +93,10 @@ public:
         /**
          * Reads a release fence from the BufferReleaseChannel.
          *
+         * The producer may pack multiple releases into a single datagram. Any additional
+         * messages read from the socket are queued and returned by subsequent calls without
+         * another recvmsg syscall.
+         *
          * Returns OK on success.
          * Returns WOULD_BLOCK if there is no fence present.
          * Other errors probably indicate that the channel is broken.
@@ -69,7 +105,10 @@ public:
                                   sp<Fence>& outReleaseFence, uint32_t& maxAcquiredBufferCount);
 
     private:
+        status_t readNextDatagram();
+
         std::vector<uint8_t> mFlattenedBuffer;
+        std::deque<Message> mPendingMessages;
     };
 
     class ProducerEndpoint : public Endpoint, public Parcelable {
@@ -84,7 +123,15 @@ public:
         status_t writeReleaseFence(const ReleaseCallbackId&, const sp<Fence>& releaseFence,
                                    uint32_t maxAcquiredBufferCount);
 
+        /**
+         * Writes a batch of release fences to the BufferReleaseChannel, packing up to
+         * MAX_MESSAGES_PER_DATAGRAM messages per sendmsg syscall.
+         */
+        status_t writeReleaseFences(const std::vector<Message>& messages);
+
     private:
+        status_t writeBatch(const Message* messages, size_t count);
+
         std::vector<uint8_t> mFlattenedBuffer;
     };
 
@@ -95,31 +142,6 @@ public:
      */
     static status_t open(const std::string name, std::unique_ptr<ConsumerEndpoint>& outConsumer,
                          std::shared_ptr<ProducerEndpoint>& outProducer);
-
-    struct Message : public Flattenable<Message> {
-        ReleaseCallbackId releaseCallbackId;
-        sp<Fence> releaseFence = Fence::NO_FENCE;
-        uint32_t maxAcquiredBufferCount;
-
-        Message() = default;
-        Message(ReleaseCallbackId releaseCallbackId, sp<Fence> releaseFence,
-                uint32_t maxAcquiredBufferCount)
-              : releaseCallbackId{releaseCallbackId},
-                releaseFence{std::move(releaseFence)},
-                maxAcquiredBufferCount{maxAcquiredBufferCount} {}
-
-        // Flattenable protocol
-        size_t getFlattenedSize() const;
-
-        size_t getFdCount() const { return releaseFence->getFdCount(); }
-
-        status_t flatten(void*& buffer, size_t& size, int*& fds, size_t& count) const;
-
-        status_t unflatten(void const*& buffer, size_t& size, int const*& fds, size_t& count);
-
-    private:
-        size_t getPodSize() const;
-    };
 };
 
 } // namespace android::gui
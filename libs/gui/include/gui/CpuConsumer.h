@@ -25,6 +25,8 @@
 
 #include <utils/Vector.h>
 
+#include <unordered_map>
+
 
 namespace android {
 
@@ -156,6 +158,12 @@ class CpuConsumer : public ConsumerBase
 
     // Count of currently locked buffers
     size_t mCurrentLockedBuffers;
+
+    // Caches, per gralloc buffer id, whether the buffer can be locked as
+    // flexible YUV. Steady-state reacquires of the same buffers then skip the
+    // failing probe call into gralloc on every frame. Guarded by mMutex;
+    // mutable because lockBufferItem is const.
+    mutable std::unordered_map<uint64_t, bool> mCanLockYCbCr;
 };
 
 } // namespace android
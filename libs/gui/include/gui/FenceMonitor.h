@@ -24,20 +24,22 @@
 
 namespace android::gui {
 
+// Traces the completion of queued fences. All monitors in a process share one
+// epoll-based waiter thread. A monitor is never destroyed; create them with
+// static storage duration.
 class FenceMonitor {
 public:
     explicit FenceMonitor(const char* name);
     void queueFence(const sp<Fence>& fence);
 
 private:
-    void loop();
-    void threadLoop();
+    void armLocked();
+    void onFenceSignaled();
 
     const char* mName;
     uint32_t mFencesQueued;
     uint32_t mFencesSignaled;
     std::deque<sp<Fence>> mQueue;
-    std::condition_variable mCondition;
     std::mutex mMutex;
 };
 
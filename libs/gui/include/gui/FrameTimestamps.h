@@ -26,6 +26,7 @@
 #include <utils/Timers.h>
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <vector>
 
@@ -99,12 +100,26 @@ public:
 
     static const size_t INITIAL_MAX_FRAME_HISTORY;
 
+    // Returns the most recently published compositor timing. Unlike the rest
+    // of the history, this is readable without external synchronization: the
+    // timing is republished under a seqlock each time it changes, so readers
+    // never contend with the owner's lock.
+    CompositorTiming getCompositorTimingSnapshot() const;
+
 protected:
     void resize(size_t newSize);
 
+    // Stores a new compositor timing and republishes it through the seqlock.
+    // Callers must hold the owner's lock, which serializes writers.
+    void publishCompositorTiming(const CompositorTiming& timing);
+
     std::vector<FrameEvents> mFrames;
 
     CompositorTiming mCompositorTiming;
+
+    // Seqlock guarding mCompositorTiming for lock-free readers. Odd while a
+    // write is in progress.
+    std::atomic<uint32_t> mCompositorTimingSeq{0};
 };
 
 
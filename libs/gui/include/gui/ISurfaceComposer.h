@@ -101,7 +101,13 @@ public:
         // android.permission.WAKEUP_SURFACE_FLINGER
         eEarlyWakeupStart = 0x08,
         eEarlyWakeupEnd = 0x10,
-        eOneWay = 0x20
+        eOneWay = 0x20,
+
+        // Marks a latency-critical transaction, e.g. from system UI. SurfaceFlinger gives
+        // urgent transactions the first chance to latch when flushing the transaction queues;
+        // ordering within an apply token is unaffected. Guarded by
+        // android.permission.WAKEUP_SURFACE_FLINGER.
+        eUrgent = 0x40
     };
 
     /* open/close transactions. requires ACCESS_SURFACE_FLINGER permission */
@@ -112,6 +118,21 @@ public:
             bool isAutoTimestamp, const std::vector<client_cache_t>& uncacheBuffer,
             bool hasListenerCallbacks, const std::vector<ListenerCallbacks>& listenerCallbacks,
             uint64_t transactionId, const std::vector<uint64_t>& mergedTransactionIds) = 0;
+
+    // Flattens the arguments of a setTransactionState() call into `data`, including the
+    // interface token. Shared between the Bp implementation and
+    // SurfaceComposerClient::Transaction snapshots so the wire layout lives in one place.
+    // If `outTransactionIdPos` is non-null it receives the parcel offset of `transactionId`,
+    // which lets a cached parcel be re-sent with a fresh id patched in place.
+    static status_t writeTransactionState(
+            Parcel& data, const FrameTimelineInfo& frameTimelineInfo,
+            const Vector<ComposerState>& state, const Vector<DisplayState>& displays,
+            uint32_t flags, const sp<IBinder>& applyToken, const InputWindowCommands& commands,
+            int64_t desiredPresentTime, bool isAutoTimestamp,
+            const std::vector<client_cache_t>& uncacheBuffers, bool hasListenerCallbacks,
+            const std::vector<ListenerCallbacks>& listenerCallbacks, uint64_t transactionId,
+            const std::vector<uint64_t>& mergedTransactionIds,
+            size_t* outTransactionIdPos = nullptr);
 };
 
 // ----------------------------------------------------------------------------
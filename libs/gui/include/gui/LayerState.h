@@ -140,6 +140,58 @@ public:
     status_t readFromParcel(const Parcel* parcel) override;
 };
 
+/*
+ * Declarative geometry animation advanced compositor-side. Instead of sending
+ * a transaction per animation frame, a client submits start and end values
+ * once and SurfaceFlinger's front end interpolates them on every committed
+ * frame until the duration elapses, with no further IPC.
+ */
+struct LayerAnimationSpec {
+    enum class Curve : int32_t {
+        Linear = 0,
+        // Smoothstep: slow start and end, matching the interpolators used for
+        // most window animations.
+        EaseInOut = 1,
+    };
+
+    // 0 starts the animation on the first frame it is latched.
+    nsecs_t startTimeNanos = 0;
+    nsecs_t durationNanos = 0;
+    Curve curve = Curve::Linear;
+
+    bool animatePosition = false;
+    float startX = 0;
+    float startY = 0;
+    float endX = 0;
+    float endY = 0;
+
+    bool animateAlpha = false;
+    float startAlpha = 1.f;
+    float endAlpha = 1.f;
+
+    bool animateCrop = false;
+    Rect startCrop{Rect::INVALID_RECT};
+    Rect endCrop{Rect::INVALID_RECT};
+
+    bool animatesSomething() const {
+        return durationNanos > 0 && (animatePosition || animateAlpha || animateCrop);
+    }
+
+    status_t write(Parcel& output) const;
+    status_t read(const Parcel& input);
+
+    inline bool operator==(const LayerAnimationSpec& other) const {
+        return std::tie(startTimeNanos, durationNanos, curve, animatePosition, startX, startY,
+                        endX, endY, animateAlpha, startAlpha, endAlpha, animateCrop, startCrop,
+                        endCrop) ==
+                std::tie(other.startTimeNanos, other.durationNanos, other.curve,
+                         other.animatePosition, other.startX, other.startY, other.endX, other.endY,
+                         other.animateAlpha, other.startAlpha, other.endAlpha, other.animateCrop,
+                         other.startCrop, other.endCrop);
+    }
+    inline bool operator!=(const LayerAnimationSpec& other) const { return !(*this == other); }
+};
+
 /*
  * Used to communicate layer information between SurfaceFlinger and its clients.
  */
@@ -222,6 +274,7 @@ struct layer_state_t {
         eExtendedRangeBrightnessChanged = 0x10000'00000000,
         eEdgeExtensionChanged = 0x20000'00000000,
         eBufferReleaseChannelChanged = 0x40000'00000000,
+        eAnimationChanged = 0x80000'00000000,
     };
 
     layer_state_t();
@@ -416,6 +469,9 @@ struct layer_state_t {
     TrustedPresentationListener trustedPresentationListener;
 
     std::shared_ptr<gui::BufferReleaseChannel::ProducerEndpoint> bufferReleaseChannel;
+
+    // Compositor-side geometry animation, see LayerAnimationSpec.
+    LayerAnimationSpec animationSpec;
 };
 
 class ComposerState {
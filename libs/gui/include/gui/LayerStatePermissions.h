@@ -22,7 +22,12 @@ class LayerStatePermissions {
 public:
     static uint32_t getTransactionPermissions(int pid, int uid);
 
+    // Pushes the cached evaluation for (pid, uid) out of the cache. Call this when the process
+    // behind an entry may change, e.g. when its connection goes away and the pid can be reused.
+    static void invalidateCache(int pid, int uid);
+
 private:
+    static uint32_t evaluateTransactionPermissions(int pid, int uid);
     static std::vector<std::pair<String16, int>> mPermissionMap;
 };
 } // namespace android
\ No newline at end of file
@@ -31,6 +31,8 @@
 #include <utils/Mutex.h>
 #include <utils/RefBase.h>
 
+#include <atomic>
+#include <functional>
 #include <shared_mutex>
 #include <unordered_set>
 
@@ -190,6 +192,18 @@ public:
      */
     virtual void allocateBuffers();
 
+    /* Warms up the buffer queue at window creation time without blocking the caller.
+     *
+     * Performs the same allocation as allocateBuffers(), but from a worker thread so the
+     * caller does not wait on the binder round trip and the serial gralloc allocations.
+     * Freshly allocated slots carry no pending release fence, so once the warm-up has
+     * completed the first dequeueBuffer returns without blocking on either.
+     *
+     * |onComplete| (may be nullptr) is invoked once from the worker thread when the
+     * allocation has finished.
+     */
+    void allocateBuffersAsync(std::function<void()> onComplete = nullptr);
+
 #if COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(WB_PLATFORM_API_IMPROVEMENTS)
     // See IGraphicBufferProducer::allowAllocation
     status_t allowAllocation(bool allowAllocation);
@@ -720,7 +734,8 @@ protected:
     mutable bool mFrameTimestampsSupportsPresent;
 
     // A cached copy of the FrameEventHistory maintained by the consumer.
-    bool mEnableFrameTimestamps = false;
+    // Atomic so getCompositorTiming can check it without taking mMutex.
+    std::atomic<bool> mEnableFrameTimestamps = false;
     std::unique_ptr<ProducerFrameEventHistory> mFrameEventHistory;
 
     // Reference to the SurfaceFlinger layer that was used to create this
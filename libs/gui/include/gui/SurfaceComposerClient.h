@@ -455,6 +455,7 @@ public:
         bool mAnimation = false;
         bool mEarlyWakeupStart = false;
         bool mEarlyWakeupEnd = false;
+        bool mUrgent = false;
 
         // Indicates that the Transaction may contain buffers that should be cached. The reason this
         // is only a guess is that buffers can be removed before cache is called. This is only a
@@ -515,6 +516,37 @@ public:
         std::vector<uint64_t> getMergedTransactionIds();
 
         status_t apply(bool synchronous = false, bool oneWay = false);
+
+        // Pre-validated, pre-flattened form of a transaction for clients that replay the same
+        // transaction many times. The validation and field-by-field flattening cost is paid
+        // once when the snapshot is created; each apply() re-sends the cached parcel, patching
+        // in a fresh transaction id. Snapshots cannot carry buffers or completion callbacks,
+        // since those need per-apply bookkeeping.
+        class Snapshot {
+        public:
+            Snapshot();
+            ~Snapshot();
+            Snapshot(Snapshot&&) noexcept;
+            Snapshot& operator=(Snapshot&&) noexcept;
+
+            // Sends the cached transaction state to SurfaceFlinger. May be called any number
+            // of times.
+            status_t apply();
+
+            bool isValid() const { return mParcel != nullptr; }
+
+        private:
+            friend class Transaction;
+            std::unique_ptr<Parcel> mParcel;
+            size_t mTransactionIdPos = 0;
+            bool mOneWay = false;
+        };
+
+        // Flattens the current state of this transaction into a reusable snapshot. Unlike
+        // apply(), this does not consume the transaction. Fails with BAD_VALUE if the
+        // transaction carries buffers or listener callbacks.
+        status_t createSnapshot(Snapshot* outSnapshot, bool oneWay = false);
+
         // Merge another transaction in to this one, clearing other
         // as if it had been applied.
         Transaction& merge(Transaction&& other);
@@ -549,6 +581,11 @@ public:
         Transaction& setMatrix(const sp<SurfaceControl>& sc,
                 float dsdx, float dtdx, float dtdy, float dsdy);
         Transaction& setCrop(const sp<SurfaceControl>& sc, const Rect& crop);
+        // Hands a declarative animation to SurfaceFlinger, which interpolates
+        // the spec's geometry compositor-side every frame until the duration
+        // elapses. Replaces any animation previously set on the surface; a
+        // spec with zero duration cancels it.
+        Transaction& setAnimationSpec(const sp<SurfaceControl>& sc, const LayerAnimationSpec& spec);
         Transaction& setCornerRadius(const sp<SurfaceControl>& sc, float cornerRadius);
         Transaction& setBackgroundBlurRadius(const sp<SurfaceControl>& sc,
                                              int backgroundBlurRadius);
@@ -790,6 +827,10 @@ public:
         void setAnimationTransaction();
         void setEarlyWakeupStart();
         void setEarlyWakeupEnd();
+        // Marks this transaction as latency critical, giving it the first chance to latch
+        // when SurfaceFlinger flushes its transaction queues. Requires the
+        // android.permission.WAKEUP_SURFACE_FLINGER permission.
+        void setUrgentTransaction();
 
         /**
          * Strip the transaction of all permissioned requests, required when
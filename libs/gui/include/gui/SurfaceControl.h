@@ -77,7 +77,7 @@ public:
     sp<Surface> getSurface();
     sp<Surface> createSurface();
     sp<IBinder> getHandle() const;
-    sp<IBinder> getLayerStateHandle() const;
+    const sp<IBinder>& getLayerStateHandle() const;
     int32_t getLayerId() const;
     const std::string& getName() const;
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <android-base/unique_fd.h>
 #include <binder/Parcelable.h>
 #include <utils/Errors.h>
@@ -39,8 +41,20 @@ public:
     static constexpr DefaultSizeType DefaultSize{};
     explicit BitTube(DefaultSizeType);
 
+    // creates a BitTube backed by a process-local ring buffer with eventfd
+    // signaling instead of a socket pair, for producers and consumers living in
+    // the same process. The receive fd stays pollable like the socket-backed
+    // variant, but messages never cross the kernel. In-process tubes cannot be
+    // parceled; hand the receive end to the consumer with moveReceiveEndTo().
+    struct InProcessSizeType {};
+    static constexpr InProcessSizeType InProcess{};
+    explicit BitTube(InProcessSizeType);
+
     explicit BitTube(const Parcel& data);
 
+    BitTube(BitTube&&) = default;
+    BitTube& operator=(BitTube&&) = default;
+
     virtual ~BitTube() = default;
 
     // check state after construction
@@ -61,6 +75,10 @@ public:
     // resets this BitTube's send file descriptor to sendFd
     void setSendFd(base::unique_fd&& sendFd);
 
+    // moves the receive end of this BitTube (and, for in-process tubes, the shared
+    // ring) into outTube; this BitTube keeps a duped send end for writing.
+    void moveReceiveEndTo(BitTube* outTube);
+
     // send objects (sized blobs). All objects are guaranteed to be written or the call fails.
     template <typename T>
     static ssize_t sendObjects(BitTube* tube, T const* events, size_t count) {
@@ -91,6 +109,10 @@ private:
     mutable base::unique_fd mSendFd;
     mutable base::unique_fd mReceiveFd;
 
+    // only set for in-process tubes; shared between the send and receive ends
+    class InProcessRing;
+    std::shared_ptr<InProcessRing> mRing;
+
     static ssize_t sendObjects(BitTube* tube, void const* events, size_t count, size_t objSize);
 
     static ssize_t recvObjects(BitTube* tube, void* events, size_t count, size_t objSize);
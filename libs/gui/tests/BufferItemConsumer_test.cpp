@@ -236,6 +236,32 @@ TEST_F(BufferItemConsumerTest, DetachBufferWithBuffer) {
     EXPECT_EQ(OK, mBIC->detachBuffer(buffer));
     EXPECT_THAT(mDetachedBufferSlots, testing::ElementsAre(slot));
 }
+
+// Test that a burst of queued buffers can be drained with a single call.
+TEST_F(BufferItemConsumerTest, AcquireBuffersDrainsBurst) {
+    int slot1;
+    int slot2;
+    DequeueBuffer(&slot1);
+    DequeueBuffer(&slot2);
+    QueueBuffer(slot1);
+    QueueBuffer(slot2);
+
+    std::vector<BufferItem> items;
+    ASSERT_EQ(NO_ERROR,
+              mBIC->acquireBuffers(&items, 0, /*maxBuffers=*/kMaxLockedBuffers,
+                                   /*waitForFence=*/false));
+    ASSERT_EQ(2u, items.size());
+
+    // The queue is now drained.
+    std::vector<BufferItem> rest;
+    EXPECT_EQ(BufferItemConsumer::NO_BUFFER_AVAILABLE,
+              mBIC->acquireBuffers(&rest, 0, kMaxLockedBuffers, /*waitForFence=*/false));
+    EXPECT_TRUE(rest.empty());
+
+    for (const auto& item : items) {
+        EXPECT_EQ(NO_ERROR, mBIC->releaseBuffer(item, Fence::NO_FENCE));
+    }
+}
 #endif // COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(WB_PLATFORM_API_IMPROVEMENTS)
 
 }  // namespace android
@@ -135,4 +135,41 @@ TEST(BufferReleaseChannelTest, ProduceAndConsume) {
     }
 }
 
+// Verify that a batched write packs multiple messages per datagram and that the consumer returns
+// them in order, including batches that span multiple datagrams.
+TEST(BufferReleaseChannelTest, BatchedProduceAndConsume) {
+    std::unique_ptr<BufferReleaseChannel::ConsumerEndpoint> consumer;
+    std::shared_ptr<BufferReleaseChannel::ProducerEndpoint> producer;
+    ASSERT_EQ(OK, BufferReleaseChannel::open("test-channel"s, consumer, producer));
+
+    sp<Fence> fence = sp<Fence>::make(memfd_create("fake-fence-fd", 0));
+
+    std::vector<BufferReleaseChannel::Message> messages;
+    for (uint64_t i = 0; i < 2 * BufferReleaseChannel::MAX_MESSAGES_PER_DATAGRAM + 3; i++) {
+        messages.emplace_back(ReleaseCallbackId{i, i + 1}, fence, static_cast<uint32_t>(i + 2));
+    }
+    ASSERT_EQ(OK, producer->writeReleaseFences(messages));
+
+    for (uint64_t i = 0; i < messages.size(); i++) {
+        ReleaseCallbackId expectedId{i, i + 1};
+        uint32_t expectedMaxAcquiredBufferCount = i + 2;
+
+        ReleaseCallbackId consumerId;
+        sp<Fence> consumerFence;
+        uint32_t maxAcquiredBufferCount;
+        ASSERT_EQ(OK,
+                  consumer->readReleaseFence(consumerId, consumerFence, maxAcquiredBufferCount));
+
+        ASSERT_EQ(expectedId, consumerId);
+        ASSERT_TRUE(is_same_file(fence->get(), consumerFence->get()));
+        ASSERT_EQ(expectedMaxAcquiredBufferCount, maxAcquiredBufferCount);
+    }
+
+    ReleaseCallbackId consumerId;
+    sp<Fence> consumerFence;
+    uint32_t maxAcquiredBufferCount;
+    ASSERT_EQ(WOULD_BLOCK,
+              consumer->readReleaseFence(consumerId, consumerFence, maxAcquiredBufferCount));
+}
+
 } // namespace android
\ No newline at end of file
@@ -368,6 +368,25 @@ TEST_F(SurfaceTest, GetConsumerName) {
     EXPECT_STREQ("TestConsumer", surface->getConsumerName().c_str());
 }
 
+TEST_F(SurfaceTest, AllocateBuffersAsyncSignalsCompletion) {
+    sp<IGraphicBufferProducer> producer;
+    sp<IGraphicBufferConsumer> consumer;
+    BufferQueue::createBufferQueue(&producer, &consumer);
+
+    sp<MockConsumer> mockConsumer(new MockConsumer);
+    consumer->consumerConnect(mockConsumer, false);
+    consumer->setConsumerName(String8("TestConsumer"));
+
+    sp<Surface> surface = new Surface(producer);
+    sp<ANativeWindow> window(surface);
+    native_window_api_connect(window.get(), NATIVE_WINDOW_API_CPU);
+
+    std::promise<void> allocated;
+    surface->allocateBuffersAsync([&allocated]() { allocated.set_value(); });
+    ASSERT_EQ(std::future_status::ready,
+              allocated.get_future().wait_for(std::chrono::seconds(5)));
+}
+
 TEST_F(SurfaceTest, GetWideColorSupport) {
     sp<IGraphicBufferProducer> producer;
     sp<IGraphicBufferConsumer> consumer;
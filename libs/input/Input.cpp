@@ -730,6 +730,21 @@ float MotionEvent::getHistoricalAxisValue(int32_t axis, size_t pointerIndex,
     return calculateTransformedAxisValue(axis, mSource, mFlags, mTransform, coords);
 }
 
+void MotionEvent::getHistoricalAxisValues(int32_t axis, size_t pointerIndex,
+                                          std::vector<float>& outValues) const {
+    const size_t pointerCount = getPointerCount();
+    if (CC_UNLIKELY(pointerIndex < 0 || pointerIndex >= pointerCount)) {
+        LOG(FATAL) << __func__ << ": Invalid pointer index " << pointerIndex << " for " << *this;
+    }
+    const size_t sampleCount = getHistorySize() + 1;
+    outValues.clear();
+    outValues.reserve(sampleCount);
+    for (size_t h = 0; h < sampleCount; h++) {
+        const PointerCoords& coords = mSamplePointerCoords[h * pointerCount + pointerIndex];
+        outValues.push_back(calculateTransformedAxisValue(axis, mSource, mFlags, mTransform, coords));
+    }
+}
+
 ssize_t MotionEvent::findPointerIndex(int32_t pointerId) const {
     size_t pointerCount = mPointerProperties.size();
     for (size_t i = 0; i < pointerCount; i++) {
@@ -17,6 +17,7 @@
 #define LOG_TAG "InputConsumerNoResampling"
 #define ATRACE_TAG ATRACE_TAG_INPUT
 
+#include <array>
 #include <chrono>
 
 #include <inttypes.h>
@@ -78,13 +79,15 @@ std::unique_ptr<DragEvent> createDragEvent(const InputMessage& msg) {
 std::unique_ptr<MotionEvent> createMotionEvent(const InputMessage& msg) {
     std::unique_ptr<MotionEvent> event = std::make_unique<MotionEvent>();
     const uint32_t pointerCount = msg.body.motion.pointerCount;
-    std::vector<PointerProperties> pointerProperties;
-    pointerProperties.reserve(pointerCount);
-    std::vector<PointerCoords> pointerCoords;
-    pointerCoords.reserve(pointerCount);
+    // The message layout interleaves properties and coords per pointer, but
+    // MotionEvent::initialize wants separate arrays. The channel guarantees
+    // pointerCount <= MAX_POINTERS, so de-interleave on the stack rather than
+    // paying for two heap allocations per received message.
+    std::array<PointerProperties, MAX_POINTERS> pointerProperties;
+    std::array<PointerCoords, MAX_POINTERS> pointerCoords;
     for (uint32_t i = 0; i < pointerCount; i++) {
-        pointerProperties.push_back(msg.body.motion.pointers[i].properties);
-        pointerCoords.push_back(msg.body.motion.pointers[i].coords);
+        pointerProperties[i] = msg.body.motion.pointers[i].properties;
+        pointerCoords[i] = msg.body.motion.pointers[i].coords;
     }
 
     ui::Transform transform;
@@ -108,10 +111,10 @@ std::unique_ptr<MotionEvent> createMotionEvent(const InputMessage& msg) {
 
 void addSample(MotionEvent& event, const InputMessage& msg) {
     uint32_t pointerCount = msg.body.motion.pointerCount;
-    std::vector<PointerCoords> pointerCoords;
-    pointerCoords.reserve(pointerCount);
+    // As in createMotionEvent, gather the coords on the stack.
+    std::array<PointerCoords, MAX_POINTERS> pointerCoords;
     for (uint32_t i = 0; i < pointerCount; i++) {
-        pointerCoords.push_back(msg.body.motion.pointers[i].coords);
+        pointerCoords[i] = msg.body.motion.pointers[i].coords;
     }
 
     // TODO(b/329770983): figure out if it's safe to combine events with mismatching metaState
@@ -8,6 +8,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <algorithm>
 #include <inttypes.h>
 #include <math.h>
 #include <poll.h>
@@ -94,6 +95,13 @@ android::base::unique_fd dupChannelFd(int fd) {
 // behind processing touches.
 constexpr size_t SOCKET_BUFFER_SIZE = 32 * 1024;
 
+// Bounds for adaptive send buffer sizing in InputPublisher. The buffer doubles whenever the
+// channel fills up, so a fast-producing device against a slow app stops bouncing off EAGAIN,
+// and decays back toward SOCKET_BUFFER_SIZE once the consumer has kept up for a while so idle
+// connections do not pin kernel memory. Note that AF_UNIX sockets only honor SO_SNDBUF.
+constexpr size_t MAX_SOCKET_BUFFER_SIZE = 256 * 1024;
+constexpr nsecs_t SOCKET_BUFFER_SHRINK_TIMEOUT = seconds_to_nanoseconds(5);
+
 /**
  * Crash if the events that are getting sent to the InputPublisher are inconsistent.
  * Enable this via "adb shell setprop log.tag.InputTransportVerifyEvents DEBUG"
@@ -523,11 +531,59 @@ sp<IBinder> InputChannel::getConnectionToken() const {
 // --- InputPublisher ---
 
 InputPublisher::InputPublisher(const std::shared_ptr<InputChannel>& channel)
-      : mChannel(channel), mInputVerifier(mChannel->getName()) {}
+      : mChannel(channel),
+        mInputVerifier(mChannel->getName()),
+        mSendBufferSize(SOCKET_BUFFER_SIZE) {}
 
 InputPublisher::~InputPublisher() {
 }
 
+status_t InputPublisher::sendMessage(const InputMessage& msg) {
+    status_t result = mChannel->sendMessage(&msg);
+    if (result == WOULD_BLOCK) {
+        // Stamp on the blocked send itself, not just on final failure, so a grown buffer is
+        // only shrunk once the consumer has genuinely kept up for the full quiet period.
+        mLastWouldBlockTime = systemTime(SYSTEM_TIME_MONOTONIC);
+    }
+    while (result == WOULD_BLOCK && mSendBufferSize < MAX_SOCKET_BUFFER_SIZE) {
+        // The consumer is falling behind. Grow the send buffer and retry before handing the
+        // event back to the dispatcher's wait-queue machinery.
+        int bufferSize = static_cast<int>(std::min(mSendBufferSize * 2, MAX_SOCKET_BUFFER_SIZE));
+        if (setsockopt(mChannel->getFd(), SOL_SOCKET, SO_SNDBUF, &bufferSize,
+                       sizeof(bufferSize))) {
+            ALOGW("channel '%s' publisher ~ Could not grow send buffer to %d bytes.  errno=%d",
+                  mChannel->getName().c_str(), bufferSize, errno);
+            break;
+        }
+        mSendBufferSize = static_cast<size_t>(bufferSize);
+        mSendBufferGrowCount++;
+        ALOGD_IF(debugTransportPublisher(), "channel '%s' publisher ~ grew send buffer to %zu",
+                 mChannel->getName().c_str(), mSendBufferSize);
+        result = mChannel->sendMessage(&msg);
+    }
+    return result;
+}
+
+void InputPublisher::shrinkSendBufferIfIdle() {
+    if (mSendBufferSize <= SOCKET_BUFFER_SIZE) {
+        return;
+    }
+    const nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
+    if (now - mLastWouldBlockTime < SOCKET_BUFFER_SHRINK_TIMEOUT) {
+        return;
+    }
+    const int bufferSize = static_cast<int>(std::max(mSendBufferSize / 2, SOCKET_BUFFER_SIZE));
+    if (setsockopt(mChannel->getFd(), SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize))) {
+        return;
+    }
+    mSendBufferSize = static_cast<size_t>(bufferSize);
+    // Halve at most once per quiet period so a burst right after a shrink can still grow back
+    // cheaply.
+    mLastWouldBlockTime = now;
+    ALOGD_IF(debugTransportPublisher(), "channel '%s' publisher ~ shrank send buffer to %zu",
+             mChannel->getName().c_str(), mSendBufferSize);
+}
+
 status_t InputPublisher::publishKeyEvent(uint32_t seq, int32_t eventId, int32_t deviceId,
                                          int32_t source, ui::LogicalDisplayId displayId,
                                          std::array<uint8_t, 32> hmac, int32_t action,
@@ -567,7 +623,7 @@ status_t InputPublisher::publishKeyEvent(uint32_t seq, int32_t eventId, int32_t
     msg.body.key.repeatCount = repeatCount;
     msg.body.key.downTime = downTime;
     msg.body.key.eventTime = eventTime;
-    return mChannel->sendMessage(&msg);
+    return sendMessage(msg);
 }
 
 status_t InputPublisher::publishMotionEvent(
@@ -658,7 +714,7 @@ status_t InputPublisher::publishMotionEvent(
         msg.body.motion.pointers[i].coords = pointerCoords[i];
     }
 
-    return mChannel->sendMessage(&msg);
+    return sendMessage(msg);
 }
 
 status_t InputPublisher::publishFocusEvent(uint32_t seq, int32_t eventId, bool hasFocus) {
@@ -673,7 +729,7 @@ status_t InputPublisher::publishFocusEvent(uint32_t seq, int32_t eventId, bool h
     msg.header.seq = seq;
     msg.body.focus.eventId = eventId;
     msg.body.focus.hasFocus = hasFocus;
-    return mChannel->sendMessage(&msg);
+    return sendMessage(msg);
 }
 
 status_t InputPublisher::publishCaptureEvent(uint32_t seq, int32_t eventId,
@@ -690,7 +746,7 @@ status_t InputPublisher::publishCaptureEvent(uint32_t seq, int32_t eventId,
     msg.header.seq = seq;
     msg.body.capture.eventId = eventId;
     msg.body.capture.pointerCaptureEnabled = pointerCaptureEnabled;
-    return mChannel->sendMessage(&msg);
+    return sendMessage(msg);
 }
 
 status_t InputPublisher::publishDragEvent(uint32_t seq, int32_t eventId, float x, float y,
@@ -709,7 +765,7 @@ status_t InputPublisher::publishDragEvent(uint32_t seq, int32_t eventId, float x
     msg.body.drag.isExiting = isExiting;
     msg.body.drag.x = x;
     msg.body.drag.y = y;
-    return mChannel->sendMessage(&msg);
+    return sendMessage(msg);
 }
 
 status_t InputPublisher::publishTouchModeEvent(uint32_t seq, int32_t eventId, bool isInTouchMode) {
@@ -725,7 +781,7 @@ status_t InputPublisher::publishTouchModeEvent(uint32_t seq, int32_t eventId, bo
     msg.header.seq = seq;
     msg.body.touchMode.eventId = eventId;
     msg.body.touchMode.isInTouchMode = isInTouchMode;
-    return mChannel->sendMessage(&msg);
+    return sendMessage(msg);
 }
 
 android::base::Result<InputPublisher::ConsumerResponse> InputPublisher::receiveConsumerResponse() {
@@ -744,6 +800,7 @@ android::base::Result<InputPublisher::ConsumerResponse> InputPublisher::receiveC
                  "channel '%s' publisher ~ %s: finished: seq=%u, handled=%s",
                  mChannel->getName().c_str(), __func__, msg.header.seq,
                  toString(msg.body.finished.handled));
+        shrinkSendBufferIfIdle();
         return Finished{
                 .seq = msg.header.seq,
                 .handled = msg.body.finished.handled,
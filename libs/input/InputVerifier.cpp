@@ -16,6 +16,8 @@
 
 #define LOG_TAG "InputVerifier"
 
+#include <array>
+
 #include <android-base/logging.h>
 #include <input/InputVerifier.h>
 #include "input_cxx_bridge.rs.h"
@@ -37,11 +39,16 @@ Result<void> InputVerifier::processMovement(DeviceId deviceId, int32_t source, i
                                             uint32_t pointerCount,
                                             const PointerProperties* pointerProperties,
                                             const PointerCoords* pointerCoords, int32_t flags) {
-    std::vector<RustPointerProperties> rpp;
+    // Marshal the pointer ids into a stack buffer. This runs for every motion event on verified
+    // streams, so avoid a heap allocation per call.
+    std::array<RustPointerProperties, MAX_POINTERS> rpp;
+    if (pointerCount > rpp.size()) {
+        return Error() << "Too many pointers: " << pointerCount;
+    }
     for (size_t i = 0; i < pointerCount; i++) {
-        rpp.emplace_back(RustPointerProperties{.id = pointerProperties[i].id});
+        rpp[i] = RustPointerProperties{.id = pointerProperties[i].id};
     }
-    rust::Slice<const RustPointerProperties> properties{rpp.data(), rpp.size()};
+    rust::Slice<const RustPointerProperties> properties{rpp.data(), pointerCount};
     rust::String errorMessage =
             android::input::verifier::process_movement(*mVerifier, deviceId, source, action,
                                                        properties, static_cast<uint32_t>(flags));
@@ -18,6 +18,12 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
 
 #include <android/keycodes.h>
 #include <attestation/HmacKeyManager.h>
@@ -82,10 +88,47 @@ static String8 toString(const char16_t* chars, size_t numChars) {
 
 // --- KeyCharacterMap ---
 
+namespace {
+
+// Pristine parsed maps, keyed by (path, format, mtime, size). Most devices on
+// a system share a handful of .kcm files (usually Generic.kcm), so each file
+// is tokenized at most once per process and subsequent device attaches get a
+// cheap copy of the parsed tables. The file's mtime and size are part of the
+// key so a .kcm pushed during development is reparsed rather than served
+// stale.
+using LoadedMapKey = std::tuple<std::string, KeyCharacterMap::Format, nsecs_t, off_t>;
+std::mutex gLoadedMapsLock;
+std::map<LoadedMapKey, std::shared_ptr<const KeyCharacterMap>>& getLoadedMapsLocked() {
+    static auto& maps = *new std::map<LoadedMapKey, std::shared_ptr<const KeyCharacterMap>>();
+    return maps;
+}
+
+std::optional<LoadedMapKey> makeLoadedMapKey(const std::string& filename,
+                                             KeyCharacterMap::Format format) {
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) {
+        return std::nullopt;
+    }
+    return LoadedMapKey{filename, format, nsecs_t(st.st_mtime), st.st_size};
+}
+
+} // namespace
+
 KeyCharacterMap::KeyCharacterMap(const std::string& filename) : mLoadFileName(filename) {}
 
 base::Result<std::shared_ptr<KeyCharacterMap>> KeyCharacterMap::load(const std::string& filename,
                                                                      Format format) {
+    const std::optional<LoadedMapKey> cacheKey = makeLoadedMapKey(filename, format);
+    if (cacheKey) {
+        std::lock_guard _l(gLoadedMapsLock);
+        auto& loadedMaps = getLoadedMapsLocked();
+        auto it = loadedMaps.find(*cacheKey);
+        if (it != loadedMaps.end()) {
+            // Return a copy: callers mutate their maps (key remapping, layout
+            // overlays), so the cached instance must stay pristine.
+            return std::make_shared<KeyCharacterMap>(*it->second);
+        }
+    }
     Tokenizer* tokenizer;
     status_t status = Tokenizer::open(String8(filename.c_str()), &tokenizer);
     if (status) {
@@ -100,6 +143,10 @@ base::Result<std::shared_ptr<KeyCharacterMap>> KeyCharacterMap::load(const std::
     std::unique_ptr<Tokenizer> t(tokenizer);
     status = map->load(t.get(), format);
     if (status == OK) {
+        if (cacheKey) {
+            std::lock_guard _l(gLoadedMapsLock);
+            getLoadedMapsLocked().emplace(*cacheKey, std::make_shared<const KeyCharacterMap>(*map));
+        }
         return map;
     }
     return Errorf("Load KeyCharacterMap failed {}.", status);
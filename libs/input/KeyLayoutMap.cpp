@@ -30,7 +30,10 @@
 #include <vintf/KernelConfigs.h>
 #endif
 
+#include <sys/stat.h>
+
 #include <cstdlib>
+#include <mutex>
 #include <string_view>
 #include <unordered_map>
 
@@ -125,6 +128,19 @@ bool kernelConfigsArePresent(const std::set<std::string>& configs) {
 #endif
 }
 
+// Process-wide cache of parsed layouts, keyed by file path and invalidated when the
+// file's modification time or size changes. The same layout file (e.g. Generic.kl) is
+// loaded for many devices, and again on every device hotplug and configuration change;
+// KeyLayoutMap is immutable after load, so instances can be freely shared.
+struct CachedLayout {
+    std::shared_ptr<KeyLayoutMap> map;
+    time_t mtime;
+    off_t size;
+};
+
+std::mutex gCachedLayoutsLock;
+std::unordered_map<std::string, CachedLayout> gCachedLayouts;
+
 } // namespace
 
 KeyLayoutMap::KeyLayoutMap() = default;
@@ -137,6 +153,17 @@ base::Result<std::shared_ptr<KeyLayoutMap>> KeyLayoutMap::loadContents(const std
 
 base::Result<std::shared_ptr<KeyLayoutMap>> KeyLayoutMap::load(const std::string& filename,
                                                                const char* contents) {
+    struct stat fileStat{};
+    const bool cacheable = contents == nullptr && stat(filename.c_str(), &fileStat) == 0;
+    if (cacheable) {
+        std::lock_guard lock(gCachedLayoutsLock);
+        const auto it = gCachedLayouts.find(filename);
+        if (it != gCachedLayouts.end() && it->second.mtime == fileStat.st_mtime &&
+            it->second.size == fileStat.st_size) {
+            return it->second.map;
+        }
+    }
+
     Tokenizer* tokenizer;
     status_t status;
     if (contents == nullptr) {
@@ -160,6 +187,10 @@ base::Result<std::shared_ptr<KeyLayoutMap>> KeyLayoutMap::load(const std::string
         return Errorf("Missing kernel config");
     }
     map->mLoadFileName = filename;
+    if (cacheable) {
+        std::lock_guard lock(gCachedLayoutsLock);
+        gCachedLayouts[filename] = CachedLayout{map, fileStat.st_mtime, fileStat.st_size};
+    }
     return ret;
 }
 
@@ -46,7 +46,7 @@ void PropertyMap::addProperty(const std::string& key, const std::string& value)
     mProperties.emplace(key, value);
 }
 
-std::unordered_set<std::string> PropertyMap::getKeysWithPrefix(const std::string& prefix) const {
+std::unordered_set<std::string> PropertyMap::getKeysWithPrefix(std::string_view prefix) const {
     std::unordered_set<std::string> keys;
     for (const auto& [key, _] : mProperties) {
         if (key.starts_with(prefix)) {
@@ -56,21 +56,21 @@ std::unordered_set<std::string> PropertyMap::getKeysWithPrefix(const std::string
     return keys;
 }
 
-bool PropertyMap::hasProperty(const std::string& key) const {
+bool PropertyMap::hasProperty(std::string_view key) const {
     return mProperties.find(key) != mProperties.end();
 }
 
-std::optional<std::string> PropertyMap::getString(const std::string& key) const {
+std::optional<std::string> PropertyMap::getString(std::string_view key) const {
     auto it = mProperties.find(key);
     return it != mProperties.end() ? std::make_optional(it->second) : std::nullopt;
 }
 
-std::optional<bool> PropertyMap::getBool(const std::string& key) const {
+std::optional<bool> PropertyMap::getBool(std::string_view key) const {
     std::optional<int32_t> intValue = getInt(key);
     return intValue.has_value() ? std::make_optional(*intValue != 0) : std::nullopt;
 }
 
-std::optional<int32_t> PropertyMap::getInt(const std::string& key) const {
+std::optional<int32_t> PropertyMap::getInt(std::string_view key) const {
     std::optional<std::string> stringValue = getString(key);
     if (!stringValue.has_value() || stringValue->length() == 0) {
         return std::nullopt;
@@ -79,14 +79,14 @@ std::optional<int32_t> PropertyMap::getInt(const std::string& key) const {
     char* end;
     int32_t value = static_cast<int32_t>(strtol(stringValue->c_str(), &end, 10));
     if (*end != '\0') {
-        ALOGW("Property key '%s' has invalid value '%s'.  Expected an integer.", key.c_str(),
-              stringValue->c_str());
+        ALOGW("Property key '%.*s' has invalid value '%s'.  Expected an integer.",
+              static_cast<int>(key.size()), key.data(), stringValue->c_str());
         return std::nullopt;
     }
     return value;
 }
 
-std::optional<float> PropertyMap::getFloat(const std::string& key) const {
+std::optional<float> PropertyMap::getFloat(std::string_view key) const {
     std::optional<std::string> stringValue = getString(key);
     if (!stringValue.has_value() || stringValue->length() == 0) {
         return std::nullopt;
@@ -95,14 +95,14 @@ std::optional<float> PropertyMap::getFloat(const std::string& key) const {
     char* end;
     float value = strtof(stringValue->c_str(), &end);
     if (*end != '\0') {
-        ALOGW("Property key '%s' has invalid value '%s'.  Expected a float.", key.c_str(),
-              stringValue->c_str());
+        ALOGW("Property key '%.*s' has invalid value '%s'.  Expected a float.",
+              static_cast<int>(key.size()), key.data(), stringValue->c_str());
         return std::nullopt;
     }
     return value;
 }
 
-std::optional<double> PropertyMap::getDouble(const std::string& key) const {
+std::optional<double> PropertyMap::getDouble(std::string_view key) const {
     std::optional<std::string> stringValue = getString(key);
     if (!stringValue.has_value() || stringValue->length() == 0) {
         return std::nullopt;
@@ -111,8 +111,8 @@ std::optional<double> PropertyMap::getDouble(const std::string& key) const {
     char* end;
     double value = strtod(stringValue->c_str(), &end);
     if (*end != '\0') {
-        ALOGW("Property key '%s' has invalid value '%s'.  Expected a double.", key.c_str(),
-              stringValue->c_str());
+        ALOGW("Property key '%.*s' has invalid value '%s'.  Expected a double.",
+              static_cast<int>(key.size()), key.data(), stringValue->c_str());
         return std::nullopt;
     }
     return value;
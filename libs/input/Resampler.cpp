@@ -84,6 +84,7 @@ void LegacyResampler::updateLatestSamples(const MotionEvent& motionEvent) {
     for (size_t sampleIndex = secondToLatestIndex; sampleIndex < numSamples; ++sampleIndex) {
         std::vector<Pointer> pointers;
         const size_t numPointers = motionEvent.getPointerCount();
+        pointers.reserve(numPointers);
         for (size_t pointerIndex = 0; pointerIndex < numPointers; ++pointerIndex) {
             // getSamplePointerCoords is the vector representation of a getHistorySize by
             // getPointerCount matrix.
@@ -99,6 +100,7 @@ void LegacyResampler::updateLatestSamples(const MotionEvent& motionEvent) {
 
 LegacyResampler::Sample LegacyResampler::messageToSample(const InputMessage& message) {
     std::vector<Pointer> pointers;
+    pointers.reserve(message.body.motion.pointerCount);
     for (uint32_t i = 0; i < message.body.motion.pointerCount; ++i) {
         pointers.push_back(Pointer{message.body.motion.pointers[i].properties,
                                    message.body.motion.pointers[i].coords});
@@ -106,6 +108,24 @@ LegacyResampler::Sample LegacyResampler::messageToSample(const InputMessage& mes
     return Sample{nanoseconds{message.body.motion.eventTime}, pointers};
 }
 
+bool LegacyResampler::pointerResampleable(const PointerProperties& target,
+                                          const PointerProperties& auxiliary) {
+    if (target.id != auxiliary.id) {
+        LOG_IF(INFO, debugResampling()) << "Not resampled. Pointer ID mismatch.";
+        return false;
+    }
+    if (target.toolType != auxiliary.toolType) {
+        LOG_IF(INFO, debugResampling()) << "Not resampled. Pointer ToolType mismatch.";
+        return false;
+    }
+    if (!canResampleTool(target.toolType)) {
+        LOG_IF(INFO, debugResampling()) << "Not resampled. Cannot resample "
+                                        << ftl::enum_string(target.toolType) << " ToolType.";
+        return false;
+    }
+    return true;
+}
+
 bool LegacyResampler::pointerPropertiesResampleable(const Sample& target, const Sample& auxiliary) {
     if (target.pointers.size() > auxiliary.pointers.size()) {
         LOG_IF(INFO, debugResampling())
@@ -113,18 +133,23 @@ bool LegacyResampler::pointerPropertiesResampleable(const Sample& target, const
         return false;
     }
     for (size_t i = 0; i < target.pointers.size(); ++i) {
-        if (target.pointers[i].properties.id != auxiliary.pointers[i].properties.id) {
-            LOG_IF(INFO, debugResampling()) << "Not resampled. Pointer ID mismatch.";
-            return false;
-        }
-        if (target.pointers[i].properties.toolType != auxiliary.pointers[i].properties.toolType) {
-            LOG_IF(INFO, debugResampling()) << "Not resampled. Pointer ToolType mismatch.";
+        if (!pointerResampleable(target.pointers[i].properties, auxiliary.pointers[i].properties)) {
             return false;
         }
-        if (!canResampleTool(target.pointers[i].properties.toolType)) {
-            LOG_IF(INFO, debugResampling())
-                    << "Not resampled. Cannot resample "
-                    << ftl::enum_string(target.pointers[i].properties.toolType) << " ToolType.";
+    }
+    return true;
+}
+
+bool LegacyResampler::pointerPropertiesResampleable(const Sample& target,
+                                                    const InputMessage& auxiliary) {
+    if (target.pointers.size() > auxiliary.body.motion.pointerCount) {
+        LOG_IF(INFO, debugResampling())
+                << "Not resampled. Auxiliary sample has fewer pointers than target sample.";
+        return false;
+    }
+    for (size_t i = 0; i < target.pointers.size(); ++i) {
+        if (!pointerResampleable(target.pointers[i].properties,
+                                 auxiliary.body.motion.pointers[i].properties)) {
             return false;
         }
     }
@@ -136,13 +161,14 @@ bool LegacyResampler::canInterpolate(const InputMessage& message) const {
             << "Not resampled. mLatestSamples must not be empty to interpolate.";
 
     const Sample& pastSample = *(mLatestSamples.end() - 1);
-    const Sample& futureSample = messageToSample(message);
 
-    if (!pointerPropertiesResampleable(pastSample, futureSample)) {
+    // Compare against the message directly rather than converting it to a Sample, which would
+    // heap-allocate a pointer vector for every incoming event.
+    if (!pointerPropertiesResampleable(pastSample, message)) {
         return false;
     }
 
-    const nanoseconds delta = futureSample.eventTime - pastSample.eventTime;
+    const nanoseconds delta = nanoseconds{message.body.motion.eventTime} - pastSample.eventTime;
     if (delta < RESAMPLE_MIN_DELTA) {
         LOG_IF(INFO, debugResampling()) << "Not resampled. Delta is too small: " << delta << "ns.";
         return false;
@@ -166,6 +192,7 @@ std::optional<LegacyResampler::Sample> LegacyResampler::attemptInterpolation(
             std::chrono::duration<float, std::milli>(resampleTime - pastSample.eventTime) / delta;
 
     std::vector<Pointer> resampledPointers;
+    resampledPointers.reserve(pastSample.pointers.size());
     for (size_t i = 0; i < pastSample.pointers.size(); ++i) {
         const PointerCoords& resampledCoords =
                 calculateResampledCoords(pastSample.pointers[i].coords,
@@ -226,6 +253,7 @@ std::optional<LegacyResampler::Sample> LegacyResampler::attemptExtrapolation(
             delta;
 
     std::vector<Pointer> resampledPointers;
+    resampledPointers.reserve(presentSample.pointers.size());
     for (size_t i = 0; i < presentSample.pointers.size(); ++i) {
         const PointerCoords& resampledCoords =
                 calculateResampledCoords(pastSample.pointers[i].coords,
@@ -342,16 +342,18 @@ void VelocityTracker::addMovement(const MotionEvent& event) {
     }
 
     const size_t historySize = event.getHistorySize();
-    for (size_t h = 0; h <= historySize; h++) {
-        const nsecs_t eventTime = event.getHistoricalEventTime(h);
-        for (size_t i = 0; i < event.getPointerCount(); i++) {
-            if (event.isResampled(i, h)) {
-                continue; // skip resampled samples
-            }
-            const int32_t pointerId = event.getPointerId(i);
-            for (int32_t axis : axesToProcess) {
-                const float position = event.getHistoricalAxisValue(axis, i, h);
-                addMovement(eventTime, pointerId, axis, position);
+    std::vector<float> positions;
+    for (size_t i = 0; i < event.getPointerCount(); i++) {
+        const int32_t pointerId = event.getPointerId(i);
+        for (int32_t axis : axesToProcess) {
+            // The (pointer, axis) streams are independent, so we can process each one across
+            // all samples in one pass and extract the axis in bulk.
+            event.getHistoricalAxisValues(axis, i, positions);
+            for (size_t h = 0; h <= historySize; h++) {
+                if (event.isResampled(i, h)) {
+                    continue; // skip resampled samples
+                }
+                addMovement(event.getHistoricalEventTime(h), pointerId, axis, positions[h]);
             }
         }
     }
@@ -479,15 +481,11 @@ LeastSquaresVelocityTrackerStrategy::~LeastSquaresVelocityTrackerStrategy() {}
  * http://en.wikipedia.org/wiki/Numerical_methods_for_linear_least_squares
  * http://en.wikipedia.org/wiki/Gram-Schmidt
  */
-static std::optional<float> solveLeastSquares(const std::vector<float>& x,
-                                              const std::vector<float>& y,
-                                              const std::vector<float>& w, uint32_t n) {
-    const size_t m = x.size();
-
+static std::optional<float> solveLeastSquares(const float* x, const float* y, const float* w,
+                                              size_t m, uint32_t n) {
     ALOGD_IF(DEBUG_STRATEGY, "solveLeastSquares: m=%d, n=%d, x=%s, y=%s, w=%s", int(m), int(n),
-             vectorToString(x).c_str(), vectorToString(y).c_str(), vectorToString(w).c_str());
-
-    LOG_ALWAYS_FATAL_IF(m != y.size() || m != w.size(), "Mismatched vector sizes");
+             vectorToString(x, m).c_str(), vectorToString(y, m).c_str(),
+             vectorToString(w, m).c_str());
 
     // Expand the X vector to a matrix A, pre-multiplied by the weights.
     float a[n][m]; // column-major order
@@ -671,22 +669,26 @@ std::optional<float> LeastSquaresVelocityTrackerStrategy::getVelocity(int32_t po
         return solveUnweightedLeastSquaresDeg2(movements);
     }
 
-    // Iterate over movement samples in reverse time order and collect samples.
-    std::vector<float> positions;
-    std::vector<float> w;
-    std::vector<float> time;
+    // Iterate over movement samples in reverse time order and collect samples. The window is
+    // bounded by HISTORY_SIZE, so gather into stack buffers instead of allocating vectors for
+    // every velocity query.
+    std::array<float, HISTORY_SIZE> positions;
+    std::array<float, HISTORY_SIZE> w;
+    std::array<float, HISTORY_SIZE> time;
+    size_t m = 0;
 
     const Movement& newestMovement = movements[size - 1];
     for (ssize_t i = size - 1; i >= 0; i--) {
         const Movement& movement = movements[i];
         nsecs_t age = newestMovement.eventTime - movement.eventTime;
-        positions.push_back(movement.position);
-        w.push_back(chooseWeight(pointerId, i));
-        time.push_back(-age * 0.000000001f);
+        positions[m] = movement.position;
+        w[m] = chooseWeight(pointerId, i);
+        time[m] = -age * 0.000000001f;
+        m++;
     }
 
     // General case for an Nth degree polynomial fit
-    return solveLeastSquares(time, positions, w, degree + 1);
+    return solveLeastSquares(time.data(), positions.data(), w.data(), m, degree + 1);
 }
 
 float LeastSquaresVelocityTrackerStrategy::chooseWeight(int32_t pointerId, uint32_t index) const {
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+#include <input/Input.h>
+#include <input/InputEventBuilders.h>
+#include <input/InputTransport.h>
+#include <input/Resampler.h>
+
+namespace android {
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+// A typical touchscreen report interval.
+constexpr std::chrono::nanoseconds SAMPLE_INTERVAL = 5ms;
+
+MotionEvent buildMotionEvent(int32_t action, std::chrono::nanoseconds eventTime,
+                             size_t pointerCount) {
+    MotionEventBuilder builder =
+            MotionEventBuilder(action, AINPUT_SOURCE_CLASS_POINTER)
+                    .downTime(0)
+                    .eventTime(eventTime.count());
+    for (size_t i = 0; i < pointerCount; ++i) {
+        builder.pointer(PointerBuilder(static_cast<int32_t>(i), ToolType::FINGER)
+                                .x(static_cast<float>(100 + i))
+                                .y(static_cast<float>(200 + i)));
+    }
+    return builder.build();
+}
+
+InputMessage buildInputMessage(std::chrono::nanoseconds eventTime, size_t pointerCount) {
+    InputMessageBuilder builder = InputMessageBuilder{InputMessage::Type::MOTION, /*seq=*/0}
+                                          .eventTime(eventTime.count())
+                                          .source(AINPUT_SOURCE_TOUCHSCREEN)
+                                          .downTime(0);
+    for (size_t i = 0; i < pointerCount; ++i) {
+        builder.pointer(PointerBuilder(static_cast<int32_t>(i), ToolType::FINGER)
+                                .x(static_cast<float>(110 + i))
+                                .y(static_cast<float>(210 + i)));
+    }
+    return builder.build();
+}
+
+/**
+ * Streams MOVE events with the given number of pointers through the resampler, interpolating
+ * against a future sample, the way InputConsumer does for every frame of an active gesture.
+ */
+void BM_resampleInterpolate(benchmark::State& state) {
+    const size_t pointerCount = static_cast<size_t>(state.range(0));
+    LegacyResampler resampler;
+    std::chrono::nanoseconds eventTime{0};
+
+    for (auto _ : state) {
+        eventTime += SAMPLE_INTERVAL;
+        MotionEvent motionEvent =
+                buildMotionEvent(AMOTION_EVENT_ACTION_MOVE, eventTime, pointerCount);
+        const InputMessage futureSample =
+                buildInputMessage(eventTime + SAMPLE_INTERVAL, pointerCount);
+        // The frame time is chosen so that, after the resampler subtracts its latency, the
+        // resample target falls between the event and the future sample.
+        resampler.resampleMotionEvent(eventTime + 7ms, motionEvent, &futureSample);
+        benchmark::DoNotOptimize(motionEvent);
+    }
+}
+
+/**
+ * Same stream without a future sample, forcing the extrapolation path.
+ */
+void BM_resampleExtrapolate(benchmark::State& state) {
+    const size_t pointerCount = static_cast<size_t>(state.range(0));
+    LegacyResampler resampler;
+    std::chrono::nanoseconds eventTime{0};
+
+    for (auto _ : state) {
+        eventTime += SAMPLE_INTERVAL;
+        MotionEvent motionEvent =
+                buildMotionEvent(AMOTION_EVENT_ACTION_MOVE, eventTime, pointerCount);
+        resampler.resampleMotionEvent(eventTime + 7ms, motionEvent, /*futureSample=*/nullptr);
+        benchmark::DoNotOptimize(motionEvent);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_resampleInterpolate)->Arg(1)->Arg(2)->Arg(10);
+BENCHMARK(BM_resampleExtrapolate)->Arg(1)->Arg(2)->Arg(10);
+
+} // namespace android
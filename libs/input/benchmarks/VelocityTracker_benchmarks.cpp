@@ -0,0 +1,89 @@
+/**
+ * Copyright 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+#include <input/Input.h>
+#include <input/VelocityTracker.h>
+#include <utils/Timers.h>
+
+namespace android {
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+// Matches AccumulatingVelocityTrackerStrategy::HISTORY_SIZE: enough samples to fill the history
+// window so that the solvers run over a full window on every query.
+constexpr size_t SAMPLES_PER_WINDOW = 20;
+
+// A typical high rate touchscreen report interval.
+constexpr std::chrono::nanoseconds SAMPLE_INTERVAL = 5ms;
+
+/**
+ * Feeds a full history window of X and Y movements for the given number of pointers and then
+ * queries the velocity of every pointer, mirroring what apps do once per frame while a gesture
+ * is in progress.
+ */
+void benchmarkStrategy(benchmark::State& state, VelocityTracker::Strategy strategy) {
+    const int32_t pointerCount = static_cast<int32_t>(state.range(0));
+    VelocityTracker tracker(strategy);
+    nsecs_t eventTime = 0;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < SAMPLES_PER_WINDOW; ++i) {
+            eventTime += SAMPLE_INTERVAL.count();
+            for (int32_t pointerId = 0; pointerId < pointerCount; ++pointerId) {
+                tracker.addMovement(eventTime, pointerId, AMOTION_EVENT_AXIS_X,
+                                    static_cast<float>(i * 5 + pointerId));
+                tracker.addMovement(eventTime, pointerId, AMOTION_EVENT_AXIS_Y,
+                                    static_cast<float>(i * 3 + pointerId));
+            }
+        }
+        VelocityTracker::ComputedVelocity velocity =
+                tracker.getComputedVelocity(/*units=*/1000, /*maxVelocity=*/16000.f);
+        benchmark::DoNotOptimize(velocity);
+    }
+}
+
+void BM_velocityLsq2(benchmark::State& state) {
+    benchmarkStrategy(state, VelocityTracker::Strategy::LSQ2);
+}
+
+void BM_velocityLsq3(benchmark::State& state) {
+    benchmarkStrategy(state, VelocityTracker::Strategy::LSQ3);
+}
+
+void BM_velocityWlsq2Delta(benchmark::State& state) {
+    benchmarkStrategy(state, VelocityTracker::Strategy::WLSQ2_DELTA);
+}
+
+void BM_velocityImpulse(benchmark::State& state) {
+    benchmarkStrategy(state, VelocityTracker::Strategy::IMPULSE);
+}
+
+} // namespace
+
+BENCHMARK(BM_velocityLsq2)->Arg(1)->Arg(2)->Arg(10);
+BENCHMARK(BM_velocityLsq3)->Arg(1)->Arg(2)->Arg(10);
+BENCHMARK(BM_velocityWlsq2Delta)->Arg(1)->Arg(2)->Arg(10);
+BENCHMARK(BM_velocityImpulse)->Arg(1)->Arg(2)->Arg(10);
+
+} // namespace android
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <math/mat4.h>
+#include <math/vec4.h>
+
+namespace android {
+
+// Compound transform expressions of the shape used by GLConsumer and the
+// RenderEngine description math. The chained variant goes through operator*
+// twice and relies on the compiler to keep the intermediate product in
+// registers; the fused variant computes one result column at a time so the
+// intermediate never exists as a matrix temporary.
+
+static mat4 makeMatrix(float seed) {
+    return mat4(vec4(seed, 2, 3, 4), vec4(5, seed, 7, 8), vec4(9, 10, seed, 12),
+                vec4(13, 14, 15, seed));
+}
+
+static void BM_mat4_multiply(benchmark::State& state) {
+    mat4 a = makeMatrix(1.5f);
+    mat4 b = makeMatrix(-0.5f);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        mat4 r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_mat4_multiply);
+
+static void BM_mat4_chainMultiply(benchmark::State& state) {
+    mat4 projection = makeMatrix(1.5f);
+    mat4 view = makeMatrix(-0.5f);
+    mat4 model = makeMatrix(0.25f);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(projection);
+        benchmark::DoNotOptimize(view);
+        benchmark::DoNotOptimize(model);
+        mat4 r = projection * view * model;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_mat4_chainMultiply);
+
+static void BM_mat4_fusedMultiply(benchmark::State& state) {
+    mat4 projection = makeMatrix(1.5f);
+    mat4 view = makeMatrix(-0.5f);
+    mat4 model = makeMatrix(0.25f);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(projection);
+        benchmark::DoNotOptimize(view);
+        benchmark::DoNotOptimize(model);
+        mat4 r = matrix::multiply<mat4>(projection, view, model);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_mat4_fusedMultiply);
+
+static void BM_mat4_vec4_transform(benchmark::State& state) {
+    mat4 transform = makeMatrix(1.5f);
+    vec4 v(1, 2, 3, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(transform);
+        benchmark::DoNotOptimize(v);
+        vec4 r = transform * v;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_mat4_vec4_transform);
+
+} // namespace android
+
+BENCHMARK_MAIN();
@@ -259,6 +259,31 @@ CONSTEXPR MATRIX_R PURE multiply(const MATRIX_A& lhs, const MATRIX_B& rhs) {
     return res;
 }
 
+/*
+ * Fused three-matrix product, equivalent to a * (b * c) but computed one
+ * result column at a time so the intermediate product is never materialized
+ * as a matrix temporary. Useful for compound transform chains such as
+ * projection * view * model. The result is bit-exact with a * (b * c);
+ * floating point rounding may differ from (a * b) * c.
+ */
+template<typename MATRIX_R, typename MATRIX_A, typename MATRIX_B, typename MATRIX_C>
+CONSTEXPR MATRIX_R PURE multiply(const MATRIX_A& a, const MATRIX_B& b, const MATRIX_C& c) {
+    static_assert(MATRIX_A::NUM_COLS == MATRIX_B::NUM_ROWS,
+            "matrices can't be multiplied. invalid dimensions.");
+    static_assert(MATRIX_B::NUM_COLS == MATRIX_C::NUM_ROWS,
+            "matrices can't be multiplied. invalid dimensions.");
+    static_assert(MATRIX_R::NUM_COLS == MATRIX_C::NUM_COLS,
+            "invalid dimension of matrix multiply result.");
+    static_assert(MATRIX_R::NUM_ROWS == MATRIX_A::NUM_ROWS,
+            "invalid dimension of matrix multiply result.");
+
+    MATRIX_R res(MATRIX_R::NO_INIT);
+    for (size_t col = 0; col < MATRIX_R::NUM_COLS; ++col) {
+        res[col] = a * (b * c[col]);
+    }
+    return res;
+}
+
 // transpose. this handles matrices of matrices
 template <typename MATRIX>
 CONSTEXPR MATRIX PURE transpose(const MATRIX& m) {
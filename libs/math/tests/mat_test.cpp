@@ -150,6 +150,19 @@ TEST_F(MatTest, MiscOps) {
     }
 }
 
+TEST_F(MatTest, FusedMultiply) {
+    const mat4 identity;
+    mat4 p(vec4(2, 0, 0, 0), vec4(0, 3, 0, 0), vec4(0, 0, 4, 0), vec4(1, 2, 3, 1));
+    mat4 v(vec4(0, 1, 0, 0), vec4(-1, 0, 0, 0), vec4(0, 0, 1, 0), vec4(5, -5, 0, 1));
+    mat4 m(vec4(1, 2, 3, 4), vec4(5, 6, 7, 8), vec4(9, 10, 11, 12), vec4(13, 14, 15, 16));
+
+    // The fused product is computed one result column at a time and is
+    // bit-exact with the right-associated chain.
+    EXPECT_EQ(p * (v * m), matrix::multiply<mat4>(p, v, m));
+    EXPECT_EQ(p * v, matrix::multiply<mat4>(p, identity, v));
+    EXPECT_EQ(p * v, matrix::multiply<mat4>(identity, p, v));
+}
+
 TEST_F(MatTest, ElementAccess) {
     mat4 m(vec4(1, 2, 3, 4), vec4(5, 6, 7, 8), vec4(9, 10, 11, 12), vec4(13, 14, 15, 16));
     for (size_t c=0 ; c<4 ; c++) {
@@ -20,6 +20,7 @@
 
 namespace {
 bool gSave = false;
+const char* gReplayPath = "";
 }
 
 namespace renderenginebench {
@@ -29,6 +30,8 @@ void parseFlagsForHelp(int argc, char** argv) {
         if (!strcmp(argv[i], "--help")) {
             printf("RenderEngineBench-specific flags:\n");
             printf("[--save]: Save the output to the device to confirm drawing result.\n");
+            printf("[--replay <file>]: Replay a layer trace recorded with"
+                   " debug.renderengine.capture_layer_trace_frames.\n");
             break;
         }
     }
@@ -38,6 +41,8 @@ void parseFlags(int argc, char** argv) {
     for (int i = 0; i < argc; i++) {
         if (!strcmp(argv[i], "--save")) {
             gSave = true;
+        } else if (!strcmp(argv[i], "--replay") && i + 1 < argc) {
+            gReplayPath = argv[++i];
         }
     }
 }
@@ -45,4 +50,8 @@ void parseFlags(int argc, char** argv) {
 bool save() {
     return gSave;
 }
+
+const char* replay() {
+    return gReplayPath;
+}
 } // namespace renderenginebench
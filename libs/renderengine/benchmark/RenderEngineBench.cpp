@@ -24,8 +24,11 @@
 #include <renderengine/RenderEngine.h>
 #include <renderengine/impl/ExternalTexture.h>
 
+#include <fstream>
 #include <mutex>
 
+#include "../skia/SkiaRenderEngine.h"
+
 using namespace android;
 using namespace android::renderengine;
 
@@ -207,6 +210,97 @@ static std::shared_ptr<ExternalTexture> createTexture(RenderEngine& re, const ch
     return srcBuffer;
 }
 
+/**
+ * A single recorded drawLayers call from a layer trace.
+ */
+struct TraceFrame {
+    ui::Dataspace outputDataspace = ui::Dataspace::UNKNOWN;
+    std::vector<LayerSettings> layers;
+};
+
+/**
+ * Parse a layer trace recorded by LayerTraceRecorder back into LayerSettings.
+ *
+ * The trace only records shader-relevant parameters, so buffer layers are
+ * reconstructed on top of 'srcBuffer'; the pixel contents do not affect which
+ * shaders get compiled. The format is documented in
+ * libs/renderengine/skia/debug/LayerTraceRecorder.h and must be kept in sync.
+ */
+static std::vector<TraceFrame> loadLayerTrace(const char* path,
+                                              const std::shared_ptr<ExternalTexture>& srcBuffer) {
+    std::vector<TraceFrame> frames;
+    std::ifstream in(path);
+    std::string token;
+    while (in >> token) {
+        if (token == "frame") {
+            int32_t dataspace = 0;
+            in >> dataspace;
+            frames.push_back(TraceFrame{.outputDataspace = static_cast<ui::Dataspace>(dataspace)});
+        } else if (token == "layer" && !frames.empty()) {
+            FloatRect bounds;
+            char sourceType = 'b';
+            int32_t dataspace = 0;
+            float alpha = 1.f;
+            float cornerRadius = 0.f;
+            int blurRadius = 0;
+            float shadowLength = 0.f;
+            bool premultiplied = true;
+            bool opaque = false;
+            bool hasColorTransform = false;
+            int edgeFlags = 0;
+            in >> bounds.left >> bounds.top >> bounds.right >> bounds.bottom >> sourceType >>
+                    dataspace >> alpha >> cornerRadius >> blurRadius >> shadowLength >>
+                    premultiplied >> opaque >> hasColorTransform >> edgeFlags;
+
+            LayerSettings layer{
+                    .geometry =
+                            Geometry{
+                                    .boundaries = bounds,
+                                    .roundedCornersRadius = vec2(cornerRadius, cornerRadius),
+                                    .roundedCornersCrop = bounds,
+                            },
+                    .alpha = half(alpha),
+                    .sourceDataspace = static_cast<ui::Dataspace>(dataspace),
+                    .backgroundBlurRadius = blurRadius,
+            };
+            if (sourceType == 'b') {
+                layer.source.buffer = Buffer{
+                        .buffer = srcBuffer,
+                        .usePremultipliedAlpha = premultiplied,
+                        .isOpaque = opaque,
+                };
+            } else {
+                layer.source.solidColor = half3(0.5f, 0.5f, 0.5f);
+            }
+            if (shadowLength > 0.f) {
+                // Light parameters are not recorded; use the same plausible
+                // light as Cache.cpp so the shadow shaders are exercised.
+                layer.shadow = ShadowSettings{
+                        .boundaries = bounds,
+                        .ambientColor = vec4(0, 0, 0, 0.00935997f),
+                        .spotColor = vec4(0, 0, 0, 0.0455841f),
+                        .lightPos = vec3(500.f, -1500.f, 1500.f),
+                        .lightRadius = 2500.0f,
+                        .length = shadowLength,
+                        .casterIsTranslucent = alpha < 1.f,
+                };
+            }
+            if (hasColorTransform) {
+                // Any non-identity matrix selects the color transform path.
+                layer.colorTransform = mat4(vec4(0.9f, 0.f, 0.f, 0.f), vec4(0.f, 1.f, 0.f, 0.f),
+                                            vec4(0.f, 0.f, 1.f, 0.f), vec4(0.f, 0.f, 0.f, 1.f));
+            }
+            if (edgeFlags != 0) {
+                layer.edgeExtensionEffect =
+                        EdgeExtensionEffect(edgeFlags & LEFT, edgeFlags & RIGHT, edgeFlags & TOP,
+                                            edgeFlags & BOTTOM);
+            }
+            frames.back().layers.push_back(layer);
+        }
+    }
+    return frames;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //  Benchmarks
 ///////////////////////////////////////////////////////////////////////////////
@@ -318,6 +412,60 @@ void BM_homescreen_edgeExtension(benchmark::State& benchState, Args&&... args) {
     benchDrawLayers(*re, layers, benchState, "homescreen_edge_extension");
 }
 
+/**
+ * Replay a layer trace recorded on a device via
+ * debug.renderengine.capture_layer_trace_frames (passed with --replay).
+ *
+ * Reports the number of shaders the trace compiled as a counter, so that the
+ * priming in skia/Cache.cpp can be validated against the shader population the
+ * actual UI hits: a fully primed cache should replay with zero compiles.
+ */
+template <class... Args>
+void BM_layer_trace(benchmark::State& benchState, Args&&... args) {
+    const char* tracePath = renderenginebench::replay();
+    if (*tracePath == '\0') {
+        benchState.SkipWithError("No layer trace; run with --replay <file>");
+        return;
+    }
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    // Unthreaded so the engine can be downcast to read the shader compile count.
+    auto re = createRenderEngine(RenderEngine::Threaded::NO,
+                                 static_cast<RenderEngine::GraphicsApi>(std::get<0>(args_tuple)));
+    auto* skiaRE = static_cast<skia::SkiaRenderEngine*>(re.get());
+
+    auto [width, height] = getDisplaySize();
+    auto srcBuffer = createTexture(*re, kHomescreenPath);
+    const auto frames = loadLayerTrace(tracePath, srcBuffer);
+    if (frames.empty()) {
+        benchState.SkipWithError("Trace is empty or unreadable");
+        return;
+    }
+    auto outputBuffer = allocateBuffer(*re, width, height);
+    const Rect displayRect(0, 0, static_cast<int32_t>(width), static_cast<int32_t>(height));
+
+    const int shadersBefore = skiaRE->reportShadersCompiled();
+    for (auto _ : benchState) {
+        for (const auto& frame : frames) {
+            DisplaySettings display{
+                    .physicalDisplay = displayRect,
+                    .clip = displayRect,
+                    .maxLuminance = 500,
+                    .outputDataspace = frame.outputDataspace,
+            };
+            sp<Fence> waitFence = re->drawLayers(display, frame.layers, outputBuffer,
+                                                 kUseFrameBufferCache, base::unique_fd())
+                                          .get()
+                                          .value();
+            waitFence->waitForever(LOG_TAG);
+        }
+    }
+    benchState.counters["frames"] = static_cast<double>(frames.size());
+    benchState.counters["shaders_compiled"] =
+            static_cast<double>(skiaRE->reportShadersCompiled() - shadersBefore);
+}
+
+BENCHMARK_CAPTURE(BM_layer_trace, SkiaGL, RenderEngine::GraphicsApi::GL);
+
 BENCHMARK_CAPTURE(BM_homescreen_blur, gaussian, RenderEngine::Threaded::YES,
                   RenderEngine::GraphicsApi::GL, RenderEngine::BlurAlgorithm::GAUSSIAN);
 
@@ -27,6 +27,7 @@ namespace renderenginebench {
  *
  * --save Save the output buffer to a file to verify that it drew as
  *  expected.
+ * --replay <file> Replay a recorded layer trace and report shader compiles.
  */
 void parseFlags(int argc, char** argv);
 
@@ -42,6 +43,14 @@ void parseFlagsForHelp(int argc, char** argv);
  */
 bool save();
 
+/**
+ * Path to a layer trace to replay, recorded on a device by setting
+ * debug.renderengine.capture_layer_trace_frames.
+ *
+ * Empty string unless --replay was used on the command line.
+ */
+const char* replay();
+
 /**
  * Decode the image at 'path' into 'buffer'.
  *
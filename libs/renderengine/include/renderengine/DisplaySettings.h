@@ -105,6 +105,16 @@ struct DisplaySettings {
 
     // For now, meaningful primarily when the TonemappingStrategy is Local
     float targetHdrSdrRatio = 1.f;
+
+    // Hint for threaded RenderEngine implementations describing how urgent this draw is.
+    // Frame draws feed the display pipeline and are serviced before any queued Background
+    // work. Background is meant for one-shot renders such as screen captures, whose
+    // latency does not gate the next frame. Unthreaded implementations ignore this.
+    enum class QueuePriority {
+        Frame,
+        Background,
+    };
+    QueuePriority queuePriority = QueuePriority::Frame;
 };
 
 static inline bool operator==(const DisplaySettings& lhs, const DisplaySettings& rhs) {
@@ -116,7 +126,8 @@ static inline bool operator==(const DisplaySettings& lhs, const DisplaySettings&
             lhs.deviceHandlesColorTransform == rhs.deviceHandlesColorTransform &&
             lhs.orientation == rhs.orientation &&
             lhs.targetLuminanceNits == rhs.targetLuminanceNits &&
-            lhs.dimmingStage == rhs.dimmingStage && lhs.renderIntent == rhs.renderIntent;
+            lhs.dimmingStage == rhs.dimmingStage && lhs.renderIntent == rhs.renderIntent &&
+            lhs.queuePriority == rhs.queuePriority;
 }
 
 static const char* orientation_to_string(uint32_t orientation) {
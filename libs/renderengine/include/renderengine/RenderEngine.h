@@ -51,6 +51,14 @@
  */
 #define PROPERTY_DEBUG_RENDERENGINE_CAPTURE_FILENAME "debug.renderengine.capture_filename"
 
+/**
+ * Records the shader-relevant parameters of drawLayers calls into a text trace
+ * that librenderengine_bench can replay with --replay. The property defines the
+ * number of frames to record. A non zero value turns on the recording.
+ */
+#define PROPERTY_DEBUG_RENDERENGINE_CAPTURE_LAYER_TRACE_FRAMES \
+    "debug.renderengine.capture_layer_trace_frames"
+
 /**
  * Switches the cross-window background blur algorithm.
  */
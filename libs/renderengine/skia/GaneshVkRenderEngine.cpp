@@ -19,6 +19,7 @@
 #undef LOG_TAG
 #define LOG_TAG "RenderEngine"
 
+#include <include/gpu/ganesh/SkSurfaceGanesh.h>
 #include <include/gpu/ganesh/vk/GrVkBackendSemaphore.h>
 
 #include <common/trace.h>
@@ -77,12 +78,6 @@ void GaneshVkRenderEngine::waitFence(SkiaGpuContext* context, base::borrowed_fd
 base::unique_fd GaneshVkRenderEngine::flushAndSubmit(SkiaGpuContext* context,
                                                      sk_sp<SkSurface> dstSurface) {
     sk_sp<GrDirectContext> grContext = context->grDirectContext();
-    {
-        SFTRACE_NAME("flush surface");
-        // TODO: Investigate feasibility of combining this "surface flush" into the "context flush"
-        // below.
-        context->grDirectContext()->flush(dstSurface.get());
-    }
 
     VulkanInterface& vi = getVulkanInterface(isProtected());
     VkSemaphore semaphore = vi.createExportableSemaphore();
@@ -97,7 +92,15 @@ base::unique_fd GaneshVkRenderEngine::flushAndSubmit(SkiaGpuContext* context,
         flushInfo.fFinishedProc = unref_semaphore;
         flushInfo.fFinishedContext = destroySemaphoreInfo;
     }
-    GrSemaphoresSubmitted submitted = grContext->flush(flushInfo);
+    GrSemaphoresSubmitted submitted;
+    {
+        SFTRACE_NAME("flush surface");
+        // Flush the surface and attach the signal semaphore in one call. The surface flush
+        // pulls in everything the frame depends on, so the previous second context-wide
+        // flush only added an extra command buffer boundary between dependent work.
+        submitted = grContext->flush(dstSurface.get(), SkSurfaces::BackendSurfaceAccess::kNoAccess,
+                                     flushInfo);
+    }
     grContext->submit(GrSyncCpu::kNo);
     int drawFenceFd = -1;
     if (semaphore != VK_NULL_HANDLE) {
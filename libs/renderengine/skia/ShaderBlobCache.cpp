@@ -0,0 +1,173 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShaderBlobCache.h"
+
+#undef LOG_TAG
+#define LOG_TAG "RenderEngine"
+
+#include <android-base/file.h>
+#include <log/log.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace android {
+namespace renderengine {
+namespace skia {
+
+namespace {
+
+// 'S' 'B' 'C' + format revision. Bump the last byte whenever the layout of
+// the file changes so older files are discarded instead of misparsed.
+constexpr uint32_t kMagic = 0x53424301;
+
+// Limits chosen to comfortably hold a steady-state SurfaceFlinger pipeline
+// working set while bounding how much a corrupt header can make us allocate.
+constexpr size_t kMaxEntrySize = 256 * 1024;
+constexpr size_t kMaxTotalSize = 4 * 1024 * 1024;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t entryCount;
+    uint64_t payloadHash;
+};
+
+// FNV-1a, self-contained so the cache does not grow a zlib dependency just
+// for integrity checking.
+uint64_t hashBytes(const uint8_t* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+template <typename T>
+bool readValue(const std::string& buffer, size_t* offset, T* out) {
+    if (buffer.size() - *offset < sizeof(T)) {
+        return false;
+    }
+    memcpy(out, buffer.data() + *offset, sizeof(T));
+    *offset += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+ShaderBlobCache::ShaderBlobCache(std::string path) : mPath(std::move(path)) {
+    readFromDisk();
+}
+
+sk_sp<SkData> ShaderBlobCache::load(const SkData& key) {
+    std::lock_guard lock(mMutex);
+    auto it = mEntries.find(std::string(static_cast<const char*>(key.data()), key.size()));
+    return it == mEntries.end() ? nullptr : it->second;
+}
+
+void ShaderBlobCache::store(const SkData& key, const SkData& data) {
+    if (key.size() + data.size() > kMaxEntrySize) {
+        return;
+    }
+    std::lock_guard lock(mMutex);
+    std::string keyBytes(static_cast<const char*>(key.data()), key.size());
+    auto it = mEntries.find(keyBytes);
+    if (it != mEntries.end()) {
+        mTotalSize -= keyBytes.size() + it->second->size();
+    }
+    if (mTotalSize + keyBytes.size() + data.size() > kMaxTotalSize) {
+        // Shader blobs are never invalidated individually, so an overflowing
+        // cache means the working set changed wholesale (e.g. a driver
+        // update). Start over rather than evicting piecemeal.
+        mEntries.clear();
+        mTotalSize = 0;
+    }
+    mTotalSize += keyBytes.size() + data.size();
+    mEntries[std::move(keyBytes)] = SkData::MakeWithCopy(data.data(), data.size());
+    // Stores only happen when Skia compiles a pipeline that was not already
+    // cached, so rewriting synchronously here is rare after warm-up.
+    writeToDiskLocked();
+}
+
+size_t ShaderBlobCache::entryCount() const {
+    std::lock_guard lock(mMutex);
+    return mEntries.size();
+}
+
+void ShaderBlobCache::readFromDisk() {
+    std::string buffer;
+    if (!base::ReadFileToString(mPath, &buffer)) {
+        return;
+    }
+    FileHeader header;
+    size_t offset = 0;
+    if (!readValue(buffer, &offset, &header) || header.magic != kMagic) {
+        ALOGW("Discarding shader cache '%s' with unrecognized header", mPath.c_str());
+        return;
+    }
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(buffer.data()) + sizeof(FileHeader);
+    if (hashBytes(payload, buffer.size() - sizeof(FileHeader)) != header.payloadHash) {
+        ALOGW("Discarding corrupt shader cache '%s'", mPath.c_str());
+        return;
+    }
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        uint32_t keySize, valueSize;
+        if (!readValue(buffer, &offset, &keySize) || !readValue(buffer, &offset, &valueSize) ||
+            keySize + static_cast<size_t>(valueSize) > kMaxEntrySize ||
+            buffer.size() - offset < keySize + static_cast<size_t>(valueSize)) {
+            ALOGW("Discarding truncated shader cache '%s'", mPath.c_str());
+            mEntries.clear();
+            mTotalSize = 0;
+            return;
+        }
+        std::string keyBytes(buffer.data() + offset, keySize);
+        offset += keySize;
+        mEntries[std::move(keyBytes)] = SkData::MakeWithCopy(buffer.data() + offset, valueSize);
+        offset += valueSize;
+        mTotalSize += keySize + valueSize;
+    }
+    ALOGD("Loaded %zu shader blobs (%zu bytes) from '%s'", mEntries.size(), mTotalSize,
+          mPath.c_str());
+}
+
+void ShaderBlobCache::writeToDiskLocked() {
+    std::string buffer;
+    buffer.reserve(sizeof(FileHeader) + mTotalSize + mEntries.size() * 2 * sizeof(uint32_t));
+    buffer.resize(sizeof(FileHeader));
+    for (const auto& [key, value] : mEntries) {
+        uint32_t keySize = static_cast<uint32_t>(key.size());
+        uint32_t valueSize = static_cast<uint32_t>(value->size());
+        buffer.append(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+        buffer.append(reinterpret_cast<const char*>(&valueSize), sizeof(valueSize));
+        buffer.append(key);
+        buffer.append(static_cast<const char*>(value->data()), value->size());
+    }
+    FileHeader header;
+    header.magic = kMagic;
+    header.entryCount = static_cast<uint32_t>(mEntries.size());
+    header.payloadHash = hashBytes(reinterpret_cast<const uint8_t*>(buffer.data()) +
+                                           sizeof(FileHeader),
+                                   buffer.size() - sizeof(FileHeader));
+    memcpy(buffer.data(), &header, sizeof(FileHeader));
+    if (!base::WriteStringToFile(buffer, mPath)) {
+        ALOGW("Failed to persist shader cache to '%s'", mPath.c_str());
+    }
+}
+
+} // namespace skia
+} // namespace renderengine
+} // namespace android
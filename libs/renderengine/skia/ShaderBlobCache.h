@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <include/core/SkData.h>
+#include <include/core/SkRefCnt.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace android {
+namespace renderengine {
+namespace skia {
+
+/**
+ * A persistent, file-backed store for the compiled shader and pipeline blobs
+ * that Skia hands to GrContextOptions::PersistentCache. The entire cache file
+ * is read and validated once at RenderEngine creation, so cache hits after a
+ * process restart are served from memory before the first frame is composited
+ * instead of triggering a pipeline compile.
+ *
+ * The on-disk format is a small fixed header (magic, version, entry count and
+ * a checksum of the payload) followed by length-prefixed key/value pairs. Any
+ * mismatch - truncated file, bad checksum, or a version bump after a driver or
+ * Skia update - discards the file and starts over, since stale blobs are worse
+ * than a cold cache.
+ */
+class ShaderBlobCache {
+public:
+    // Loads and validates the cache file at |path|. An unreadable or invalid
+    // file leaves the cache empty; it will be rewritten on the first store.
+    explicit ShaderBlobCache(std::string path);
+
+    // Returns the cached blob for |key|, or nullptr on a miss.
+    sk_sp<SkData> load(const SkData& key);
+
+    // Inserts or replaces the blob for |key| and schedules the file to be
+    // rewritten. Oversized entries are dropped rather than evicting the rest
+    // of the cache.
+    void store(const SkData& key, const SkData& data);
+
+    size_t entryCount() const;
+
+private:
+    void readFromDisk();
+    void writeToDiskLocked();
+
+    const std::string mPath;
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, sk_sp<SkData>> mEntries;
+    size_t mTotalSize = 0;
+};
+
+} // namespace skia
+} // namespace renderengine
+} // namespace android
@@ -49,6 +49,7 @@
 #include <SkString.h>
 #include <SkSurface.h>
 #include <SkTileMode.h>
+#include <android-base/properties.h>
 #include <android-base/stringprintf.h>
 #include <common/FlagManager.h>
 #include <common/trace.h>
@@ -262,16 +263,28 @@ std::future<void> SkiaRenderEngine::primeCache(PrimeCacheConfig config) {
     return {};
 }
 
+SkiaRenderEngine::SkSLCacheMonitor::SkSLCacheMonitor() {
+    const std::string path = base::GetProperty("debug.renderengine.shader_cache_path", "");
+    if (!path.empty()) {
+        mBlobCache = std::make_unique<ShaderBlobCache>(path);
+        ALOGD("Persistent shader cache enabled at '%s' (%zu blobs)", path.c_str(),
+              mBlobCache->entryCount());
+    }
+}
+
 sk_sp<SkData> SkiaRenderEngine::SkSLCacheMonitor::load(const SkData& key) {
-    // This "cache" does not actually cache anything. It just allows us to
-    // monitor Skia's internal cache. So this method always returns null.
-    return nullptr;
+    // Without a backing file this "cache" does not actually cache anything; it
+    // just allows us to monitor Skia's internal cache.
+    return mBlobCache ? mBlobCache->load(key) : nullptr;
 }
 
 void SkiaRenderEngine::SkSLCacheMonitor::store(const SkData& key, const SkData& data,
                                                const SkString& description) {
     mShadersCachedSinceLastCall++;
     mTotalShadersCompiled++;
+    if (mBlobCache) {
+        mBlobCache->store(key, data);
+    }
     SFTRACE_FORMAT("SF cache: %i shaders", mTotalShadersCompiled);
 }
 
@@ -309,6 +322,7 @@ SkiaRenderEngine::SkiaRenderEngine(Threaded threaded, PixelFormat pixelFormat,
     }
 
     mCapture = std::make_unique<SkiaCapture>();
+    mLayerTraceRecorder = std::make_unique<LayerTraceRecorder>();
 }
 
 SkiaRenderEngine::~SkiaRenderEngine() { }
@@ -339,6 +353,9 @@ void SkiaRenderEngine::useProtectedContext(bool useProtectedContext) {
     }
 
     // release any scratch resources before switching into a new mode
+    if (mBlurFilter) {
+        mBlurFilter->releaseRenderTargets();
+    }
     if (getActiveContext()) {
         getActiveContext()->purgeUnlockedScratchResources();
     }
@@ -593,15 +610,64 @@ sk_sp<SkShader> SkiaRenderEngine::createRuntimeEffectShader(
         }
 
         const auto hardwareBuffer = graphicBuffer ? graphicBuffer->toAHardwareBuffer() : nullptr;
-        return createLinearEffectShader(shader, effect, runtimeEffect, std::move(colorTransform),
-                                        parameters.display.maxLuminance,
-                                        parameters.display.currentLuminanceNits,
-                                        parameters.layer.source.buffer.maxLuminanceNits,
-                                        hardwareBuffer, parameters.display.renderIntent);
+        const auto& uniforms = getOrBuildLinearEffectUniforms(
+                {.effect = effect,
+                 .colorTransform = colorTransform,
+                 .maxDisplayLuminance = parameters.display.maxLuminance,
+                 .currentDisplayLuminanceNits = parameters.display.currentLuminanceNits,
+                 .maxLuminance = parameters.layer.source.buffer.maxLuminanceNits,
+                 .renderIntent = parameters.display.renderIntent},
+                hardwareBuffer);
+        return createLinearEffectShader(shader, runtimeEffect, uniforms);
     }
     return shader;
 }
 
+bool SkiaRenderEngine::LinearEffectUniformsKey::operator==(
+        const LinearEffectUniformsKey& other) const {
+    return effect == other.effect && colorTransform == other.colorTransform &&
+            maxDisplayLuminance == other.maxDisplayLuminance &&
+            currentDisplayLuminanceNits == other.currentDisplayLuminanceNits &&
+            maxLuminance == other.maxLuminance && renderIntent == other.renderIntent;
+}
+
+size_t SkiaRenderEngine::LinearEffectUniformsKeyHasher::operator()(
+        const LinearEffectUniformsKey& key) const {
+    using shaders::LinearEffectHasher;
+    size_t result = LinearEffectHasher{}(key.effect);
+    for (size_t i = 0; i < 16; i++) {
+        result = LinearEffectHasher::HashCombine(result,
+                                                 std::hash<float>{}(key.colorTransform.asArray()[i]));
+    }
+    result = LinearEffectHasher::HashCombine(result, std::hash<float>{}(key.maxDisplayLuminance));
+    result = LinearEffectHasher::HashCombine(result,
+                                             std::hash<float>{}(key.currentDisplayLuminanceNits));
+    result = LinearEffectHasher::HashCombine(result, std::hash<float>{}(key.maxLuminance));
+    return LinearEffectHasher::HashCombine(result,
+                                           std::hash<int32_t>{}(
+                                                   static_cast<int32_t>(key.renderIntent)));
+}
+
+const std::vector<tonemap::ShaderUniform>& SkiaRenderEngine::getOrBuildLinearEffectUniforms(
+        const LinearEffectUniformsKey& key, AHardwareBuffer* buffer) {
+    auto uniformsIter = mLinearEffectUniforms.find(key);
+    if (uniformsIter != mLinearEffectUniforms.end()) {
+        return uniformsIter->second;
+    }
+    // The layer dimming ratio is folded into the color transform and animates during
+    // brightness transitions, so guard against unbounded growth.
+    static constexpr size_t kMaxLinearEffectUniforms = 32;
+    if (mLinearEffectUniforms.size() >= kMaxLinearEffectUniforms) {
+        mLinearEffectUniforms.clear();
+    }
+    auto uniforms =
+            shaders::buildLinearEffectUniforms(key.effect, key.colorTransform,
+                                               key.maxDisplayLuminance,
+                                               key.currentDisplayLuminanceNits, key.maxLuminance,
+                                               buffer, key.renderIntent);
+    return mLinearEffectUniforms.emplace(key, std::move(uniforms)).first->second;
+}
+
 void SkiaRenderEngine::initCanvas(SkCanvas* canvas, const DisplaySettings& display) {
     if (CC_UNLIKELY(mCapture->isCaptureRunning())) {
         // Record display settings when capture is running.
@@ -727,6 +793,8 @@ void SkiaRenderEngine::drawLayersInternal(
 
     validateOutputBufferUsage(buffer->getBuffer());
 
+    mLayerTraceRecorder->recordFrame(display, layers);
+
     auto context = getActiveContext();
     LOG_ALWAYS_FATAL_IF(context->isAbandonedOrDeviceLost(),
                         "Context is abandoned/device lost at start of %s", __func__);
@@ -736,6 +804,25 @@ void SkiaRenderEngine::drawLayersInternal(
 
     auto surfaceTextureRef = getOrCreateBackendTexture(buffer->getBuffer(), true);
 
+    // Import all layer buffers up front, so that recording below is not interleaved with
+    // backend texture creation. Buffers that miss mTextureCache require a GPU image import,
+    // which is the expensive part; hoisting the imports keeps them out of the per-layer
+    // DrawImage path and aborts cheaply if an import fails. The imports must stay on this
+    // thread since both Ganesh and Graphite require their context for texture creation.
+    std::unordered_map<GraphicBufferId, std::shared_ptr<AutoBackendTexture::LocalRef>>
+            prefetchedTextures;
+    {
+        SFTRACE_NAME("PrefetchTextures");
+        for (const auto& layer : layers) {
+            if (layer.skipContentDraw || !layer.source.buffer.buffer) {
+                continue;
+            }
+            const auto& layerBuffer = layer.source.buffer.buffer->getBuffer();
+            prefetchedTextures.try_emplace(layerBuffer->getId(),
+                                           getOrCreateBackendTexture(layerBuffer, false));
+        }
+    }
+
     // wait on the buffer to be ready to use prior to using it
     waitFence(context, bufferFence);
 
@@ -1000,7 +1087,10 @@ void SkiaRenderEngine::drawLayersInternal(
             SFTRACE_NAME("DrawImage");
             validateInputBufferUsage(layer.source.buffer.buffer->getBuffer());
             const auto& item = layer.source.buffer;
-            auto imageTextureRef = getOrCreateBackendTexture(item.buffer->getBuffer(), false);
+            const auto prefetched = prefetchedTextures.find(item.buffer->getBuffer()->getId());
+            auto imageTextureRef = prefetched != prefetchedTextures.end()
+                    ? prefetched->second
+                    : getOrCreateBackendTexture(item.buffer->getBuffer(), false);
 
             // if the layer's buffer has a fence, then we must must respect the fence prior to using
             // the buffer.
@@ -1370,6 +1460,8 @@ void SkiaRenderEngine::dump(std::string& result) {
             StringAppendF(&result, "undoPremultipliedAlpha: %s\n",
                           linearEffect.undoPremultipliedAlpha ? "true" : "false");
         }
+        StringAppendF(&result, "RenderEngine cached linear effect uniforms: %zu\n",
+                      mLinearEffectUniforms.size());
     }
     StringAppendF(&result, "\n");
 }
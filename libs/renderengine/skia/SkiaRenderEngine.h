@@ -33,8 +33,10 @@
 #include <unordered_map>
 
 #include "AutoBackendTexture.h"
+#include "ShaderBlobCache.h"
 #include "android-base/macros.h"
 #include "compat/SkiaGpuContext.h"
+#include "debug/LayerTraceRecorder.h"
 #include "debug/SkiaCapture.h"
 #include "filters/BlurFilter.h"
 #include "filters/EdgeExtensionShaderFactory.h"
@@ -104,10 +106,12 @@ protected:
     bool isProtected() const { return mInProtectedContext; }
 
     // Implements PersistentCache as a way to monitor what SkSL shaders Skia has
-    // cached.
+    // cached, and - when the debug.renderengine.shader_cache_path property
+    // names a writable file - to persist those blobs across restarts via a
+    // ShaderBlobCache so pipelines are warm before the first composition.
     class SkSLCacheMonitor : public GrContextOptions::PersistentCache {
     public:
-        SkSLCacheMonitor() = default;
+        SkSLCacheMonitor();
         ~SkSLCacheMonitor() override = default;
 
         sk_sp<SkData> load(const SkData& key) override;
@@ -125,6 +129,7 @@ protected:
     private:
         int mShadersCachedSinceLastCall = 0;
         int mTotalShadersCompiled = 0;
+        std::unique_ptr<ShaderBlobCache> mBlobCache;
     };
 
     SkSLCacheMonitor mSkSLCacheMonitor;
@@ -184,6 +189,34 @@ private:
             GUARDED_BY(mRenderingMutex);
     std::unordered_map<shaders::LinearEffect, sk_sp<SkRuntimeEffect>, shaders::LinearEffectHasher>
             mRuntimeEffects;
+
+    // Key for the cache of uniform values bound to the runtime effects above, covering
+    // the display- and content-derived parameters that determine them. The AHardwareBuffer
+    // is deliberately not part of the key: the in-tree tonemappers derive their uniforms
+    // from the luminance metadata alone.
+    struct LinearEffectUniformsKey {
+        shaders::LinearEffect effect;
+        mat4 colorTransform;
+        float maxDisplayLuminance;
+        float currentDisplayLuminanceNits;
+        float maxLuminance;
+        aidl::android::hardware::graphics::composer3::RenderIntent renderIntent;
+
+        bool operator==(const LinearEffectUniformsKey& other) const;
+    };
+    struct LinearEffectUniformsKeyHasher {
+        size_t operator()(const LinearEffectUniformsKey& key) const;
+    };
+
+    // Returns the cached uniforms for the key, building them on a miss. Mixed HDR/SDR
+    // scenes resolve to a handful of keys, so steady-state composition skips the
+    // per-layer color space and matrix chain rebuilds. The returned reference is only
+    // valid until the next call.
+    const std::vector<tonemap::ShaderUniform>& getOrBuildLinearEffectUniforms(
+            const LinearEffectUniformsKey& key, AHardwareBuffer* buffer);
+    std::unordered_map<LinearEffectUniformsKey, std::vector<tonemap::ShaderUniform>,
+                       LinearEffectUniformsKeyHasher>
+            mLinearEffectUniforms;
     AutoBackendTexture::CleanupManager mTextureCleanupMgr GUARDED_BY(mRenderingMutex);
 
     StretchShaderFactory mStretchShaderFactory;
@@ -195,6 +228,9 @@ private:
     // Object to capture commands send to Skia.
     std::unique_ptr<SkiaCapture> mCapture;
 
+    // Object to record shader-relevant drawLayers parameters for benchmark replay.
+    std::unique_ptr<LayerTraceRecorder> mLayerTraceRecorder;
+
     // Mutex guarding rendering operations, so that internal state related to
     // rendering that is potentially modified by multiple threads is guaranteed thread-safe.
     mutable std::mutex mRenderingMutex;
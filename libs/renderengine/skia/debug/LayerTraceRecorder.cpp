@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LayerTraceRecorder.h"
+
+#undef LOG_TAG
+#define LOG_TAG "RenderEngine"
+
+#include <android-base/properties.h>
+#include <log/log.h>
+#include <renderengine/RenderEngine.h>
+
+namespace android {
+namespace renderengine {
+namespace skia {
+
+// Written to the same debug directory as the SKP captures, so the existing
+// record.sh selinux setup applies.
+static const std::string LAYER_TRACE_FILE = "/data/misc/mskps/layer_trace.txt";
+
+void LayerTraceRecorder::recordFrame(const DisplaySettings& display,
+                                     const std::vector<LayerSettings>& layers) {
+    const std::scoped_lock lock(mMutex);
+    if (CC_LIKELY(mFramesLeft == 0)) {
+        if (!setupCapture()) {
+            return;
+        }
+    }
+
+    mFile << "frame " << static_cast<int32_t>(display.outputDataspace) << '\n';
+    for (const auto& layer : layers) {
+        const FloatRect& bounds = layer.geometry.boundaries;
+        const bool hasBuffer = layer.source.buffer.buffer != nullptr;
+        int edgeFlags = 0;
+        for (CanonicalDirections edge : {LEFT, RIGHT, TOP, BOTTOM}) {
+            if (layer.edgeExtensionEffect.extendsEdge(edge)) {
+                edgeFlags |= edge;
+            }
+        }
+        mFile << "layer " << bounds.left << ' ' << bounds.top << ' ' << bounds.right << ' '
+              << bounds.bottom << ' ' << (hasBuffer ? 'b' : 'c') << ' '
+              << static_cast<int32_t>(layer.sourceDataspace) << ' '
+              << static_cast<float>(layer.alpha) << ' ' << layer.geometry.roundedCornersRadius.x
+              << ' ' << layer.backgroundBlurRadius << ' ' << layer.shadow.length << ' '
+              << layer.source.buffer.usePremultipliedAlpha << ' ' << layer.source.buffer.isOpaque
+              << ' ' << (layer.colorTransform != mat4()) << ' ' << edgeFlags << '\n';
+    }
+
+    if (--mFramesLeft == 0) {
+        mFile.close();
+        ALOGD("Wrote layer trace to %s", LAYER_TRACE_FILE.c_str());
+    }
+}
+
+bool LayerTraceRecorder::setupCapture() {
+    const int32_t frames =
+            base::GetIntProperty(PROPERTY_DEBUG_RENDERENGINE_CAPTURE_LAYER_TRACE_FRAMES, 0);
+    if (CC_LIKELY(frames <= 0)) {
+        return false;
+    }
+    mFile.open(LAYER_TRACE_FILE, std::ofstream::trunc);
+    // Reset the property so the capture can be restarted just by setting it
+    // again, without restarting the process.
+    base::SetProperty(PROPERTY_DEBUG_RENDERENGINE_CAPTURE_LAYER_TRACE_FRAMES, "0");
+    if (!mFile.is_open()) {
+        ALOGE("Could not open layer trace file %s", LAYER_TRACE_FILE.c_str());
+        return false;
+    }
+    mFramesLeft = frames;
+    return true;
+}
+
+} // namespace skia
+} // namespace renderengine
+} // namespace android
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <renderengine/DisplaySettings.h>
+#include <renderengine/LayerSettings.h>
+
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace android {
+namespace renderengine {
+namespace skia {
+
+/**
+ * Class that records the shader-relevant parameters of the drawLayers calls a
+ * device actually makes, so that librenderengine_bench can replay them
+ * (--replay) and report how many shaders a real scene population compiles.
+ * Unlike SkiaCapture, which records full Skia command streams, this trace only
+ * keeps the fields that select a shader combination (source type, dataspace,
+ * rounded corners, blur, shadows, ...), so it stays small and is cheap enough
+ * to leave compiled in.
+ *
+ * The trace is a whitespace-separated text file with one record per line:
+ *
+ *   frame <outputDataspace>
+ *   layer <left> <top> <right> <bottom> <source b|c> <dataspace> <alpha>
+ *         <cornerRadius> <blurRadius> <shadowLength> <premultiplied>
+ *         <opaque> <hasColorTransform> <edgeExtensionFlags>
+ *
+ * A "frame" record starts a new drawLayers call; the "layer" records that
+ * follow belong to it. The parser in the benchmark must be kept in sync.
+ */
+class LayerTraceRecorder {
+public:
+    // Called once per drawLayers call. Returns early unless
+    // debug.renderengine.capture_layer_trace_frames is set to a frame count.
+    void recordFrame(const DisplaySettings& display, const std::vector<LayerSettings>& layers);
+
+private:
+    bool setupCapture();
+
+    std::mutex mMutex;
+    std::ofstream mFile;
+    int32_t mFramesLeft = 0;
+};
+
+} // namespace skia
+} // namespace renderengine
+} // namespace android
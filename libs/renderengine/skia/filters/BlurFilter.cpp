@@ -120,6 +120,25 @@ void BlurFilter::drawBlurRegion(SkCanvas* canvas, const SkRRect& effectRegion,
     }
 }
 
+sk_sp<SkSurface> BlurFilter::obtainRenderTarget(SkiaGpuContext* context, const SkImageInfo& info,
+                                                size_t slot) const {
+    LOG_ALWAYS_FATAL_IF(slot >= kMaxRenderTargetSlots, "Invalid blur render target slot %zu", slot);
+    RenderTargetCacheEntry& entry = mRenderTargets[slot];
+    if (entry.context == context && entry.surface && entry.surface->imageInfo() == info) {
+        return entry.surface;
+    }
+    entry.context = context;
+    entry.surface = context->createRenderTarget(info);
+    return entry.surface;
+}
+
+void BlurFilter::releaseRenderTargets() {
+    for (RenderTargetCacheEntry& entry : mRenderTargets) {
+        entry.context = nullptr;
+        entry.surface = nullptr;
+    }
+}
+
 } // namespace skia
 } // namespace renderengine
 } // namespace android
@@ -61,6 +61,25 @@ public:
 
     float getMaxCrossFadeRadius() const;
 
+    // Drops the scratch render targets kept for cross-frame reuse, e.g. before
+    // switching GPU contexts. They are recreated on the next generate() call.
+    void releaseRenderTargets();
+
+protected:
+    /**
+     * Returns a scratch render target for an intermediate blur pass, reusing the
+     * surface from a previous frame when the GPU context and image geometry still
+     * match. The downscaled pyramid surfaces are otherwise reallocated on every
+     * frame a blur is visible, which is pure overhead while the blur geometry is
+     * stable. Distinct slots keep the targets that are live simultaneously within
+     * one generate() call apart; Skia's copy-on-write snapshots keep any result
+     * image that is still referenced valid when its surface is redrawn.
+     */
+    sk_sp<SkSurface> obtainRenderTarget(SkiaGpuContext* context, const SkImageInfo& info,
+                                        size_t slot) const;
+
+    static constexpr size_t kMaxRenderTargetSlots = 4;
+
 private:
     // To avoid downscaling artifacts, we interpolate the blurred fbo with the full composited
     // image, up to this radius.
@@ -68,6 +87,14 @@ private:
 
     // Optional blend used for crossfade only if mMaxCrossFadeRadius > 0
     const sk_sp<SkRuntimeEffect> mMixEffect;
+
+    // Scratch surfaces reused across generate() calls. Accessed only on the
+    // render thread, like the rest of the filter.
+    struct RenderTargetCacheEntry {
+        SkiaGpuContext* context = nullptr;
+        sk_sp<SkSurface> surface;
+    };
+    mutable RenderTargetCacheEntry mRenderTargets[kMaxRenderTargetSlots];
 };
 
 } // namespace skia
@@ -48,7 +48,7 @@ sk_sp<SkImage> GaussianBlurFilter::generate(SkiaGpuContext* context, const uint3
     // Create blur surface with the bit depth and colorspace of the original surface
     SkImageInfo scaledInfo = input->imageInfo().makeWH(std::ceil(blurRect.width() * kInputScale),
                                                        std::ceil(blurRect.height() * kInputScale));
-    sk_sp<SkSurface> surface = context->createRenderTarget(scaledInfo);
+    sk_sp<SkSurface> surface = obtainRenderTarget(context, scaledInfo, 0);
 
     SkPaint paint;
     paint.setBlendMode(SkBlendMode::kSrc);
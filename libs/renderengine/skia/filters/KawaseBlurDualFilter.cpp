@@ -74,11 +74,9 @@ KawaseBlurDualFilter::KawaseBlurDualFilter() : BlurFilter() {
     mBlurEffect = std::move(blurEffect);
 }
 
-static sk_sp<SkSurface> makeSurface(SkiaGpuContext* context, const SkRect& origRect, int scale) {
-    SkImageInfo scaledInfo =
-            SkImageInfo::MakeN32Premul(ceil(static_cast<float>(origRect.width()) / scale),
-                                       ceil(static_cast<float>(origRect.height()) / scale));
-    return context->createRenderTarget(scaledInfo);
+static SkImageInfo makeScaledInfo(const SkRect& origRect, int scale) {
+    return SkImageInfo::MakeN32Premul(ceil(static_cast<float>(origRect.width()) / scale),
+                                      ceil(static_cast<float>(origRect.height()) / scale));
 }
 
 void KawaseBlurDualFilter::blurInto(const sk_sp<SkSurface>& drawSurface,
@@ -121,12 +119,26 @@ sk_sp<SkImage> KawaseBlurDualFilter::generate(SkiaGpuContext* context, const uin
             std::min(kMaxSurfaces - 1.0f, 1.0f + std::max(0.0f, log2f(radius * kInputScale)));
     const int filterPasses = std::min(kMaxSurfaces - 1, static_cast<int>(ceil(filterDepth)));
 
-    // Render into surfaces downscaled by 1x, 1x, 2x, and 4x from the initial downscale.
+    // Render into surfaces downscaled by 1x, 1x, 2x, and 4x from the initial downscale. The
+    // surfaces are reused from the previous frame while the blur geometry is stable.
+    static_assert(kMaxSurfaces <= kMaxRenderTargetSlots);
     sk_sp<SkSurface> surfaces[kMaxSurfaces] =
-            {filterPasses >= 0 ? makeSurface(context, blurRect, 1 * kInverseInputScale) : nullptr,
-             filterPasses >= 1 ? makeSurface(context, blurRect, 1 * kInverseInputScale) : nullptr,
-             filterPasses >= 2 ? makeSurface(context, blurRect, 2 * kInverseInputScale) : nullptr,
-             filterPasses >= 3 ? makeSurface(context, blurRect, 4 * kInverseInputScale) : nullptr};
+            {filterPasses >= 0
+                     ? obtainRenderTarget(context, makeScaledInfo(blurRect, 1 * kInverseInputScale),
+                                          0)
+                     : nullptr,
+             filterPasses >= 1
+                     ? obtainRenderTarget(context, makeScaledInfo(blurRect, 1 * kInverseInputScale),
+                                          1)
+                     : nullptr,
+             filterPasses >= 2
+                     ? obtainRenderTarget(context, makeScaledInfo(blurRect, 2 * kInverseInputScale),
+                                          2)
+                     : nullptr,
+             filterPasses >= 3
+                     ? obtainRenderTarget(context, makeScaledInfo(blurRect, 4 * kInverseInputScale),
+                                          3)
+                     : nullptr};
 
     // These weights for scaling offsets per-pass are handpicked to look good at 1 <= radius <= 600.
     static const float kWeights[7] = {1.0f, 2.0f, 3.5f, 1.0f, 2.0f, 2.0f, 2.0f};
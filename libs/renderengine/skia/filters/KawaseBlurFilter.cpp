@@ -107,7 +107,7 @@ sk_sp<SkImage> KawaseBlurFilter::generate(SkiaGpuContext* context, const uint32_
             input->makeShader(SkTileMode::kClamp, SkTileMode::kClamp, linear, blurMatrix);
     blurBuilder.uniform("in_blurOffset") = radiusByPasses * kInputScale;
 
-    sk_sp<SkSurface> surface = context->createRenderTarget(scaledInfo);
+    sk_sp<SkSurface> surface = obtainRenderTarget(context, scaledInfo, 0);
     LOG_ALWAYS_FATAL_IF(!surface, "%s: Failed to create surface for blurring!", __func__);
     sk_sp<SkImage> tmpBlur = makeImage(surface.get(), &blurBuilder);
 
@@ -117,7 +117,7 @@ sk_sp<SkImage> KawaseBlurFilter::generate(SkiaGpuContext* context, const uint32_
     if (numberOfPasses <= 1) {
         LOG_ALWAYS_FATAL_IF(tmpBlur == nullptr, "%s: tmpBlur is null", __func__);
     } else {
-        surfaceTwo = surface->makeSurface(scaledInfo);
+        surfaceTwo = obtainRenderTarget(context, scaledInfo, 1);
         LOG_ALWAYS_FATAL_IF(!surfaceTwo, "%s: Failed to create second blur surface!", __func__);
 
         for (auto i = 1; i < numberOfPasses; i++) {
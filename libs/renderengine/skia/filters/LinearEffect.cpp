@@ -45,15 +45,20 @@ sk_sp<SkShader> createLinearEffectShader(
         sk_sp<SkRuntimeEffect> runtimeEffect, const mat4& colorTransform, float maxDisplayLuminance,
         float currentDisplayLuminanceNits, float maxLuminance, AHardwareBuffer* buffer,
         aidl::android::hardware::graphics::composer3::RenderIntent renderIntent) {
-    SFTRACE_CALL();
-    SkRuntimeShaderBuilder effectBuilder(runtimeEffect);
-
-    effectBuilder.child("child") = shader;
-
     const auto uniforms =
             shaders::buildLinearEffectUniforms(linearEffect, colorTransform, maxDisplayLuminance,
                                                currentDisplayLuminanceNits, maxLuminance, buffer,
                                                renderIntent);
+    return createLinearEffectShader(std::move(shader), std::move(runtimeEffect), uniforms);
+}
+
+sk_sp<SkShader> createLinearEffectShader(sk_sp<SkShader> shader,
+                                         sk_sp<SkRuntimeEffect> runtimeEffect,
+                                         const std::vector<tonemap::ShaderUniform>& uniforms) {
+    SFTRACE_CALL();
+    SkRuntimeShaderBuilder effectBuilder(runtimeEffect);
+
+    effectBuilder.child("child") = shader;
 
     for (const auto& uniform : uniforms) {
         effectBuilder.uniform(uniform.name.c_str()).set(uniform.value.data(), uniform.value.size());
@@ -49,6 +49,12 @@ sk_sp<SkShader> createLinearEffectShader(
         sk_sp<SkRuntimeEffect> runtimeEffect, const mat4& colorTransform, float maxDisplayLuminance,
         float currentDisplayLuminanceNits, float maxLuminance, AHardwareBuffer* buffer,
         aidl::android::hardware::graphics::composer3::RenderIntent renderIntent);
+
+// Variant of the above for callers that have already built (or cached) the uniform
+// values to bind to the runtime effect.
+sk_sp<SkShader> createLinearEffectShader(sk_sp<SkShader> inputShader,
+                                         sk_sp<SkRuntimeEffect> runtimeEffect,
+                                         const std::vector<tonemap::ShaderUniform>& uniforms);
 } // namespace skia
 } // namespace renderengine
 } // namespace android
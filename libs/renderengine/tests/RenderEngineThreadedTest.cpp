@@ -67,10 +67,9 @@ TEST_F(RenderEngineThreadedTest, primeCache) {
     PrimeCacheConfig config;
     config.cacheUltraHDR = false;
     EXPECT_CALL(*mRenderEngine, primeCache(EqConfig(config)));
-    mThreadedRE->primeCache(config);
-    // need to call ANY synchronous function after primeCache to ensure that primeCache has
-    // completed asynchronously before the test completes execution.
-    mThreadedRE->getContextPriority();
+    // primeCache runs on the background lane, so synchronous calls may overtake it; wait
+    // on its future to ensure it has completed before the test completes execution.
+    mThreadedRE->primeCache(config).wait();
 }
 
 TEST_F(RenderEngineThreadedTest, genTextures) {
@@ -197,6 +196,33 @@ TEST_F(RenderEngineThreadedTest, drawLayers) {
     ASSERT_TRUE(result.ok());
 }
 
+TEST_F(RenderEngineThreadedTest, drawLayers_backgroundPriority) {
+    renderengine::DisplaySettings settings;
+    settings.queuePriority = renderengine::DisplaySettings::QueuePriority::Background;
+    std::vector<renderengine::LayerSettings> layers;
+    std::shared_ptr<renderengine::ExternalTexture> buffer = std::make_shared<
+            renderengine::impl::
+                    ExternalTexture>(sp<GraphicBuffer>::make(), *mRenderEngine,
+                                     renderengine::impl::ExternalTexture::Usage::READABLE |
+                                             renderengine::impl::ExternalTexture::Usage::WRITEABLE);
+
+    base::unique_fd bufferFence;
+
+    EXPECT_CALL(*mRenderEngine, useProtectedContext(false));
+    EXPECT_CALL(*mRenderEngine, drawLayersInternal)
+            .WillOnce([&](const std::shared_ptr<std::promise<FenceResult>>&& resultPromise,
+                          const renderengine::DisplaySettings&,
+                          const std::vector<renderengine::LayerSettings>&,
+                          const std::shared_ptr<renderengine::ExternalTexture>&, const bool,
+                          base::unique_fd&&) { resultPromise->set_value(Fence::NO_FENCE); });
+
+    ftl::Future<FenceResult> future =
+            mThreadedRE->drawLayers(settings, layers, buffer, false, std::move(bufferFence));
+    ASSERT_TRUE(future.valid());
+    auto result = future.get();
+    ASSERT_TRUE(result.ok());
+}
+
 TEST_F(RenderEngineThreadedTest, drawLayers_protectedLayer) {
     renderengine::DisplaySettings settings;
     auto layerBuffer = sp<GraphicBuffer>::make();
@@ -99,6 +99,9 @@ void RenderEngineThreaded::threadMain(CreateInstanceFactory factory) NO_THREAD_S
     mInitializedCondition.notify_all();
 
     while (mRunning) {
+        // Frame-critical work always runs before queued background work. Because only one
+        // task is popped per iteration, a frame draw submitted while a long background
+        // queue is pending only waits for the task currently executing.
         const auto getNextTask = [this]() -> std::optional<Work> {
             std::scoped_lock lock(mThreadMutex);
             if (!mFunctionCalls.empty()) {
@@ -106,6 +109,11 @@ void RenderEngineThreaded::threadMain(CreateInstanceFactory factory) NO_THREAD_S
                 mFunctionCalls.pop();
                 return std::make_optional<Work>(task);
             }
+            if (!mBackgroundCalls.empty()) {
+                Work task = mBackgroundCalls.front();
+                mBackgroundCalls.pop();
+                return std::make_optional<Work>(task);
+            }
             return std::nullopt;
         };
 
@@ -117,7 +125,7 @@ void RenderEngineThreaded::threadMain(CreateInstanceFactory factory) NO_THREAD_S
 
         std::unique_lock<std::mutex> lock(mThreadMutex);
         mCondition.wait(lock, [this]() REQUIRES(mThreadMutex) {
-            return !mRunning || !mFunctionCalls.empty();
+            return !mRunning || !mFunctionCalls.empty() || !mBackgroundCalls.empty();
         });
     }
 
@@ -140,7 +148,7 @@ std::future<void> RenderEngineThreaded::primeCache(PrimeCacheConfig config) {
     // for the futures.
     {
         std::lock_guard lock(mThreadMutex);
-        mFunctionCalls.push([resultPromise, config](renderengine::RenderEngine& instance) {
+        mBackgroundCalls.push([resultPromise, config](renderengine::RenderEngine& instance) {
             SFTRACE_NAME("REThreaded::primeCache");
             if (setSchedFifo(false) != NO_ERROR) {
                 ALOGW("Couldn't set SCHED_OTHER for primeCache");
@@ -313,13 +321,16 @@ ftl::Future<FenceResult> RenderEngineThreaded::drawLayers(
     {
         std::lock_guard lock(mThreadMutex);
         mNeedsPostRenderCleanup = true;
-        mFunctionCalls.push([resultPromise, display, layers, buffer, useFramebufferCache,
-                             fd](renderengine::RenderEngine& instance) {
-                    SFTRACE_NAME("REThreaded::drawLayers");
-                    instance.updateProtectedContext(layers, {buffer.get()});
-                    instance.drawLayersInternal(std::move(resultPromise), display, layers, buffer,
-                                                useFramebufferCache, base::unique_fd(fd));
-                });
+        auto& queue = display.queuePriority == DisplaySettings::QueuePriority::Background
+                ? mBackgroundCalls
+                : mFunctionCalls;
+        queue.push([resultPromise, display, layers, buffer, useFramebufferCache,
+                    fd](renderengine::RenderEngine& instance) {
+            SFTRACE_NAME("REThreaded::drawLayers");
+            instance.updateProtectedContext(layers, {buffer.get()});
+            instance.drawLayersInternal(std::move(resultPromise), display, layers, buffer,
+                                        useFramebufferCache, base::unique_fd(fd));
+        });
     }
     mCondition.notify_one();
     return resultFuture;
@@ -109,6 +109,11 @@ private:
 
     using Work = std::function<void(renderengine::RenderEngine&)>;
     mutable std::queue<Work> mFunctionCalls GUARDED_BY(mThreadMutex);
+    // Lane for work whose latency does not gate the next frame: shader priming and draws
+    // tagged DisplaySettings::QueuePriority::Background (e.g. screen captures). Drained
+    // only when mFunctionCalls is empty, so queued background renders never delay
+    // composition. Tasks within each lane still execute in FIFO order.
+    mutable std::queue<Work> mBackgroundCalls GUARDED_BY(mThreadMutex);
     mutable std::condition_variable mCondition;
 
     // Used to allow select thread safe methods to be accessed without requiring the
@@ -62,4 +62,13 @@
       TRACE_CATEGORY_DATABASE | TRACE_CATEGORY_NETWORK | TRACE_CATEGORY_ADB | \
       TRACE_CATEGORY_VIBRATOR | TRACE_CATEGORY_AIDL | TRACE_CATEGORY_NNAPI |  \
       TRACE_CATEGORY_RRO | TRACE_CATEGORY_THERMAL
+
+// Compile-time category filter. Products can narrow this mask (via cflags) to compile
+// entire categories out of libtracing_perfetto: every trace entry point then reduces to
+// a single predictable branch on a constant for the filtered categories, with no atomic
+// loads or category lookups. The default keeps all categories compiled in, in which case
+// the filter folds away entirely.
+#ifndef TRACE_CATEGORIES_COMPILED_IN
+#define TRACE_CATEGORIES_COMPILED_IN (~0ull)
+#endif
 #endif  // TRACE_CATEGORIES_H
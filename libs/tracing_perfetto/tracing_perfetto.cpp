@@ -25,11 +25,25 @@
 
 namespace tracing_perfetto {
 
+namespace {
+
+// Events for categories compiled out via TRACE_CATEGORIES_COMPILED_IN cost exactly this
+// branch on a constant; with the default mask the check folds away at compile time.
+constexpr bool isCategoryCompiledIn(uint64_t category) {
+  return (category & TRACE_CATEGORIES_COMPILED_IN) != 0;
+}
+
+}  // namespace
+
 void registerWithPerfetto(bool test) {
   internal::registerWithPerfetto(test);
 }
 
 void traceBegin(uint64_t category, const char* name) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -41,6 +55,10 @@ void traceBegin(uint64_t category, const char* name) {
 }
 
 void traceFormatBegin(uint64_t category, const char* fmt, ...) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
   const bool preferAtrace = internal::shouldPreferAtrace(perfettoTeCategory, category);
@@ -66,6 +84,10 @@ void traceFormatBegin(uint64_t category, const char* fmt, ...) {
 }
 
 void traceEnd(uint64_t category) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -77,6 +99,10 @@ void traceEnd(uint64_t category) {
 }
 
 void traceAsyncBegin(uint64_t category, const char* name, int32_t cookie) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -88,6 +114,10 @@ void traceAsyncBegin(uint64_t category, const char* name, int32_t cookie) {
 }
 
 void traceAsyncEnd(uint64_t category, const char* name, int32_t cookie) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -100,6 +130,10 @@ void traceAsyncEnd(uint64_t category, const char* name, int32_t cookie) {
 
 void traceAsyncBeginForTrack(uint64_t category, const char* name,
                                const char* trackName, int32_t cookie) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -112,6 +146,10 @@ void traceAsyncBeginForTrack(uint64_t category, const char* name,
 
 void traceAsyncEndForTrack(uint64_t category, const char* trackName,
                              int32_t cookie) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -123,6 +161,10 @@ void traceAsyncEndForTrack(uint64_t category, const char* trackName,
 }
 
 void traceInstant(uint64_t category, const char* name) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -134,6 +176,10 @@ void traceInstant(uint64_t category, const char* name) {
 }
 
 void traceFormatInstant(uint64_t category, const char* fmt, ...) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
   const bool preferAtrace = internal::shouldPreferAtrace(perfettoTeCategory, category);
@@ -159,6 +205,10 @@ void traceFormatInstant(uint64_t category, const char* fmt, ...) {
 
 void traceInstantForTrack(uint64_t category, const char* trackName,
                             const char* name) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -170,6 +220,10 @@ void traceInstantForTrack(uint64_t category, const char* trackName,
 }
 
 void traceCounter(uint64_t category, const char* name, int64_t value) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
 
@@ -181,6 +235,10 @@ void traceCounter(uint64_t category, const char* name, int64_t value) {
 }
 
 void traceCounter32(uint64_t category, const char* name, int32_t value) {
+  if (!isCategoryCompiledIn(category)) {
+    return;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory = internal::toPerfettoCategory(category);
   if (internal::shouldPreferAtrace(perfettoTeCategory, category)) {
     atrace_int(category, name, value);
@@ -191,6 +249,10 @@ void traceCounter32(uint64_t category, const char* name, int32_t value) {
 }
 
 bool isTagEnabled(uint64_t category) {
+  if (!isCategoryCompiledIn(category)) {
+    return false;
+  }
+
   struct PerfettoTeCategory* perfettoTeCategory =
       internal::toPerfettoCategory(category);
   return internal::isPerfettoCategoryEnabled(perfettoTeCategory)
@@ -91,15 +91,18 @@ sp<Fence> Fence::merge(const char* name, const sp<Fence>& f1,
         const sp<Fence>& f2) {
     ATRACE_CALL();
     int result;
-    // Merge the two fences.  In the case where one of the fences is not a
-    // valid fence (e.g. NO_FENCE) we merge the one valid fence with itself so
-    // that a new fence with the given name is created.
+    // Merge the two fences. In the case where one of the fences is not a
+    // valid fence (e.g. NO_FENCE) the valid fence is shared directly: a
+    // Fence's fd is immutable once created, so handing out another reference
+    // is equivalent to the rename-only sync_merge of the fence with itself
+    // that used to happen here, minus a kernel sync file creation and its
+    // eventual close. Only the requested name is lost.
     if (f1->isValid() && f2->isValid()) {
         result = sync_merge(name, f1->mFenceFd, f2->mFenceFd);
     } else if (f1->isValid()) {
-        result = sync_merge(name, f1->mFenceFd, f1->mFenceFd);
+        return f1;
     } else if (f2->isValid()) {
-        result = sync_merge(name, f2->mFenceFd, f2->mFenceFd);
+        return f2;
     } else {
         return NO_FENCE;
     }
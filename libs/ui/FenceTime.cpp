@@ -20,10 +20,17 @@
 
 #include <cutils/compiler.h>  // For CC_[UN]LIKELY
 #include <utils/Log.h>
+#include <errno.h>
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
 
 #include <memory>
+#include <mutex>
+#include <thread>
 
 namespace android {
 
@@ -284,6 +291,110 @@ status_t FenceTime::Snapshot::unflatten(
     return NO_ERROR;
 }
 
+// ============================================================================
+// FenceSignalWatcher
+// ============================================================================
+
+namespace {
+
+// Resolves fence signal times exactly once per fence. Pending fences handed to
+// watch() are registered with a process-wide epoll thread; when a fence
+// signals, the thread performs the one getSignalTime() query that caches the
+// timestamp and drops the FenceTime's reference to the fence. Every later
+// getSignalTime() call across the process then hits the cache instead of
+// issuing its own sync_file ioctl.
+//
+// This is strictly an accelerator: registration failures (or the thread dying
+// across a fork) leave the fence unwatched, and the existing polling paths
+// still resolve it.
+class FenceSignalWatcher {
+public:
+    static FenceSignalWatcher& getInstance() {
+        // Deliberately leaked so the watcher thread never races process exit.
+        static FenceSignalWatcher* const instance = new FenceSignalWatcher();
+        return *instance;
+    }
+
+    void watch(const std::shared_ptr<FenceTime>& fenceTime) {
+        if (CC_UNLIKELY(mEpollFd < 0)) {
+            return;
+        }
+
+        // Snapshot to atomically learn whether the fence is still pending and,
+        // if so, grab a reference to it.
+        FenceTime::Snapshot snapshot = fenceTime->getSnapshot();
+        if (snapshot.state != FenceTime::Snapshot::State::FENCE) {
+            // Already resolved or invalid; nothing to wait for.
+            return;
+        }
+
+        int fd = snapshot.fence->dup();
+        if (fd < 0) {
+            return;
+        }
+
+        auto* entry = new Entry{fenceTime, fd};
+        epoll_event event{};
+        // A sync_file polls readable once its fence signals. If it has
+        // signaled already, the event fires immediately.
+        event.events = EPOLLIN;
+        event.data.ptr = entry;
+        // epoll_ctl is safe to call concurrently with the thread's epoll_wait.
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ALOGE("FenceSignalWatcher: epoll_ctl failed: %s", strerror(errno));
+            close(fd);
+            delete entry;
+        }
+    }
+
+private:
+    struct Entry {
+        std::weak_ptr<FenceTime> fenceTime;
+        int fd;
+    };
+
+    FenceSignalWatcher() : mEpollFd(epoll_create1(EPOLL_CLOEXEC)) {
+        if (mEpollFd < 0) {
+            ALOGE("FenceSignalWatcher: epoll_create1 failed: %s", strerror(errno));
+            return;
+        }
+        std::thread([this] { threadLoop(); }).detach();
+    }
+
+    ~FenceSignalWatcher() = default;
+
+    void threadLoop() {
+        pthread_setname_np(pthread_self(), "FenceWatcher");
+        constexpr int kMaxEvents = 16;
+        epoll_event events[kMaxEvents];
+        while (true) {
+            int count = epoll_wait(mEpollFd, events, kMaxEvents, -1);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ALOGE("FenceSignalWatcher: epoll_wait failed: %s", strerror(errno));
+                return;
+            }
+            for (int i = 0; i < count; i++) {
+                auto* entry = static_cast<Entry*>(events[i].data.ptr);
+                epoll_ctl(mEpollFd, EPOLL_CTL_DEL, entry->fd, nullptr);
+                close(entry->fd);
+                if (std::shared_ptr<FenceTime> fenceTime = entry->fenceTime.lock()) {
+                    // The one query per fence; caches the timestamp and lets
+                    // the FenceTime close its fence.
+                    fenceTime->getSignalTime();
+                }
+                delete entry;
+            }
+        }
+    }
+
+    const int mEpollFd;
+};
+
+} // namespace
+
 // ============================================================================
 // FenceTimeline
 // ============================================================================
@@ -304,6 +415,10 @@ void FenceTimeline::push(const std::shared_ptr<FenceTime>& fence) {
         mQueue.pop();
     }
     mQueue.push(fence);
+    // Resolve the signal time eagerly when the fence fires so the polling
+    // below (and every other consumer of this FenceTime) reads the cached
+    // value instead of re-querying the fence.
+    FenceSignalWatcher::getInstance().watch(fence);
 }
 
 void FenceTimeline::updateSignalTimes() {
@@ -22,6 +22,29 @@ namespace android {
 
 GrallocMapper::~GrallocMapper() {}
 
+status_t GrallocMapper::getPlaneLayoutsCached(buffer_handle_t bufferHandle,
+                                              std::vector<ui::PlaneLayout>* outPlaneLayouts) const {
+    {
+        std::lock_guard<std::mutex> lock(mPlaneLayoutCacheMutex);
+        if (auto it = mPlaneLayoutCache.find(bufferHandle); it != mPlaneLayoutCache.end()) {
+            *outPlaneLayouts = it->second;
+            return NO_ERROR;
+        }
+    }
+
+    status_t error = getPlaneLayouts(bufferHandle, outPlaneLayouts);
+    if (error == NO_ERROR) {
+        std::lock_guard<std::mutex> lock(mPlaneLayoutCacheMutex);
+        mPlaneLayoutCache.emplace(bufferHandle, *outPlaneLayouts);
+    }
+    return error;
+}
+
+void GrallocMapper::evictCachedPlaneLayouts(buffer_handle_t bufferHandle) const {
+    std::lock_guard<std::mutex> lock(mPlaneLayoutCacheMutex);
+    mPlaneLayoutCache.erase(bufferHandle);
+}
+
 GrallocAllocator::~GrallocAllocator() {}
 
 } // namespace android
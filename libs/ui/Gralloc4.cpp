@@ -220,6 +220,8 @@ status_t Gralloc4Mapper::importBuffer(const native_handle_t* rawHandle,
 }
 
 void Gralloc4Mapper::freeBuffer(buffer_handle_t bufferHandle) const {
+    evictCachedPlaneLayouts(bufferHandle);
+
     auto buffer = const_cast<native_handle_t*>(bufferHandle);
     auto ret = mMapper->freeBuffer(buffer);
 
@@ -314,7 +316,7 @@ status_t Gralloc4Mapper::lock(buffer_handle_t bufferHandle, uint64_t usage, cons
     }
 
     std::vector<ui::PlaneLayout> planeLayouts;
-    status_t error = getPlaneLayouts(bufferHandle, &planeLayouts);
+    status_t error = getPlaneLayoutsCached(bufferHandle, &planeLayouts);
     if (error != NO_ERROR) {
         return error;
     }
@@ -524,6 +524,7 @@ status_t Gralloc5Mapper::importBuffer(const native_handle_t *rawHandle,
 }
 
 void Gralloc5Mapper::freeBuffer(buffer_handle_t bufferHandle) const {
+    evictCachedPlaneLayouts(bufferHandle);
     mMapper->v5.freeBuffer(bufferHandle);
 }
 
@@ -621,7 +622,7 @@ status_t Gralloc5Mapper::lock(buffer_handle_t bufferHandle, uint64_t usage, cons
     };
 
     std::vector<ui::PlaneLayout> planeLayouts;
-    status_t error = getPlaneLayouts(bufferHandle, &planeLayouts);
+    status_t error = getPlaneLayoutsCached(bufferHandle, &planeLayouts);
     if (error != NO_ERROR) {
         return error;
     }
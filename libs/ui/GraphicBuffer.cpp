@@ -19,6 +19,13 @@
 
 #include <ui/GraphicBuffer.h>
 
+#include <sys/stat.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <cutils/atomic.h>
 
 #include <grallocusage/GrallocUsageConversion.h>
@@ -29,6 +36,142 @@
 
 namespace android {
 
+namespace {
+
+// Identity fingerprint of an arriving raw handle: gralloc's integer words plus
+// the device/inode of every fd. Handles referring to the same allocation
+// (dup'd dma-bufs) match; handles from different allocations cannot, since
+// every live dma-buf has a distinct inode. The flattened buffer id is
+// guessable across clients (pid plus counter), so the cache must not share an
+// import on the id alone — a forged or recycled id with matching geometry
+// would otherwise alias one client's buffer to another's allocation.
+struct HandleFingerprint {
+    std::vector<int> ints;
+    std::vector<std::pair<dev_t, ino_t>> fds;
+
+    static bool make(const native_handle_t* handle, HandleFingerprint* out) {
+        out->ints.assign(handle->data + handle->numFds,
+                         handle->data + handle->numFds + handle->numInts);
+        out->fds.clear();
+        out->fds.reserve(static_cast<size_t>(handle->numFds));
+        for (int i = 0; i < handle->numFds; i++) {
+            struct stat st;
+            if (fstat(handle->data[i], &st) != 0) {
+                return false;
+            }
+            out->fds.emplace_back(st.st_dev, st.st_ino);
+        }
+        return true;
+    }
+
+    bool operator==(const HandleFingerprint& other) const {
+        return ints == other.ints && fds == other.fds;
+    }
+};
+
+// Per-process cache of imported gralloc handles, keyed by the stable buffer
+// id (GraphicBuffer::getId). When the same allocation is unflattened
+// repeatedly — the common case when a BufferQueue slot cycles the same
+// buffer — the import is shared and refcounted instead of asking the HAL to
+// import the handle again. This generalizes what ClientCache does inside
+// SurfaceFlinger to every libui user.
+class ImportedBufferCache {
+public:
+    static ImportedBufferCache& get() {
+        static ImportedBufferCache sCache;
+        return sCache;
+    }
+
+    // Returns a cached import for `id` if one exists with matching geometry
+    // and `rawHandle` provably refers to the same underlying allocation,
+    // otherwise imports `rawHandle` through the mapper and caches the result.
+    // On success the returned handle is owned by the cache; the caller must
+    // give it back via release().
+    status_t importBuffer(uint64_t id, const native_handle_t* rawHandle, uint32_t width,
+                          uint32_t height, uint32_t layerCount, PixelFormat format, uint64_t usage,
+                          uint32_t stride, GraphicBufferMapper& mapper,
+                          buffer_handle_t* outHandle) {
+        HandleFingerprint fingerprint;
+        if (!HandleFingerprint::make(rawHandle, &fingerprint)) {
+            // Can't establish the allocation's identity; import without caching.
+            return mapper.importBuffer(rawHandle, width, height, layerCount, format, usage,
+                                       stride, outHandle);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mEntries.find(id);
+        if (it != mEntries.end()) {
+            Entry& entry = it->second;
+            if (entry.width == width && entry.height == height &&
+                entry.layerCount == layerCount && entry.format == format &&
+                entry.usage == usage && entry.stride == stride &&
+                entry.fingerprint == fingerprint) {
+                entry.refCount++;
+                *outHandle = entry.handle;
+                return NO_ERROR;
+            }
+            // Same id but different metadata or a different underlying
+            // allocation (forged or pid-recycled id); don't trust the cache
+            // entry. Fall through to a plain import, which release() will
+            // free directly since it is not tracked here.
+        }
+
+        buffer_handle_t importedHandle;
+        status_t err = mapper.importBuffer(rawHandle, width, height, layerCount, format, usage,
+                                           stride, &importedHandle);
+        if (err != NO_ERROR) {
+            return err;
+        }
+        if (it == mEntries.end()) {
+            mEntries.emplace(id,
+                             Entry{importedHandle, width, height, layerCount, format, usage,
+                                   stride, /*refCount=*/1, std::move(fingerprint)});
+            mHandleToId.emplace(importedHandle, id);
+        }
+        *outHandle = importedHandle;
+        return NO_ERROR;
+    }
+
+    // Drops a reference on `handle`. Handles not owned by the cache (plain
+    // imports) are freed through the mapper directly.
+    void release(buffer_handle_t handle, GraphicBufferMapper& mapper) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        auto handleIt = mHandleToId.find(handle);
+        if (handleIt == mHandleToId.end()) {
+            lock.unlock();
+            mapper.freeBuffer(handle);
+            return;
+        }
+        auto entryIt = mEntries.find(handleIt->second);
+        LOG_ALWAYS_FATAL_IF(entryIt == mEntries.end(), "cached handle with no entry");
+        if (--entryIt->second.refCount == 0) {
+            mEntries.erase(entryIt);
+            mHandleToId.erase(handleIt);
+            lock.unlock();
+            mapper.freeBuffer(handle);
+        }
+    }
+
+private:
+    struct Entry {
+        buffer_handle_t handle;
+        uint32_t width;
+        uint32_t height;
+        uint32_t layerCount;
+        PixelFormat format;
+        uint64_t usage;
+        uint32_t stride;
+        int refCount;
+        HandleFingerprint fingerprint;
+    };
+
+    std::mutex mMutex;
+    std::unordered_map<uint64_t, Entry> mEntries;
+    std::unordered_map<buffer_handle_t, uint64_t> mHandleToId;
+};
+
+} // namespace
+
 // ===========================================================================
 // Buffer and implementation of ANativeWindowBuffer
 // ===========================================================================
@@ -172,7 +315,9 @@ GraphicBuffer::~GraphicBuffer()
 void GraphicBuffer::free_handle()
 {
     if (mOwner == ownHandle) {
-        mBufferMapper.freeBuffer(handle);
+        // The handle may be shared with other unflattened copies of the same
+        // buffer; the cache frees it once the last reference is gone.
+        ImportedBufferCache::get().release(handle, mBufferMapper);
     } else if (mOwner == ownData) {
         GraphicBufferAllocator& allocator(GraphicBufferAllocator::get());
         allocator.free(handle);
@@ -590,8 +735,10 @@ status_t GraphicBuffer::unflatten(void const*& buffer, size_t& size, int const*&
 
     if (handle != nullptr) {
         buffer_handle_t importedHandle;
-        status_t err = mBufferMapper.importBuffer(handle, uint32_t(width), uint32_t(height),
-                uint32_t(layerCount), format, usage, uint32_t(stride), &importedHandle);
+        status_t err = ImportedBufferCache::get()
+                               .importBuffer(mId, handle, uint32_t(width), uint32_t(height),
+                                             uint32_t(layerCount), format, usage, uint32_t(stride),
+                                             mBufferMapper, &importedHandle);
         if (err != NO_ERROR) {
             width = height = stride = format = usage_deprecated = 0;
             layerCount = 0;
@@ -313,13 +313,13 @@ status_t GraphicBufferMapper::getChromaSiting(buffer_handle_t bufferHandle,
 
 status_t GraphicBufferMapper::getPlaneLayouts(buffer_handle_t bufferHandle,
                                               std::vector<ui::PlaneLayout>* outPlaneLayouts) {
-    return mMapper->getPlaneLayouts(bufferHandle, outPlaneLayouts);
+    return mMapper->getPlaneLayoutsCached(bufferHandle, outPlaneLayouts);
 }
 
 ui::Result<std::vector<ui::PlaneLayout>> GraphicBufferMapper::getPlaneLayouts(
         buffer_handle_t bufferHandle) {
     std::vector<ui::PlaneLayout> temp;
-    status_t status = mMapper->getPlaneLayouts(bufferHandle, &temp);
+    status_t status = mMapper->getPlaneLayoutsCached(bufferHandle, &temp);
     if (status == OK) {
         return std::move(temp);
     } else {
@@ -381,5 +381,23 @@ status_t GraphicBufferMapper::setSmpte2094_10(buffer_handle_t bufferHandle,
     return mMapper->setSmpte2094_10(bufferHandle, smpte2094_10);
 }
 
+status_t GraphicBufferMapper::getCompositionMetadata(buffer_handle_t bufferHandle,
+                                                     CompositionMetadata* outMetadata) {
+    status_t error = mMapper->getDataspace(bufferHandle, &outMetadata->dataspace);
+    if (mMapper->getBlendMode(bufferHandle, &outMetadata->blendMode) != NO_ERROR) {
+        outMetadata->blendMode = ui::BlendMode::INVALID;
+    }
+    if (mMapper->getSmpte2086(bufferHandle, &outMetadata->smpte2086) != NO_ERROR) {
+        outMetadata->smpte2086.reset();
+    }
+    if (mMapper->getCta861_3(bufferHandle, &outMetadata->cta861_3) != NO_ERROR) {
+        outMetadata->cta861_3.reset();
+    }
+    if (mMapper->getSmpte2094_40(bufferHandle, &outMetadata->smpte2094_40) != NO_ERROR) {
+        outMetadata->smpte2094_40.reset();
+    }
+    return error;
+}
+
 // ---------------------------------------------------------------------------
 }; // namespace android
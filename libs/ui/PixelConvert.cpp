@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ui/PixelConvert.h>
+
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define UI_PIXEL_CONVERT_HAS_NEON 1
+#endif
+
+namespace android::ui {
+
+void swapRedBlue8888(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                     size_t srcStrideBytes, uint32_t width, uint32_t height) {
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t* s = src + y * srcStrideBytes;
+        uint8_t* d = dst + y * dstStrideBytes;
+        uint32_t x = 0;
+#ifdef UI_PIXEL_CONVERT_HAS_NEON
+        for (; x + 16 <= width; x += 16, s += 64, d += 64) {
+            uint8x16x4_t px = vld4q_u8(s);
+            const uint8x16_t r = px.val[0];
+            px.val[0] = px.val[2];
+            px.val[2] = r;
+            vst4q_u8(d, px);
+        }
+#endif
+        for (; x < width; x++, s += 4, d += 4) {
+            const uint8_t r = s[0];
+            const uint8_t g = s[1];
+            const uint8_t b = s[2];
+            const uint8_t a = s[3];
+            d[0] = b;
+            d[1] = g;
+            d[2] = r;
+            d[3] = a;
+        }
+    }
+}
+
+void convertRGBA8888ToRGB565(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                             size_t srcStrideBytes, uint32_t width, uint32_t height) {
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t* s = src + y * srcStrideBytes;
+        uint16_t* d = reinterpret_cast<uint16_t*>(dst + y * dstStrideBytes);
+        uint32_t x = 0;
+#ifdef UI_PIXEL_CONVERT_HAS_NEON
+        for (; x + 8 <= width; x += 8, s += 32, d += 8) {
+            const uint8x8x4_t px = vld4_u8(s);
+            // Build RRRRRGGG GGGBBBBB by inserting each widened channel below the previous
+            // one: r << 8 keeps the top 5 red bits, then vsri inserts g << 3 and b >> 3.
+            uint16x8_t out = vshll_n_u8(px.val[0], 8);
+            out = vsriq_n_u16(out, vshll_n_u8(px.val[1], 8), 5);
+            out = vsriq_n_u16(out, vshll_n_u8(px.val[2], 8), 11);
+            vst1q_u16(d, out);
+        }
+#endif
+        for (; x < width; x++, s += 4, d++) {
+            *d = static_cast<uint16_t>(((s[0] & 0xf8) << 8) | ((s[1] & 0xfc) << 3) | (s[2] >> 3));
+        }
+    }
+}
+
+void flipHorizontal8888(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                        size_t srcStrideBytes, uint32_t width, uint32_t height) {
+    for (uint32_t y = 0; y < height; y++) {
+        const uint32_t* s = reinterpret_cast<const uint32_t*>(src + y * srcStrideBytes);
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst + y * dstStrideBytes) + width;
+        uint32_t x = 0;
+#ifdef UI_PIXEL_CONVERT_HAS_NEON
+        for (; x + 4 <= width; x += 4, s += 4) {
+            uint32x4_t px = vld1q_u32(s);
+            px = vrev64q_u32(px);
+            px = vextq_u32(px, px, 2);
+            d -= 4;
+            vst1q_u32(d, px);
+        }
+#endif
+        for (; x < width; x++, s++) {
+            *--d = *s;
+        }
+    }
+}
+
+void flipVertical8888(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                      size_t srcStrideBytes, uint32_t width, uint32_t height) {
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (uint32_t y = 0; y < height; y++) {
+        memcpy(dst + (height - 1 - y) * dstStrideBytes, src + y * srcStrideBytes, rowBytes);
+    }
+}
+
+} // namespace android::ui
@@ -28,6 +28,12 @@
 #include <ui/Region.h>
 #include <ui/RegionHelper.h>
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // ----------------------------------------------------------------------------
 
 // ### VALIDATE_REGIONS ###
@@ -312,11 +318,28 @@ void Region::addRectUnchecked(int l, int t, int r, int b)
 
 // ----------------------------------------------------------------------------
 
+static inline bool rectContains(const Rect& a, const Rect& b) {
+    return a.left <= b.left && a.top <= b.top && a.right >= b.right && a.bottom >= b.bottom;
+}
+
 Region& Region::orSelf(const Rect& r) {
     if (isEmpty()) {
         set(r);
         return *this;
     }
+    // Scrolling surfaces repeatedly OR a moving damage rect into the accumulated
+    // damage, and the union frequently degenerates to one of the operands. Catching
+    // that here avoids copying the region and re-running the span rasterizer.
+    if (r.isValid()) {
+        const Rect bounds(getBounds());
+        if (rectContains(r, bounds)) {
+            set(r);
+            return *this;
+        }
+        if (isRect() && rectContains(bounds, r)) {
+            return *this;
+        }
+    }
     return operationSelf(r, op_or);
 }
 Region& Region::xorSelf(const Rect& r) {
@@ -341,6 +364,10 @@ Region& Region::orSelf(const Region& rhs) {
         *this = rhs;
         return *this;
     }
+    if (rhs.isRect()) {
+        // Take the degenerate-union fast paths for a single-rect rhs.
+        return orSelf(rhs.getBounds());
+    }
     return operationSelf(rhs, op_or);
 }
 Region& Region::xorSelf(const Region& rhs) {
@@ -465,6 +492,67 @@ const Region Region::operation(const Region& rhs, int dx, int dy, uint32_t op) c
 
 // ----------------------------------------------------------------------------
 
+// Returns whether two spans cover the same horizontal extents, i.e.
+// p[i].left == q[i].left && p[i].right == q[i].right for all i. This runs for
+// every flushed span during boolean operations, so it is vectorized where the
+// target supports it; top/bottom lanes are ignored by construction.
+static bool spansHaveSameExtents(Rect const* p, Rect const* q, size_t count) {
+#if defined(__aarch64__)
+    while (count >= 4) {
+        int32x4x4_t a = vld4q_s32(reinterpret_cast<const int32_t*>(p));
+        int32x4x4_t b = vld4q_s32(reinterpret_cast<const int32_t*>(q));
+        uint32x4_t eq = vandq_u32(vceqq_s32(a.val[0], b.val[0]), vceqq_s32(a.val[2], b.val[2]));
+        if (vminvq_u32(eq) == 0) {
+            return false;
+        }
+        p += 4;
+        q += 4;
+        count -= 4;
+    }
+#elif defined(__SSE2__)
+    while (count != 0) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+        // lanes 0 and 2 hold left and right
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)) & 0x0f0f) != 0x0f0f) {
+            return false;
+        }
+        p++;
+        q++;
+        count--;
+    }
+#endif
+    while (count != 0) {
+        if ((p->left != q->left) || (p->right != q->right)) {
+            return false;
+        }
+        p++;
+        q++;
+        count--;
+    }
+    return true;
+}
+
+// Rewrites the bottom edge of count consecutive rects, used when a flushed
+// span extends the previous one downwards.
+static void setSpanBottoms(Rect* r, size_t count, int32_t bottom) {
+#if defined(__aarch64__)
+    const int32x4_t vb = vdupq_n_s32(bottom);
+    while (count >= 4) {
+        int32x4x4_t a = vld4q_s32(reinterpret_cast<const int32_t*>(r));
+        a.val[3] = vb;
+        vst4q_s32(reinterpret_cast<int32_t*>(r), a);
+        r += 4;
+        count -= 4;
+    }
+#endif
+    while (count != 0) {
+        r->bottom = bottom;
+        r++;
+        count--;
+    }
+}
+
 // This is our region rasterizer, which merges rects and spans together
 // to obtain an optimal region.
 class Region::rasterizer : public region_operator<Rect>::region_rasterizer
@@ -535,24 +623,11 @@ void Region::rasterizer::flushSpan()
         Rect const* p = span.data();
         Rect const* q = head;
         if (p->top == q->bottom) {
-            merge = true;
-            while (q != tail) {
-                if ((p->left != q->left) || (p->right != q->right)) {
-                    merge = false;
-                    break;
-                }
-                p++;
-                q++;
-            }
+            merge = spansHaveSameExtents(p, q, span.size());
         }
     }
     if (merge) {
-        const int bottom = span.front().bottom;
-        Rect* r = head;
-        while (r != tail) {
-            r->bottom = bottom;
-            r++;
-        }
+        setSpanBottoms(head, size_t(tail - head), span.front().bottom);
     } else {
         bounds.left = min(span.front().left, bounds.left);
         bounds.right = max(span.back().right, bounds.right);
@@ -653,6 +728,28 @@ void Region::boolean_operation(uint32_t op, Region& dst,
     validate(dst, "boolean_operation (before): dst");
 #endif
 
+    // Trivial operands short-circuit the span walk entirely; damage and
+    // visible-region math hits these constantly (empty damage, full-surface
+    // OR into an empty accumulator).
+    if (rhs.isEmpty()) {
+        if (op == op_and) {
+            dst.clear();
+        } else {
+            // or/xor/nand with an empty rhs leave lhs untouched.
+            dst = lhs;
+        }
+        return;
+    }
+    if (lhs.isEmpty()) {
+        if (op == op_or || op == op_xor) {
+            translate(dst, rhs, dx, dy);
+        } else {
+            // and/nand with an empty lhs produce nothing.
+            dst.clear();
+        }
+        return;
+    }
+
     size_t lhs_count;
     Rect const * const lhs_rects = lhs.getArray(&lhs_count);
 
@@ -67,7 +67,16 @@ Transform Transform::operator*(const Transform& rhs) const {
     if (rhs.mType == IDENTITY)
         return r;
 
-    // TODO: we could use mType to optimize the matrix multiply
+    if (CC_LIKELY((mType | rhs.mType) <= TRANSLATE)) {
+        // Both transforms are translate-only, so the concatenation is simply
+        // the sum of the translations and the resulting type is exactly known.
+        r.mMatrix[2][0] += rhs.mMatrix[2][0];
+        r.mMatrix[2][1] += rhs.mMatrix[2][1];
+        r.mType = (isZero(r.mMatrix[2][0]) && isZero(r.mMatrix[2][1])) ? IDENTITY : TRANSLATE;
+        return r;
+    }
+
+    // TODO: we could use mType to optimize the matrix multiply further
     const mat33& A(mMatrix);
     const mat33& B(rhs.mMatrix);
           mat33& D(r.mMatrix);
@@ -233,8 +242,11 @@ void Transform::set(const std::array<float, 9>& matrix) {
 }
 
 vec2 Transform::transform(const vec2& v) const {
-    vec2 r;
     const mat33& M(mMatrix);
+    if (CC_LIKELY(mType <= TRANSLATE)) {
+        return vec2(v[0] + M[2][0], v[1] + M[2][1]);
+    }
+    vec2 r;
     r[0] = M[0][0]*v[0] + M[1][0]*v[1] + M[2][0];
     r[1] = M[0][1]*v[0] + M[1][1]*v[1] + M[2][1];
     return r;
@@ -259,6 +271,29 @@ Rect Transform::makeBounds(int w, int h) const {
 
 Rect Transform::transform(const Rect& bounds, bool roundOutwards) const {
     Rect r;
+    if (CC_LIKELY(mType <= TRANSLATE)) {
+        // Translate-only transforms preserve axis-aligned rects, so there is
+        // no need to transform all four corners.
+        const float x = mMatrix[2][0];
+        const float y = mMatrix[2][1];
+        const float left = std::min(bounds.left, bounds.right) + x;
+        const float right = std::max(bounds.left, bounds.right) + x;
+        const float top = std::min(bounds.top, bounds.bottom) + y;
+        const float bottom = std::max(bounds.top, bounds.bottom) + y;
+        if (roundOutwards) {
+            r.left   = static_cast<int32_t>(floorf(left));
+            r.top    = static_cast<int32_t>(floorf(top));
+            r.right  = static_cast<int32_t>(ceilf(right));
+            r.bottom = static_cast<int32_t>(ceilf(bottom));
+        } else {
+            r.left   = static_cast<int32_t>(floorf(left + 0.5f));
+            r.top    = static_cast<int32_t>(floorf(top + 0.5f));
+            r.right  = static_cast<int32_t>(floorf(right + 0.5f));
+            r.bottom = static_cast<int32_t>(floorf(bottom + 0.5f));
+        }
+        return r;
+    }
+
     vec2 lt( bounds.left,  bounds.top    );
     vec2 rt( bounds.right, bounds.top    );
     vec2 lb( bounds.left,  bounds.bottom );
@@ -285,6 +320,17 @@ Rect Transform::transform(const Rect& bounds, bool roundOutwards) const {
 }
 
 FloatRect Transform::transform(const FloatRect& bounds) const {
+    if (CC_LIKELY(mType <= TRANSLATE)) {
+        const float x = mMatrix[2][0];
+        const float y = mMatrix[2][1];
+        FloatRect r;
+        r.left = std::min(bounds.left, bounds.right) + x;
+        r.top = std::min(bounds.top, bounds.bottom) + y;
+        r.right = std::max(bounds.left, bounds.right) + x;
+        r.bottom = std::max(bounds.top, bounds.bottom) + y;
+        return r;
+    }
+
     vec2 lt(bounds.left, bounds.top);
     vec2 rt(bounds.right, bounds.top);
     vec2 lb(bounds.left, bounds.bottom);
@@ -25,7 +25,10 @@
 #include <utils/StrongPointer.h>
 #include "GraphicBufferAllocator.h"
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace android {
 
@@ -201,6 +204,20 @@ public:
                                      std::optional<std::vector<uint8_t>> /*smpte2094_10*/) const {
         return INVALID_OPERATION;
     }
+
+    // Like getPlaneLayouts, but serves repeat queries from a per-handle cache. Plane layouts
+    // are fixed at allocation time, so once fetched they never need to cross the mapper HAL
+    // again; every ycbcr lock needs them, which makes the fetch per-frame work for media and
+    // camera clients. Implementations must call evictCachedPlaneLayouts from freeBuffer.
+    status_t getPlaneLayoutsCached(buffer_handle_t bufferHandle,
+                                   std::vector<ui::PlaneLayout>* outPlaneLayouts) const;
+
+protected:
+    void evictCachedPlaneLayouts(buffer_handle_t bufferHandle) const;
+
+private:
+    mutable std::mutex mPlaneLayoutCacheMutex;
+    mutable std::unordered_map<buffer_handle_t, std::vector<ui::PlaneLayout>> mPlaneLayoutCache;
 };
 
 // A wrapper to IAllocator
@@ -170,6 +170,22 @@ public:
     status_t setSmpte2094_10(buffer_handle_t bufferHandle,
                              std::optional<std::vector<uint8_t>> smpte2094_10);
 
+    // The metadata fields composition cares about, fetched together.
+    struct CompositionMetadata {
+        ui::Dataspace dataspace = ui::Dataspace::UNKNOWN;
+        ui::BlendMode blendMode = ui::BlendMode::INVALID;
+        std::optional<ui::Smpte2086> smpte2086;
+        std::optional<ui::Cta861_3> cta861_3;
+        std::optional<std::vector<uint8_t>> smpte2094_40;
+    };
+
+    // Retrieves all composition-relevant metadata for a buffer in one call. The mapper HALs
+    // expose no multi-get, so this issues the individual gets back to back; it gives callers
+    // a single call site that can batch for real if a future mapper version allows it. The
+    // returned status is that of the dataspace query; the HDR fields are best-effort and are
+    // left empty if the HAL cannot provide them.
+    status_t getCompositionMetadata(buffer_handle_t bufferHandle, CompositionMetadata* outMetadata);
+
     const GrallocMapper& getGrallocMapper() const {
         return reinterpret_cast<const GrallocMapper&>(*mMapper);
     }
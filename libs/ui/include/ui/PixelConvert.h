@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace android::ui {
+
+/**
+ * CPU pixel format conversion helpers for locked buffer contents, NEON-accelerated where
+ * the target supports it. These are intended for screen capture post-processing and
+ * CpuConsumer clients that would otherwise convert pixel-by-pixel in app code.
+ *
+ * All strides are in bytes and may exceed the tightly packed row size. Source and
+ * destination must not overlap unless a function explicitly allows operating in place.
+ */
+
+/**
+ * Swaps the R and B channels of a 8888 image, converting RGBA8888 to BGRA8888 or back.
+ * May be called with dst == src to convert in place.
+ */
+void swapRedBlue8888(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                     size_t srcStrideBytes, uint32_t width, uint32_t height);
+
+/**
+ * Converts an RGBA8888 image to RGB565, dropping alpha and truncating the low color bits.
+ */
+void convertRGBA8888ToRGB565(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                             size_t srcStrideBytes, uint32_t width, uint32_t height);
+
+/**
+ * Mirrors a 8888 image horizontally (left-right).
+ */
+void flipHorizontal8888(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                        size_t srcStrideBytes, uint32_t width, uint32_t height);
+
+/**
+ * Mirrors a 8888 image vertically (top-bottom).
+ */
+void flipVertical8888(uint8_t* dst, size_t dstStrideBytes, const uint8_t* src,
+                      size_t srcStrideBytes, uint32_t width, uint32_t height);
+
+} // namespace android::ui
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ui/PixelConvert.h>
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <vector>
+
+namespace android::ui {
+
+namespace {
+
+// Wide enough to cover the vectorized path plus a scalar tail, with padded strides.
+constexpr uint32_t kWidth = 21;
+constexpr uint32_t kHeight = 3;
+constexpr size_t kSrcStride = (kWidth + 3) * 4;
+constexpr size_t kDstStride = (kWidth + 5) * 4;
+
+std::vector<uint8_t> makeImage() {
+    std::vector<uint8_t> image(kSrcStride * kHeight);
+    for (size_t i = 0; i < image.size(); i++) {
+        image[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return image;
+}
+
+const uint8_t* pixelAt(const std::vector<uint8_t>& image, size_t stride, uint32_t x, uint32_t y) {
+    return image.data() + y * stride + x * 4;
+}
+
+} // namespace
+
+TEST(PixelConvertTest, SwapRedBlue8888) {
+    const auto src = makeImage();
+    std::vector<uint8_t> dst(kDstStride * kHeight);
+
+    swapRedBlue8888(dst.data(), kDstStride, src.data(), kSrcStride, kWidth, kHeight);
+
+    for (uint32_t y = 0; y < kHeight; y++) {
+        for (uint32_t x = 0; x < kWidth; x++) {
+            const uint8_t* s = pixelAt(src, kSrcStride, x, y);
+            const uint8_t* d = pixelAt(dst, kDstStride, x, y);
+            EXPECT_EQ(s[2], d[0]);
+            EXPECT_EQ(s[1], d[1]);
+            EXPECT_EQ(s[0], d[2]);
+            EXPECT_EQ(s[3], d[3]);
+        }
+    }
+}
+
+TEST(PixelConvertTest, SwapRedBlue8888InPlace) {
+    const auto src = makeImage();
+    auto image = src;
+
+    swapRedBlue8888(image.data(), kSrcStride, image.data(), kSrcStride, kWidth, kHeight);
+
+    for (uint32_t y = 0; y < kHeight; y++) {
+        for (uint32_t x = 0; x < kWidth; x++) {
+            const uint8_t* s = pixelAt(src, kSrcStride, x, y);
+            const uint8_t* d = pixelAt(image, kSrcStride, x, y);
+            EXPECT_EQ(s[2], d[0]);
+            EXPECT_EQ(s[0], d[2]);
+        }
+    }
+}
+
+TEST(PixelConvertTest, ConvertRGBA8888ToRGB565) {
+    const auto src = makeImage();
+    std::vector<uint8_t> dst((kWidth + 1) * 2 * kHeight);
+    const size_t dstStride = (kWidth + 1) * 2;
+
+    convertRGBA8888ToRGB565(dst.data(), dstStride, src.data(), kSrcStride, kWidth, kHeight);
+
+    for (uint32_t y = 0; y < kHeight; y++) {
+        for (uint32_t x = 0; x < kWidth; x++) {
+            const uint8_t* s = pixelAt(src, kSrcStride, x, y);
+            const uint16_t expected = static_cast<uint16_t>(((s[0] & 0xf8) << 8) |
+                                                            ((s[1] & 0xfc) << 3) | (s[2] >> 3));
+            uint16_t actual;
+            memcpy(&actual, dst.data() + y * dstStride + x * 2, sizeof(actual));
+            EXPECT_EQ(expected, actual) << "pixel (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST(PixelConvertTest, FlipHorizontal8888) {
+    const auto src = makeImage();
+    std::vector<uint8_t> dst(kDstStride * kHeight);
+
+    flipHorizontal8888(dst.data(), kDstStride, src.data(), kSrcStride, kWidth, kHeight);
+
+    for (uint32_t y = 0; y < kHeight; y++) {
+        for (uint32_t x = 0; x < kWidth; x++) {
+            const uint8_t* s = pixelAt(src, kSrcStride, x, y);
+            const uint8_t* d = pixelAt(dst, kDstStride, kWidth - 1 - x, y);
+            EXPECT_EQ(0, memcmp(s, d, 4)) << "pixel (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST(PixelConvertTest, FlipVertical8888) {
+    const auto src = makeImage();
+    std::vector<uint8_t> dst(kDstStride * kHeight);
+
+    flipVertical8888(dst.data(), kDstStride, src.data(), kSrcStride, kWidth, kHeight);
+
+    for (uint32_t y = 0; y < kHeight; y++) {
+        for (uint32_t x = 0; x < kWidth; x++) {
+            const uint8_t* s = pixelAt(src, kSrcStride, x, y);
+            const uint8_t* d = pixelAt(dst, kDstStride, x, kHeight - 1 - y);
+            EXPECT_EQ(0, memcmp(s, d, 4)) << "pixel (" << x << ", " << y << ")";
+        }
+    }
+}
+
+} // namespace android::ui
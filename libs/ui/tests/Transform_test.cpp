@@ -46,4 +46,32 @@ TEST(TransformTest, inverseRotation_hasCorrectType) {
     testRotationFlagsForInverse(Transform::FLIP_V, Transform::FLIP_V, false);
 }
 
+TEST(TransformTest, translateConcatenation_hasExactType) {
+    Transform a;
+    a.set(10.f, -20.f);
+    Transform b;
+    b.set(-4.f, 2.f);
+
+    const Transform ab = a * b;
+    EXPECT_EQ(ab.getType(), Transform::TRANSLATE);
+    EXPECT_EQ(ab.tx(), 6.f);
+    EXPECT_EQ(ab.ty(), -18.f);
+
+    Transform inverse;
+    inverse.set(-6.f, 18.f);
+    EXPECT_EQ((ab * inverse).getType(), Transform::IDENTITY);
+}
+
+TEST(TransformTest, translateRect) {
+    Transform translate;
+    translate.set(5.5f, -3.25f);
+
+    const Rect bounds(10, 20, 100, 200);
+    EXPECT_EQ(translate.transform(bounds, false /* roundOutwards */), Rect(16, 17, 106, 197));
+    EXPECT_EQ(translate.transform(bounds, true /* roundOutwards */), Rect(15, 16, 106, 197));
+
+    const FloatRect floatBounds(10.f, 20.f, 100.f, 200.f);
+    EXPECT_EQ(translate.transform(floatBounds), FloatRect(15.5f, 16.75f, 105.5f, 196.75f));
+}
+
 } // namespace android::ui
@@ -24,8 +24,11 @@
 #include <cutils/properties.h>
 #include <dirent.h>
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <graphicsenv/GraphicsEnv.h>
 #include <log/log.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <utils/Timers.h>
 #include <vndksupport/linker.h>
 
@@ -485,9 +488,7 @@ static std::string findLibrary(const std::string libraryName, const std::string
     return std::string();
 }
 
-static void* load_system_driver(const char* kind, const char* suffix, const bool exact) {
-    ATRACE_CALL();
-
+static std::string system_driver_path(const char* kind, const char* suffix, const bool exact) {
     std::string libraryName = std::string("lib") + kind;
     if (suffix) {
         libraryName += std::string("_") + suffix;
@@ -499,11 +500,35 @@ static void* load_system_driver(const char* kind, const char* suffix, const bool
         libraryName += std::string("_");
     }
 
+    const bool isSuffixAngle = suffix != nullptr && strcmp(suffix, ANGLE_SUFFIX_VALUE) == 0;
+    return findLibrary(libraryName, isSuffixAngle ? SYSTEM_LIB_PATH : VENDOR_LIB_EGL_DIR, exact);
+}
+
+// Asks the kernel to start paging in a driver library ahead of the dlopen that maps
+// it. The split EGL/GLESv1_CM/GLESv2 drivers are loaded serially, so prefetching lets
+// the disk reads for the later libraries overlap with linking of the earlier ones.
+static void prefetch_library(const std::string& path) {
+    if (path.empty()) {
+        return;
+    }
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        posix_fadvise(fd, 0, st.st_size, POSIX_FADV_WILLNEED);
+    }
+    close(fd);
+}
+
+static void* load_system_driver(const char* kind, const char* suffix, const bool exact) {
+    ATRACE_CALL();
+
     void* dso = nullptr;
 
     const bool isSuffixAngle = suffix != nullptr && strcmp(suffix, ANGLE_SUFFIX_VALUE) == 0;
-    const std::string absolutePath =
-            findLibrary(libraryName, isSuffixAngle ? SYSTEM_LIB_PATH : VENDOR_LIB_EGL_DIR, exact);
+    const std::string absolutePath = system_driver_path(kind, suffix, exact);
     if (absolutePath.empty()) {
         // this happens often, we don't want to log an error
         return nullptr;
@@ -673,6 +698,15 @@ Loader::driver_t* Loader::attempt_to_load_system_driver(egl_connection_t* cnx, c
         android::GraphicsEnv::getInstance().setDriverToLoad(android::GpuStatsInfo::Driver::GL);
     }
 
+    // Kick off page cache reads for every candidate library up front, so that the
+    // serial dlopen calls below find their pages already in flight.
+    {
+        ATRACE_NAME("prefetch driver libraries");
+        for (const char* kind : {"GLES", "EGL", "GLESv1_CM", "GLESv2"}) {
+            prefetch_library(system_driver_path(kind, suffix, exact));
+        }
+    }
+
     driver_t* hnd = nullptr;
     void* dso = load_system_driver("GLES", suffix, exact);
     if (dso) {
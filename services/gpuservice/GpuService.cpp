@@ -18,6 +18,10 @@
 
 #include "gpuservice/GpuService.h"
 
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <android-base/stringprintf.h>
 #include <android-base/properties.h>
 #include <binder/IPCThreadState.h>
@@ -77,6 +81,9 @@ GpuService::~GpuService() {
 
     mGpuWorkAsyncInitThread->join();
     mGpuMemAsyncInitThread->join();
+    if (mDriverPrewarmThread) {
+        mDriverPrewarmThread->join();
+    }
 }
 
 void GpuService::setGpuStats(const std::string& driverPackageName,
@@ -144,6 +151,97 @@ void GpuService::setUpdatableDriverPath(const std::string& driverPath) {
     mDeveloperDriverPath = driverPath;
 }
 
+std::vector<GpuMemTotal> GpuService::getGpuMemTotals() {
+    IPCThreadState* ipc = IPCThreadState::self();
+    const int pid = ipc->getCallingPid();
+    const int uid = ipc->getCallingUid();
+
+    std::vector<GpuMemTotal> totals;
+
+    // Per-process memory totals are only for system monitors, same as dumpsys.
+    if (uid != AID_SYSTEM &&
+        !PermissionCache::checkPermission(sAccessGpuServicePermission, pid, uid)) {
+        ALOGE("Permission Denial: can't get GPU memory totals from pid=%d, uid=%d\n", pid, uid);
+        return totals;
+    }
+
+    if (!mGpuMem->isInitialized()) return totals;
+
+    mGpuMem->traverseGpuMemTotals(
+            [&totals](int64_t, uint32_t gpuId, uint32_t memPid, uint64_t size) {
+                totals.push_back({gpuId, memPid, size});
+            });
+    return totals;
+}
+
+namespace {
+
+// Reads a file's pages into the page cache so that the next process to map it does not pay for
+// the disk I/O. posix_fadvise kicks off asynchronous readahead; nothing is pinned.
+void prewarmFile(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+}
+
+// Pre-warms every shared library in the given directory whose name starts with `prefix` (all of
+// them when the prefix is empty).
+void prewarmDriverDirectory(const std::string& dir, const char* prefix) {
+    DIR* const dp = opendir(dir.c_str());
+    if (dp == nullptr) return;
+    while (struct dirent* entry = readdir(dp)) {
+        const std::string name = entry->d_name;
+        if (name.size() < 3 || name.compare(name.size() - 3, 3, ".so") != 0) continue;
+        if (prefix[0] != '\0' && name.rfind(prefix, 0) != 0) continue;
+        prewarmFile(dir + "/" + name);
+    }
+    closedir(dp);
+}
+
+} // namespace
+
+void GpuService::prewarmGpuDriver() {
+    IPCThreadState* ipc = IPCThreadState::self();
+    const int pid = ipc->getCallingPid();
+    const int uid = ipc->getCallingUid();
+
+    // Pre-warming does I/O on behalf of the caller, so gate it like the other control surfaces.
+    if (uid != AID_SYSTEM &&
+        !PermissionCache::checkPermission(sAccessGpuServicePermission, pid, uid)) {
+        ALOGE("Permission Denial: can't prewarm GPU driver from pid=%d, uid=%d\n", pid, uid);
+        return;
+    }
+
+    // App launches can come in bursts; once the driver pages are in the page cache there is
+    // nothing left to do for a while.
+    constexpr nsecs_t kPrewarmMinInterval = s2ns(10);
+    const nsecs_t now = systemTime();
+
+    std::lock_guard<std::mutex> lock(mLock);
+    if (mLastDriverPrewarmTime != 0 && now - mLastDriverPrewarmTime < kPrewarmMinInterval) {
+        return;
+    }
+    if (mDriverPrewarmThread) {
+        mDriverPrewarmThread->join();
+    }
+    mLastDriverPrewarmTime = now;
+
+    const std::string updatableDriverPath = mDeveloperDriverPath;
+    mDriverPrewarmThread = std::make_unique<std::thread>([updatableDriverPath]() {
+        ATRACE_NAME("prewarmGpuDriver");
+        // The vendor GLES driver and the Vulkan HAL. Which of the lib/lib64 variants exist
+        // depends on the device; prewarmDriverDirectory skips the missing ones.
+        prewarmDriverDirectory("/vendor/lib64/egl", "");
+        prewarmDriverDirectory("/vendor/lib/egl", "");
+        prewarmDriverDirectory("/vendor/lib64/hw", "vulkan.");
+        prewarmDriverDirectory("/vendor/lib/hw", "vulkan.");
+        if (!updatableDriverPath.empty()) {
+            prewarmDriverDirectory(updatableDriverPath, "");
+        }
+    });
+}
+
 std::string GpuService::getUpdatableDriverPath() {
     std::lock_guard<std::mutex> lock(mLock);
     return mDeveloperDriverPath;
@@ -22,6 +22,7 @@
 #include <graphicsenv/GpuStatsInfo.h>
 #include <graphicsenv/IGpuService.h>
 #include <serviceutils/PriorityDumper.h>
+#include <utils/Timers.h>
 
 #include <mutex>
 #include <thread>
@@ -66,6 +67,8 @@ private:
     void toggleAngleAsSystemDriver(bool enabled) override;
     void addVulkanEngineName(const std::string& appPackageName, const uint64_t driverVersionCode,
                              const char *engineName) override;
+    std::vector<GpuMemTotal> getGpuMemTotals() override;
+    void prewarmGpuDriver() override;
 
     /*
      * IBinder interface
@@ -96,6 +99,10 @@ private:
     std::string mDeveloperDriverPath;
     std::unique_ptr<std::thread> mGpuMemAsyncInitThread;
     std::unique_ptr<std::thread> mGpuWorkAsyncInitThread;
+    // Driver pre-warm state, guarded by mLock. The thread reads driver libraries into the page
+    // cache; requests arriving while the last pre-warm is still fresh are ignored.
+    nsecs_t mLastDriverPrewarmTime = 0;
+    std::unique_ptr<std::thread> mDriverPrewarmThread;
 };
 
 } // namespace android
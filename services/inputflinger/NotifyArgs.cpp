@@ -25,6 +25,8 @@
 #include <math.h>
 #include <utils/Trace.h>
 
+#include <utility>
+
 using android::base::StringPrintf;
 
 namespace android {
@@ -64,7 +66,7 @@ NotifyMotionArgs::NotifyMotionArgs(
         int32_t edgeFlags, uint32_t pointerCount, const PointerProperties* pointerProperties,
         const PointerCoords* pointerCoords, float xPrecision, float yPrecision,
         float xCursorPosition, float yCursorPosition, nsecs_t downTime,
-        const std::vector<TouchVideoFrame>& videoFrames)
+        std::vector<TouchVideoFrame> videoFrames)
       : id(id),
         eventTime(eventTime),
         deviceId(deviceId),
@@ -84,7 +86,7 @@ NotifyMotionArgs::NotifyMotionArgs(
         yCursorPosition(yCursorPosition),
         downTime(downTime),
         readTime(readTime),
-        videoFrames(videoFrames) {
+        videoFrames(std::move(videoFrames)) {
     for (uint32_t i = 0; i < pointerCount; i++) {
         this->pointerProperties.emplace_back(pointerProperties[i]);
         this->pointerCoords.emplace_back(pointerCoords[i]);
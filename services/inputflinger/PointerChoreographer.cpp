@@ -204,17 +204,25 @@ void PointerChoreographer::fadeMouseCursorOnKeyPress(const android::NotifyKeyArg
 }
 
 NotifyMotionArgs PointerChoreographer::processMotion(const NotifyMotionArgs& args) {
-    std::scoped_lock _l(mLock);
-
+    // Classify the event before taking the lock so that streams that cannot affect any
+    // pointer controller do not serialize against viewport and controller updates.
     if (isFromMouse(args)) {
+        std::scoped_lock _l(mLock);
         return processMouseEventLocked(args);
     } else if (isFromTouchpad(args)) {
+        std::scoped_lock _l(mLock);
         return processTouchpadEventLocked(args);
     } else if (isFromDrawingTablet(args)) {
+        std::scoped_lock _l(mLock);
         processDrawingTabletEventLocked(args);
     } else if (mStylusPointerIconEnabled && isStylusHoverEvent(args)) {
+        std::scoped_lock _l(mLock);
         processStylusHoverEventLocked(args);
-    } else if (isFromSource(args.source, AINPUT_SOURCE_TOUCHSCREEN)) {
+    } else if (isFromSource(args.source, AINPUT_SOURCE_TOUCHSCREEN) &&
+               mTouchNeedsPointerIndicators) {
+        // Plain touchscreen traffic only needs the lock when there are touch spots to
+        // draw or a mouse pointer that may need to be faded.
+        std::scoped_lock _l(mLock);
         processTouchscreenAndStylusEventLocked(args);
     }
     return args;
@@ -441,6 +449,11 @@ void PointerChoreographer::processDeviceReset(const NotifyDeviceResetArgs& args)
 }
 
 void PointerChoreographer::onControllerAddedOrRemovedLocked() {
+    // Keep the lock-free summary used by the touchscreen hot path in sync. This is called
+    // at every point where a pointer controller is added or removed, and by
+    // updatePointerControllersLocked() when show-touches changes.
+    mTouchNeedsPointerIndicators = mShowTouchesEnabled || !mMousePointersByDisplay.empty();
+
     if (!com::android::input::flags::hide_pointer_indicators_for_secure_windows()) {
         return;
     }
@@ -22,6 +22,7 @@
 
 #include <android-base/thread_annotations.h>
 #include <gui/WindowInfosListener.h>
+#include <atomic>
 #include <type_traits>
 #include <unordered_set>
 
@@ -196,7 +197,14 @@ private:
     std::set<DeviceId> mMouseDevices GUARDED_BY(mLock);
     std::vector<DisplayViewport> mViewports GUARDED_BY(mLock);
     bool mShowTouchesEnabled GUARDED_BY(mLock);
-    bool mStylusPointerIconEnabled GUARDED_BY(mLock);
+    // Written under mLock, but also read without it on the motion hot path to gate
+    // stylus hover processing before the lock is taken.
+    std::atomic<bool> mStylusPointerIconEnabled;
+    // True iff show-touches is enabled or any mouse pointer controller exists. A summary
+    // of the locked state maintained in onControllerAddedOrRemovedLocked() so that plain
+    // touchscreen traffic - the common case on handhelds - can skip mLock entirely when
+    // there are no pointer indicators to fade or spots to draw.
+    std::atomic<bool> mTouchNeedsPointerIndicators{false};
     std::set<ui::LogicalDisplayId /*displayId*/> mDisplaysWithPointersHidden;
     ui::LogicalDisplayId mCurrentFocusedDisplay GUARDED_BY(mLock);
 
@@ -16,14 +16,63 @@
 
 #pragma once
 
-#include <utils/threads.h>
-#include <list>
-#include <mutex>
+#include <pthread.h>
+
+#include <android-base/thread_annotations.h>
+#include <deque>
 #include <optional>
 
 namespace android {
 
-/** A thread-safe FIFO queue. */
+/**
+ * A mutex backed by a priority-inheriting futex: while a thread holds the lock,
+ * it runs at the priority of the highest-priority waiter. This bounds the time a
+ * high-priority consumer can be blocked behind a lower-priority producer that was
+ * preempted inside the critical section, which a plain std::mutex does not.
+ */
+class CAPABILITY("mutex") PriorityInheritingMutex {
+public:
+    PriorityInheritingMutex() {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+        pthread_mutex_init(&mMutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+    }
+    ~PriorityInheritingMutex() { pthread_mutex_destroy(&mMutex); }
+
+    PriorityInheritingMutex(const PriorityInheritingMutex&) = delete;
+    PriorityInheritingMutex& operator=(const PriorityInheritingMutex&) = delete;
+
+    void lock() ACQUIRE() { pthread_mutex_lock(&mMutex); }
+    void unlock() RELEASE() { pthread_mutex_unlock(&mMutex); }
+
+private:
+    pthread_mutex_t mMutex;
+};
+
+/** RAII guard for PriorityInheritingMutex, visible to thread-safety analysis. */
+class SCOPED_CAPABILITY PriorityInheritingLockGuard {
+public:
+    explicit PriorityInheritingLockGuard(PriorityInheritingMutex& mutex) ACQUIRE(mutex)
+          : mMutex(mutex) {
+        mMutex.lock();
+    }
+    ~PriorityInheritingLockGuard() RELEASE() { mMutex.unlock(); }
+
+private:
+    PriorityInheritingMutex& mMutex;
+};
+
+/**
+ * A thread-safe FIFO queue.
+ *
+ * The critical sections are a handful of instructions, so the lock is the only
+ * contention point; priority inheritance keeps the consumer's latency bounded
+ * even when a lower-priority producer is preempted mid-push. Storage is a deque
+ * so bursts grow in chunks instead of allocating a node per element, and the
+ * chunks are reused by later pushes.
+ */
 template <class T>
 class SyncQueue {
 public:
@@ -33,12 +82,12 @@ public:
 
     /** Retrieve and remove the oldest object. Returns std::nullopt if the queue is empty. */
     std::optional<T> pop() {
-        std::scoped_lock lock(mLock);
+        const PriorityInheritingLockGuard lock(mLock);
         if (mQueue.empty()) {
             return {};
         }
         T t = std::move(mQueue.front());
-        mQueue.erase(mQueue.begin());
+        mQueue.pop_front();
         return t;
     };
 
@@ -49,7 +98,7 @@ public:
      */
     template <class... Args>
     bool push(Args&&... args) {
-        std::scoped_lock lock(mLock);
+        const PriorityInheritingLockGuard lock(mLock);
         if (mCapacity && mQueue.size() == mCapacity) {
             return false;
         }
@@ -59,8 +108,8 @@ public:
 
 private:
     const std::optional<size_t> mCapacity;
-    std::mutex mLock;
-    std::list<T> mQueue GUARDED_BY(mLock);
+    PriorityInheritingMutex mLock;
+    std::deque<T> mQueue GUARDED_BY(mLock);
 };
 
 } // namespace android
@@ -0,0 +1,445 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <linux/input.h>
+
+#include <InputReader.h>
+#include "../dispatcher/InputDispatcher.h"
+#include "../tests/FakeApplicationHandle.h"
+#include "../tests/FakeEventHub.h"
+#include "../tests/FakeInputDispatcherPolicy.h"
+#include "../tests/FakeInputReaderPolicy.h"
+#include "../tests/FakeWindows.h"
+
+namespace android {
+
+namespace {
+
+using inputdispatcher::FakeApplicationHandle;
+using inputdispatcher::InputDispatcher;
+
+// The eventhub id of the single replayed device.
+constexpr int32_t EVENTHUB_ID = 1;
+
+constexpr ui::LogicalDisplayId DISPLAY_ID = ui::LogicalDisplayId::DEFAULT;
+
+// Recordings are replayed as fast as the stack will take them, so a generous timeout here only
+// matters when the dispatcher legitimately drops an event.
+constexpr std::chrono::milliseconds CONSUME_TIMEOUT{500};
+
+// Name of the environment variable holding the path of an evemu recording (as produced by
+// `evemu-record`) to replay. When unset, a built-in synthetic touchscreen swipe is replayed so
+// that the benchmark always produces a result.
+constexpr const char* RECORDING_ENV_VAR = "INPUT_REPLAY_RECORDING";
+
+static nsecs_t now() {
+    return systemTime(SYSTEM_TIME_MONOTONIC);
+}
+
+struct EvemuEvent {
+    int32_t type;
+    int32_t code;
+    int32_t value;
+};
+
+/**
+ * A parsed evemu recording: the device description (name, event bits, absolute axis ranges) and
+ * the recorded event stream. Only the parts of the format needed to reconstruct the device inside
+ * FakeEventHub are retained; comments and timestamps are dropped because events are replayed
+ * back-to-back with fresh timestamps.
+ */
+struct EvemuRecording {
+    std::string name = "evemu replay device";
+    int32_t bus = 0;
+    // Event-code bitmaps from "B:" lines, keyed by event type (EV_KEY, EV_ABS, ...).
+    std::map<int32_t, std::set<int32_t>> bitsByType;
+    // Axis ranges from "A:" lines: axis -> {min, max, fuzz, flat, resolution}.
+    std::map<int32_t, std::array<int32_t, 5>> absAxes;
+    std::vector<EvemuEvent> events;
+
+    bool isMultiTouch() const {
+        return absAxes.find(ABS_MT_POSITION_X) != absAxes.end();
+    }
+
+    bool hasBit(int32_t type, int32_t code) const {
+        const auto it = bitsByType.find(type);
+        return it != bitsByType.end() && it->second.count(code);
+    }
+
+    ftl::Flags<InputDeviceClass> guessClasses() const {
+        ftl::Flags<InputDeviceClass> classes;
+        if (isMultiTouch()) {
+            classes |= InputDeviceClass::TOUCH | InputDeviceClass::TOUCH_MT;
+        } else if (absAxes.find(ABS_X) != absAxes.end() && hasBit(EV_KEY, BTN_TOUCH)) {
+            classes |= InputDeviceClass::TOUCH;
+        }
+        if (hasBit(EV_REL, REL_X) && hasBit(EV_REL, REL_Y)) {
+            classes |= InputDeviceClass::CURSOR;
+        }
+        const auto keys = bitsByType.find(EV_KEY);
+        if (keys != bitsByType.end() && !keys->second.empty() &&
+            *keys->second.begin() < BTN_MISC) {
+            classes |= InputDeviceClass::KEYBOARD;
+        }
+        return classes;
+    }
+};
+
+/**
+ * Parse the text format written by `evemu-record` (see cmds/evemu-record). Unknown line types are
+ * ignored, which keeps us compatible with both the FreeDesktop and the Android recorder output.
+ */
+std::optional<EvemuRecording> parseEvemuRecording(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    EvemuRecording recording;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() < 2 || line[1] != ':') {
+            continue;
+        }
+        const char* data = line.c_str() + 2;
+        switch (line[0]) {
+            case 'N': {
+                const size_t start = line.find_first_not_of(' ', 2);
+                if (start != std::string::npos) {
+                    recording.name = line.substr(start);
+                }
+                break;
+            }
+            case 'I': {
+                unsigned int bus, vendor, product, version;
+                if (sscanf(data, " %x %x %x %x", &bus, &vendor, &product, &version) == 4) {
+                    recording.bus = static_cast<int32_t>(bus);
+                }
+                break;
+            }
+            case 'B': {
+                unsigned int type;
+                int consumed;
+                if (sscanf(data, " %x%n", &type, &consumed) != 1) {
+                    break;
+                }
+                data += consumed;
+                unsigned int byte;
+                int32_t bitBase = 0;
+                while (sscanf(data, " %x%n", &byte, &consumed) == 1) {
+                    data += consumed;
+                    for (int32_t bit = 0; bit < 8; bit++) {
+                        if (byte & (1u << bit)) {
+                            recording.bitsByType[static_cast<int32_t>(type)].insert(bitBase + bit);
+                        }
+                    }
+                    bitBase += 8;
+                }
+                break;
+            }
+            case 'A': {
+                unsigned int axis;
+                int32_t min, max, fuzz, flat, resolution = 0;
+                const int matched =
+                        sscanf(data, " %x %d %d %d %d %d", &axis, &min, &max, &fuzz, &flat,
+                               &resolution);
+                if (matched >= 5) {
+                    recording.absAxes[static_cast<int32_t>(axis)] = {min, max, fuzz, flat,
+                                                                     resolution};
+                    recording.bitsByType[EV_ABS].insert(static_cast<int32_t>(axis));
+                }
+                break;
+            }
+            case 'E': {
+                long sec, usec;
+                unsigned int type, code;
+                int32_t value;
+                if (sscanf(data, " %ld.%ld %x %x %d", &sec, &usec, &type, &code, &value) == 5) {
+                    recording.events.push_back({static_cast<int32_t>(type),
+                                                static_cast<int32_t>(code), value});
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    if (recording.events.empty()) {
+        return std::nullopt;
+    }
+    return recording;
+}
+
+/**
+ * A single-finger swipe across a 1080x2400 multi-touch screen, used when no recording is supplied
+ * so that the benchmark is runnable out of the box.
+ */
+EvemuRecording makeSyntheticSwipe() {
+    EvemuRecording recording;
+    recording.name = "synthetic touchscreen swipe";
+    recording.absAxes[ABS_MT_SLOT] = {0, 9, 0, 0, 0};
+    recording.absAxes[ABS_MT_TRACKING_ID] = {0, 65535, 0, 0, 0};
+    recording.absAxes[ABS_MT_POSITION_X] = {0, 1079, 0, 0, 0};
+    recording.absAxes[ABS_MT_POSITION_Y] = {0, 2399, 0, 0, 0};
+    recording.absAxes[ABS_MT_PRESSURE] = {0, 255, 0, 0, 0};
+    for (const auto& [axis, _] : recording.absAxes) {
+        recording.bitsByType[EV_ABS].insert(axis);
+    }
+    recording.bitsByType[EV_KEY].insert(BTN_TOUCH);
+
+    auto& events = recording.events;
+    events.push_back({EV_ABS, ABS_MT_TRACKING_ID, 1});
+    events.push_back({EV_KEY, BTN_TOUCH, 1});
+    constexpr int32_t FRAME_COUNT = 120;
+    for (int32_t i = 0; i < FRAME_COUNT; i++) {
+        events.push_back({EV_ABS, ABS_MT_POSITION_X, 100 + i * 8});
+        events.push_back({EV_ABS, ABS_MT_POSITION_Y, 200 + i * 18});
+        events.push_back({EV_ABS, ABS_MT_PRESSURE, 60});
+        events.push_back({EV_SYN, SYN_REPORT, 0});
+    }
+    events.push_back({EV_ABS, ABS_MT_TRACKING_ID, -1});
+    events.push_back({EV_KEY, BTN_TOUCH, 0});
+    events.push_back({EV_SYN, SYN_REPORT, 0});
+    return recording;
+}
+
+EvemuRecording loadRecording() {
+    if (const char* path = getenv(RECORDING_ENV_VAR); path != nullptr) {
+        std::optional<EvemuRecording> recording = parseEvemuRecording(path);
+        LOG_ALWAYS_FATAL_IF(!recording, "Could not parse evemu recording '%s'", path);
+        return std::move(*recording);
+    }
+    return makeSyntheticSwipe();
+}
+
+// Exposes the protected loopOnce so the benchmark can pump the reader synchronously instead of
+// spinning a thread against the non-blocking FakeEventHub.
+class ReplayInputReader : public InputReader {
+public:
+    using InputReader::InputReader;
+    using InputReader::loopOnce;
+};
+
+/**
+ * Sits between InputReader and InputDispatcher, in the position the real pipeline stages occupy,
+ * and records how long each key/motion event spent in the reader (enqueue into the fake event hub
+ * until notify) before forwarding it downstream.
+ */
+class LatencyRecordingListener : public InputListenerInterface {
+public:
+    explicit LatencyRecordingListener(InputListenerInterface& innerListener)
+          : mInnerListener(innerListener) {}
+
+    void notifyInputDevicesChanged(const NotifyInputDevicesChangedArgs& args) override {
+        mInnerListener.notifyInputDevicesChanged(args);
+    }
+    void notifyKey(const NotifyKeyArgs& args) override {
+        recordReaderLatency(args.eventTime);
+        mDeliverableCount++;
+        mInnerListener.notifyKey(args);
+    }
+    void notifyMotion(const NotifyMotionArgs& args) override {
+        recordReaderLatency(args.eventTime);
+        mDeliverableCount++;
+        mInnerListener.notifyMotion(args);
+    }
+    void notifySwitch(const NotifySwitchArgs& args) override {
+        mInnerListener.notifySwitch(args);
+    }
+    void notifySensor(const NotifySensorArgs& args) override {
+        mInnerListener.notifySensor(args);
+    }
+    void notifyVibratorState(const NotifyVibratorStateArgs& args) override {
+        mInnerListener.notifyVibratorState(args);
+    }
+    void notifyDeviceReset(const NotifyDeviceResetArgs& args) override {
+        mInnerListener.notifyDeviceReset(args);
+    }
+    void notifyPointerCaptureChanged(const NotifyPointerCaptureChangedArgs& args) override {
+        mInnerListener.notifyPointerCaptureChanged(args);
+    }
+
+    // The number of events forwarded to the dispatcher that should eventually reach a window.
+    size_t getDeliverableCount() const { return mDeliverableCount; }
+
+    std::vector<nsecs_t>& getReaderLatencies() { return mReaderLatencies; }
+
+private:
+    void recordReaderLatency(nsecs_t eventTime) {
+        // Events are enqueued with eventTime = enqueue time, so this measures the full reader
+        // stage: fake event hub queue, mapper processing and NotifyArgs construction.
+        mReaderLatencies.push_back(now() - eventTime);
+    }
+
+    InputListenerInterface& mInnerListener;
+    std::vector<nsecs_t> mReaderLatencies;
+    size_t mDeliverableCount = 0;
+};
+
+nsecs_t percentile(std::vector<nsecs_t>& latencies, double fraction) {
+    if (latencies.empty()) {
+        return 0;
+    }
+    const size_t index = static_cast<size_t>(fraction * static_cast<double>(latencies.size() - 1));
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index];
+}
+
+void setLatencyCounters(benchmark::State& state, const std::string& prefix,
+                        std::vector<nsecs_t>& latencies) {
+    constexpr double NANOS_PER_MICROS = 1000.0;
+    state.counters[prefix + "P50us"] =
+            static_cast<double>(percentile(latencies, 0.5)) / NANOS_PER_MICROS;
+    state.counters[prefix + "P99us"] =
+            static_cast<double>(percentile(latencies, 0.99)) / NANOS_PER_MICROS;
+}
+
+/**
+ * Replays an evemu recording through EventHub-level injection into a real InputReader feeding a
+ * real InputDispatcher, with a fake window consuming the output, and reports per-stage latency
+ * percentiles alongside the usual per-iteration (= per full trace) wall time.
+ */
+static void benchmarkReplayEvemuRecording(benchmark::State& state) {
+    const EvemuRecording recording = loadRecording();
+    const ftl::Flags<InputDeviceClass> classes = recording.guessClasses();
+
+    // Size the display to cover the touch device's range so that no event lands outside the
+    // window.
+    int32_t displayWidth = 1080;
+    int32_t displayHeight = 2400;
+    if (const auto x = recording.absAxes.find(recording.isMultiTouch() ? ABS_MT_POSITION_X : ABS_X);
+        x != recording.absAxes.end()) {
+        displayWidth = x->second[1] - x->second[0] + 1;
+    }
+    if (const auto y = recording.absAxes.find(recording.isMultiTouch() ? ABS_MT_POSITION_Y : ABS_Y);
+        y != recording.absAxes.end()) {
+        displayHeight = y->second[1] - y->second[0] + 1;
+    }
+
+    FakeInputDispatcherPolicy dispatcherPolicy;
+    auto dispatcher = std::make_unique<InputDispatcher>(dispatcherPolicy);
+    dispatcher->setInputDispatchMode(/*enabled=*/true, /*frozen=*/false);
+    dispatcher->start();
+
+    LatencyRecordingListener listener(*dispatcher);
+    std::shared_ptr<FakeEventHub> eventHub = std::make_shared<FakeEventHub>();
+    sp<FakeInputReaderPolicy> readerPolicy = sp<FakeInputReaderPolicy>::make();
+    readerPolicy->addDisplayViewport(DISPLAY_ID, displayWidth, displayHeight, ui::ROTATION_0,
+                                     /*isActive=*/true, "local:0", /*physicalPort=*/std::nullopt,
+                                     ViewportType::INTERNAL);
+    ReplayInputReader reader(eventHub, readerPolicy, listener);
+
+    // Reconstruct the recorded device inside the fake event hub.
+    eventHub->addDevice(EVENTHUB_ID, recording.name, classes, recording.bus);
+    for (const auto& [axis, info] : recording.absAxes) {
+        eventHub->addAbsoluteAxis(EVENTHUB_ID, axis, info[0], info[1], info[2], info[3], info[4]);
+    }
+    if (const auto keys = recording.bitsByType.find(EV_KEY); keys != recording.bitsByType.end()) {
+        for (const int32_t scanCode : keys->second) {
+            // Identity scan code mapping: the benchmark cares about pipeline cost, not about
+            // producing the exact key codes a real key layout file would.
+            eventHub->addKey(EVENTHUB_ID, scanCode, /*usageCode=*/0, /*keyCode=*/scanCode,
+                             /*flags=*/0);
+        }
+    }
+    if (classes.test(InputDeviceClass::TOUCH)) {
+        eventHub->addConfigurationProperty(EVENTHUB_ID, "touch.deviceType", "touchScreen");
+    }
+    // One loop to pick up the new device, one to finish the configuration round trip.
+    reader.loopOnce();
+    reader.loopOnce();
+
+    // Create a full-screen window to consume the dispatched events.
+    std::shared_ptr<FakeApplicationHandle> application = std::make_shared<FakeApplicationHandle>();
+    sp<FakeWindowHandle> window =
+            sp<FakeWindowHandle>::make(application, dispatcher, "Replay Window", DISPLAY_ID);
+    window->setFrame(Rect(0, 0, displayWidth, displayHeight));
+    const bool needsFocus = classes.test(InputDeviceClass::KEYBOARD);
+    if (needsFocus) {
+        window->setFocusable(true);
+    }
+    dispatcher->onWindowInfosChanged({{*window->getInfo()}, {}, 0, 0});
+    if (needsFocus) {
+        gui::FocusRequest request;
+        request.token = window->getToken();
+        request.windowName = window->getName();
+        request.timestamp = now();
+        request.displayId = DISPLAY_ID.val();
+        dispatcher->setFocusedWindow(request);
+        window->consumeFocusEvent(true);
+    }
+
+    std::vector<nsecs_t> endToEndLatencies;
+    size_t consumedCount = 0;
+    size_t droppedCount = 0;
+    for (auto _ : state) {
+        for (const EvemuEvent& event : recording.events) {
+            const nsecs_t enqueueTime = now();
+            eventHub->enqueueEvent(enqueueTime, enqueueTime, EVENTHUB_ID, event.type, event.code,
+                                   event.value);
+            if (event.type != EV_SYN || event.code != SYN_REPORT) {
+                continue;
+            }
+            reader.loopOnce();
+            // Consume in lockstep with the reader so that at most one event is ever in flight,
+            // which keeps consumer-side batching from merging the recorded MOVEs.
+            while (consumedCount < listener.getDeliverableCount()) {
+                std::unique_ptr<InputEvent> consumedEvent =
+                        window->consume(CONSUME_TIMEOUT, /*handled=*/true);
+                if (consumedEvent == nullptr) {
+                    // The dispatcher dropped the event (e.g. an untargetable source); stop
+                    // waiting for this frame.
+                    droppedCount += listener.getDeliverableCount() - consumedCount;
+                    consumedCount = listener.getDeliverableCount();
+                    break;
+                }
+                consumedCount++;
+                nsecs_t eventTime = 0;
+                if (consumedEvent->getType() == InputEventType::MOTION) {
+                    eventTime = static_cast<const MotionEvent&>(*consumedEvent).getEventTime();
+                } else if (consumedEvent->getType() == InputEventType::KEY) {
+                    eventTime = static_cast<const KeyEvent&>(*consumedEvent).getEventTime();
+                } else {
+                    continue;
+                }
+                endToEndLatencies.push_back(now() - eventTime);
+            }
+        }
+    }
+
+    dispatcher->stop();
+
+    setLatencyCounters(state, "reader", listener.getReaderLatencies());
+    setLatencyCounters(state, "endToEnd", endToEndLatencies);
+    state.counters["eventsDelivered"] = static_cast<double>(consumedCount);
+    state.counters["eventsDropped"] = static_cast<double>(droppedCount);
+}
+
+} // namespace
+
+BENCHMARK(benchmarkReplayEvemuRecording)->Unit(benchmark::kMillisecond);
+
+} // namespace android
@@ -16,15 +16,21 @@
 
 #include "AnrTracker.h"
 
-namespace android::inputdispatcher {
+#include <algorithm>
+#include <limits>
 
-template <typename T>
-static T max(const T& a, const T& b) {
-    return a < b ? b : a;
-}
+namespace android::inputdispatcher {
 
 void AnrTracker::insert(nsecs_t timeoutTime, sp<IBinder> token) {
-    mAnrTimeouts.insert(std::make_pair(timeoutTime, std::move(token)));
+    std::deque<nsecs_t>& timeouts = mTimeoutsByToken[std::move(token)];
+    if (timeouts.empty() || timeouts.back() <= timeoutTime) {
+        // Common case: this event times out no sooner than the events already in flight.
+        timeouts.push_back(timeoutTime);
+    } else {
+        timeouts.insert(std::upper_bound(timeouts.begin(), timeouts.end(), timeoutTime),
+                        timeoutTime);
+    }
+    ++mCount;
 }
 
 /**
@@ -32,42 +38,66 @@ void AnrTracker::insert(nsecs_t timeoutTime, sp<IBinder> token) {
  * (same time, same connection), then only remove one of them.
  */
 void AnrTracker::erase(nsecs_t timeoutTime, const sp<IBinder>& token) {
-    auto pair = std::make_pair(timeoutTime, token);
-    auto it = mAnrTimeouts.find(pair);
-    if (it != mAnrTimeouts.end()) {
-        mAnrTimeouts.erase(it);
+    auto it = mTimeoutsByToken.find(token);
+    if (it == mTimeoutsByToken.end()) {
+        return;
+    }
+    std::deque<nsecs_t>& timeouts = it->second;
+    if (timeouts.front() == timeoutTime) {
+        // Common case: the finished event is the oldest one in flight.
+        timeouts.pop_front();
+    } else {
+        auto entry = std::lower_bound(timeouts.begin(), timeouts.end(), timeoutTime);
+        if (entry == timeouts.end() || *entry != timeoutTime) {
+            return;
+        }
+        timeouts.erase(entry);
+    }
+    --mCount;
+    if (timeouts.empty()) {
+        mTimeoutsByToken.erase(it);
     }
 }
 
 void AnrTracker::eraseToken(const sp<IBinder>& token) {
-    for (auto it = mAnrTimeouts.begin(); it != mAnrTimeouts.end();) {
-        if (it->second == token) {
-            it = mAnrTimeouts.erase(it);
-        } else {
-            ++it;
-        }
+    auto it = mTimeoutsByToken.find(token);
+    if (it == mTimeoutsByToken.end()) {
+        return;
     }
+    mCount -= it->second.size();
+    mTimeoutsByToken.erase(it);
 }
 
 bool AnrTracker::empty() const {
-    return mAnrTimeouts.empty();
+    return mCount == 0;
+}
+
+AnrTracker::TimeoutsByToken::const_iterator AnrTracker::findSoonest() const {
+    auto soonest = mTimeoutsByToken.begin();
+    for (auto it = std::next(soonest); it != mTimeoutsByToken.end(); ++it) {
+        if (it->second.front() < soonest->second.front()) {
+            soonest = it;
+        }
+    }
+    return soonest;
 }
 
 // If empty() is false, return the time at which the next connection should cause an ANR
 // If empty() is true, return LLONG_MAX
 nsecs_t AnrTracker::firstTimeout() const {
-    if (mAnrTimeouts.empty()) {
+    if (empty()) {
         return std::numeric_limits<nsecs_t>::max();
     }
-    return mAnrTimeouts.begin()->first;
+    return findSoonest()->second.front();
 }
 
 const sp<IBinder>& AnrTracker::firstToken() const {
-    return mAnrTimeouts.begin()->second;
+    return findSoonest()->first;
 }
 
 void AnrTracker::clear() {
-    mAnrTimeouts.clear();
+    mTimeoutsByToken.clear();
+    mCount = 0;
 }
 
 } // namespace android::inputdispatcher
@@ -18,7 +18,8 @@
 
 #include <binder/IBinder.h>
 #include <utils/Timers.h>
-#include <set>
+#include <deque>
+#include <unordered_map>
 
 namespace android::inputdispatcher {
 
@@ -42,16 +43,34 @@ public:
     const sp<IBinder>& firstToken() const;
 
 private:
-    // Optimization: use a multiset to keep track of the event timeouts. When an event is sent
-    // to the InputConsumer, we add an entry to this structure. We look at the smallest value to
-    // determine if any of the connections is unresponsive, and to determine when we should wake
-    // next for the future ANR check.
-    // Using a multiset helps quickly look up the next timeout due.
+    struct StrongPointerHash {
+        std::size_t operator()(const sp<IBinder>& b) const {
+            return std::hash<IBinder*>{}(b.get());
+        }
+    };
+
+    // Optimization: track the pending timeouts of each connection separately. Events are
+    // dispatched to a connection with non-decreasing timeout times and finish in order in
+    // the common case, so each connection's timeouts form a sorted deque where an insert
+    // appends to the back and an erase pops the front — both O(1), with no tree churn per
+    // dispatched event. Out-of-order times (e.g. when a connection's timeout shrinks) fall
+    // back to a binary search within that connection's deque.
+    //
+    // Duplicate entries (same time, same connection) are plausible (although highly
+    // unlikely) for events with different sequence numbers, and are simply stored twice.
     //
-    // We must use a multi-set, because it is plausible (although highly unlikely) to have entries
-    // from the same connection and same timestamp, but different sequence numbers.
-    // We are not tracking sequence numbers, and just allow duplicates to exist.
-    std::multiset<std::pair<nsecs_t /*timeoutTime*/, sp<IBinder> /*connectionToken*/>> mAnrTimeouts;
+    // Finding the next connection to ANR scans the front entry of each connection, which
+    // is O(number of connections); that only happens when the dispatcher computes its next
+    // wake-up time, not per event.
+    using TimeoutsByToken =
+            std::unordered_map<sp<IBinder>, std::deque<nsecs_t>, StrongPointerHash>;
+    TimeoutsByToken mTimeoutsByToken;
+
+    // Total number of pending entries across all connections.
+    size_t mCount = 0;
+
+    // Returns the connection whose soonest timeout is due first. Only valid if !empty().
+    TimeoutsByToken::const_iterator findSoonest() const;
 };
 
 } // namespace android::inputdispatcher
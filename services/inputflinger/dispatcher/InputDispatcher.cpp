@@ -88,6 +88,15 @@ bool isInputTracingEnabled() {
     return input_flags::enable_input_event_tracing() && isUserdebugOrEng;
 }
 
+// Pipeline motion prediction runs the stylus motion predictor centrally in the dispatcher and
+// attaches the predicted samples to outgoing MotionEntries, instead of every interested client
+// recording the stream and running its own inference. Off by default; when the property is
+// changed, the new setting takes effect after reboot.
+bool isPipelineMotionPredictionEnabled() {
+    return base::GetBoolProperty("persist.input.dispatcher_motion_prediction", false) &&
+            isMotionPredictionEnabled();
+}
+
 // Create the input tracing backend that writes to perfetto from a single thread.
 std::unique_ptr<trace::InputTracingBackendInterface> createInputTracingBackendIfEnabled() {
     if (!isInputTracingEnabled()) {
@@ -149,6 +158,11 @@ const std::chrono::duration STALE_EVENT_TIMEOUT = std::chrono::seconds(10) * HwT
 // Log a warning when an event takes longer than this to process, even if an ANR does not occur.
 constexpr nsecs_t SLOW_EVENT_PROCESSING_WARNING_TIMEOUT = 2000 * 1000000LL; // 2sec
 
+// How far past the latest recorded sample to ask the motion predictor for predicted motion. By
+// the time the client draws against the prediction, the on-screen content trails the newest
+// input by roughly one display frame.
+constexpr nsecs_t MOTION_PREDICTION_HORIZON = 16 * 1000000LL; // 16ms, about one 60Hz frame
+
 // Log a warning when an interception call takes longer than this to process.
 constexpr std::chrono::milliseconds SLOW_INTERCEPTION_THRESHOLD = 50ms;
 
@@ -436,21 +450,33 @@ std::unique_ptr<DispatchEntry> createDispatchEntry(const IdGenerator& idGenerato
         const ui::Transform inverseTransform = transform->inverse();
         displayTransform = &inputTarget.displayTransform;
 
+        // Pointers that share a transform also share the same normalizing composition, so
+        // compose each distinct pointer transform with the inverse once and apply a single
+        // transform per pointer, rather than two. The number of distinct transforms is bounded
+        // by the number of windows the touch is split across, typically one or two.
+        std::vector<std::pair<const ui::Transform*, ui::Transform>> composedTransforms;
+
         // Iterate through all pointers in the event to normalize against the first.
         for (size_t i = 0; i < motionEntry.getPointerCount(); i++) {
             PointerCoords& newCoords = pointerCoords[i];
             const auto pointerId = motionEntry.pointerProperties[i].id;
             const ui::Transform& currTransform = inputTarget.getTransformForPointer(pointerId);
 
+            auto composedIt = std::find_if(composedTransforms.begin(), composedTransforms.end(),
+                                           [&currTransform](const auto& entry) {
+                                               return entry.first == &currTransform;
+                                           });
+            if (composedIt == composedTransforms.end()) {
+                // Apply the current pointer's transform to update the coordinates into window
+                // space, then the inverse transform of the normalized coordinates, so the
+                // current coordinates are transformed into the normalized coordinate space.
+                composedIt = composedTransforms.emplace(composedTransforms.end(), &currTransform,
+                                                        inverseTransform * currTransform);
+            }
+
             newCoords.copyFrom(motionEntry.pointerCoords[i]);
-            // First, apply the current pointer's transform to update the coordinates into
-            // window space.
             MotionEvent::calculateTransformedCoordsInPlace(newCoords, motionEntry.source,
-                                                           motionEntry.flags, currTransform);
-            // Next, apply the inverse transform of the normalized coordinates so the
-            // current coordinates are transformed into the normalized coordinate space.
-            MotionEvent::calculateTransformedCoordsInPlace(newCoords, motionEntry.source,
-                                                           motionEntry.flags, inverseTransform);
+                                                           motionEntry.flags, composedIt->second);
         }
     }
 
@@ -592,12 +618,21 @@ bool windowAcceptsTouchAt(const WindowInfo& windowInfo, ui::LogicalDisplayId dis
     // "bottom" of the window will be different in the display (un-rotated) space compared to in the
     // logical display in which WM determined the bounds. Perform the hit test in the logical
     // display space to ensure these edges are considered correctly in all orientations.
-    const auto touchableRegion = displayTransform.transform(windowInfo.touchableRegion);
     const auto p = displayTransform.transform(x, y);
-    if (!touchableRegion.contains(std::floor(p.x), std::floor(p.y))) {
-        return false;
+    const int32_t px = static_cast<int32_t>(std::floor(p.x));
+    const int32_t py = static_cast<int32_t>(std::floor(p.y));
+
+    // Most windows have a rectangular touchable region. Hit test those against the transformed
+    // bounds directly instead of materializing a transformed Region per window: with many overlay
+    // windows, the Region allocations dominate the front-to-back walk on every touch down. This is
+    // exact, since transforming a single-rect Region reduces to transforming its bounds.
+    if (windowInfo.touchableRegion.isRect()) {
+        const Rect bounds = displayTransform.transform(windowInfo.touchableRegion.getBounds());
+        return px >= bounds.left && px < bounds.right && py >= bounds.top && py < bounds.bottom;
     }
-    return true;
+
+    const auto touchableRegion = displayTransform.transform(windowInfo.touchableRegion);
+    return touchableRegion.contains(px, py);
 }
 
 // Returns true if the given window's frame can occlude pointer events at the given display
@@ -962,6 +997,10 @@ InputDispatcher::InputDispatcher(InputDispatcherPolicyInterface& policy,
         mTracer = std::make_unique<trace::impl::InputTracer>(std::move(traceBackend));
     }
 
+    if (isPipelineMotionPredictionEnabled()) {
+        mMotionPredictor = std::make_unique<MotionPredictor>(/*predictionTimestampOffsetNanos=*/0);
+    }
+
     mLastUserActivityTimes.fill(0);
 }
 
@@ -2023,6 +2062,10 @@ bool InputDispatcher::dispatchMotionLocked(nsecs_t currentTime,
     if (!entry->dispatchInProgress) {
         entry->dispatchInProgress = true;
 
+        if (mMotionPredictor != nullptr) {
+            attachPredictedMotionLocked(*entry);
+        }
+
         logOutboundMotionDetails("dispatchMotion - ", *entry);
     }
 
@@ -2156,6 +2199,51 @@ void InputDispatcher::logOutboundMotionDetails(const char* prefix, const MotionE
     }
 }
 
+void InputDispatcher::attachPredictedMotionLocked(const MotionEntry& entry) {
+    if (!isFromSource(entry.source, AINPUT_SOURCE_STYLUS) || entry.getPointerCount() != 1) {
+        return;
+    }
+    if (mMotionPredictionDeviceId && *mMotionPredictionDeviceId != entry.deviceId) {
+        // Another device's gesture is already being predicted.
+        return;
+    }
+    const int32_t maskedAction = entry.action & AMOTION_EVENT_ACTION_MASK;
+    switch (maskedAction) {
+        case AMOTION_EVENT_ACTION_DOWN:
+            mMotionPredictionDeviceId = entry.deviceId;
+            break;
+        case AMOTION_EVENT_ACTION_UP:
+        case AMOTION_EVENT_ACTION_CANCEL:
+            mMotionPredictionDeviceId.reset();
+            break;
+        case AMOTION_EVENT_ACTION_MOVE:
+            break;
+        default:
+            // The predictor only consumes DOWN, MOVE, UP and CANCEL.
+            return;
+    }
+
+    // The predictor only looks at relative raw motion, so the display transform is not needed.
+    MotionEvent event;
+    event.initialize(entry.id, entry.deviceId, entry.source, entry.displayId, INVALID_HMAC,
+                     entry.action, entry.actionButton, entry.flags, entry.edgeFlags,
+                     entry.metaState, entry.buttonState, entry.classification, kIdentityTransform,
+                     entry.xPrecision, entry.yPrecision, entry.xCursorPosition,
+                     entry.yCursorPosition, kIdentityTransform, entry.downTime, entry.eventTime,
+                     entry.getPointerCount(), entry.pointerProperties.data(),
+                     entry.pointerCoords.data());
+    if (!mMotionPredictor->record(event).ok()) {
+        // The event is not consistent with the stream recorded so far (e.g. overlapping
+        // gestures); the predictor recovers once the current gesture ends.
+        return;
+    }
+    entry.predictedMotion = mMotionPredictor->predict(entry.eventTime + MOTION_PREDICTION_HORIZON);
+    if (DEBUG_OUTBOUND_EVENT_DETAILS && entry.predictedMotion != nullptr) {
+        ALOGD("dispatchMotion - attached %zu predicted samples",
+              entry.predictedMotion->getHistorySize() + 1);
+    }
+}
+
 void InputDispatcher::dispatchEventLocked(nsecs_t currentTime,
                                           std::shared_ptr<const EventEntry> eventEntry,
                                           const std::vector<InputTarget>& inputTargets) {
@@ -4596,6 +4684,27 @@ void InputDispatcher::notifyMotion(const NotifyMotionArgs& args) {
               std::to_string(t.duration().count()).c_str());
     }
 
+    // Construct the entry before acquiring the lock, since copying the pointer data is the most
+    // expensive part of enqueueing. This bounds the time the reader thread can stall on the
+    // dispatcher thread, which may hold the lock for a long time while finding targets. The
+    // policy flags may still be adjusted below, and are reapplied to the entry before it is
+    // enqueued.
+    std::unique_ptr<MotionEntry> newEntry =
+            std::make_unique<MotionEntry>(args.id, /*injectionState=*/nullptr, args.eventTime,
+                                          args.deviceId, args.source, args.displayId, policyFlags,
+                                          args.action, args.actionButton, args.flags,
+                                          args.metaState, args.buttonState, args.classification,
+                                          args.edgeFlags, args.xPrecision, args.yPrecision,
+                                          args.xCursorPosition, args.yCursorPosition, args.downTime,
+                                          args.pointerProperties, args.pointerCoords);
+
+    const bool isFromReader = args.id != android::os::IInputConstants::INVALID_INPUT_EVENT_ID &&
+            IdGenerator::getSource(args.id) == IdGenerator::Source::INPUT_READER;
+    std::set<InputDeviceUsageSource> usageSources;
+    if (isFromReader) {
+        usageSources = getUsageSourcesForMotionArgs(args);
+    }
+
     bool needWake = false;
     { // acquire lock
         mLock.lock();
@@ -4637,26 +4746,15 @@ void InputDispatcher::notifyMotion(const NotifyMotionArgs& args) {
             mLock.lock();
         }
 
-        // Just enqueue a new motion event.
-        std::unique_ptr<MotionEntry> newEntry =
-                std::make_unique<MotionEntry>(args.id, /*injectionState=*/nullptr, args.eventTime,
-                                              args.deviceId, args.source, args.displayId,
-                                              policyFlags, args.action, args.actionButton,
-                                              args.flags, args.metaState, args.buttonState,
-                                              args.classification, args.edgeFlags, args.xPrecision,
-                                              args.yPrecision, args.xCursorPosition,
-                                              args.yCursorPosition, args.downTime,
-                                              args.pointerProperties, args.pointerCoords);
+        // Just enqueue the pre-built motion event, with any policy flag changes made above.
+        newEntry->policyFlags = policyFlags;
         if (mTracer) {
             newEntry->traceTracker = mTracer->traceInboundEvent(*newEntry);
         }
 
-        if (args.id != android::os::IInputConstants::INVALID_INPUT_EVENT_ID &&
-            IdGenerator::getSource(args.id) == IdGenerator::Source::INPUT_READER &&
-            !mInputFilterEnabled) {
-            std::set<InputDeviceUsageSource> sources = getUsageSourcesForMotionArgs(args);
+        if (isFromReader && !mInputFilterEnabled) {
             mLatencyTracker.trackListener(args.id, args.eventTime, args.readTime, args.deviceId,
-                                          sources, args.action, InputEventType::MOTION);
+                                          usageSources, args.action, InputEventType::MOTION);
         }
 
         needWake = enqueueInboundEventLocked(std::move(newEntry));
@@ -5931,6 +6029,8 @@ void InputDispatcher::dumpDispatchStateLocked(std::string& dump) const {
     dump += StringPrintf(INDENT "DispatchEnabled: %s\n", toString(mDispatchEnabled));
     dump += StringPrintf(INDENT "DispatchFrozen: %s\n", toString(mDispatchFrozen));
     dump += StringPrintf(INDENT "InputFilterEnabled: %s\n", toString(mInputFilterEnabled));
+    dump += StringPrintf(INDENT "MotionPredictionPipelineEnabled: %s\n",
+                         toString(mMotionPredictor != nullptr));
     dump += StringPrintf(INDENT "FocusedDisplayId: %s\n", mFocusedDisplayId.toString().c_str());
 
     if (!mFocusedApplicationHandlesByDisplay.empty()) {
@@ -6050,11 +6150,14 @@ void InputDispatcher::dumpDispatchStateLocked(std::string& dump) const {
         dump += INDENT "Connections:\n";
         for (const auto& [token, connection] : mConnectionsByToken) {
             dump += StringPrintf(INDENT2 "%i: channelName='%s', "
-                                         "status=%s, monitor=%s, responsive=%s\n",
+                                         "status=%s, monitor=%s, responsive=%s, "
+                                         "sendBufferSize=%zu, sendBufferGrowCount=%u\n",
                                  connection->inputPublisher.getChannel().getFd(),
                                  connection->getInputChannelName().c_str(),
                                  ftl::enum_string(connection->status).c_str(),
-                                 toString(connection->monitor), toString(connection->responsive));
+                                 toString(connection->monitor), toString(connection->responsive),
+                                 connection->inputPublisher.getSendBufferSize(),
+                                 connection->inputPublisher.getSendBufferGrowCount());
 
             if (!connection->outboundQueue.empty()) {
                 dump += StringPrintf(INDENT3 "OutboundQueue: length=%zu\n",
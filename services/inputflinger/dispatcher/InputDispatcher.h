@@ -40,6 +40,7 @@
 #include <gui/WindowInfosUpdate.h>
 #include <input/Input.h>
 #include <input/InputTransport.h>
+#include <input/MotionPredictor.h>
 #include <limits.h>
 #include <powermanager/PowerManager.h>
 #include <stddef.h>
@@ -184,6 +185,16 @@ private:
     // Input event tracer. The tracer will only exist on builds where input tracing is allowed.
     std::unique_ptr<trace::InputTracerInterface> mTracer GUARDED_BY(mLock);
 
+    // Predicts stylus motion centrally so that the predicted samples can be attached to outgoing
+    // MotionEntries, sparing interested clients a second IPC/inference round trip per frame.
+    // Only set when pipeline motion prediction is enabled.
+    std::unique_ptr<MotionPredictor> mMotionPredictor GUARDED_BY(mLock);
+
+    // The device whose gesture is currently being fed to mMotionPredictor, which only supports
+    // one gesture at a time. Gestures from other devices pass through unaugmented until this
+    // one ends.
+    std::optional<int32_t> mMotionPredictionDeviceId GUARDED_BY(mLock);
+
     sp<Looper> mLooper;
 
     std::shared_ptr<const EventEntry> mPendingEvent GUARDED_BY(mLock);
@@ -469,6 +480,10 @@ private:
     void logOutboundKeyDetails(const char* prefix, const KeyEntry& entry);
     void logOutboundMotionDetails(const char* prefix, const MotionEntry& entry);
 
+    // Records the given entry into mMotionPredictor and, if enough of the gesture has been seen,
+    // attaches the predicted continuation to the entry.
+    void attachPredictedMotionLocked(const MotionEntry& entry) REQUIRES(mLock);
+
     /**
      * This field is set if there is no focused window, and we have an event that requires
      * a focused window to be dispatched (for example, a KeyEvent).
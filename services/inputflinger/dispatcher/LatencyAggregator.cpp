@@ -15,14 +15,20 @@
  */
 
 #define LOG_TAG "LatencyAggregator"
+#define ATRACE_TAG ATRACE_TAG_INPUT
 #include "LatencyAggregator.h"
 
 #include <inttypes.h>
+#include <pthread.h>
 
 #include <android-base/stringprintf.h>
 #include <input/Input.h>
 #include <log/log.h>
 #include <server_configurable_flags/get_flags.h>
+#include <utils/Trace.h>
+
+#include <algorithm>
+#include <string>
 
 using android::base::StringPrintf;
 using dist_proc::aggregation::KllQuantile;
@@ -104,10 +110,17 @@ LatencyAggregator::LatencyAggregator() {
         mDownSketches[i] = KllQuantile::Create(options);
         mMoveSketches[i] = KllQuantile::Create(options);
     }
+    mThread = std::thread(&LatencyAggregator::threadLoop, this);
 }
 
 LatencyAggregator::~LatencyAggregator() {
     AStatsManager_clearPullAtomCallback(android::util::INPUT_EVENT_LATENCY_SKETCH);
+    {
+        std::scoped_lock lock(mLock);
+        mShuttingDown = true;
+    }
+    mPendingTimelinesChanged.notify_all();
+    mThread.join();
 }
 
 AStatsManager_PullAtomCallbackReturn LatencyAggregator::pullAtomCallback(int32_t atomTag,
@@ -120,13 +133,90 @@ AStatsManager_PullAtomCallbackReturn LatencyAggregator::pullAtomCallback(int32_t
     return pAggregator->pullData(data);
 }
 
+// Names of the stages tracked by SketchIndex, used for dump output and trace counters.
+static constexpr const char* kStageNames[SketchIndex::SIZE] = {
+        "eventToRead",          "readToDeliver",        "deliverToConsume", "consumeToFinish",
+        "consumeToGpuComplete", "gpuCompleteToPresent", "endToEnd",
+};
+
 void LatencyAggregator::processTimeline(const InputEventTimeline& timeline) {
-    processStatistics(timeline);
-    processSlowEvent(timeline);
+    // Called on the dispatcher thread. Aggregation (sketch compactions, statsd socket writes)
+    // would perturb the very latency being measured, so only queue a copy here and let the
+    // aggregation thread do the rest.
+    {
+        std::scoped_lock lock(mLock);
+        if (mPendingTimelines.size() >= MAX_PENDING_TIMELINES) {
+            mNumTimelinesDropped++;
+            return;
+        }
+        mPendingTimelines.push_back(timeline);
+    }
+    mPendingTimelinesChanged.notify_one();
+}
+
+void LatencyAggregator::threadLoop() {
+    pthread_setname_np(pthread_self(), "InputLatencyAgg");
+    std::unique_lock lock(mLock);
+    while (true) {
+        mPendingTimelinesChanged.wait(lock, [this]() REQUIRES(mLock) {
+            return mShuttingDown || !mPendingTimelines.empty();
+        });
+        if (mShuttingDown) {
+            return;
+        }
+        while (!mPendingTimelines.empty()) {
+            const InputEventTimeline timeline = mPendingTimelines.front();
+            mPendingTimelines.pop_front();
+            processStatistics(timeline);
+            processHistograms(timeline);
+            processSlowEvent(timeline);
+        }
+    }
+}
+
+void LatencyAggregator::addHistogramSample(SketchIndex stage, nsecs_t latency) {
+    const int64_t hus = ns2hus(latency);
+    size_t bucket = 0;
+    if (hus > 0) {
+        bucket = std::min(static_cast<size_t>(64 - __builtin_clzll(static_cast<uint64_t>(hus))),
+                          NUM_HISTOGRAM_BUCKETS - 1);
+    }
+    mHistograms[stage][bucket]++;
+    mHistogramSampleCounts[stage]++;
+    if (ATRACE_ENABLED()) {
+        ATRACE_INT64((std::string("input.latency.") + kStageNames[stage]).c_str(),
+                     ns2us(latency));
+    }
+}
+
+void LatencyAggregator::processHistograms(const InputEventTimeline& timeline) {
+    // Unlike the sketches, the histograms are not capped by MAX_EVENTS_FOR_STATISTICS and are
+    // never reset, so they keep aggregating for the lifetime of the process.
+    addHistogramSample(SketchIndex::EVENT_TO_READ, timeline.readTime - timeline.eventTime);
+
+    for (const auto& [connectionToken, connectionTimeline] : timeline.connectionTimelines) {
+        if (!connectionTimeline.isComplete()) {
+            continue;
+        }
+        const nsecs_t gpuCompletedTime =
+                connectionTimeline.graphicsTimeline[GraphicsTimeline::GPU_COMPLETED_TIME];
+        const nsecs_t presentTime =
+                connectionTimeline.graphicsTimeline[GraphicsTimeline::PRESENT_TIME];
+
+        addHistogramSample(SketchIndex::READ_TO_DELIVER,
+                           connectionTimeline.deliveryTime - timeline.readTime);
+        addHistogramSample(SketchIndex::DELIVER_TO_CONSUME,
+                           connectionTimeline.consumeTime - connectionTimeline.deliveryTime);
+        addHistogramSample(SketchIndex::CONSUME_TO_FINISH,
+                           connectionTimeline.finishTime - connectionTimeline.consumeTime);
+        addHistogramSample(SketchIndex::CONSUME_TO_GPU_COMPLETE,
+                           gpuCompletedTime - connectionTimeline.consumeTime);
+        addHistogramSample(SketchIndex::GPU_COMPLETE_TO_PRESENT, presentTime - gpuCompletedTime);
+        addHistogramSample(SketchIndex::END_TO_END, presentTime - timeline.eventTime);
+    }
 }
 
 void LatencyAggregator::processStatistics(const InputEventTimeline& timeline) {
-    std::scoped_lock lock(mLock);
     // Before we do any processing, check that we have not yet exceeded MAX_SIZE
     if (mNumSketchEventsProcessed >= MAX_EVENTS_FOR_STATISTICS) {
         return;
@@ -278,8 +368,23 @@ std::string LatencyAggregator::dump(const char* prefix) const {
                              prefix, i, numDown, downBytesKb, i, numMove, moveBytesKb);
     }
 
-    return StringPrintf("%sLatencyAggregator:\n", prefix) + sketchDump +
+    std::string histogramDump =
+            StringPrintf("%s  Histograms (since boot; bucket b counts latencies in"
+                         " [0.1ms * 2^(b-1), 0.1ms * 2^b), last bucket is unbounded):\n",
+                         prefix);
+    for (size_t i = 0; i < SketchIndex::SIZE; i++) {
+        histogramDump += StringPrintf("%s    %s (n=%" PRIu64 "):", prefix, kStageNames[i],
+                                      mHistogramSampleCounts[i]);
+        for (size_t b = 0; b < NUM_HISTOGRAM_BUCKETS; b++) {
+            histogramDump += StringPrintf(" %" PRIu64, mHistograms[i][b]);
+        }
+        histogramDump += "\n";
+    }
+
+    return StringPrintf("%sLatencyAggregator:\n", prefix) + sketchDump + histogramDump +
             StringPrintf("%s  mNumSketchEventsProcessed=%zu\n", prefix, mNumSketchEventsProcessed) +
+            StringPrintf("%s  mPendingTimelines=%zu mNumTimelinesDropped=%zu\n", prefix,
+                         mPendingTimelines.size(), mNumTimelinesDropped) +
             StringPrintf("%s  mLastSlowEventTime=%" PRId64 "\n", prefix, mLastSlowEventTime) +
             StringPrintf("%s  mNumEventsSinceLastSlowEventReport = %zu\n", prefix,
                          mNumEventsSinceLastSlowEventReport) +
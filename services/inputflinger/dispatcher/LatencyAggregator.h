@@ -21,6 +21,10 @@
 #include <statslog.h>
 #include <utils/Timers.h>
 
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 #include "InputEventTimeline.h"
 
 namespace android::inputdispatcher {
@@ -69,19 +73,51 @@ private:
                                                                  void* cookie);
     AStatsManager_PullAtomCallbackReturn pullData(AStatsEventList* data);
 
+    // ---------- Background processing ----------
+    /**
+     * Completed timelines waiting for the aggregation thread. processTimeline only copies the
+     * timeline into this queue, so the dispatcher thread never pays for sketch compactions or
+     * statsd socket writes. The queue is bounded; timelines that arrive while it is full are
+     * dropped and counted, since stale telemetry is cheaper than unbounded memory.
+     */
+    static constexpr size_t MAX_PENDING_TIMELINES = 500;
+    std::deque<InputEventTimeline> mPendingTimelines GUARDED_BY(mLock);
+    size_t mNumTimelinesDropped GUARDED_BY(mLock) = 0;
+    bool mShuttingDown GUARDED_BY(mLock) = false;
+    std::condition_variable mPendingTimelinesChanged;
+    void threadLoop();
+
     // ---------- Slow event handling ----------
-    void processSlowEvent(const InputEventTimeline& timeline);
-    nsecs_t mLastSlowEventTime = 0;
+    void processSlowEvent(const InputEventTimeline& timeline) REQUIRES(mLock);
+    nsecs_t mLastSlowEventTime GUARDED_BY(mLock) = 0;
     // How many slow events have been skipped due to rate limiting
-    size_t mNumSkippedSlowEvents = 0;
+    size_t mNumSkippedSlowEvents GUARDED_BY(mLock) = 0;
     // How many events have been received since the last time we reported a slow event
-    size_t mNumEventsSinceLastSlowEventReport = 0;
+    size_t mNumEventsSinceLastSlowEventReport GUARDED_BY(mLock) = 0;
+
+    // ---------- Histogram handling ----------
+    /**
+     * Number of buckets in each always-on latency histogram. Bucket 0 counts latencies below
+     * 0.1 ms; bucket b counts latencies in [0.1ms * 2^(b-1), 0.1ms * 2^b), and the last bucket
+     * also absorbs everything above its lower bound.
+     */
+    static constexpr size_t NUM_HISTOGRAM_BUCKETS = 12;
+    using StageHistogram = std::array<uint64_t, NUM_HISTOGRAM_BUCKETS>;
+    void processHistograms(const InputEventTimeline& timeline) REQUIRES(mLock);
+    void addHistogramSample(SketchIndex stage, nsecs_t latency) REQUIRES(mLock);
+    /**
+     * Always-on histograms of the same stages as the sketches. Unlike the sketches, these are
+     * never reset by statsd pulls, so `dumpsys input` shows the tail behavior since boot
+     * without a statsd round trip.
+     */
+    std::array<StageHistogram, SketchIndex::SIZE> mHistograms GUARDED_BY(mLock) = {};
+    std::array<uint64_t, SketchIndex::SIZE> mHistogramSampleCounts GUARDED_BY(mLock) = {};
 
     // ---------- Statistics handling ----------
-    // Statistics is pulled rather than pushed. It's pulled on a binder thread, and therefore will
-    // be accessed by two different threads. The lock is needed to protect the pulled data.
+    // Statistics is pulled rather than pushed. It's pulled on a binder thread, while the
+    // aggregation thread fills the sketches in. The lock is needed to protect the pulled data.
     mutable std::mutex mLock;
-    void processStatistics(const InputEventTimeline& timeline);
+    void processStatistics(const InputEventTimeline& timeline) REQUIRES(mLock);
     // Sketches
     std::array<std::unique_ptr<dist_proc::aggregation::KllQuantile>, SketchIndex::SIZE>
             mDownSketches GUARDED_BY(mLock);
@@ -89,6 +125,10 @@ private:
             mMoveSketches GUARDED_BY(mLock);
     // How many events have been processed so far
     size_t mNumSketchEventsProcessed GUARDED_BY(mLock) = 0;
+
+    // The aggregation thread. Declared last so that everything it touches is initialized before
+    // it starts.
+    std::thread mThread;
 };
 
 } // namespace android::inputdispatcher
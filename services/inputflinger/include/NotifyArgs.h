@@ -114,7 +114,7 @@ struct NotifyMotionArgs {
                      uint32_t pointerCount, const PointerProperties* pointerProperties,
                      const PointerCoords* pointerCoords, float xPrecision, float yPrecision,
                      float xCursorPosition, float yCursorPosition, nsecs_t downTime,
-                     const std::vector<TouchVideoFrame>& videoFrames);
+                     std::vector<TouchVideoFrame> videoFrames);
 
     NotifyMotionArgs(const NotifyMotionArgs& other) = default;
     NotifyMotionArgs& operator=(const android::NotifyMotionArgs&) = default;
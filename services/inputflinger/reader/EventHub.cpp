@@ -85,6 +85,10 @@ static constexpr int32_t FF_WEAK_MAGNITUDE_CHANNEL_IDX = 1;
 
 static constexpr size_t EVENT_BUFFER_SIZE = 256;
 
+// Maximum number of consecutive reads to drain one device fd before moving on,
+// so a runaway device cannot starve the others or grow its buffer unbounded.
+static constexpr size_t MAX_READS_PER_DEVICE = 8;
+
 // Mapping for input battery class node IDs lookup.
 // https://www.kernel.org/doc/Documentation/power/power_supply_class.txt
 static const std::unordered_map<std::string, InputBatteryClass> BATTERY_CLASSES =
@@ -1843,6 +1847,17 @@ std::optional<int32_t> EventHub::getBatteryStatus(int32_t deviceId, int32_t batt
     return std::nullopt;
 }
 
+void EventHub::emitBufferedEventsLocked(Device& device, std::vector<RawEvent>& events) {
+    while (device.bufferedEventsBegin < device.bufferedEvents.size() &&
+           events.size() < EVENT_BUFFER_SIZE) {
+        events.push_back(device.bufferedEvents[device.bufferedEventsBegin++]);
+    }
+    if (device.bufferedEventsBegin == device.bufferedEvents.size()) {
+        device.bufferedEvents.clear();
+        device.bufferedEventsBegin = 0;
+    }
+}
+
 std::vector<RawEvent> EventHub::getEvents(int timeoutMillis) {
     std::scoped_lock _l(mLock);
 
@@ -1918,6 +1933,18 @@ std::vector<RawEvent> EventHub::getEvents(int timeoutMillis) {
             }
         }
 
+        // Deliver events drained into per-device buffers by a previous call
+        // before reading anything new, so batching never reorders a device's
+        // stream.
+        for (const auto& [deviceId, device] : mDevices) {
+            if (!device->bufferedEvents.empty()) {
+                emitBufferedEventsLocked(*device, events);
+                if (events.size() >= EVENT_BUFFER_SIZE) {
+                    break;
+                }
+            }
+        }
+
         // Grab the next input event.
         bool deviceChanged = false;
         while (mPendingEventIndex < mPendingEventCount) {
@@ -1976,45 +2003,64 @@ std::vector<RawEvent> EventHub::getEvents(int timeoutMillis) {
             }
             // This must be an input event
             if (eventItem.events & EPOLLIN) {
-                int32_t readSize =
-                        read(device->fd, readBuffer.data(),
-                             sizeof(decltype(readBuffer)::value_type) * readBuffer.size());
-                if (readSize == 0 || (readSize < 0 && errno == ENODEV)) {
-                    // Device was removed before INotify noticed.
-                    ALOGW("could not get event, removed? (fd: %d size: %" PRId32
-                          " capacity: %zu errno: %d)\n",
-                          device->fd, readSize, readBuffer.size(), errno);
-                    deviceChanged = true;
-                    closeDeviceLocked(*device);
-                } else if (readSize < 0) {
-                    if (errno != EAGAIN && errno != EINTR) {
-                        ALOGW("could not get event (errno=%d)", errno);
-                    }
-                } else if ((readSize % sizeof(struct input_event)) != 0) {
-                    ALOGE("could not get event (wrong size: %d)", readSize);
-                } else {
-                    const int32_t deviceId = device->id == mBuiltInKeyboardId ? 0 : device->id;
-
-                    const size_t count = size_t(readSize) / sizeof(struct input_event);
-                    for (size_t i = 0; i < count; i++) {
-                        struct input_event& iev = readBuffer[i];
-                        device->trackInputEvent(iev);
-                        events.push_back({
-                                .when = processEventTimestamp(iev),
-                                .readTime = systemTime(SYSTEM_TIME_MONOTONIC),
-                                .deviceId = deviceId,
-                                .type = iev.type,
-                                .code = iev.code,
-                                .value = iev.value,
-                        });
-                    }
-                    if (events.size() >= EVENT_BUFFER_SIZE) {
-                        // The result buffer is full.  Reset the pending event index
-                        // so we will try to read the device again on the next iteration.
-                        mPendingEventIndex -= 1;
+                // Drain the fd in bulk instead of one buffer per epoll wakeup:
+                // a 1kHz device then costs one read per batch rather than one
+                // epoll_wait + read per EVENT_BUFFER_SIZE events. Events that
+                // do not fit in the caller's batch are parked on the device
+                // and delivered by the next call without touching the fd.
+                bool deviceRemoved = false;
+                for (size_t readCount = 0; readCount < MAX_READS_PER_DEVICE; readCount++) {
+                    int32_t readSize =
+                            read(device->fd, readBuffer.data(),
+                                 sizeof(decltype(readBuffer)::value_type) * readBuffer.size());
+                    if (readSize == 0 || (readSize < 0 && errno == ENODEV)) {
+                        // Device was removed before INotify noticed.
+                        ALOGW("could not get event, removed? (fd: %d size: %" PRId32
+                              " capacity: %zu errno: %d)\n",
+                              device->fd, readSize, readBuffer.size(), errno);
+                        deviceChanged = true;
+                        deviceRemoved = true;
+                        closeDeviceLocked(*device);
+                        break;
+                    } else if (readSize < 0) {
+                        if (errno != EAGAIN && errno != EINTR) {
+                            ALOGW("could not get event (errno=%d)", errno);
+                        }
                         break;
+                    } else if ((readSize % sizeof(struct input_event)) != 0) {
+                        ALOGE("could not get event (wrong size: %d)", readSize);
+                        break;
+                    } else {
+                        const int32_t deviceId = device->id == mBuiltInKeyboardId ? 0 : device->id;
+
+                        const size_t count = size_t(readSize) / sizeof(struct input_event);
+                        const nsecs_t readTime = systemTime(SYSTEM_TIME_MONOTONIC);
+                        for (size_t i = 0; i < count; i++) {
+                            struct input_event& iev = readBuffer[i];
+                            device->trackInputEvent(iev);
+                            device->bufferedEvents.push_back({
+                                    .when = processEventTimestamp(iev),
+                                    .readTime = readTime,
+                                    .deviceId = deviceId,
+                                    .type = iev.type,
+                                    .code = iev.code,
+                                    .value = iev.value,
+                            });
+                        }
+                        if (count < readBuffer.size()) {
+                            // Short read: the fd is drained.
+                            break;
+                        }
                     }
                 }
+                if (!deviceRemoved) {
+                    emitBufferedEventsLocked(*device, events);
+                }
+                if (events.size() >= EVENT_BUFFER_SIZE) {
+                    // The result buffer is full. Remaining events stay parked
+                    // in per-device buffers for the next call.
+                    break;
+                }
             } else if (eventItem.events & EPOLLHUP) {
                 ALOGI("Removing device %s due to epoll hang-up event.",
                       device->identifier.name.c_str());
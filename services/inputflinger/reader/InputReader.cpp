@@ -135,6 +135,21 @@ status_t InputReader::stop() {
     return OK;
 }
 
+// Returns the size of the contiguous run of events at the front of the buffer that is processed
+// as one batch: a run of raw events from a single device, or a single synthetic event.
+static size_t deviceBatchSize(const RawEvent* rawEvents, size_t count) {
+    if (rawEvents->type >= EventHubInterface::FIRST_SYNTHETIC_EVENT) {
+        return 1;
+    }
+    size_t batchSize = 1;
+    while (batchSize < count &&
+           rawEvents[batchSize].type < EventHubInterface::FIRST_SYNTHETIC_EVENT &&
+           rawEvents[batchSize].deviceId == rawEvents->deviceId) {
+        batchSize += 1;
+    }
+    return batchSize;
+}
+
 void InputReader::loopOnce() {
     int32_t oldGeneration;
     int32_t timeoutMillis;
@@ -164,10 +179,38 @@ void InputReader::loopOnce() {
     { // acquire lock
         std::scoped_lock _l(mLock);
         mReaderIsAliveCondition.notify_all();
+    } // release lock
+
+    // Batches from different devices are independent of each other, so process and flush the
+    // stream one device batch at a time. Events from a device with cheap mappers that are queued
+    // behind a large batch from a device with expensive ones then reach the listener without
+    // waiting for the latter to be processed. Stream order is preserved.
+    for (size_t processedCount = 0; processedCount < events.size();) {
+        const size_t batchSize =
+                deviceBatchSize(events.data() + processedCount, events.size() - processedCount);
+        std::list<NotifyArgs> batchArgs;
+        { // acquire lock
+            std::scoped_lock _l(mLock);
+            mPendingArgs += processEventsLocked(events.data() + processedCount, batchSize);
+            std::swap(batchArgs, mPendingArgs);
+
+            // Keep track of the last used device
+            for (const NotifyArgs& args : batchArgs) {
+                mLastUsedDeviceId = getDeviceIdOfNewGesture(args).value_or(mLastUsedDeviceId);
+            }
+        } // release lock
 
-        if (!events.empty()) {
-            mPendingArgs += processEventsLocked(events.data(), events.size());
+        // Flush outside of the lock, for the same reasons as the flush below.
+        for (const NotifyArgs& args : batchArgs) {
+            mNextListener.notify(args);
         }
+        notifyArgs.splice(notifyArgs.end(), batchArgs);
+        processedCount += batchSize;
+    }
+
+    std::list<NotifyArgs> remainingArgs;
+    { // acquire lock
+        std::scoped_lock _l(mLock);
 
         if (mNextTimeout != LLONG_MAX) {
             nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
@@ -190,10 +233,10 @@ void InputReader::loopOnce() {
                     NotifyInputDevicesChangedArgs{mContext.getNextId(), inputDevices});
         }
 
-        std::swap(notifyArgs, mPendingArgs);
+        std::swap(remainingArgs, mPendingArgs);
 
         // Keep track of the last used device
-        for (const NotifyArgs& args : notifyArgs) {
+        for (const NotifyArgs& args : remainingArgs) {
             mLastUsedDeviceId = getDeviceIdOfNewGesture(args).value_or(mLastUsedDeviceId);
         }
     } // release lock
@@ -205,9 +248,10 @@ void InputReader::loopOnce() {
     // resulting in a deadlock.  This situation is actually quite plausible because the
     // listener is actually the input dispatcher, which calls into the window manager,
     // which occasionally calls into the input reader.
-    for (const NotifyArgs& args : notifyArgs) {
+    for (const NotifyArgs& args : remainingArgs) {
         mNextListener.notify(args);
     }
+    notifyArgs.splice(notifyArgs.end(), remainingArgs);
 
     // Notify the policy that input devices have changed.
     // This must be done after flushing events down the listener chain to ensure that the rest of
@@ -228,21 +272,12 @@ void InputReader::loopOnce() {
 std::list<NotifyArgs> InputReader::processEventsLocked(const RawEvent* rawEvents, size_t count) {
     std::list<NotifyArgs> out;
     for (const RawEvent* rawEvent = rawEvents; count;) {
-        int32_t type = rawEvent->type;
-        size_t batchSize = 1;
-        if (type < EventHubInterface::FIRST_SYNTHETIC_EVENT) {
-            int32_t deviceId = rawEvent->deviceId;
-            while (batchSize < count) {
-                if (rawEvent[batchSize].type >= EventHubInterface::FIRST_SYNTHETIC_EVENT ||
-                    rawEvent[batchSize].deviceId != deviceId) {
-                    break;
-                }
-                batchSize += 1;
-            }
+        const size_t batchSize = deviceBatchSize(rawEvent, count);
+        if (rawEvent->type < EventHubInterface::FIRST_SYNTHETIC_EVENT) {
             if (debugRawEvents()) {
                 ALOGD("BatchSize: %zu Count: %zu", batchSize, count);
             }
-            out += processEventsForDeviceLocked(deviceId, rawEvent, batchSize);
+            out += processEventsForDeviceLocked(rawEvent->deviceId, rawEvent, batchSize);
         } else {
             switch (rawEvent->type) {
                 case EventHubInterface::DEVICE_ADDED:
@@ -654,6 +654,14 @@ private:
         bool ffEffectPlaying;
         int16_t ffEffectId; // initially -1
 
+        // Events drained from the fd but not yet returned by getEvents().
+        // Each readable fd is drained in bulk so high-rate devices coalesce
+        // into fewer reads and wakeups; whatever does not fit into the
+        // caller's batch is parked here until the next call. Consumed from
+        // bufferedEventsBegin; cleared once fully delivered.
+        std::vector<RawEvent> bufferedEvents;
+        size_t bufferedEventsBegin{0};
+
         // A shared_ptr of a device associated with the input device.
         // The input devices that have the same sysfs path have the same associated device.
         std::shared_ptr<const AssociatedDevice> associatedDevice;
@@ -730,6 +738,10 @@ private:
     status_t scanVideoDirLocked(const std::string& dirname) REQUIRES(mLock);
     void scanDevicesLocked() REQUIRES(mLock);
     base::Result<void> readNotifyLocked() REQUIRES(mLock);
+
+    // Moves events parked in device.bufferedEvents into the result vector,
+    // up to the EVENT_BUFFER_SIZE batch limit.
+    void emitBufferedEventsLocked(Device& device, std::vector<RawEvent>& events) REQUIRES(mLock);
     void handleNotifyEventLocked(const inotify_event&) REQUIRES(mLock);
 
     Device* getDeviceLocked(int32_t deviceId) const REQUIRES(mLock);
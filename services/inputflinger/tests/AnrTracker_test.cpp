@@ -132,6 +132,23 @@ TEST(AnrTrackerTest, MultipleTokens_IdenticalTimesRemove) {
     ASSERT_EQ(token1, tracker.firstToken());
 }
 
+TEST(AnrTrackerTest, SingleToken_RemoveOutOfOrder) {
+    AnrTracker tracker;
+
+    sp<IBinder> token = sp<BBinder>::make();
+
+    tracker.insert(1, token);
+    tracker.insert(3, token);
+    tracker.insert(5, token);
+
+    // Remove an entry that is neither the oldest nor the newest for this connection
+    tracker.erase(3, token);
+
+    ASSERT_EQ(1, tracker.firstTimeout());
+    tracker.erase(1, token);
+    ASSERT_EQ(5, tracker.firstTimeout());
+}
+
 TEST(AnrTrackerTest, Empty_DoesntCrash) {
     AnrTracker tracker;
 
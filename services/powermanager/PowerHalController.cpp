@@ -146,6 +146,78 @@ HalResult<std::shared_ptr<PowerHintSessionWrapper>> PowerHalController::createHi
                                           "createHintSessionWithConfig"));
 }
 
+HalResult<std::vector<std::shared_ptr<PowerHintSessionWrapper>>>
+PowerHalController::createHintSessions(int32_t tgid, int32_t uid,
+                                       const std::vector<std::vector<int32_t>>& threadIdsPerSession,
+                                       int64_t durationNanos) {
+    using Sessions = std::vector<std::shared_ptr<PowerHintSessionWrapper>>;
+    std::shared_ptr<HalWrapper> handle = initHal();
+    Sessions sessions;
+    sessions.reserve(threadIdsPerSession.size());
+    for (const auto& threadIds : threadIdsPerSession) {
+        auto result = processHalResult(handle->createHintSession(tgid, uid, threadIds,
+                                                                 durationNanos),
+                                       "createHintSession");
+        if (!result.isOk()) {
+            // Don't leave a partial batch behind.
+            for (auto& session : sessions) {
+                session->close();
+            }
+            return result.isUnsupported() ? HalResult<Sessions>::unsupported()
+                                          : HalResult<Sessions>::failed(result.errorMessage());
+        }
+        sessions.push_back(result.value());
+    }
+    return HalResult<Sessions>::ok(std::move(sessions));
+}
+
+void PowerHalController::prepareLaunchBoostSessions(int32_t tgid, int32_t uid, size_t count,
+                                                    int64_t durationNanos) {
+    // The process main thread (tid == tgid) exists as soon as the process
+    // does, so use it as a placeholder until the real threads are known.
+    std::vector<std::vector<int32_t>> placeholders(count, std::vector<int32_t>{tgid});
+    auto result = createHintSessions(tgid, uid, placeholders, durationNanos);
+    if (!result.isOk()) {
+        return;
+    }
+    std::vector<std::shared_ptr<PowerHintSessionWrapper>> sessions = result.value();
+    for (auto& session : sessions) {
+        session->pause();
+    }
+    std::vector<std::shared_ptr<PowerHintSessionWrapper>> stale;
+    {
+        std::lock_guard<std::mutex> lock(mSessionPoolMutex);
+        stale = std::move(mPooledSessions);
+        mPooledSessions = std::move(sessions);
+        mPooledSessionTgid = tgid;
+        mPooledSessionUid = uid;
+    }
+    for (auto& session : stale) {
+        session->close();
+    }
+}
+
+HalResult<std::shared_ptr<PowerHintSessionWrapper>> PowerHalController::acquireLaunchBoostSession(
+        int32_t tgid, int32_t uid, const std::vector<int32_t>& threadIds, int64_t durationNanos) {
+    std::shared_ptr<PowerHintSessionWrapper> pooled;
+    {
+        std::lock_guard<std::mutex> lock(mSessionPoolMutex);
+        if (tgid == mPooledSessionTgid && uid == mPooledSessionUid && !mPooledSessions.empty()) {
+            pooled = std::move(mPooledSessions.back());
+            mPooledSessions.pop_back();
+        }
+    }
+    if (pooled != nullptr) {
+        if (pooled->setThreads(threadIds).isOk() && pooled->resume().isOk()) {
+            return HalResult<std::shared_ptr<PowerHintSessionWrapper>>::ok(std::move(pooled));
+        }
+        // Retargeting is only available on newer session versions; fall back
+        // to a fresh session rather than boosting the placeholder thread.
+        pooled->close();
+    }
+    return createHintSession(tgid, uid, threadIds, durationNanos);
+}
+
 HalResult<int64_t> PowerHalController::getHintSessionPreferredRate() {
     std::shared_ptr<HalWrapper> handle = initHal();
     return CACHE_SUPPORT(2,
@@ -215,6 +215,21 @@ TEST_F(PowerHalControllerTest, TestPowerHalDoesNotTryToRecoverFromFailureOnUnsup
     EXPECT_EQ(powerHalResetCount, 0);
 }
 
+TEST_F(PowerHalControllerTest, TestHintSessionBatchAndPoolUnsupportedOnOldPowerHal) {
+    auto batchResult = mHalController->createHintSessions(1, 10, {{1}, {2}}, 1000);
+    ASSERT_TRUE(batchResult.isUnsupported());
+
+    // Arming the pool on a HAL without hint sessions is a no-op and acquiring
+    // falls back to regular session creation, which is also unsupported.
+    mHalController->prepareLaunchBoostSessions(1, 10, 2, 1000);
+    auto acquireResult = mHalController->acquireLaunchBoostSession(1, 10, {1}, 1000);
+    ASSERT_TRUE(acquireResult.isUnsupported());
+
+    // PowerHalConnector was never reset for unsupported calls.
+    int powerHalResetCount = mHalConnector->getResetCount();
+    EXPECT_EQ(powerHalResetCount, 0);
+}
+
 TEST_F(PowerHalControllerTest, TestMultiThreadConnectsOnlyOnce) {
     int powerHalConnectCount = mHalConnector->getConnectCount();
     EXPECT_EQ(powerHalConnectCount, 0);
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <pthread.h>
 #include <stdint.h>
 #include <math.h>
 #include <sys/types.h>
@@ -21,6 +22,7 @@
 #include <cutils/atomic.h>
 #include <utils/Errors.h>
 #include <utils/Singleton.h>
+#include <utils/Timers.h>
 
 #include <binder/BinderService.h>
 #include <binder/Parcel.h>
@@ -31,45 +33,84 @@ namespace android {
 // ---------------------------------------------------------------------------
 
 BatteryService::BatteryService()
-    : mBatteryStatService(nullptr), mLastWakeupSensorEventReportedMs(0) {}
+    : mBatteryStatService(nullptr), mLastWakeupSensorEventReportedMs(0),
+      mHasPendingNotes(false) {
+    std::thread(&BatteryService::flushLoop, this).detach();
+}
+
+void BatteryService::enableSensorImpl(uid_t uid, int handle) {
+    Mutex::Autolock _l(mActivationsLock);
+    updateSensorLocked(uid, handle, true);
+}
 
-bool BatteryService::addSensor(uid_t uid, int handle) {
+void BatteryService::disableSensorImpl(uid_t uid, int handle) {
     Mutex::Autolock _l(mActivationsLock);
+    updateSensorLocked(uid, handle, false);
+}
+
+void BatteryService::updateSensorLocked(uid_t uid, int handle, bool enabled) {
     Info key(uid, handle);
     ssize_t index = mActivations.indexOf(key);
     if (index < 0) {
+        if (!enabled) return;
         index = mActivations.add(key);
     }
     Info& info(mActivations.editItemAt(index));
-    info.count++;
-    return info.count == 1;
-}
-
-bool BatteryService::removeSensor(uid_t uid, int handle) {
-    Mutex::Autolock _l(mActivationsLock);
-    ssize_t index = mActivations.indexOf(Info(uid, handle));
-    if (index < 0) return false;
-    Info& info(mActivations.editItemAt(index));
-    info.count--;
-    return info.count == 0;
+    if (enabled) {
+        info.count++;
+    } else if (info.count > 0) {
+        info.count--;
+    }
+    // Only the first delta after a flush needs to wake the flush thread; it
+    // stays asleep for SENSOR_NOTE_FLUSH_DELAY_MS after waking so that bursts
+    // of churn collapse into a single reconciliation pass.
+    if (((info.count > 0) != info.noted) && !mHasPendingNotes) {
+        mHasPendingNotes = true;
+        mFlushCondition.signal();
+    }
 }
 
+void BatteryService::flushLoop() {
+    pthread_setname_np(pthread_self(), "BatteryService");
+    mActivationsLock.lock();
+    while (true) {
+        while (!mHasPendingNotes) {
+            mFlushCondition.wait(mActivationsLock);
+        }
+        // Accumulation window: enables and disables that cancel out before it
+        // elapses are never reported.
+        mFlushCondition.waitRelative(mActivationsLock, ms2ns(SENSOR_NOTE_FLUSH_DELAY_MS));
 
-void BatteryService::enableSensorImpl(uid_t uid, int handle) {
-    if (checkService()) {
-        if (addSensor(uid, handle)) {
-            int64_t identity = IPCThreadState::self()->clearCallingIdentity();
-            mBatteryStatService->noteStartSensor(uid, handle);
-            IPCThreadState::self()->restoreCallingIdentity(identity);
+        Vector<Info> deltas;
+        for (size_t i = 0; i < mActivations.size();) {
+            Info& info(mActivations.editItemAt(i));
+            const bool enabled = info.count > 0;
+            if (enabled != info.noted) {
+                deltas.push(info);
+                info.noted = enabled;
+            }
+            if (info.count == 0 && !info.noted) {
+                mActivations.removeAt(i);
+            } else {
+                i++;
+            }
         }
-    }
-}
-void BatteryService::disableSensorImpl(uid_t uid, int handle) {
-    if (checkService()) {
-        if (removeSensor(uid, handle)) {
-            int64_t identity = IPCThreadState::self()->clearCallingIdentity();
-            mBatteryStatService->noteStopSensor(uid, handle);
-            IPCThreadState::self()->restoreCallingIdentity(identity);
+        mHasPendingNotes = false;
+
+        if (!deltas.isEmpty()) {
+            mActivationsLock.unlock();
+            if (checkService()) {
+                int64_t identity = IPCThreadState::self()->clearCallingIdentity();
+                for (const Info& delta : deltas) {
+                    if (delta.count > 0) {
+                        mBatteryStatService->noteStartSensor(delta.uid, delta.handle);
+                    } else {
+                        mBatteryStatService->noteStopSensor(delta.uid, delta.handle);
+                    }
+                }
+                IPCThreadState::self()->restoreCallingIdentity(identity);
+            }
+            mActivationsLock.lock();
         }
     }
 }
@@ -17,7 +17,10 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#include <thread>
+
 #include <batterystats/IBatteryStats.h>
+#include <utils/Condition.h>
 #include <utils/Singleton.h>
 #include <utils/SortedVector.h>
 #include <utils/SystemClock.h>
@@ -27,6 +30,10 @@ namespace android {
 
 class BatteryService : public Singleton<BatteryService> {
     static constexpr int64_t WAKEUP_SENSOR_EVENT_DEBOUNCE_MS = 1000;
+    // How long enable/disable deltas are accumulated locally before the net
+    // result is reported to batterystats. Toggles that cancel out within the
+    // window generate no IPC at all.
+    static constexpr int64_t SENSOR_NOTE_FLUSH_DELAY_MS = 500;
 
     friend class Singleton<BatteryService>;
     sp<IBatteryStats> mBatteryStatService;
@@ -41,8 +48,11 @@ class BatteryService : public Singleton<BatteryService> {
         uid_t uid;
         int handle;
         int32_t count;
-        Info()  : uid(0), handle(0), count(0) { }
-        Info(uid_t uid, int handle) : uid(uid), handle(handle), count(0) { }
+        // Whether batterystats currently believes this sensor is started for
+        // this uid. Reconciled against count by the flush thread.
+        bool noted;
+        Info()  : uid(0), handle(0), count(0), noted(false) { }
+        Info(uid_t uid, int handle) : uid(uid), handle(handle), count(0), noted(false) { }
         bool operator < (const Info& rhs) const {
             return (uid == rhs.uid) ? (handle < rhs.handle) :  (uid < rhs.uid);
         }
@@ -50,9 +60,11 @@ class BatteryService : public Singleton<BatteryService> {
 
     int64_t mLastWakeupSensorEventReportedMs;
     Mutex mActivationsLock;
+    Condition mFlushCondition;
     SortedVector<Info> mActivations;
-    bool addSensor(uid_t uid, int handle);
-    bool removeSensor(uid_t uid, int handle);
+    bool mHasPendingNotes;
+    void updateSensorLocked(uid_t uid, int handle, bool enabled);
+    void flushLoop();
     bool checkService();
 
 public:
@@ -104,6 +104,15 @@ static const float MIN_VALID_CROSS_PRODUCT_MAG_SQ =
 
 static const float SQRT_3 = 1.732f;
 static const float WVEC_EPS = 1e-4f/SQRT_3;
+
+/*
+ * Maximum amount of time the covariance propagation may lag behind the
+ * attitude integration. At typical (<= 100Hz) gyro rates every sample still
+ * propagates P immediately; at higher rates consecutive samples are coalesced
+ * into a single propagation, which is where most of the per-sample matrix
+ * arithmetic goes. The attitude itself is always integrated per sample.
+ */
+static const float MAX_COVARIANCE_DEFERRAL_T = 0.01f; // s
 // -----------------------------------------------------------------------
 
 template <typename TYPE, size_t C, size_t R>
@@ -187,6 +196,10 @@ Fusion::Fusion() {
     x0 = 0;
     x1 = 0;
 
+    mPendingRotation = 0;
+    mPendingDT = 0;
+    mPendingCount = 0;
+
     init();
 }
 
@@ -250,6 +263,10 @@ void Fusion::initFusion(const vec4_t& q, float dT)
     // initial covariance: Var{ x(t0) }
     // TODO: initialize P correctly
     P = 0;
+
+    mPendingRotation = 0;
+    mPendingDT = 0;
+    mPendingCount = 0;
 }
 
 bool Fusion::hasEstimate() const {
@@ -442,10 +459,49 @@ void Fusion::predict(const vec3_t& w, float dT) {
     //        | -psi'                              cos(0.5*||w||*dT) |
     //
     // psi = sin(0.5*||w||*dT)*w / ||w||
-    //
-    //
-    // P(k+1) = Phi(k)*P(k)*Phi(k)' + G*Q(k)*G'
-    // ----------------------------------------
+
+    const float lwedT = length(we)*dT;
+    const float hlwedT = 0.5f*lwedT;
+    const float ilwe = 1.f/length(we);
+    const float k2 = cosf(hlwedT);
+    const vec3_t psi(sinf(hlwedT)*ilwe*we);
+    const mat33_t O33(crossMatrix(-psi, k2));
+    mat44_t O;
+    O[0].xyz = O33[0];  O[0].w = -psi.x;
+    O[1].xyz = O33[1];  O[1].w = -psi.y;
+    O[2].xyz = O33[2];  O[2].w = -psi.z;
+    O[3].xyz = psi;     O[3].w = k2;
+
+    x0 = O*q;
+
+    if (x0.w < 0)
+        x0 = -x0;
+
+    // The covariance propagation is amortized over a burst of samples: we
+    // accumulate the unbiased rotation increment and propagate P once per
+    // MAX_COVARIANCE_DEFERRAL_T worth of gyro data, or whenever a measurement
+    // update needs an up-to-date P. Over such a short window the composed
+    // transition matrix is, to second order, that of the average rate, and
+    // the process noise accumulates additively.
+    mPendingRotation += we*dT;
+    mPendingDT += dT;
+    mPendingCount++;
+    if (mPendingDT >= MAX_COVARIANCE_DEFERRAL_T) {
+        flushCovariancePropagation();
+    }
+}
+
+void Fusion::flushCovariancePropagation() {
+    if (mPendingCount == 0)
+        return;
+
+    const float dT = mPendingDT;
+    vec3_t we = mPendingRotation * (1.f/dT);
+    if (length(we) < WVEC_EPS) {
+        we = (we[0]>0.f)?WVEC_EPS:-WVEC_EPS;
+    }
+    // P(k+n) = Phi(k)*P(k)*Phi(k)' + n*G*Q(k)*G'
+    // ------------------------------------------
     //
     // G = | -I33    0 |
     //     |    0  I33 |
@@ -466,33 +522,34 @@ void Fusion::predict(const vec3_t& w, float dT) {
     const mat33_t wx(crossMatrix(we, 0));
     const mat33_t wx2(wx*wx);
     const float lwedT = length(we)*dT;
-    const float hlwedT = 0.5f*lwedT;
     const float ilwe = 1.f/length(we);
     const float k0 = (1-cosf(lwedT))*(ilwe*ilwe);
     const float k1 = sinf(lwedT);
-    const float k2 = cosf(hlwedT);
-    const vec3_t psi(sinf(hlwedT)*ilwe*we);
-    const mat33_t O33(crossMatrix(-psi, k2));
-    mat44_t O;
-    O[0].xyz = O33[0];  O[0].w = -psi.x;
-    O[1].xyz = O33[1];  O[1].w = -psi.y;
-    O[2].xyz = O33[2];  O[2].w = -psi.z;
-    O[3].xyz = psi;     O[3].w = k2;
 
     Phi[0][0] = I33 - wx*(k1*ilwe) + wx2*k0;
     Phi[1][0] = wx*k0 - I33dT - wx2*(ilwe*ilwe*ilwe)*(lwedT-k1);
 
-    x0 = O*q;
+    P = Phi*P*transpose(Phi);
 
-    if (x0.w < 0)
-        x0 = -x0;
+    // GQGt was computed for the per-sample period, so a burst of n samples
+    // accumulates n times the process noise.
+    const float n = float(mPendingCount);
+    P[0][0] += GQGt[0][0]*n;
+    P[1][0] += GQGt[1][0]*n;
+    P[0][1] += GQGt[0][1]*n;
+    P[1][1] += GQGt[1][1]*n;
 
-    P = Phi*P*transpose(Phi) + GQGt;
+    mPendingRotation = 0;
+    mPendingDT = 0;
+    mPendingCount = 0;
 
     checkState();
 }
 
 void Fusion::update(const vec3_t& z, const vec3_t& Bi, float sigma) {
+    // measurement updates need the covariance brought up to date first
+    flushCovariancePropagation();
+
     vec4_t q(x0);
     // measured vector in body space: h(p) = A(p)*Bi
     const mat33_t A(quatToMatrix(q));
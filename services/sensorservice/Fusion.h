@@ -81,6 +81,16 @@ private:
 
     mat<mat33_t, 2, 2> Phi;
     vec3_t Ba, Bm;
+
+    /*
+     * Deferred covariance propagation: consecutive gyro predictions are
+     * coalesced and P is propagated once per burst (see predict()). The
+     * attitude itself is still integrated on every sample.
+     */
+    vec3_t mPendingRotation;
+    float mPendingDT;
+    uint32_t mPendingCount;
+
     uint32_t mInitState;
     float mGyroRate;
     vec<vec3_t, 3> mData;
@@ -92,6 +102,7 @@ private:
     void initFusion(const vec4_t& q0, float dT);
     void checkState();
     void predict(const vec3_t& w, float dT);
+    void flushCovariancePropagation();
     void update(const vec3_t& z, const vec3_t& Bi, float sigma);
     static mat34_t getF(const vec4_t& p);
     static vec3_t getOrthogonal(const vec3_t &v);
@@ -523,13 +523,10 @@ status_t SensorDevice::activateLocked(void* ident, int handle, int enabled) {
                 // This is the last connection, we need to de-activate the underlying h/w sensor.
                 activateHardware = true;
             } else {
-                // Call batch for this sensor with the previously calculated best effort
-                // batch_rate and timeout. One of the apps has unregistered for sensor
-                // events, and the best effort batch parameters might have changed.
-                ALOGD_IF(DEBUG_CONNECTIONS, "\t>>> actuating h/w batch 0x%08x %" PRId64 " %" PRId64,
-                         handle, info.bestBatchParams.mTSample, info.bestBatchParams.mTBatch);
-                mHalWrapper->batch(handle, info.bestBatchParams.mTSample,
-                                   info.bestBatchParams.mTBatch);
+                // One of the apps has unregistered for sensor events, and the best effort
+                // batch parameters might have changed. This only reaches the HAL when the
+                // remaining clients actually need different parameters.
+                updateBatchParamsLocked(handle, info);
             }
         } else {
             // sensor wasn't enabled for this ident
@@ -625,12 +622,16 @@ status_t SensorDevice::updateBatchParamsLocked(int handle, Info& info) {
              prevBestBatchParams.mTBatch, info.bestBatchParams.mTBatch);
 
     status_t err(NO_ERROR);
-    // If the min period or min timeout has changed since the last batch call, call batch.
-    if (prevBestBatchParams != info.bestBatchParams && info.numActiveClients() > 0) {
+    // Only reconfigure the HAL if the parameters it currently runs with no longer satisfy the
+    // selected ones.
+    if (info.numActiveClients() > 0 && info.needsHalReconfiguration()) {
         ALOGD_IF(DEBUG_CONNECTIONS, "\t>>> actuating h/w BATCH 0x%08x %" PRId64 " %" PRId64, handle,
                  info.bestBatchParams.mTSample, info.bestBatchParams.mTBatch);
         err = mHalWrapper->batch(handle, info.bestBatchParams.mTSample,
                                  info.bestBatchParams.mTBatch);
+        if (err == NO_ERROR) {
+            info.configuredBatchParams = info.bestBatchParams;
+        }
     }
 
     return err;
@@ -752,6 +753,7 @@ void SensorDevice::enableAllSensors() {
         ALOGE_IF(err, "Error calling batch on sensor %d (%s)", sensor_handle, strerror(-err));
 
         if (err == NO_ERROR) {
+            info.configuredBatchParams = info.bestBatchParams;
             err = mHalWrapper->activate(sensor_handle, 1 /* enabled */);
             ALOGE_IF(err, "Error activating sensor %d (%s)", sensor_handle, strerror(-err));
         }
@@ -900,6 +902,25 @@ void SensorDevice::Info::selectBatchParams() {
     bestBatchParams = bestParams;
 }
 
+bool SensorDevice::Info::needsHalReconfiguration() const {
+    if (configuredBatchParams.mTSample == bestBatchParams.mTSample &&
+        configuredBatchParams.mTBatch == bestBatchParams.mTBatch) {
+        return false;
+    }
+    // Hysteresis for clients churning between nearby rates: keep the current
+    // configuration when the hardware already samples at least as fast as
+    // required and oversamples by no more than ~10%, so the extra power cost
+    // is bounded. Never skip when the hardware would undersample or batch
+    // longer than requested.
+    if (configuredBatchParams.mTBatch == bestBatchParams.mTBatch &&
+        configuredBatchParams.mTSample <= bestBatchParams.mTSample &&
+        bestBatchParams.mTSample - configuredBatchParams.mTSample <=
+                bestBatchParams.mTSample / 10) {
+        return false;
+    }
+    return true;
+}
+
 ssize_t SensorDevice::Info::removeBatchParamsForIdent(void* ident) {
     ssize_t idx = batchParams.removeItem(ident);
     if (idx >= 0) {
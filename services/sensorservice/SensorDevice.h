@@ -164,6 +164,10 @@ private:
     // has registered for this sensor.
     struct Info {
         BatchParams bestBatchParams;
+        // Parameters the HAL was last configured with. Only updated after a successful
+        // batch() call on the HAL, so it can lag behind bestBatchParams when
+        // reconfiguration was skipped (see needsHalReconfiguration()) or failed.
+        BatchParams configuredBatchParams;
         // Key is the unique identifier(ident) for each client, value is the batch parameters
         // requested by the client.
         KeyedVector<void*, BatchParams> batchParams;
@@ -185,6 +189,11 @@ private:
             return batchParams.indexOfKey(ident) >= 0;
         }
 
+        // Returns true if the HAL must be reconfigured to honor bestBatchParams.
+        // HAL reconfiguration is expensive on some parts, so tolerate slight
+        // oversampling instead of chasing every small rate change.
+        bool needsHalReconfiguration() const;
+
         /**
          * @return The number of active clients of this sensor.
          */
@@ -196,18 +196,41 @@ int32_t SensorService::SensorDirectConnection::configureChannel(int handle, int
     };
 
     Mutex::Autolock _l(mConnectionLock);
+
+    if (rateLevel != SENSOR_DIRECT_RATE_STOP) {
+        // Fast path for clients toggling back to the rate that is already configured:
+        // the channel state would not change, so return the existing report token
+        // without a blocking round trip to the device.
+        auto activated = mActivated.find(handle);
+        auto token = mConfiguredReportTokens.find(handle);
+        if (activated != mActivated.end() && activated->second == rateLevel &&
+            token != mConfiguredReportTokens.end()) {
+            if (mService->isSensorInCappedSet(s.getType())) {
+                if ((requestedRateLevel <= SENSOR_SERVICE_CAPPED_SAMPLING_RATE_LEVEL) ||
+                    !isRateCappedBasedOnPermission()) {
+                    mMicRateBackup[handle] = requestedRateLevel;
+                } else {
+                    mMicRateBackup[handle] = SENSOR_SERVICE_CAPPED_SAMPLING_RATE_LEVEL;
+                }
+            }
+            return token->second;
+        }
+    }
+
     int ret = configure(handle, &config);
 
     if (rateLevel == SENSOR_DIRECT_RATE_STOP) {
         if (ret == NO_ERROR) {
             mActivated.erase(handle);
             mMicRateBackup.erase(handle);
+            mConfiguredReportTokens.erase(handle);
         } else if (ret > 0) {
             ret = UNKNOWN_ERROR;
         }
     } else {
         if (ret > 0) {
             mActivated[handle] = rateLevel;
+            mConfiguredReportTokens[handle] = ret;
             if (mService->isSensorInCappedSet(s.getType())) {
                 // Back up the rates that the app is allowed to have if the mic toggle is off
                 // This is used in the uncapRates() function.
@@ -250,6 +273,7 @@ void SensorService::SensorDirectConnection::capRates() {
                 mMicRateBackup[handle] = rateLevel;
                 // Modify the rate kept by the existing map
                 existingConnections[handle] = SENSOR_SERVICE_CAPPED_SAMPLING_RATE_LEVEL;
+                mConfiguredReportTokens.erase(handle);
                 // Only reconfigure the channel if it's ongoing
                 if (!temporarilyStopped) {
                     // Stopping before reconfiguring is the well-tested path in CTS
@@ -282,6 +306,7 @@ void SensorService::SensorDirectConnection::uncapRates() {
 
         // Modify the rate kept by the existing map
         existingConnections[handle] = rateLevel;
+        mConfiguredReportTokens.erase(handle);
 
         // Only reconfigure the channel if it's ongoing
         if (!temporarilyStopped) {
@@ -321,6 +346,7 @@ void SensorService::SensorDirectConnection::stopAllLocked(bool backupRecord) {
         mActivatedBackup = mActivated;
     }
     mActivated.clear();
+    mConfiguredReportTokens.clear();
 }
 
 void SensorService::SensorDirectConnection::recoverAll() {
@@ -111,6 +111,11 @@ private:
     std::unordered_map<int, int> mActivated;
     std::unordered_map<int, int> mActivatedBackup;
     std::unordered_map<int, int> mMicRateBackup;
+    // Report tokens returned by the device for the rate currently configured for each
+    // sensor, so that a request repeating the active rate can be answered without a
+    // blocking round trip to the device. Entries are dropped whenever the channel is
+    // reconfigured outside of configureChannel().
+    std::unordered_map<int, int> mConfiguredReportTokens;
 
     mutable Mutex mDestroyLock;
     bool mDestroyed;
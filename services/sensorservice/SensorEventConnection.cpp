@@ -289,14 +289,22 @@ bool SensorService::SensorEventConnection::incrementPendingFlushCountIfHasAccess
 status_t SensorService::SensorEventConnection::sendEvents(
         sensors_event_t const* buffer, size_t numEvents,
         sensors_event_t* scratch,
-        wp<const SensorEventConnection> const * mapFlushEventsToConnections) {
+        wp<const SensorEventConnection> const * mapFlushEventsToConnections,
+        const EventBatchSummary* batchSummary) {
     // filter out events not for this connection
 
     std::unique_ptr<sensors_event_t[]> sanitizedBuffer;
 
     int count = 0;
     Mutex::Autolock _l(mConnectionLock);
-    if (scratch) {
+    if (scratch && batchSummary != nullptr && canSendBatchUnfilteredLocked(*batchSummary)) {
+        // Common case for high rate streams: every event in the buffer belongs to this
+        // connection and passes filtering unchanged, so deliver straight from the shared poll
+        // buffer instead of copying each event through the scratch buffer first. Nothing below
+        // mutates the events because the batch contains no wake-up events.
+        scratch = const_cast<sensors_event_t *>(buffer);
+        count = numEvents;
+    } else if (scratch) {
         size_t i=0;
         while (i<numEvents) {
             int32_t sensor_handle = buffer[i].sensor;
@@ -444,6 +452,29 @@ bool SensorService::SensorEventConnection::hasSensorAccess() {
         && !mService->mSensorPrivacyPolicy->isSensorPrivacyEnabled();
 }
 
+bool SensorService::SensorEventConnection::canSendBatchUnfilteredLocked(
+        const EventBatchSummary& batchSummary) {
+    // The filtering loop in sendEvents only drops or rewrites events to route flush complete
+    // events, to honor pending first flushes, and to enforce app ops and sensor access; when
+    // none of those apply to any sensor in the batch, every event passes through unchanged.
+    // Batches with wake-up events are excluded because the needs-ack flag must not be set on
+    // the shared poll buffer.
+    if (batchSummary.hasMetaDataEvents || batchSummary.hasWakeUpEvents || !hasSensorAccess()) {
+        return false;
+    }
+    for (size_t i = 0; i < batchSummary.sensorHandles.size(); i++) {
+        const int32_t handle = batchSummary.sensorHandles[i];
+        const auto iter = mSensorInfo.find(handle);
+        if (iter == mSensorInfo.end() || iter->second.mFirstFlushPending) {
+            return false;
+        }
+        if (mHandleToAppOp.find(handle) != mHandleToAppOp.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool SensorService::SensorEventConnection::noteOpIfRequired(const sensors_event_t& event) {
     bool success = true;
     const auto iter = mHandleToAppOp.find(event.sensor);
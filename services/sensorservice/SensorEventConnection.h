@@ -55,7 +55,8 @@ public:
                           const String16& attributionTag);
 
     status_t sendEvents(sensors_event_t const* buffer, size_t count, sensors_event_t* scratch,
-                        wp<const SensorEventConnection> const * mapFlushEventsToConnections = nullptr);
+                        wp<const SensorEventConnection> const * mapFlushEventsToConnections = nullptr,
+                        const EventBatchSummary* batchSummary = nullptr);
     bool hasSensor(int32_t handle) const;
     bool hasAnySensor() const;
     bool hasOneShotSensors() const;
@@ -140,6 +141,11 @@ private:
     // privacy not being enabled.
     bool hasSensorAccess();
 
+    // Returns whether every event in a batch described by the given summary would pass the
+    // per-event filtering in sendEvents unchanged, in which case the batch can be sent straight
+    // from the shared poll buffer without copying through the scratch buffer.
+    bool canSendBatchUnfilteredLocked(const EventBatchSummary& batchSummary);
+
     // Call noteOp for the sensor if the sensor requires a permission
     bool noteOpIfRequired(const sensors_event_t& event);
     // Limits all active connections when the mic toggle is flipped to on.
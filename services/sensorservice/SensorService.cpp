@@ -1063,12 +1063,31 @@ void SensorService::cleanupAutoDisabledSensorLocked(const sp<SensorEventConnecti
 void SensorService::sendEventsToAllClients(
     const std::vector<sp<SensorEventConnection>>& activeConnections,
     ssize_t count) {
+   // Summarize the batch once so that each connection can recognize the common case where
+   // every event in the buffer is destined for it unchanged, without rescanning the buffer.
+   EventBatchSummary batchSummary;
+   for (ssize_t i = 0; i < count; i++) {
+       const sensors_event_t& event = mSensorEventBuffer[i];
+       if (event.type == SENSOR_TYPE_META_DATA) {
+           batchSummary.hasMetaDataEvents = true;
+           batchSummary.sensorHandles.add(event.meta_data.sensor);
+       } else {
+           batchSummary.sensorHandles.add(event.sensor);
+       }
+   }
+   for (size_t i = 0; i < batchSummary.sensorHandles.size() && !batchSummary.hasWakeUpEvents;
+        i++) {
+       std::shared_ptr<SensorInterface> si =
+               getSensorInterfaceFromHandle(batchSummary.sensorHandles[i]);
+       batchSummary.hasWakeUpEvents = si != nullptr && si->getSensor().isWakeUpSensor();
+   }
+
    // Send our events to clients. Check the state of wake lock for each client
    // and release the lock if none of the clients need it.
    bool needsWakeLock = false;
    for (const sp<SensorEventConnection>& connection : activeConnections) {
        connection->sendEvents(mSensorEventBuffer, count, mSensorEventScratch,
-                              mMapFlushEventsToConnections);
+                              mMapFlushEventsToConnections, &batchSummary);
        needsWakeLock |= connection->needsWakeLock();
        // If the connection has one-shot sensors, it may be cleaned up after
        // first trigger. Early check for one-shot sensors.
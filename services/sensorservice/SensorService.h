@@ -458,6 +458,15 @@ private:
     // Send events from the event cache for this particular connection.
     void sendEventsFromCache(const sp<SensorEventConnection>& connection);
 
+    // Facts about one poll buffer that hold for every connection. Computed once per batch in
+    // sendEventsToAllClients so that connections which receive the whole batch unchanged can
+    // skip the per-event filtering copy and send straight from the shared buffer.
+    struct EventBatchSummary {
+        SortedVector<int32_t> sensorHandles;
+        bool hasMetaDataEvents = false;
+        bool hasWakeUpEvents = false;
+    };
+
     // Send all events in the buffer to all clients.
     void sendEventsToAllClients(
         const std::vector<sp<SensorEventConnection>>& activeConnections,
@@ -41,55 +41,64 @@ void set_thread_priority(bool highPriority) {
 } // anonymous namespace
 
 BackgroundExecutor::BackgroundExecutor(bool highPriority) {
-    // mSemaphore must be initialized before any calls to
-    // BackgroundExecutor::sendCallbacks. For this reason, we initialize it
-    // within the constructor instead of within mThread.
-    LOG_ALWAYS_FATAL_IF(sem_init(&mSemaphore, 0, 0), "sem_init failed");
-    mThread = std::thread([&, highPriority]() {
-        set_thread_priority(highPriority);
-        while (!mDone) {
-            LOG_ALWAYS_FATAL_IF(sem_wait(&mSemaphore), "sem_wait failed (%d)", errno);
-            auto callbacks = mCallbacksQueue.pop();
-            if (!callbacks) {
-                continue;
+    for (size_t i = 0; i < kNumWorkers; i++) {
+        Worker& worker = mWorkers[i];
+        // The semaphores must be initialized before any calls to
+        // BackgroundExecutor::sendCallbacks. For this reason, we initialize
+        // them within the constructor instead of within the worker threads.
+        LOG_ALWAYS_FATAL_IF(sem_init(&worker.semaphore, 0, 0), "sem_init failed");
+        worker.thread = std::thread([&worker, this, highPriority]() {
+            set_thread_priority(highPriority);
+            while (!mDone) {
+                LOG_ALWAYS_FATAL_IF(sem_wait(&worker.semaphore), "sem_wait failed (%d)", errno);
+                auto callbacks = worker.callbacksQueue.pop();
+                if (!callbacks) {
+                    continue;
+                }
+                for (auto& callback : *callbacks) {
+                    callback();
+                }
             }
-            for (auto& callback : *callbacks) {
-                callback();
-            }
-        }
-    });
-    if (highPriority) {
-        pthread_setname_np(mThread.native_handle(), "BckgrndExec HP");
-    } else {
-        pthread_setname_np(mThread.native_handle(), "BckgrndExec LP");
+        });
+        char name[16];
+        snprintf(name, sizeof(name), "BckgrndExec %s%zu", highPriority ? "HP" : "LP", i);
+        pthread_setname_np(worker.thread.native_handle(), name);
     }
 }
 
 BackgroundExecutor::~BackgroundExecutor() {
     mDone = true;
-    LOG_ALWAYS_FATAL_IF(sem_post(&mSemaphore), "sem_post failed");
-    if (mThread.joinable()) {
-        mThread.join();
-        LOG_ALWAYS_FATAL_IF(sem_destroy(&mSemaphore), "sem_destroy failed");
+    for (Worker& worker : mWorkers) {
+        LOG_ALWAYS_FATAL_IF(sem_post(&worker.semaphore), "sem_post failed");
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+            LOG_ALWAYS_FATAL_IF(sem_destroy(&worker.semaphore), "sem_destroy failed");
+        }
     }
 }
 
-void BackgroundExecutor::sendCallbacks(Callbacks&& tasks) {
-    mCallbacksQueue.push(std::move(tasks));
-    LOG_ALWAYS_FATAL_IF(sem_post(&mSemaphore), "sem_post failed");
+void BackgroundExecutor::sendCallbacks(Callbacks&& tasks, Affinity affinity) {
+    Worker& worker = mWorkers[static_cast<size_t>(affinity) % kNumWorkers];
+    worker.callbacksQueue.push(std::move(tasks));
+    LOG_ALWAYS_FATAL_IF(sem_post(&worker.semaphore), "sem_post failed");
 }
 
 void BackgroundExecutor::flushQueue() {
     std::mutex mutex;
     std::condition_variable cv;
-    bool flushComplete = false;
-    sendCallbacks({[&]() {
-        std::scoped_lock lock{mutex};
-        flushComplete = true;
-        cv.notify_one();
-    }});
+    size_t pendingFlushes = kNumWorkers;
+    for (size_t i = 0; i < kNumWorkers; i++) {
+        Callbacks fence{[&]() {
+            std::scoped_lock lock{mutex};
+            pendingFlushes--;
+            cv.notify_one();
+        }};
+        Worker& worker = mWorkers[i];
+        worker.callbacksQueue.push(std::move(fence));
+        LOG_ALWAYS_FATAL_IF(sem_post(&worker.semaphore), "sem_post failed");
+    }
     std::unique_lock<std::mutex> lock{mutex};
-    cv.wait(lock, [&]() { return flushComplete; });
+    cv.wait(lock, [&]() { return pendingFlushes == 0; });
 }
 
 } // namespace android
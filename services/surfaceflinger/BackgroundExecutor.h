@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <ftl/small_vector.h>
 #include <semaphore.h>
 #include <thread>
@@ -24,7 +25,7 @@
 
 namespace android {
 
-// Executes tasks off the main thread.
+// Executes tasks off the main thread on a small pool of worker threads.
 class BackgroundExecutor {
 public:
     ~BackgroundExecutor();
@@ -39,20 +40,35 @@ public:
         return instance;
     }
 
+    // Tasks in the same affinity class retain FIFO ordering with respect to
+    // each other by always running on the same worker thread, while tasks in
+    // different classes may overlap. Independent subsystems should use
+    // distinct classes so a backlog in one does not delay the others.
+    enum class Affinity : size_t {
+        Default,
+        TransactionCallbacks,
+        WindowInfos,
+    };
+
     using Callbacks = ftl::SmallVector<std::function<void()>, 10>;
     // Queues callbacks onto a work queue to be executed by a background thread.
     // This is safe to call from multiple threads.
-    void sendCallbacks(Callbacks&& tasks);
+    void sendCallbacks(Callbacks&& tasks, Affinity affinity = Affinity::Default);
+    // Blocks until every task queued on every worker before this call has run.
     void flushQueue();
 
 private:
     BackgroundExecutor(bool highPriority);
 
-    sem_t mSemaphore;
-    std::atomic_bool mDone = false;
+    static constexpr size_t kNumWorkers = 2;
 
-    LocklessQueue<Callbacks> mCallbacksQueue;
-    std::thread mThread;
+    struct Worker {
+        sem_t semaphore;
+        LocklessQueue<Callbacks> callbacksQueue;
+        std::thread thread;
+    };
+    std::array<Worker, kNumWorkers> mWorkers;
+    std::atomic_bool mDone = false;
 };
 
 } // namespace android
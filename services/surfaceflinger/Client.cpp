@@ -22,6 +22,7 @@
 #include <private/android_filesystem_config.h>
 
 #include <gui/AidlUtil.h>
+#include <gui/LayerStatePermissions.h>
 #include <gui/SchedulingPolicy.h>
 
 #include "Client.h"
@@ -41,8 +42,18 @@ const String16 sAccessSurfaceFlinger("android.permission.ACCESS_SURFACE_FLINGER"
 // ---------------------------------------------------------------------------
 
 Client::Client(const sp<SurfaceFlinger>& flinger)
-    : mFlinger(flinger)
-{
+      : mFlinger(flinger),
+        mOwnerPid(IPCThreadState::self()->getCallingPid()),
+        mOwnerUid(IPCThreadState::self()->getCallingUid()),
+        // Evaluating the permissions here also warms the per-process cache, so that
+        // applying this client's transactions never pays for a permission lookup.
+        mTransactionPermissions(
+                LayerStatePermissions::getTransactionPermissions(mOwnerPid, mOwnerUid)) {}
+
+Client::~Client() {
+    // Our pid may be recycled once the connection is gone; push the cached
+    // permission evaluation out with it.
+    LayerStatePermissions::invalidateCache(mOwnerPid, mOwnerUid);
 }
 
 status_t Client::initCheck() const {
@@ -34,10 +34,14 @@ class SurfaceFlinger;
 class Client : public gui::BnSurfaceComposerClient {
 public:
     explicit Client(const sp<SurfaceFlinger>& flinger);
-    ~Client() = default;
+    ~Client();
 
     status_t initCheck() const;
 
+    // The layer_state_t::Permission bits of the process that opened this connection,
+    // evaluated once at connection time.
+    uint32_t getTransactionPermissions() const { return mTransactionPermissions; }
+
 private:
     // ISurfaceComposerClient interface
 
@@ -59,6 +63,9 @@ private:
 
     // constant
     sp<SurfaceFlinger> mFlinger;
+    const pid_t mOwnerPid;
+    const uid_t mOwnerUid;
+    const uint32_t mTransactionPermissions;
 
     // thread-safe
     mutable Mutex mLock;
@@ -20,6 +20,7 @@
 #define ATRACE_TAG ATRACE_TAG_GRAPHICS
 
 #include <cinttypes>
+#include <optional>
 
 #include <android-base/stringprintf.h>
 #include <common/trace.h>
@@ -46,15 +47,17 @@ bool ClientCache::getBuffer(const client_cache_t& cacheId,
         return false;
     }
 
-    auto& processBuffers = it->second.second;
+    auto& processCache = it->second;
 
-    auto bufItr = processBuffers.find(id);
-    if (bufItr == processBuffers.end()) {
+    auto bufItr = processCache.buffers.find(id);
+    if (bufItr == processCache.buffers.end()) {
         ALOGE_AND_TRACE("ClientCache::getBuffer - invalid buffer id");
         return false;
     }
 
     ClientCacheBuffer& buf = bufItr->second;
+    // A lookup makes the entry the most recently used one.
+    processCache.lru.splice(processCache.lru.begin(), processCache.lru, buf.lruIt);
     *outClientCacheBuffer = &buf;
     return true;
 }
@@ -72,50 +75,89 @@ ClientCache::add(const client_cache_t& cacheId, const sp<GraphicBuffer>& buffer)
         return base::unexpected(AddError::Unspecified);
     }
 
-    std::lock_guard lock(mMutex);
-    sp<IBinder> token;
+    std::vector<sp<ErasedRecipient>> pendingErase;
+    std::optional<client_cache_t> evictedId;
+    std::shared_ptr<renderengine::ExternalTexture> texture;
+    {
+        std::lock_guard lock(mMutex);
+        sp<IBinder> token;
+
+        // If this is a new process token, set a death recipient. If the client process dies, we
+        // will get a callback through binderDied.
+        auto it = mBuffers.find(processToken);
+        if (it == mBuffers.end()) {
+            token = processToken.promote();
+            if (!token) {
+                ALOGE_AND_TRACE("ClientCache::add - invalid token");
+                return base::unexpected(AddError::Unspecified);
+            }
 
-    // If this is a new process token, set a death recipient. If the client process dies, we will
-    // get a callback through binderDied.
-    auto it = mBuffers.find(processToken);
-    if (it == mBuffers.end()) {
-        token = processToken.promote();
-        if (!token) {
-            ALOGE_AND_TRACE("ClientCache::add - invalid token");
-            return base::unexpected(AddError::Unspecified);
+            // Only call linkToDeath if not a local binder
+            if (token->localBinder() == nullptr) {
+                status_t err = token->linkToDeath(mDeathRecipient);
+                if (err != NO_ERROR) {
+                    ALOGE_AND_TRACE("ClientCache::add - could not link to death");
+                    return base::unexpected(AddError::Unspecified);
+                }
+            }
+            auto [itr, success] = mBuffers.emplace(processToken, ProcessCache{token, {}, {}});
+            LOG_ALWAYS_FATAL_IF(!success, "failed to insert new process into client cache");
+            it = itr;
         }
 
-        // Only call linkToDeath if not a local binder
-        if (token->localBinder() == nullptr) {
-            status_t err = token->linkToDeath(mDeathRecipient);
-            if (err != NO_ERROR) {
-                ALOGE_AND_TRACE("ClientCache::add - could not link to death");
-                return base::unexpected(AddError::Unspecified);
+        auto& processCache = it->second;
+
+        if (processCache.buffers.size() > BUFFER_CACHE_MAX_SIZE) {
+            // Evict the least recently used entry that is no longer referenced outside the
+            // cache. Entries still held elsewhere (e.g. latched by a layer snapshot) are
+            // pinned, since dropping them would release a buffer that is in active use.
+            for (auto lruIt = processCache.lru.rbegin(); lruIt != processCache.lru.rend();
+                 ++lruIt) {
+                auto bufIt = processCache.buffers.find(*lruIt);
+                LOG_ALWAYS_FATAL_IF(bufIt == processCache.buffers.end(),
+                                    "stale id in client cache lru list");
+                if (bufIt->second.buffer.use_count() > 1) {
+                    continue;
+                }
+                evictedId = {processToken, bufIt->first};
+                for (auto& recipient : bufIt->second.recipients) {
+                    if (sp<ErasedRecipient> erasedRecipient = recipient.promote()) {
+                        pendingErase.push_back(erasedRecipient);
+                    }
+                }
+                processCache.lru.erase(std::next(lruIt).base());
+                processCache.buffers.erase(bufIt);
+                break;
+            }
+            if (!evictedId) {
+                ALOGE_AND_TRACE("ClientCache::add - cache is full");
+                return base::unexpected(AddError::CacheFull);
             }
         }
-        auto [itr, success] =
-                mBuffers.emplace(processToken,
-                                 std::make_pair(token,
-                                                std::unordered_map<uint64_t, ClientCacheBuffer>()));
-        LOG_ALWAYS_FATAL_IF(!success, "failed to insert new process into client cache");
-        it = itr;
-    }
 
-    auto& processBuffers = it->second.second;
-
-    if (processBuffers.size() > BUFFER_CACHE_MAX_SIZE) {
-        ALOGE_AND_TRACE("ClientCache::add - cache is full");
-        return base::unexpected(AddError::CacheFull);
+        LOG_ALWAYS_FATAL_IF(mRenderEngine == nullptr,
+                            "Attempted to build the ClientCache before a RenderEngine instance "
+                            "was ready!");
+
+        auto bufIt = processCache.buffers.find(id);
+        if (bufIt == processCache.buffers.end()) {
+            processCache.lru.push_front(id);
+            bufIt = processCache.buffers.emplace(id, ClientCacheBuffer{}).first;
+            bufIt->second.lruIt = processCache.lru.begin();
+        } else {
+            processCache.lru.splice(processCache.lru.begin(), processCache.lru,
+                                    bufIt->second.lruIt);
+        }
+        texture = bufIt->second.buffer = std::make_shared<
+                renderengine::impl::ExternalTexture>(buffer, *mRenderEngine,
+                                                     renderengine::impl::ExternalTexture::Usage::
+                                                             READABLE);
     }
 
-    LOG_ALWAYS_FATAL_IF(mRenderEngine == nullptr,
-                        "Attempted to build the ClientCache before a RenderEngine instance was "
-                        "ready!");
-
-    return (processBuffers[id].buffer = std::make_shared<
-                    renderengine::impl::ExternalTexture>(buffer, *mRenderEngine,
-                                                         renderengine::impl::ExternalTexture::
-                                                                 Usage::READABLE));
+    for (auto& recipient : pendingErase) {
+        recipient->bufferErased(*evictedId);
+    }
+    return texture;
 }
 
 sp<GraphicBuffer> ClientCache::erase(const client_cache_t& cacheId) {
@@ -139,7 +181,9 @@ sp<GraphicBuffer> ClientCache::erase(const client_cache_t& cacheId) {
             }
         }
 
-        mBuffers[processToken].second.erase(id);
+        auto& processCache = mBuffers[processToken];
+        processCache.lru.erase(buf->lruIt);
+        processCache.buffers.erase(id);
     }
 
     for (auto& recipient : pendingErase) {
@@ -200,7 +244,7 @@ void ClientCache::removeProcess(const wp<IBinder>& processToken) {
             return;
         }
 
-        for (auto& [id, clientCacheBuffer] : itr->second.second) {
+        for (auto& [id, clientCacheBuffer] : itr->second.buffers) {
             client_cache_t cacheId = {processToken, id};
             for (auto& recipient : clientCacheBuffer.recipients) {
                 sp<ErasedRecipient> erasedRecipient = recipient.promote();
@@ -224,12 +268,14 @@ void ClientCache::CacheDeathRecipient::binderDied(const wp<IBinder>& who) {
 void ClientCache::dump(std::string& result) {
     std::lock_guard lock(mMutex);
     for (const auto& [_, cache] : mBuffers) {
-        base::StringAppendF(&result, " Cache owner: %p\n", cache.first.get());
+        base::StringAppendF(&result, " Cache owner: %p, entries: %zu\n", cache.process.get(),
+                            cache.buffers.size());
 
-        for (const auto& [id, entry] : cache.second) {
+        for (const auto& [id, entry] : cache.buffers) {
             const auto& buffer = entry.buffer->getBuffer();
-            base::StringAppendF(&result, "\tID: %" PRIu64 ", size: %ux%u\n", id, buffer->getWidth(),
-                                buffer->getHeight());
+            base::StringAppendF(&result, "\tID: %" PRIu64 ", size: %ux%u%s\n", id,
+                                buffer->getWidth(), buffer->getHeight(),
+                                entry.buffer.use_count() > 1 ? ", pinned" : "");
         }
     }
 }
@@ -24,13 +24,14 @@
 #include <utils/RefBase.h>
 #include <utils/Singleton.h>
 
+#include <list>
 #include <map>
 #include <mutex>
 #include <set>
 #include <unordered_map>
 
 // 4096 is based on 64 buffers * 64 layers. Once this limit is reached, the least recently used
-// buffer is uncached before the new buffer is cached.
+// buffer that is not referenced outside the cache is evicted before the new buffer is cached.
 #define BUFFER_CACHE_MAX_SIZE 4096
 
 namespace android {
@@ -83,11 +84,19 @@ private:
     struct ClientCacheBuffer {
         std::shared_ptr<renderengine::ExternalTexture> buffer;
         std::set<wp<ErasedRecipient>> recipients;
+        // Position in ProcessCache::lru, so a cache hit can refresh recency in O(1).
+        std::list<uint64_t>::iterator lruIt;
     };
-    std::map<wp<IBinder> /*caching process*/,
-             std::pair<sp<IBinder> /*strong ref to caching process*/,
-                       std::unordered_map<uint64_t /*cache id*/, ClientCacheBuffer>>>
-            mBuffers GUARDED_BY(mMutex);
+    struct ProcessCache {
+        // Strong ref to the caching process so the token stays valid while cached.
+        sp<IBinder> process;
+        std::unordered_map<uint64_t /*cache id*/, ClientCacheBuffer> buffers;
+        // Cache ids ordered from most to least recently used. Entries whose
+        // textures are still referenced outside the cache (e.g. latched by a
+        // layer snapshot) are treated as pinned and never evicted.
+        std::list<uint64_t> lru;
+    };
+    std::map<wp<IBinder> /*caching process*/, ProcessCache> mBuffers GUARDED_BY(mMutex);
 
     class CacheDeathRecipient : public IBinder::DeathRecipient {
     public:
@@ -141,6 +141,28 @@ public:
 
     // Use internally to incrementally compute visibility/coverage
     struct CoverageState {
+        // Coarse spatial index over the output, tracking which cells are entirely inside
+        // aboveOpaqueLayers. A layer whose on-screen footprint only touches fully-opaque cells
+        // is provably invisible and can be rejected with bit tests instead of Region
+        // arithmetic, so visibility cost tracks the visible complexity rather than the total
+        // layer count.
+        struct OcclusionGrid {
+            // 8x8 cells, so the cell set fits in one word.
+            static constexpr int32_t kCells = 8;
+
+            // Resets the grid to cover `bounds` (layer stack space) with no opaque cells.
+            void initialize(const Rect& bounds);
+            // Marks the cells that lie entirely inside `rect` as opaque.
+            void addOpaqueRect(const Rect& rect);
+            // Returns true if `rect` only touches opaque cells, and so is fully occluded.
+            // Conservatively returns false for anything extending outside the grid bounds.
+            bool isOccluded(const Rect& rect) const;
+
+        private:
+            Rect mBounds = Rect::EMPTY_RECT;
+            uint64_t mOpaqueCells = 0;
+        };
+
         explicit CoverageState(LayerFESet& latchedLayers) : latchedLayers(latchedLayers) {}
 
         // The set of layers that had been latched for the coverage calls, to
@@ -153,6 +175,8 @@ public:
         Region aboveOpaqueLayers;
         // The region of the output which should be considered dirty
         Region dirtyRegion;
+        // Spatial index over aboveOpaqueLayers for cheap full-occlusion rejection
+        OcclusionGrid occlusionGrid;
         // The region of the output which is covered by layers, excluding display overlays. This
         // only has a value if there's something needing it, like when a TrustedPresentationListener
         // is set
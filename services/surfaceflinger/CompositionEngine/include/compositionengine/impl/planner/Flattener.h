@@ -93,6 +93,9 @@ public:
     static constexpr int kNumLayersFpsConsideration = 1;
     // Frames/Second threshold below which these CachedSets may be considered inactive.
     static constexpr float kFpsActiveThreshold = 1.f;
+    // If no cached set has been rendered for this long, the texture pool is trimmed so that an
+    // idle flattener does not pin screen-sized buffers.
+    static constexpr std::chrono::seconds kCachedSetIdleTimeout = 5s;
 
     Flattener(renderengine::RenderEngine& renderEngine, const Tunables& tunables);
 
@@ -243,6 +246,8 @@ private:
 
     NonBufferHash mCurrentGeometry;
     std::chrono::steady_clock::time_point mLastGeometryUpdate;
+    // When the last cached set was rendered, for deciding when to trim the texture pool.
+    std::optional<std::chrono::steady_clock::time_point> mLastCachedSetRender;
 
     std::vector<CachedSet> mLayers;
 
@@ -254,6 +259,13 @@ private:
     size_t mCachedSetCreationCount = 0;
     size_t mCachedSetCreationCost = 0;
     std::unordered_map<size_t, size_t> mInvalidatedCachedSetAges;
+    size_t mCachedSetRenderCount = 0;
+    size_t mCachedSetRenderDeferredCount = 0;
+
+    // Exponential moving average of measured cached set render durations. Once it has a
+    // sample, it replaces the fixed cachedSetRenderDuration estimate in deadline scheduling,
+    // so rendering defers based on what flattening actually costs on this device.
+    std::optional<std::chrono::nanoseconds> mMeasuredRenderDuration;
 };
 
 } // namespace compositionengine::impl::planner
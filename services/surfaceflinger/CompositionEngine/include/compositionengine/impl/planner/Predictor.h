@@ -269,6 +269,12 @@ private:
                                Plan result);
     bool findSimilarPrediction(const std::vector<const LayerState*>& layers, Plan result);
 
+    // Moves the prediction to the front of the recency list.
+    void touchPrediction(NonBufferHash);
+    // Drops the least recently used prediction, along with its entries in the similar and
+    // approximate stacks, so that prediction state and dump cost stay bounded.
+    void evictLeastRecentlyUsedPrediction();
+
     void dumpPredictionsByFrequency(std::string&) const;
 
     struct PromotionCandidate {
@@ -289,7 +295,10 @@ private:
         return std::find_if(mCandidates.cbegin(), mCandidates.cend(), candidateMatches);
     }
 
+    static constexpr const size_t MAX_PREDICTIONS = 128;
     std::unordered_map<NonBufferHash, Prediction> mPredictions;
+    // Prediction hashes ordered from most to least recently hit, for LRU eviction.
+    std::deque<NonBufferHash> mPredictionsByRecency;
     std::unordered_map<Plan, std::vector<NonBufferHash>> mSimilarStacks;
 
     struct ApproximateStack {
@@ -309,6 +318,7 @@ private:
     mutable size_t mExactHitCount = 0;
     mutable size_t mApproximateHitCount = 0;
     mutable size_t mMissCount = 0;
+    size_t mEvictedPredictionCount = 0;
 };
 
 // Defining PrintTo helps with Google Tests.
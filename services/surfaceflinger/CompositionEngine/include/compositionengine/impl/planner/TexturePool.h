@@ -23,6 +23,9 @@
 
 #include <renderengine/ExternalTexture.h>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "android-base/macros.h"
 
 namespace android::compositionengine::impl::planner {
@@ -66,7 +69,7 @@ public:
     TexturePool(renderengine::RenderEngine& renderEngine)
           : mRenderEngine(renderEngine), mEnabled(false) {}
 
-    virtual ~TexturePool() = default;
+    virtual ~TexturePool();
 
     // Sets the display size for the texture pool.
     // This will trigger a reallocation for all remaining textures in the pool.
@@ -83,6 +86,16 @@ public:
     // be held by the pool. This is useful when the active display changes.
     void setEnabled(bool enable);
 
+    // Refills the pool up to the minimum size on the allocator thread. Called when the flattener
+    // decides that a cached set will need a render target soon, so that borrowTexture does not
+    // have to allocate on the composition path.
+    void preallocate();
+
+    // Frees every texture currently held by the pool while leaving it enabled, so that an idle
+    // flattener does not pin screen-sized buffers. The pool is refilled by a later preallocate
+    // call, or on demand by borrowTexture.
+    void trim();
+
     void dump(std::string& out) const;
 
 protected:
@@ -97,15 +110,30 @@ protected:
 
     std::deque<Entry> mPool;
 
+    // Guards the pool and its configuration, since the allocator thread deposits textures
+    // concurrently with the composition thread borrowing them. Protected so that tests can
+    // synchronize when inspecting the pool.
+    mutable std::mutex mMutex;
+
 private:
-    std::shared_ptr<renderengine::ExternalTexture> genTexture();
+    std::shared_ptr<renderengine::ExternalTexture> genTexture(ui::Size size);
     // Returns a previously borrowed texture to the pool.
     void returnTexture(std::shared_ptr<renderengine::ExternalTexture>&& texture,
                        const sp<Fence>& fence);
-    void allocatePool();
+    void allocatePoolLocked();
+    void allocatorLoop();
     renderengine::RenderEngine& mRenderEngine;
     ui::Size mSize;
     bool mEnabled;
+
+    std::condition_variable mCondition;
+    bool mAllocationRequested = false;
+    bool mShutdown = false;
+    // Bumped whenever the size, enabled state or pool contents are invalidated, so that an
+    // allocation that was in flight on the allocator thread is dropped instead of deposited.
+    uint64_t mGeneration = 0;
+    // Started lazily by the first preallocate call; joined in the destructor.
+    std::thread mAllocatorThread;
 };
 
 } // namespace android::compositionengine::impl::planner
@@ -77,6 +77,12 @@ static int forwardPerform(ANativeWindow* window, int operation, ...) {
             result = static_cast<NativeWindow*>(window)->disconnect(api);
             break;
         }
+        case NATIVE_WINDOW_SET_SURFACE_DAMAGE: {
+            const android_native_rect_t* rects = va_arg(args, const android_native_rect_t*);
+            size_t numRects = va_arg(args, size_t);
+            result = static_cast<NativeWindow*>(window)->setSurfaceDamage(rects, numRects);
+            break;
+        }
         default:
             LOG_ALWAYS_FATAL("Unexpected operation %d", operation);
             break;
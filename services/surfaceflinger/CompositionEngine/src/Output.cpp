@@ -36,6 +36,7 @@
 #include <scheduler/FrameTargeter.h>
 #include <scheduler/Time.h>
 
+#include <algorithm>
 #include <optional>
 #include <thread>
 
@@ -63,6 +64,64 @@ namespace android::compositionengine {
 
 Output::~Output() = default;
 
+void Output::CoverageState::OcclusionGrid::initialize(const Rect& bounds) {
+    mBounds = bounds;
+    mOpaqueCells = 0;
+}
+
+void Output::CoverageState::OcclusionGrid::addOpaqueRect(const Rect& rect) {
+    if (mBounds.isEmpty()) {
+        return;
+    }
+    const int32_t cellWidth = std::max(1, mBounds.getWidth() / kCells);
+    const int32_t cellHeight = std::max(1, mBounds.getHeight() / kCells);
+    for (int32_t cy = 0; cy < kCells; cy++) {
+        const int32_t top = mBounds.top + cy * cellHeight;
+        const int32_t bottom = (cy == kCells - 1) ? mBounds.bottom : top + cellHeight;
+        if (top < rect.top || bottom > rect.bottom) {
+            continue;
+        }
+        for (int32_t cx = 0; cx < kCells; cx++) {
+            const int32_t left = mBounds.left + cx * cellWidth;
+            const int32_t right = (cx == kCells - 1) ? mBounds.right : left + cellWidth;
+            if (left >= rect.left && right <= rect.right) {
+                mOpaqueCells |= 1ull << (cy * kCells + cx);
+            }
+        }
+    }
+}
+
+bool Output::CoverageState::OcclusionGrid::isOccluded(const Rect& rect) const {
+    if (mOpaqueCells == 0 || mBounds.isEmpty()) {
+        return false;
+    }
+    // Anything extending outside the indexed bounds might be visible there.
+    if (rect.left < mBounds.left || rect.top < mBounds.top || rect.right > mBounds.right ||
+        rect.bottom > mBounds.bottom) {
+        return false;
+    }
+    const int32_t cellWidth = std::max(1, mBounds.getWidth() / kCells);
+    const int32_t cellHeight = std::max(1, mBounds.getHeight() / kCells);
+    for (int32_t cy = 0; cy < kCells; cy++) {
+        const int32_t top = mBounds.top + cy * cellHeight;
+        const int32_t bottom = (cy == kCells - 1) ? mBounds.bottom : top + cellHeight;
+        if (bottom <= rect.top || top >= rect.bottom) {
+            continue;
+        }
+        for (int32_t cx = 0; cx < kCells; cx++) {
+            const int32_t left = mBounds.left + cx * cellWidth;
+            const int32_t right = (cx == kCells - 1) ? mBounds.right : left + cellWidth;
+            if (right <= rect.left || left >= rect.right) {
+                continue;
+            }
+            if (!(mOpaqueCells & (1ull << (cy * kCells + cx)))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 namespace impl {
 using CompositionStrategyPredictionState =
         OutputCompositionState::CompositionStrategyPredictionState;
@@ -476,6 +535,27 @@ ftl::Future<std::monostate> Output::present(
         prepareFrame();
     }
 
+    const bool flushEvenWhenDisabledEarly = !refreshArgs.bufferIdsToUncache.empty();
+    if (mOffloadPresent && getState().usesClientComposition) {
+        // This frame needs GPU fallback composition. Run the whole tail of the
+        // frame - debug flash, client composition, the HWC present and cached
+        // set rendering - on the async worker so that this display's GPU work
+        // does not serialize the other displays' presents on the main thread.
+        // The caller keeps refreshArgs alive until all present futures are
+        // waited on.
+        mOffloadPresent = false;
+        return ftl::Future<bool>(
+                       mHwComposerAsyncWorker->send([this, &refreshArgs, flushEvenWhenDisabledEarly,
+                                                     result = std::move(result)]() mutable {
+                           devOptRepaintFlash(refreshArgs);
+                           finishFrame(std::move(result));
+                           presentFrameAndReleaseLayers(flushEvenWhenDisabledEarly);
+                           renderCachedSets(refreshArgs);
+                           return true;
+                       }))
+                .then([](bool) { return std::monostate{}; });
+    }
+
     devOptRepaintFlash(refreshArgs);
     finishFrame(std::move(result));
     ftl::Future<std::monostate> future;
@@ -526,6 +606,7 @@ void Output::rebuildLayerStacks(const compositionengine::CompositionRefreshArgs&
     coverage.aboveCoveredLayersExcludingOverlays = refreshArgs.hasTrustedPresentationListener
             ? std::make_optional<Region>()
             : std::nullopt;
+    coverage.occlusionGrid.initialize(outputState.layerStackSpace.getContent());
     collectVisibleLayers(refreshArgs, coverage);
 
     // Compute the resulting coverage for this output, and store it for later
@@ -651,6 +732,16 @@ void Output::ensureOutputLayerIfVisible(sp<compositionengine::LayerFE>& layerFE,
         return;
     }
 
+    // Fully-occluded fast path: if the footprint only touches cells that are already entirely
+    // opaque, every Region operation below reduces to a no-op (aboveCoveredLayers already
+    // contains any occluding opaque footprint), so the layer can be rejected outright. The
+    // shortcut is skipped when the covered-region-excluding-overlays accumulator is in use,
+    // since occluded layers still contribute to that one.
+    if (CC_LIKELY(!computeAboveCoveredExcludingOverlays) &&
+        coverage.occlusionGrid.isOccluded(visibleRegion.getBounds())) {
+        return;
+    }
+
     // Remove the transparent area from the visible region
     if (!layerFEState->isOpaque) {
         if (tr.preserveRects()) {
@@ -760,6 +851,9 @@ void Output::ensureOutputLayerIfVisible(sp<compositionengine::LayerFE>& layerFE,
 
     // Update accumAboveOpaqueLayers for next (lower) layer
     coverage.aboveOpaqueLayers.orSelf(opaqueRegion);
+    for (const Rect& rect : opaqueRegion) {
+        coverage.occlusionGrid.addOpaqueRect(rect);
+    }
 
     // Compute the visible non-transparent region
     Region visibleNonTransparentRegion = visibleRegion.subtract(transparentRegion);
@@ -831,6 +925,13 @@ void Output::planComposition() {
         return;
     }
 
+    // Flattening can only merge two or more layers into a cached set, so planning is pure
+    // per-frame overhead while a single layer fills the output - the common fullscreen
+    // game/video case.
+    if (getOutputLayerCount() <= 1) {
+        return;
+    }
+
     SFTRACE_CALL();
     ALOGV(__FUNCTION__);
 
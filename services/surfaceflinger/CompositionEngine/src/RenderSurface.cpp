@@ -33,6 +33,9 @@
 #include <system/window.h>
 #include <ui/GraphicBuffer.h>
 #include <ui/Rect.h>
+#include <ui/Region.h>
+
+#include <vector>
 
 // TODO(b/129481165): remove the #pragma below and fix conversion issues
 #pragma clang diagnostic push
@@ -220,6 +223,33 @@ void RenderSurface::queueBuffer(base::unique_fd readyFence, float hdrSdrRatio) {
         if (mTexture == nullptr) {
             ALOGE("No buffer is ready for display [%s]", mDisplay.getName().c_str());
         } else {
+            // Propagate this frame's damage through the buffer queue, so the consumer
+            // (HWC via FramebufferSurface) can restrict its work to the pixels that
+            // actually changed. The dirty region is tracked in layer stack space;
+            // the window expects buffer-space rects with a bottom-left origin (the
+            // GL convention), which Surface flips back to top-left when queueing.
+            const Region damage = state.transform.transform(
+                    state.dirtyRegion.intersect(state.layerStackSpace.getContent()));
+            const Rect bufferBounds = state.framebufferSpace.getBoundsAsRect();
+            if (!damage.isEmpty() && !(damage.isRect() && damage.getBounds() == bufferBounds)) {
+                const int32_t height = bufferBounds.getHeight();
+                size_t rectCount = 0;
+                const Rect* rects = damage.getArray(&rectCount);
+                std::vector<android_native_rect_t> flippedRects;
+                flippedRects.reserve(rectCount);
+                for (size_t i = 0; i < rectCount; ++i) {
+                    flippedRects.push_back({rects[i].left, height - rects[i].bottom,
+                                            rects[i].right, height - rects[i].top});
+                }
+                native_window_set_surface_damage(mNativeWindow.get(), flippedRects.data(),
+                                                 flippedRects.size());
+            } else {
+                // Empty or full-screen damage: restore the window's default of full
+                // damage, since an empty dirty region can still queue a buffer (e.g.
+                // when the client target must be flipped) whose content is all new.
+                native_window_set_surface_damage(mNativeWindow.get(), nullptr, 0);
+            }
+
             status_t result = mNativeWindow->queueBuffer(mNativeWindow.get(),
                                                          mTexture->getBuffer()->getNativeBuffer(),
                                                          dup(readyFence));
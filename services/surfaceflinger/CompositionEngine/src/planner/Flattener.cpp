@@ -115,6 +115,13 @@ void Flattener::renderCachedSets(
     SFTRACE_CALL();
 
     if (!mNewCachedSet) {
+        // Nothing to flatten. If nothing has been flattened for a while either, release the
+        // pooled render targets; buildCachedSets preallocates them again before the next render.
+        if (mLastCachedSetRender &&
+            std::chrono::steady_clock::now() - *mLastCachedSetRender > kCachedSetIdleTimeout) {
+            mTexturePool.trim();
+            mLastCachedSetRender.reset();
+        }
         return;
     }
 
@@ -130,13 +137,17 @@ void Flattener::renderCachedSets(
     // have enough time, then we skip rendering the cached set if we think that we'll steal too much
     // time from the next frame.
     if (renderDeadline && mTunables.mRenderScheduling) {
-        if (const auto estimatedRenderFinish =
-                    now + mTunables.mRenderScheduling->cachedSetRenderDuration;
+        // Prefer the measured duration of past renders over the configured estimate, so the
+        // decision reflects what flattening actually costs on this device.
+        const auto renderDuration = mMeasuredRenderDuration.value_or(
+                mTunables.mRenderScheduling->cachedSetRenderDuration);
+        if (const auto estimatedRenderFinish = now + renderDuration;
             estimatedRenderFinish > *renderDeadline) {
             mNewCachedSet->incrementSkipCount();
 
             if (mNewCachedSet->getSkipCount() <=
                 mTunables.mRenderScheduling->maxDeferRenderAttempts) {
+                ++mCachedSetRenderDeferredCount;
                 SFTRACE_FORMAT("DeadlinePassed: exceeded deadline by: %d us",
                                std::chrono::duration_cast<std::chrono::microseconds>(
                                        estimatedRenderFinish - *renderDeadline)
@@ -149,6 +160,14 @@ void Flattener::renderCachedSets(
     }
 
     mNewCachedSet->render(mRenderEngine, mTexturePool, outputState, deviceHandlesColorTransform);
+    mLastCachedSetRender = now;
+
+    ++mCachedSetRenderCount;
+    const auto renderDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - now);
+    mMeasuredRenderDuration = mMeasuredRenderDuration
+            ? (*mMeasuredRenderDuration * 3 + renderDuration) / 4
+            : renderDuration;
 }
 
 void Flattener::dumpLayers(std::string& result) const {
@@ -200,6 +219,13 @@ void Flattener::dump(std::string& result) const {
     base::StringAppendF(&result, "    Cost: %.2f\n",
                         static_cast<float>(mCachedSetCreationCost) / displayArea);
 
+    base::StringAppendF(&result, "    Cached sets rendered: %zd (%zd deferred past deadline)\n",
+                        mCachedSetRenderCount, mCachedSetRenderDeferredCount);
+    if (mMeasuredRenderDuration) {
+        base::StringAppendF(&result, "    Measured render duration: %.2f ms\n",
+                            static_cast<float>(mMeasuredRenderDuration->count()) / 1e6f);
+    }
+
     const auto lastUpdate =
             std::chrono::duration_cast<std::chrono::milliseconds>(now - mLastGeometryUpdate);
     base::StringAppendF(&result, "\n  Current hash %016zx, last update %sago\n\n", mCurrentGeometry,
@@ -546,6 +572,10 @@ void Flattener::buildCachedSets(time_point now) {
     ++mCachedSetCreationCount;
     mCachedSetCreationCost += mNewCachedSet->getCreationCost();
 
+    // The new cached set will be rendered in an upcoming frame, so warm the texture pool now
+    // instead of letting the render allocate on the composition path.
+    mTexturePool.preallocate();
+
     // note the compiler should strip the follow no-op statements when ALOGV is off
     const auto dumper = [&] {
         std::string setDump;
@@ -228,7 +228,9 @@ void Predictor::dump(std::string& result) const {
                         100.0f * hitCount / totalAttempts, hitCount, totalAttempts);
     base::StringAppendF(&result, "  Exact hits: %zd\n", mExactHitCount);
     base::StringAppendF(&result, "  Approximate hits: %zd\n", mApproximateHitCount);
-    base::StringAppendF(&result, "  Misses: %zd\n\n", mMissCount);
+    base::StringAppendF(&result, "  Misses: %zd\n", mMissCount);
+    base::StringAppendF(&result, "  Predictions cached: %zd/%zd (%zd evicted)\n\n",
+                        mPredictions.size(), MAX_PREDICTIONS, mEvictedPredictionCount);
 
     dumpPredictionsByFrequency(result);
 }
@@ -388,7 +390,52 @@ void Predictor::promoteIfCandidate(NonBufferHash predictionHash) {
 
     mSimilarStacks[candidateEntry->prediction.getPlan()].push_back(predictionHash);
     mPredictions.emplace(predictionHash, std::move(candidateEntry->prediction));
+    mPredictionsByRecency.push_front(predictionHash);
     mCandidates.erase(candidateEntry);
+
+    if (mPredictions.size() > MAX_PREDICTIONS) {
+        evictLeastRecentlyUsedPrediction();
+    }
+}
+
+void Predictor::touchPrediction(NonBufferHash hash) {
+    const auto recencyEntry =
+            std::find(mPredictionsByRecency.begin(), mPredictionsByRecency.end(), hash);
+    if (recencyEntry == mPredictionsByRecency.end() ||
+        recencyEntry == mPredictionsByRecency.begin()) {
+        return;
+    }
+
+    mPredictionsByRecency.erase(recencyEntry);
+    mPredictionsByRecency.push_front(hash);
+}
+
+void Predictor::evictLeastRecentlyUsedPrediction() {
+    const NonBufferHash hash = mPredictionsByRecency.back();
+    mPredictionsByRecency.pop_back();
+
+    ALOGV("[%s] Evicting %zx", __func__, hash);
+
+    const auto predictionEntry = mPredictions.find(hash);
+    if (const auto similarStacksEntry = mSimilarStacks.find(predictionEntry->second.getPlan());
+        similarStacksEntry != mSimilarStacks.end()) {
+        auto& similarStacks = similarStacksEntry->second;
+        similarStacks.erase(std::remove(similarStacks.begin(), similarStacks.end(), hash),
+                            similarStacks.end());
+        if (similarStacks.empty()) {
+            mSimilarStacks.erase(similarStacksEntry);
+        }
+    }
+
+    const auto stackMatchesHash = [hash](const ApproximateStack& stack) {
+        return stack.hash == hash;
+    };
+    mApproximateStacks.erase(std::remove_if(mApproximateStacks.begin(), mApproximateStacks.end(),
+                                            stackMatchesHash),
+                             mApproximateStacks.end());
+
+    mPredictions.erase(predictionEntry);
+    ++mEvictedPredictionCount;
 }
 
 void Predictor::recordPredictedResult(PredictedPlan predictedPlan,
@@ -417,6 +464,7 @@ void Predictor::recordPredictedResult(PredictedPlan predictedPlan,
     ALOGV("[%s] %s prediction hit", __func__, to_string(predictedPlan.type).c_str());
     ALOGV("[%s] Plan: %s", __func__, to_string(result).c_str());
     prediction.recordHit(predictedPlan.type);
+    touchPrediction(predictedPlan.hash);
 
     const auto stackMatchesHash = [hash = predictedPlan.hash](const ApproximateStack& stack) {
         return stack.hash == hash;
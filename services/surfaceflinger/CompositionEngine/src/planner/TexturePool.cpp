@@ -25,27 +25,45 @@
 
 namespace android::compositionengine::impl::planner {
 
-void TexturePool::allocatePool() {
+TexturePool::~TexturePool() {
+    {
+        std::lock_guard lock(mMutex);
+        mShutdown = true;
+    }
+    mCondition.notify_all();
+    if (mAllocatorThread.joinable()) {
+        mAllocatorThread.join();
+    }
+}
+
+void TexturePool::allocatePoolLocked() {
     mPool.clear();
     if (mEnabled && mSize.isValid()) {
         mPool.resize(kMinPoolSize);
         std::generate_n(mPool.begin(), kMinPoolSize, [&]() {
-            return Entry{genTexture(), nullptr};
+            return Entry{genTexture(mSize), nullptr};
         });
     }
 }
 
 void TexturePool::setDisplaySize(ui::Size size) {
+    std::lock_guard lock(mMutex);
     if (mSize == size) {
         return;
     }
     mSize = size;
-    allocatePool();
+    mGeneration++;
+    allocatePoolLocked();
 }
 
 std::shared_ptr<TexturePool::AutoTexture> TexturePool::borrowTexture() {
+    std::unique_lock lock(mMutex);
     if (mPool.empty()) {
-        return std::make_shared<AutoTexture>(*this, genTexture(), nullptr);
+        // Starved; allocate synchronously, but outside the lock so that a concurrent
+        // preallocation can still deposit textures for the next borrow.
+        const ui::Size size = mSize;
+        lock.unlock();
+        return std::make_shared<AutoTexture>(*this, genTexture(size), nullptr);
     }
 
     const auto entry = mPool.front();
@@ -53,8 +71,61 @@ std::shared_ptr<TexturePool::AutoTexture> TexturePool::borrowTexture() {
     return std::make_shared<AutoTexture>(*this, entry.texture, entry.fence);
 }
 
+void TexturePool::preallocate() {
+    {
+        std::lock_guard lock(mMutex);
+        if (!mEnabled || !mSize.isValid() || mPool.size() >= kMinPoolSize) {
+            return;
+        }
+        if (!mAllocatorThread.joinable()) {
+            mAllocatorThread = std::thread(&TexturePool::allocatorLoop, this);
+        }
+        mAllocationRequested = true;
+    }
+    mCondition.notify_one();
+}
+
+void TexturePool::trim() {
+    std::deque<Entry> dropped;
+    {
+        std::lock_guard lock(mMutex);
+        if (mPool.empty()) {
+            return;
+        }
+        mGeneration++;
+        dropped.swap(mPool);
+    }
+    // The textures in `dropped` are freed here, outside the lock.
+    ALOGV("Trimmed %zu textures from Planner's pool", dropped.size());
+}
+
+void TexturePool::allocatorLoop() {
+    std::unique_lock lock(mMutex);
+    while (true) {
+        mCondition.wait(lock, [&]() { return mShutdown || mAllocationRequested; });
+        if (mShutdown) {
+            return;
+        }
+        mAllocationRequested = false;
+        while (mEnabled && mSize.isValid() && mPool.size() < kMinPoolSize) {
+            const ui::Size size = mSize;
+            const uint64_t generation = mGeneration;
+            lock.unlock();
+            auto texture = genTexture(size);
+            lock.lock();
+            if (mGeneration != generation) {
+                // The pool was resized, disabled or trimmed while we were allocating; this
+                // texture no longer belongs in it.
+                break;
+            }
+            mPool.push_back({std::move(texture), nullptr});
+        }
+    }
+}
+
 void TexturePool::returnTexture(std::shared_ptr<renderengine::ExternalTexture>&& texture,
                                 const sp<Fence>& fence) {
+    std::lock_guard lock(mMutex);
     // Drop the texture on the floor if the pool is not enabled
     if (!mEnabled) {
         return;
@@ -80,13 +151,13 @@ void TexturePool::returnTexture(std::shared_ptr<renderengine::ExternalTexture>&&
     mPool.push_back({std::move(texture), fence});
 }
 
-std::shared_ptr<renderengine::ExternalTexture> TexturePool::genTexture() {
-    LOG_ALWAYS_FATAL_IF(!mSize.isValid(), "Attempted to generate texture with invalid size");
+std::shared_ptr<renderengine::ExternalTexture> TexturePool::genTexture(ui::Size size) {
+    LOG_ALWAYS_FATAL_IF(!size.isValid(), "Attempted to generate texture with invalid size");
     return std::make_shared<
             renderengine::impl::
                     ExternalTexture>(sp<GraphicBuffer>::
-                                             make(static_cast<uint32_t>(mSize.getWidth()),
-                                                  static_cast<uint32_t>(mSize.getHeight()),
+                                             make(static_cast<uint32_t>(size.getWidth()),
+                                                  static_cast<uint32_t>(size.getHeight()),
                                                   HAL_PIXEL_FORMAT_RGBA_8888, 1U,
                                                   static_cast<uint64_t>(
                                                           GraphicBuffer::USAGE_HW_RENDER |
@@ -99,11 +170,14 @@ std::shared_ptr<renderengine::ExternalTexture> TexturePool::genTexture() {
 }
 
 void TexturePool::setEnabled(bool enabled) {
+    std::lock_guard lock(mMutex);
     mEnabled = enabled;
-    allocatePool();
+    mGeneration++;
+    allocatePoolLocked();
 }
 
 void TexturePool::dump(std::string& out) const {
+    std::lock_guard lock(mMutex);
     base::StringAppendF(&out,
                         "TexturePool (%s) has %zu buffers of size [%" PRId32 ", %" PRId32 "]\n",
                         mEnabled ? "enabled" : "disabled", mPool.size(), mSize.width, mSize.height);
@@ -1265,6 +1265,39 @@ const ui::Transform OutputRebuildLayerStacksTest::kIdentityTransform{TR_IDENT, 1
 const ui::Transform OutputRebuildLayerStacksTest::kRotate90Transform{TR_ROT_90, 1920, 1080};
 const Rect OutputRebuildLayerStacksTest::kOutputBounds{0, 0, 1920, 1080};
 
+TEST(OutputCoverageOcclusionGridTest, rejectsOnlyFullyOccludedRects) {
+    Output::CoverageState::OcclusionGrid grid;
+    grid.initialize(Rect(0, 0, 1920, 1080));
+
+    // Nothing is occluded while no opaque coverage has been recorded.
+    EXPECT_FALSE(grid.isOccluded(Rect(0, 0, 100, 100)));
+
+    grid.addOpaqueRect(Rect(0, 0, 1920, 1080));
+    EXPECT_TRUE(grid.isOccluded(Rect(100, 100, 200, 200)));
+    EXPECT_TRUE(grid.isOccluded(Rect(0, 0, 1920, 1080)));
+
+    // Anything extending outside the indexed bounds is conservatively kept.
+    EXPECT_FALSE(grid.isOccluded(Rect(-10, 0, 100, 100)));
+    EXPECT_FALSE(grid.isOccluded(Rect(1000, 1000, 2000, 1090)));
+}
+
+TEST(OutputCoverageOcclusionGridTest, partialOpaqueCoverageIsConservative) {
+    Output::CoverageState::OcclusionGrid grid;
+    grid.initialize(Rect(0, 0, 1920, 1080));
+
+    // Cover the left half of the output.
+    grid.addOpaqueRect(Rect(0, 0, 960, 1080));
+    EXPECT_TRUE(grid.isOccluded(Rect(0, 0, 960, 1080)));
+    EXPECT_TRUE(grid.isOccluded(Rect(100, 100, 900, 900)));
+    EXPECT_FALSE(grid.isOccluded(Rect(900, 100, 1000, 900)));
+    EXPECT_FALSE(grid.isOccluded(Rect(1000, 100, 1900, 900)));
+
+    // A rect smaller than one cell never marks any cell as opaque.
+    grid.initialize(Rect(0, 0, 1920, 1080));
+    grid.addOpaqueRect(Rect(0, 0, 100, 100));
+    EXPECT_FALSE(grid.isOccluded(Rect(10, 10, 50, 50)));
+}
+
 TEST_F(OutputRebuildLayerStacksTest, doesNothingIfNotEnabled) {
     mOutput.mState.isEnabled = false;
 
@@ -281,6 +281,39 @@ TEST_F(RenderSurfaceTest, queueBufferHandlesClientComposition) {
     state.flipClientTarget = false;
 
     EXPECT_CALL(mDisplay, getState()).WillOnce(ReturnRef(state));
+    EXPECT_CALL(*mNativeWindow, setSurfaceDamage(nullptr, 0)).WillOnce(Return(NO_ERROR));
+    EXPECT_CALL(*mNativeWindow, queueBuffer(buffer->getBuffer()->getNativeBuffer(), -1))
+            .WillOnce(Return(NO_ERROR));
+    EXPECT_CALL(*mDisplaySurface, advanceFrame(0.5f)).Times(1);
+
+    mSurface.queueBuffer(base::unique_fd(), 0.5f);
+
+    EXPECT_EQ(nullptr, mSurface.mutableTextureForTest().get());
+}
+
+TEST_F(RenderSurfaceTest, queueBufferSetsPartialSurfaceDamage) {
+    const auto buffer =
+            std::make_shared<renderengine::impl::ExternalTexture>(sp<GraphicBuffer>::make(),
+                                                                  mRenderEngine, false);
+    mSurface.mutableTextureForTest() = buffer;
+
+    impl::OutputCompositionState state;
+    state.usesClientComposition = true;
+    state.layerStackSpace.setContent(Rect(0, 0, 100, 200));
+    state.framebufferSpace.setBounds(ui::Size(100, 200));
+    state.dirtyRegion = Region(Rect(10, 20, 30, 40));
+
+    EXPECT_CALL(mDisplay, getState()).WillOnce(ReturnRef(state));
+    // The damage rect is flipped to the bottom-left origin convention expected
+    // by the window, which flips it back when queueing.
+    EXPECT_CALL(*mNativeWindow, setSurfaceDamage(testing::NotNull(), 1))
+            .WillOnce([](const android_native_rect_t* rects, size_t) {
+                EXPECT_EQ(10, rects[0].left);
+                EXPECT_EQ(160, rects[0].top);
+                EXPECT_EQ(30, rects[0].right);
+                EXPECT_EQ(180, rects[0].bottom);
+                return NO_ERROR;
+            });
     EXPECT_CALL(*mNativeWindow, queueBuffer(buffer->getBuffer()->getNativeBuffer(), -1))
             .WillOnce(Return(NO_ERROR));
     EXPECT_CALL(*mDisplaySurface, advanceFrame(0.5f)).Times(1);
@@ -301,6 +334,7 @@ TEST_F(RenderSurfaceTest, queueBufferHandlesFlipClientTargetRequest) {
     state.flipClientTarget = true;
 
     EXPECT_CALL(mDisplay, getState()).WillOnce(ReturnRef(state));
+    EXPECT_CALL(*mNativeWindow, setSurfaceDamage(nullptr, 0)).WillOnce(Return(NO_ERROR));
     EXPECT_CALL(*mNativeWindow, queueBuffer(buffer->getBuffer()->getNativeBuffer(), -1))
             .WillOnce(Return(NO_ERROR));
     EXPECT_CALL(*mDisplaySurface, advanceFrame(0.5f)).Times(1);
@@ -321,6 +355,7 @@ TEST_F(RenderSurfaceTest, queueBufferHandlesFlipClientTargetRequestWithNoBufferY
     EXPECT_CALL(*mNativeWindow, dequeueBuffer(_, _))
             .WillOnce(
                     DoAll(SetArgPointee<0>(buffer.get()), SetArgPointee<1>(-1), Return(NO_ERROR)));
+    EXPECT_CALL(*mNativeWindow, setSurfaceDamage(nullptr, 0)).WillOnce(Return(NO_ERROR));
     EXPECT_CALL(*mNativeWindow, queueBuffer(buffer->getNativeBuffer(), -1))
             .WillOnce(Return(NO_ERROR));
     EXPECT_CALL(*mDisplaySurface, advanceFrame(0.5f)).Times(1);
@@ -340,6 +375,7 @@ TEST_F(RenderSurfaceTest, queueBufferHandlesNativeWindowQueueBufferFailureOnVirt
     state.usesClientComposition = true;
 
     EXPECT_CALL(mDisplay, getState()).WillOnce(ReturnRef(state));
+    EXPECT_CALL(*mNativeWindow, setSurfaceDamage(nullptr, 0)).WillOnce(Return(NO_ERROR));
     EXPECT_CALL(*mNativeWindow, queueBuffer(buffer->getBuffer()->getNativeBuffer(), -1))
             .WillOnce(Return(INVALID_OPERATION));
     EXPECT_CALL(mDisplay, isVirtual()).WillOnce(Return(true));
@@ -22,6 +22,9 @@
 #include <log/log.h>
 #include <renderengine/mock/RenderEngine.h>
 
+#include <chrono>
+#include <thread>
+
 namespace android::compositionengine::impl::planner {
 namespace {
 
@@ -34,7 +37,10 @@ public:
 
     size_t getMinPoolSize() const { return kMinPoolSize; }
     size_t getMaxPoolSize() const { return kMaxPoolSize; }
-    size_t getPoolSize() const { return mPool.size(); }
+    size_t getPoolSize() const {
+        std::lock_guard lock(mMutex);
+        return mPool.size();
+    }
 };
 
 struct TexturePoolTest : public testing::Test {
@@ -162,6 +168,33 @@ TEST_F(TexturePoolTest, doesNotHoldBuffersWhenDisabled) {
     EXPECT_EQ(mTexturePool.getPoolSize(), 0u);
 }
 
+TEST_F(TexturePoolTest, trimFreesBuffersAndPoolRecovers) {
+    EXPECT_EQ(mTexturePool.getPoolSize(), mTexturePool.getMinPoolSize());
+    mTexturePool.trim();
+    EXPECT_EQ(mTexturePool.getPoolSize(), 0u);
+
+    // Borrowing still works while the pool is trimmed, and returned textures repopulate it.
+    auto texture = mTexturePool.borrowTexture();
+    EXPECT_EQ(kDisplaySize.getWidth(),
+              static_cast<int32_t>(texture->get()->getBuffer()->getWidth()));
+    texture.reset();
+    EXPECT_EQ(mTexturePool.getPoolSize(), 1u);
+}
+
+TEST_F(TexturePoolTest, preallocateRefillsToMinPool) {
+    mTexturePool.trim();
+    EXPECT_EQ(mTexturePool.getPoolSize(), 0u);
+
+    mTexturePool.preallocate();
+    constexpr auto kTimeout = std::chrono::seconds(5);
+    const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    while (mTexturePool.getPoolSize() < mTexturePool.getMinPoolSize() &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(mTexturePool.getPoolSize(), mTexturePool.getMinPoolSize());
+}
+
 TEST_F(TexturePoolTest, reallocatesWhenReEnabled) {
     EXPECT_EQ(mTexturePool.getPoolSize(), mTexturePool.getMinPoolSize());
     mTexturePool.setEnabled(false);
@@ -22,6 +22,7 @@
 
 #include <SurfaceFlingerProperties.h>
 #include <android-base/file.h>
+#include <android-base/stringprintf.h>
 #include <android/binder_ibinder_platform.h>
 #include <android/binder_manager.h>
 #include <common/FlagManager.h>
@@ -338,10 +339,22 @@ std::string AidlComposer::dumpDebugInfo() {
     t.join();
     close(pipefds[0]);
 
+    std::string stats;
+    mMutex.lock_shared();
+    for (const auto& [display, writerStats] : mWriterStats) {
+        base::StringAppendF(&stats,
+                            "display %" PRId64 ": max %zu display commands, %zu layer commands\n",
+                            translate<int64_t>(display),
+                            writerStats->maxCommands.load(std::memory_order_relaxed),
+                            writerStats->maxLayerCommands.load(std::memory_order_relaxed));
+    }
+    mMutex.unlock_shared();
+
     std::string hash;
     mAidlComposer->getInterfaceHash(&hash);
     return std::string(mAidlComposer->descriptor) +
-            " version:" + std::to_string(mComposerInterfaceVersion) + " hash:" + hash + str;
+            " version:" + std::to_string(mComposerInterfaceVersion) + " hash:" + hash + str +
+            "\nCommand stream high-water marks:\n" + stats;
 }
 
 void AidlComposer::registerCallback(HWC2::ComposerCallback& callback) {
@@ -380,7 +393,9 @@ uint32_t AidlComposer::getMaxVirtualDisplayCount() {
 Error AidlComposer::createVirtualDisplay(uint32_t width, uint32_t height, PixelFormat* format,
                                          Display* outDisplay) {
     using AidlPixelFormat = aidl::android::hardware::graphics::common::PixelFormat;
-    const int32_t bufferSlotCount = 1;
+    // Request a full set of output buffer slots so the HAL can cache every sink
+    // buffer and we don't force a buffer import per frame.
+    const int32_t bufferSlotCount = BufferQueue::NUM_BUFFER_SLOTS;
     VirtualDisplay virtualDisplay;
     const auto status =
             mAidlComposerClient->createVirtualDisplay(static_cast<int32_t>(width),
@@ -768,12 +783,13 @@ Error AidlComposer::setColorTransform(Display display, const float* matrix) {
     return error;
 }
 
-Error AidlComposer::setOutputBuffer(Display display, const native_handle_t* buffer,
+Error AidlComposer::setOutputBuffer(Display display, uint32_t slot, const native_handle_t* buffer,
                                     int releaseFence) {
     auto error = Error::NONE;
     mMutex.lock_shared();
     if (auto writer = getWriter(display)) {
-        writer->get().setOutputBuffer(translate<int64_t>(display), 0, buffer, dup(releaseFence));
+        writer->get().setOutputBuffer(translate<int64_t>(display), slot, buffer,
+                                      dup(releaseFence));
     } else {
         error = Error::BAD_DISPLAY;
     }
@@ -1140,6 +1156,22 @@ Error AidlComposer::execute(Display display) {
         return Error::NONE;
     }
 
+    if (const auto statsOpt = mWriterStats.get(display)) {
+        WriterStats& stats = *statsOpt->get();
+        size_t layerCommands = 0;
+        for (const auto& command : commands) {
+            layerCommands += command.layers.size();
+        }
+        if (commands.size() > stats.maxCommands.load(std::memory_order_relaxed)) {
+            stats.maxCommands.store(commands.size(), std::memory_order_relaxed);
+        }
+        if (layerCommands > stats.maxLayerCommands.load(std::memory_order_relaxed)) {
+            stats.maxLayerCommands.store(layerCommands, std::memory_order_relaxed);
+            SFTRACE_FORMAT_INSTANT("display %" PRId64 ": %zu layer commands (new high-water mark)",
+                                   translate<int64_t>(display), layerCommands);
+        }
+    }
+
     { // scope for results
         std::vector<CommandResultPayload> results;
         auto status = mAidlComposerClient->executeCommands(commands, &results);
@@ -1652,6 +1684,7 @@ void AidlComposer::removeDisplay(Display display) {
     ALOGW_IF(!wasErased,
              "Attempting to remove writer for display %" PRId64 " which is not connected",
              translate<int64_t>(display));
+    mWriterStats.erase(display);
     if (!mSingleReader) {
         removeReader(display);
     }
@@ -1699,6 +1732,7 @@ void AidlComposer::addDisplay(Display display) {
     auto [it, added] = mWriters.try_emplace(display, displayId);
     ALOGW_IF(!added, "Attempting to add writer for display %" PRId64 " which is already connected",
              displayId);
+    mWriterStats.try_emplace(display, std::make_unique<WriterStats>());
     if (mSingleReader) {
         if (hasMultiThreadedPresentSupport(display)) {
             mSingleReader = false;
@@ -21,7 +21,9 @@
 #include <ftl/shared_mutex.h>
 #include <ui/DisplayMap.h>
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -128,7 +130,7 @@ public:
                           float hdrSdrRatio) override;
     Error setColorMode(Display display, ColorMode mode, RenderIntent renderIntent) override;
     Error setColorTransform(Display display, const float* matrix) override;
-    Error setOutputBuffer(Display display, const native_handle_t* buffer,
+    Error setOutputBuffer(Display display, uint32_t slot, const native_handle_t* buffer,
                           int releaseFence) override;
     Error setPowerMode(Display display, IComposerClient::PowerMode mode) override;
     Error setVsyncEnabled(Display display, IComposerClient::Vsync enabled) override;
@@ -290,6 +292,16 @@ private:
     ui::PhysicalDisplayMap<Display, ComposerClientWriter> mWriters GUARDED_BY(mMutex);
     ui::PhysicalDisplayMap<Display, ComposerClientReader> mReaders GUARDED_BY(mMutex);
 
+    // Per-display high-water marks of the command stream handed to the HAL,
+    // used to spot displays whose payloads keep regrowing frame over frame.
+    // Each entry is written only by its display's presenting thread in
+    // execute() and read from dumpDebugInfo(), hence the relaxed atomics.
+    struct WriterStats {
+        std::atomic<size_t> maxCommands = 0;
+        std::atomic<size_t> maxLayerCommands = 0;
+    };
+    ui::PhysicalDisplayMap<Display, std::unique_ptr<WriterStats>> mWriterStats GUARDED_BY(mMutex);
+
     // Protect access to mWriters and mReaders with a shared_mutex. Adding and
     // removing a display require exclusive access, since the iterator or the
     // writer/reader may be invalidated. Other calls need shared access while
@@ -140,7 +140,7 @@ status_t FramebufferSurface::advanceFrame(float hdrSdrRatio) {
         hwcBuffer = mCurrentBuffer; // HWC hasn't previously seen this buffer in this slot
     }
     status_t result = mHwc.setClientTarget(mDisplayId, mCurrentBufferSlot, mCurrentFence, hwcBuffer,
-                                           mDataspace, hdrSdrRatio);
+                                           mDataspace, item.mSurfaceDamage, hdrSdrRatio);
     if (result != NO_ERROR) {
         ALOGE("error posting framebuffer: %s (%d)", strerror(-result), result);
         return result;
@@ -69,6 +69,19 @@ inline bool hasMetadataKey(const std::set<Hwc2::PerFrameMetadataKey>& keys,
     return keys.find(key) != keys.end();
 }
 
+std::vector<Hwc2::IComposerClient::Rect> convertRegionToHwcRects(const Region& region) {
+    size_t rectCount = 0;
+    Rect const* rectArray = region.getArray(&rectCount);
+
+    std::vector<Hwc2::IComposerClient::Rect> hwcRects;
+    hwcRects.reserve(rectCount);
+    for (size_t rect = 0; rect < rectCount; ++rect) {
+        hwcRects.push_back({rectArray[rect].left, rectArray[rect].top, rectArray[rect].right,
+                            rectArray[rect].bottom});
+    }
+    return hwcRects;
+}
+
 } // namespace anonymous
 
 // Display methods
@@ -468,12 +481,17 @@ Error Display::setActiveConfigWithConstraints(hal::HWConfigId configId,
 
 Error Display::setClientTarget(uint32_t slot, const sp<GraphicBuffer>& target,
                                const sp<Fence>& acquireFence, Dataspace dataspace,
-                               float hdrSdrRatio) {
-    // TODO: Properly encode client target surface damage
+                               const Region& damage, float hdrSdrRatio) {
     int32_t fenceFd = acquireFence->dup();
+    // We encode default full-screen damage as INVALID_RECT upstream, but as 0
+    // rects for HWC
+    std::vector<Hwc2::IComposerClient::Rect> damageRects;
+    if (!(damage.isRect() && damage.getBounds() == Rect::INVALID_RECT)) {
+        damageRects = convertRegionToHwcRects(damage);
+    }
     auto intError =
-            mComposer.setClientTarget(mId, slot, target, fenceFd, dataspace,
-                                      std::vector<Hwc2::IComposerClient::Rect>(), hdrSdrRatio);
+            mComposer.setClientTarget(mId, slot, target, fenceFd, dataspace, damageRects,
+                                      hdrSdrRatio);
     return static_cast<Error>(intError);
 }
 
@@ -488,12 +506,14 @@ Error Display::setColorTransform(const android::mat4& matrix) {
     return static_cast<Error>(intError);
 }
 
-Error Display::setOutputBuffer(const sp<GraphicBuffer>& buffer,
+Error Display::setOutputBuffer(uint32_t slot, const sp<GraphicBuffer>& buffer,
         const sp<Fence>& releaseFence)
 {
     int32_t fenceFd = releaseFence->dup();
-    auto handle = buffer->getNativeBuffer()->handle;
-    auto intError = mComposer.setOutputBuffer(mId, handle, fenceFd);
+    // A null buffer means the HAL has already seen the buffer in this slot and
+    // should use its cached copy.
+    auto handle = buffer ? buffer->getNativeBuffer()->handle : nullptr;
+    auto intError = mComposer.setOutputBuffer(mId, slot, handle, fenceFd);
     close(fenceFd);
     return static_cast<Error>(intError);
 }
@@ -684,21 +704,6 @@ void Display::setPhysicalSizeInMm(std::optional<ui::Size> size) {
 
 // Layer methods
 
-namespace {
-std::vector<Hwc2::IComposerClient::Rect> convertRegionToHwcRects(const Region& region) {
-    size_t rectCount = 0;
-    Rect const* rectArray = region.getArray(&rectCount);
-
-    std::vector<Hwc2::IComposerClient::Rect> hwcRects;
-    hwcRects.reserve(rectCount);
-    for (size_t rect = 0; rect < rectCount; ++rect) {
-        hwcRects.push_back({rectArray[rect].left, rectArray[rect].top, rectArray[rect].right,
-                            rectArray[rect].bottom});
-    }
-    return hwcRects;
-}
-} // namespace
-
 Layer::~Layer() = default;
 
 namespace impl {
@@ -813,6 +818,10 @@ Error Layer::setBlendMode(BlendMode mode)
         return Error::BAD_DISPLAY;
     }
 
+    if (mode == mBlendMode) {
+        return Error::NONE;
+    }
+    mBlendMode = mode;
     auto intError = mComposer.setLayerBlendMode(mDisplay->getId(), mId, mode);
     return static_cast<Error>(intError);
 }
@@ -822,6 +831,10 @@ Error Layer::setColor(Color color) {
         return Error::BAD_DISPLAY;
     }
 
+    if (color == mColor) {
+        return Error::NONE;
+    }
+    mColor = color;
     auto intError = mComposer.setLayerColor(mDisplay->getId(), mId, color);
     return static_cast<Error>(intError);
 }
@@ -922,6 +935,10 @@ Error Layer::setDisplayFrame(const Rect& frame)
         return Error::BAD_DISPLAY;
     }
 
+    if (frame == mDisplayFrame) {
+        return Error::NONE;
+    }
+    mDisplayFrame = frame;
     Hwc2::IComposerClient::Rect hwcRect{frame.left, frame.top,
         frame.right, frame.bottom};
     auto intError = mComposer.setLayerDisplayFrame(mDisplay->getId(), mId, hwcRect);
@@ -934,6 +951,10 @@ Error Layer::setPlaneAlpha(float alpha)
         return Error::BAD_DISPLAY;
     }
 
+    if (alpha == mPlaneAlpha) {
+        return Error::NONE;
+    }
+    mPlaneAlpha = alpha;
     auto intError = mComposer.setLayerPlaneAlpha(mDisplay->getId(), mId, alpha);
     return static_cast<Error>(intError);
 }
@@ -959,6 +980,10 @@ Error Layer::setSourceCrop(const FloatRect& crop)
         return Error::BAD_DISPLAY;
     }
 
+    if (crop == mSourceCrop) {
+        return Error::NONE;
+    }
+    mSourceCrop = crop;
     Hwc2::IComposerClient::FRect hwcRect{
         crop.left, crop.top, crop.right, crop.bottom};
     auto intError = mComposer.setLayerSourceCrop(mDisplay->getId(), mId, hwcRect);
@@ -971,6 +996,10 @@ Error Layer::setTransform(Transform transform)
         return Error::BAD_DISPLAY;
     }
 
+    if (transform == mTransform) {
+        return Error::NONE;
+    }
+    mTransform = transform;
     auto intTransform = static_cast<Hwc2::Transform>(transform);
     auto intError = mComposer.setLayerTransform(mDisplay->getId(), mId, intTransform);
     return static_cast<Error>(intError);
@@ -998,6 +1027,10 @@ Error Layer::setZOrder(uint32_t z)
         return Error::BAD_DISPLAY;
     }
 
+    if (z == mZOrder) {
+        return Error::NONE;
+    }
+    mZOrder = z;
     auto intError = mComposer.setLayerZOrder(mDisplay->getId(), mId, z);
     return static_cast<Error>(intError);
 }
@@ -1038,6 +1071,10 @@ Error Layer::setBrightness(float brightness) {
         return Error::BAD_DISPLAY;
     }
 
+    if (brightness == mBrightness) {
+        return Error::NONE;
+    }
+    mBrightness = brightness;
     auto intError = mComposer.setLayerBrightness(mDisplay->getId(), mId, brightness);
     return static_cast<Error>(intError);
 }
@@ -16,6 +16,7 @@
 
 // TODO(b/129481165): remove the #pragma below and fix conversion issues
 #include <chrono>
+#include <string_view>
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wconversion"
 
@@ -491,12 +492,14 @@ void HWComposer::setVsyncEnabled(PhysicalDisplayId displayId, hal::Vsync enabled
 
 status_t HWComposer::setClientTarget(HalDisplayId displayId, uint32_t slot,
                                      const sp<Fence>& acquireFence, const sp<GraphicBuffer>& target,
-                                     ui::Dataspace dataspace, float hdrSdrRatio) {
+                                     ui::Dataspace dataspace, const Region& damage,
+                                     float hdrSdrRatio) {
     RETURN_IF_INVALID_DISPLAY(displayId, BAD_INDEX);
 
     ALOGV("%s for display %s", __FUNCTION__, to_string(displayId).c_str());
     auto& hwcDisplay = mDisplayData[displayId].hwcDisplay;
-    auto error = hwcDisplay->setClientTarget(slot, target, acquireFence, dataspace, hdrSdrRatio);
+    auto error = hwcDisplay->setClientTarget(slot, target, acquireFence, dataspace, damage,
+                                             hdrSdrRatio);
     RETURN_IF_HWC_ERROR(error, displayId, BAD_VALUE);
     return NO_ERROR;
 }
@@ -758,11 +761,11 @@ void HWComposer::disconnectDisplay(HalDisplayId displayId) {
 }
 
 status_t HWComposer::setOutputBuffer(HalVirtualDisplayId displayId, const sp<Fence>& acquireFence,
-                                     const sp<GraphicBuffer>& buffer) {
+                                     uint32_t slot, const sp<GraphicBuffer>& buffer) {
     RETURN_IF_INVALID_DISPLAY(displayId, BAD_INDEX);
     const auto& displayData = mDisplayData[displayId];
 
-    auto error = displayData.hwcDisplay->setOutputBuffer(buffer, acquireFence);
+    auto error = displayData.hwcDisplay->setOutputBuffer(slot, buffer, acquireFence);
     RETURN_IF_HWC_ERROR(error, displayId, UNKNOWN_ERROR);
     return NO_ERROR;
 }
@@ -1111,6 +1114,23 @@ bool HWComposer::shouldIgnoreHotplugConnect(hal::HWDisplayId hwcDisplayId,
     return false;
 }
 
+std::optional<DisplayIdentificationInfo> HWComposer::parseIdentificationData(
+        hal::HWDisplayId hwcDisplayId, uint8_t port, const DisplayIdentificationData& data) {
+    const uint64_t dataHash =
+            std::hash<std::string_view>{}(
+                    std::string_view(reinterpret_cast<const char*>(data.data()), data.size())) ^
+            port;
+    if (const auto it = mIdentificationCache.find(hwcDisplayId);
+        it != mIdentificationCache.end() && it->second.dataHash == dataHash) {
+        return it->second.info;
+    }
+    auto info = parseDisplayIdentificationData(port, data);
+    if (info) {
+        mIdentificationCache[hwcDisplayId] = {dataHash, *info};
+    }
+    return info;
+}
+
 std::optional<DisplayIdentificationInfo> HWComposer::onHotplugConnect(
         hal::HWDisplayId hwcDisplayId) {
     std::optional<DisplayIdentificationInfo> info;
@@ -1122,7 +1142,7 @@ std::optional<DisplayIdentificationInfo> HWComposer::onHotplugConnect(
             uint8_t port;
             DisplayIdentificationData data;
             getDisplayIdentificationData(hwcDisplayId, &port, &data);
-            if (auto newInfo = parseDisplayIdentificationData(port, data)) {
+            if (auto newInfo = parseIdentificationData(hwcDisplayId, port, data)) {
                 info->deviceProductInfo = std::move(newInfo->deviceProductInfo);
                 info->preferredDetailedTimingDescriptor =
                         std::move(newInfo->preferredDetailedTimingDescriptor);
@@ -1148,7 +1168,7 @@ std::optional<DisplayIdentificationInfo> HWComposer::onHotplugConnect(
         info = [this, hwcDisplayId, &port, &data, hasDisplayIdentificationData] {
             const bool isPrimary = !mPrimaryHwcDisplayId;
             if (mHasMultiDisplaySupport) {
-                if (const auto info = parseDisplayIdentificationData(port, data)) {
+                if (const auto info = parseIdentificationData(hwcDisplayId, port, data)) {
                     return *info;
                 }
                 ALOGE("Failed to parse identification data for display %" PRIu64, hwcDisplayId);
@@ -155,6 +155,7 @@ public:
 
     virtual status_t setClientTarget(HalDisplayId, uint32_t slot, const sp<Fence>& acquireFence,
                                      const sp<GraphicBuffer>& target, ui::Dataspace,
+                                     const Region& damage,
                                      float hdrSdrRatio) = 0;
 
     // Present layers to the display and read releaseFences.
@@ -180,9 +181,10 @@ public:
     // Get last release fence for the given layer
     virtual sp<Fence> getLayerReleaseFence(HalDisplayId, HWC2::Layer*) const = 0;
 
-    // Set the output buffer and acquire fence for a virtual display.
+    // Set the output buffer and acquire fence for a virtual display. The buffer
+    // may be null if the HAL has already cached a buffer in the given slot.
     virtual status_t setOutputBuffer(HalVirtualDisplayId, const sp<Fence>& acquireFence,
-                                     const sp<GraphicBuffer>& buffer) = 0;
+                                     uint32_t slot, const sp<GraphicBuffer>& buffer) = 0;
 
     // After SurfaceFlinger has retrieved the release fences for all the frames,
     // it can call this to clear the shared pointers in the release fence map
@@ -364,7 +366,7 @@ public:
 
     status_t setClientTarget(HalDisplayId, uint32_t slot, const sp<Fence>& acquireFence,
                              const sp<GraphicBuffer>& target, ui::Dataspace,
-                             float hdrSdrRatio) override;
+                             const Region& damage, float hdrSdrRatio) override;
 
     // Present layers to the display and read releaseFences.
     status_t presentAndGetReleaseFences(
@@ -390,7 +392,7 @@ public:
     sp<Fence> getLayerReleaseFence(HalDisplayId, HWC2::Layer*) const override;
 
     // Set the output buffer and acquire fence for a virtual display.
-    status_t setOutputBuffer(HalVirtualDisplayId, const sp<Fence>& acquireFence,
+    status_t setOutputBuffer(HalVirtualDisplayId, const sp<Fence>& acquireFence, uint32_t slot,
                              const sp<GraphicBuffer>& buffer) override;
 
     // After SurfaceFlinger has retrieved the release fences for all the frames,
@@ -532,6 +534,11 @@ private:
 
     std::optional<DisplayIdentificationInfo> onHotplugConnect(hal::HWDisplayId);
     std::optional<DisplayIdentificationInfo> onHotplugDisconnect(hal::HWDisplayId);
+
+    // Parses identification data, memoizing the result keyed by a hash of the raw
+    // blob so that hotplug reconnects of the same panel skip the EDID re-parse.
+    std::optional<DisplayIdentificationInfo> parseIdentificationData(
+            hal::HWDisplayId, uint8_t port, const DisplayIdentificationData&);
     bool shouldIgnoreHotplugConnect(hal::HWDisplayId, bool hasDisplayIdentificationData) const;
 
     aidl::android::hardware::graphics::composer3::DisplayConfiguration::Dpi
@@ -568,6 +575,15 @@ private:
     std::optional<hal::HWDisplayId> mPrimaryHwcDisplayId;
     bool mHasMultiDisplaySupport = false;
 
+    // Memoized identification parses, keyed per connector. Entries deliberately
+    // survive disconnection so that plugging the same panel back in is cheap; the
+    // blob hash revalidates them.
+    struct IdentificationCacheEntry {
+        uint64_t dataHash;
+        DisplayIdentificationInfo info;
+    };
+    std::unordered_map<hal::HWDisplayId, IdentificationCacheEntry> mIdentificationCache;
+
     const size_t mMaxVirtualDisplayDimension;
     const bool mUpdateDeviceProductInfoOnHotplugReconnect;
     bool mEnableVrrTimeout;
@@ -230,7 +230,7 @@ public:
                           float hdrSdrRatio) override;
     Error setColorMode(Display display, ColorMode mode, RenderIntent renderIntent) override;
     Error setColorTransform(Display display, const float* matrix) override;
-    Error setOutputBuffer(Display display, const native_handle_t* buffer,
+    Error setOutputBuffer(Display display, uint32_t slot, const native_handle_t* buffer,
                           int releaseFence) override;
     Error setPowerMode(Display display, IComposerClient::PowerMode mode) override;
     Error setVsyncEnabled(Display display, IComposerClient::Vsync enabled) override;
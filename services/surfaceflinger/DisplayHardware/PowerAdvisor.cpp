@@ -24,6 +24,7 @@
 #include <unistd.h>
 #include <cinttypes>
 #include <cstdint>
+#include <cstdlib>
 #include <optional>
 
 #include <android-base/properties.h>
@@ -307,6 +308,8 @@ void PowerAdvisor::updateTargetWorkDuration(Duration targetDuration) {
         }
         ALOGV("Sending target time: %" PRId64 "ns", targetDuration.ns());
         mLastTargetDurationSent = targetDuration;
+        // The steady-state baseline is no longer meaningful under the new target.
+        mLastFlushedDurationNs = -1;
         auto target = targetDuration.ns();
         if (!writeHintSessionMessage<ChannelMessageContents::Tag::targetDuration>(&target, 1)) {
             auto ret = mHintSession->updateTargetWorkDuration(targetDuration.ns());
@@ -362,6 +365,12 @@ void PowerAdvisor::reportActualWorkDuration() {
             return;
         }
         mHintSessionQueue.push_back(*actualDuration);
+        if (sBatchWorkDurations && shouldDeferWorkDurationReport(*actualDuration)) {
+            // Steady state: this duration would not change the governor's decision, so
+            // keep it queued. It is still delivered, timestamped, with the next flush.
+            return;
+        }
+        mLastFlushedDurationNs = actualDuration->durationNanos;
         if (!writeHintSessionMessage<
                     ChannelMessageContents::Tag::workDuration>(mHintSessionQueue.data(),
                                                                mHintSessionQueue.size())) {
@@ -376,6 +385,18 @@ void PowerAdvisor::reportActualWorkDuration() {
     mHintSessionQueue.clear();
 }
 
+bool PowerAdvisor::shouldDeferWorkDurationReport(const WorkDuration& duration) const {
+    // Bound both the batch size and how stale the HAL's view may become.
+    if (mHintSessionQueue.size() >= kMaxBatchedReports) return false;
+    // No baseline yet, or the target just changed.
+    if (mLastFlushedDurationNs < 0) return false;
+    const nsecs_t target = mLastTargetDurationSent.ns();
+    // Never sit on a report that signals a deadline at risk.
+    if (duration.durationNanos >= target || mLastFlushedDurationNs >= target) return false;
+    const nsecs_t tolerance = target * kBatchTolerancePercent / 100;
+    return std::abs(duration.durationNanos - mLastFlushedDurationNs) <= tolerance;
+}
+
 template <ChannelMessage::ChannelMessageContents::Tag T, class In>
 bool PowerAdvisor::writeHintSessionMessage(In* contents, size_t count) {
     if (!mMsgQueue) {
@@ -753,6 +774,9 @@ const Duration PowerAdvisor::sTargetSafetyMargin = std::chrono::microseconds(
 const bool PowerAdvisor::sUseReportActualDuration =
         base::GetBoolProperty(std::string("debug.adpf.use_report_actual_duration"), true);
 
+const bool PowerAdvisor::sBatchWorkDurations =
+        base::GetBoolProperty(std::string("debug.adpf.batch_work_durations"), false);
+
 power::PowerHalController& PowerAdvisor::getPowerHal() {
     static std::once_flag halFlag;
     std::call_once(halFlag, [this] { mPowerHal->init(); });
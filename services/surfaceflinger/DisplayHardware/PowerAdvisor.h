@@ -274,6 +274,10 @@ private:
     bool mHasDisplayUpdateImminent = true;
     // Queue of actual durations saved to report
     std::vector<aidl::android::hardware::power::WorkDuration> mHintSessionQueue;
+    // Duration of the last report actually flushed to the HAL, or -1 if the next report
+    // must flush, e.g. after the target changed. Used by sBatchWorkDurations to decide
+    // whether a new duration could change the governor's decision.
+    int64_t mLastFlushedDurationNs = -1;
     std::unique_ptr<::android::AidlMessageQueue<
             aidl::android::hardware::power::ChannelMessage,
             ::aidl::android::hardware::common::fmq::SynchronizedReadWrite>>
@@ -314,6 +318,18 @@ private:
     // Whether we should send reportActualWorkDuration calls
     static const bool sUseReportActualDuration;
 
+    // Whether steady-state actual durations should be batched and flushed only when they
+    // could change the governor's decision (debug.adpf.batch_work_durations)
+    static const bool sBatchWorkDurations;
+    // A queued duration within this much of the last flushed one, both below target, is
+    // considered steady state
+    static constexpr uint32_t kBatchTolerancePercent = 5;
+    // Upper bound on batching, so the HAL's view never goes stale for long
+    static constexpr size_t kMaxBatchedReports = 8;
+
+    bool shouldDeferWorkDurationReport(
+            const aidl::android::hardware::power::WorkDuration& duration) const;
+
     // How long we expect hwc to run after the present call until it waits for the fence
     static constexpr const Duration kFenceWaitStartDelayValidated{150us};
     static constexpr const Duration kFenceWaitStartDelaySkippedValidate{250us};
@@ -115,6 +115,7 @@ VirtualDisplaySurface::VirtualDisplaySurface(HWComposer& hwc, VirtualDisplayId d
 
     for (size_t i = 0; i < sizeof(mHwcBufferIds) / sizeof(mHwcBufferIds[0]); ++i) {
         mHwcBufferIds[i] = UINT64_MAX;
+        mHwcOutputBufferIds[i] = UINT64_MAX;
     }
 }
 
@@ -224,7 +225,8 @@ status_t VirtualDisplaySurface::advanceFrame(float hdrSdrRatio) {
     LOG_FATAL_IF(!halDisplayId);
     // At this point we know the output buffer acquire fence,
     // so update HWC state with it.
-    mHwc.setOutputBuffer(*halDisplayId, mOutputFence, outBuffer);
+    mHwc.setOutputBuffer(*halDisplayId, mOutputFence, static_cast<uint32_t>(mOutputProducerSlot),
+                         cachedOutputBuffer(outBuffer));
 
     status_t result = NO_ERROR;
     if (fbBuffer != nullptr) {
@@ -236,7 +238,8 @@ status_t VirtualDisplaySurface::advanceFrame(float hdrSdrRatio) {
         }
         // TODO: Correctly propagate the dataspace from GL composition
         result = mHwc.setClientTarget(*halDisplayId, mFbProducerSlot, mFbFence, hwcBuffer,
-                                      ui::Dataspace::UNKNOWN, hdrSdrRatio);
+                                      ui::Dataspace::UNKNOWN, Region::INVALID_REGION,
+                                      hdrSdrRatio);
     }
 
     return result;
@@ -659,11 +662,22 @@ status_t VirtualDisplaySurface::refreshOutputBuffer() {
     const auto halDisplayId = HalVirtualDisplayId::tryCast(mDisplayId);
     LOG_FATAL_IF(!halDisplayId);
     result = mHwc.setOutputBuffer(*halDisplayId, Fence::NO_FENCE,
-                                  mProducerBuffers[mOutputProducerSlot]);
+                                  static_cast<uint32_t>(mOutputProducerSlot),
+                                  cachedOutputBuffer(mProducerBuffers[mOutputProducerSlot]));
 
     return result;
 }
 
+sp<GraphicBuffer> VirtualDisplaySurface::cachedOutputBuffer(const sp<GraphicBuffer>& buffer) {
+    // Assume that HWC has previously seen the buffer in this slot and send a
+    // null handle so it uses its cached import instead of importing it again.
+    if (buffer->getId() == mHwcOutputBufferIds[mOutputProducerSlot]) {
+        return nullptr;
+    }
+    mHwcOutputBufferIds[mOutputProducerSlot] = buffer->getId();
+    return buffer;
+}
+
 // This slot mapping function is its own inverse, so two copies are unnecessary.
 // Both are kept to make the intent clear where the function is called, and for
 // the (unlikely) chance that we switch to a different mapping function.
@@ -147,6 +147,7 @@ private:
     void updateQueueBufferOutput(QueueBufferOutput&&);
     void resetPerFrameState();
     status_t refreshOutputBuffer();
+    sp<GraphicBuffer> cachedOutputBuffer(const sp<GraphicBuffer>& buffer);
 
     // Both the sink and scratch buffer pools have their own set of slots
     // ("source slots", or "sslot"). We have to merge these into the single
@@ -170,6 +171,9 @@ private:
     // NOTE: The BufferQueue slot number is the same as the HWC slot number.
     uint64_t mHwcBufferIds[BufferQueue::NUM_BUFFER_SLOTS];
 
+    // Output buffers that HWC has seen before, indexed by HWC slot number.
+    uint64_t mHwcOutputBufferIds[BufferQueue::NUM_BUFFER_SLOTS];
+
     //
     // Inter-frame state
     //
@@ -37,21 +37,18 @@ void FpsReporter::dispatchLayerFps(const frontend::LayerHierarchy& layerHierarch
         return;
     }
 
-    std::vector<TrackedListener> localListeners;
+    std::vector<std::pair<wp<IBinder>, TrackedListener>> localListeners;
     {
         std::scoped_lock lock(mMutex);
         if (mListeners.empty()) {
             return;
         }
 
-        std::transform(mListeners.begin(), mListeners.end(), std::back_inserter(localListeners),
-                       [](const std::pair<wp<IBinder>, TrackedListener>& entry) {
-                           return entry.second;
-                       });
+        std::copy(mListeners.begin(), mListeners.end(), std::back_inserter(localListeners));
     }
 
     std::unordered_set<int32_t> seenTasks;
-    std::vector<std::pair<TrackedListener, const frontend::LayerHierarchy*>>
+    std::vector<std::pair<std::pair<wp<IBinder>, TrackedListener>, const frontend::LayerHierarchy*>>
             listenersAndLayersToReport;
 
     layerHierarchy.traverse([&](const frontend::LayerHierarchy& hierarchy,
@@ -64,10 +61,10 @@ void FpsReporter::dispatchLayerFps(const frontend::LayerHierarchy& layerHierarch
             int32_t taskId = metadata.getInt32(gui::METADATA_TASK_ID, 0);
             if (seenTasks.count(taskId) == 0) {
                 // localListeners is expected to be tiny
-                for (TrackedListener& listener : localListeners) {
-                    if (listener.taskId == taskId) {
+                for (auto& entry : localListeners) {
+                    if (entry.second.taskId == taskId) {
                         seenTasks.insert(taskId);
-                        listenersAndLayersToReport.push_back({listener, &hierarchy});
+                        listenersAndLayersToReport.push_back({entry, &hierarchy});
                         break;
                     }
                 }
@@ -76,7 +73,7 @@ void FpsReporter::dispatchLayerFps(const frontend::LayerHierarchy& layerHierarch
         return true;
     });
 
-    for (const auto& [listener, hierarchy] : listenersAndLayersToReport) {
+    for (const auto& [entry, hierarchy] : listenersAndLayersToReport) {
         std::unordered_set<int32_t> layerIds;
 
         hierarchy->traverse([&](const frontend::LayerHierarchy& hierarchy,
@@ -88,7 +85,20 @@ void FpsReporter::dispatchLayerFps(const frontend::LayerHierarchy& layerHierarch
             return true;
         });
 
-        listener.listener->onFpsReported(mFrameTimeline.computeFps(layerIds));
+        const float fps = mFrameTimeline.computeFps(layerIds);
+        {
+            // Skip the binder callback when the value did not change since the last
+            // report, so idle listeners are not woken up twice a second for nothing.
+            std::scoped_lock lock(mMutex);
+            auto it = mListeners.find(entry.first);
+            if (it != mListeners.end()) {
+                if (it->second.lastReportedFps == fps) {
+                    continue;
+                }
+                it->second.lastReportedFps = fps;
+            }
+        }
+        entry.second.listener->onFpsReported(fps);
     }
 
     mLastDispatch = now;
@@ -56,6 +56,9 @@ private:
     struct TrackedListener {
         sp<gui::IFpsListener> listener;
         int32_t taskId;
+        // Last value delivered to the listener, so dispatches that recompute the same
+        // fps do not wake the listener process again. Negative means never reported.
+        float lastReportedFps = -1.f;
     };
 
     frametimeline::FrameTimeline& mFrameTimeline;
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+
+#include <android-base/properties.h>
+#include <android-base/stringprintf.h>
+#include <common/trace.h>
+
+#include "FrameBudgetTracker.h"
+
+namespace android {
+
+using base::StringAppendF;
+
+namespace {
+
+nsecs_t budgetFromProperty(const char* name) {
+    const int us = base::GetIntProperty(name, 0);
+    return us > 0 ? us2ns(us) : 0;
+}
+
+} // namespace
+
+FrameBudgetTracker::FrameBudgetTracker() {
+    mBudgets[static_cast<size_t>(Stage::Latch)] = budgetFromProperty("debug.sf.budget.latch_us");
+    mBudgets[static_cast<size_t>(Stage::CompositeSetup)] =
+            budgetFromProperty("debug.sf.budget.composite_setup_us");
+    mBudgets[static_cast<size_t>(Stage::Present)] =
+            budgetFromProperty("debug.sf.budget.present_us");
+    mBudgets[static_cast<size_t>(Stage::PostComposition)] =
+            budgetFromProperty("debug.sf.budget.post_composition_us");
+
+    for (const nsecs_t budget : mBudgets) {
+        mEnabled |= budget > 0;
+    }
+}
+
+const char* FrameBudgetTracker::stageName(Stage stage) {
+    switch (stage) {
+        case Stage::Latch:
+            return "latch";
+        case Stage::CompositeSetup:
+            return "composite setup";
+        case Stage::Present:
+            return "present";
+        case Stage::PostComposition:
+            return "post composition";
+    }
+    return "unknown";
+}
+
+void FrameBudgetTracker::recordStageDuration(Stage stage, int64_t vsyncId, nsecs_t startTime,
+                                             nsecs_t endTime, const char* attribution) {
+    const nsecs_t budget = mBudgets[static_cast<size_t>(stage)];
+    const nsecs_t duration = endTime - startTime;
+    if (budget <= 0 || duration <= budget) {
+        return;
+    }
+
+    size_t totalOverruns;
+    {
+        Mutex::Autolock lock(mMutex);
+        OverrunRecord& record = mOverruns[mNextOverrun];
+        record.vsyncId = vsyncId;
+        record.stage = stage;
+        record.duration = duration;
+        record.budget = budget;
+        record.when = endTime;
+        record.attribution = attribution ? attribution : "";
+
+        mNextOverrun = (mNextOverrun + 1) % kNumOverrunRecords;
+        if (mNumOverruns < kNumOverrunRecords) {
+            mNumOverruns++;
+        }
+        totalOverruns = ++mOverrunCounts[static_cast<size_t>(stage)];
+        for (size_t i = 0; i < kNumStages; i++) {
+            if (i != static_cast<size_t>(stage)) {
+                totalOverruns += mOverrunCounts[i];
+            }
+        }
+    }
+
+    SFTRACE_INT("FrameBudgetOverruns", static_cast<int32_t>(totalOverruns));
+}
+
+void FrameBudgetTracker::dump(std::string& result) const {
+    result.append("Frame budget tracker:\n");
+    if (!mEnabled) {
+        result.append("  disabled (no debug.sf.budget.*_us budgets set)\n");
+        return;
+    }
+
+    for (size_t i = 0; i < kNumStages; i++) {
+        if (mBudgets[i] > 0) {
+            StringAppendF(&result, "  %-16s budget %" PRId64 " us\n",
+                          stageName(static_cast<Stage>(i)), ns2us(mBudgets[i]));
+        }
+    }
+
+    Mutex::Autolock lock(mMutex);
+    size_t totalOverruns = 0;
+    for (size_t i = 0; i < kNumStages; i++) {
+        totalOverruns += mOverrunCounts[i];
+    }
+    StringAppendF(&result, "  %zu overruns total, most recent %zu:\n", totalOverruns,
+                  mNumOverruns);
+
+    // Walk the ring from oldest to newest.
+    const size_t start = (mNextOverrun + kNumOverrunRecords - mNumOverruns) % kNumOverrunRecords;
+    for (size_t i = 0; i < mNumOverruns; i++) {
+        const OverrunRecord& record = mOverruns[(start + i) % kNumOverrunRecords];
+        StringAppendF(&result,
+                      "  [%" PRId64 "] %-16s %" PRId64 " us (budget %" PRId64 " us)%s%s\n",
+                      record.vsyncId, stageName(record.stage), ns2us(record.duration),
+                      ns2us(record.budget), record.attribution.empty() ? "" : " - ",
+                      record.attribution.c_str());
+    }
+}
+
+} // namespace android
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <utils/Mutex.h>
+#include <utils/Timers.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace android {
+
+// FrameBudgetTracker attributes main-thread jank to the frame stage that exceeded
+// its budget. Budgets are configured per stage, in microseconds, via debug sysprops:
+//
+//   debug.sf.budget.latch_us
+//   debug.sf.budget.composite_setup_us
+//   debug.sf.budget.present_us
+//   debug.sf.budget.post_composition_us
+//
+// A stage with no budget (the default) is not tracked, so the tracker costs nothing
+// unless enabled. Overruns are recorded into a circular buffer along with the frame's
+// vsync id and an attribution hint (e.g. the first layer latched that frame), and are
+// reported via `dumpsys SurfaceFlinger --frame-budget` and as a "FrameBudgetOverruns"
+// trace counter for correlation with system traces.
+class FrameBudgetTracker {
+public:
+    enum class Stage : size_t {
+        // Transaction flush and buffer latch.
+        Latch,
+        // Snapshot handoff and CompositionRefreshArgs construction.
+        CompositeSetup,
+        // CompositionEngine::present, covering HWC validate and RenderEngine drawing.
+        Present,
+        // Work between present and the end of composite.
+        PostComposition,
+    };
+
+    static constexpr size_t kNumStages = 4;
+
+    FrameBudgetTracker();
+
+    // True if any stage has a budget configured. Callers use this to skip
+    // timestamping stage boundaries entirely when the tracker is off.
+    bool isEnabled() const { return mEnabled; }
+
+    // Records the duration of a stage for the frame with the given vsync id. The
+    // attribution hint may be null and is copied only if the stage overran its budget.
+    void recordStageDuration(Stage stage, int64_t vsyncId, nsecs_t startTime, nsecs_t endTime,
+                             const char* attribution);
+
+    void dump(std::string& result) const;
+
+private:
+    struct OverrunRecord {
+        int64_t vsyncId = 0;
+        Stage stage = Stage::Latch;
+        nsecs_t duration = 0;
+        nsecs_t budget = 0;
+        nsecs_t when = 0;
+        std::string attribution;
+    };
+
+    static const char* stageName(Stage stage);
+
+    bool mEnabled = false;
+    std::array<nsecs_t, kNumStages> mBudgets{};
+
+    // The mutex is only taken when an overrun is recorded or the tracker is dumped.
+    static constexpr size_t kNumOverrunRecords = 64;
+    mutable Mutex mMutex;
+    std::array<OverrunRecord, kNumOverrunRecords> mOverruns GUARDED_BY(mMutex);
+    size_t mNextOverrun GUARDED_BY(mMutex) = 0;
+    size_t mNumOverruns GUARDED_BY(mMutex) = 0;
+    std::array<size_t, kNumStages> mOverrunCounts GUARDED_BY(mMutex){};
+};
+
+} // namespace android
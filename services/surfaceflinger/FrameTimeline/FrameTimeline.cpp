@@ -25,6 +25,7 @@
 #include <common/trace.h>
 #include <utils/Log.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cinttypes>
 #include <numeric>
@@ -335,9 +336,26 @@ int64_t TraceCookieCounter::getCookieForTracing() {
     return ++mTraceCookie;
 }
 
+std::shared_ptr<const std::string> LayerNameInterner::intern(std::string name) {
+    std::scoped_lock lock(mMutex);
+    if (auto it = mNames.find(name); it != mNames.end()) {
+        if (std::shared_ptr<const std::string> interned = it->second.lock()) {
+            return interned;
+        }
+    }
+    // Drop entries whose names are no longer referenced by any SurfaceFrame, so the
+    // table tracks the set of live layers rather than every name ever seen.
+    std::erase_if(mNames, [](const auto& entry) { return entry.second.expired(); });
+    auto interned = std::make_shared<const std::string>(std::move(name));
+    mNames[*interned] = interned;
+    return interned;
+}
+
 SurfaceFrame::SurfaceFrame(const FrameTimelineInfo& frameTimelineInfo, pid_t ownerPid,
-                           uid_t ownerUid, int32_t layerId, std::string layerName,
-                           std::string debugName, PredictionState predictionState,
+                           uid_t ownerUid, int32_t layerId,
+                           std::shared_ptr<const std::string> layerName,
+                           std::shared_ptr<const std::string> debugName,
+                           PredictionState predictionState,
                            frametimeline::TimelineItem&& predictions,
                            std::shared_ptr<TimeStats> timeStats,
                            JankClassificationThresholds thresholds,
@@ -388,7 +406,7 @@ void SurfaceFrame::setPresentState(PresentState presentState, nsecs_t lastLatchT
     LOG_ALWAYS_FATAL_IF(mPresentState != PresentState::Unknown,
                         "setPresentState called on a SurfaceFrame from Layer - %s, that has a "
                         "PresentState - %s set already.",
-                        mDebugName.c_str(), toString(mPresentState).c_str());
+                        mDebugName->c_str(), toString(mPresentState).c_str());
     mPresentState = presentState;
     mLastLatchTime = lastLatchTime;
 }
@@ -485,7 +503,7 @@ void SurfaceFrame::promoteToBuffer() {
     LOG_ALWAYS_FATAL_IF(mIsBuffer == true,
                         "Trying to promote an already promoted BufferSurfaceFrame from layer %s "
                         "with token %" PRId64 "",
-                        mDebugName.c_str(), mToken);
+                        mDebugName->c_str(), mToken);
     mIsBuffer = true;
 }
 
@@ -497,7 +515,7 @@ bool SurfaceFrame::getIsBuffer() const {
 void SurfaceFrame::dump(std::string& result, const std::string& indent, nsecs_t baseTime) const {
     std::scoped_lock lock(mMutex);
     StringAppendF(&result, "%s", indent.c_str());
-    StringAppendF(&result, "Layer - %s", mDebugName.c_str());
+    StringAppendF(&result, "Layer - %s", mDebugName->c_str());
     if (mJankType != JankType::None) {
         // Easily identify a janky Surface Frame in the dump
         StringAppendF(&result, " [*] ");
@@ -548,7 +566,7 @@ void SurfaceFrame::dump(std::string& result, const std::string& indent, nsecs_t
 std::string SurfaceFrame::miniDump() const {
     std::scoped_lock lock(mMutex);
     std::string result;
-    StringAppendF(&result, "Layer - %s\n", mDebugName.c_str());
+    StringAppendF(&result, "Layer - %s\n", mDebugName->c_str());
     StringAppendF(&result, "Token: %" PRId64 "\n", mToken);
     StringAppendF(&result, "Is Buffer?: %d\n", mIsBuffer);
     StringAppendF(&result, "Present State : %s\n", toString(mPresentState).c_str());
@@ -700,7 +718,7 @@ void SurfaceFrame::onPresent(nsecs_t presentTime, int32_t displayFrameJankType,
 
     if (mPredictionState != PredictionState::None) {
         // Only update janky frames if the app used vsync predictions
-        mTimeStats->incrementJankyFrames({refreshRate, mRenderRate, mOwnerUid, mLayerName,
+        mTimeStats->incrementJankyFrames({refreshRate, mRenderRate, mOwnerUid, *mLayerName,
                                           mGameMode, mJankType, displayDeadlineDelta,
                                           displayPresentDelta, deadlineDelta});
 
@@ -766,7 +784,7 @@ void SurfaceFrame::tracePredictions(int64_t displayFrameToken, nsecs_t monoBootO
         expectedSurfaceFrameStartEvent->set_display_frame_token(displayFrameToken);
 
         expectedSurfaceFrameStartEvent->set_pid(mOwnerPid);
-        expectedSurfaceFrameStartEvent->set_layer_name(mDebugName);
+        expectedSurfaceFrameStartEvent->set_layer_name(*mDebugName);
     });
 
     if (traced) {
@@ -827,7 +845,7 @@ void SurfaceFrame::traceActuals(int64_t displayFrameToken, nsecs_t monoBootOffse
         actualSurfaceFrameStartEvent->set_display_frame_token(displayFrameToken);
 
         actualSurfaceFrameStartEvent->set_pid(mOwnerPid);
-        actualSurfaceFrameStartEvent->set_layer_name(mDebugName);
+        actualSurfaceFrameStartEvent->set_layer_name(*mDebugName);
 
         if (mPresentState == PresentState::Dropped) {
             actualSurfaceFrameStartEvent->set_present_type(FrameTimelineEvent::PRESENT_DROPPED);
@@ -889,18 +907,21 @@ int64_t TokenManager::generateTokenForPredictions(TimelineItem&& predictions) {
     SFTRACE_CALL();
     std::scoped_lock lock(mMutex);
     while (mPredictions.size() >= kMaxTokens) {
-        mPredictions.erase(mPredictions.begin());
+        mPredictions.pop_front();
     }
     const int64_t assignedToken = mCurrentToken++;
-    mPredictions[assignedToken] = predictions;
+    mPredictions.emplace_back(assignedToken, std::move(predictions));
     return assignedToken;
 }
 
 std::optional<TimelineItem> TokenManager::getPredictionsForToken(int64_t token) const {
     std::scoped_lock lock(mMutex);
-    auto predictionsIterator = mPredictions.find(token);
-    if (predictionsIterator != mPredictions.end()) {
-        return predictionsIterator->second;
+    const auto it = std::lower_bound(mPredictions.begin(), mPredictions.end(), token,
+                                     [](const auto& prediction, int64_t value) {
+                                         return prediction.first < value;
+                                     });
+    if (it != mPredictions.end() && it->first == token) {
+        return it->second;
     }
     return {};
 }
@@ -937,9 +958,16 @@ std::shared_ptr<SurfaceFrame> FrameTimeline::createSurfaceFrameForToken(
         const FrameTimelineInfo& frameTimelineInfo, pid_t ownerPid, uid_t ownerUid, int32_t layerId,
         std::string layerName, std::string debugName, bool isBuffer, GameMode gameMode) {
     SFTRACE_CALL();
+    // Intern the names up front: a SurfaceFrame is created per layer per frame, so the
+    // timeline history would otherwise retain a copy of each name per frame.
+    std::shared_ptr<const std::string> internedLayerName =
+            mNameInterner.intern(std::move(layerName));
+    std::shared_ptr<const std::string> internedDebugName =
+            mNameInterner.intern(std::move(debugName));
     if (frameTimelineInfo.vsyncId == FrameTimelineInfo::INVALID_VSYNC_ID) {
         return std::make_shared<SurfaceFrame>(frameTimelineInfo, ownerPid, ownerUid, layerId,
-                                              std::move(layerName), std::move(debugName),
+                                              std::move(internedLayerName),
+                                              std::move(internedDebugName),
                                               PredictionState::None, TimelineItem(), mTimeStats,
                                               mJankClassificationThresholds, &mTraceCookieCounter,
                                               isBuffer, gameMode);
@@ -948,13 +976,15 @@ std::shared_ptr<SurfaceFrame> FrameTimeline::createSurfaceFrameForToken(
             mTokenManager.getPredictionsForToken(frameTimelineInfo.vsyncId);
     if (predictions) {
         return std::make_shared<SurfaceFrame>(frameTimelineInfo, ownerPid, ownerUid, layerId,
-                                              std::move(layerName), std::move(debugName),
+                                              std::move(internedLayerName),
+                                              std::move(internedDebugName),
                                               PredictionState::Valid, std::move(*predictions),
                                               mTimeStats, mJankClassificationThresholds,
                                               &mTraceCookieCounter, isBuffer, gameMode);
     }
     return std::make_shared<SurfaceFrame>(frameTimelineInfo, ownerPid, ownerUid, layerId,
-                                          std::move(layerName), std::move(debugName),
+                                          std::move(internedLayerName),
+                                          std::move(internedDebugName),
                                           PredictionState::Expired, TimelineItem(), mTimeStats,
                                           mJankClassificationThresholds, &mTraceCookieCounter,
                                           isBuffer, gameMode);
@@ -1158,8 +1188,11 @@ void FrameTimeline::DisplayFrame::classifyJank(nsecs_t& deadlineDelta, nsecs_t&
                                     mJankClassificationThresholds.presentThreshold) {
                     // Classify CPU vs GPU if SF wasn't stuffed or if SF was stuffed but this frame
                     // was presented more than a vsync late.
-                    if (mGpuFence != FenceTime::NO_FENCE) {
-                        // If SF was in GPU composition, classify it as GPU deadline missed.
+                    if (mGpuFence != FenceTime::NO_FENCE &&
+                        mGpuFence->getSignalTime() > mSurfaceFlingerPredictions.endTime) {
+                        // The GPU composition work itself completed past the deadline, so the
+                        // GPU was the long pole. A frame that used GPU composition but whose
+                        // GPU work finished in time missed the deadline on the CPU side.
                         mJankType = JankType::SurfaceFlingerGpuDeadlineMissed;
                     } else {
                         mJankType = JankType::SurfaceFlingerCpuDeadlineMissed;
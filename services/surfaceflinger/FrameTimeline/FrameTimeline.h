@@ -23,6 +23,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 #include <gui/ISurfaceComposer.h>
 #include <gui/JankInfo.h>
@@ -148,6 +149,20 @@ private:
     std::atomic<int64_t> mTraceCookie = 0;
 };
 
+/*
+ * Interns layer and debug names so that the SurfaceFrames kept in the timeline history
+ * share a single allocation per distinct name instead of each owning a copy. Entries are
+ * dropped once no SurfaceFrame references them anymore.
+ */
+class LayerNameInterner {
+public:
+    std::shared_ptr<const std::string> intern(std::string name);
+
+private:
+    std::mutex mMutex;
+    std::unordered_map<std::string, std::weak_ptr<const std::string>> mNames GUARDED_BY(mMutex);
+};
+
 class SurfaceFrame {
 public:
     enum class PresentState {
@@ -159,7 +174,8 @@ public:
     // Only FrameTimeline can construct a SurfaceFrame as it provides Predictions(through
     // TokenManager), Thresholds and TimeStats pointer.
     SurfaceFrame(const FrameTimelineInfo& frameTimelineInfo, pid_t ownerPid, uid_t ownerUid,
-                 int32_t layerId, std::string layerName, std::string debugName,
+                 int32_t layerId, std::shared_ptr<const std::string> layerName,
+                 std::shared_ptr<const std::string> debugName,
                  PredictionState predictionState, TimelineItem&& predictions,
                  std::shared_ptr<TimeStats> timeStats, JankClassificationThresholds thresholds,
                  TraceCookieCounter* traceCookieCounter, bool isBuffer, GameMode);
@@ -246,8 +262,9 @@ private:
     const int32_t mInputEventId;
     const pid_t mOwnerPid;
     const uid_t mOwnerUid;
-    const std::string mLayerName;
-    const std::string mDebugName;
+    // Interned: shared with other SurfaceFrames of the same layer, never null.
+    const std::shared_ptr<const std::string> mLayerName;
+    const std::shared_ptr<const std::string> mDebugName;
     const int32_t mLayerId;
     PresentState mPresentState GUARDED_BY(mMutex);
     const PredictionState mPredictionState;
@@ -359,9 +376,11 @@ private:
     // Friend class for testing
     friend class android::frametimeline::FrameTimelineTest;
 
-    void flushTokens(nsecs_t flushTime) REQUIRES(mMutex);
-
-    std::map<int64_t, TimelineItem> mPredictions GUARDED_BY(mMutex);
+    // Tokens are assigned from a monotonic counter, so the pending predictions form a
+    // ring ordered by token: generation appends to the back and expiry pops from the
+    // front, and lookup binary-searches the ring. One token is generated per
+    // choreographed frame, so this avoids rebalancing a tree at frame rate.
+    std::deque<std::pair<int64_t /* token */, TimelineItem>> mPredictions GUARDED_BY(mMutex);
     int64_t mCurrentToken GUARDED_BY(mMutex);
     mutable std::mutex mMutex;
     static constexpr size_t kMaxTokens = 500;
@@ -528,6 +547,7 @@ private:
     std::shared_ptr<DisplayFrame> mCurrentDisplayFrame GUARDED_BY(mMutex);
     TokenManager mTokenManager;
     TraceCookieCounter mTraceCookieCounter;
+    LayerNameInterner mNameInterner;
     mutable std::mutex mMutex;
     const bool mUseBootTimeClock;
     const bool mFilterFramesBeforeTraceStarts;
@@ -118,6 +118,17 @@ void LayerHierarchy::sortChildrenByZOrder() {
     std::sort(mChildren.begin(), mChildren.end(), layerZCompare);
 }
 
+void LayerHierarchy::repositionChildByZOrder(LayerHierarchy* child) {
+    auto it = std::find_if(mChildren.begin(), mChildren.end(),
+                           [child](const std::pair<LayerHierarchy*, Variant>& x) {
+                               return x.first == child;
+                           });
+    LLOG_ALWAYS_FATAL_WITH_TRACE_IF(it == mChildren.end(), "Could not find child!");
+    auto entry = *it;
+    mChildren.erase(it);
+    insertSorted(mChildren, std::move(entry));
+}
+
 void LayerHierarchy::updateChild(LayerHierarchy* hierarchy, LayerHierarchy::Variant variant) {
     auto it = std::find_if(mChildren.begin(), mChildren.end(),
                            [hierarchy](std::pair<LayerHierarchy*, Variant>& child) {
@@ -393,9 +404,11 @@ void LayerHierarchyBuilder::doUpdate(
             attachToRelativeParent(hierarchy);
         }
         if (layer->changes.test(RequestedLayerState::Changes::Z)) {
-            hierarchy->mParent->sortChildrenByZOrder();
+            // The sibling lists are maintained in sorted order, so move only the
+            // changed layer instead of re-sorting each list from scratch.
+            hierarchy->mParent->repositionChildByZOrder(hierarchy);
             if (hierarchy->mRelativeParent) {
-                hierarchy->mRelativeParent->sortChildrenByZOrder();
+                hierarchy->mRelativeParent->repositionChildByZOrder(hierarchy);
             }
         }
         if (layer->changes.test(RequestedLayerState::Changes::Mirror)) {
@@ -188,6 +188,10 @@ private:
     void addChild(LayerHierarchy*, LayerHierarchy::Variant);
     void removeChild(LayerHierarchy*);
     void sortChildrenByZOrder();
+    // Moves a single child whose z (or layer stack) changed back to its sorted
+    // position. The siblings are kept sorted on insertion, so this avoids a full
+    // re-sort of the child list for the common case of one layer animating its z.
+    void repositionChildByZOrder(LayerHierarchy* child);
     void updateChild(LayerHierarchy*, LayerHierarchy::Variant);
     void traverseInZOrder(const Visitor& visitor, LayerHierarchy::TraversalPath& parent) const;
     void traverse(const Visitor& visitor, LayerHierarchy::TraversalPath& parent,
@@ -91,7 +91,7 @@ void LayerLifecycleManager::addLayers(std::vector<std::unique_ptr<RequestedLayer
 void LayerLifecycleManager::onHandlesDestroyed(
         const std::vector<std::pair<uint32_t, std::string /* debugName */>>& destroyedHandles,
         bool ignoreUnknownHandles) {
-    std::vector<uint32_t> layersToBeDestroyed;
+    ftl::SmallVector<uint32_t, 8> layersToBeDestroyed;
     for (const auto& [layerId, name] : destroyedHandles) {
         auto it = mIdToLayer.find(layerId);
         if (it == mIdToLayer.end()) {
@@ -282,6 +282,22 @@ void LayerLifecycleManager::applyTransactions(const std::vector<TransactionState
     }
 }
 
+bool LayerLifecycleManager::advanceAnimations(nsecs_t now) {
+    bool anyActive = false;
+    for (auto& layer : mLayers) {
+        if (!layer->hasActiveAnimation()) {
+            continue;
+        }
+        if (layer->changes.get() == 0) {
+            mChangedLayers.push_back(layer.get());
+        }
+        layer->advanceAnimation(now);
+        mGlobalChanges |= layer->changes;
+        anyActive |= layer->hasActiveAnimation();
+    }
+    return anyActive;
+}
+
 void LayerLifecycleManager::commitChanges() {
     for (auto layer : mAddedLayers) {
         for (auto& listener : mListeners) {
@@ -351,7 +367,7 @@ RequestedLayerState* LayerLifecycleManager::getLayerFromId(uint32_t id) {
     return &it->second.owner;
 }
 
-std::vector<uint32_t>* LayerLifecycleManager::getLinkedLayersFromId(uint32_t id) {
+ftl::SmallVector<uint32_t, 2>* LayerLifecycleManager::getLinkedLayersFromId(uint32_t id) {
     if (id == UNASSIGNED_LAYER_ID) {
         return nullptr;
     }
@@ -367,7 +383,7 @@ uint32_t LayerLifecycleManager::linkLayer(uint32_t layerId, uint32_t layerToLink
         return UNASSIGNED_LAYER_ID;
     }
 
-    std::vector<uint32_t>* linkedLayers = getLinkedLayersFromId(layerId);
+    ftl::SmallVector<uint32_t, 2>* linkedLayers = getLinkedLayersFromId(layerId);
     if (!linkedLayers) {
         ALOGV("Could not find layer id %d to link %d. Parent is probably destroyed", layerId,
               layerToLink);
@@ -378,7 +394,7 @@ uint32_t LayerLifecycleManager::linkLayer(uint32_t layerId, uint32_t layerToLink
 }
 
 uint32_t LayerLifecycleManager::unlinkLayer(uint32_t layerId, uint32_t linkedLayer) {
-    std::vector<uint32_t>* linkedLayers = getLinkedLayersFromId(layerId);
+    ftl::SmallVector<uint32_t, 2>* linkedLayers = getLinkedLayersFromId(layerId);
     if (!linkedLayers) {
         return UNASSIGNED_LAYER_ID;
     }
@@ -386,8 +402,8 @@ uint32_t LayerLifecycleManager::unlinkLayer(uint32_t layerId, uint32_t linkedLay
     return UNASSIGNED_LAYER_ID;
 }
 
-std::vector<uint32_t> LayerLifecycleManager::unlinkLayers(const std::vector<uint32_t>& layerIds,
-                                                          uint32_t linkedLayer) {
+ftl::SmallVector<uint32_t, 1> LayerLifecycleManager::unlinkLayers(
+        const ftl::SmallVector<uint32_t, 1>& layerIds, uint32_t linkedLayer) {
     for (uint32_t layerId : layerIds) {
         unlinkLayer(layerId, linkedLayer);
     }
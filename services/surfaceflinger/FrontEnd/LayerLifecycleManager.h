@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <ftl/small_vector.h>
+
 #include "RequestedLayerState.h"
 #include "TransactionState.h"
 
@@ -50,6 +52,12 @@ public:
     void onHandlesDestroyed(const std::vector<std::pair<uint32_t, std::string /* debugName */>>&,
                             bool ignoreUnknownHandles = false);
 
+    // Advances compositor-side animations (LayerAnimationSpec) to the given
+    // frame time, marking the affected layers changed as if a client
+    // transaction had updated them. Returns true while any animation still has
+    // frames to produce, so the caller can schedule another commit.
+    bool advanceAnimations(nsecs_t now);
+
     // Detaches the layer from its relative parent to prevent a loop in the
     // layer hierarchy. This overrides the RequestedLayerState and leaves
     // the system in an invalid state. This is always a client error that
@@ -88,17 +96,20 @@ private:
     friend class android::SurfaceFlinger;
 
     RequestedLayerState* getLayerFromId(uint32_t);
-    std::vector<uint32_t>* getLinkedLayersFromId(uint32_t);
+    ftl::SmallVector<uint32_t, 2>* getLinkedLayersFromId(uint32_t);
     uint32_t linkLayer(uint32_t layerId, uint32_t layerToLink);
     uint32_t unlinkLayer(uint32_t layerId, uint32_t linkedLayer);
-    std::vector<uint32_t> unlinkLayers(const std::vector<uint32_t>& layerIds, uint32_t linkedLayer);
+    ftl::SmallVector<uint32_t, 1> unlinkLayers(const ftl::SmallVector<uint32_t, 1>& layerIds,
+                                               uint32_t linkedLayer);
 
     void updateDisplayMirrorLayers(RequestedLayerState& rootLayer);
 
     struct References {
         // Lifetime tied to mLayers
         RequestedLayerState& owner;
-        std::vector<uint32_t> references;
+        // Most layers are referenced by at most a parent and a relative parent, so keep
+        // that many entries inline to avoid a heap allocation per link.
+        ftl::SmallVector<uint32_t, 2> references;
         std::string getDebugString() const;
     };
     std::unordered_map<uint32_t, References> mIdToLayer;
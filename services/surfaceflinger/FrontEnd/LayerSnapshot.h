@@ -55,6 +55,10 @@ struct LayerSnapshot : public compositionengine::LayerFECompositionState {
     bool isHiddenByPolicyFromRelativeParent = false;
     ftl::Flags<RequestedLayerState::Changes> changes;
     uint64_t clientChanges = 0;
+    // Incremented every time the geometry of this snapshot (bounds, crops, transform) is
+    // recomputed. Content-only updates such as alpha or color fades leave it untouched, so
+    // consumers can cheaply distinguish geometry updates from content updates.
+    uint32_t geometryGeneration = 0;
     // Some consumers of this snapshot (input, layer traces) rely on each snapshot to be unique.
     // For mirrored layers, snapshots will have the same sequence so this unique id provides
     // an alternative identifier when needed.
@@ -417,6 +417,7 @@ bool LayerSnapshotBuilder::tryFastUpdate(const Args& args) {
 
 void LayerSnapshotBuilder::updateSnapshots(const Args& args) {
     SFTRACE_NAME("UpdateSnapshots");
+    mPrimaryDisplayRotationFlags = getPrimaryDisplayRotationFlags(args.displays);
     LayerSnapshot rootSnapshot = args.rootSnapshot;
     if (args.parentCrop) {
         rootSnapshot.geomLayerBounds = *args.parentCrop;
@@ -433,9 +434,12 @@ void LayerSnapshotBuilder::updateSnapshots(const Args& args) {
         rootSnapshot.clientChanges |= layer_state_t::eReparent;
     }
 
-    for (auto& snapshot : mSnapshots) {
-        if (snapshot->reachablilty == LayerSnapshot::Reachablilty::Reachable) {
-            snapshot->reachablilty = LayerSnapshot::Reachablilty::Unreachable;
+    prepareSubtreePruning(args);
+    if (!mPruneUnchangedSubtrees) {
+        for (auto& snapshot : mSnapshots) {
+            if (snapshot->reachablilty == LayerSnapshot::Reachablilty::Reachable) {
+                snapshot->reachablilty = LayerSnapshot::Reachablilty::Unreachable;
+            }
         }
     }
 
@@ -503,6 +507,70 @@ void LayerSnapshotBuilder::updateSnapshots(const Args& args) {
     }
 }
 
+void LayerSnapshotBuilder::prepareSubtreePruning(const Args& args) {
+    mChangedSubtreeRoots.clear();
+    // Pruning must be off whenever reachability, z-order or layer lifetimes
+    // can change, since those passes consult snapshots that a pruned walk
+    // would not have visited.
+    mPruneUnchangedSubtrees = args.forceUpdate == ForceUpdateFlags::NONE && !args.displayChanges &&
+            !mResortSnapshots && !args.parentCrop.has_value() &&
+            args.layerLifecycleManager.getDestroyedLayers().empty() &&
+            !args.layerLifecycleManager.getGlobalChanges().any(
+                    RequestedLayerState::Changes::Created | RequestedLayerState::Changes::Destroyed |
+                    RequestedLayerState::Changes::Hierarchy | RequestedLayerState::Changes::Mirror |
+                    RequestedLayerState::Changes::Parent |
+                    RequestedLayerState::Changes::RelativeParent |
+                    RequestedLayerState::Changes::Visibility | RequestedLayerState::Changes::Input |
+                    RequestedLayerState::Changes::Z);
+    if (!mPruneUnchangedSubtrees) {
+        return;
+    }
+
+    // Mark every changed layer and all of its ancestors, walking both real and
+    // relative parent links since a layer is traversed under each of them.
+    auto markAncestors = [&](uint32_t layerId) {
+        std::vector<uint32_t> pending{layerId};
+        while (!pending.empty()) {
+            uint32_t id = pending.back();
+            pending.pop_back();
+            if (id == UNASSIGNED_LAYER_ID || !mChangedSubtreeRoots.insert(id).second) {
+                continue;
+            }
+            const RequestedLayerState* layer = args.layerLifecycleManager.getLayerFromId(id);
+            if (layer == nullptr) {
+                continue;
+            }
+            pending.push_back(layer->parentId);
+            pending.push_back(layer->relativeParentId);
+        }
+    };
+    for (const RequestedLayerState* layer : args.layerLifecycleManager.getChangedLayers()) {
+        markAncestors(layer->id);
+    }
+
+    // A layer that mirrors a dirty layer picks up the changes even though it is
+    // not on any parent chain. Iterate until no new subtree roots appear so
+    // chained mirrors settle.
+    bool updated = true;
+    while (updated) {
+        updated = false;
+        for (auto& layer : args.layerLifecycleManager.getLayers()) {
+            if (mChangedSubtreeRoots.count(layer->id) != 0) {
+                continue;
+            }
+            bool mirrorsDirtyLayer = layer->layerIdToMirror != UNASSIGNED_LAYER_ID &&
+                    mChangedSubtreeRoots.count(layer->layerIdToMirror) != 0;
+            for (uint32_t mirrorId : layer->mirrorIds) {
+                mirrorsDirtyLayer |= mChangedSubtreeRoots.count(mirrorId) != 0;
+            }
+            if (mirrorsDirtyLayer) {
+                markAncestors(layer->id);
+                updated = true;
+            }
+        }
+    }
+}
+
 void LayerSnapshotBuilder::update(const Args& args) {
     for (auto& snapshot : mSnapshots) {
         clearChanges(*snapshot);
@@ -524,12 +592,20 @@ const LayerSnapshot& LayerSnapshotBuilder::updateSnapshotsInHierarchy(
 
     const RequestedLayerState* layer = hierarchy.getLayer();
     LayerSnapshot* snapshot = getSnapshot(traversalPath);
+    if (mPruneUnchangedSubtrees && snapshot != nullptr && parentSnapshot.changes.get() == 0 &&
+        parentSnapshot.clientChanges == 0 &&
+        mChangedSubtreeRoots.find(traversalPath.id) == mChangedSubtreeRoots.end()) {
+        // Nothing changed in this layer or anywhere below it, and the parent
+        // has nothing to propagate: every snapshot in the subtree is still
+        // valid, so the walk costs O(depth) instead of O(n) for sparse
+        // updates.
+        return *snapshot;
+    }
     const bool newSnapshot = snapshot == nullptr;
-    uint32_t primaryDisplayRotationFlags = getPrimaryDisplayRotationFlags(args.displays);
     if (newSnapshot) {
         snapshot = createSnapshot(traversalPath, *layer, parentSnapshot);
         snapshot->merge(*layer, /*forceUpdate=*/true, /*displayChanges=*/true, args.forceFullDamage,
-                        primaryDisplayRotationFlags);
+                        mPrimaryDisplayRotationFlags);
         snapshot->changes |= RequestedLayerState::Changes::Created;
     }
 
@@ -911,29 +987,30 @@ void LayerSnapshotBuilder::updateSnapshot(LayerSnapshot& snapshot, const Args& a
         }
     }
 
-    if (forceUpdate || snapshot.changes.any(RequestedLayerState::Changes::Geometry)) {
-        uint32_t primaryDisplayRotationFlags = getPrimaryDisplayRotationFlags(args.displays);
-        updateLayerBounds(snapshot, requested, parentSnapshot, primaryDisplayRotationFlags);
+    const bool geometryChanged =
+            forceUpdate || snapshot.changes.any(RequestedLayerState::Changes::Geometry);
+    if (geometryChanged) {
+        updateLayerBounds(snapshot, requested, parentSnapshot, mPrimaryDisplayRotationFlags);
+        snapshot.geometryGeneration++;
     }
 
-    if (snapshot.edgeExtensionEffect.hasEffect()) {
+    // The extended bounds are derived purely from the geometry computed above, so only redo
+    // the rect math when that geometry was recomputed. Content-only updates such as alpha
+    // fades, which dominate animation frames, keep the memoized bounds.
+    if (snapshot.edgeExtensionEffect.hasEffect() && geometryChanged) {
         updateBoundsForEdgeExtension(snapshot);
     }
 
-    if (forceUpdate || snapshot.clientChanges & layer_state_t::eCornerRadiusChanged ||
-        snapshot.changes.any(RequestedLayerState::Changes::Geometry |
-                             RequestedLayerState::Changes::BufferUsageFlags)) {
+    if (geometryChanged || snapshot.clientChanges & layer_state_t::eCornerRadiusChanged ||
+        snapshot.changes.any(RequestedLayerState::Changes::BufferUsageFlags)) {
         updateRoundedCorner(snapshot, requested, parentSnapshot, args);
     }
 
-    if (forceUpdate || snapshot.clientChanges & layer_state_t::eShadowRadiusChanged ||
-        snapshot.changes.any(RequestedLayerState::Changes::Geometry)) {
+    if (geometryChanged || snapshot.clientChanges & layer_state_t::eShadowRadiusChanged) {
         updateShadows(snapshot, requested, args.globalShadowSettings);
     }
 
-    if (forceUpdate ||
-        snapshot.changes.any(RequestedLayerState::Changes::Geometry |
-                             RequestedLayerState::Changes::Input)) {
+    if (geometryChanged || snapshot.changes.any(RequestedLayerState::Changes::Input)) {
         updateInput(snapshot, requested, parentSnapshot, path, args);
     }
 
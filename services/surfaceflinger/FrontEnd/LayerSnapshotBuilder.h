@@ -137,6 +137,9 @@ private:
                                           const RequestedLayerState& requestedCHildState,
                                           const Args& args, bool* outChildHasValidFrameRate);
     void updateTouchableRegionCrop(const Args& args);
+    // Decides whether this update can skip subtrees with no pending changes
+    // and, if so, collects the layers that have changes somewhere below them.
+    void prepareSubtreePruning(const Args& args);
 
     std::unordered_map<LayerHierarchy::TraversalPath, LayerSnapshot*,
                        LayerHierarchy::TraversalPathHash>
@@ -149,6 +152,16 @@ private:
     std::vector<std::unique_ptr<LayerSnapshot>> mSnapshots;
     bool mResortSnapshots = false;
     int mNumInterestingSnapshots = 0;
+    // When set, updateSnapshotsInHierarchy() skips subtrees whose layers have
+    // no pending changes; see prepareSubtreePruning().
+    bool mPruneUnchangedSubtrees = false;
+    // Layers with changes on themselves or somewhere in their subtree for the
+    // current update. Only valid while mPruneUnchangedSubtrees is set.
+    std::unordered_set<uint32_t> mChangedSubtreeRoots;
+    // The primary display's rotation flags, captured once at the start of the
+    // update pass. Mirrors multiply the snapshot count, so per snapshot work
+    // like rescanning the display list shows up on mirrored displays.
+    uint32_t mPrimaryDisplayRotationFlags = 0;
 };
 
 } // namespace android::surfaceflinger::frontend
@@ -24,6 +24,9 @@
 #include <private/android_filesystem_config.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <scheduler/Fps.h>
 
 #include "Layer.h"
@@ -36,7 +39,7 @@ using ftl::Flags;
 using namespace ftl::flag_operators;
 
 namespace {
-std::string layerIdsToString(const std::vector<uint32_t>& layerIds) {
+std::string layerIdsToString(const ftl::SmallVector<uint32_t, 1>& layerIds) {
     std::stringstream stream;
     stream << "{";
     for (auto layerId : layerIds) {
@@ -146,6 +149,13 @@ RequestedLayerState::RequestedLayerState(const LayerCreationArgs& args)
 }
 
 void RequestedLayerState::merge(const ResolvedComposerState& resolvedComposerState) {
+    if (resolvedComposerState.state.what == layer_state_t::eBufferChanged) {
+        // Dedicated lane for the dominant transaction type in production:
+        // a new buffer with nothing else attached. Skips the full
+        // layer_state_t diff/merge field walk.
+        mergeBufferOnly(resolvedComposerState);
+        return;
+    }
     const uint32_t oldFlags = flags;
     const half oldAlpha = color.a;
     const bool hadBuffer = externalTexture != nullptr;
@@ -348,6 +358,81 @@ void RequestedLayerState::merge(const ResolvedComposerState& resolvedComposerSta
         requestedFrameRate.category = category;
         changes |= RequestedLayerState::Changes::FrameRate;
     }
+    if (clientState.what & layer_state_t::eAnimationChanged) {
+        // Restart interpolation with the new spec. The first advanceAnimation
+        // call resolves an unset start time.
+        animationStartTime = animationSpec.startTimeNanos;
+        changes |= RequestedLayerState::Changes::Animation;
+    }
+}
+
+void RequestedLayerState::mergeBufferOnly(const ResolvedComposerState& resolvedComposerState) {
+    const layer_state_t& clientState = resolvedComposerState.state;
+    const bool hadBuffer = externalTexture != nullptr;
+    const uint64_t oldFramenumber = hadBuffer ? bufferData->frameNumber : 0;
+    const ui::Size oldBufferSize = hadBuffer
+            ? ui::Size(externalTexture->getWidth(), externalTexture->getHeight())
+            : ui::Size();
+    const uint64_t oldUsageFlags = hadBuffer ? externalTexture->getUsage() : 0;
+    const bool oldBufferFormatOpaque = LayerSnapshot::isOpaqueFormat(
+            externalTexture ? externalTexture->getPixelFormat() : PIXEL_FORMAT_NONE);
+
+    what |= layer_state_t::eBufferChanged;
+    bufferData = clientState.bufferData;
+    externalTexture = resolvedComposerState.externalTexture;
+    // eBufferChanged is part of CONTENT_CHANGES and nothing else.
+    changes |= RequestedLayerState::Changes::Content;
+
+    const bool hasBuffer = externalTexture != nullptr;
+    if (hasBuffer || hasBuffer != hadBuffer) {
+        changes |= RequestedLayerState::Changes::Buffer;
+        const ui::Size newBufferSize = hasBuffer
+                ? ui::Size(externalTexture->getWidth(), externalTexture->getHeight())
+                : ui::Size();
+        if (oldBufferSize != newBufferSize) {
+            changes |= RequestedLayerState::Changes::BufferSize;
+            changes |= RequestedLayerState::Changes::Geometry;
+        }
+        const uint64_t usageFlags = hasBuffer ? externalTexture->getUsage() : 0;
+        if (oldUsageFlags != usageFlags) {
+            changes |= RequestedLayerState::Changes::BufferUsageFlags;
+        }
+    }
+
+    if (hasBuffer != hadBuffer) {
+        changes |= RequestedLayerState::Changes::Geometry |
+                RequestedLayerState::Changes::VisibleRegion |
+                RequestedLayerState::Changes::Visibility | RequestedLayerState::Changes::Input;
+    }
+
+    if (hasBuffer) {
+        const bool frameNumberChanged =
+                bufferData->flags.test(BufferData::BufferDataChange::frameNumberChanged);
+        const uint64_t frameNumber =
+                frameNumberChanged ? bufferData->frameNumber : oldFramenumber + 1;
+        bufferData->frameNumber = frameNumber;
+
+        if ((barrierProducerId > bufferData->producerId) ||
+            ((barrierProducerId == bufferData->producerId) &&
+             (barrierFrameNumber > bufferData->frameNumber))) {
+            ALOGE("Out of order buffers detected for %s producedId=%d frameNumber=%" PRIu64
+                  " -> producedId=%d frameNumber=%" PRIu64,
+                  getDebugString().c_str(), barrierProducerId, barrierFrameNumber,
+                  bufferData->producerId, frameNumber);
+            TransactionTraceWriter::getInstance().invoke("out_of_order_buffers_",
+                                                         /*overwrite=*/false);
+        }
+
+        barrierProducerId = std::max(bufferData->producerId, barrierProducerId);
+        barrierFrameNumber = std::max(bufferData->frameNumber, barrierFrameNumber);
+    }
+
+    const bool newBufferFormatOpaque = LayerSnapshot::isOpaqueFormat(
+            externalTexture ? externalTexture->getPixelFormat() : PIXEL_FORMAT_NONE);
+    if (newBufferFormatOpaque != oldBufferFormatOpaque) {
+        changes |= RequestedLayerState::Changes::Visibility |
+                RequestedLayerState::Changes::VisibleRegion;
+    }
 }
 
 ui::Size RequestedLayerState::getUnrotatedBufferSize(uint32_t displayRotationFlags) const {
@@ -661,4 +746,71 @@ void RequestedLayerState::clearChanges() {
     changes.clear();
 }
 
+bool RequestedLayerState::hasActiveAnimation() const {
+    return animationSpec.animatesSomething();
+}
+
+void RequestedLayerState::advanceAnimation(nsecs_t now) {
+    if (!hasActiveAnimation()) {
+        return;
+    }
+    if (animationStartTime == 0) {
+        animationStartTime = now;
+    }
+
+    float progress = now <= animationStartTime
+            ? 0.f
+            : std::min(1.f,
+                       static_cast<float>(now - animationStartTime) /
+                               static_cast<float>(animationSpec.durationNanos));
+    if (animationSpec.curve == LayerAnimationSpec::Curve::EaseInOut) {
+        progress = progress * (progress * (3.f - 2.f * progress));
+    }
+    const auto lerp = [progress](float start, float end) {
+        return start + (end - start) * progress;
+    };
+
+    if (animationSpec.animatePosition) {
+        x = lerp(animationSpec.startX, animationSpec.endX);
+        y = lerp(animationSpec.startY, animationSpec.endY);
+        requestedTransform.set(x, y);
+        what |= layer_state_t::ePositionChanged;
+        changes |= RequestedLayerState::Changes::Geometry |
+                RequestedLayerState::Changes::AffectsChildren;
+    }
+    if (animationSpec.animateAlpha) {
+        const float oldAlpha = color.a;
+        color.a = lerp(animationSpec.startAlpha, animationSpec.endAlpha);
+        what |= layer_state_t::eAlphaChanged;
+        changes |= RequestedLayerState::Changes::Content |
+                RequestedLayerState::Changes::AffectsChildren;
+        if (oldAlpha == 0 || color.a == 0) {
+            changes |= RequestedLayerState::Changes::Visibility;
+        }
+    }
+    if (animationSpec.animateCrop) {
+        const auto lerpEdge = [&lerp](int32_t start, int32_t end) {
+            return static_cast<int32_t>(
+                    std::lround(lerp(static_cast<float>(start), static_cast<float>(end))));
+        };
+        crop = Rect(lerpEdge(animationSpec.startCrop.left, animationSpec.endCrop.left),
+                    lerpEdge(animationSpec.startCrop.top, animationSpec.endCrop.top),
+                    lerpEdge(animationSpec.startCrop.right, animationSpec.endCrop.right),
+                    lerpEdge(animationSpec.startCrop.bottom, animationSpec.endCrop.bottom));
+        what |= layer_state_t::eCropChanged;
+        changes |= RequestedLayerState::Changes::Geometry |
+                RequestedLayerState::Changes::AffectsChildren;
+    }
+
+    changes |= RequestedLayerState::Changes::Animation | RequestedLayerState::Changes::Content |
+            RequestedLayerState::Changes::VisibleRegion;
+
+    if (progress >= 1.f) {
+        // The end state has been applied; the layer now behaves as if the
+        // client had sent a final transaction with these values.
+        animationSpec = LayerAnimationSpec();
+        animationStartTime = 0;
+    }
+}
+
 } // namespace android::surfaceflinger::frontend
@@ -18,6 +18,7 @@
 
 #include <aidl/android/hardware/graphics/composer3/Composition.h>
 #include <ftl/flags.h>
+#include <ftl/small_vector.h>
 #include <gui/LayerState.h>
 #include <renderengine/ExternalTexture.h>
 #include "Scheduler/LayerInfo.h"
@@ -69,6 +70,9 @@ struct RequestedLayerState : layer_state_t {
     static Rect reduce(const Rect& win, const Region& exclude);
     RequestedLayerState(const LayerCreationArgs&);
     void merge(const ResolvedComposerState&);
+    // Fast lane taken by merge() for buffer-only client states; updates the
+    // buffer fields and change flags without the full layer_state_t diff.
+    void mergeBufferOnly(const ResolvedComposerState&);
     void clearChanges();
 
     // Currently we only care about the primary display
@@ -97,6 +101,14 @@ struct RequestedLayerState : layer_state_t {
     bool isSimpleBufferUpdate(const layer_state_t&) const;
     bool isProtected() const;
     bool hasSomethingToDraw() const;
+    // True while a client supplied LayerAnimationSpec still has frames to
+    // produce. Active animations are advanced by the LayerLifecycleManager at
+    // the start of every commit without further client IPC.
+    bool hasActiveAnimation() const;
+    // Interpolates the animated properties for the given frame time, setting
+    // the same what/changes bits a client transaction would. Clears the spec
+    // once the end state has been applied.
+    void advanceAnimation(nsecs_t now);
 
     // Layer serial number.  This gives layers an explicit ordering, so we
     // have a stable sort order when their layer stack and Z-order are
@@ -132,11 +144,15 @@ struct RequestedLayerState : layer_state_t {
     uint64_t barrierFrameNumber = 0;
     uint32_t barrierProducerId = 0;
     std::string debugName;
+    // Resolved start time of the current animation spec. 0 until the first
+    // frame the animation is advanced when the spec has no explicit start.
+    nsecs_t animationStartTime = 0;
 
     // book keeping states
     bool handleAlive = true;
     bool isRelativeOf = false;
-    std::vector<uint32_t> mirrorIds{};
+    // Inline storage covers the common case of mirroring at most one layer.
+    ftl::SmallVector<uint32_t, 1> mirrorIds;
     ftl::Flags<RequestedLayerState::Changes> changes;
     bool bgColorLayer = false;
 };
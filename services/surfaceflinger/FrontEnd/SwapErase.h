@@ -18,6 +18,8 @@
 
 #include <vector>
 
+#include <ftl/small_vector.h>
+
 namespace android::surfaceflinger::frontend {
 // Erases the first element in vec that matches value. This is a more optimal way to
 // remove an element from a vector that avoids relocating all the elements after the one
@@ -34,6 +36,17 @@ bool swapErase(std::vector<T>& vec, const T& value) {
     return found;
 }
 
+// Overload for ftl::SmallVector, whose unstable_erase already has swap-erase semantics.
+template <typename T, std::size_t N>
+bool swapErase(ftl::SmallVector<T, N>& vec, const T& value) {
+    auto it = std::find(vec.begin(), vec.end(), value);
+    if (it == vec.end()) {
+        return false;
+    }
+    vec.unstable_erase(it);
+    return true;
+}
+
 // Similar to swapErase(std::vector<T>& vec, const T& value) but erases the first element
 // that returns true for predicate.
 template <typename T, class P>
@@ -21,6 +21,7 @@
 
 #include <common/trace.h>
 #include <cutils/trace.h>
+#include <gui/ISurfaceComposer.h>
 #include <utils/Log.h>
 #include "FrontEnd/LayerLog.h"
 
@@ -61,12 +62,15 @@ std::vector<TransactionState> TransactionHandler::flushTransactions() {
     // where the number of transactionsPendingBarrier doesn't change. This way
     // we can continue to resolve dependency chains of barriers as far as possible.
     int lastTransactionsPendingBarrier = 0;
-    int transactionsPendingBarrier = 0;
-    do {
+    // Collect transactions that are ready to be applied.
+    int transactionsPendingBarrier = flushPendingTransactionQueues(transactions, flushState);
+    // Only transactions latched during this flush can satisfy a barrier, so the follow-up
+    // passes revisit just the queues whose head was blocked on one; the remaining queues
+    // cannot change their answer and need not be rescanned.
+    while (lastTransactionsPendingBarrier != transactionsPendingBarrier) {
         lastTransactionsPendingBarrier = transactionsPendingBarrier;
-        // Collect transactions that are ready to be applied.
-        transactionsPendingBarrier = flushPendingTransactionQueues(transactions, flushState);
-    } while (lastTransactionsPendingBarrier != transactionsPendingBarrier);
+        transactionsPendingBarrier = flushQueuesPendingBarrier(transactions, flushState);
+    }
 
     applyUnsignaledBufferTransaction(transactions, flushState);
 
@@ -146,35 +150,79 @@ TransactionHandler::TransactionReadiness TransactionHandler::applyFilters(
     return ready;
 }
 
+TransactionHandler::TransactionReadiness TransactionHandler::flushPendingTransactionQueue(
+        std::vector<TransactionState>& transactions, TransactionFlushState& flushState,
+        std::queue<TransactionState>& queue) {
+    while (!queue.empty()) {
+        auto& transaction = queue.front();
+        flushState.transaction = &transaction;
+        auto ready = applyFilters(flushState);
+        if (ready == TransactionReadiness::NotReadyUnsignaled) {
+            // We maybe able to latch this transaction if it's the only transaction
+            // ready to be applied.
+            flushState.queueWithUnsignaledBuffer = transaction.applyToken;
+        }
+        if (ready != TransactionReadiness::Ready) {
+            return ready;
+        }
+        popTransactionFromPending(transactions, flushState, queue);
+    }
+    return TransactionReadiness::Ready;
+}
+
 int TransactionHandler::flushPendingTransactionQueues(std::vector<TransactionState>& transactions,
                                                       TransactionFlushState& flushState) {
     int transactionsPendingBarrier = 0;
-    auto it = mPendingTransactionQueues.begin();
-    while (it != mPendingTransactionQueues.end()) {
-        auto& [applyToken, queue] = *it;
-        while (!queue.empty()) {
-            auto& transaction = queue.front();
-            flushState.transaction = &transaction;
-            auto ready = applyFilters(flushState);
-            if (ready == TransactionReadiness::NotReadyBarrier) {
+    mApplyTokensPendingBarrier.clear();
+    // Queues whose head transaction is marked urgent are flushed first. Ordering within an
+    // apply token is unchanged, but latency-critical transactions get the first chance to
+    // latch, including the single unsignaled-buffer allowance, instead of depending on the
+    // map's iteration order when the queues are contended.
+    for (const bool urgentPass : {true, false}) {
+        auto it = mPendingTransactionQueues.begin();
+        while (it != mPendingTransactionQueues.end()) {
+            auto& [applyToken, queue] = *it;
+            const bool urgent = !queue.empty() &&
+                    (queue.front().flags & ISurfaceComposer::eUrgent) != 0;
+            if (urgent != urgentPass) {
+                it = std::next(it, 1);
+                continue;
+            }
+            if (flushPendingTransactionQueue(transactions, flushState, queue) ==
+                TransactionReadiness::NotReadyBarrier) {
                 transactionsPendingBarrier++;
-                break;
-            } else if (ready == TransactionReadiness::NotReady) {
-                break;
-            } else if (ready == TransactionReadiness::NotReadyUnsignaled) {
-                // We maybe able to latch this transaction if it's the only transaction
-                // ready to be applied.
-                flushState.queueWithUnsignaledBuffer = applyToken;
-                break;
+                mApplyTokensPendingBarrier.emplace_back(applyToken);
+            }
+
+            if (queue.empty()) {
+                it = mPendingTransactionQueues.erase(it);
+            } else {
+                it = std::next(it, 1);
             }
-            // ready == TransactionReadiness::Ready
-            popTransactionFromPending(transactions, flushState, queue);
+        }
+    }
+    return transactionsPendingBarrier;
+}
+
+int TransactionHandler::flushQueuesPendingBarrier(std::vector<TransactionState>& transactions,
+                                                  TransactionFlushState& flushState) {
+    int transactionsPendingBarrier = 0;
+    std::vector<sp<IBinder>> applyTokens = std::move(mApplyTokensPendingBarrier);
+    mApplyTokensPendingBarrier.clear();
+    for (auto& applyToken : applyTokens) {
+        auto it = mPendingTransactionQueues.find(applyToken);
+        if (it == mPendingTransactionQueues.end()) {
+            continue;
+        }
+        auto& queue = it->second;
+        if (flushPendingTransactionQueue(transactions, flushState, queue) ==
+            TransactionReadiness::NotReadyBarrier) {
+            transactionsPendingBarrier++;
+            mApplyTokensPendingBarrier.emplace_back(applyToken);
         }
 
         if (queue.empty()) {
-            it = mPendingTransactionQueues.erase(it);
-        } else {
-            it = std::next(it, 1);
+            mPendingTransactionQueues.erase(it);
         }
     }
     return transactionsPendingBarrier;
@@ -82,12 +82,20 @@ private:
     friend class ::android::TestableSurfaceFlinger;
 
     int flushPendingTransactionQueues(std::vector<TransactionState>&, TransactionFlushState&);
+    int flushQueuesPendingBarrier(std::vector<TransactionState>&, TransactionFlushState&);
+    TransactionReadiness flushPendingTransactionQueue(std::vector<TransactionState>&,
+                                                      TransactionFlushState&,
+                                                      std::queue<TransactionState>&);
     void applyUnsignaledBufferTransaction(std::vector<TransactionState>&, TransactionFlushState&);
     void popTransactionFromPending(std::vector<TransactionState>&, TransactionFlushState&,
                                    std::queue<TransactionState>&);
     TransactionReadiness applyFilters(TransactionFlushState&);
     std::unordered_map<sp<IBinder>, std::queue<TransactionState>, IListenerHash>
             mPendingTransactionQueues;
+    // Apply tokens whose queue head was blocked on a barrier during the last flush pass. Only
+    // these queues can become ready as a result of transactions latched later in the same
+    // flush, so subsequent passes revisit just them instead of rescanning every pending queue.
+    std::vector<sp<IBinder>> mApplyTokensPendingBarrier;
     LocklessQueue<TransactionState> mLocklessTransactionQueue;
     std::atomic<size_t> mPendingTransactionCount = 0;
     ftl::SmallVector<TransactionFilter, 2> mTransactionReadyFilters;
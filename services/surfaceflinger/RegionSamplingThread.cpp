@@ -36,6 +36,7 @@
 #include <renderengine/impl/ExternalTexture.h>
 #include <ui/DisplayStatInfo.h>
 
+#include <cmath>
 #include <string>
 
 #include "DisplayDevice.h"
@@ -64,6 +65,11 @@ constexpr auto defaultRegionSamplingWorkDuration = 3ms;
 constexpr auto defaultRegionSamplingPeriod = 100ms;
 constexpr auto defaultRegionSamplingTimerTimeout = 100ms;
 constexpr auto maxRegionSamplingDelay = 100ms;
+// Scale factor between the sampled bounds on screen and the capture buffer.
+// Rendering the capture at reduced resolution pushes the bulk of the pixel
+// reduction onto the GPU, shrinking both the readback over the bus and the
+// CPU luma loop by the square of this factor.
+constexpr int32_t kSampleScale = 8;
 // TODO: (b/127403193) duration to string conversion could probably be constexpr
 template <typename Rep, typename Per>
 inline std::string toNsString(std::chrono::duration<Rep, Per> t) {
@@ -137,6 +143,9 @@ void RegionSamplingThread::addListener(const Rect& samplingArea, uint32_t stopLa
     asBinder->linkToDeath(sp<DeathRecipient>::fromExisting(this));
     std::lock_guard lock(mSamplingMutex);
     mDescriptors.emplace(wp<IBinder>(asBinder), Descriptor{samplingArea, stopLayerId, listener});
+    // Make sure the new listener receives a baseline luma even if its area
+    // never gets damaged.
+    mSampleNeeded = true;
 }
 
 void RegionSamplingThread::removeListener(const sp<IRegionSamplingListener>& listener) {
@@ -154,6 +163,19 @@ void RegionSamplingThread::checkForStaleLuma() {
     }
 }
 
+void RegionSamplingThread::onCommitDamage(const Region& damage) {
+    if (mSampleNeeded.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::lock_guard lock(mSamplingMutex);
+    for (const auto& [listener, descriptor] : mDescriptors) {
+        if (!damage.intersect(descriptor.area).isEmpty()) {
+            mSampleNeeded = true;
+            return;
+        }
+    }
+}
+
 void RegionSamplingThread::onCompositionComplete(
         std::optional<std::chrono::steady_clock::time_point> samplingDeadline) {
     doSample(samplingDeadline);
@@ -161,6 +183,12 @@ void RegionSamplingThread::onCompositionComplete(
 
 void RegionSamplingThread::doSample(
         std::optional<std::chrono::steady_clock::time_point> samplingDeadline) {
+    if (!mSampleNeeded.load(std::memory_order_relaxed)) {
+        // No damage has touched a sampling area since the last sample, so the
+        // luma the listeners hold is still accurate.
+        SFTRACE_INT(lumaSamplingStepTag, static_cast<int>(samplingStep::noWorkNeeded));
+        return;
+    }
     std::lock_guard lock(mThreadControlMutex);
     const auto now = std::chrono::steady_clock::now();
     if (mLastSampleTime + mTunables.mSamplingPeriod > now) {
@@ -185,6 +213,7 @@ void RegionSamplingThread::doSample(
 
     mSampleRequestTime.reset();
     mLastSampleTime = now;
+    mSampleNeeded = false;
 
     mIdleTimer.reset();
 
@@ -226,7 +255,7 @@ float sampleArea(const uint32_t* data, int32_t width, int32_t height, int32_t st
 }
 
 std::vector<float> RegionSamplingThread::sampleBuffer(
-        const sp<GraphicBuffer>& buffer, const Point& leftTop,
+        const sp<GraphicBuffer>& buffer, const Rect& sampledBounds,
         const std::vector<RegionSamplingThread::Descriptor>& descriptors, uint32_t orientation) {
     void* data_raw = nullptr;
     buffer->lock(GRALLOC_USAGE_SW_READ_OFTEN, &data_raw);
@@ -237,11 +266,31 @@ std::vector<float> RegionSamplingThread::sampleBuffer(
     const int32_t width = buffer->getWidth();
     const int32_t height = buffer->getHeight();
     const int32_t stride = buffer->getStride();
+
+    // The capture is rendered at a fraction of the sampled bounds, so map each
+    // descriptor's area into buffer coordinates before walking pixels.
+    const float scaleX = static_cast<float>(width) / sampledBounds.getWidth();
+    const float scaleY = static_cast<float>(height) / sampledBounds.getHeight();
+
     std::vector<float> lumas(descriptors.size());
     std::transform(descriptors.begin(), descriptors.end(), lumas.begin(),
                    [&](auto const& descriptor) {
-                       return sampleArea(data.get(), width, height, stride, orientation,
-                                         descriptor.area - leftTop);
+                       const Rect area = descriptor.area - sampledBounds.leftTop();
+                       Rect scaled(area.left * scaleX, area.top * scaleY,
+                                   std::ceil(area.right * scaleX), std::ceil(area.bottom * scaleY));
+                       if (!scaled.intersect(Rect(width, height), &scaled)) {
+                           scaled = Rect::EMPTY_RECT;
+                       }
+                       // never round a non-empty area down to nothing
+                       if (!area.isEmpty()) {
+                           if (scaled.right <= scaled.left) {
+                               scaled.right = std::min(scaled.left + 1, width);
+                           }
+                           if (scaled.bottom <= scaled.top) {
+                               scaled.bottom = std::min(scaled.top + 1, height);
+                           }
+                       }
+                       return sampleArea(data.get(), width, height, stride, orientation, scaled);
                    });
     return lumas;
 }
@@ -277,6 +326,10 @@ void RegionSamplingThread::captureSample() {
     }
 
     const Rect sampledBounds = sampleRegion.bounds();
+    // Render the capture at a fraction of the sampled bounds; the GPU reduces
+    // the pixels while rasterizing, so only a small buffer crosses the bus.
+    const ui::Size captureSize(std::max(sampledBounds.getWidth() / kSampleScale, 1),
+                               std::max(sampledBounds.getHeight() / kSampleScale, 1));
 
     std::unordered_set<sp<IRegionSamplingListener>, SpHash<IRegionSamplingListener>> listeners;
 
@@ -325,14 +378,14 @@ void RegionSamplingThread::captureSample() {
             mFlinger.getLayerSnapshotsForScreenshots(layerStack, CaptureArgs::UNSET_UID, filterFn);
 
     std::shared_ptr<renderengine::ExternalTexture> buffer = nullptr;
-    if (mCachedBuffer && mCachedBuffer->getBuffer()->getWidth() == sampledBounds.getWidth() &&
-        mCachedBuffer->getBuffer()->getHeight() == sampledBounds.getHeight()) {
+    if (mCachedBuffer && mCachedBuffer->getBuffer()->getWidth() == (uint32_t)captureSize.width &&
+        mCachedBuffer->getBuffer()->getHeight() == (uint32_t)captureSize.height) {
         buffer = mCachedBuffer;
     } else {
         const uint32_t usage =
                 GRALLOC_USAGE_SW_READ_OFTEN | GRALLOC_USAGE_HW_RENDER | GRALLOC_USAGE_HW_TEXTURE;
         sp<GraphicBuffer> graphicBuffer =
-                sp<GraphicBuffer>::make(sampledBounds.getWidth(), sampledBounds.getHeight(),
+                sp<GraphicBuffer>::make(captureSize.width, captureSize.height,
                                         PIXEL_FORMAT_RGBA_8888, 1, usage, "RegionSamplingThread");
         const status_t bufferStatus = graphicBuffer->initCheck();
         LOG_ALWAYS_FATAL_IF(bufferStatus != OK, "captureSample: Buffer failed to allocate: %d",
@@ -350,7 +403,7 @@ void RegionSamplingThread::captureSample() {
 
     SurfaceFlinger::RenderAreaBuilderVariant
             renderAreaBuilder(std::in_place_type<DisplayRenderAreaBuilder>, sampledBounds,
-                              sampledBounds.getSize(), ui::Dataspace::V0_SRGB, displayWeak,
+                              captureSize, ui::Dataspace::V0_SRGB, displayWeak,
                               RenderArea::Options::CAPTURE_SECURE_LAYERS);
 
     FenceResult fenceResult;
@@ -381,8 +434,8 @@ void RegionSamplingThread::captureSample() {
     }
 
     ALOGV("Sampling %zu descriptors", activeDescriptors.size());
-    std::vector<float> lumas = sampleBuffer(buffer->getBuffer(), sampledBounds.leftTop(),
-                                            activeDescriptors, orientation);
+    std::vector<float> lumas =
+            sampleBuffer(buffer->getBuffer(), sampledBounds, activeDescriptors, orientation);
     if (lumas.size() != activeDescriptors.size()) {
         ALOGW("collected %zu median luma values for %zu descriptors", lumas.size(),
               activeDescriptors.size());
@@ -22,8 +22,10 @@
 #include <renderengine/ExternalTexture.h>
 #include <ui/GraphicBuffer.h>
 #include <ui/Rect.h>
+#include <ui/Region.h>
 #include <utils/StrongPointer.h>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
@@ -78,6 +80,12 @@ public:
     // Remove the listener to stop receiving median luma notifications.
     void removeListener(const sp<IRegionSamplingListener>& listener);
 
+    // Notifies sampling engine of the frame damage reported by the front-end
+    // for this commit. Sampling stays parked until damage overlaps a
+    // registered sampling area, so unchanged content never triggers capture
+    // work.
+    void onCommitDamage(const Region& damage);
+
     // Notifies sampling engine that composition is done and new content is
     // available, and the deadline for the sampling work on the main thread to
     // be completed without eating the budget of another frame.
@@ -92,7 +100,7 @@ private:
     };
 
     std::vector<float> sampleBuffer(
-            const sp<GraphicBuffer>& buffer, const Point& leftTop,
+            const sp<GraphicBuffer>& buffer, const Rect& sampledBounds,
             const std::vector<RegionSamplingThread::Descriptor>& descriptors, uint32_t orientation);
 
     void doSample(std::optional<std::chrono::steady_clock::time_point> samplingDeadline);
@@ -116,6 +124,11 @@ private:
             GUARDED_BY(mThreadControlMutex);
     std::chrono::steady_clock::time_point mLastSampleTime GUARDED_BY(mThreadControlMutex);
 
+    // True once damage has touched a sampling area (or a listener was added)
+    // and no sample has been dispatched for it yet. Starts true so the first
+    // listener gets a baseline sample.
+    std::atomic<bool> mSampleNeeded = true;
+
     std::mutex mSamplingMutex;
     std::unordered_map<wp<IBinder>, Descriptor, WpHash> mDescriptors GUARDED_BY(mSamplingMutex);
     std::shared_ptr<renderengine::ExternalTexture> mCachedBuffer GUARDED_BY(mSamplingMutex) =
@@ -23,6 +23,7 @@
 #include <pthread.h>
 #include <sched.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <chrono>
 #include <cstdint>
@@ -36,6 +37,7 @@
 #include <common/trace.h>
 #include <cutils/compiler.h>
 #include <cutils/sched_policy.h>
+#include <ftl/small_map.h>
 
 #include <gui/DisplayEventReceiver.h>
 #include <gui/SchedulingPolicy.h>
@@ -195,7 +197,11 @@ EventThreadConnection::EventThreadConnection(EventThread* eventThread, uid_t cal
       : mOwnerUid(callingUid),
         mEventRegistration(eventRegistration),
         mEventThread(eventThread),
-        mChannel(gui::BitTube::DefaultSize) {}
+        // Consumers in our own process never parcel the channel, so they can use the
+        // in-process tube and skip the kernel socket round trip on every event.
+        mChannel(IPCThreadState::self()->getCallingPid() == getpid()
+                         ? gui::BitTube(gui::BitTube::InProcess)
+                         : gui::BitTube(gui::BitTube::DefaultSize)) {}
 
 EventThreadConnection::~EventThreadConnection() {
     // do nothing here -- clean-up will happen automatically
@@ -213,8 +219,7 @@ binder::Status EventThreadConnection::stealReceiveChannel(gui::BitTube* outChann
         return binder::Status::fromStatusT(NAME_NOT_FOUND);
     }
 
-    outChannel->setReceiveFd(mChannel.moveReceiveFd());
-    outChannel->setSendFd(base::unique_fd(dup(mChannel.getSendFd())));
+    mChannel.moveReceiveEndTo(outChannel);
     return binder::Status::ok();
 }
 
@@ -348,6 +353,10 @@ status_t EventThread::registerDisplayEventConnection(const sp<EventThreadConnect
         return ALREADY_EXISTS;
     }
 
+    if (const auto it = mDeliveryClassByUid.find(connection->mOwnerUid);
+        it != mDeliveryClassByUid.end()) {
+        connection->deliveryClass = it->second;
+    }
     mDisplayEventConnections.push_back(connection);
     mCondition.notify_all();
     return NO_ERROR;
@@ -388,6 +397,24 @@ void EventThread::requestNextVsync(const sp<EventThreadConnection>& connection)
     }
 }
 
+void EventThread::setVsyncDeliveryClassForUid(uid_t uid, VsyncDeliveryClass deliveryClass) {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (deliveryClass == VsyncDeliveryClass::Foreground) {
+        mDeliveryClassByUid.erase(uid);
+    } else {
+        mDeliveryClassByUid[uid] = deliveryClass;
+    }
+
+    for (const wp<EventThreadConnection>& weakConnection : mDisplayEventConnections) {
+        if (const sp<EventThreadConnection> connection = weakConnection.promote();
+            connection && connection->mOwnerUid == uid) {
+            connection->deliveryClass = deliveryClass;
+        }
+    }
+    mCondition.notify_all();
+}
+
 VsyncEventData EventThread::getLatestVsyncEventData(const sp<EventThreadConnection>& connection,
                                                     nsecs_t now) const {
     // Resync so that the vsync is accurate with hardware. getLatestVsyncEventData is an alternate
@@ -516,7 +543,7 @@ void EventThread::threadMain(std::unique_lock<std::mutex>& lock) {
         }
 
         if (!consumers.empty()) {
-            dispatchEvent(*event, consumers);
+            dispatchEvent(*event, consumers, lock);
             consumers.clear();
         }
 
@@ -596,7 +623,14 @@ bool EventThread::shouldConsumeEvent(const DisplayEventReceiver::Event& event,
                     gui::ISurfaceComposer::EventRegistration::modeChanged);
         }
 
-        case DisplayEventReceiver::DISPLAY_EVENT_VSYNC:
+        case DisplayEventReceiver::DISPLAY_EVENT_VSYNC: {
+            // Background connections only receive every 1-in-N vsync. Pending requests are
+            // held (not dropped), so the request stays armed and is satisfied with the fresh
+            // VsyncEventData of the tick that finally gets delivered.
+            const auto decimateVsync = [&]() {
+                return connection->deliveryClass == VsyncDeliveryClass::Background &&
+                        event.vsync.count % kBackgroundVsyncDecimation != 0;
+            };
             switch (connection->vsyncRequest) {
                 case VSyncRequest::None:
                     return false;
@@ -604,14 +638,14 @@ bool EventThread::shouldConsumeEvent(const DisplayEventReceiver::Event& event,
                     connection->vsyncRequest = VSyncRequest::None;
                     return false;
                 case VSyncRequest::Single: {
-                    if (throttleVsync()) {
+                    if (throttleVsync() || decimateVsync()) {
                         return false;
                     }
                     connection->vsyncRequest = VSyncRequest::SingleSuppressCallback;
                     return true;
                 }
                 case VSyncRequest::Periodic:
-                    if (throttleVsync()) {
+                    if (throttleVsync() || decimateVsync()) {
                         return false;
                     }
                     return true;
@@ -621,6 +655,7 @@ bool EventThread::shouldConsumeEvent(const DisplayEventReceiver::Event& event,
                     // rare case
                     return event.vsync.count % vsyncPeriod(connection->vsyncRequest) == 0;
             }
+        }
 
         case DisplayEventReceiver::DISPLAY_EVENT_FRAME_RATE_OVERRIDE:
             [[fallthrough]];
@@ -646,6 +681,12 @@ void EventThread::generateFrameTimeline(VsyncEventData& outVsyncEventData, nsecs
                                         nsecs_t timestamp,
                                         nsecs_t preferredExpectedPresentationTime,
                                         nsecs_t preferredDeadlineTimestamp) const {
+    // Shift the published present times by the measured present-fence drift, so apps
+    // predict where frames actually land under current DPU load instead of assuming
+    // the statically configured offsets. The deadline is SurfaceFlinger's latch time
+    // and is not affected by downstream present latency, so it is left untouched.
+    preferredExpectedPresentationTime += mCallback.getPresentLatencyBias().ns();
+
     uint32_t currentIndex = 0;
     // Add 1 to ensure the preferredFrameTimelineIndex entry (when multiplier == 0) is included.
     for (int64_t multiplier = -VsyncEventData::kFrameTimelinesCapacity + 1;
@@ -700,15 +741,36 @@ void EventThread::generateFrameTimeline(VsyncEventData& outVsyncEventData, nsecs
 }
 
 void EventThread::dispatchEvent(const DisplayEventReceiver::Event& event,
-                                const DisplayEventConsumers& consumers) {
+                                const DisplayEventConsumers& consumers,
+                                std::unique_lock<std::mutex>& lock) {
+    // The consumers are strong references and the fanout below only touches
+    // them and thread-safe collaborators (the token manager and the scheduler
+    // callback), so deliver with the lock dropped. Holding it across the
+    // socket writes would serialize every connection binder call - including
+    // those from other displays' clients - behind the slowest listener list.
+    lock.unlock();
+
+    std::vector<wp<EventThreadConnection>> failedConnections;
+
+    // The frame timelines depend only on the consumer's frame interval, so consumers at the same
+    // rate receive identical payloads. Generate the timeline (and its tokens) once per distinct
+    // rate rather than once per connection, as the fanout cost grows with the number of
+    // Choreographer instances in the system.
+    ftl::SmallMap<nsecs_t, DisplayEventReceiver::Event, 2> vsyncEventsPerInterval;
     for (const auto& consumer : consumers) {
         DisplayEventReceiver::Event copy = event;
         if (event.header.type == DisplayEventReceiver::DISPLAY_EVENT_VSYNC) {
             const Period frameInterval = mCallback.getVsyncPeriod(consumer->mOwnerUid);
-            copy.vsync.vsyncData.frameInterval = frameInterval.ns();
-            generateFrameTimeline(copy.vsync.vsyncData, frameInterval.ns(), copy.header.timestamp,
-                                  event.vsync.vsyncData.preferredExpectedPresentationTime(),
-                                  event.vsync.vsyncData.preferredDeadlineTimestamp());
+            if (const auto cached = vsyncEventsPerInterval.get(frameInterval.ns())) {
+                copy = *cached;
+            } else {
+                copy.vsync.vsyncData.frameInterval = frameInterval.ns();
+                generateFrameTimeline(copy.vsync.vsyncData, frameInterval.ns(),
+                                      copy.header.timestamp,
+                                      event.vsync.vsyncData.preferredExpectedPresentationTime(),
+                                      event.vsync.vsyncData.preferredDeadlineTimestamp());
+                vsyncEventsPerInterval.try_emplace(frameInterval.ns(), copy);
+            }
         }
         switch (consumer->postEvent(copy)) {
             case NO_ERROR:
@@ -722,9 +784,14 @@ void EventThread::dispatchEvent(const DisplayEventReceiver::Event& event,
 
             default:
                 // Treat EPIPE and other errors as fatal.
-                removeDisplayEventConnectionLocked(consumer);
+                failedConnections.emplace_back(consumer);
         }
     }
+
+    lock.lock();
+    for (const auto& connection : failedConnections) {
+        removeDisplayEventConnectionLocked(connection);
+    }
     if (event.header.type == DisplayEventReceiver::DISPLAY_EVENT_VSYNC &&
         FlagManager::getInstance().vrr_config()) {
         mLastCommittedVsyncTime =
@@ -30,6 +30,7 @@
 #include <mutex>
 #include <optional>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "DisplayHardware/DisplayMode.h"
@@ -66,6 +67,15 @@ enum class VSyncRequest {
     // Subsequent values are periods.
 };
 
+// How eagerly vsync events are delivered to a connection. Foreground connections get every
+// requested vsync. Background connections get decimated callbacks: pending requests are held
+// until a decimation boundary, so a backgrounded-but-animating app wakes up at a fraction of the
+// display rate and each callback carries that tick's fresh VsyncEventData.
+enum class VsyncDeliveryClass {
+    Foreground,
+    Background,
+};
+
 class EventThreadConnection : public gui::BnDisplayEventConnection {
 public:
     EventThreadConnection(EventThread*, uid_t callingUid,
@@ -81,6 +91,8 @@ public:
     binder::Status getSchedulingPolicy(gui::SchedulingPolicy* outPolicy) override;
 
     VSyncRequest vsyncRequest = VSyncRequest::None;
+    // Guarded by EventThread::mMutex, like vsyncRequest.
+    VsyncDeliveryClass deliveryClass = VsyncDeliveryClass::Foreground;
     const uid_t mOwnerUid;
     const EventRegistrationFlags mEventRegistration;
 
@@ -127,6 +139,8 @@ public:
     virtual void setVsyncRate(uint32_t rate, const sp<EventThreadConnection>& connection) = 0;
     // Requests the next vsync. If resetIdleTimer is set to true, it resets the idle timer.
     virtual void requestNextVsync(const sp<EventThreadConnection>& connection) = 0;
+    // Sets the delivery class for all current and future connections owned by the given uid.
+    virtual void setVsyncDeliveryClassForUid(uid_t uid, VsyncDeliveryClass deliveryClass) = 0;
     virtual VsyncEventData getLatestVsyncEventData(const sp<EventThreadConnection>& connection,
                                                    nsecs_t now) const = 0;
 
@@ -143,6 +157,11 @@ struct IEventThreadCallback {
     virtual Period getVsyncPeriod(uid_t) = 0;
     virtual void resync() = 0;
     virtual void onExpectedPresentTimePosted(TimePoint) = 0;
+
+    // Signed correction learned from HWC present-fence history: positive when frames
+    // have been landing later than the modeled vsync, negative when earlier. Applied
+    // to the present times published to apps through VsyncEventData.
+    virtual Duration getPresentLatencyBias() const = 0;
 };
 
 namespace impl {
@@ -160,6 +179,7 @@ public:
     status_t registerDisplayEventConnection(const sp<EventThreadConnection>& connection) override;
     void setVsyncRate(uint32_t rate, const sp<EventThreadConnection>& connection) override;
     void requestNextVsync(const sp<EventThreadConnection>& connection) override;
+    void setVsyncDeliveryClassForUid(uid_t uid, VsyncDeliveryClass deliveryClass) override;
     VsyncEventData getLatestVsyncEventData(const sp<EventThreadConnection>& connection,
                                            nsecs_t now) const override;
 
@@ -193,8 +213,12 @@ private:
 
     bool shouldConsumeEvent(const DisplayEventReceiver::Event& event,
                             const sp<EventThreadConnection>& connection) const REQUIRES(mMutex);
+    // Delivers the event to the consumers, dropping the lock for the socket
+    // write fanout so connection calls from binder threads are not serialized
+    // behind it. Failed connections are removed after the lock is reacquired.
     void dispatchEvent(const DisplayEventReceiver::Event& event,
-                       const DisplayEventConsumers& consumers) REQUIRES(mMutex);
+                       const DisplayEventConsumers& consumers,
+                       std::unique_lock<std::mutex>& lock) REQUIRES(mMutex);
 
     void removeDisplayEventConnectionLocked(const wp<EventThreadConnection>& connection)
             REQUIRES(mMutex);
@@ -233,6 +257,12 @@ private:
     std::vector<wp<EventThreadConnection>> mDisplayEventConnections GUARDED_BY(mMutex);
     std::deque<DisplayEventReceiver::Event> mPendingEvents GUARDED_BY(mMutex);
 
+    // Every 1-in-N vsync delivered to background connections.
+    static constexpr uint32_t kBackgroundVsyncDecimation = 4;
+    // Uids demoted to background delivery, so that connections created while the app is
+    // backgrounded start out demoted too. Absent means Foreground.
+    std::unordered_map<uid_t, VsyncDeliveryClass> mDeliveryClassByUid GUARDED_BY(mMutex);
+
     // VSYNC state of connected display.
     struct VSyncState {
         explicit VSyncState(PhysicalDisplayId displayId) : displayId(displayId) {}
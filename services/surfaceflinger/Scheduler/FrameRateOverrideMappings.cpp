@@ -22,18 +22,18 @@ using FrameRateOverride = DisplayEventReceiver::Event::FrameRateOverride;
 
 std::optional<Fps> FrameRateOverrideMappings::getFrameRateOverrideForUid(
         uid_t uid, bool supportsFrameRateOverrideByContent) const {
-    std::lock_guard lock(mFrameRateOverridesLock);
+    const std::shared_ptr<const Overrides> overrides = load();
 
     {
-        const auto iter = mFrameRateOverridesFromBackdoor.find(uid);
-        if (iter != mFrameRateOverridesFromBackdoor.end()) {
+        const auto iter = overrides->fromBackdoor.find(uid);
+        if (iter != overrides->fromBackdoor.end()) {
             return iter->second;
         }
     }
 
     if (!FlagManager::getInstance().game_default_frame_rate()) {
-        const auto iter = mFrameRateOverridesFromGameManager.find(uid);
-        if (iter != mFrameRateOverridesFromGameManager.end()) {
+        const auto iter = overrides->fromGameManager.find(uid);
+        if (iter != overrides->fromGameManager.end()) {
             return iter->second;
         }
     }
@@ -43,8 +43,8 @@ std::optional<Fps> FrameRateOverrideMappings::getFrameRateOverrideForUid(
     }
 
     {
-        const auto iter = mFrameRateOverridesByContent.find(uid);
-        if (iter != mFrameRateOverridesByContent.end()) {
+        const auto iter = overrides->byContent.find(uid);
+        if (iter != overrides->byContent.end()) {
             return iter->second;
         }
     }
@@ -53,18 +53,18 @@ std::optional<Fps> FrameRateOverrideMappings::getFrameRateOverrideForUid(
 }
 
 std::vector<FrameRateOverride> FrameRateOverrideMappings::getAllFrameRateOverrides(
-        bool supportsFrameRateOverrideByContent) {
-    std::lock_guard lock(mFrameRateOverridesLock);
+        bool supportsFrameRateOverrideByContent) const {
+    const std::shared_ptr<const Overrides> snapshot = load();
 
     std::vector<FrameRateOverride> overrides;
-    overrides.reserve(maxOverridesCount());
+    overrides.reserve(snapshot->maxOverridesCount());
 
-    for (const auto& [uid, frameRate] : mFrameRateOverridesFromBackdoor) {
+    for (const auto& [uid, frameRate] : snapshot->fromBackdoor) {
         overrides.emplace_back(FrameRateOverride{uid, frameRate.getValue()});
     }
 
     if (!FlagManager::getInstance().game_default_frame_rate()) {
-        for (const auto& [uid, frameRate] : mFrameRateOverridesFromGameManager) {
+        for (const auto& [uid, frameRate] : snapshot->fromGameManager) {
             if (std::find_if(overrides.begin(), overrides.end(),
                              [uid = uid](auto i) { return i.uid == uid; }) == overrides.end()) {
                 overrides.emplace_back(FrameRateOverride{uid, frameRate.getValue()});
@@ -76,7 +76,7 @@ std::vector<FrameRateOverride> FrameRateOverrideMappings::getAllFrameRateOverrid
         return overrides;
     }
 
-    for (const auto& [uid, frameRate] : mFrameRateOverridesByContent) {
+    for (const auto& [uid, frameRate] : snapshot->byContent) {
         if (std::find_if(overrides.begin(), overrides.end(),
                          [uid = uid](auto i) { return i.uid == uid; }) == overrides.end()) {
             overrides.emplace_back(FrameRateOverride{uid, frameRate.getValue()});
@@ -89,18 +89,18 @@ std::vector<FrameRateOverride> FrameRateOverrideMappings::getAllFrameRateOverrid
 void FrameRateOverrideMappings::dump(utils::Dumper& dumper) const {
     using namespace std::string_view_literals;
 
-    std::lock_guard lock(mFrameRateOverridesLock);
+    const std::shared_ptr<const Overrides> overrides = load();
 
-    const bool hasOverrides = maxOverridesCount() > 0;
+    const bool hasOverrides = overrides->maxOverridesCount() > 0;
     dumper.dump("FrameRateOverrides"sv, hasOverrides ? ""sv : "none"sv);
 
     if (!hasOverrides) return;
 
-    dump(dumper, "setFrameRate"sv, mFrameRateOverridesByContent);
+    dump(dumper, "setFrameRate"sv, overrides->byContent);
     if (!FlagManager::getInstance().game_default_frame_rate()) {
-        dump(dumper, "GameManager"sv, mFrameRateOverridesFromGameManager);
+        dump(dumper, "GameManager"sv, overrides->fromGameManager);
     }
-    dump(dumper, "Backdoor"sv, mFrameRateOverridesFromBackdoor);
+    dump(dumper, "Backdoor"sv, overrides->fromBackdoor);
 }
 
 void FrameRateOverrideMappings::dump(utils::Dumper& dumper, std::string_view name,
@@ -120,35 +120,55 @@ void FrameRateOverrideMappings::dump(utils::Dumper& dumper, std::string_view nam
 
 bool FrameRateOverrideMappings::updateFrameRateOverridesByContent(
         const UidToFrameRateOverride& frameRateOverrides) {
-    std::lock_guard lock(mFrameRateOverridesLock);
-    if (!std::equal(mFrameRateOverridesByContent.begin(), mFrameRateOverridesByContent.end(),
-                    frameRateOverrides.begin(), frameRateOverrides.end(),
-                    [](const auto& lhs, const auto& rhs) {
-                        return lhs.first == rhs.first && isApproxEqual(lhs.second, rhs.second);
-                    })) {
-        mFrameRateOverridesByContent = frameRateOverrides;
-        return true;
+    std::lock_guard lock(mWriteLock);
+    const std::shared_ptr<const Overrides> current = load();
+    if (std::equal(current->byContent.begin(), current->byContent.end(),
+                   frameRateOverrides.begin(), frameRateOverrides.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                       return lhs.first == rhs.first && isApproxEqual(lhs.second, rhs.second);
+                   })) {
+        return false;
     }
-    return false;
+    auto next = std::make_shared<Overrides>(*current);
+    next->byContent = frameRateOverrides;
+    store(std::move(next));
+    return true;
 }
 
-void FrameRateOverrideMappings::setGameModeRefreshRateForUid(FrameRateOverride frameRateOverride) {
-    std::lock_guard lock(mFrameRateOverridesLock);
+void FrameRateOverrideMappings::applyOverride(UidToFrameRateOverride& overrides,
+                                              FrameRateOverride frameRateOverride) {
     if (frameRateOverride.frameRateHz != 0.f) {
-        mFrameRateOverridesFromGameManager[frameRateOverride.uid] =
-                Fps::fromValue(frameRateOverride.frameRateHz);
+        overrides[frameRateOverride.uid] = Fps::fromValue(frameRateOverride.frameRateHz);
     } else {
-        mFrameRateOverridesFromGameManager.erase(frameRateOverride.uid);
+        overrides.erase(frameRateOverride.uid);
     }
 }
 
+void FrameRateOverrideMappings::setGameModeRefreshRateForUid(FrameRateOverride frameRateOverride) {
+    setGameModeRefreshRateForUids({frameRateOverride});
+}
+
+void FrameRateOverrideMappings::setGameModeRefreshRateForUids(
+        const std::vector<FrameRateOverride>& frameRateOverrides) {
+    std::lock_guard lock(mWriteLock);
+    auto next = std::make_shared<Overrides>(*load());
+    for (const auto& frameRateOverride : frameRateOverrides) {
+        applyOverride(next->fromGameManager, frameRateOverride);
+    }
+    store(std::move(next));
+}
+
 void FrameRateOverrideMappings::setPreferredRefreshRateForUid(FrameRateOverride frameRateOverride) {
-    std::lock_guard lock(mFrameRateOverridesLock);
-    if (frameRateOverride.frameRateHz != 0.f) {
-        mFrameRateOverridesFromBackdoor[frameRateOverride.uid] =
-                Fps::fromValue(frameRateOverride.frameRateHz);
-    } else {
-        mFrameRateOverridesFromBackdoor.erase(frameRateOverride.uid);
+    setPreferredRefreshRateForUids({frameRateOverride});
+}
+
+void FrameRateOverrideMappings::setPreferredRefreshRateForUids(
+        const std::vector<FrameRateOverride>& frameRateOverrides) {
+    std::lock_guard lock(mWriteLock);
+    auto next = std::make_shared<Overrides>(*load());
+    for (const auto& frameRateOverride : frameRateOverrides) {
+        applyOverride(next->fromBackdoor, frameRateOverride);
     }
+    store(std::move(next));
 }
 } // namespace android::scheduler
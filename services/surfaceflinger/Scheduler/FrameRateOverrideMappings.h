@@ -16,11 +16,12 @@
 
 #pragma once
 
-#include <android-base/thread_annotations.h>
 #include <gui/DisplayEventReceiver.h>
 #include <scheduler/Fps.h>
 #include <sys/types.h>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 
 #include "Utils/Dumper.h"
@@ -33,37 +34,52 @@ class FrameRateOverrideMappings {
 
 public:
     std::optional<Fps> getFrameRateOverrideForUid(uid_t uid,
-                                                  bool supportsFrameRateOverrideByContent) const
-            EXCLUDES(mFrameRateOverridesLock);
-    std::vector<FrameRateOverride> getAllFrameRateOverrides(bool supportsFrameRateOverrideByContent)
-            EXCLUDES(mFrameRateOverridesLock);
-    bool updateFrameRateOverridesByContent(const UidToFrameRateOverride& frameRateOverrides)
-            EXCLUDES(mFrameRateOverridesLock);
-    void setGameModeRefreshRateForUid(FrameRateOverride frameRateOverride)
-            EXCLUDES(mFrameRateOverridesLock);
-    void setPreferredRefreshRateForUid(FrameRateOverride frameRateOverride)
-            EXCLUDES(mFrameRateOverridesLock);
+                                                  bool supportsFrameRateOverrideByContent) const;
+    std::vector<FrameRateOverride> getAllFrameRateOverrides(
+            bool supportsFrameRateOverrideByContent) const;
+    bool updateFrameRateOverridesByContent(const UidToFrameRateOverride& frameRateOverrides);
+    void setGameModeRefreshRateForUid(FrameRateOverride frameRateOverride);
+    void setPreferredRefreshRateForUid(FrameRateOverride frameRateOverride);
+
+    // Batch variants applying all passed overrides as a single snapshot swap,
+    // so readers never observe a half-applied policy update.
+    void setGameModeRefreshRateForUids(const std::vector<FrameRateOverride>& frameRateOverrides);
+    void setPreferredRefreshRateForUids(const std::vector<FrameRateOverride>& frameRateOverrides);
 
     void dump(utils::Dumper&) const;
 
 private:
-    size_t maxOverridesCount() const REQUIRES(mFrameRateOverridesLock) {
-        return std::max({mFrameRateOverridesByContent.size(),
-                         mFrameRateOverridesFromGameManager.size(),
-                         mFrameRateOverridesFromBackdoor.size()});
+    // All override lists are published together as one immutable snapshot.
+    // They are read per frame and per event fanout by SurfaceFlinger, Scheduler
+    // and EventThread, so readers take no lock: they atomically load the
+    // current snapshot and writers swap in a frozen replacement.
+    struct Overrides {
+        // mappings between a UID and a preferred refresh rate that this app
+        // would run at.
+        UidToFrameRateOverride byContent;
+        UidToFrameRateOverride fromBackdoor;
+        UidToFrameRateOverride fromGameManager;
+
+        size_t maxOverridesCount() const {
+            return std::max({byContent.size(), fromGameManager.size(), fromBackdoor.size()});
+        }
+    };
+
+    std::shared_ptr<const Overrides> load() const {
+        return std::atomic_load_explicit(&mOverrides, std::memory_order_acquire);
     }
 
-    void dump(utils::Dumper&, std::string_view name, const UidToFrameRateOverride&) const;
+    void store(std::shared_ptr<const Overrides> overrides) {
+        std::atomic_store_explicit(&mOverrides, std::move(overrides), std::memory_order_release);
+    }
+
+    static void applyOverride(UidToFrameRateOverride&, FrameRateOverride);
 
-    // The frame rate override lists need their own mutex as they are being read
-    // by SurfaceFlinger, Scheduler and EventThread (as a callback) to prevent deadlocks
-    mutable std::mutex mFrameRateOverridesLock;
+    void dump(utils::Dumper&, std::string_view name, const UidToFrameRateOverride&) const;
 
-    // mappings between a UID and a preferred refresh rate that this app would
-    // run at.
-    UidToFrameRateOverride mFrameRateOverridesByContent GUARDED_BY(mFrameRateOverridesLock);
-    UidToFrameRateOverride mFrameRateOverridesFromBackdoor GUARDED_BY(mFrameRateOverridesLock);
-    UidToFrameRateOverride mFrameRateOverridesFromGameManager GUARDED_BY(mFrameRateOverridesLock);
+    // Serializes writers only; readers go through load() without locking.
+    std::mutex mWriteLock;
+    std::shared_ptr<const Overrides> mOverrides = std::make_shared<const Overrides>();
 };
 
 } // namespace android::scheduler
@@ -120,6 +120,7 @@ void LayerHistory::registerLayer(Layer* layer, bool contentDetectionEnabled,
     // The layer can be placed on either map, it is assumed that partitionLayers() will be called
     // to correct them.
     mInactiveLayerInfos.insert({layer->getSequence(), std::make_pair(layer, std::move(info))});
+    mInactiveLayersDirty = true;
 }
 
 void LayerHistory::deregisterLayer(Layer* layer) {
@@ -182,10 +183,16 @@ void LayerHistory::setLayerProperties(int32_t id, const LayerProps& properties)
     info->setProperties(properties);
 
     // Activate layer if inactive and visible.
-    if (found == LayerStatus::LayerInInactiveMap && info->isVisible()) {
-        mActiveLayerInfos.insert(
-                {id, std::make_pair(layerPair->first, std::move(layerPair->second))});
-        mInactiveLayerInfos.erase(id);
+    if (found == LayerStatus::LayerInInactiveMap) {
+        if (info->isVisible()) {
+            mActiveLayerInfos.insert(
+                    {id, std::make_pair(layerPair->first, std::move(layerPair->second))});
+            mInactiveLayerInfos.erase(id);
+        } else {
+            // The new properties may still activate the layer, e.g. an explicit
+            // frame rate vote. Let partitionLayers() take another look.
+            mInactiveLayersDirty = true;
+        }
     }
 }
 
@@ -196,6 +203,7 @@ auto LayerHistory::summarize(const RefreshRateSelector& selector, nsecs_t now) -
     std::lock_guard lock(mLock);
 
     partitionLayers(now, selector.isVrrDevice());
+    summary.reserve(mActiveLayerInfos.size());
 
     for (const auto& [key, value] : mActiveLayerInfos) {
         auto& info = value.second;
@@ -241,26 +249,36 @@ void LayerHistory::partitionLayers(nsecs_t now, bool isVrrDevice) {
     SFTRACE_CALL();
     const nsecs_t threshold = getActiveLayerThreshold(now);
 
-    // iterate over inactive map
-    LayerInfos::iterator it = mInactiveLayerInfos.begin();
-    while (it != mInactiveLayerInfos.end()) {
-        auto& [layerUnsafe, info] = it->second;
-        if (isLayerActive(*info, threshold, isVrrDevice)) {
-            // move this to the active map
+    if (isVrrDevice != mPartitionedForVrr) {
+        mPartitionedForVrr = isVrrDevice;
+        mInactiveLayersDirty = true;
+    }
 
-            mActiveLayerInfos.insert({it->first, std::move(it->second)});
-            it = mInactiveLayerInfos.erase(it);
-        } else {
-            if (CC_UNLIKELY(mTraceEnabled)) {
-                trace(*info, LayerVoteType::NoVote, 0);
+    // Iterate over the inactive map, but only when a layer may have been activated since the
+    // last partition: time alone never activates a layer, it only deactivates. Keep iterating
+    // when tracing so inactive layers continue to emit NoVote.
+    if (mInactiveLayersDirty || CC_UNLIKELY(mTraceEnabled)) {
+        mInactiveLayersDirty = false;
+        LayerInfos::iterator it = mInactiveLayerInfos.begin();
+        while (it != mInactiveLayerInfos.end()) {
+            auto& [layerUnsafe, info] = it->second;
+            if (isLayerActive(*info, threshold, isVrrDevice)) {
+                // move this to the active map
+
+                mActiveLayerInfos.insert({it->first, std::move(it->second)});
+                it = mInactiveLayerInfos.erase(it);
+            } else {
+                if (CC_UNLIKELY(mTraceEnabled)) {
+                    trace(*info, LayerVoteType::NoVote, 0);
+                }
+                info->onLayerInactive(now);
+                it++;
             }
-            info->onLayerInactive(now);
-            it++;
         }
     }
 
     // iterate over active map
-    it = mActiveLayerInfos.begin();
+    LayerInfos::iterator it = mActiveLayerInfos.begin();
     while (it != mActiveLayerInfos.end()) {
         auto& [layerUnsafe, info] = it->second;
         if (isLayerActive(*info, threshold, isVrrDevice)) {
@@ -114,7 +114,9 @@ private:
     // Iterates over layers maps moving all active layers to mActiveLayerInfos and all inactive
     // layers to mInactiveLayerInfos. Layer's active state is determined by multiple factors
     // such as update activity, visibility, and frame rate vote.
-    // worst case time complexity is O(2 * inactive + active)
+    // worst case time complexity is O(2 * inactive + active), but the inactive map is only
+    // scanned when a layer may have been activated since the last call (see
+    // mInactiveLayersDirty), so the steady-state cost is O(active).
     // now: the current time (system time) when calling the method
     // isVrrDevice: true if the device has DisplayMode with VrrConfig specified.
     void partitionLayers(nsecs_t now, bool isVrrDevice) REQUIRES(mLock);
@@ -143,6 +145,14 @@ private:
     LayerInfos mActiveLayerInfos GUARDED_BY(mLock);
     LayerInfos mInactiveLayerInfos GUARDED_BY(mLock);
 
+    // Set when a change may activate a layer in mInactiveLayerInfos. Activation is driven by
+    // recorded updates and property changes, never by time alone, so partitionLayers() can skip
+    // scanning the inactive map while this is false.
+    bool mInactiveLayersDirty GUARDED_BY(mLock) = true;
+
+    // The device type partitionLayers() last ran with; isLayerActive() depends on it.
+    bool mPartitionedForVrr GUARDED_BY(mLock) = false;
+
     uint32_t mDisplayArea = 0;
 
     // Whether to emit systrace output and debug logs.
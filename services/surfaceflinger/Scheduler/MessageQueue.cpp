@@ -16,6 +16,9 @@
 
 #define ATRACE_TAG ATRACE_TAG_GRAPHICS
 
+#include <algorithm>
+
+#include <android-base/properties.h>
 #include <binder/IPCThreadState.h>
 #include <utils/Log.h>
 #include <utils/Timers.h>
@@ -29,6 +32,21 @@
 
 namespace android::impl {
 
+namespace {
+
+// Bounds for the late wakeup compensation: never schedule more than this much extra lead time,
+// and walk the compensation back by the decay step for every on-time callback.
+constexpr Duration kMaxLateWakeupCompensation = std::chrono::microseconds(1500);
+constexpr Duration kLateWakeupCompensationDecay = std::chrono::microseconds(50);
+
+bool compensateLateWakeups() {
+    static const bool enabled =
+            base::GetBoolProperty(std::string("debug.sf.compensate_late_wakeups"), false);
+    return enabled;
+}
+
+} // namespace
+
 void MessageQueue::Handler::dispatchFrame(VsyncId vsyncId, TimePoint expectedVsyncTime) {
     if (!mFramePending.exchange(true)) {
         mVsyncId = vsyncId;
@@ -66,6 +84,18 @@ void MessageQueue::vsyncCallback(nsecs_t vsyncTime, nsecs_t targetWakeupTime, ns
         std::lock_guard lock(mVsync.mutex);
         mVsync.lastCallbackTime = expectedVsyncTime;
         mVsync.scheduledFrameTimeOpt.reset();
+
+        if (compensateLateWakeups()) {
+            const Duration lateness = TimePoint::now() - TimePoint::fromNs(targetWakeupTime);
+            if (lateness > mVsync.lateWakeupCompensation) {
+                mVsync.lateWakeupCompensation = std::min(lateness, kMaxLateWakeupCompensation);
+            } else {
+                mVsync.lateWakeupCompensation =
+                        std::max(Duration(mVsync.lateWakeupCompensation -
+                                          kLateWakeupCompensationDecay),
+                                 Duration::fromNs(0));
+            }
+        }
     }
 
     const auto vsyncId = VsyncId{mVsync.tokenManager->generateTokenForPredictions(
@@ -192,7 +222,8 @@ void MessageQueue::scheduleFrame(Duration workDurationSlack) {
     SFTRACE_CALL();
 
     std::lock_guard lock(mVsync.mutex);
-    const auto workDuration = Duration(mVsync.workDuration.get() - workDurationSlack);
+    const auto workDuration = Duration(mVsync.workDuration.get() - workDurationSlack +
+                                       mVsync.lateWakeupCompensation);
     mVsync.scheduledFrameTimeOpt =
             mVsync.registration->schedule({.workDuration = workDuration.ns(),
                                            .readyDuration = 0,
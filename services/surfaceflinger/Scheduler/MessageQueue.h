@@ -127,6 +127,12 @@ private:
         TimePoint lastCallbackTime GUARDED_BY(mutex);
         std::optional<scheduler::ScheduleResult> scheduledFrameTimeOpt GUARDED_BY(mutex);
         TracedOrdinal<int> value = {"VSYNC-sf", 0};
+
+        // Extra lead time added to scheduled frames after the vsync callback fires later than
+        // its target wakeup, so scheduling latency does not eat into the commit window. Ramps
+        // up to the observed lateness and decays while wakeups are back on time. Only nonzero
+        // when debug.sf.compensate_late_wakeups is set.
+        Duration lateWakeupCompensation GUARDED_BY(mutex) = Duration::fromNs(0);
     };
 
     Vsync mVsync;
@@ -14,194 +14,357 @@
  * limitations under the License.
  */
 
+#undef LOG_TAG
+#define LOG_TAG "OneShotTimer"
+
 #include "OneShotTimer.h"
-#include <utils/Log.h>
-#include <utils/Timers.h>
-#include <chrono>
-#include <sstream>
-#include <thread>
 
-namespace {
-using namespace std::chrono_literals;
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/unistd.h>
 
-constexpr int64_t kNsToSeconds = std::chrono::duration_cast<std::chrono::nanoseconds>(1s).count();
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
 
-// The syscall interface uses a pair of integers for the timestamp. The first
-// (tv_sec) is the whole count of seconds. The second (tv_nsec) is the
-// nanosecond part of the count. This function takes care of translation.
-void calculateTimeoutTime(std::chrono::nanoseconds timestamp, timespec* spec) {
-    const nsecs_t timeout = systemTime(CLOCK_MONOTONIC) + timestamp.count();
-    spec->tv_sec = static_cast<__kernel_time_t>(timeout / kNsToSeconds);
-    spec->tv_nsec = timeout % kNsToSeconds;
-}
-} // namespace
+#include <utils/Log.h>
+#include <utils/Timers.h>
 
 namespace android {
 namespace scheduler {
 
-OneShotTimer::OneShotTimer(std::string name, const Interval& interval,
-                           const ResetCallback& resetCallback,
-                           const TimeoutCallback& timeoutCallback, std::unique_ptr<Clock> clock)
-      : mClock(std::move(clock)),
-        mName(std::move(name)),
-        mInterval(interval),
-        mResetCallback(resetCallback),
-        mTimeoutCallback(timeoutCallback) {
-    mLastResetTime = std::chrono::steady_clock::time_point::min();
-    LOG_ALWAYS_FATAL_IF(!mClock, "Clock must not be provided");
-}
+namespace {
+using namespace std::chrono_literals;
 
-OneShotTimer::~OneShotTimer() {
-    stop();
-}
+constexpr size_t kReadPipe = 0;
+constexpr size_t kWritePipe = 1;
 
-void OneShotTimer::start() {
-    int result = sem_init(&mSemaphore, 0, 0);
-    LOG_ALWAYS_FATAL_IF(result, "sem_init failed");
+// Control bytes written to the dispatch pipe.
+constexpr char kWake = 'w';
+constexpr char kTerminate = 'e';
 
-    if (!mThread.joinable()) {
-        // Only create thread if it has not been created.
-        mThread = std::thread(&OneShotTimer::loop, this);
+// Deadlines that land within this window of the earliest pending deadline are
+// serviced by the same wakeup of the dispatch thread. The timers multiplexed
+// here fire on the scale of tens of milliseconds to seconds, so delaying the
+// earliest of a cluster by up to a millisecond is not observable.
+constexpr auto kCoalesceWindow = 1ms;
+
+constexpr int64_t kNsToSeconds = std::chrono::duration_cast<std::chrono::nanoseconds>(1s).count();
+} // namespace
+
+// Process-wide timerfd/epoll dispatch thread shared by every OneShotTimer.
+// A single thread waits on the earliest pending deadline across all registered
+// timers instead of each timer burning a thread and its own periodic wakeups.
+class OneShotTimerDispatch {
+public:
+    static OneShotTimerDispatch& getInstance() {
+        static OneShotTimerDispatch sDispatch;
+        return sDispatch;
     }
-}
 
-void OneShotTimer::stop() {
-    mStopTriggered = true;
-    int result = sem_post(&mSemaphore);
-    LOG_ALWAYS_FATAL_IF(result, "sem_post failed");
+    OneShotTimerDispatch() {
+        mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (pipe2(mPipes.data(), O_CLOEXEC | O_NONBLOCK)) {
+            ALOGE("could not create OneShotTimer dispatch pipes");
+        }
+        mThread = std::thread([this] { threadMain(); });
+    }
 
-    if (mThread.joinable()) {
+    ~OneShotTimerDispatch() {
+        write(mPipes[kWritePipe], &kTerminate, sizeof(kTerminate));
         mThread.join();
-        result = sem_destroy(&mSemaphore);
-        LOG_ALWAYS_FATAL_IF(result, "sem_destroy failed");
+        close(mTimerFd);
+        close(mEpollFd);
+        close(mPipes[kReadPipe]);
+        close(mPipes[kWritePipe]);
     }
-}
 
-void OneShotTimer::loop() {
-    if (pthread_setname_np(pthread_self(), mName.c_str())) {
-        ALOGW("Failed to set thread name on dispatch thread");
+    void startTimer(OneShotTimer* timer) {
+        {
+            std::lock_guard lock(mMutex);
+            if (timer->mState != OneShotTimer::TimerState::STOPPED) {
+                return;
+            }
+            timer->mState = OneShotTimer::TimerState::RESET;
+            timer->mPaused = false;
+            mTimers.push_back(timer);
+        }
+        wake();
     }
 
-    TimerState state = TimerState::RESET;
-    while (true) {
-        bool triggerReset = false;
-        bool triggerTimeout = false;
+    void stopTimer(OneShotTimer* timer) {
+        std::unique_lock lock(mMutex);
+        if (timer->mState == OneShotTimer::TimerState::STOPPED) {
+            return;
+        }
+        timer->mState = OneShotTimer::TimerState::STOPPED;
+        mTimers.erase(std::remove(mTimers.begin(), mTimers.end(), timer), mTimers.end());
+        // If the dispatch thread is mid-callback for this timer, wait for the
+        // callback to return so that no callback runs after stop(), matching
+        // the semantics of the per-timer thread this class used to join here.
+        // A callback stopping its own timer runs on the dispatch thread and
+        // must not wait for itself.
+        if (std::this_thread::get_id() != mThread.get_id()) {
+            mCallbackDone.wait(lock, [&] { return mDispatching != timer; });
+        }
+    }
 
-        state = checkForResetAndStop(state);
-        if (state == TimerState::STOPPED) {
-            break;
+    void resetTimer(OneShotTimer* timer) {
+        bool needsWake = false;
+        {
+            std::lock_guard lock(mMutex);
+            switch (timer->mState) {
+                case OneShotTimer::TimerState::STOPPED:
+                    return;
+                case OneShotTimer::TimerState::RESET:
+                    // A reset callback is already pending.
+                    break;
+                case OneShotTimer::TimerState::WAITING:
+                    // Push the deadline out without firing the reset callback.
+                    // No wakeup is needed: the new deadline is later than the
+                    // one currently armed, and the dispatch thread re-arms
+                    // after every wakeup anyway.
+                    timer->mDeadline = timer->mClock->now() + timer->mInterval.load();
+                    break;
+                case OneShotTimer::TimerState::IDLE:
+                    timer->mState = OneShotTimer::TimerState::RESET;
+                    needsWake = true;
+                    break;
+            }
         }
+        if (needsWake) {
+            wake();
+        }
+    }
+
+    void pauseTimer(OneShotTimer* timer) {
+        std::lock_guard lock(mMutex);
+        timer->mPaused = true;
+    }
 
-        if (state == TimerState::IDLE) {
-            int result = sem_wait(&mSemaphore);
-            if (result && errno != EINTR) {
-                std::stringstream ss;
-                ss << "sem_wait failed (" << errno << ")";
-                LOG_ALWAYS_FATAL("%s", ss.str().c_str());
+    void resumeTimer(OneShotTimer* timer) {
+        bool needsWake = false;
+        {
+            std::lock_guard lock(mMutex);
+            if (timer->mPaused) {
+                timer->mPaused = false;
+                needsWake = true;
             }
-            continue;
         }
+        if (needsWake) {
+            wake();
+        }
+    }
+
+private:
+    void wake() { write(mPipes[kWritePipe], &kWake, sizeof(kWake)); }
 
-        if (state == TimerState::RESET) {
-            triggerReset = true;
+    void threadMain() {
+        if (pthread_setname_np(pthread_self(), "OneShotDispatch")) {
+            ALOGW("Failed to set thread name on dispatch thread");
         }
 
-        if (triggerReset && mResetCallback) {
-            mResetCallback();
+        enum DispatchType : uint32_t { TIMER, CONTROL, MAX_DISPATCH_TYPE };
+        epoll_event timerEvent;
+        timerEvent.events = EPOLLIN;
+        timerEvent.data.u32 = DispatchType::TIMER;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &timerEvent) == -1) {
+            ALOGE("Error adding timer fd to epoll dispatch loop");
+            return;
         }
 
-        state = checkForResetAndStop(state);
-        if (state == TimerState::STOPPED) {
-            break;
+        epoll_event controlEvent;
+        controlEvent.events = EPOLLIN;
+        controlEvent.data.u32 = DispatchType::CONTROL;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mPipes[kReadPipe], &controlEvent) == -1) {
+            ALOGE("Error adding control fd to dispatch loop");
+            return;
         }
 
-        auto triggerTime = mClock->now() + mInterval.load();
-        state = TimerState::WAITING;
         while (true) {
-            if (mPaused) {
-                mWaiting = true;
-                int result = sem_wait(&mSemaphore);
-                if (result && errno != EINTR) {
-                    std::stringstream ss;
-                    ss << "sem_wait failed (" << errno << ")";
-                    LOG_ALWAYS_FATAL("%s", ss.str().c_str());
+            epoll_event events[DispatchType::MAX_DISPATCH_TYPE];
+            int nfds = epoll_wait(mEpollFd, events, DispatchType::MAX_DISPATCH_TYPE, -1);
+            if (nfds == -1 && errno != EINTR) {
+                ALOGE("Error waiting on epoll: %s", strerror(errno));
+                return;
+            }
+
+            for (int i = 0; i < nfds; i++) {
+                if (events[i].data.u32 == DispatchType::TIMER) {
+                    uint64_t ignored;
+                    read(mTimerFd, &ignored, sizeof(ignored));
+                } else if (events[i].data.u32 == DispatchType::CONTROL) {
+                    char commands[16];
+                    ssize_t count;
+                    while ((count = read(mPipes[kReadPipe], commands, sizeof(commands))) > 0) {
+                        for (ssize_t j = 0; j < count; j++) {
+                            if (commands[j] == kTerminate) {
+                                return;
+                            }
+                        }
+                    }
                 }
+            }
 
-                mWaiting = false;
-                state = checkForResetAndStop(state);
-                if (state == TimerState::STOPPED) {
+            std::unique_lock lock(mMutex);
+            dispatchDueTimers(lock);
+            rearmLocked();
+        }
+    }
+
+    // Fires callbacks for every due timer, dropping the lock around each
+    // callback so that callbacks may call back into this class.
+    void dispatchDueTimers(std::unique_lock<std::mutex>& lock) {
+        while (true) {
+            OneShotTimer* dueTimer = nullptr;
+            bool isReset = false;
+            for (OneShotTimer* timer : mTimers) {
+                if (timer->mState == OneShotTimer::TimerState::RESET) {
+                    // The reset callback fires even while paused, as the old
+                    // per-timer loop did; only the timeout is gated on pause.
+                    dueTimer = timer;
+                    isReset = true;
                     break;
                 }
-            }
-            // Wait until triggerTime time to check if we need to reset or drop into the idle state.
-            if (const auto triggerInterval = triggerTime - mClock->now(); triggerInterval > 0ns) {
-                mWaiting = true;
-                struct timespec ts;
-                calculateTimeoutTime(triggerInterval, &ts);
-                int result = sem_clockwait(&mSemaphore, CLOCK_MONOTONIC, &ts);
-                if (result && errno != ETIMEDOUT && errno != EINTR) {
-                    std::stringstream ss;
-                    ss << "sem_clockwait failed (" << errno << ")";
-                    LOG_ALWAYS_FATAL("%s", ss.str().c_str());
+                if (!timer->mPaused && timer->mState == OneShotTimer::TimerState::WAITING &&
+                    timer->mClock->now() >= timer->mDeadline) {
+                    dueTimer = timer;
+                    break;
                 }
             }
+            if (dueTimer == nullptr) {
+                return;
+            }
 
-            mWaiting = false;
-            state = checkForResetAndStop(state);
-            if (state == TimerState::STOPPED) {
-                break;
+            if (!isReset) {
+                dueTimer->mState = OneShotTimer::TimerState::IDLE;
+            }
+            const auto callback = isReset ? dueTimer->mResetCallback : dueTimer->mTimeoutCallback;
+            mDispatching = dueTimer;
+            lock.unlock();
+            if (callback) {
+                callback();
             }
+            lock.lock();
+            mDispatching = nullptr;
+            mCallbackDone.notify_all();
 
-            if (!mPaused && state == TimerState::WAITING && (triggerTime - mClock->now()) <= 0ns) {
-                triggerTimeout = true;
-                state = TimerState::IDLE;
-                break;
+            // Arm the timeout only after the reset callback has returned,
+            // matching the old loop which sampled the clock after the
+            // callback. The timer may have been stopped or re-reset while
+            // the lock was dropped.
+            if (isReset && dueTimer->mState == OneShotTimer::TimerState::RESET) {
+                dueTimer->mState = OneShotTimer::TimerState::WAITING;
+                dueTimer->mDeadline = dueTimer->mClock->now() + dueTimer->mInterval.load();
             }
+        }
+    }
 
-            if (state == TimerState::RESET) {
-                triggerTime = mLastResetTime.load() + mInterval.load();
-                state = TimerState::WAITING;
+    // Arms the timerfd for the earliest pending deadline, stretched to the
+    // latest deadline within kCoalesceWindow of it so that near-simultaneous
+    // timers are serviced by a single wakeup. Remaining times are computed
+    // against each timer's own clock, which unit tests mock, so the armed
+    // wakeup is a poll point after which the deadlines are re-evaluated.
+    void rearmLocked() {
+        std::optional<std::chrono::nanoseconds> minRemaining;
+        for (OneShotTimer* timer : mTimers) {
+            if (timer->mPaused || timer->mState != OneShotTimer::TimerState::WAITING) {
+                continue;
+            }
+            const std::chrono::nanoseconds remaining = timer->mDeadline - timer->mClock->now();
+            if (!minRemaining || remaining < *minRemaining) {
+                minRemaining = remaining;
             }
         }
 
-        if (triggerTimeout && mTimeoutCallback) {
-            mTimeoutCallback();
+        struct itimerspec newTimer {
+            .it_interval = {.tv_sec = 0, .tv_nsec = 0},
+            .it_value = {.tv_sec = 0, .tv_nsec = 0},
+        };
+
+        if (minRemaining) {
+            auto wakeIn = *minRemaining;
+            for (OneShotTimer* timer : mTimers) {
+                if (timer->mPaused || timer->mState != OneShotTimer::TimerState::WAITING) {
+                    continue;
+                }
+                const std::chrono::nanoseconds remaining = timer->mDeadline - timer->mClock->now();
+                if (remaining <= *minRemaining + kCoalesceWindow && remaining > wakeIn) {
+                    wakeIn = remaining;
+                }
+            }
+            // An armed time of zero would disarm the timerfd.
+            const nsecs_t target =
+                    systemTime(SYSTEM_TIME_MONOTONIC) + std::max<int64_t>(wakeIn.count(), 1);
+            newTimer.it_value.tv_sec = static_cast<long>(target / kNsToSeconds);
+            newTimer.it_value.tv_nsec = static_cast<long>(target % kNsToSeconds);
+        }
+
+        if (timerfd_settime(mTimerFd, minRemaining ? TFD_TIMER_ABSTIME : 0, &newTimer, nullptr)) {
+            ALOGW("Failed to set timerfd %s (%i)", strerror(errno), errno);
         }
     }
+
+    std::mutex mMutex;
+
+    // Signalled when the dispatch thread finishes a callback, so that stop()
+    // can wait out an in-flight callback for its timer.
+    std::condition_variable mCallbackDone;
+
+    // Timers registered with the dispatch thread. Guarded by mMutex.
+    std::vector<OneShotTimer*> mTimers;
+
+    // Timer whose callback is currently being invoked, if any. Guarded by
+    // mMutex.
+    OneShotTimer* mDispatching = nullptr;
+
+    int mTimerFd = -1;
+    int mEpollFd = -1;
+    std::array<int, 2> mPipes = {-1, -1};
+    std::thread mThread;
+};
+
+OneShotTimer::OneShotTimer(std::string name, const Interval& interval,
+                           const ResetCallback& resetCallback,
+                           const TimeoutCallback& timeoutCallback, std::unique_ptr<Clock> clock)
+      : mClock(std::move(clock)),
+        mName(std::move(name)),
+        mInterval(interval),
+        mResetCallback(resetCallback),
+        mTimeoutCallback(timeoutCallback) {
+    LOG_ALWAYS_FATAL_IF(!mClock, "Clock must not be provided");
 }
 
-OneShotTimer::TimerState OneShotTimer::checkForResetAndStop(TimerState state) {
-    // Stop takes precedence of the reset.
-    if (mStopTriggered.exchange(false)) {
-        return TimerState::STOPPED;
-    }
-    // If the state was stopped, the thread was joined, and we cannot reset
-    // the timer anymore.
-    if (state != TimerState::STOPPED && mResetTriggered.exchange(false)) {
-        return TimerState::RESET;
-    }
-    return state;
+OneShotTimer::~OneShotTimer() {
+    stop();
+}
+
+void OneShotTimer::start() {
+    OneShotTimerDispatch::getInstance().startTimer(this);
+}
+
+void OneShotTimer::stop() {
+    OneShotTimerDispatch::getInstance().stopTimer(this);
 }
 
 void OneShotTimer::reset() {
-    mLastResetTime = mClock->now();
-    mResetTriggered = true;
-    // If mWaiting is true, then we are guaranteed to be in a block where we are waiting on
-    // mSemaphore for a timeout, rather than idling. So we can avoid a sem_post call since we can
-    // just check that we triggered a reset on timeout.
-    if (!mWaiting) {
-        LOG_ALWAYS_FATAL_IF(sem_post(&mSemaphore), "sem_post failed");
-    }
+    OneShotTimerDispatch::getInstance().resetTimer(this);
 }
 
 void OneShotTimer::pause() {
-    mPaused = true;
+    OneShotTimerDispatch::getInstance().pauseTimer(this);
 }
 
 void OneShotTimer::resume() {
-    if (mPaused.exchange(false)) {
-        LOG_ALWAYS_FATAL_IF(sem_post(&mSemaphore), "sem_post failed");
-    }
+    OneShotTimerDispatch::getInstance().resumeTimer(this);
 }
 
 } // namespace scheduler
@@ -16,21 +16,27 @@
 
 #pragma once
 
-#include <semaphore.h>
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
-#include <thread>
+#include <functional>
+#include <memory>
+#include <string>
 #include "../Clock.h"
 
-#include <android-base/thread_annotations.h>
 #include <scheduler/Time.h>
 
 namespace android {
 namespace scheduler {
 
+class OneShotTimerDispatch;
+
 /*
  * Class that sets off a timer for a given interval, and fires a callback when the
  * interval expires.
+ *
+ * All OneShotTimer instances in the process share a single timerfd/epoll dispatch
+ * thread that multiplexes their deadlines and coalesces near-simultaneous wakeups,
+ * so each timer no longer owns a thread of its own.
  */
 class OneShotTimer {
 public:
@@ -58,14 +64,17 @@ public:
     void resume();
 
 private:
+    friend class OneShotTimerDispatch;
+
     // Enum to track in what state is the timer.
     enum class TimerState {
-        // The internal timer thread has been destroyed, and no state is
-        // tracked.
+        // The timer is not registered with the dispatch thread, and no state
+        // is tracked.
         // Possible state transitions: RESET
         STOPPED = 0,
-        // An external thread has just reset this timer.
-        // If there is a reset callback, then that callback is fired.
+        // An external thread has just started or reset this timer. The
+        // dispatch thread fires the reset callback, if any, and arms the
+        // timeout.
         // Possible state transitions: STOPPED, WAITING
         RESET = 1,
         // This timer is waiting for the timeout interval to expire.
@@ -76,22 +85,9 @@ private:
         IDLE = 3
     };
 
-    // Function that loops until the condition for stopping is met.
-    void loop();
-
-    // Checks whether mResetTriggered and mStopTriggered were set and updates
-    // mState if so.
-    TimerState checkForResetAndStop(TimerState state);
-
-    // Thread waiting for timer to expire.
-    std::thread mThread;
-
     // Clock object for the timer. Mocked in unit tests.
     std::unique_ptr<android::Clock> mClock;
 
-    // Semaphore to keep mThread synchronized.
-    sem_t mSemaphore;
-
     // Timer's name.
     std::string mName;
 
@@ -104,14 +100,10 @@ private:
     // Callback that happens when timer expires.
     const TimeoutCallback mTimeoutCallback;
 
-    // After removing lock guarding mState, the state can be now accessed at
-    // any time. Keep a bool if the reset or stop were requested, and occasionally
-    // check in the main loop if they were.
-    std::atomic<bool> mResetTriggered = false;
-    std::atomic<bool> mStopTriggered = false;
-    std::atomic<bool> mWaiting = false;
-    std::atomic<bool> mPaused = false;
-    std::atomic<std::chrono::steady_clock::time_point> mLastResetTime;
+    // State below is guarded by the dispatch thread's lock.
+    TimerState mState = TimerState::STOPPED;
+    std::chrono::steady_clock::time_point mDeadline;
+    bool mPaused = false;
 };
 
 } // namespace scheduler
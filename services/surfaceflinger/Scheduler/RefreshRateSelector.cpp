@@ -21,6 +21,7 @@
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wextra"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <deque>
@@ -476,17 +477,29 @@ float RefreshRateSelector::calculateLayerScoreLocked(const LayerRequirement& lay
 auto RefreshRateSelector::getRankedFrameRates(const std::vector<LayerRequirement>& layers,
                                               GlobalSignals signals, Fps pacesetterFps) const
         -> RankedFrameRates {
-    GetRankedFrameRatesCache cache{layers, signals, pacesetterFps};
-
     std::lock_guard lock(mLock);
 
-    if (mGetRankedFrameRatesCache && mGetRankedFrameRatesCache->matches(cache)) {
-        return mGetRankedFrameRatesCache->result;
+    const auto matches = [&](const GetRankedFrameRatesCache& cache) {
+        return cache.layers == layers && cache.signals == signals &&
+                isApproxEqual(cache.pacesetterFps, pacesetterFps);
+    };
+
+    if (const auto it = std::find_if(mGetRankedFrameRatesCache.begin(),
+                                     mGetRankedFrameRatesCache.end(), matches);
+        it != mGetRankedFrameRatesCache.end()) {
+        // Keep the cache in MRU order, since scroll start/stop tends to alternate between a
+        // small set of signatures.
+        std::rotate(mGetRankedFrameRatesCache.begin(), it, it + 1);
+        return mGetRankedFrameRatesCache.front().result;
     }
 
+    GetRankedFrameRatesCache cache{layers, signals, pacesetterFps};
     cache.result = getRankedFrameRatesLocked(layers, signals, pacesetterFps);
-    mGetRankedFrameRatesCache = std::move(cache);
-    return mGetRankedFrameRatesCache->result;
+    if (mGetRankedFrameRatesCache.size() == kMaxGetRankedFrameRatesCacheEntries) {
+        mGetRankedFrameRatesCache.pop_back();
+    }
+    mGetRankedFrameRatesCache.insert(mGetRankedFrameRatesCache.begin(), std::move(cache));
+    return mGetRankedFrameRatesCache.front().result;
 }
 
 auto RefreshRateSelector::getRankedFrameRatesLocked(const std::vector<LayerRequirement>& layers,
@@ -1249,7 +1262,7 @@ void RefreshRateSelector::setActiveMode(DisplayModeId modeId, Fps renderFrameRat
 
     // Invalidate the cached invocation to getRankedFrameRates. This forces
     // the refresh rate to be recomputed on the next call to getRankedFrameRates.
-    mGetRankedFrameRatesCache.reset();
+    mGetRankedFrameRatesCache.clear();
 
     const auto activeModeOpt = mDisplayModes.get(modeId);
     LOG_ALWAYS_FATAL_IF(!activeModeOpt);
@@ -1290,7 +1303,7 @@ void RefreshRateSelector::updateDisplayModes(DisplayModes modes, DisplayModeId a
 
     // Invalidate the cached invocation to getRankedFrameRates. This forces
     // the refresh rate to be recomputed on the next call to getRankedFrameRates.
-    mGetRankedFrameRatesCache.reset();
+    mGetRankedFrameRatesCache.clear();
 
     mDisplayModes = std::move(modes);
     const auto activeModeOpt = mDisplayModes.get(activeModeId);
@@ -1319,6 +1332,9 @@ void RefreshRateSelector::updateDisplayModes(DisplayModes modes, DisplayModeId a
         }
     }();
 
+    mCanSwitch = mDisplayModes.size() > 1 ||
+            mFrameRateOverrideConfig == Config::FrameRateOverride::Enabled;
+
     if (mConfig.enableFrameRateOverride ==
         Config::FrameRateOverride::AppOverrideNativeRefreshRates) {
         for (const auto& [_, mode] : mDisplayModes) {
@@ -1390,7 +1406,7 @@ auto RefreshRateSelector::setPolicy(const PolicyVariant& policy) -> SetPolicyRes
             return SetPolicyResult::Invalid;
         }
 
-        mGetRankedFrameRatesCache.reset();
+        mGetRankedFrameRatesCache.clear();
 
         const auto& idleScreenConfigOpt = getCurrentPolicyLocked()->idleScreenConfigOpt;
         if (idleScreenConfigOpt != oldPolicy.idleScreenConfigOpt) {
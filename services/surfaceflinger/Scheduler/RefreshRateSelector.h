@@ -328,16 +328,13 @@ public:
         return mDisplayModes;
     }
 
-    // Returns whether switching modes (refresh rate or resolution) is possible.
+    // Returns whether switching modes (refresh rate or resolution) is possible. Lock-free, as
+    // this is queried for every layer update recorded on the latch path.
     // TODO(b/158780872): Consider HAL support, and skip frame rate detection if the modes only
     //  differ in resolution. Once Config::FrameRateOverride::Enabled becomes the default,
     //  we can probably remove canSwitch altogether since all devices will be able
     //  to switch to a frame rate divisor.
-    bool canSwitch() const EXCLUDES(mLock) {
-        std::lock_guard lock(mLock);
-        return mDisplayModes.size() > 1 ||
-                mFrameRateOverrideConfig == Config::FrameRateOverride::Enabled;
-    }
+    bool canSwitch() const { return mCanSwitch; }
 
     // Class to enumerate options around toggling the kernel timer on and off.
     enum class KernelIdleTimerAction {
@@ -547,6 +544,10 @@ private:
     // Caches whether the device is VRR-compatible based on the active display mode.
     std::atomic_bool mIsVrrDevice = false;
 
+    // Caches whether mode switching is possible, based on the display modes and the frame rate
+    // override config, so that canSwitch() does not take mLock.
+    std::atomic_bool mCanSwitch = false;
+
     Policy mDisplayManagerPolicy GUARDED_BY(mLock);
     std::optional<Policy> mOverridePolicy GUARDED_BY(mLock);
 
@@ -573,13 +574,14 @@ private:
         Fps pacesetterFps;
 
         RankedFrameRates result;
-
-        bool matches(const GetRankedFrameRatesCache& other) const {
-            return layers == other.layers && signals == other.signals &&
-                    isApproxEqual(pacesetterFps, other.pacesetterFps);
-        }
     };
-    mutable std::optional<GetRankedFrameRatesCache> mGetRankedFrameRatesCache GUARDED_BY(mLock);
+
+    static constexpr size_t kMaxGetRankedFrameRatesCacheEntries = 4;
+
+    // Memoized invocations of getRankedFrameRates, in MRU order. Interactions such as scroll
+    // start/stop alternate between a small set of (layers, signals) signatures, so keep a few
+    // recent entries rather than only the last one.
+    mutable std::vector<GetRankedFrameRatesCache> mGetRankedFrameRatesCache GUARDED_BY(mLock);
 
     // Declare mIdleTimer last to ensure its thread joins before the mutex/callbacks are destroyed.
     std::mutex mIdleTimerCallbacksMutex;
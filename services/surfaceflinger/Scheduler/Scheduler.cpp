@@ -38,8 +38,10 @@
 #include <FrameTimeline/FrameTimeline.h>
 #include <scheduler/interface/ICompositor.h>
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -136,6 +138,15 @@ void Scheduler::registerDisplay(PhysicalDisplayId displayId, RefreshRateSelector
                                                 onHardwareVsyncRequest(id, enable);
                                             });
 
+    // Warm the phase offset cache for every switchable mode now, so a mode switch only
+    // looks up precomputed configs instead of deriving them inline on the main thread.
+    // LTPO panels switch modes frequently, and lazily deriving offsets on first use of
+    // each rate would put that work in the middle of a switch.
+    for (const auto& [modeId, modePtr] : selectorPtr->displayModes()) {
+        mVsyncConfiguration->getConfigsForRefreshRate(modePtr->getVsyncRate());
+        mVsyncConfiguration->getConfigsForRefreshRate(modePtr->getPeakFps());
+    }
+
     registerDisplayInternal(displayId, std::move(selectorPtr), std::move(schedulePtr),
                             activeDisplayId);
 }
@@ -349,6 +360,42 @@ void Scheduler::onExpectedPresentTimePosted(TimePoint expectedPresentTime) {
     }
 }
 
+void Scheduler::recordPresentTimeError(FrameTime lastSignaledFrameTime) {
+    const auto [signalTime, expectedPresentTime] = lastSignaledFrameTime;
+    if (signalTime.ns() <= 0 || expectedPresentTime.ns() <= 0) {
+        return;
+    }
+    // The same signaled fence can be observed by several consecutive frames; only fold
+    // each sample in once.
+    if (mLastPresentErrorSignalTime.exchange(signalTime.ns(), std::memory_order_relaxed) ==
+        signalTime.ns()) {
+        return;
+    }
+
+    const nsecs_t error = signalTime.ns() - expectedPresentTime.ns();
+
+    // An error of half a period or more means the frame missed its vsync entirely; that
+    // is jank, not steady-state latency drift, and would poison the average.
+    const Period period = getVsyncSchedule()->period();
+    if (std::abs(error) >= period.ns() / 2) {
+        return;
+    }
+
+    const nsecs_t ewma = mPresentErrorEwmaNs.load(std::memory_order_relaxed);
+    mPresentErrorEwmaNs.store(ewma - ewma / 8 + error / 8, std::memory_order_relaxed);
+}
+
+Duration Scheduler::getPresentLatencyBias() const {
+    constexpr nsecs_t kDeadband = 500'000;  // ignore noise below 0.5ms
+    constexpr nsecs_t kMaxBias = 3'000'000; // trust the average for at most 3ms of drift
+
+    const nsecs_t bias = mPresentErrorEwmaNs.load(std::memory_order_relaxed);
+    if (std::abs(bias) < kDeadband) {
+        return Duration::zero();
+    }
+    return Duration::fromNs(std::clamp(bias, -kMaxBias, kMaxBias));
+}
+
 void Scheduler::createEventThread(Cycle cycle, frametimeline::TokenManager* tokenManager,
                                   std::chrono::nanoseconds workDuration,
                                   std::chrono::nanoseconds readyDuration) {
@@ -426,6 +473,13 @@ void Scheduler::onHdcpLevelsChanged(Cycle cycle, PhysicalDisplayId displayId,
     eventThreadFor(cycle).onHdcpLevelsChanged(displayId, connectedLevel, maxLevel);
 }
 
+void Scheduler::setVsyncDeliveryClassForUid(uid_t uid, VsyncDeliveryClass deliveryClass) {
+    if (!hasEventThreads()) {
+        return;
+    }
+    eventThreadFor(Cycle::Render).setVsyncDeliveryClassForUid(uid, deliveryClass);
+}
+
 bool Scheduler::onDisplayModeChanged(PhysicalDisplayId displayId, const FrameRateMode& mode) {
     const bool isPacesetter =
             FTL_FAKE_GUARD(kMainThreadContext,
@@ -682,7 +736,11 @@ void Scheduler::onLayerDestroyed(Layer* layer) {
 
 void Scheduler::recordLayerHistory(int32_t id, const LayerProps& layerProps, nsecs_t presentTime,
                                    nsecs_t now, LayerHistory::LayerUpdateType updateType) {
-    if (pacesetterSelectorPtr()->canSwitch()) {
+    // No need to lock for reads on kMainThreadContext: recording happens on the commit/latch
+    // path on the main thread, which is also where displays are registered, so the pacesetter
+    // cannot change underneath us. canSwitch() is lock-free, so a latch never blocks on display
+    // registration or the selection pass.
+    if (FTL_FAKE_GUARD(mDisplayLock, pacesetterSelectorPtrLocked())->canSwitch()) {
         mLayerHistory.record(id, layerProps, presentTime, now, updateType);
     }
 }
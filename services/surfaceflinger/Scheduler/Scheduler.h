@@ -157,6 +157,10 @@ public:
 
     void onHdcpLevelsChanged(Cycle, PhysicalDisplayId, int32_t, int32_t);
 
+    // Demotes (or re-promotes) app vsync delivery for all choreographer connections of a uid.
+    // Background uids receive decimated vsync callbacks; see VsyncDeliveryClass.
+    void setVsyncDeliveryClassForUid(uid_t uid, VsyncDeliveryClass deliveryClass);
+
     // Modifies work duration in the event thread.
     void setDuration(Cycle, std::chrono::nanoseconds workDuration,
                      std::chrono::nanoseconds readyDuration);
@@ -214,6 +218,11 @@ public:
     void addPresentFence(PhysicalDisplayId, std::shared_ptr<FenceTime>)
             REQUIRES(kMainThreadContext);
 
+    // Feeds the pacesetter's latest signaled present fence together with the vsync it
+    // targeted, so the scheduler can learn how far actual presents drift from the
+    // modeled timeline. See getPresentLatencyBias().
+    void recordPresentTimeError(FrameTime lastSignaledFrameTime) REQUIRES(kMainThreadContext);
+
     // Layers are registered on creation, and unregistered when the weak reference expires.
     void registerLayer(Layer*, FrameRateCompatibility);
     void recordLayerHistory(int32_t id, const LayerProps& layerProps, nsecs_t presentTime,
@@ -461,12 +470,20 @@ private:
     Period getVsyncPeriod(uid_t) override EXCLUDES(mDisplayLock);
     void resync() override EXCLUDES(mDisplayLock);
     void onExpectedPresentTimePosted(TimePoint expectedPresentTime) override EXCLUDES(mDisplayLock);
+    Duration getPresentLatencyBias() const override;
 
     std::unique_ptr<EventThread> mRenderEventThread;
     std::unique_ptr<EventThread> mLastCompositeEventThread;
 
     std::atomic<nsecs_t> mLastResyncTime = 0;
 
+    // Exponentially weighted moving average of the signed error between present-fence
+    // signal times and the vsyncs they targeted, and the signal time of the last sample
+    // folded in (to avoid double-counting a fence reported on consecutive frames).
+    // Written on the main thread, read from EventThread via getPresentLatencyBias().
+    std::atomic<nsecs_t> mPresentErrorEwmaNs = 0;
+    std::atomic<nsecs_t> mLastPresentErrorSignalTime = 0;
+
     const FeatureFlags mFeatures;
 
     // Stores phase offsets configured per refresh rate.
@@ -20,26 +20,31 @@
 namespace android::scheduler {
 void SmallAreaDetectionAllowMappings::update(
         std::vector<std::pair<int32_t, float>>& appIdThresholdMappings) {
-    std::lock_guard lock(mLock);
-    mMap.clear();
+    auto map = std::make_shared<AppIdThresholdMap>();
     for (std::pair<int32_t, float> row : appIdThresholdMappings) {
         if (!isValidThreshold(row.second)) continue;
 
-        mMap.emplace(row.first, row.second);
+        map->emplace(row.first, row.second);
     }
+    std::lock_guard lock(mWriteLock);
+    std::atomic_store_explicit(&mMap, std::shared_ptr<const AppIdThresholdMap>(std::move(map)),
+                               std::memory_order_release);
 }
 
 void SmallAreaDetectionAllowMappings::setThresholdForAppId(int32_t appId, float threshold) {
     if (!isValidThreshold(threshold)) return;
 
-    std::lock_guard lock(mLock);
-    mMap.emplace(appId, threshold);
+    std::lock_guard lock(mWriteLock);
+    auto map = std::make_shared<AppIdThresholdMap>(*load());
+    map->emplace(appId, threshold);
+    std::atomic_store_explicit(&mMap, std::shared_ptr<const AppIdThresholdMap>(std::move(map)),
+                               std::memory_order_release);
 }
 
-std::optional<float> SmallAreaDetectionAllowMappings::getThresholdForAppId(int32_t appId) {
-    std::lock_guard lock(mLock);
-    const auto iter = mMap.find(appId);
-    if (iter != mMap.end()) {
+std::optional<float> SmallAreaDetectionAllowMappings::getThresholdForAppId(int32_t appId) const {
+    const std::shared_ptr<const AppIdThresholdMap> map = load();
+    const auto iter = map->find(appId);
+    if (iter != map->end()) {
         return iter->second;
     }
     return std::nullopt;
@@ -16,8 +16,9 @@
 
 #pragma once
 
-#include <android-base/thread_annotations.h>
 #include <sys/types.h>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -28,12 +29,20 @@ class SmallAreaDetectionAllowMappings {
 
 public:
     void update(std::vector<std::pair<int32_t, float>>& appIdThresholdMappings);
-    void setThresholdForAppId(int32_t appId, float threshold) EXCLUDES(mLock);
-    std::optional<float> getThresholdForAppId(int32_t uid) EXCLUDES(mLock);
+    void setThresholdForAppId(int32_t appId, float threshold);
+    std::optional<float> getThresholdForAppId(int32_t appId) const;
 
 private:
     static bool isValidThreshold(float threshold) { return threshold >= 0.0f && threshold <= 1.0f; }
-    mutable std::mutex mLock;
-    AppIdThresholdMap mMap GUARDED_BY(mLock);
+
+    // The map is consulted per frame by LayerHistory, so readers atomically
+    // load the current immutable snapshot instead of locking; writers build a
+    // replacement map and swap it in. The lock only serializes writers.
+    std::shared_ptr<const AppIdThresholdMap> load() const {
+        return std::atomic_load_explicit(&mMap, std::memory_order_acquire);
+    }
+
+    std::mutex mWriteLock;
+    std::shared_ptr<const AppIdThresholdMap> mMap = std::make_shared<const AppIdThresholdMap>();
 };
 } // namespace android::scheduler
@@ -45,6 +45,10 @@ using base::StringAppendF;
 
 static auto constexpr kMaxPercent = 100u;
 
+// How far (as a percentage of the vsync period) a timestamp may land from the
+// model's predicted phase and still be considered plain hardware jitter.
+static auto constexpr kJitterTolerancePercent = 1u;
+
 namespace {
 int numVsyncsPerFrame(const ftl::NonNull<DisplayModePtr>& displayModePtr) {
     const auto idealPeakRefreshPeriod = displayModePtr->getPeakFps().getPeriodNsecs();
@@ -164,6 +168,7 @@ bool VSyncPredictor::addVsyncTimestamp(nsecs_t timestamp) {
         } else {
             mKnownTimestamp = timestamp;
         }
+        mInPhaseStreak = 0;
         SFTRACE_FORMAT_INSTANT("timestamp rejected. mKnownTimestamp was %.2fms ago",
                                (mClock->now() - *mKnownTimestamp) / 1e6f);
         return false;
@@ -185,6 +190,31 @@ bool VSyncPredictor::addVsyncTimestamp(nsecs_t timestamp) {
         return true;
     }
 
+    // Once the ring is full and a long run of samples has landed within the
+    // hardware-jitter tolerance of the model's phase, a new in-phase sample
+    // carries no information the model doesn't already have. Skip the O(N)
+    // refit in that steady state so each HWC vsync callback is O(1); the
+    // first out-of-tolerance sample resets the streak and resumes refitting.
+    if (mTimestamps.size() == kHistorySize) {
+        const auto& model = mRateMap.find(idealPeriod())->second;
+        if (model.slope != 0) {
+            // The ring is ordered by insertion, so the slot after the newest
+            // timestamp holds the oldest.
+            const nsecs_t oldest = mTimestamps[next(mLastTimestampIndex)];
+            nsecs_t phase = (timestamp - oldest - model.intercept) % model.slope;
+            if (phase < 0) phase += model.slope;
+            const nsecs_t distance = std::min(phase, model.slope - phase);
+            if (distance * kMaxPercent <= model.slope * kJitterTolerancePercent) {
+                if (++mInPhaseStreak >= kHistorySize) {
+                    SFTRACE_FORMAT_INSTANT("VSP: in-phase sample, skipping refit");
+                    return true;
+                }
+            } else {
+                mInPhaseStreak = 0;
+            }
+        }
+    }
+
     // This is a 'simple linear regression' calculation of Y over X, with Y being the
     // vsync timestamps, and X being the ordinal of vsync count.
     // The calculated slope is the vsync period.
@@ -587,6 +617,7 @@ void VSyncPredictor::clearTimestamps(bool clearTimelines) {
 
         mTimestamps.clear();
         mLastTimestampIndex = 0;
+        mInPhaseStreak = 0;
     }
 
     mIdealPeriod = Period::fromNs(idealPeriod());
@@ -158,6 +158,9 @@ private:
 
     size_t mLastTimestampIndex GUARDED_BY(mMutex) = 0;
     std::vector<nsecs_t> mTimestamps GUARDED_BY(mMutex);
+    // Consecutive timestamps that landed within the jitter tolerance of the
+    // model's phase; once long enough, refits are skipped as no-ops.
+    size_t mInPhaseStreak GUARDED_BY(mMutex) = 0;
 
     ftl::NonNull<DisplayModePtr> mDisplayModePtr GUARDED_BY(mMutex);
     int mNumVsyncsForFrame GUARDED_BY(mMutex);
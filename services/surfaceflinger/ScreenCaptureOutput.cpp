@@ -83,6 +83,11 @@ renderengine::DisplaySettings ScreenCaptureOutput::generateClientCompositionDisp
             compositionengine::impl::Output::generateClientCompositionDisplaySettings(buffer);
     clientCompositionDisplay.clip = mRenderArea.getSourceCrop();
 
+    // Captures are one-shot renders: let a threaded RenderEngine service queued
+    // composition draws first so captures never add latency to the frame path.
+    clientCompositionDisplay.queuePriority =
+            renderengine::DisplaySettings::QueuePriority::Background;
+
     auto renderIntent = static_cast<ui::RenderIntent>(clientCompositionDisplay.renderIntent);
     if (mDimInGammaSpaceForEnhancedScreenshots && renderIntent != ui::RenderIntent::COLORIMETRIC &&
         renderIntent != ui::RenderIntent::TONE_MAP_COLORIMETRIC) {
@@ -77,6 +77,7 @@
 #include <layerproto/LayerProtoHeader.h>
 #include <linux/sched/types.h>
 #include <log/log.h>
+#include <malloc.h>
 #include <private/android_filesystem_config.h>
 #include <private/gui/SyncFeatures.h>
 #include <processgroup/processgroup.h>
@@ -108,6 +109,7 @@
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -487,6 +489,11 @@ SurfaceFlinger::SurfaceFlinger(Factory& factory) : SurfaceFlinger(factory, SkipI
     mBackpressureGpuComposition = base::GetBoolProperty("debug.sf.enable_gl_backpressure"s, true);
     ALOGI_IF(mBackpressureGpuComposition, "Enabling backpressure for GPU composition");
 
+    mDedicatedCaptureRenderEngine =
+            base::GetBoolProperty("debug.sf.dedicated_capture_render_engine"s, false);
+    ALOGI_IF(mDedicatedCaptureRenderEngine,
+             "Rendering screen captures on a dedicated RenderEngine");
+
     property_get("ro.surface_flinger.supports_background_blur", value, "0");
     bool supportsBlurs = atoi(value);
     mSupportsBlur = supportsBlurs;
@@ -900,6 +907,24 @@ renderengine::RenderEngine::BlurAlgorithm chooseBlurAlgorithm(bool supportsBlur)
     }
 }
 
+renderengine::RenderEngine& SurfaceFlinger::getCaptureRenderEngine() {
+    std::call_once(mCaptureRenderEngineInit, [this] {
+        // Mirrors the composition engine's configuration, but at MEDIUM priority and with a
+        // minimal image cache: captures are sporadic, and must not preempt composition work.
+        auto builder = renderengine::RenderEngineCreationArgs::Builder()
+                               .setPixelFormat(static_cast<int32_t>(defaultCompositionPixelFormat))
+                               .setImageCacheSize(2)
+                               .setEnableProtectedContext(enable_protected_contents(false))
+                               .setPrecacheToneMapperShaderOnly(false)
+                               .setBlurAlgorithm(chooseBlurAlgorithm(mSupportsBlur))
+                               .setContextPriority(
+                                       renderengine::RenderEngine::ContextPriority::MEDIUM);
+        chooseRenderEngineType(builder);
+        mCaptureRenderEngine = renderengine::RenderEngine::create(builder.build());
+    });
+    return *mCaptureRenderEngine;
+}
+
 void SurfaceFlinger::init() FTL_FAKE_GUARD(kMainThreadContext) {
     SFTRACE_CALL();
     ALOGI(  "SurfaceFlinger's main thread ready to run. "
@@ -923,14 +948,58 @@ void SurfaceFlinger::init() FTL_FAKE_GUARD(kMainThreadContext) {
     chooseRenderEngineType(builder);
     mRenderEngine = renderengine::RenderEngine::create(builder.build());
     mCompositionEngine->setRenderEngine(mRenderEngine.get());
-    mMaxRenderTargetSize =
-            std::min(getRenderEngine().getMaxTextureSize(), getRenderEngine().getMaxViewportDims());
 
     // Set SF main policy after initializing RenderEngine which has its own policy.
     if (!SetTaskProfiles(0, {"SFMainPolicy"})) {
         ALOGW("Failed to set main task profile");
     }
 
+    // Kick off shader cache priming now, so that context creation and priming on the
+    // RenderEngine thread overlap display bring-up below instead of delaying the first
+    // composited frame. The future is waited on in bootFinished.
+    if (base::GetBoolProperty("service.sf.prime_shader_cache"s, true)) {
+        if (setSchedFifo(false) != NO_ERROR) {
+            ALOGW("Can't set SCHED_OTHER for primeCache");
+        }
+
+        mRenderEnginePrimeCacheFuture.callOnce([this] {
+            renderengine::PrimeCacheConfig config;
+            config.cacheHolePunchLayer =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.hole_punch"s, true);
+            config.cacheSolidLayers =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.solid_layers"s, true);
+            config.cacheSolidDimmedLayers =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.solid_dimmed_layers"s, true);
+            config.cacheImageLayers =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.image_layers"s, true);
+            config.cacheImageDimmedLayers =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.image_dimmed_layers"s, true);
+            config.cacheClippedLayers =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.clipped_layers"s, true);
+            config.cacheShadowLayers =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.shadow_layers"s, true);
+            config.cachePIPImageLayers =
+                    base::GetBoolProperty("debug.sf.prime_shader_cache.pip_image_layers"s, true);
+            config.cacheTransparentImageDimmedLayers = base::
+                    GetBoolProperty("debug.sf.prime_shader_cache.transparent_image_dimmed_layers"s,
+                                    true);
+            config.cacheClippedDimmedImageLayers = base::
+                    GetBoolProperty("debug.sf.prime_shader_cache.clipped_dimmed_image_layers"s,
+                                    true);
+            // ro.surface_flinger.prime_chader_cache.ultrahdr exists as a previous ro property
+            // which we maintain for backwards compatibility.
+            config.cacheUltraHDR =
+                    base::GetBoolProperty("ro.surface_flinger.prime_shader_cache.ultrahdr"s, false);
+            config.cacheEdgeExtension =
+                    base::GetBoolProperty("debug.sf.edge_extension_shader"s, true);
+            return getRenderEngine().primeCache(config);
+        });
+
+        if (setSchedFifo(true) != NO_ERROR) {
+            ALOGW("Can't set SCHED_FIFO after primeCache");
+        }
+    }
+
     mCompositionEngine->setTimeStats(mTimeStats);
 
     mCompositionEngine->setHwComposer(getFactory().createHWComposer(mHwcServiceName));
@@ -1016,48 +1085,11 @@ void SurfaceFlinger::init() FTL_FAKE_GUARD(kMainThreadContext) {
 
     mPowerAdvisor->init();
 
-    if (base::GetBoolProperty("service.sf.prime_shader_cache"s, true)) {
-        if (setSchedFifo(false) != NO_ERROR) {
-            ALOGW("Can't set SCHED_OTHER for primeCache");
-        }
-
-        mRenderEnginePrimeCacheFuture.callOnce([this] {
-            renderengine::PrimeCacheConfig config;
-            config.cacheHolePunchLayer =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.hole_punch"s, true);
-            config.cacheSolidLayers =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.solid_layers"s, true);
-            config.cacheSolidDimmedLayers =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.solid_dimmed_layers"s, true);
-            config.cacheImageLayers =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.image_layers"s, true);
-            config.cacheImageDimmedLayers =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.image_dimmed_layers"s, true);
-            config.cacheClippedLayers =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.clipped_layers"s, true);
-            config.cacheShadowLayers =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.shadow_layers"s, true);
-            config.cachePIPImageLayers =
-                    base::GetBoolProperty("debug.sf.prime_shader_cache.pip_image_layers"s, true);
-            config.cacheTransparentImageDimmedLayers = base::
-                    GetBoolProperty("debug.sf.prime_shader_cache.transparent_image_dimmed_layers"s,
-                                    true);
-            config.cacheClippedDimmedImageLayers = base::
-                    GetBoolProperty("debug.sf.prime_shader_cache.clipped_dimmed_image_layers"s,
-                                    true);
-            // ro.surface_flinger.prime_chader_cache.ultrahdr exists as a previous ro property
-            // which we maintain for backwards compatibility.
-            config.cacheUltraHDR =
-                    base::GetBoolProperty("ro.surface_flinger.prime_shader_cache.ultrahdr"s, false);
-            config.cacheEdgeExtension =
-                    base::GetBoolProperty("debug.sf.edge_extension_shader"s, true);
-            return getRenderEngine().primeCache(config);
-        });
-
-        if (setSchedFifo(true) != NO_ERROR) {
-            ALOGW("Can't set SCHED_FIFO after primeCache");
-        }
-    }
+    // Query the render target limits only after display bring-up: this blocks until the
+    // RenderEngine context is initialized, which has been running concurrently with the
+    // work above.
+    mMaxRenderTargetSize =
+            std::min(getRenderEngine().getMaxTextureSize(), getRenderEngine().getMaxViewportDims());
 
     // Avoid blocking the main thread on `init` to set properties.
     mInitBootPropsFuture.callOnce([this] {
@@ -2445,6 +2477,13 @@ bool SurfaceFlinger::updateLayerSnapshots(VsyncId vsyncId, nsecs_t frameTimeNs,
         mLayerHierarchyBuilder.update(mLayerLifecycleManager);
     }
 
+    // Advance compositor-side animations before building snapshots so this
+    // frame picks up the interpolated state, and keep committing until the
+    // last animation has produced its end state.
+    if (mLayerLifecycleManager.advanceAnimations(frameTimeNs)) {
+        scheduleCommit(FrameHint::kActive);
+    }
+
     // Keep a copy of the drawing state (that is going to be overwritten
     // by commitTransactionsLocked) outside of mStateLock so that the side
     // effects of the State assignment don't happen with mStateLock held,
@@ -2502,76 +2541,97 @@ bool SurfaceFlinger::updateLayerSnapshots(VsyncId vsyncId, nsecs_t frameTimeNs,
     const nsecs_t latchTime = systemTime();
     bool unused = false;
 
-    for (auto& layer : mLayerLifecycleManager.getLayers()) {
-        if (layer->changes.test(frontend::RequestedLayerState::Changes::Created) &&
-            layer->bgColorLayer) {
-            sp<Layer> bgColorLayer = getFactory().createEffectLayer(
-                    LayerCreationArgs(this, nullptr, layer->name,
-                                      ISurfaceComposerClient::eFXSurfaceEffect, LayerMetadata(),
-                                      std::make_optional(layer->id), true));
-            mLegacyLayers[bgColorLayer->sequence] = bgColorLayer;
-        }
-        const bool willReleaseBufferOnLatch = layer->willReleaseBufferOnLatch();
-
-        auto it = mLegacyLayers.find(layer->id);
-        if (it == mLegacyLayers.end() &&
-            layer->changes.test(frontend::RequestedLayerState::Changes::Destroyed)) {
-            // Layer handle was created and immediately destroyed. It was destroyed before it
-            // was added to the map.
-            continue;
-        }
+    // When this frame provably carries no layer deltas - no transactions were applied,
+    // the lifecycle manager accumulated no changes, display info is unchanged, and no
+    // layer is in auto-refresh - every step of the per-layer walk below is a no-op.
+    // Skipping it keeps empty commits on static scenes from scaling with layer count.
+    const bool hasFrontEndChanges = !update.transactions.empty() ||
+            mLayerLifecycleManager.getGlobalChanges().get() != 0 || mFrontEndDisplayInfosChanged;
+    if (hasFrontEndChanges || mHasAutoRefreshLayers) {
+        bool hasAutoRefreshLayers = false;
+
+        for (auto& layer : mLayerLifecycleManager.getLayers()) {
+            // Auto-refresh layers need a latch walk every frame, even without deltas.
+            hasAutoRefreshLayers |= layer->autoRefresh;
+            if (layer->changes.test(frontend::RequestedLayerState::Changes::Created) &&
+                layer->bgColorLayer) {
+                sp<Layer> bgColorLayer = getFactory().createEffectLayer(
+                        LayerCreationArgs(this, nullptr, layer->name,
+                                          ISurfaceComposerClient::eFXSurfaceEffect, LayerMetadata(),
+                                          std::make_optional(layer->id), true));
+                mLegacyLayers[bgColorLayer->sequence] = bgColorLayer;
+            }
+            const bool willReleaseBufferOnLatch = layer->willReleaseBufferOnLatch();
+
+            auto it = mLegacyLayers.find(layer->id);
+            if (it == mLegacyLayers.end() &&
+                layer->changes.test(frontend::RequestedLayerState::Changes::Destroyed)) {
+                // Layer handle was created and immediately destroyed. It was destroyed before it
+                // was added to the map.
+                continue;
+            }
 
-        LLOG_ALWAYS_FATAL_WITH_TRACE_IF(it == mLegacyLayers.end(),
-                                        "Couldnt find layer object for %s",
-                                        layer->getDebugString().c_str());
-        if (!layer->hasReadyFrame() && !willReleaseBufferOnLatch) {
-            if (!it->second->hasBuffer()) {
-                // The last latch time is used to classify a missed frame as buffer stuffing
-                // instead of a missed frame. This is used to identify scenarios where we
-                // could not latch a buffer or apply a transaction due to backpressure.
-                // We only update the latch time for buffer less layers here, the latch time
-                // is updated for buffer layers when the buffer is latched.
-                it->second->updateLastLatchTime(latchTime);
+            LLOG_ALWAYS_FATAL_WITH_TRACE_IF(it == mLegacyLayers.end(),
+                                            "Couldnt find layer object for %s",
+                                            layer->getDebugString().c_str());
+            if (!layer->hasReadyFrame() && !willReleaseBufferOnLatch) {
+                if (!it->second->hasBuffer()) {
+                    // The last latch time is used to classify a missed frame as buffer stuffing
+                    // instead of a missed frame. This is used to identify scenarios where we
+                    // could not latch a buffer or apply a transaction due to backpressure.
+                    // We only update the latch time for buffer less layers here, the latch time
+                    // is updated for buffer layers when the buffer is latched.
+                    it->second->updateLastLatchTime(latchTime);
+                }
+                continue;
             }
-            continue;
-        }
 
-        const bool bgColorOnly =
-                !layer->externalTexture && (layer->bgColorLayerId != UNASSIGNED_LAYER_ID);
-        if (willReleaseBufferOnLatch) {
-            mLayersWithBuffersRemoved.emplace(it->second);
+            const bool bgColorOnly =
+                    !layer->externalTexture && (layer->bgColorLayerId != UNASSIGNED_LAYER_ID);
+            if (willReleaseBufferOnLatch) {
+                mLayersWithBuffersRemoved.emplace(it->second);
+            }
+            it->second->latchBufferImpl(unused, latchTime, bgColorOnly);
+            newDataLatched = true;
+
+            frontend::LayerSnapshot* snapshot =
+                    mLayerSnapshotBuilder.getSnapshot(it->second->sequence);
+            gui::GameMode gameMode = (snapshot) ? snapshot->gameMode : gui::GameMode::Unsupported;
+            mLayersWithQueuedFrames.emplace(it->second, gameMode);
+            mLayersIdsWithQueuedFrames.emplace(it->second->sequence);
+        }
+
+        updateLayerHistory(latchTime);
+        Region frameDamage;
+        mLayerSnapshotBuilder.forEachSnapshot([&](const frontend::LayerSnapshot& snapshot) {
+            // update output dirty region if we have a queued buffer that is visible or a snapshot
+            // recently became invisible
+            // TODO(b/360050020) investigate if we need to update dirty region when layer color changes
+            if ((snapshot.isVisible &&
+                 (mLayersIdsWithQueuedFrames.find(snapshot.path.id) !=
+                  mLayersIdsWithQueuedFrames.end())) ||
+                (!snapshot.isVisible && snapshot.changes.test(Changes::Visibility))) {
+                Region visibleReg;
+                visibleReg.set(snapshot.transformedBoundsWithoutTransparentRegion);
+                invalidateLayerStack(snapshot.outputFilter, visibleReg);
+                frameDamage.orSelf(visibleReg);
+            }
+        });
+        if (mLumaSampling && mRegionSamplingThread && !frameDamage.isEmpty()) {
+            // Let the sampling engine decide whether this frame's damage
+            // touches any registered sampling area.
+            mRegionSamplingThread->onCommitDamage(frameDamage);
         }
-        it->second->latchBufferImpl(unused, latchTime, bgColorOnly);
-        newDataLatched = true;
 
-        frontend::LayerSnapshot* snapshot = mLayerSnapshotBuilder.getSnapshot(it->second->sequence);
-        gui::GameMode gameMode = (snapshot) ? snapshot->gameMode : gui::GameMode::Unsupported;
-        mLayersWithQueuedFrames.emplace(it->second, gameMode);
-        mLayersIdsWithQueuedFrames.emplace(it->second->sequence);
-    }
-
-    updateLayerHistory(latchTime);
-    mLayerSnapshotBuilder.forEachSnapshot([&](const frontend::LayerSnapshot& snapshot) {
-        // update output dirty region if we have a queued buffer that is visible or a snapshot
-        // recently became invisible
-        // TODO(b/360050020) investigate if we need to update dirty region when layer color changes
-        if ((snapshot.isVisible &&
-             (mLayersIdsWithQueuedFrames.find(snapshot.path.id) !=
-              mLayersIdsWithQueuedFrames.end())) ||
-            (!snapshot.isVisible && snapshot.changes.test(Changes::Visibility))) {
-            Region visibleReg;
-            visibleReg.set(snapshot.transformedBoundsWithoutTransparentRegion);
-            invalidateLayerStack(snapshot.outputFilter, visibleReg);
+        for (auto& destroyedLayer : mLayerLifecycleManager.getDestroyedLayers()) {
+            mLegacyLayers.erase(destroyedLayer->id);
         }
-    });
 
-    for (auto& destroyedLayer : mLayerLifecycleManager.getDestroyedLayers()) {
-        mLegacyLayers.erase(destroyedLayer->id);
-    }
-
-    {
-        SFTRACE_NAME("LLM:commitChanges");
-        mLayerLifecycleManager.commitChanges();
+        {
+            SFTRACE_NAME("LLM:commitChanges");
+            mLayerLifecycleManager.commitChanges();
+        }
+        mHasAutoRefreshLayers = hasAutoRefreshLayers;
     }
 
     // enter boot animation on first buffer latch
@@ -2676,8 +2736,18 @@ bool SurfaceFlinger::commit(PhysicalDisplayId pacesetterId,
 
         const bool flushTransactions = clearTransactionFlags(eTransactionFlushNeeded);
         bool transactionsAreEmpty = false;
+        const nsecs_t latchStartTime = mFrameBudgetTracker.isEnabled() ? systemTime() : 0;
         mustComposite |= updateLayerSnapshots(vsyncId, pacesetterFrameTarget.frameBeginTime().ns(),
                                               flushTransactions, transactionsAreEmpty);
+        if (mFrameBudgetTracker.isEnabled()) {
+            const auto frontLayer = mLayersWithQueuedFrames.begin();
+            mFrameBudgetTracker
+                    .recordStageDuration(FrameBudgetTracker::Stage::Latch,
+                                         ftl::to_underlying(vsyncId), latchStartTime, systemTime(),
+                                         frontLayer != mLayersWithQueuedFrames.end()
+                                                 ? frontLayer->first->getDebugName()
+                                                 : nullptr);
+        }
 
         // Tell VsyncTracker that we are going to present this frame before scheduling
         // setTransactionFlags which will schedule another SF frame. This was if the tracker
@@ -2687,6 +2757,7 @@ bool SurfaceFlinger::commit(PhysicalDisplayId pacesetterId,
                 pacesetterFrameTarget.expectedPresentTime(),
                 pacesetterFrameTarget.lastSignaledFrameTime());
         }
+        mScheduler->recordPresentTimeError(pacesetterFrameTarget.lastSignaledFrameTime());
         if (transactionFlushNeeded()) {
             setTransactionFlags(eTransactionFlushNeeded);
         }
@@ -2746,6 +2817,8 @@ CompositeResultsPerDisplay SurfaceFlinger::composite(
     const VsyncId vsyncId = pacesetterTarget.vsyncId();
     SFTRACE_NAME(ftl::Concat(__func__, ' ', ftl::to_underlying(vsyncId)).c_str());
 
+    const nsecs_t compositeStartTime = mFrameBudgetTracker.isEnabled() ? systemTime() : 0;
+
     compositionengine::CompositionRefreshArgs refreshArgs;
     refreshArgs.powerCallback = this;
     const auto& displays = FTL_FAKE_GUARD(mStateLock, mDisplays);
@@ -2827,7 +2900,7 @@ CompositeResultsPerDisplay SurfaceFlinger::composite(
     const auto presentTime = systemTime();
 
     constexpr bool kCursorOnly = false;
-    const auto layers = moveSnapshotsToCompositionArgs(refreshArgs, kCursorOnly);
+    const auto& layers = moveSnapshotsToCompositionArgs(refreshArgs, kCursorOnly);
 
     if (!mVisibleRegionsDirty) {
         for (const auto& [token, display] : FTL_FAKE_GUARD(mStateLock, mDisplays)) {
@@ -2856,6 +2929,13 @@ CompositeResultsPerDisplay SurfaceFlinger::composite(
         layer->onPreComposition(refreshArgs.refreshStartTime);
     }
 
+    const nsecs_t presentStartTime = mFrameBudgetTracker.isEnabled() ? systemTime() : 0;
+    if (mFrameBudgetTracker.isEnabled()) {
+        mFrameBudgetTracker.recordStageDuration(FrameBudgetTracker::Stage::CompositeSetup,
+                                                ftl::to_underlying(vsyncId), compositeStartTime,
+                                                presentStartTime, nullptr);
+    }
+
     if (FlagManager::getInstance().ce_fence_promise()) {
         for (auto& [layer, layerFE] : layers) {
             attachReleaseFenceFutureToLayer(layer, layerFE,
@@ -2905,6 +2985,12 @@ CompositeResultsPerDisplay SurfaceFlinger::composite(
     }
 
     SFTRACE_NAME("postComposition");
+    const nsecs_t postCompositionStartTime = mFrameBudgetTracker.isEnabled() ? systemTime() : 0;
+    if (mFrameBudgetTracker.isEnabled()) {
+        mFrameBudgetTracker.recordStageDuration(FrameBudgetTracker::Stage::Present,
+                                                ftl::to_underlying(vsyncId), presentStartTime,
+                                                postCompositionStartTime, nullptr);
+    }
     mTimeStats->recordFrameDuration(pacesetterTarget.frameBeginTime().ns(), systemTime());
 
     // Send a power hint after presentation is finished.
@@ -2990,6 +3076,12 @@ CompositeResultsPerDisplay SurfaceFlinger::composite(
         mPowerAdvisor->setCompositeEnd(TimePoint::now());
     }
 
+    if (mFrameBudgetTracker.isEnabled()) {
+        mFrameBudgetTracker.recordStageDuration(FrameBudgetTracker::Stage::PostComposition,
+                                                ftl::to_underlying(vsyncId),
+                                                postCompositionStartTime, systemTime(), nullptr);
+    }
+
     CompositeResultsPerDisplay resultsPerDisplay;
 
     // Filter out virtual displays.
@@ -3175,6 +3267,12 @@ void SurfaceFlinger::onCompositionPresented(PhysicalDisplayId pacesetterId,
         layer->releasePendingBuffer(presentTime.ns());
     }
 
+    // The release fences for the buffers replaced in this frame are known now that the handles
+    // above are complete. Push them over the buffer release channels before the listener and
+    // stats work below, so producers blocked in dequeueBuffer can start their next frame as
+    // early as possible.
+    mTransactionCallbackInvoker.sendBufferReleases();
+
     std::vector<std::pair<std::shared_ptr<compositionengine::Display>, sp<HdrLayerInfoReporter>>>
             hdrInfoListeners;
     bool haveNewListeners = false;
@@ -4041,8 +4139,18 @@ void SurfaceFlinger::updateInputFlinger(VsyncId vsyncId, TimePoint frameTime) {
     bool updateWindowInfo = false;
     if (mUpdateInputInfo) {
         mUpdateInputInfo = false;
-        updateWindowInfo = true;
         buildWindowInfos(windowInfos, displayInfos);
+
+        // Many commits dirty the input info without changing what input actually sees, e.g. a
+        // buffer update or a color change on an otherwise static window. Skip the update when
+        // the built infos match what was last sent, so listeners neither deserialize nor
+        // rebuild their window state for a no-op.
+        updateWindowInfo =
+                windowInfos != mLastSentWindowInfos || displayInfos != mLastSentDisplayInfos;
+        if (updateWindowInfo) {
+            mLastSentWindowInfos = windowInfos;
+            mLastSentDisplayInfos = displayInfos;
+        }
     }
 
     std::unordered_set<int32_t> visibleWindowIds;
@@ -4087,7 +4195,8 @@ void SurfaceFlinger::updateInputFlinger(VsyncId vsyncId, TimePoint frameTime) {
         for (const auto& focusRequest : inputWindowCommands.focusRequests) {
             inputFlinger->setFocusedWindow(focusRequest);
         }
-    }});
+    }},
+                                                    BackgroundExecutor::Affinity::WindowInfos);
 
     mInputWindowCommands.clear();
 }
@@ -4149,7 +4258,7 @@ void SurfaceFlinger::updateCursorAsync() {
     }
 
     constexpr bool kCursorOnly = true;
-    const auto layers = moveSnapshotsToCompositionArgs(refreshArgs, kCursorOnly);
+    const auto& layers = moveSnapshotsToCompositionArgs(refreshArgs, kCursorOnly);
     mCompositionEngine->updateCursorAsync(refreshArgs);
     moveSnapshotsFromCompositionArgs(refreshArgs, layers);
 }
@@ -4777,14 +4886,14 @@ status_t SurfaceFlinger::setTransactionState(
         inputWindowCommands.clear();
     }
 
-    if (flags & (eEarlyWakeupStart | eEarlyWakeupEnd)) {
+    if (flags & (eEarlyWakeupStart | eEarlyWakeupEnd | eUrgent)) {
         const bool hasPermission =
                 (permissions & layer_state_t::Permission::ACCESS_SURFACE_FLINGER) ||
                 callingThreadHasPermission(sWakeupSurfaceFlinger);
         if (!hasPermission) {
             ALOGE("Caller needs permission android.permission.WAKEUP_SURFACE_FLINGER to use "
-                  "eEarlyWakeup[Start|End] flags");
-            flags &= ~(eEarlyWakeupStart | eEarlyWakeupEnd);
+                  "eEarlyWakeup[Start|End] or eUrgent flags");
+            flags &= ~(eEarlyWakeupStart | eEarlyWakeupEnd | eUrgent);
         }
     }
 
@@ -5427,13 +5536,20 @@ void SurfaceFlinger::setPowerModeInternal(const sp<DisplayDevice>& display, hal:
             }
         }
 
-        getHwComposer().setPowerMode(displayId, mode);
-        if (mode != hal::PowerMode::DOZE_SUSPEND &&
-            (displayId == mActiveDisplayId || FlagManager::getInstance().multithreaded_present())) {
-            const bool enable =
-                    mScheduler->getVsyncSchedule(displayId)->getPendingHardwareVsyncState();
-            requestHardwareVsync(displayId, enable);
+        // Issue the blocking HWC power call on a separate thread so that scheduler
+        // bring-up overlaps the panel power sequence, which dominates time-to-first-frame
+        // on wake. Only the hardware VSYNC enable below must wait for it; scheduler-side
+        // VSYNC requests made meanwhile are deferred to the main thread and thus run
+        // after this function returns, once the power transition is complete.
+        auto hwcPowerOn = std::async(std::launch::async, [this, displayId, mode] {
+            SFTRACE_NAME("HWC::setPowerMode");
+            getHwComposer().setPowerMode(displayId, mode);
+        });
 
+        const bool updateVsync = mode != hal::PowerMode::DOZE_SUSPEND &&
+                (displayId == mActiveDisplayId ||
+                 FlagManager::getInstance().multithreaded_present());
+        if (updateVsync) {
             if (displayId == mActiveDisplayId) {
                 mScheduler->enableSyntheticVsync(false);
             }
@@ -5442,8 +5558,18 @@ void SurfaceFlinger::setPowerModeInternal(const sp<DisplayDevice>& display, hal:
             mScheduler->resyncToHardwareVsync(displayId, kAllowToEnable, activeMode.get());
         }
 
+        // Prepare the first frame speculatively so it latches as soon as the display
+        // reports ready.
         mVisibleRegionsDirty = true;
         scheduleComposite(FrameHint::kActive);
+
+        hwcPowerOn.wait();
+
+        if (updateVsync) {
+            const bool enable =
+                    mScheduler->getVsyncSchedule(displayId)->getPendingHardwareVsyncState();
+            requestHardwareVsync(displayId, enable);
+        }
     } else if (mode == hal::PowerMode::OFF) {
         const bool currentModeNotDozeSuspend = (currentMode != hal::PowerMode::DOZE_SUSPEND);
         // Turn off the display
@@ -5563,7 +5689,9 @@ status_t SurfaceFlinger::doDump(int fd, const DumpArgs& args, bool asProto) {
         layersTrace->mutable_layers()->Swap(&layersProto);
         auto displayProtos = dumpDisplayProto();
         layersTrace->mutable_displays()->Swap(&displayProtos);
-        result.append(traceFileProto.SerializeAsString());
+        // Serialize straight into the output buffer instead of staging the
+        // multi-MB payload through a temporary string.
+        traceFileProto.SerializeToString(&result);
         write(fd, result.c_str(), result.size());
         return NO_ERROR;
     }
@@ -5574,6 +5702,7 @@ status_t SurfaceFlinger::doDump(int fd, const DumpArgs& args, bool asProto) {
             {"--displays"s, dumper(&SurfaceFlinger::dumpDisplays)},
             {"--edid"s, argsDumper(&SurfaceFlinger::dumpRawDisplayIdentificationData)},
             {"--events"s, dumper(&SurfaceFlinger::dumpEvents)},
+            {"--frame-budget"s, dumper(&SurfaceFlinger::dumpFrameBudget)},
             {"--frametimeline"s, argsDumper(&SurfaceFlinger::dumpFrameTimeline)},
             {"--frontend"s, mainThreadDumper(&SurfaceFlinger::dumpFrontEnd)},
             {"--hdrinfo"s, dumper(&SurfaceFlinger::dumpHdrInfo)},
@@ -5581,6 +5710,7 @@ status_t SurfaceFlinger::doDump(int fd, const DumpArgs& args, bool asProto) {
             {"--latency"s, argsMainThreadDumper(&SurfaceFlinger::dumpStats)},
             {"--latency-clear"s, argsMainThreadDumper(&SurfaceFlinger::clearStats)},
             {"--list"s, mainThreadDumper(&SurfaceFlinger::listLayers)},
+            {"--memory"s, dumper(&SurfaceFlinger::dumpMemory)},
             {"--planner"s, argsDumper(&SurfaceFlinger::dumpPlannerInfo)},
             {"--scheduler"s, dumper(&SurfaceFlinger::dumpScheduler)},
             {"--timestats"s, protoDumper(&SurfaceFlinger::dumpTimeStats)},
@@ -5595,13 +5725,16 @@ status_t SurfaceFlinger::doDump(int fd, const DumpArgs& args, bool asProto) {
         return NO_ERROR;
     }
 
-    // Collect debug data from main thread
-    std::string compositionLayers;
+    // Collect debug data from the main thread, holding it only long enough to clone
+    // the compact frontend state. The multi-MB text formatting happens on this thread.
+    FrontEndDumpState frontEndState;
     mScheduler
             ->schedule([&]() FTL_FAKE_GUARD(mStateLock) FTL_FAKE_GUARD(kMainThreadContext) {
-                dumpVisibleFrontEnd(compositionLayers);
+                captureVisibleFrontEnd(frontEndState);
             })
             .get();
+    std::string compositionLayers;
+    dumpVisibleFrontEnd(frontEndState, compositionLayers);
     // get window info listener data without the state lock
     auto windowInfosDebug = mWindowInfosListenerInvoker->getDebugInfo();
     compositionLayers.append("Window Infos:\n");
@@ -5658,6 +5791,33 @@ void SurfaceFlinger::dumpFrameTimeline(const DumpArgs& args, std::string& result
     mFrameTimeline->parseArgs(args, result);
 }
 
+void SurfaceFlinger::dumpFrameBudget(std::string& result) const {
+    mFrameBudgetTracker.dump(result);
+}
+
+void SurfaceFlinger::dumpMemory(std::string& result) const {
+    // Process RSS as the kernel sees it, so heap fragmentation regressions
+    // (allocator caches that never return to the kernel) show up even when the
+    // allocator's own accounting looks flat.
+    std::ifstream statm("/proc/self/statm");
+    uint64_t vmSizePages = 0, rssPages = 0, sharedPages = 0;
+    if (statm >> vmSizePages >> rssPages >> sharedPages) {
+        const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        StringAppendF(&result,
+                      "Virtual size: %" PRIu64 " kB\n"
+                      "Resident set size: %" PRIu64 " kB (%" PRIu64 " kB shared)\n",
+                      vmSizePages * pageSize / 1024, rssPages * pageSize / 1024,
+                      sharedPages * pageSize / 1024);
+    } else {
+        result.append("Could not read /proc/self/statm\n");
+    }
+
+    const struct mallinfo mi = mallinfo();
+    StringAppendF(&result, "Native heap: %zu kB in use, %zu kB free in allocator caches\n",
+                  static_cast<size_t>(mi.uordblks) / 1024,
+                  static_cast<size_t>(mi.fordblks) / 1024);
+}
+
 void SurfaceFlinger::logFrameStats(TimePoint now) {
     static TimePoint sTimestamp = now;
     if (now - sTimestamp < 30min) return;
@@ -5849,36 +6009,51 @@ void SurfaceFlinger::dumpFrontEnd(std::string& result) {
     result.append(out.str());
 }
 
-void SurfaceFlinger::dumpVisibleFrontEnd(std::string& result) {
-    std::ostringstream out;
-    out << "\nComposition list\n";
-    ui::LayerStack lastPrintedLayerStackHeader = ui::INVALID_LAYER_STACK;
+void SurfaceFlinger::captureVisibleFrontEnd(FrontEndDumpState& state) {
     mLayerSnapshotBuilder.forEachVisibleSnapshot(
             [&](std::unique_ptr<frontend::LayerSnapshot>& snapshot) {
                 if (snapshot->hasSomethingToDraw()) {
-                    if (lastPrintedLayerStackHeader != snapshot->outputFilter.layerStack) {
-                        lastPrintedLayerStackHeader = snapshot->outputFilter.layerStack;
-                        out << "LayerStack=" << lastPrintedLayerStackHeader.id << "\n";
-                    }
-                    out << "  " << *snapshot << "\n";
+                    state.compositionSnapshots.push_back(*snapshot);
                 }
             });
+    mLayerSnapshotBuilder.forEachInputSnapshot([&](const frontend::LayerSnapshot& snapshot) {
+        state.inputSnapshots.push_back(snapshot);
+    });
+
+    std::ostringstream out;
+    out << "\nLayer Hierarchy\n"
+        << mLayerHierarchyBuilder.getHierarchy() << "\nOffscreen Hierarchy\n"
+        << mLayerHierarchyBuilder.getOffscreenHierarchy() << "\n\n";
+    state.hierarchyDump = out.str();
+    dumpHwcLayersMinidump(state.hwcLayersMinidump);
+}
+
+void SurfaceFlinger::dumpVisibleFrontEnd(const FrontEndDumpState& state,
+                                         std::string& result) const {
+    std::ostringstream out;
+    out << "\nComposition list\n";
+    ui::LayerStack lastPrintedLayerStackHeader = ui::INVALID_LAYER_STACK;
+    for (const auto& snapshot : state.compositionSnapshots) {
+        if (lastPrintedLayerStackHeader != snapshot.outputFilter.layerStack) {
+            lastPrintedLayerStackHeader = snapshot.outputFilter.layerStack;
+            out << "LayerStack=" << lastPrintedLayerStackHeader.id << "\n";
+        }
+        out << "  " << snapshot << "\n";
+    }
 
     out << "\nInput list\n";
     lastPrintedLayerStackHeader = ui::INVALID_LAYER_STACK;
-    mLayerSnapshotBuilder.forEachInputSnapshot([&](const frontend::LayerSnapshot& snapshot) {
+    for (const auto& snapshot : state.inputSnapshots) {
         if (lastPrintedLayerStackHeader != snapshot.outputFilter.layerStack) {
             lastPrintedLayerStackHeader = snapshot.outputFilter.layerStack;
             out << "LayerStack=" << lastPrintedLayerStackHeader.id << "\n";
         }
         out << "  " << snapshot << "\n";
-    });
+    }
 
-    out << "\nLayer Hierarchy\n"
-        << mLayerHierarchyBuilder.getHierarchy() << "\nOffscreen Hierarchy\n"
-        << mLayerHierarchyBuilder.getOffscreenHierarchy() << "\n\n";
+    out << state.hierarchyDump;
     result = out.str();
-    dumpHwcLayersMinidump(result);
+    result.append(state.hwcLayersMinidump);
 }
 
 perfetto::protos::LayersProto SurfaceFlinger::dumpDrawingStateProto(uint32_t traceFlags) const {
@@ -6020,6 +6195,9 @@ void SurfaceFlinger::dumpAll(const DumpArgs& args, const std::string& compositio
     dumpVsync(result);
     result.append("\n");
 
+    dumpFrameBudget(result);
+    result.append("\n");
+
     /*
      * Dump the visible layer list
      */
@@ -6260,9 +6438,9 @@ status_t SurfaceFlinger::CheckTransactCodeCredentials(uint32_t code) {
         code == IBinder::SYSPROPS_TRANSACTION) {
         return OK;
     }
-    // Numbers from 1000 to 1045 are currently used for backdoors. The code
+    // Numbers from 1000 to 1046 are currently used for backdoors. The code
     // in onTransact verifies that the user is root, and has access to use SF.
-    if (code >= 1000 && code <= 1045) {
+    if (code >= 1000 && code <= 1046) {
         ALOGV("Accessing SurfaceFlinger through backdoor code: %u", code);
         return OK;
     }
@@ -6795,6 +6973,18 @@ status_t SurfaceFlinger::onTransact(uint32_t code, const Parcel& data, Parcel* r
                 }
                 return err;
             }
+            // Set the vsync delivery class for a uid.
+            // First argument is an int32 - the uid
+            // Second argument is an int32 - nonzero demotes the uid to background (decimated)
+            // vsync delivery, zero restores foreground delivery
+            case 1046: {
+                const auto uid = static_cast<uid_t>(data.readInt32());
+                const bool background = data.readInt32() != 0;
+                mScheduler->setVsyncDeliveryClassForUid(uid,
+                                                        background ? VsyncDeliveryClass::Background
+                                                                   : VsyncDeliveryClass::Foreground);
+                return NO_ERROR;
+            }
         }
     }
     return err;
@@ -7285,13 +7475,18 @@ void SurfaceFlinger::captureScreenCommon(RenderAreaBuilderVariant renderAreaBuil
         return;
     }
 
+    // When enabled, captures render on their own RenderEngine so they never queue behind (or
+    // stall) the composition engine's work.
+    renderengine::RenderEngine& captureEngine =
+            mDedicatedCaptureRenderEngine ? getCaptureRenderEngine() : getRenderEngine();
+
     if (FlagManager::getInstance().single_hop_screenshot() &&
         FlagManager::getInstance().ce_fence_promise() && mRenderEngine->isThreaded()) {
         std::vector<sp<LayerFE>> layerFEs;
         auto displayState =
                 getSnapshotsFromMainThread(renderAreaBuilder, getLayerSnapshotsFn, layerFEs);
 
-        const bool supportsProtected = getRenderEngine().supportsProtectedContent();
+        const bool supportsProtected = captureEngine.supportsProtectedContent();
         bool hasProtectedLayer = false;
         if (allowProtected && supportsProtected) {
             hasProtectedLayer = layersHasProtectedLayer(layerFEs);
@@ -7316,7 +7511,7 @@ void SurfaceFlinger::captureScreenCommon(RenderAreaBuilderVariant renderAreaBuil
             return;
         }
         const std::shared_ptr<renderengine::ExternalTexture> texture = std::make_shared<
-                renderengine::impl::ExternalTexture>(buffer, getRenderEngine(),
+                renderengine::impl::ExternalTexture>(buffer, captureEngine,
                                                      renderengine::impl::ExternalTexture::Usage::
                                                              WRITEABLE);
         auto futureFence = captureScreenshot(renderAreaBuilder, texture, false /* regionSampling */,
@@ -7325,7 +7520,7 @@ void SurfaceFlinger::captureScreenCommon(RenderAreaBuilderVariant renderAreaBuil
         futureFence.get();
 
     } else {
-        const bool supportsProtected = getRenderEngine().supportsProtectedContent();
+        const bool supportsProtected = captureEngine.supportsProtectedContent();
         bool hasProtectedLayer = false;
         if (allowProtected && supportsProtected) {
             auto layers = mScheduler->schedule([=]() { return getLayerSnapshotsFn(); }).get();
@@ -7351,7 +7546,7 @@ void SurfaceFlinger::captureScreenCommon(RenderAreaBuilderVariant renderAreaBuil
             return;
         }
         const std::shared_ptr<renderengine::ExternalTexture> texture = std::make_shared<
-                renderengine::impl::ExternalTexture>(buffer, getRenderEngine(),
+                renderengine::impl::ExternalTexture>(buffer, captureEngine,
                                                      renderengine::impl::ExternalTexture::Usage::
                                                              WRITEABLE);
         auto futureFence = captureScreenshotLegacy(renderAreaBuilder, getLayerSnapshotsFn, texture,
@@ -7459,12 +7654,14 @@ ftl::SharedFuture<FenceResult> SurfaceFlinger::captureScreenshot(
                   __func__, gainmapBufferStatus);
         } else {
             captureResults.optionalGainMap = gainmapBuffer;
+            renderengine::RenderEngine& captureEngine =
+                    mDedicatedCaptureRenderEngine ? getCaptureRenderEngine() : getRenderEngine();
             const auto hdrTexture = std::make_shared<
-                    renderengine::impl::ExternalTexture>(hdrBuffer, getRenderEngine(),
+                    renderengine::impl::ExternalTexture>(hdrBuffer, captureEngine,
                                                          renderengine::impl::ExternalTexture::
                                                                  Usage::WRITEABLE);
             const auto gainmapTexture = std::make_shared<
-                    renderengine::impl::ExternalTexture>(gainmapBuffer, getRenderEngine(),
+                    renderengine::impl::ExternalTexture>(gainmapBuffer, captureEngine,
                                                          renderengine::impl::ExternalTexture::
                                                                  Usage::WRITEABLE);
             ScreenCaptureResults unusedResults;
@@ -7489,7 +7686,8 @@ ftl::SharedFuture<FenceResult> SurfaceFlinger::captureScreenshot(
                                     return hdrFenceResult;
                                 }
 
-                                return getRenderEngine()
+                                return (mDedicatedCaptureRenderEngine ? getCaptureRenderEngine()
+                                                                      : getRenderEngine())
                                         .drawGainmap(buffer, fenceResult.value()->get(), hdrTexture,
                                                      hdrFenceResult.value()->get(),
                                                      displayBrightnessNits / sdrWhitePointNits,
@@ -7667,7 +7865,8 @@ ftl::SharedFuture<FenceResult> SurfaceFlinger::renderScreenImpl(
                     enableLocalTonemapping]() -> FenceResult {
         std::unique_ptr<compositionengine::CompositionEngine> compositionEngine =
                 mFactory.createCompositionEngine();
-        compositionEngine->setRenderEngine(mRenderEngine.get());
+        compositionEngine->setRenderEngine(mDedicatedCaptureRenderEngine ? &getCaptureRenderEngine()
+                                                                         : mRenderEngine.get());
 
         compositionengine::Output::ColorProfile colorProfile{.dataspace = dataspace,
                                                              .renderIntent = renderIntent};
@@ -8299,9 +8498,10 @@ void SurfaceFlinger::moveSnapshotsFromCompositionArgs(
     }
 }
 
-std::vector<std::pair<Layer*, LayerFE*>> SurfaceFlinger::moveSnapshotsToCompositionArgs(
+const std::vector<std::pair<Layer*, LayerFE*>>& SurfaceFlinger::moveSnapshotsToCompositionArgs(
         compositionengine::CompositionRefreshArgs& refreshArgs, bool cursorOnly) {
-    std::vector<std::pair<Layer*, LayerFE*>> layers;
+    std::vector<std::pair<Layer*, LayerFE*>>& layers = mSnapshotCompositionLayers;
+    layers.clear();
     nsecs_t currentTime = systemTime();
     const bool needsMetadata = mCompositionEngine->getFeatureFlags().test(
             compositionengine::Feature::kSnapshotLayerMetadata);
@@ -37,10 +37,12 @@
 #include <ftl/non_null.h>
 #include <gui/BufferQueue.h>
 #include <gui/CompositorTiming.h>
+#include <gui/DisplayInfo.h>
 #include <gui/FrameTimestamps.h>
 #include <gui/ISurfaceComposer.h>
 #include <gui/ITransactionCompletedListener.h>
 #include <gui/LayerState.h>
+#include <gui/WindowInfo.h>
 #include <layerproto/LayerProtoHeader.h>
 #include <math/mat4.h>
 #include <renderengine/LayerSettings.h>
@@ -73,6 +75,7 @@
 #include "DisplayHardware/PowerAdvisor.h"
 #include "DisplayIdGenerator.h"
 #include "Effects/Daltonizer.h"
+#include "FrameBudgetTracker.h"
 #include "FrontEnd/DisplayInfo.h"
 #include "FrontEnd/LayerCreationArgs.h"
 #include "FrontEnd/LayerLifecycleManager.h"
@@ -296,6 +299,11 @@ public:
 
     renderengine::RenderEngine& getRenderEngine() const;
 
+    // Lazily creates and returns the RenderEngine dedicated to screen captures. Only used when
+    // debug.sf.dedicated_capture_render_engine is set, so capture rendering never contends with
+    // the composition engine's RenderEngine thread.
+    renderengine::RenderEngine& getCaptureRenderEngine();
+
     void onLayerFirstRef(Layer*);
     void onLayerDestroyed(Layer*);
     void onLayerUpdate();
@@ -756,7 +764,10 @@ private:
             REQUIRES(mStateLock, kMainThreadContext);
     void doCommitTransactions() REQUIRES(mStateLock);
 
-    std::vector<std::pair<Layer*, LayerFE*>> moveSnapshotsToCompositionArgs(
+    // Returns a reference to a member scratch vector that is reused across frames. The
+    // scratch keeps its capacity when cleared, so steady-state composition does not
+    // reallocate the layer list every frame. Only valid until the next call.
+    const std::vector<std::pair<Layer*, LayerFE*>>& moveSnapshotsToCompositionArgs(
             compositionengine::CompositionRefreshArgs& refreshArgs, bool cursorOnly)
             REQUIRES(kMainThreadContext);
     void moveSnapshotsFromCompositionArgs(compositionengine::CompositionRefreshArgs& refreshArgs,
@@ -1119,6 +1130,8 @@ private:
     void dumpScheduler(std::string& result) const REQUIRES(mStateLock);
     void dumpEvents(std::string& result) const REQUIRES(mStateLock);
     void dumpVsync(std::string& result) const REQUIRES(mStateLock);
+    void dumpFrameBudget(std::string& result) const;
+    void dumpMemory(std::string& result) const;
 
     void dumpCompositionDisplays(std::string& result) const REQUIRES(mStateLock);
     void dumpDisplays(std::string& result) const REQUIRES(mStateLock);
@@ -1127,7 +1140,18 @@ private:
     void dumpWideColorInfo(std::string& result) const REQUIRES(mStateLock);
     void dumpHdrInfo(std::string& result) const REQUIRES(mStateLock);
     void dumpFrontEnd(std::string& result) REQUIRES(kMainThreadContext);
-    void dumpVisibleFrontEnd(std::string& result) REQUIRES(mStateLock, kMainThreadContext);
+
+    // Compact clone of the frontend state dumped for bugreports. Captured on the main
+    // thread so the expensive per-layer text formatting can run on the binder thread.
+    struct FrontEndDumpState {
+        std::vector<frontend::LayerSnapshot> compositionSnapshots;
+        std::vector<frontend::LayerSnapshot> inputSnapshots;
+        std::string hierarchyDump;
+        std::string hwcLayersMinidump;
+    };
+    void captureVisibleFrontEnd(FrontEndDumpState& state)
+            REQUIRES(mStateLock, kMainThreadContext);
+    void dumpVisibleFrontEnd(const FrontEndDumpState& state, std::string& result) const;
 
     perfetto::protos::LayersProto dumpDrawingStateProto(uint32_t traceFlags) const
             REQUIRES(kMainThreadContext);
@@ -1242,6 +1266,9 @@ private:
     bool mUpdateInputInfo = false;
     bool mSomeChildrenChanged;
     bool mUpdateAttachedChoreographer = false;
+    // Whether the last latch walk saw a layer in auto-refresh mode, which forces the
+    // walk to run on every commit even when the frame carries no layer deltas.
+    bool mHasAutoRefreshLayers = false;
 
     struct LayerIntHash {
         size_t operator()(const std::pair<sp<Layer>, gui::GameMode>& k) const {
@@ -1257,6 +1284,11 @@ private:
     std::unordered_set<sp<Layer>, SpHash<Layer>> mLayersWithBuffersRemoved;
     std::unordered_set<uint32_t> mLayersIdsWithQueuedFrames;
 
+    // Commit-scoped scratch for moveSnapshotsToCompositionArgs. Cleared at the start of
+    // each frame but never shrunk, so the per-frame layer list stops churning the heap
+    // once it reaches the size of the scene. Main thread only.
+    std::vector<std::pair<Layer*, LayerFE*>> mSnapshotCompositionLayers;
+
     // Sorted list of layers that were composed during previous frame. This is used to
     // avoid an expensive traversal of the layer hierarchy when there are no
     // visible region changes. Because this is a list of strong pointers, this will
@@ -1309,6 +1341,10 @@ private:
     const std::unique_ptr<FrameTracer> mFrameTracer;
     const std::unique_ptr<frametimeline::FrameTimeline> mFrameTimeline;
 
+    // Attributes main-thread stage budget overruns; only active when budgets are
+    // configured via debug.sf.budget.*_us.
+    FrameBudgetTracker mFrameBudgetTracker;
+
     VsyncId mLastCommittedVsyncId;
 
     // If blurs should be enabled on this device.
@@ -1355,6 +1391,12 @@ private:
     std::unique_ptr<renderengine::RenderEngine> mRenderEngine;
     std::atomic<int> mNumTrustedPresentationListeners = 0;
 
+    // Separate engine used for screen captures when debug.sf.dedicated_capture_render_engine is
+    // set, created on first capture. See getCaptureRenderEngine().
+    std::unique_ptr<renderengine::RenderEngine> mCaptureRenderEngine;
+    std::once_flag mCaptureRenderEngineInit;
+    bool mDedicatedCaptureRenderEngine = false;
+
     std::unique_ptr<compositionengine::CompositionEngine> mCompositionEngine;
 
     CompositionCoveragePerDisplay mCompositionCoverage;
@@ -1458,6 +1500,11 @@ private:
     // WindowInfo ids visible during the last commit.
     std::unordered_set<int32_t> mVisibleWindowIds GUARDED_BY(kMainThreadContext);
 
+    // The window and display infos sent to input during the last commit, used to skip the
+    // update entirely when a commit dirties input but produces identical infos.
+    std::vector<gui::WindowInfo> mLastSentWindowInfos GUARDED_BY(kMainThreadContext);
+    std::vector<gui::DisplayInfo> mLastSentDisplayInfos GUARDED_BY(kMainThreadContext);
+
     // Mirroring
     // Map of displayid to mirrorRoot
     ftl::SmallMap<int64_t, sp<SurfaceControl>, 3> mMirrorMapForDebug;
@@ -24,9 +24,11 @@
 #include "Tracing/tools/LayerTraceGenerator.h"
 #include "TransactionTracing.h"
 
+#include <chrono>
 #include <common/trace.h>
 #include <log/log.h>
 #include <perfetto/tracing.h>
+#include <pthread.h>
 #include <utils/Timers.h>
 
 namespace android {
@@ -41,6 +43,14 @@ LayerTracing::LayerTracing(std::ostream& outStream) : LayerTracing() {
 }
 
 LayerTracing::~LayerTracing() {
+    {
+        std::lock_guard lock(mWriterLock);
+        mWriterThreadStop = true;
+    }
+    mWriterCondition.notify_all();
+    if (mWriterThread.joinable()) {
+        mWriterThread.join();
+    }
     LayerDataSource::UnregisterLayerTracing();
 }
 
@@ -128,6 +138,17 @@ void LayerTracing::onFlush(Mode mode, uint32_t flags, bool isBugreport) {
 void LayerTracing::onStop(Mode mode) {
     if (mode == Mode::MODE_ACTIVE) {
         mIsActiveTracingStarted.store(false);
+        // Let snapshots queued for the writer thread reach perfetto before the session
+        // finalizes. The wait is bounded because this runs on a perfetto callback thread
+        // and must not hang if the writer stalls inside a perfetto write.
+        constexpr auto kDrainTimeout = std::chrono::seconds(3);
+        std::unique_lock lock(mWriterLock);
+        if (!mWriterCondition.wait_for(lock, kDrainTimeout, [this]() {
+                return mPendingSnapshots.empty() && !mWriting;
+            })) {
+            ALOGW("Stopped active tracing (writer thread did not drain in time)");
+            return;
+        }
         ALOGD("Stopped active tracing");
     }
 }
@@ -137,11 +158,57 @@ void LayerTracing::addProtoSnapshotToOstream(perfetto::protos::LayersSnapshotPro
     SFTRACE_CALL();
     if (mOutStream) {
         writeSnapshotToStream(std::move(snapshot));
+    } else if (mode == Mode::MODE_ACTIVE) {
+        // Active tracing runs on every traced commit; hand the snapshot off so serialization
+        // and the perfetto write happen off the main thread.
+        enqueueSnapshotForWriter(std::move(snapshot));
     } else {
         writeSnapshotToPerfetto(snapshot, mode);
     }
 }
 
+void LayerTracing::enqueueSnapshotForWriter(perfetto::protos::LayersSnapshotProto&& snapshot) {
+    constexpr size_t kMaxPendingSnapshots = 8;
+    {
+        std::lock_guard lock(mWriterLock);
+        if (!mWriterThread.joinable()) {
+            mWriterThreadStop = false;
+            mWriterThread = std::thread([this]() { writerThreadLoop(); });
+        }
+        if (mPendingSnapshots.size() >= kMaxPendingSnapshots) {
+            ALOGW("Dropping layers snapshot (writer thread is backlogged)");
+            mPendingSnapshots.pop();
+        }
+        mPendingSnapshots.push(std::move(snapshot));
+    }
+    mWriterCondition.notify_one();
+}
+
+void LayerTracing::writerThreadLoop() {
+    pthread_setname_np(pthread_self(), "LayerTracing");
+    std::unique_lock lock(mWriterLock);
+    while (true) {
+        mWriterCondition.wait(lock, [this]() {
+            return mWriterThreadStop || !mPendingSnapshots.empty();
+        });
+        if (mPendingSnapshots.empty()) {
+            // Stop was requested and the queue is drained.
+            return;
+        }
+        auto snapshot = std::move(mPendingSnapshots.front());
+        mPendingSnapshots.pop();
+        mWriting = true;
+        lock.unlock();
+        writeSnapshotToPerfetto(snapshot, Mode::MODE_ACTIVE);
+        lock.lock();
+        mWriting = false;
+        if (mPendingSnapshots.empty()) {
+            // Wake anyone waiting in onStop for the queue to drain.
+            mWriterCondition.notify_all();
+        }
+    }
+}
+
 bool LayerTracing::isActiveTracingStarted() const {
     return mIsActiveTracingStarted.load();
 }
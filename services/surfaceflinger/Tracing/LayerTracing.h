@@ -19,9 +19,13 @@
 #include <layerproto/LayerProtoHeader.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <ostream>
+#include <queue>
+#include <thread>
 
 namespace android {
 
@@ -122,6 +126,8 @@ private:
     void writeSnapshotToStream(perfetto::protos::LayersSnapshotProto&& snapshot) const;
     void writeSnapshotToPerfetto(const perfetto::protos::LayersSnapshotProto& snapshot, Mode mode);
     bool checkAndUpdateLastVsyncIdWrittenToPerfetto(Mode mode, std::int64_t vsyncId);
+    void enqueueSnapshotForWriter(perfetto::protos::LayersSnapshotProto&& snapshot);
+    void writerThreadLoop();
 
     std::function<perfetto::protos::LayersSnapshotProto(uint32_t)> mTakeLayersSnapshotProto;
     TransactionTracing* mTransactionTracing;
@@ -130,6 +136,18 @@ private:
     std::atomic<uint32_t> mActiveTracingFlags{0};
     std::atomic<std::int64_t> mLastVsyncIdWrittenToPerfetto{-1};
     std::optional<std::reference_wrapper<std::ostream>> mOutStream;
+
+    // MODE_ACTIVE snapshots are serialized and written to perfetto on this worker thread, so
+    // per-commit tracing does not add the serialization cost to the main thread. The queue is
+    // bounded; under backpressure the oldest snapshot is dropped so the trace stays current.
+    std::thread mWriterThread;
+    std::mutex mWriterLock;
+    std::condition_variable mWriterCondition;
+    std::queue<perfetto::protos::LayersSnapshotProto> mPendingSnapshots;
+    // True while the writer thread is inside writeSnapshotToPerfetto() for a snapshot it has
+    // already popped off the queue, so drain waiters cannot miss an in-flight write.
+    bool mWriting = false;
+    bool mWriterThreadStop = false;
 };
 
 } // namespace android
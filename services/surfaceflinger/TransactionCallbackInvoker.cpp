@@ -164,12 +164,30 @@ void TransactionCallbackInvoker::addPresentFence(sp<Fence> presentFence) {
     mPresentFence = std::move(presentFence);
 }
 
-void TransactionCallbackInvoker::sendCallbacks(bool onCommitOnly) {
+void TransactionCallbackInvoker::sendBufferReleases() {
+    if (mBufferReleases.empty()) {
+        return;
+    }
+
+    // Group releases by channel so that each channel gets a single batched write instead
+    // of one sendmsg per released buffer.
+    std::unordered_map<std::shared_ptr<gui::BufferReleaseChannel::ProducerEndpoint>,
+                       std::vector<gui::BufferReleaseChannel::Message>>
+            releasesPerChannel;
     for (const auto& bufferRelease : mBufferReleases) {
-        bufferRelease.channel->writeReleaseFence(bufferRelease.callbackId, bufferRelease.fence,
-                                                 bufferRelease.currentMaxAcquiredBufferCount);
+        releasesPerChannel[bufferRelease.channel]
+                .emplace_back(bufferRelease.callbackId,
+                              bufferRelease.fence ? bufferRelease.fence : Fence::NO_FENCE,
+                              bufferRelease.currentMaxAcquiredBufferCount);
+    }
+    for (const auto& [channel, messages] : releasesPerChannel) {
+        channel->writeReleaseFences(messages);
     }
     mBufferReleases.clear();
+}
+
+void TransactionCallbackInvoker::sendCallbacks(bool onCommitOnly) {
+    sendBufferReleases();
 
     // For each listener
     auto completedTransactionsItr = mCompletedTransactions.begin();
@@ -225,7 +243,8 @@ void TransactionCallbackInvoker::sendCallbacks(bool onCommitOnly) {
                     interface_cast<ITransactionCompletedListener>(stats.listener)
                             ->onTransactionCompleted(stats);
                 }
-            }});
+            }},
+            BackgroundExecutor::Affinity::TransactionCallbacks);
 }
 
 // -----------------------------------------------------------------------
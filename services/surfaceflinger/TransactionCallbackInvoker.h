@@ -68,6 +68,10 @@ public:
 
     void addPresentFence(sp<Fence>);
 
+    // Flushes any pending buffer release fences over their BufferReleaseChannels. Called
+    // eagerly once the present fence for a frame is known so producers can re-dequeue without
+    // waiting for the full transaction callback pass; sendCallbacks also flushes as a fallback.
+    void sendBufferReleases();
     void sendCallbacks(bool onCommitOnly);
     void clearCompletedTransactions() {
         mCompletedTransactions.clear();
@@ -47,7 +47,8 @@ void WindowInfosListenerInvoker::addWindowInfosListener(sp<IWindowInfosListener>
                 asBinder->linkToDeath(sp<DeathRecipient>::fromExisting(this));
                 mWindowInfosListeners.try_emplace(asBinder,
                                                   std::make_pair(listenerId, std::move(listener)));
-            }});
+            }},
+            BackgroundExecutor::Affinity::WindowInfos);
 }
 
 void WindowInfosListenerInvoker::removeWindowInfosListener(
@@ -57,14 +58,16 @@ void WindowInfosListenerInvoker::removeWindowInfosListener(
         sp<IBinder> asBinder = IInterface::asBinder(listener);
         asBinder->unlinkToDeath(sp<DeathRecipient>::fromExisting(this));
         eraseListenerAndAckMessages(asBinder);
-    }});
+    }},
+                                                    BackgroundExecutor::Affinity::WindowInfos);
 }
 
 void WindowInfosListenerInvoker::binderDied(const wp<IBinder>& who) {
     BackgroundExecutor::getInstance().sendCallbacks({[this, who]() {
         SFTRACE_NAME("WindowInfosListenerInvoker::binderDied");
         eraseListenerAndAckMessages(who);
-    }});
+    }},
+                                                    BackgroundExecutor::Affinity::WindowInfos);
 }
 
 void WindowInfosListenerInvoker::eraseListenerAndAckMessages(const wp<IBinder>& binder) {
@@ -150,7 +153,8 @@ WindowInfosListenerInvoker::DebugInfo WindowInfosListenerInvoker::getDebugInfo()
         updateMaxSendDelay();
         result = mDebugInfo;
         result.pendingMessageCount = mUnackedState.size();
-    }});
+    }},
+                                                    BackgroundExecutor::Affinity::WindowInfos);
     BackgroundExecutor::getInstance().flushQueue();
     return result;
 }
@@ -199,7 +203,8 @@ binder::Status WindowInfosListenerInvoker::ackWindowInfosReceived(int64_t vsyncI
         gui::WindowInfosUpdate update{std::move(*mDelayedUpdate)};
         mDelayedUpdate.reset();
         windowInfosChanged(std::move(update), {}, false);
-    }});
+    }},
+                                                    BackgroundExecutor::Affinity::WindowInfos);
     return binder::Status::ok();
 }
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <android/hardware/graphics/composer3/ComposerClientWriter.h>
+
+namespace android::surfaceflinger {
+
+namespace {
+
+using aidl::android::hardware::graphics::common::Dataspace;
+using aidl::android::hardware::graphics::common::FRect;
+using aidl::android::hardware::graphics::common::Rect;
+using aidl::android::hardware::graphics::composer3::ClockMonotonicTimestamp;
+using aidl::android::hardware::graphics::composer3::ComposerClientWriter;
+using aidl::android::hardware::graphics::composer3::Composition;
+using aidl::android::hardware::graphics::composer3::DisplayCommand;
+
+constexpr int64_t kDisplayId = 42;
+
+// Applies a configurable latency model to a composer command stream,
+// standing in for a vendor composer so the cost of a submission pattern can
+// be compared without a device. The model charges a binder round trip per
+// executeCommands call, a fixed cost per display command, a cost per layer
+// command, and validate/present costs, which together approximate where the
+// time goes in vendor traces.
+struct SimulatedComposer {
+    struct LatencyModel {
+        int64_t ipcRoundTripNs = 60'000;
+        int64_t perDisplayCommandNs = 5'000;
+        int64_t perLayerCommandNs = 15'000;
+        int64_t validateNs = 300'000;
+        int64_t presentNs = 500'000;
+    };
+
+    LatencyModel model;
+    int64_t modeledTimeNs = 0;
+    int64_t executeCalls = 0;
+
+    // Simulates one executeCommands binder call and returns its modeled
+    // service time.
+    int64_t execute(const std::vector<DisplayCommand>& commands) {
+        int64_t timeNs = model.ipcRoundTripNs;
+        for (const auto& command : commands) {
+            timeNs += model.perDisplayCommandNs;
+            timeNs += static_cast<int64_t>(command.layers.size()) * model.perLayerCommandNs;
+            if (command.validateDisplay || command.presentOrValidateDisplay) {
+                timeNs += model.validateNs;
+            }
+            if (command.presentDisplay || command.presentOrValidateDisplay) {
+                timeNs += model.presentNs;
+            }
+        }
+        modeledTimeNs += timeNs;
+        executeCalls++;
+        return timeNs;
+    }
+};
+
+// Queues one frame's worth of commands for a typical scene: every layer gets
+// a new buffer and damage, a quarter of the layers also move, and the frame
+// ends with presentOrValidate. This matches the command mix AidlComposer's
+// writer accumulates between present calls on a steady-state device.
+void queueFrame(ComposerClientWriter& writer, int64_t layerCount, bool geometryChanged) {
+    for (int64_t layer = 1; layer <= layerCount; layer++) {
+        writer.setLayerBuffer(kDisplayId, layer, /*slot=*/static_cast<uint32_t>(layer % 4),
+                              /*buffer=*/nullptr, /*acquireFence=*/-1);
+        writer.setLayerSurfaceDamage(kDisplayId, layer, std::vector<Rect>{{0, 0, 100, 100}});
+        if (geometryChanged || layer % 4 == 0) {
+            writer.setLayerDisplayFrame(kDisplayId, layer,
+                                        Rect{0, 0, 1080, static_cast<int32_t>(layer + 100)});
+            writer.setLayerSourceCrop(kDisplayId, layer,
+                                      FRect{0.f, 0.f, 1080.f, static_cast<float>(layer + 100)});
+            writer.setLayerZOrder(kDisplayId, layer, static_cast<uint32_t>(layer));
+        }
+        if (geometryChanged) {
+            writer.setLayerCompositionType(kDisplayId, layer, Composition::DEVICE);
+            writer.setLayerDataspace(kDisplayId, layer, Dataspace::SRGB);
+            writer.setLayerPlaneAlpha(kDisplayId, layer, 1.f);
+        }
+    }
+    writer.presentOrvalidateDisplay(kDisplayId, ClockMonotonicTimestamp{0},
+                                    /*frameIntervalNs=*/16'666'667);
+}
+
+// Replays frames the way AidlComposer::execute submits them: the whole
+// accumulated stream in a single executeCommands call.
+void replayFrameBatched(benchmark::State& state) {
+    const int64_t layerCount = state.range(0);
+    SimulatedComposer composer;
+    composer.model.ipcRoundTripNs = state.range(1);
+    ComposerClientWriter writer(kDisplayId);
+
+    int64_t frames = 0;
+    int64_t worstPresentNs = 0;
+    for (auto _ : state) {
+        queueFrame(writer, layerCount, /*geometryChanged=*/frames % 60 == 0);
+        auto commands = writer.takePendingCommands();
+        const int64_t presentNs = composer.execute(commands);
+        if (presentNs > worstPresentNs) worstPresentNs = presentNs;
+        benchmark::DoNotOptimize(commands);
+        frames++;
+    }
+    state.counters["modeled_present_ns"] =
+            benchmark::Counter(static_cast<double>(composer.modeledTimeNs),
+                               benchmark::Counter::kAvgIterations);
+    state.counters["modeled_worst_present_ns"] =
+            benchmark::Counter(static_cast<double>(worstPresentNs));
+    state.counters["execute_calls_per_frame"] =
+            benchmark::Counter(static_cast<double>(composer.executeCalls),
+                               benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(replayFrameBatched)
+        ->ArgsProduct({{4, 16, 64}, {20'000, 60'000, 200'000}})
+        ->ArgNames({"layers", "ipc_ns"});
+
+// Same command mix, but each display command goes through its own
+// executeCommands call. The delta against replayFrameBatched is the modeled
+// win from command batching under a given IPC latency, which is what we want
+// to bound before committing to batching changes on device.
+void replayFrameUnbatched(benchmark::State& state) {
+    const int64_t layerCount = state.range(0);
+    SimulatedComposer composer;
+    composer.model.ipcRoundTripNs = state.range(1);
+    ComposerClientWriter writer(kDisplayId);
+
+    int64_t frames = 0;
+    for (auto _ : state) {
+        queueFrame(writer, layerCount, /*geometryChanged=*/frames % 60 == 0);
+        auto commands = writer.takePendingCommands();
+        for (auto& command : commands) {
+            // Submit each layer command and the trailing present separately.
+            for (auto& layerCommand : command.layers) {
+                DisplayCommand split;
+                split.display = command.display;
+                split.layers.emplace_back(std::move(layerCommand));
+                composer.execute({std::move(split)});
+            }
+            command.layers.clear();
+            composer.execute({std::move(command)});
+        }
+        frames++;
+    }
+    state.counters["modeled_present_ns"] =
+            benchmark::Counter(static_cast<double>(composer.modeledTimeNs),
+                               benchmark::Counter::kAvgIterations);
+    state.counters["execute_calls_per_frame"] =
+            benchmark::Counter(static_cast<double>(composer.executeCalls),
+                               benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(replayFrameUnbatched)
+        ->ArgsProduct({{4, 16, 64}, {20'000, 60'000, 200'000}})
+        ->ArgNames({"layers", "ipc_ns"});
+
+} // namespace
+} // namespace android::surfaceflinger
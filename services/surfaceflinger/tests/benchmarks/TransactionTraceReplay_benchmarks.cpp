@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Client.h> // temporarily needed for LayerCreationArgs
+#include <FrontEnd/LayerCreationArgs.h>
+#include <FrontEnd/LayerHierarchy.h>
+#include <FrontEnd/LayerLifecycleManager.h>
+#include <FrontEnd/LayerSnapshotBuilder.h>
+#include <LayerLifecycleManagerHelper.h>
+#include <Tracing/TransactionProtoParser.h>
+#include <TransactionState.h>
+#include <gui/LayerState.h>
+#include <utils/Timers.h>
+
+namespace android::surfaceflinger {
+
+namespace {
+
+using namespace android::surfaceflinger::frontend;
+
+// Replays transactions through the same commit-phase stages that
+// LayerTraceGenerator uses, accumulating wall time per stage so regressions
+// can be pinned to the lifecycle, hierarchy or snapshot step.
+struct FrontEndPipeline {
+    LayerLifecycleManager lifecycleManager;
+    LayerHierarchyBuilder hierarchyBuilder;
+    LayerSnapshotBuilder snapshotBuilder;
+    ui::DisplayMap<ui::LayerStack, DisplayInfo> displayInfos;
+    ShadowSettings globalShadowSettings{.ambientColor = {1, 1, 1, 1}};
+
+    nsecs_t lifecycleTime = 0;
+    nsecs_t hierarchyTime = 0;
+    nsecs_t snapshotTime = 0;
+
+    void updateStages(bool displayChanged) {
+        nsecs_t start = systemTime();
+        hierarchyBuilder.update(lifecycleManager);
+        nsecs_t hierarchyDone = systemTime();
+
+        LayerSnapshotBuilder::Args args{.root = hierarchyBuilder.getHierarchy(),
+                                        .layerLifecycleManager = lifecycleManager,
+                                        .displays = displayInfos,
+                                        .displayChanges = displayChanged,
+                                        .globalShadowSettings = globalShadowSettings,
+                                        .supportsBlur = true,
+                                        .forceFullDamage = false,
+                                        .supportedLayerGenericMetadata = {},
+                                        .genericLayerMetadataKeyMap = {}};
+        snapshotBuilder.update(args);
+        nsecs_t snapshotDone = systemTime();
+
+        lifecycleManager.commitChanges();
+
+        hierarchyTime += hierarchyDone - start;
+        snapshotTime += snapshotDone - hierarchyDone;
+    }
+
+    void applyTraceEntry(TransactionProtoParser& parser,
+                         const perfetto::protos::TransactionTraceEntry& entry) {
+        std::vector<std::unique_ptr<RequestedLayerState>> addedLayers;
+        addedLayers.reserve(static_cast<size_t>(entry.added_layers_size()));
+        for (int j = 0; j < entry.added_layers_size(); j++) {
+            LayerCreationArgs args;
+            parser.fromProto(entry.added_layers(j), args);
+            addedLayers.emplace_back(std::make_unique<RequestedLayerState>(args));
+        }
+
+        std::vector<TransactionState> transactions;
+        transactions.reserve(static_cast<size_t>(entry.transactions_size()));
+        for (int j = 0; j < entry.transactions_size(); j++) {
+            TransactionState transaction = parser.fromProto(entry.transactions(j));
+            for (auto& resolvedComposerState : transaction.states) {
+                if (resolvedComposerState.state.what & layer_state_t::eInputInfoChanged) {
+                    if (!resolvedComposerState.state.windowInfoHandle->getInfo()->inputConfig.test(
+                                gui::WindowInfo::InputConfig::NO_INPUT_CHANNEL)) {
+                        // create a fake token since the FE expects a valid token
+                        resolvedComposerState.state.windowInfoHandle->editInfo()->token =
+                                sp<BBinder>::make();
+                    }
+                }
+            }
+            transactions.emplace_back(std::move(transaction));
+        }
+
+        std::vector<std::pair<uint32_t, std::string>> destroyedHandles;
+        destroyedHandles.reserve(static_cast<size_t>(entry.destroyed_layer_handles_size()));
+        for (int j = 0; j < entry.destroyed_layer_handles_size(); j++) {
+            destroyedHandles.push_back({entry.destroyed_layer_handles(j), ""});
+        }
+
+        const bool displayChanged = entry.displays_changed();
+        if (displayChanged) {
+            parser.fromProto(entry.displays(), displayInfos);
+        }
+
+        nsecs_t start = systemTime();
+        lifecycleManager.addLayers(std::move(addedLayers));
+        lifecycleManager.applyTransactions(transactions, /*ignoreUnknownHandles=*/true);
+        lifecycleManager.onHandlesDestroyed(destroyedHandles, /*ignoreUnknownHandles=*/true);
+        lifecycleTime += systemTime() - start;
+
+        updateStages(displayChanged);
+    }
+
+    void exportCounters(benchmark::State& state) {
+        state.counters["lifecycle_ns"] =
+                benchmark::Counter(static_cast<double>(lifecycleTime),
+                                   benchmark::Counter::kAvgIterations);
+        state.counters["hierarchy_ns"] =
+                benchmark::Counter(static_cast<double>(hierarchyTime),
+                                   benchmark::Counter::kAvgIterations);
+        state.counters["snapshot_ns"] =
+                benchmark::Counter(static_cast<double>(snapshotTime),
+                                   benchmark::Counter::kAvgIterations);
+    }
+};
+
+// Commit pipeline on a synthetic layer-heavy scene: a root layer per "app"
+// with a small subtree each, then one frame's worth of position updates on a
+// tenth of the layers per iteration.
+static void commitPipelineSyntheticScene(benchmark::State& state) {
+    const uint32_t layerCount = static_cast<uint32_t>(state.range(0));
+
+    FrontEndPipeline pipeline;
+    LayerLifecycleManagerHelper helper(pipeline.lifecycleManager);
+    for (uint32_t id = 1; id <= layerCount; id++) {
+        if (id % 4 == 1) {
+            helper.createRootLayer(id);
+        } else {
+            helper.createLayer(id, id - 1);
+        }
+    }
+    pipeline.updateStages(/*displayChanged=*/false);
+
+    float offset = 0;
+    for (auto _ : state) {
+        offset += 1.f;
+        nsecs_t start = systemTime();
+        for (uint32_t id = 1; id <= layerCount; id += 10) {
+            helper.setPosition(id, offset, offset);
+        }
+        pipeline.lifecycleTime += systemTime() - start;
+        pipeline.updateStages(/*displayChanged=*/false);
+    }
+    pipeline.exportCounters(state);
+}
+BENCHMARK(commitPipelineSyntheticScene)->Arg(50)->Arg(200)->Arg(800);
+
+// Replays a recorded transaction trace (the Tracing/TransactionTracing
+// capture format, as written to /data/misc/wmtrace) through the commit
+// pipeline. The trace path is taken from SF_BENCH_TRANSACTION_TRACE so
+// device-specific layer-heavy scenes can be compared between releases.
+static void replayTransactionTrace(benchmark::State& state) {
+    const char* tracePath = std::getenv("SF_BENCH_TRANSACTION_TRACE");
+    if (tracePath == nullptr) {
+        state.SkipWithError("SF_BENCH_TRANSACTION_TRACE is not set");
+        return;
+    }
+
+    perfetto::protos::TransactionTraceFile traceFile;
+    {
+        std::fstream input(tracePath, std::ios::in | std::ios::binary);
+        if (!input || !traceFile.ParseFromIstream(&input)) {
+            state.SkipWithError("failed to parse transaction trace");
+            return;
+        }
+    }
+
+    nsecs_t lifecycleTime = 0;
+    nsecs_t hierarchyTime = 0;
+    nsecs_t snapshotTime = 0;
+    for (auto _ : state) {
+        FrontEndPipeline pipeline;
+        TransactionProtoParser parser(
+                std::make_unique<TransactionProtoParser::FlingerDataMapper>());
+        for (int i = 0; i < traceFile.entry_size(); i++) {
+            pipeline.applyTraceEntry(parser, traceFile.entry(i));
+        }
+        lifecycleTime += pipeline.lifecycleTime;
+        hierarchyTime += pipeline.hierarchyTime;
+        snapshotTime += pipeline.snapshotTime;
+    }
+
+    state.counters["lifecycle_ns"] =
+            benchmark::Counter(static_cast<double>(lifecycleTime),
+                               benchmark::Counter::kAvgIterations);
+    state.counters["hierarchy_ns"] =
+            benchmark::Counter(static_cast<double>(hierarchyTime),
+                               benchmark::Counter::kAvgIterations);
+    state.counters["snapshot_ns"] =
+            benchmark::Counter(static_cast<double>(snapshotTime),
+                               benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * traceFile.entry_size());
+}
+BENCHMARK(replayTransactionTrace);
+
+} // namespace
+} // namespace android::surfaceflinger
@@ -86,6 +86,7 @@ protected:
     Period getVsyncPeriod(uid_t) override;
     void resync() override;
     void onExpectedPresentTimePosted(TimePoint) override;
+    Duration getPresentLatencyBias() const override { return Duration::zero(); }
 
     void setupEventThread();
     sp<MockEventThreadConnection> createConnection(ConnectionEventRecorder& recorder,
@@ -621,6 +622,31 @@ TEST_F(EventThreadTest, setVsyncRateTwoPostsEveryOtherEventToThatConnection) {
     expectVsyncEventReceivedByConnection(101112, 4u);
 }
 
+TEST_F(EventThreadTest, backgroundConnectionGetsDecimatedVsyncs) {
+    setupEventThread();
+
+    mThread->setVsyncDeliveryClassForUid(mConnectionUid, VsyncDeliveryClass::Background);
+    mThread->setVsyncRate(1, mConnection);
+
+    // EventThread should enable vsync callbacks.
+    expectVSyncCallbackScheduleReceived(true);
+
+    // The first three vsyncs are decimated for the background connection.
+    onVSyncEvent(123, 456, 789);
+    onVSyncEvent(456, 123, 0);
+    onVSyncEvent(789, 777, 111);
+    EXPECT_FALSE(mConnectionEventCallRecorder.waitForUnexpectedCall().has_value());
+
+    // The fourth vsync lands on the decimation boundary and is delivered.
+    onVSyncEvent(101112, 7847, 86);
+    expectVsyncEventReceivedByConnection(101112, 4u);
+
+    // Promoting the uid back to foreground restores delivery of every vsync.
+    mThread->setVsyncDeliveryClassForUid(mConnectionUid, VsyncDeliveryClass::Foreground);
+    onVSyncEvent(131415, 1000, 0);
+    expectVsyncEventReceivedByConnection(131415, 5u);
+}
+
 TEST_F(EventThreadTest, connectionsRemovedIfInstanceDestroyed) {
     setupEventThread();
 
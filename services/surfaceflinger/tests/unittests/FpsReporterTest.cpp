@@ -55,9 +55,11 @@ struct TestableFpsListener : public gui::BnFpsListener {
     TestableFpsListener() {}
 
     float lastReportedFps = 0;
+    int reportCount = 0;
 
     binder::Status onFpsReported(float fps) override {
         lastReportedFps = fps;
+        reportCount++;
         return binder::Status::ok();
     }
 };
@@ -210,5 +212,41 @@ TEST_F(FpsReporterTest, rateLimits) {
     EXPECT_EQ(secondFps, mFpsListener->lastReportedFps);
 }
 
+TEST_F(FpsReporterTest, skipsCallbackWhenFpsUnchanged) {
+    const constexpr int32_t kTaskId = 12;
+    LayerMetadata targetMetadata;
+    targetMetadata.setInt32(gui::METADATA_TASK_ID, kTaskId);
+    createRootLayer(1);
+    createLayer(11, 1, targetMetadata);
+
+    frontend::LayerHierarchyBuilder hierarchyBuilder;
+    hierarchyBuilder.update(mLifecycleManager);
+
+    float firstFps = 44.0;
+    float secondFps = 53.0;
+
+    EXPECT_CALL(mFrameTimeline, computeFps(UnorderedElementsAre(11)))
+            .WillOnce(Return(firstFps))
+            .WillOnce(Return(firstFps))
+            .WillOnce(Return(secondFps));
+
+    mFpsReporter->addListener(mFpsListener, kTaskId);
+    mClock->advanceTime(600ms);
+    mFpsReporter->dispatchLayerFps(hierarchyBuilder.getHierarchy());
+    EXPECT_EQ(firstFps, mFpsListener->lastReportedFps);
+    EXPECT_EQ(1, mFpsListener->reportCount);
+
+    // Same fps recomputed: the listener must not be called again.
+    mClock->advanceTime(600ms);
+    mFpsReporter->dispatchLayerFps(hierarchyBuilder.getHierarchy());
+    EXPECT_EQ(1, mFpsListener->reportCount);
+
+    // A different value is delivered as usual.
+    mClock->advanceTime(600ms);
+    mFpsReporter->dispatchLayerFps(hierarchyBuilder.getHierarchy());
+    EXPECT_EQ(secondFps, mFpsListener->lastReportedFps);
+    EXPECT_EQ(2, mFpsListener->reportCount);
+}
+
 } // namespace
 } // namespace android
@@ -100,6 +100,36 @@ TEST_F(FrameRateOverrideMappingsTest, testSetPreferredRefreshRateForUid) {
                       .getFrameRateOverrideForUid(1, /*supportsFrameRateOverrideByContent*/ false));
 }
 
+TEST_F(FrameRateOverrideMappingsTest, testSetRefreshRateForUidsBatch) {
+    SET_FLAG_FOR_TEST(flags::game_default_frame_rate, false);
+
+    mFrameRateOverrideMappings.setGameModeRefreshRateForUids({{1, 30.0f}, {2, 90.0f}});
+    mFrameRateOverrideMappings.setPreferredRefreshRateForUids({{3, 60.0f}, {4, 120.0f}});
+
+    ASSERT_TRUE(isApproxEqual(30.0_Hz,
+                              *mFrameRateOverrideMappings.getFrameRateOverrideForUid(
+                                      1, /*supportsFrameRateOverrideByContent*/ false)));
+    ASSERT_TRUE(isApproxEqual(90.0_Hz,
+                              *mFrameRateOverrideMappings.getFrameRateOverrideForUid(
+                                      2, /*supportsFrameRateOverrideByContent*/ false)));
+    ASSERT_TRUE(isApproxEqual(60.0_Hz,
+                              *mFrameRateOverrideMappings.getFrameRateOverrideForUid(
+                                      3, /*supportsFrameRateOverrideByContent*/ false)));
+    ASSERT_TRUE(isApproxEqual(120.0_Hz,
+                              *mFrameRateOverrideMappings.getFrameRateOverrideForUid(
+                                      4, /*supportsFrameRateOverrideByContent*/ false)));
+
+    // A zero frame rate in a batch clears the override for that uid.
+    mFrameRateOverrideMappings.setGameModeRefreshRateForUids({{1, 0.0f}, {2, 60.0f}});
+
+    ASSERT_EQ(std::nullopt,
+              mFrameRateOverrideMappings
+                      .getFrameRateOverrideForUid(1, /*supportsFrameRateOverrideByContent*/ false));
+    ASSERT_TRUE(isApproxEqual(60.0_Hz,
+                              *mFrameRateOverrideMappings.getFrameRateOverrideForUid(
+                                      2, /*supportsFrameRateOverrideByContent*/ false)));
+}
+
 TEST_F(FrameRateOverrideMappingsTest, testGetFrameRateOverrideForUidMixed) {
     SET_FLAG_FOR_TEST(flags::game_default_frame_rate, false);
     mFrameRateOverrideByContent.clear();
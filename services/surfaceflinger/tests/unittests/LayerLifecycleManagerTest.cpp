@@ -117,6 +117,54 @@ TEST_F(LayerLifecycleManagerTest, updateLayerStates) {
     EXPECT_EQ(managedLayers.front()->backgroundBlurRadius, 22u);
 }
 
+TEST_F(LayerLifecycleManagerTest, advanceAnimationsInterpolatesState) {
+    LayerLifecycleManager lifecycleManager;
+    std::vector<std::unique_ptr<RequestedLayerState>> layers;
+    layers.emplace_back(rootLayer(1));
+    lifecycleManager.addLayers(std::move(layers));
+
+    LayerAnimationSpec spec;
+    spec.startTimeNanos = 1000;
+    spec.durationNanos = 1000;
+    spec.animatePosition = true;
+    spec.endX = 100;
+    spec.endY = 50;
+    spec.animateAlpha = true;
+    spec.startAlpha = 0.f;
+    spec.endAlpha = 1.f;
+
+    std::vector<TransactionState> transactions;
+    transactions.emplace_back();
+    transactions.back().states.push_back({});
+    transactions.back().states.front().state.animationSpec = spec;
+    transactions.back().states.front().state.what = layer_state_t::eAnimationChanged;
+    transactions.back().states.front().layerId = 1;
+    lifecycleManager.applyTransactions(transactions);
+    EXPECT_TRUE(lifecycleManager.getGlobalChanges().test(RequestedLayerState::Changes::Animation));
+    lifecycleManager.commitChanges();
+
+    // Midpoint: state is interpolated and the animation still has frames.
+    EXPECT_TRUE(lifecycleManager.advanceAnimations(1500));
+    auto& layer = *lifecycleManager.getLayers().front();
+    EXPECT_FLOAT_EQ(layer.x, 50.f);
+    EXPECT_FLOAT_EQ(layer.y, 25.f);
+    EXPECT_FLOAT_EQ(static_cast<float>(layer.color.a), 0.5f);
+    EXPECT_TRUE(layer.changes.test(RequestedLayerState::Changes::Animation));
+    EXPECT_TRUE(lifecycleManager.getGlobalChanges().test(RequestedLayerState::Changes::Geometry));
+    lifecycleManager.commitChanges();
+
+    // Past the end: the final state is applied and the animation is done.
+    EXPECT_FALSE(lifecycleManager.advanceAnimations(2500));
+    EXPECT_FLOAT_EQ(layer.x, 100.f);
+    EXPECT_FLOAT_EQ(layer.y, 50.f);
+    EXPECT_FLOAT_EQ(static_cast<float>(layer.color.a), 1.f);
+    lifecycleManager.commitChanges();
+
+    // Nothing left to advance.
+    EXPECT_FALSE(lifecycleManager.advanceAnimations(3000));
+    EXPECT_EQ(lifecycleManager.getGlobalChanges().get(), 0u);
+}
+
 TEST_F(LayerLifecycleManagerTest, layerWithoutHandleIsDestroyed) {
     LayerLifecycleManager lifecycleManager;
     auto listener = std::make_shared<ExpectLayerLifecycleListener>();
@@ -175,6 +175,21 @@ TEST_F(LayerSnapshotTest, croppedByParent) {
     EXPECT_EQ(getSnapshot(1)->geomLayerBounds, maxDisplaySize);
 }
 
+TEST_F(LayerSnapshotTest, alphaOnlyUpdateKeepsGeometryGeneration) {
+    setCrop(11, Rect(0, 0, 10, 20));
+    UPDATE_AND_VERIFY(mSnapshotBuilder, STARTING_ZORDER);
+    const uint32_t generation = getSnapshot(11)->geometryGeneration;
+
+    // Content-only updates must not recompute geometry.
+    setAlpha(11, 0.5f);
+    UPDATE_AND_VERIFY(mSnapshotBuilder, STARTING_ZORDER);
+    EXPECT_EQ(generation, getSnapshot(11)->geometryGeneration);
+
+    setCrop(11, Rect(0, 0, 30, 20));
+    UPDATE_AND_VERIFY(mSnapshotBuilder, STARTING_ZORDER);
+    EXPECT_GT(getSnapshot(11)->geometryGeneration, generation);
+}
+
 // visibility tests
 TEST_F(LayerSnapshotTest, newLayerHiddenByPolicy) {
     createLayer(112, 11);
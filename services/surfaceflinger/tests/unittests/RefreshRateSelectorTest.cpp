@@ -3256,19 +3256,19 @@ TEST_P(RefreshRateSelectorTest, getBestFrameRateMode_ReadsCache) {
                                                                   {90_Hz, kMode90}}},
                                                           GlobalSignals{.touch = true}};
 
-    selector.mutableGetRankedRefreshRatesCache() = {.layers = std::vector<LayerRequirement>{},
-                                                    .signals = GlobalSignals{.touch = true,
-                                                                             .idle = true},
-                                                    .result = result};
+    selector.mutableGetRankedRefreshRatesCache().push_back(
+            {.layers = std::vector<LayerRequirement>{},
+             .signals = GlobalSignals{.touch = true, .idle = true},
+             .result = result});
 
-    const auto& cache = *selector.mutableGetRankedRefreshRatesCache();
+    const auto& cache = selector.mutableGetRankedRefreshRatesCache().front();
     EXPECT_EQ(result, selector.getRankedFrameRates(cache.layers, cache.signals));
 }
 
 TEST_P(RefreshRateSelectorTest, getBestFrameRateMode_WritesCache) {
     auto selector = createSelector(kModes_30_60_72_90_120, kModeId60);
 
-    EXPECT_FALSE(selector.mutableGetRankedRefreshRatesCache());
+    EXPECT_TRUE(selector.mutableGetRankedRefreshRatesCache().empty());
 
     const std::vector<LayerRequirement> layers = {{.weight = 1.f}, {.weight = 0.5f}};
     const RefreshRateSelector::GlobalSignals globalSignals{.touch = true, .idle = true};
@@ -3277,12 +3277,12 @@ TEST_P(RefreshRateSelectorTest, getBestFrameRateMode_WritesCache) {
     const auto result = selector.getRankedFrameRates(layers, globalSignals, pacesetterFps);
 
     const auto& cache = selector.mutableGetRankedRefreshRatesCache();
-    ASSERT_TRUE(cache);
+    ASSERT_EQ(cache.size(), 1u);
 
-    EXPECT_EQ(cache->layers, layers);
-    EXPECT_EQ(cache->signals, globalSignals);
-    EXPECT_EQ(cache->pacesetterFps, pacesetterFps);
-    EXPECT_EQ(cache->result, result);
+    EXPECT_EQ(cache.front().layers, layers);
+    EXPECT_EQ(cache.front().signals, globalSignals);
+    EXPECT_EQ(cache.front().pacesetterFps, pacesetterFps);
+    EXPECT_EQ(cache.front().result, result);
 }
 
 TEST_P(RefreshRateSelectorTest, getBestFrameRateMode_ExplicitExactTouchBoost) {
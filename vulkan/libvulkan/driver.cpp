@@ -970,6 +970,14 @@ PFN_vkVoidFunction GetInstanceProcAddr(VkInstance instance, const char* pName) {
 }
 
 PFN_vkVoidFunction GetDeviceProcAddr(VkDevice device, const char* pName) {
+    // Command recording entrypoints are never hooked by the loader, so queries
+    // for them can return the driver's entrypoint directly without searching
+    // the hook table. With no layers enabled this function is the head of the
+    // chain, which is what keeps vkCmd* pointers resolved through
+    // vkGetDeviceProcAddr free of loader trampolines.
+    if (strncmp(pName, "vkCmd", 5) == 0)
+        return GetData(device).driver.GetDeviceProcAddr(device, pName);
+
     const ProcHook* hook = GetProcHook(pName);
     PFN_vkVoidFunction drv_func = GetData(device).driver.GetDeviceProcAddr(device, pName);
 